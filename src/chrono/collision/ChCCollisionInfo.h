@@ -33,7 +33,7 @@ class ChApi ChCollisionInfo {
     ChVector<> vN;             ///< coll.normal, respect to A, in abs coords
     double distance;           ///< distance (negative for penetration)
     double eff_radius;         ///< effective radius of curvature at contact (SMC only)
-    float* reaction_cache;     ///< pointer to some persistent user cache of reactions
+    float* reaction_cache;     ///< pointer to some persistent user cache of reactions (N,U,V and rolling torques)
 
     /// Basic default constructor.
     ChCollisionInfo();
@@ -18,6 +18,7 @@
 #include "chrono/collision/ChCCollisionInfo.h"
 #include "chrono/core/ChApiCE.h"
 #include "chrono/core/ChFrame.h"
+#include "chrono/parallel/ChTaskScheduler.h"
 
 namespace chrono {
 
@@ -70,6 +71,10 @@ class ChApi ChCollisionSystem {
     /// Reset any timers associated with collision detection.
     virtual void ResetTimers() {}
 
+    /// Set the task scheduler that can be used for parallel collision detection.
+    /// This is called by the ChSystem that owns the collision system; by default it is ignored.
+    virtual void SetTaskScheduler(std::shared_ptr<ChTaskScheduler> scheduler) {}
+
     /// After the Run() has completed, you can call this function to
     /// fill a 'contact container', that is an object inherited from class
     /// ChContactContainer. For instance ChSystem, after each Run()
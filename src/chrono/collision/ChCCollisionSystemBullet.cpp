@@ -1171,7 +1171,7 @@ ChCollisionSystemBullet::ChCollisionSystemBullet(unsigned int max_objects, doubl
     // btDefaultCollisionConstructionInfo conf_info(...); ***TODO***
     bt_collision_configuration = new btDefaultCollisionConfiguration();
 
-    bt_dispatcher = new btCollisionDispatcher(bt_collision_configuration);
+    bt_dispatcher = new btCollisionDispatcherMt(bt_collision_configuration);
     //((btDefaultCollisionConfiguration*)bt_collision_configuration)->setConvexConvexMultipointIterations(4,4);
 
     //***OLD***
@@ -1266,6 +1266,19 @@ void ChCollisionSystemBullet::Run() {
     }
 }
 
+void ChCollisionSystemBullet::SetNumThreads(int nthreads) {
+    bt_dispatcher->setNumThreads(nthreads);
+}
+
+int ChCollisionSystemBullet::GetNumThreads() const {
+    return bt_dispatcher->getNumThreads();
+}
+
+void ChCollisionSystemBullet::SetTaskScheduler(std::shared_ptr<ChTaskScheduler> scheduler) {
+    task_scheduler = scheduler;
+    bt_dispatcher->setTaskScheduler(scheduler.get());
+}
+
 void ChCollisionSystemBullet::ResetTimers() {
     bt_collision_world->timer_collision_broad.reset();
     bt_collision_world->timer_collision_narrow.reset();
@@ -17,6 +17,7 @@
 
 #include "chrono/collision/ChCCollisionSystem.h"
 #include "chrono/collision/bullet/btBulletCollisionCommon.h"
+#include "chrono/collision/bullet/BulletCollision/CollisionDispatch/btCollisionDispatcherMt.h"
 #include "chrono/core/ChApiCE.h"
 
 namespace chrono {
@@ -53,9 +54,22 @@ class ChApi ChCollisionSystemBullet : public ChCollisionSystem {
     /// (Contacts will be managed by the Bullet persistent contact cache).
     virtual void Run() override;
 
+    /// Set the number of threads used by the narrow phase (default: 1).
+    /// With more than one thread, the overlapping pairs found by the broadphase are processed in
+    /// parallel; the contacts found, and the order in which they are reported, do not depend on
+    /// the number of threads. If a task scheduler is set, the pairs are processed as tasks of the
+    /// scheduler, and its threads are used instead.
+    void SetNumThreads(int nthreads);
+
+    /// Get the number of threads used by the narrow phase.
+    int GetNumThreads() const;
+
     /// Reset timers for collision detection.
     virtual void ResetTimers() override;
 
+    /// Set the task scheduler used by the multithreaded narrow phase (see SetNumThreads).
+    virtual void SetTaskScheduler(std::shared_ptr<ChTaskScheduler> scheduler) override;
+
     /// Return the time (in seconds) for broadphase collision detection.
     virtual double GetTimerCollisionBroad() const override;
 
@@ -116,9 +130,10 @@ class ChApi ChCollisionSystemBullet : public ChCollisionSystem {
 
   private:
     btCollisionConfiguration* bt_collision_configuration;
-    btCollisionDispatcher* bt_dispatcher;
+    btCollisionDispatcherMt* bt_dispatcher;
     btBroadphaseInterface* bt_broadphase;
     btCollisionWorld* bt_collision_world;
+    std::shared_ptr<ChTaskScheduler> task_scheduler;
 };
 
 }  // end namespace collision
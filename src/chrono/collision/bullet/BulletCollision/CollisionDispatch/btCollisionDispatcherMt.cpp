@@ -0,0 +1,318 @@
+/*
+Bullet Continuous Collision Detection and Physics Library
+Copyright (c) 2003-2006 Erwin Coumans  http://continuousphysics.com/Bullet/
+
+This software is provided 'as-is', without any express or implied warranty.
+In no event will the authors be held liable for any damages arising from the use of this software.
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute it freely,
+subject to the following restrictions:
+
+1. The origin of this software must not be misrepresented; you must not claim that you wrote the original software. If you use this software in a product, an acknowledgment in the product documentation would be appreciated but is not required.
+2. Altered source versions must be plainly marked as such, and must not be misrepresented as being the original software.
+3. This notice may not be removed or altered from any source distribution.
+*/
+
+#include "btCollisionDispatcherMt.h"
+
+#include "BulletCollision/CollisionShapes/btCollisionShape.h"
+#include "BulletCollision/CollisionDispatch/btCollisionObject.h"
+#include "BulletCollision/BroadphaseCollision/btOverlappingPairCache.h"
+#include "LinearMath/btPoolAllocator.h"
+
+extern int gNumManifold;
+
+// Context of the task being processed by the calling thread.
+static thread_local void* t_taskContext = 0;
+
+// Below this number of overlapping pairs, the narrow phase is always run on a single thread.
+#define BT_DISPATCHER_MT_MIN_PAIRS 64
+
+// Minimum number of independent pairs processed by a single task.
+#define BT_DISPATCHER_MT_MIN_CHUNK 16
+
+
+btCollisionDispatcherMt::btCollisionDispatcherMt(btCollisionConfiguration* collisionConfiguration)
+:btCollisionDispatcher(collisionConfiguration),
+m_numThreads(1),
+m_batchUpdating(false),
+m_taskScheduler(0)
+{
+}
+
+btCollisionDispatcherMt::~btCollisionDispatcherMt()
+{
+}
+
+void btCollisionDispatcherMt::setNumThreads(int numThreads)
+{
+	m_numThreads = btMax(numThreads, 1);
+}
+
+btPersistentManifold* btCollisionDispatcherMt::getNewManifold(void* b0,void* b1)
+{
+	if (!m_batchUpdating)
+		return btCollisionDispatcher::getNewManifold(b0,b1);
+
+	// Same as btCollisionDispatcher::getNewManifold(), but the manifold is added to the
+	// manifold array later, in replayManifoldEvents().
+	btCollisionObject* body0 = (btCollisionObject*)b0;
+	btCollisionObject* body1 = (btCollisionObject*)b1;
+
+	btScalar contactBreakingThreshold =  (m_dispatcherFlags & btCollisionDispatcher::CD_USE_RELATIVE_CONTACT_BREAKING_THRESHOLD) ?
+		btMin(body0->getCollisionShape()->getContactBreakingThreshold(gContactBreakingThreshold) , body1->getCollisionShape()->getContactBreakingThreshold(gContactBreakingThreshold))
+		: gContactBreakingThreshold ;
+
+	btScalar contactProcessingThreshold = btMin(body0->getContactProcessingThreshold(),body1->getContactProcessingThreshold());
+
+	void* mem = 0;
+	{
+		std::lock_guard<std::mutex> lock(m_allocatorMutex);
+		gNumManifold++;
+		if (m_persistentManifoldPoolAllocator->getFreeCount())
+		{
+			mem = m_persistentManifoldPoolAllocator->allocate(sizeof(btPersistentManifold));
+		} else
+		{
+			mem = btAlignedAlloc(sizeof(btPersistentManifold),16);
+		}
+	}
+	btPersistentManifold* manifold = new(mem) btPersistentManifold (body0,body1,0,contactBreakingThreshold,contactProcessingThreshold);
+
+	recordManifoldEvent(manifold,true);
+
+	return manifold;
+}
+
+void btCollisionDispatcherMt::releaseManifold(btPersistentManifold* manifold)
+{
+	if (!m_batchUpdating)
+	{
+		btCollisionDispatcher::releaseManifold(manifold);
+		return;
+	}
+
+	// The manifold is removed from the manifold array, and deleted, in replayManifoldEvents().
+	clearManifold(manifold);
+
+	recordManifoldEvent(manifold,false);
+}
+
+void btCollisionDispatcherMt::recordManifoldEvent(btPersistentManifold* manifold, bool created)
+{
+	btTaskContext* context = (btTaskContext*)t_taskContext;
+	btAssert(context);
+
+	btManifoldEvent event;
+	event.m_pair = context->m_pair;
+	event.m_seq = context->m_seq++;
+	event.m_manifold = manifold;
+	event.m_created = created;
+	context->m_events->push_back(event);
+}
+
+void* btCollisionDispatcherMt::allocateCollisionAlgorithm(int size)
+{
+	if (!m_batchUpdating)
+		return btCollisionDispatcher::allocateCollisionAlgorithm(size);
+
+	std::lock_guard<std::mutex> lock(m_allocatorMutex);
+	return btCollisionDispatcher::allocateCollisionAlgorithm(size);
+}
+
+void btCollisionDispatcherMt::freeCollisionAlgorithm(void* ptr)
+{
+	if (!m_batchUpdating)
+	{
+		btCollisionDispatcher::freeCollisionAlgorithm(ptr);
+		return;
+	}
+
+	std::lock_guard<std::mutex> lock(m_allocatorMutex);
+	btCollisionDispatcher::freeCollisionAlgorithm(ptr);
+}
+
+
+// Compound and concave objects are temporarily modified by their collision algorithms (that replace
+// their shape with the shape of a child or of a triangle); GImpact algorithms modify both objects.
+static bool btIsModifiedByCollision(const btCollisionShape* shape, const btCollisionShape* otherShape)
+{
+	return shape->isCompound() || shape->isConcave() ||
+		otherShape->getShapeType() == GIMPACT_SHAPE_PROXYTYPE;
+}
+
+void btCollisionDispatcherMt::buildTasks(btBroadphasePair* pairs, int numPairs)
+{
+	// Collect the objects that are modified by the collision algorithms
+	m_sharedObjects.clear();
+	for (int i=0;i<numPairs;i++)
+	{
+		btCollisionObject* colObj0 = (btCollisionObject*)pairs[i].m_pProxy0->m_clientObject;
+		btCollisionObject* colObj1 = (btCollisionObject*)pairs[i].m_pProxy1->m_clientObject;
+		const btCollisionShape* shape0 = colObj0->getCollisionShape();
+		const btCollisionShape* shape1 = colObj1->getCollisionShape();
+
+		if (btIsModifiedByCollision(shape0,shape1) && !m_sharedObjects.find(btHashPtr(colObj0)))
+			m_sharedObjects.insert(btHashPtr(colObj0),m_sharedObjects.size());
+		if (btIsModifiedByCollision(shape1,shape0) && !m_sharedObjects.find(btHashPtr(colObj1)))
+			m_sharedObjects.insert(btHashPtr(colObj1),m_sharedObjects.size());
+	}
+
+	// All pairs touching a modified object are processed by the same task, so pairs that
+	// connect two modified objects merge their groups.
+	int numShared = m_sharedObjects.size();
+	m_unionFind.reset(numShared);
+	m_pairTask.resize(numPairs);
+	for (int i=0;i<numPairs;i++)
+	{
+		const int* shared0 = m_sharedObjects.find(btHashPtr(pairs[i].m_pProxy0->m_clientObject));
+		const int* shared1 = m_sharedObjects.find(btHashPtr(pairs[i].m_pProxy1->m_clientObject));
+		if (shared0 && shared1)
+			m_unionFind.unite(*shared0,*shared1);
+		m_pairTask[i] = shared0 ? *shared0 : (shared1 ? *shared1 : -1);
+	}
+
+	// One task per group, then the independent pairs split in chunks
+	int numTasks = 0;
+	int numFree = 0;
+	m_groupTask.resize(numShared);
+	for (int g=0;g<numShared;g++)
+		m_groupTask[g] = -1;
+	for (int i=0;i<numPairs;i++)
+	{
+		if (m_pairTask[i] < 0)
+		{
+			numFree++;
+			continue;
+		}
+		int group = m_unionFind.find(m_pairTask[i]);
+		if (m_groupTask[group] < 0)
+			m_groupTask[group] = numTasks++;
+		m_pairTask[i] = m_groupTask[group];
+	}
+
+	int chunk = btMax(BT_DISPATCHER_MT_MIN_CHUNK, numFree / (8 * m_numThreads));
+	int freeIndex = 0;
+	for (int i=0;i<numPairs;i++)
+	{
+		if (m_pairTask[i] < 0)
+			m_pairTask[i] = -2 - (freeIndex++ / chunk);
+	}
+	int numGroupTasks = numTasks;
+	numTasks += (numFree + chunk - 1) / chunk;
+
+	// Sort the pairs by task (pairs of each task remain in increasing order)
+	m_taskStart.resize(numTasks+1);
+	for (int t=0;t<=numTasks;t++)
+		m_taskStart[t] = 0;
+	for (int i=0;i<numPairs;i++)
+	{
+		if (m_pairTask[i] < -1)
+			m_pairTask[i] = numGroupTasks - 2 - m_pairTask[i];
+		m_taskStart[m_pairTask[i]+1]++;
+	}
+	for (int t=0;t<numTasks;t++)
+		m_taskStart[t+1] += m_taskStart[t];
+
+	m_taskPairs.resize(numPairs);
+	for (int i=0;i<numPairs;i++)
+		m_taskPairs[m_taskStart[m_pairTask[i]]++] = i;
+	for (int t=numTasks;t>0;t--)
+		m_taskStart[t] = m_taskStart[t-1];
+	m_taskStart[0] = 0;
+}
+
+
+class btManifoldEventSortPredicate
+{
+public:
+	template <class T>
+	bool operator() ( const T& lhs, const T& rhs ) const
+	{
+		return (lhs.m_pair < rhs.m_pair) || (lhs.m_pair == rhs.m_pair && lhs.m_seq < rhs.m_seq);
+	}
+};
+
+void btCollisionDispatcherMt::replayManifoldEvents()
+{
+	// All the events of a pair come from the same task, so sorting by pair and then by sequence
+	// number gives the order of the single-threaded dispatcher.
+	btAlignedObjectArray<btManifoldEvent>& events = m_taskEvents[0];
+	for (int t=1;t<m_taskEvents.size();t++)
+	{
+		for (int i=0;i<m_taskEvents[t].size();i++)
+			events.push_back(m_taskEvents[t][i]);
+		m_taskEvents[t].resize(0);
+	}
+	events.quickSort(btManifoldEventSortPredicate());
+
+	for (int i=0;i<events.size();i++)
+	{
+		btPersistentManifold* manifold = events[i].m_manifold;
+		if (events[i].m_created)
+		{
+			manifold->m_index1a = m_manifoldsPtr.size();
+			m_manifoldsPtr.push_back(manifold);
+		} else
+		{
+			btCollisionDispatcher::releaseManifold(manifold);
+		}
+	}
+	events.resize(0);
+}
+
+void btCollisionDispatcherMt::processTask(int task, btBroadphasePair* pairs, const btDispatcherInfo& dispatchInfo)
+{
+	btNearCallback nearCallback = getNearCallback();
+
+	btTaskContext context;
+	context.m_seq = 0;
+	context.m_events = &m_taskEvents[task];
+
+	void* previousContext = t_taskContext;
+	t_taskContext = &context;
+	for (int k=m_taskStart[task];k<m_taskStart[task+1];k++)
+	{
+		int i = m_taskPairs[k];
+		context.m_pair = i;
+		(*nearCallback)(pairs[i],*this,dispatchInfo);
+	}
+	t_taskContext = previousContext;
+}
+
+void btCollisionDispatcherMt::dispatchAllCollisionPairs(btOverlappingPairCache* pairCache,const btDispatcherInfo& dispatchInfo,btDispatcher* dispatcher)
+{
+	int numPairs = pairCache->getNumOverlappingPairs();
+
+	// Continuous collision detection updates dispatchInfo.m_timeOfImpact, so it is always single-threaded.
+	if (m_numThreads < 2 || numPairs < BT_DISPATCHER_MT_MIN_PAIRS ||
+		dispatchInfo.m_dispatchFunc != btDispatcherInfo::DISPATCH_DISCRETE)
+	{
+		btCollisionDispatcher::dispatchAllCollisionPairs(pairCache,dispatchInfo,dispatcher);
+		return;
+	}
+
+	btBroadphasePair* pairs = pairCache->getOverlappingPairArrayPtr();
+	buildTasks(pairs,numPairs);
+	int numTasks = m_taskStart.size() - 1;
+
+	m_taskEvents.resize(numTasks);
+	for (int t=0;t<numTasks;t++)
+		m_taskEvents[t].resize(0);
+
+	m_batchUpdating = true;
+
+	if (m_taskScheduler)
+	{
+		m_taskScheduler->ParallelFor(0,numTasks,[&](int t) { processTask(t,pairs,dispatchInfo); });
+	} else
+	{
+#pragma omp parallel for num_threads(m_numThreads) schedule(dynamic, 1)
+		for (int t=0;t<numTasks;t++)
+			processTask(t,pairs,dispatchInfo);
+	}
+
+	m_batchUpdating = false;
+
+	replayManifoldEvents();
+}
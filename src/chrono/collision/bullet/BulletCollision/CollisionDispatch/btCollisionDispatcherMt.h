@@ -0,0 +1,119 @@
+/*
+Bullet Continuous Collision Detection and Physics Library
+Copyright (c) 2003-2006 Erwin Coumans  http://continuousphysics.com/Bullet/
+
+This software is provided 'as-is', without any express or implied warranty.
+In no event will the authors be held liable for any damages arising from the use of this software.
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute it freely,
+subject to the following restrictions:
+
+1. The origin of this software must not be misrepresented; you must not claim that you wrote the original software. If you use this software in a product, an acknowledgment in the product documentation would be appreciated but is not required.
+2. Altered source versions must be plainly marked as such, and must not be misrepresented as being the original software.
+3. This notice may not be removed or altered from any source distribution.
+*/
+
+#ifndef BT_COLLISION_DISPATCHER_MT_H
+#define BT_COLLISION_DISPATCHER_MT_H
+
+#include "BulletCollision/CollisionDispatch/btCollisionDispatcher.h"
+#include "BulletCollision/CollisionDispatch/btUnionFind.h"
+#include "LinearMath/btHashMap.h"
+#include "chrono/parallel/ChTaskScheduler.h"
+
+#include <mutex>
+
+/// btCollisionDispatcherMt is a btCollisionDispatcher that can run the narrow phase on multiple threads.
+/// The overlapping pairs of the broadphase are split in tasks that are processed in parallel.
+/// Pairs that involve compound or concave shapes are not independent, because their collision
+/// algorithms temporarily replace the shape and transform of the collision objects: all pairs that
+/// touch such objects are put in the same task, and processed sequentially.
+/// Manifolds created or released during the parallel pass are not added to (or removed from) the
+/// manifold array immediately: these events are recorded per pair and replayed in pair order at
+/// the end of the pass, so that the manifold array (hence the order of the reported contacts) is
+/// exactly the same as with the single-threaded dispatcher, whatever the number of threads.
+/// The tasks are run on a chrono::ChTaskScheduler if one is set, otherwise on OpenMP threads.
+/// Note that a custom near callback, if any, must be thread safe when using more than one thread.
+class btCollisionDispatcherMt : public btCollisionDispatcher
+{
+public:
+
+	btCollisionDispatcherMt(btCollisionConfiguration* collisionConfiguration);
+
+	virtual ~btCollisionDispatcherMt();
+
+	/// Set the number of threads used by dispatchAllCollisionPairs() (default: 1, i.e. single-threaded).
+	void	setNumThreads(int numThreads);
+
+	int		getNumThreads() const
+	{
+		return m_numThreads;
+	}
+
+	/// Set the scheduler that runs the tasks of the parallel pass (not owned; 0 to use OpenMP threads).
+	/// The parallel pass is still enabled only if the number of threads is more than one.
+	void	setTaskScheduler(chrono::ChTaskScheduler* scheduler)
+	{
+		m_taskScheduler = scheduler;
+	}
+
+	virtual btPersistentManifold*	getNewManifold(void* b0,void* b1);
+
+	virtual void releaseManifold(btPersistentManifold* manifold);
+
+	virtual void	dispatchAllCollisionPairs(btOverlappingPairCache* pairCache,const btDispatcherInfo& dispatchInfo,btDispatcher* dispatcher);
+
+	virtual	void* allocateCollisionAlgorithm(int size);
+
+	virtual	void freeCollisionAlgorithm(void* ptr);
+
+protected:
+
+	/// Creation or release of a manifold during the parallel pass.
+	struct btManifoldEvent
+	{
+		int						m_pair;		///< index of the pair being processed
+		int						m_seq;		///< sequence number, to keep the order of events of the same pair
+		btPersistentManifold*	m_manifold;
+		bool					m_created;
+	};
+
+	/// Pair being processed by a task, and events recorded by the task.
+	struct btTaskContext
+	{
+		int		m_pair;
+		int		m_seq;		///< event counter of the task
+		btAlignedObjectArray<btManifoldEvent>*	m_events;
+	};
+
+	/// Group the pairs in tasks that can be processed concurrently.
+	void	buildTasks(btBroadphasePair* pairs, int numPairs);
+
+	/// Process the pairs of a task, in increasing order.
+	void	processTask(int task, btBroadphasePair* pairs, const btDispatcherInfo& dispatchInfo);
+
+	/// Record the creation or release of a manifold by the task running on the calling thread.
+	void	recordManifoldEvent(btPersistentManifold* manifold, bool created);
+
+	/// Add to the manifold array (or remove from it) the manifolds created (or released) during
+	/// the parallel pass, in the same order as the single-threaded dispatcher would do.
+	void	replayManifoldEvents();
+
+	int		m_numThreads;
+	bool	m_batchUpdating;
+
+	chrono::ChTaskScheduler*	m_taskScheduler;
+
+	std::mutex	m_allocatorMutex;	///< protects the pool allocators during the parallel pass
+
+	btAlignedObjectArray<btAlignedObjectArray<btManifoldEvent> >	m_taskEvents;	///< events recorded by each task
+
+	btHashMap<btHashPtr,int>	m_sharedObjects;	///< objects whose pairs must be processed sequentially
+	btUnionFind					m_unionFind;
+	btAlignedObjectArray<int>	m_groupTask;		///< task of each group of shared objects
+	btAlignedObjectArray<int>	m_pairTask;			///< task of each pair
+	btAlignedObjectArray<int>	m_taskPairs;		///< indices of pairs, sorted by task
+	btAlignedObjectArray<int>	m_taskStart;		///< start of each task in m_taskPairs (plus end marker)
+};
+
+#endif //BT_COLLISION_DISPATCHER_MT_H
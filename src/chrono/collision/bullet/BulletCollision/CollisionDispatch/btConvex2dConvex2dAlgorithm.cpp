@@ -122,7 +122,9 @@ void btConvex2dConvex2dAlgorithm ::processCollision (btCollisionObject* body0,bt
 
 		btGjkPairDetector::ClosestPointInput input;
 
-		btGjkPairDetector	gjkPairDetector(min0,min1,m_simplexSolver,m_pdSolver);
+		// local simplex solver, because the shared m_simplexSolver is not thread safe (see btCollisionDispatcherMt)
+		btVoronoiSimplexSolver	simplexSolver;
+		btGjkPairDetector	gjkPairDetector(min0,min1,&simplexSolver,m_pdSolver);
 		//TODO: if (dispatchInfo.m_useContinuous)
 		gjkPairDetector.setMinkowskiA(min0);
 		gjkPairDetector.setMinkowskiB(min1);
@@ -110,6 +110,9 @@ void ChElementShellANCF::SetupInitial(ChSystem* system) {
     // Cache the scaling factor (due to change of integration intervals)
     m_GaussScaling = (m_lenX * m_lenY * m_thickness) / 8;
 
+    // Precompute the data at the Gauss points used in the internal force calculation
+    SetupGaussPoints();
+
     // Compute mass matrix and gravitational forces (constant)
     ComputeMassMatrix();
     ComputeGravityForce(system->Get_G_acc());
@@ -280,310 +283,313 @@ void ChElementShellANCF::ComputeGravityForce(const ChVector<>& g_acc) {
 }
 
 // -----------------------------------------------------------------------------
-// Elastic force calculation
+// Gauss point data
 // -----------------------------------------------------------------------------
 
-// The class MyForce provides the integrand for the calculation of the internal forces
-// for one layer of an ANCF shell element.
-// The first 24 entries in the integrand represent the internal force.
-// The next 5 entries represent the residual of the EAS nonlinear system.
-// The last 25 entries represent the 5x5 Jacobian of the EAS nonlinear system.
-// Capabilities of this class include: application of enhanced assumed strain (EAS) and
-// assumed natural strain (ANS) formulations to avoid thickness and (transverse and in-plane)
-// shear locking. This implementation also features a composite material implementation
-// that allows for selecting a number of layers over the element thickness; each of which
-// has an independent, user-selected fiber angle (direction for orthotropic constitutive behavior)
-class MyForce : public ChIntegrable3D<ChMatrixNM<double, 54, 1> > {
-  public:
-    MyForce(ChElementShellANCF* element,         // Containing element
-            size_t kl,                           // Current layer index
-            ChMatrixNM<double, 5, 1>* alpha_eas  // Vector of internal parameters for EAS formulation
-            )
-        : m_element(element), m_kl(kl), m_alpha_eas(alpha_eas) {}
-    ~MyForce() {}
-
-  private:
-    ChElementShellANCF* m_element;
-    size_t m_kl;
-    ChMatrixNM<double, 5, 1>* m_alpha_eas;
-
-    /// Evaluate (strainD'*strain)  at point x, include ANS and EAS.
-    virtual void Evaluate(ChMatrixNM<double, 54, 1>& result, const double x, const double y, const double z) override;
-};
-
-void MyForce::Evaluate(ChMatrixNM<double, 54, 1>& result, const double x, const double y, const double z) {
-    // Element shape function
-    ChMatrixNM<double, 1, 8> N;
-    m_element->ShapeFunctions(N, x, y, z);
-
-    // Determinant of position vector gradient matrix: Initial configuration
-    ChMatrixNM<double, 1, 8> Nx;
-    ChMatrixNM<double, 1, 8> Ny;
-    ChMatrixNM<double, 1, 8> Nz;
-    ChMatrixNM<double, 1, 3> Nx_d0;
-    ChMatrixNM<double, 1, 3> Ny_d0;
-    ChMatrixNM<double, 1, 3> Nz_d0;
-    double detJ0 = m_element->Calc_detJ0(x, y, z, Nx, Ny, Nz, Nx_d0, Ny_d0, Nz_d0);
-
-    // ANS shape function
-    ChMatrixNM<double, 1, 4> S_ANS;  // Shape function vector for Assumed Natural Strain
-    ChMatrixNM<double, 6, 5> M;      // Shape function vector for Enhanced Assumed Strain
-    m_element->ShapeFunctionANSbilinearShell(S_ANS, x, y);
-    m_element->Basis_M(M, x, y, z);
-
-    // Transformation : Orthogonal transformation (A and J)
-    ChVector<double> G1xG2;  // Cross product of first and second column of
-    double G1dotG1;          // Dot product of first column of position vector gradient
-
-    G1xG2.x() = Nx_d0[0][1] * Ny_d0[0][2] - Nx_d0[0][2] * Ny_d0[0][1];
-    G1xG2.y() = Nx_d0[0][2] * Ny_d0[0][0] - Nx_d0[0][0] * Ny_d0[0][2];
-    G1xG2.z() = Nx_d0[0][0] * Ny_d0[0][1] - Nx_d0[0][1] * Ny_d0[0][0];
-    G1dotG1 = Nx_d0[0][0] * Nx_d0[0][0] + Nx_d0[0][1] * Nx_d0[0][1] + Nx_d0[0][2] * Nx_d0[0][2];
+// Precompute the quantities at the Gauss points of all layers that depend only on the
+// initial configuration (shape functions and their derivatives, transformation to the
+// orthotropic material frame, EAS interpolation matrix, quadrature weights), so that the
+// internal force and Jacobian kernels only deal with the current configuration.
+void ChElementShellANCF::SetupGaussPoints() {
+    const std::vector<double>& roots = ChQuadrature::GetStaticTables()->Lroots[1];
+    const std::vector<double>& weights = ChQuadrature::GetStaticTables()->Weight[1];
 
-    // Tangent Frame
-    ChVector<double> A1;
-    ChVector<double> A2;
-    ChVector<double> A3;
-    A1.x() = Nx_d0[0][0];
-    A1.y() = Nx_d0[0][1];
-    A1.z() = Nx_d0[0][2];
-    A1 = A1 / sqrt(G1dotG1);
-    A3 = G1xG2.GetNormalized();
-    A2.Cross(A3, A1);
-
-    // Direction for orthotropic material
-    double theta = m_element->GetLayer(m_kl).Get_theta();  // Fiber angle
-    ChVector<double> AA1;
-    ChVector<double> AA2;
-    ChVector<double> AA3;
-    AA1 = A1 * cos(theta) + A2 * sin(theta);
-    AA2 = -A1 * sin(theta) + A2 * cos(theta);
-    AA3 = A3;
-
-    /// Beta
-    ChMatrixNM<double, 3, 3> j0;
-    ChVector<double> j01;
-    ChVector<double> j02;
-    ChVector<double> j03;
-    ChMatrixNM<double, 9, 1> beta;
-    // Calculates inverse of rd0 (j0) (position vector gradient: Initial Configuration)
-    j0(0, 0) = Ny_d0[0][1] * Nz_d0[0][2] - Nz_d0[0][1] * Ny_d0[0][2];
-    j0(0, 1) = Ny_d0[0][2] * Nz_d0[0][0] - Ny_d0[0][0] * Nz_d0[0][2];
-    j0(0, 2) = Ny_d0[0][0] * Nz_d0[0][1] - Nz_d0[0][0] * Ny_d0[0][1];
-    j0(1, 0) = Nz_d0[0][1] * Nx_d0[0][2] - Nx_d0[0][1] * Nz_d0[0][2];
-    j0(1, 1) = Nz_d0[0][2] * Nx_d0[0][0] - Nx_d0[0][2] * Nz_d0[0][0];
-    j0(1, 2) = Nz_d0[0][0] * Nx_d0[0][1] - Nz_d0[0][1] * Nx_d0[0][0];
-    j0(2, 0) = Nx_d0[0][1] * Ny_d0[0][2] - Ny_d0[0][1] * Nx_d0[0][2];
-    j0(2, 1) = Ny_d0[0][0] * Nx_d0[0][2] - Nx_d0[0][0] * Ny_d0[0][2];
-    j0(2, 2) = Nx_d0[0][0] * Ny_d0[0][1] - Ny_d0[0][0] * Nx_d0[0][1];
-    j0.MatrDivScale(detJ0);
-
-    j01[0] = j0(0, 0);
-    j02[0] = j0(1, 0);
-    j03[0] = j0(2, 0);
-    j01[1] = j0(0, 1);
-    j02[1] = j0(1, 1);
-    j03[1] = j0(2, 1);
-    j01[2] = j0(0, 2);
-    j02[2] = j0(1, 2);
-    j03[2] = j0(2, 2);
-
-    // Coefficients of contravariant transformation
-    beta(0, 0) = Vdot(AA1, j01);
-    beta(1, 0) = Vdot(AA2, j01);
-    beta(2, 0) = Vdot(AA3, j01);
-    beta(3, 0) = Vdot(AA1, j02);
-    beta(4, 0) = Vdot(AA2, j02);
-    beta(5, 0) = Vdot(AA3, j02);
-    beta(6, 0) = Vdot(AA1, j03);
-    beta(7, 0) = Vdot(AA2, j03);
-    beta(8, 0) = Vdot(AA3, j03);
-
-    // Transformation matrix, function of fiber angle
-    const ChMatrixNM<double, 6, 6>& T0 = m_element->GetLayer(m_kl).Get_T0();
-    // Determinant of the initial position vector gradient at the element center
-    double detJ0C = m_element->GetLayer(m_kl).Get_detJ0C();
+    m_gaussPoints.resize(m_numLayers);
 
-    // Enhanced Assumed Strain
-    ChMatrixNM<double, 6, 5> G = T0 * M * (detJ0C / detJ0);
-    ChMatrixNM<double, 6, 1> strain_EAS = G * (*m_alpha_eas);
-
-    ChMatrixNM<double, 8, 1> ddNx;
-    ChMatrixNM<double, 8, 1> ddNy;
-    ChMatrixNM<double, 8, 1> ddNz;
-    ddNx.MatrMultiplyT(m_element->m_ddT, Nx);
-    ddNy.MatrMultiplyT(m_element->m_ddT, Ny);
-    ddNz.MatrMultiplyT(m_element->m_ddT, Nz);
-
-    ChMatrixNM<double, 8, 1> d0d0Nx;
-    ChMatrixNM<double, 8, 1> d0d0Ny;
-    ChMatrixNM<double, 8, 1> d0d0Nz;
-    d0d0Nx.MatrMultiplyT(m_element->m_d0d0T, Nx);
-    d0d0Ny.MatrMultiplyT(m_element->m_d0d0T, Ny);
-    d0d0Nz.MatrMultiplyT(m_element->m_d0d0T, Nz);
-
-    // Strain component
-    ChMatrixNM<double, 6, 1> strain_til;
-    strain_til(0, 0) = 0.5 * ((Nx * ddNx)(0, 0) - (Nx * d0d0Nx)(0, 0));
-    strain_til(1, 0) = 0.5 * ((Ny * ddNy)(0, 0) - (Ny * d0d0Ny)(0, 0));
-    strain_til(2, 0) = (Nx * ddNy)(0, 0) - (Nx * d0d0Ny)(0, 0);
-    strain_til(3, 0) = N(0, 0) * m_element->m_strainANS(0, 0) + N(0, 2) * m_element->m_strainANS(1, 0) +
-                       N(0, 4) * m_element->m_strainANS(2, 0) + N(0, 6) * m_element->m_strainANS(3, 0);
-    strain_til(4, 0) = S_ANS(0, 2) * m_element->m_strainANS(6, 0) + S_ANS(0, 3) * m_element->m_strainANS(7, 0);
-    strain_til(5, 0) = S_ANS(0, 0) * m_element->m_strainANS(4, 0) + S_ANS(0, 1) * m_element->m_strainANS(5, 0);
+    for (size_t kl = 0; kl < m_numLayers; kl++) {
+        GaussPoints& gp = m_gaussPoints[kl];
+
+        // Change of integration interval in the z direction
+        double Zc1 = (m_GaussZ[kl + 1] - m_GaussZ[kl]) / 2;
+        double Zc2 = (m_GaussZ[kl + 1] + m_GaussZ[kl]) / 2;
+
+        double theta = m_layers[kl].Get_theta();
+        const ChMatrixNM<double, 6, 6>& T0 = m_layers[kl].Get_T0();
+        double detJ0C = m_layers[kl].Get_detJ0C();
+        const ChMatrixNM<double, 6, 6>& E_eps = m_layers[kl].GetMaterial()->Get_E_eps();
+
+        gp.KALPHA.Reset();
+
+        for (int ix = 0; ix < 2; ix++) {
+            for (int iy = 0; iy < 2; iy++) {
+                for (int iz = 0; iz < 2; iz++) {
+                    int p = 4 * ix + 2 * iy + iz;
+                    double x = roots[ix];
+                    double y = roots[iy];
+                    double z = Zc1 * roots[iz] + Zc2;
+
+                    // Shape functions and their derivatives
+                    ChMatrixNM<double, 1, 8> N;
+                    ChMatrixNM<double, 1, 8> Nx;
+                    ChMatrixNM<double, 1, 8> Ny;
+                    ChMatrixNM<double, 1, 8> Nz;
+                    ChMatrixNM<double, 1, 3> Nx_d0;
+                    ChMatrixNM<double, 1, 3> Ny_d0;
+                    ChMatrixNM<double, 1, 3> Nz_d0;
+                    ChMatrixNM<double, 1, 4> S_ANS;
+                    ChMatrixNM<double, 6, 5> M;
+                    ShapeFunctions(N, x, y, z);
+                    double detJ0 = Calc_detJ0(x, y, z, Nx, Ny, Nz, Nx_d0, Ny_d0, Nz_d0);
+                    ShapeFunctionANSbilinearShell(S_ANS, x, y);
+                    Basis_M(M, x, y, z);
+
+                    for (int i = 0; i < 4; i++) {
+                        gp.N[i][p] = N(0, 2 * i);
+                        gp.S_ANS[i][p] = S_ANS(0, i);
+                    }
+                    for (int i = 0; i < 8; i++) {
+                        gp.Nx[i][p] = Nx(0, i);
+                        gp.Ny[i][p] = Ny(0, i);
+                    }
+
+                    // Tangent frame and direction of the orthotropic material
+                    ChVector<double> G1(Nx_d0(0, 0), Nx_d0(0, 1), Nx_d0(0, 2));
+                    ChVector<double> G2(Ny_d0(0, 0), Ny_d0(0, 1), Ny_d0(0, 2));
+                    ChVector<double> A1 = G1.GetNormalized();
+                    ChVector<double> A3 = Vcross(G1, G2).GetNormalized();
+                    ChVector<double> A2 = Vcross(A3, A1);
+
+                    ChVector<double> AA1 = A1 * cos(theta) + A2 * sin(theta);
+                    ChVector<double> AA2 = -A1 * sin(theta) + A2 * cos(theta);
+                    ChVector<double> AA3 = A3;
+
+                    // Inverse of the initial position vector gradient
+                    ChMatrixNM<double, 3, 3> j0;
+                    j0(0, 0) = Ny_d0(0, 1) * Nz_d0(0, 2) - Nz_d0(0, 1) * Ny_d0(0, 2);
+                    j0(0, 1) = Ny_d0(0, 2) * Nz_d0(0, 0) - Ny_d0(0, 0) * Nz_d0(0, 2);
+                    j0(0, 2) = Ny_d0(0, 0) * Nz_d0(0, 1) - Nz_d0(0, 0) * Ny_d0(0, 1);
+                    j0(1, 0) = Nz_d0(0, 1) * Nx_d0(0, 2) - Nx_d0(0, 1) * Nz_d0(0, 2);
+                    j0(1, 1) = Nz_d0(0, 2) * Nx_d0(0, 0) - Nx_d0(0, 2) * Nz_d0(0, 0);
+                    j0(1, 2) = Nz_d0(0, 0) * Nx_d0(0, 1) - Nz_d0(0, 1) * Nx_d0(0, 0);
+                    j0(2, 0) = Nx_d0(0, 1) * Ny_d0(0, 2) - Ny_d0(0, 1) * Nx_d0(0, 2);
+                    j0(2, 1) = Ny_d0(0, 0) * Nx_d0(0, 2) - Nx_d0(0, 0) * Ny_d0(0, 2);
+                    j0(2, 2) = Nx_d0(0, 0) * Ny_d0(0, 1) - Ny_d0(0, 0) * Nx_d0(0, 1);
+                    j0.MatrDivScale(detJ0);
+
+                    for (int i = 0; i < 8; i++) {
+                        for (int c = 0; c < 3; c++) {
+                            gp.Gd[c][i][p] = j0(0, c) * Nx(0, i) + j0(1, c) * Ny(0, i) + j0(2, c) * Nz(0, i);
+                        }
+                    }
+
+                    // Coefficients of contravariant transformation
+                    ChVector<double> j01(j0(0, 0), j0(0, 1), j0(0, 2));
+                    ChVector<double> j02(j0(1, 0), j0(1, 1), j0(1, 2));
+                    ChVector<double> j03(j0(2, 0), j0(2, 1), j0(2, 2));
+                    double beta[9] = {Vdot(AA1, j01), Vdot(AA2, j01), Vdot(AA3, j01),
+                                      Vdot(AA1, j02), Vdot(AA2, j02), Vdot(AA3, j02),
+                                      Vdot(AA1, j03), Vdot(AA2, j03), Vdot(AA3, j03)};
+
+                    // Strain transformation to the orthotropic material frame, strain = T * strain_til
+                    static const int rows[6][2] = {{0, 0}, {1, 1}, {0, 1}, {2, 2}, {0, 2}, {1, 2}};
+                    for (int r = 0; r < 6; r++) {
+                        int a = rows[r][0];
+                        int b = rows[r][1];
+                        double f = (a == b) ? 0.5 : 1.0;
+                        gp.T[r][0][p] = 2 * f * beta[a] * beta[b];
+                        gp.T[r][1][p] = 2 * f * beta[3 + a] * beta[3 + b];
+                        gp.T[r][2][p] = f * (beta[a] * beta[3 + b] + beta[b] * beta[3 + a]);
+                        gp.T[r][3][p] = 2 * f * beta[6 + a] * beta[6 + b];
+                        gp.T[r][4][p] = f * (beta[a] * beta[6 + b] + beta[b] * beta[6 + a]);
+                        gp.T[r][5][p] = f * (beta[3 + a] * beta[6 + b] + beta[3 + b] * beta[6 + a]);
+                    }
+
+                    // Enhanced Assumed Strain
+                    ChMatrixNM<double, 6, 5> G = T0 * M * (detJ0C / detJ0);
+                    for (int r = 0; r < 6; r++) {
+                        for (int m = 0; m < 5; m++) {
+                            gp.G[r][m][p] = G(r, m);
+                        }
+                    }
+
+                    // Strain terms of the initial configuration
+                    gp.strain0[0][p] = 0.5 * Vdot(G1, G1);
+                    gp.strain0[1][p] = 0.5 * Vdot(G2, G2);
+                    gp.strain0[2][p] = Vdot(G1, G2);
+
+                    // Quadrature weight, including the change of integration intervals
+                    gp.weight[p] = weights[ix] * weights[iy] * weights[iz] * Zc1 * detJ0 * m_GaussScaling;
+
+                    // The EAS Jacobian does not depend on the current configuration
+                    ChMatrixNM<double, 5, 6> temp56;
+                    temp56.MatrTMultiply(G, E_eps);
+                    gp.KALPHA += (temp56 * G) * gp.weight[p];
+                }
+            }
+        }
+    }
+}
 
-    // For orthotropic material
-    ChMatrixNM<double, 6, 1> strain;
+// -----------------------------------------------------------------------------
+// Elastic force calculation
+// -----------------------------------------------------------------------------
 
-    strain(0, 0) = strain_til(0, 0) * beta(0) * beta(0) + strain_til(1, 0) * beta(3) * beta(3) +
-                   strain_til(2, 0) * beta(0) * beta(3) + strain_til(3, 0) * beta(6) * beta(6) +
-                   strain_til(4, 0) * beta(0) * beta(6) + strain_til(5, 0) * beta(3) * beta(6);
-    strain(1, 0) = strain_til(0, 0) * beta(1) * beta(1) + strain_til(1, 0) * beta(4) * beta(4) +
-                   strain_til(2, 0) * beta(1) * beta(4) + strain_til(3, 0) * beta(7) * beta(7) +
-                   strain_til(4, 0) * beta(1) * beta(7) + strain_til(5, 0) * beta(4) * beta(7);
-    strain(2, 0) = strain_til(0, 0) * 2.0 * beta(0) * beta(1) + strain_til(1, 0) * 2.0 * beta(3) * beta(4) +
-                   strain_til(2, 0) * (beta(1) * beta(3) + beta(0) * beta(4)) +
-                   strain_til(3, 0) * 2.0 * beta(6) * beta(7) +
-                   strain_til(4, 0) * (beta(1) * beta(6) + beta(0) * beta(7)) +
-                   strain_til(5, 0) * (beta(4) * beta(6) + beta(3) * beta(7));
-    strain(3, 0) = strain_til(0, 0) * beta(2) * beta(2) + strain_til(1, 0) * beta(5) * beta(5) +
-                   strain_til(2, 0) * beta(2) * beta(5) + strain_til(3, 0) * beta(8) * beta(8) +
-                   strain_til(4, 0) * beta(2) * beta(8) + strain_til(5, 0) * beta(5) * beta(8);
-    strain(4, 0) = strain_til(0, 0) * 2.0 * beta(0) * beta(2) + strain_til(1, 0) * 2.0 * beta(3) * beta(5) +
-                   strain_til(2, 0) * (beta(2) * beta(3) + beta(0) * beta(5)) +
-                   strain_til(3, 0) * 2.0 * beta(6) * beta(8) +
-                   strain_til(4, 0) * (beta(2) * beta(6) + beta(0) * beta(8)) +
-                   strain_til(5, 0) * (beta(5) * beta(6) + beta(3) * beta(8));
-    strain(5, 0) = strain_til(0, 0) * 2.0 * beta(1) * beta(2) + strain_til(1, 0) * 2.0 * beta(4) * beta(5) +
-                   strain_til(2, 0) * (beta(2) * beta(4) + beta(1) * beta(5)) +
-                   strain_til(3, 0) * 2.0 * beta(7) * beta(8) +
-                   strain_til(4, 0) * (beta(2) * beta(7) + beta(1) * beta(8)) +
-                   strain_til(5, 0) * (beta(5) * beta(7) + beta(4) * beta(8));
+// Evaluate the stresses at all the Gauss points of a layer.
+// Capabilities include: application of enhanced assumed strain (EAS) and assumed natural
+// strain (ANS) formulations to avoid thickness and (transverse and in-plane) shear locking,
+// and a composite material implementation that allows for selecting a number of layers over
+// the element thickness; each of which has an independent, user-selected fiber angle
+// (direction for orthotropic constitutive behavior).
+// All the loops over Gauss points are innermost and operate on contiguous arrays, so that
+// they are vectorized by the compiler (with the available SIMD instruction set).
+void ChElementShellANCF::EvaluateLayerStress(size_t kl,
+                                             const ChMatrixNM<double, 5, 1>& alphaEAS,
+                                             double rx[3][NP],
+                                             double ry[3][NP],
+                                             double stress[6][NP]) {
+    const GaussPoints& gp = m_gaussPoints[kl];
+    const ChMatrixNM<double, 6, 6>& E_eps = m_layers[kl].GetMaterial()->Get_E_eps();
+
+    // Time derivative of the ANS strains
+    ChMatrixNM<double, 8, 1> strainANS_dt;
+    strainANS_dt.MatrMultiply(m_strainANS_D, m_d_dt);
+
+    // Current position vector gradients (x and y columns) and their time derivatives
+    double vx[3][NP];
+    double vy[3][NP];
+    for (int k = 0; k < 3; k++) {
+        for (int p = 0; p < NP; p++) {
+            rx[k][p] = 0;
+            ry[k][p] = 0;
+            vx[k][p] = 0;
+            vy[k][p] = 0;
+        }
+        for (int i = 0; i < 8; i++) {
+            double d = m_d(i, k);
+            double d_dt = m_d_dt(3 * i + k);
+            for (int p = 0; p < NP; p++) {
+                rx[k][p] += gp.Nx[i][p] * d;
+                ry[k][p] += gp.Ny[i][p] * d;
+                vx[k][p] += gp.Nx[i][p] * d_dt;
+                vy[k][p] += gp.Ny[i][p] * d_dt;
+            }
+        }
+    }
 
-    // Strain derivative component
+    // Green-Lagrange strains (with ANS), plus the structural damping term
+    double strain_til[6][NP];
+    for (int p = 0; p < NP; p++) {
+        double xx = rx[0][p] * rx[0][p] + rx[1][p] * rx[1][p] + rx[2][p] * rx[2][p];
+        double yy = ry[0][p] * ry[0][p] + ry[1][p] * ry[1][p] + ry[2][p] * ry[2][p];
+        double xy = rx[0][p] * ry[0][p] + rx[1][p] * ry[1][p] + rx[2][p] * ry[2][p];
+        double xx_dt = rx[0][p] * vx[0][p] + rx[1][p] * vx[1][p] + rx[2][p] * vx[2][p];
+        double yy_dt = ry[0][p] * vy[0][p] + ry[1][p] * vy[1][p] + ry[2][p] * vy[2][p];
+        double xy_dt = rx[0][p] * vy[0][p] + rx[1][p] * vy[1][p] + rx[2][p] * vy[2][p] +
+                       ry[0][p] * vx[0][p] + ry[1][p] * vx[1][p] + ry[2][p] * vx[2][p];
+        strain_til[0][p] = 0.5 * xx - gp.strain0[0][p] + m_Alpha * xx_dt;
+        strain_til[1][p] = 0.5 * yy - gp.strain0[1][p] + m_Alpha * yy_dt;
+        strain_til[2][p] = xy - gp.strain0[2][p] + m_Alpha * xy_dt;
+    }
+    for (int p = 0; p < NP; p++) {
+        strain_til[3][p] = gp.N[0][p] * (m_strainANS(0) + m_Alpha * strainANS_dt(0)) +
+                           gp.N[1][p] * (m_strainANS(1) + m_Alpha * strainANS_dt(1)) +
+                           gp.N[2][p] * (m_strainANS(2) + m_Alpha * strainANS_dt(2)) +
+                           gp.N[3][p] * (m_strainANS(3) + m_Alpha * strainANS_dt(3));
+        strain_til[4][p] = gp.S_ANS[2][p] * (m_strainANS(6) + m_Alpha * strainANS_dt(6)) +
+                           gp.S_ANS[3][p] * (m_strainANS(7) + m_Alpha * strainANS_dt(7));
+        strain_til[5][p] = gp.S_ANS[0][p] * (m_strainANS(4) + m_Alpha * strainANS_dt(4)) +
+                           gp.S_ANS[1][p] * (m_strainANS(5) + m_Alpha * strainANS_dt(5));
+    }
 
-    ChMatrixNM<double, 6, 24> strainD_til;
-    ChMatrixNM<double, 1, 24> tempB;
-    ChMatrixNM<double, 1, 24> tempBB;
-    ChMatrixNM<double, 1, 3> tempB3;
-    ChMatrixNM<double, 1, 3> tempB31;
-    strainD_til.Reset();
-    tempB3.MatrMultiply(Nx, m_element->m_d);
-    for (int i = 0; i < 8; i++) {
-        for (int j = 0; j < 3; j++) {
-            tempB(0, i * 3 + j) = tempB3(0, j) * Nx(0, i);
+    // Strains in the orthotropic material frame, plus the enhanced assumed strains
+    double strain[6][NP];
+    for (int r = 0; r < 6; r++) {
+        for (int p = 0; p < NP; p++)
+            strain[r][p] = 0;
+        for (int s = 0; s < 6; s++) {
+            for (int p = 0; p < NP; p++)
+                strain[r][p] += gp.T[r][s][p] * strain_til[s][p];
         }
-    }
-    strainD_til.PasteClippedMatrix(tempB, 0, 0, 1, 24, 0, 0);
-    tempB3.MatrMultiply(Ny, m_element->m_d);
-    for (int i = 0; i < 8; i++) {
-        for (int j = 0; j < 3; j++) {
-            tempB(0, i * 3 + j) = tempB3(0, j) * Ny(0, i);
+        for (int m = 0; m < 5; m++) {
+            double alpha = alphaEAS(m);
+            for (int p = 0; p < NP; p++)
+                strain[r][p] += gp.G[r][m][p] * alpha;
         }
     }
-    strainD_til.PasteClippedMatrix(tempB, 0, 0, 1, 24, 1, 0);
-    tempB31.MatrMultiply(Nx, m_element->m_d);
-    for (int i = 0; i < 8; i++) {
-        for (int j = 0; j < 3; j++) {
-            tempB(0, i * 3 + j) = tempB3(0, j) * Nx(0, i) + tempB31(0, j) * Ny(0, i);
+
+    // Stresses
+    for (int r = 0; r < 6; r++) {
+        for (int p = 0; p < NP; p++)
+            stress[r][p] = 0;
+        for (int s = 0; s < 6; s++) {
+            double E = E_eps(r, s);
+            for (int p = 0; p < NP; p++)
+                stress[r][p] += E * strain[s][p];
         }
     }
-    strainD_til.PasteClippedMatrix(tempB, 0, 0, 1, 24, 2, 0);
+}
 
-    tempBB.Reset();
-    for (int i = 0; i < 4; i++) {
-        int ij = i * 2;
-        tempB.PasteClippedMatrix(m_element->m_strainANS_D, i, 0, 1, 24, 0, 0);
-        tempB *= N(0, ij);
-        tempBB += tempB;
-    }
-    strainD_til.PasteClippedMatrix(tempBB, 0, 0, 1, 24, 3, 0);  // strainD for zz
-    //
-    tempBB.Reset();
-    for (int i = 0; i < 2; i++) {
-        int ij = i + 6;
-        int ij1 = i + 2;
-        tempB.PasteClippedMatrix(m_element->m_strainANS_D, ij, 0, 1, 24, 0, 0);
-        tempB *= S_ANS(0, ij1);
-        tempBB += tempB;
+// Integrate the internal force (strainD'*stress) and the residual of the EAS nonlinear
+// system (G'*stress) over one layer.
+void ChElementShellANCF::IntegrateLayerForce(size_t kl,
+                                             const ChMatrixNM<double, 5, 1>& alphaEAS,
+                                             ChMatrixNM<double, 24, 1>& Fint,
+                                             ChMatrixNM<double, 5, 1>& HE) {
+    const GaussPoints& gp = m_gaussPoints[kl];
+
+    double rx[3][NP];
+    double ry[3][NP];
+    double stress[6][NP];
+    EvaluateLayerStress(kl, alphaEAS, rx, ry, stress);
+
+    // Weighted stresses, and their transformation to the element frame (T' * stress)
+    double stress_w[6][NP];
+    double stress_til[6][NP];
+    for (int r = 0; r < 6; r++) {
+        for (int p = 0; p < NP; p++)
+            stress_w[r][p] = stress[r][p] * gp.weight[p];
     }
-    strainD_til.PasteClippedMatrix(tempBB, 0, 0, 1, 24, 4, 0);  // strainD for xz
-    //
-    tempBB.Reset();
-    for (int i = 0; i < 2; i++) {
-        int ij = i + 4;
-        int ij1 = i;
-        tempB.PasteClippedMatrix(m_element->m_strainANS_D, ij, 0, 1, 24, 0, 0);
-        tempB *= S_ANS(0, ij1);
-        tempBB += tempB;
+    for (int r = 0; r < 6; r++) {
+        for (int p = 0; p < NP; p++)
+            stress_til[r][p] = 0;
+        for (int s = 0; s < 6; s++) {
+            for (int p = 0; p < NP; p++)
+                stress_til[r][p] += gp.T[s][r][p] * stress_w[s][p];
+        }
     }
-    strainD_til.PasteClippedMatrix(tempBB, 0, 0, 1, 24, 5, 0);  // strainD for yz
 
-    // For orthotropic material
-    ChMatrixNM<double, 6, 24> strainD;  // Derivative of the strains w.r.t. the coordinates. Includes orthotropy
-    for (int ii = 0; ii < 24; ii++) {
-        strainD(0, ii) = strainD_til(0, ii) * beta(0) * beta(0) + strainD_til(1, ii) * beta(3) * beta(3) +
-                         strainD_til(2, ii) * beta(0) * beta(3) + strainD_til(3, ii) * beta(6) * beta(6) +
-                         strainD_til(4, ii) * beta(0) * beta(6) + strainD_til(5, ii) * beta(3) * beta(6);
-        strainD(1, ii) = strainD_til(0, ii) * beta(1) * beta(1) + strainD_til(1, ii) * beta(4) * beta(4) +
-                         strainD_til(2, ii) * beta(1) * beta(4) + strainD_til(3, ii) * beta(7) * beta(7) +
-                         strainD_til(4, ii) * beta(1) * beta(7) + strainD_til(5, ii) * beta(4) * beta(7);
-        strainD(2, ii) = strainD_til(0, ii) * 2.0 * beta(0) * beta(1) + strainD_til(1, ii) * 2.0 * beta(3) * beta(4) +
-                         strainD_til(2, ii) * (beta(1) * beta(3) + beta(0) * beta(4)) +
-                         strainD_til(3, ii) * 2.0 * beta(6) * beta(7) +
-                         strainD_til(4, ii) * (beta(1) * beta(6) + beta(0) * beta(7)) +
-                         strainD_til(5, ii) * (beta(4) * beta(6) + beta(3) * beta(7));
-        strainD(3, ii) = strainD_til(0, ii) * beta(2) * beta(2) + strainD_til(1, ii) * beta(5) * beta(5) +
-                         strainD_til(2, ii) * beta(2) * beta(5) + strainD_til(3, ii) * beta(8) * beta(8) +
-                         strainD_til(4, ii) * beta(2) * beta(8) + strainD_til(5) * beta(5) * beta(8);
-        strainD(4, ii) = strainD_til(0, ii) * 2.0 * beta(0) * beta(2) + strainD_til(1, ii) * 2.0 * beta(3) * beta(5) +
-                         strainD_til(2, ii) * (beta(2) * beta(3) + beta(0) * beta(5)) +
-                         strainD_til(3, ii) * 2.0 * beta(6) * beta(8) +
-                         strainD_til(4, ii) * (beta(2) * beta(6) + beta(0) * beta(8)) +
-                         strainD_til(5, ii) * (beta(5) * beta(6) + beta(3) * beta(8));
-        strainD(5, ii) = strainD_til(0, ii) * 2.0 * beta(1) * beta(2) + strainD_til(1, ii) * 2.0 * beta(4) * beta(5) +
-                         strainD_til(2, ii) * (beta(2) * beta(4) + beta(1) * beta(5)) +
-                         strainD_til(3, ii) * 2.0 * beta(7) * beta(8) +
-                         strainD_til(4, ii) * (beta(2) * beta(7) + beta(1) * beta(8)) +
-                         strainD_til(5, ii) * (beta(5) * beta(7) + beta(4) * beta(8));
+    // EAS residual
+    for (int m = 0; m < 5; m++) {
+        double sum = 0;
+        for (int s = 0; s < 6; s++) {
+            for (int p = 0; p < NP; p++)
+                sum += gp.G[s][m][p] * stress_w[s][p];
+        }
+        HE(m) = sum;
     }
 
-    // Enhanced Assumed Strain 2nd
-    strain += strain_EAS;
-
-    // Strain time derivative for structural damping
-    ChMatrixNM<double, 6, 1> DEPS;
-    DEPS.Reset();
-    for (int ii = 0; ii < 24; ii++) {
-        DEPS(0, 0) = DEPS(0, 0) + strainD(0, ii) * m_element->m_d_dt(ii, 0);
-        DEPS(1, 0) = DEPS(1, 0) + strainD(1, ii) * m_element->m_d_dt(ii, 0);
-        DEPS(2, 0) = DEPS(2, 0) + strainD(2, ii) * m_element->m_d_dt(ii, 0);
-        DEPS(3, 0) = DEPS(3, 0) + strainD(3, ii) * m_element->m_d_dt(ii, 0);
-        DEPS(4, 0) = DEPS(4, 0) + strainD(4, ii) * m_element->m_d_dt(ii, 0);
-        DEPS(5, 0) = DEPS(5, 0) + strainD(5, ii) * m_element->m_d_dt(ii, 0);
+    // Contribution of the in-plane strains, whose derivatives are functions of rx and ry
+    for (int i = 0; i < 8; i++) {
+        double a[NP];
+        double b[NP];
+        for (int p = 0; p < NP; p++) {
+            a[p] = stress_til[0][p] * gp.Nx[i][p] + stress_til[2][p] * gp.Ny[i][p];
+            b[p] = stress_til[1][p] * gp.Ny[i][p] + stress_til[2][p] * gp.Nx[i][p];
+        }
+        for (int k = 0; k < 3; k++) {
+            double sum = 0;
+            for (int p = 0; p < NP; p++)
+                sum += a[p] * rx[k][p] + b[p] * ry[k][p];
+            Fint(3 * i + k) = sum;
+        }
     }
 
-    // Add structural damping
-    strain += DEPS * m_element->m_Alpha;
-
-    // Matrix of elastic coefficients: the input assumes the material *could* be orthotropic
-    const ChMatrixNM<double, 6, 6>& E_eps = m_element->GetLayer(m_kl).GetMaterial()->Get_E_eps();
-
-    // Internal force calculation
-    ChMatrixNM<double, 24, 6> tempC;
-    tempC.MatrTMultiply(strainD, E_eps);
-    ChMatrixNM<double, 24, 1> Fint = (tempC * strain) * (detJ0 * m_element->m_GaussScaling);
-
-    // EAS terms
-    ChMatrixNM<double, 5, 6> temp56;
-    temp56.MatrTMultiply(G, E_eps);
-    ChMatrixNM<double, 5, 1> HE = (temp56 * strain) * (detJ0 * m_element->m_GaussScaling);  // EAS residual
-    ChMatrixNM<double, 5, 5> KALPHA = (temp56 * G) * (detJ0 * m_element->m_GaussScaling);   // EAS Jacobian
-
-    /// Total result vector
-    result.PasteClippedMatrix(Fint, 0, 0, 24, 1, 0, 0);
-    result.PasteClippedMatrix(HE, 0, 0, 5, 1, 24, 0);
-    result.PasteClippedMatrixToVector(KALPHA, 0, 0, 5, 5, 29);
+    // Contribution of the ANS strains, whose derivatives interpolate the rows of m_strainANS_D
+    double c[8] = {0, 0, 0, 0, 0, 0, 0, 0};
+    for (int p = 0; p < NP; p++) {
+        c[0] += stress_til[3][p] * gp.N[0][p];
+        c[1] += stress_til[3][p] * gp.N[1][p];
+        c[2] += stress_til[3][p] * gp.N[2][p];
+        c[3] += stress_til[3][p] * gp.N[3][p];
+        c[4] += stress_til[5][p] * gp.S_ANS[0][p];
+        c[5] += stress_til[5][p] * gp.S_ANS[1][p];
+        c[6] += stress_til[4][p] * gp.S_ANS[2][p];
+        c[7] += stress_til[4][p] * gp.S_ANS[3][p];
+    }
+    for (int j = 0; j < 8; j++) {
+        for (int ii = 0; ii < 24; ii++)
+            Fint(ii) += m_strainANS_D(j, ii) * c[j];
+    }
 }
 
 void ChElementShellANCF::ComputeInternalForces(ChMatrixDynamic<>& Fi) {
@@ -599,27 +605,16 @@ void ChElementShellANCF::ComputeInternalForces(ChMatrixDynamic<>& Fi) {
     for (size_t kl = 0; kl < m_numLayers; kl++) {
         ChMatrixNM<double, 24, 1> Finternal;
         ChMatrixNM<double, 5, 1> HE;
-        ChMatrixNM<double, 5, 5> KALPHA;
+
+        // Jacobian of the EAS nonlinear system (constant)
+        const ChMatrixNM<double, 5, 5>& KALPHA = m_gaussPoints[kl].KALPHA;
 
         // Initial guess for EAS parameters
         ChMatrixNM<double, 5, 1> alphaEAS = m_alphaEAS[kl];
 
         // Newton loop for EAS
         for (int count = 0; count < m_maxIterationsEAS; count++) {
-            ChMatrixNM<double, 54, 1> result;
-            MyForce formula(this, kl, &alphaEAS);
-            ChQuadrature::Integrate3D<ChMatrixNM<double, 54, 1> >(result,   // result of integration
-                                                                  formula,  // integrand formula
-                                                                  -1, 1,    // x limits
-                                                                  -1, 1,    // y limits
-                                                                  m_GaussZ[kl], m_GaussZ[kl + 1],  // z limits
-                                                                  2  // order of integration
-            );
-
-            // Extract vectors and matrices from result of integration
-            Finternal.PasteClippedMatrix(result, 0, 0, 24, 1, 0, 0);
-            HE.PasteClippedMatrix(result, 24, 0, 5, 1, 0, 0);
-            KALPHA.PasteClippedVectorToMatrix(result, 0, 0, 5, 5, 29);
+            IntegrateLayerForce(kl, alphaEAS, Finternal, HE);
 
             // Check convergence (residual check)
             double norm_HE = HE.NormTwo();
@@ -657,393 +652,110 @@ void ChElementShellANCF::ComputeInternalForces(ChMatrixDynamic<>& Fi) {
 // Jacobians of internal forces
 // -----------------------------------------------------------------------------
 
-// The class MyJacobian provides the integrand for the calculation of the Jacobians
-// (stiffness and damping matrices) of the internal forces for one layer of an ANCF
-// shell element.
-// The first 576 entries in the integrated vector represent the 24x24 Jacobian
+// Integrate over one layer the 24x24 Jacobian
 //      Kfactor * [K] + Rfactor * [R]
-// where K does not include the EAS contribution.
-// The last 120 entries represent the 5x24 cross-dependency matrix.
-class MyJacobian : public ChIntegrable3D<ChMatrixNM<double, 696, 1> > {
-  public:
-    MyJacobian(ChElementShellANCF* element,  // Containing element
-               double Kfactor,               // Scaling coefficient for stiffness component
-               double Rfactor,               // Scaling coefficient for damping component
-               size_t kl                     // Current layer index
-               )
-        : m_element(element), m_Kfactor(Kfactor), m_Rfactor(Rfactor), m_kl(kl) {}
-
-  private:
-    ChElementShellANCF* m_element;
-    double m_Kfactor;
-    double m_Rfactor;
-    size_t m_kl;
-
-    // Evaluate integrand at the specified point.
-    virtual void Evaluate(ChMatrixNM<double, 696, 1>& result, const double x, const double y, const double z) override;
-};
-
-void MyJacobian::Evaluate(ChMatrixNM<double, 696, 1>& result, const double x, const double y, const double z) {
-    // Element shape function
-    ChMatrixNM<double, 1, 8> N;
-    m_element->ShapeFunctions(N, x, y, z);
-
-    // Determinant of position vector gradient matrix: Initial configuration
-    ChMatrixNM<double, 1, 8> Nx;
-    ChMatrixNM<double, 1, 8> Ny;
-    ChMatrixNM<double, 1, 8> Nz;
-    ChMatrixNM<double, 1, 3> Nx_d0;
-    ChMatrixNM<double, 1, 3> Ny_d0;
-    ChMatrixNM<double, 1, 3> Nz_d0;
-    double detJ0 = m_element->Calc_detJ0(x, y, z, Nx, Ny, Nz, Nx_d0, Ny_d0, Nz_d0);
-
-    // ANS shape function
-    ChMatrixNM<double, 1, 4> S_ANS;  // Shape function vector for Assumed Natural Strain
-    ChMatrixNM<double, 6, 5> M;      // Shape function vector for Enhanced Assumed Strain
-    m_element->ShapeFunctionANSbilinearShell(S_ANS, x, y);
-    m_element->Basis_M(M, x, y, z);
-
-    // Transformation : Orthogonal transformation (A and J)
-    ChVector<double> G1xG2;  // Cross product of first and second column of
-    double G1dotG1;          // Dot product of first column of position vector gradient
-
-    G1xG2.x() = Nx_d0[0][1] * Ny_d0[0][2] - Nx_d0[0][2] * Ny_d0[0][1];
-    G1xG2.y() = Nx_d0[0][2] * Ny_d0[0][0] - Nx_d0[0][0] * Ny_d0[0][2];
-    G1xG2.z() = Nx_d0[0][0] * Ny_d0[0][1] - Nx_d0[0][1] * Ny_d0[0][0];
-    G1dotG1 = Nx_d0[0][0] * Nx_d0[0][0] + Nx_d0[0][1] * Nx_d0[0][1] + Nx_d0[0][2] * Nx_d0[0][2];
-
-    // Tangent Frame
-    ChVector<double> A1;
-    ChVector<double> A2;
-    ChVector<double> A3;
-    A1.x() = Nx_d0[0][0];
-    A1.y() = Nx_d0[0][1];
-    A1.z() = Nx_d0[0][2];
-    A1 = A1 / sqrt(G1dotG1);
-    A3 = G1xG2.GetNormalized();
-    A2.Cross(A3, A1);
-
-    // Direction for orthotropic material
-    double theta = m_element->GetLayer(m_kl).Get_theta();  // Fiber angle
-    ChVector<double> AA1;
-    ChVector<double> AA2;
-    ChVector<double> AA3;
-    AA1 = A1 * cos(theta) + A2 * sin(theta);
-    AA2 = -A1 * sin(theta) + A2 * cos(theta);
-    AA3 = A3;
-
-    /// Beta
-    ChMatrixNM<double, 3, 3> j0;
-    ChVector<double> j01;
-    ChVector<double> j02;
-    ChVector<double> j03;
-    ChMatrixNM<double, 9, 1> beta;
-    // Calculates inverse of rd0 (j0) (position vector gradient: Initial Configuration)
-    j0(0, 0) = Ny_d0[0][1] * Nz_d0[0][2] - Nz_d0[0][1] * Ny_d0[0][2];
-    j0(0, 1) = Ny_d0[0][2] * Nz_d0[0][0] - Ny_d0[0][0] * Nz_d0[0][2];
-    j0(0, 2) = Ny_d0[0][0] * Nz_d0[0][1] - Nz_d0[0][0] * Ny_d0[0][1];
-    j0(1, 0) = Nz_d0[0][1] * Nx_d0[0][2] - Nx_d0[0][1] * Nz_d0[0][2];
-    j0(1, 1) = Nz_d0[0][2] * Nx_d0[0][0] - Nx_d0[0][2] * Nz_d0[0][0];
-    j0(1, 2) = Nz_d0[0][0] * Nx_d0[0][1] - Nz_d0[0][1] * Nx_d0[0][0];
-    j0(2, 0) = Nx_d0[0][1] * Ny_d0[0][2] - Ny_d0[0][1] * Nx_d0[0][2];
-    j0(2, 1) = Ny_d0[0][0] * Nx_d0[0][2] - Nx_d0[0][0] * Ny_d0[0][2];
-    j0(2, 2) = Nx_d0[0][0] * Ny_d0[0][1] - Ny_d0[0][0] * Nx_d0[0][1];
-    j0.MatrDivScale(detJ0);
-
-    j01[0] = j0(0, 0);
-    j02[0] = j0(1, 0);
-    j03[0] = j0(2, 0);
-    j01[1] = j0(0, 1);
-    j02[1] = j0(1, 1);
-    j03[1] = j0(2, 1);
-    j01[2] = j0(0, 2);
-    j02[2] = j0(1, 2);
-    j03[2] = j0(2, 2);
-
-    // Coefficients of contravariant transformation
-    beta(0, 0) = Vdot(AA1, j01);
-    beta(1, 0) = Vdot(AA2, j01);
-    beta(2, 0) = Vdot(AA3, j01);
-    beta(3, 0) = Vdot(AA1, j02);
-    beta(4, 0) = Vdot(AA2, j02);
-    beta(5, 0) = Vdot(AA3, j02);
-    beta(6, 0) = Vdot(AA1, j03);
-    beta(7, 0) = Vdot(AA2, j03);
-    beta(8, 0) = Vdot(AA3, j03);
-
-    // Transformation matrix, function of fiber angle
-    const ChMatrixNM<double, 6, 6>& T0 = m_element->GetLayer(m_kl).Get_T0();
-    // Determinant of the initial position vector gradient at the element center
-    double detJ0C = m_element->GetLayer(m_kl).Get_detJ0C();
-
-// Enhanced Assumed Strain
-#ifdef CHRONO_HAS_AVX
-    // Referring to test_AVX, expected speed up Vs. non-AVX operation: 1.7x
-    ChMatrixNM<double, 6, 5> G;
-    G.MatrMultiplyAVX(T0, M);
-    G = G * (detJ0C / detJ0);
-#else
-    ChMatrixNM<double, 6, 5> G = T0 * M * (detJ0C / detJ0);
-#endif
-
-    ChMatrixNM<double, 6, 1> strain_EAS = G * m_element->m_alphaEAS[m_kl];
-    ChMatrixNM<double, 8, 1> ddNx;
-    ChMatrixNM<double, 8, 1> ddNy;
-    ChMatrixNM<double, 8, 1> ddNz;
-    ddNx.MatrMultiplyT(m_element->m_ddT, Nx);
-    ddNy.MatrMultiplyT(m_element->m_ddT, Ny);
-    ddNz.MatrMultiplyT(m_element->m_ddT, Nz);
-
-    ChMatrixNM<double, 8, 1> d0d0Nx;
-    ChMatrixNM<double, 8, 1> d0d0Ny;
-    ChMatrixNM<double, 8, 1> d0d0Nz;
-    d0d0Nx.MatrMultiplyT(m_element->m_d0d0T, Nx);
-    d0d0Ny.MatrMultiplyT(m_element->m_d0d0T, Ny);
-    d0d0Nz.MatrMultiplyT(m_element->m_d0d0T, Nz);
-
-    // Strain component
-    ChMatrixNM<double, 6, 1> strain_til;
-    strain_til(0, 0) = 0.5 * ((Nx * ddNx)(0, 0) - (Nx * d0d0Nx)(0, 0));
-    strain_til(1, 0) = 0.5 * ((Ny * ddNy)(0, 0) - (Ny * d0d0Ny)(0, 0));
-    strain_til(2, 0) = (Nx * ddNy)(0, 0) - (Nx * d0d0Ny)(0, 0);
-    strain_til(3, 0) = N(0, 0) * m_element->m_strainANS(0, 0) + N(0, 2) * m_element->m_strainANS(1, 0) +
-                       N(0, 4) * m_element->m_strainANS(2, 0) + N(0, 6) * m_element->m_strainANS(3, 0);
-    strain_til(4, 0) = S_ANS(0, 2) * m_element->m_strainANS(6, 0) + S_ANS(0, 3) * m_element->m_strainANS(7, 0);
-    strain_til(5, 0) = S_ANS(0, 0) * m_element->m_strainANS(4, 0) + S_ANS(0, 1) * m_element->m_strainANS(5, 0);
-
-    // For orthotropic material
-    ChMatrixNM<double, 6, 1> strain;
-
-    strain(0, 0) = strain_til(0, 0) * beta(0) * beta(0) + strain_til(1, 0) * beta(3) * beta(3) +
-                   strain_til(2, 0) * beta(0) * beta(3) + strain_til(3, 0) * beta(6) * beta(6) +
-                   strain_til(4, 0) * beta(0) * beta(6) + strain_til(5, 0) * beta(3) * beta(6);
-    strain(1, 0) = strain_til(0, 0) * beta(1) * beta(1) + strain_til(1, 0) * beta(4) * beta(4) +
-                   strain_til(2, 0) * beta(1) * beta(4) + strain_til(3, 0) * beta(7) * beta(7) +
-                   strain_til(4, 0) * beta(1) * beta(7) + strain_til(5, 0) * beta(4) * beta(7);
-    strain(2, 0) = strain_til(0, 0) * 2.0 * beta(0) * beta(1) + strain_til(1, 0) * 2.0 * beta(3) * beta(4) +
-                   strain_til(2, 0) * (beta(1) * beta(3) + beta(0) * beta(4)) +
-                   strain_til(3, 0) * 2.0 * beta(6) * beta(7) +
-                   strain_til(4, 0) * (beta(1) * beta(6) + beta(0) * beta(7)) +
-                   strain_til(5, 0) * (beta(4) * beta(6) + beta(3) * beta(7));
-    strain(3, 0) = strain_til(0, 0) * beta(2) * beta(2) + strain_til(1, 0) * beta(5) * beta(5) +
-                   strain_til(2, 0) * beta(2) * beta(5) + strain_til(3, 0) * beta(8) * beta(8) +
-                   strain_til(4, 0) * beta(2) * beta(8) + strain_til(5, 0) * beta(5) * beta(8);
-    strain(4, 0) = strain_til(0, 0) * 2.0 * beta(0) * beta(2) + strain_til(1, 0) * 2.0 * beta(3) * beta(5) +
-                   strain_til(2, 0) * (beta(2) * beta(3) + beta(0) * beta(5)) +
-                   strain_til(3, 0) * 2.0 * beta(6) * beta(8) +
-                   strain_til(4, 0) * (beta(2) * beta(6) + beta(0) * beta(8)) +
-                   strain_til(5, 0) * (beta(5) * beta(6) + beta(3) * beta(8));
-    strain(5, 0) = strain_til(0, 0) * 2.0 * beta(1) * beta(2) + strain_til(1, 0) * 2.0 * beta(4) * beta(5) +
-                   strain_til(2, 0) * (beta(2) * beta(4) + beta(1) * beta(5)) +
-                   strain_til(3, 0) * 2.0 * beta(7) * beta(8) +
-                   strain_til(4, 0) * (beta(2) * beta(7) + beta(1) * beta(8)) +
-                   strain_til(5, 0) * (beta(5) * beta(7) + beta(4) * beta(8));
-
-    // Strain derivative component
-
-    ChMatrixNM<double, 6, 24> strainD_til;
-    ChMatrixNM<double, 1, 24> tempB;
-    ChMatrixNM<double, 1, 24> tempBB;
-    ChMatrixNM<double, 1, 3> tempB3;
-    ChMatrixNM<double, 1, 3> tempB31;
-    strainD_til.Reset();
-    // Expected speed up for AVX operation = 1.1x
-    tempB3.MatrMultiply(Nx, m_element->m_d);
-    for (int i = 0; i < 8; i++) {
-        for (int j = 0; j < 3; j++) {
-            tempB(0, i * 3 + j) = tempB3(0, j) * Nx(0, i);
-        }
-    }
-    strainD_til.PasteClippedMatrix(tempB, 0, 0, 1, 24, 0, 0);
-    tempB3.MatrMultiply(Ny, m_element->m_d);
-    for (int i = 0; i < 8; i++) {
-        for (int j = 0; j < 3; j++) {
-            tempB(0, i * 3 + j) = tempB3(0, j) * Ny(0, i);
+// where K does not include the EAS contribution, and the 5x24 EAS cross-dependency matrix.
+// The strain derivatives at all the Gauss points of the layer are stacked in a single 24x48
+// matrix, so that the integrals reduce to two matrix products.
+void ChElementShellANCF::IntegrateLayerJacobian(size_t kl,
+                                                double Kfactor,
+                                                double Rfactor,
+                                                ChMatrixNM<double, 24, 24>& KTE,
+                                                ChMatrixNM<double, 5, 24>& GDEPSP) {
+    const GaussPoints& gp = m_gaussPoints[kl];
+    const ChMatrixNM<double, 6, 6>& E_eps = m_layers[kl].GetMaterial()->Get_E_eps();
+
+    double rx[3][NP];
+    double ry[3][NP];
+    double stress[6][NP];
+    EvaluateLayerStress(kl, m_alphaEAS[kl], rx, ry, stress);
+
+    // Column 6*p+r holds the derivatives of strain component r at Gauss point p
+    ChMatrixNM<double, 24, 6 * NP> strainD;   // strain derivatives (transposed)
+    ChMatrixNM<double, 24, 6 * NP> EstrainD;  // E_eps * strainD, weighted (transposed)
+    ChMatrixNM<double, 5, 6 * NP> GE;         // G' * E_eps, weighted
+
+    // Geometric stiffness, the same for the three coordinate directions
+    ChMatrixNM<double, 8, 8> H;
+
+    double KRfactor = Kfactor + Rfactor * m_Alpha;
+
+    for (int p = 0; p < NP; p++) {
+        // Strain derivatives in the element frame
+        double strainD_til[6][24];
+        for (int i = 0; i < 8; i++) {
+            for (int k = 0; k < 3; k++) {
+                strainD_til[0][3 * i + k] = gp.Nx[i][p] * rx[k][p];
+                strainD_til[1][3 * i + k] = gp.Ny[i][p] * ry[k][p];
+                strainD_til[2][3 * i + k] = gp.Nx[i][p] * ry[k][p] + gp.Ny[i][p] * rx[k][p];
+            }
         }
-    }
-    strainD_til.PasteClippedMatrix(tempB, 0, 0, 1, 24, 1, 0);
-    tempB31.MatrMultiply(Nx, m_element->m_d);
-    for (int i = 0; i < 8; i++) {
-        for (int j = 0; j < 3; j++) {
-            tempB(0, i * 3 + j) = tempB3(0, j) * Nx(0, i) + tempB31(0, j) * Ny(0, i);
+        for (int ii = 0; ii < 24; ii++) {
+            strainD_til[3][ii] = gp.N[0][p] * m_strainANS_D(0, ii) + gp.N[1][p] * m_strainANS_D(1, ii) +
+                                 gp.N[2][p] * m_strainANS_D(2, ii) + gp.N[3][p] * m_strainANS_D(3, ii);
+            strainD_til[4][ii] = gp.S_ANS[2][p] * m_strainANS_D(6, ii) + gp.S_ANS[3][p] * m_strainANS_D(7, ii);
+            strainD_til[5][ii] = gp.S_ANS[0][p] * m_strainANS_D(4, ii) + gp.S_ANS[1][p] * m_strainANS_D(5, ii);
         }
-    }
-    strainD_til.PasteClippedMatrix(tempB, 0, 0, 1, 24, 2, 0);
-
-    tempBB.Reset();
-    for (int i = 0; i < 4; i++) {
-        int ij = i * 2;
-        tempB.PasteClippedMatrix(m_element->m_strainANS_D, i, 0, 1, 24, 0, 0);
-        tempB *= N(0, ij);
-        tempBB += tempB;
-    }
-    strainD_til.PasteClippedMatrix(tempBB, 0, 0, 1, 24, 3, 0);  // strainD for zz
-    //
-    tempBB.Reset();
-    for (int i = 0; i < 2; i++) {
-        int ij = i + 6;
-        int ij1 = i + 2;
-        tempB.PasteClippedMatrix(m_element->m_strainANS_D, ij, 0, 1, 24, 0, 0);
-        tempB *= S_ANS(0, ij1);
-        tempBB += tempB;
-    }
-    strainD_til.PasteClippedMatrix(tempBB, 0, 0, 1, 24, 4, 0);  // strainD for xz
-    //
-    tempBB.Reset();
-    for (int i = 0; i < 2; i++) {
-        int ij = i + 4;
-        int ij1 = i;
-        tempB.PasteClippedMatrix(m_element->m_strainANS_D, ij, 0, 1, 24, 0, 0);
-        tempB *= S_ANS(0, ij1);
-        tempBB += tempB;
-    }
-    strainD_til.PasteClippedMatrix(tempBB, 0, 0, 1, 24, 5, 0);  // strainD for yz
-
-    //// For orthotropic material
-    ChMatrixNM<double, 6, 24> strainD;  // Derivative of the strains w.r.t. the coordinates. Includes orthotropy
-    for (int ii = 0; ii < 24; ii++) {
-        strainD(0, ii) = strainD_til(0, ii) * beta(0) * beta(0) + strainD_til(1, ii) * beta(3) * beta(3) +
-                         strainD_til(2, ii) * beta(0) * beta(3) + strainD_til(3, ii) * beta(6) * beta(6) +
-                         strainD_til(4, ii) * beta(0) * beta(6) + strainD_til(5, ii) * beta(3) * beta(6);
-        strainD(1, ii) = strainD_til(0, ii) * beta(1) * beta(1) + strainD_til(1, ii) * beta(4) * beta(4) +
-                         strainD_til(2, ii) * beta(1) * beta(4) + strainD_til(3, ii) * beta(7) * beta(7) +
-                         strainD_til(4, ii) * beta(1) * beta(7) + strainD_til(5, ii) * beta(4) * beta(7);
-        strainD(2, ii) = strainD_til(0, ii) * 2.0 * beta(0) * beta(1) + strainD_til(1, ii) * 2.0 * beta(3) * beta(4) +
-                         strainD_til(2, ii) * (beta(1) * beta(3) + beta(0) * beta(4)) +
-                         strainD_til(3, ii) * 2.0 * beta(6) * beta(7) +
-                         strainD_til(4, ii) * (beta(1) * beta(6) + beta(0) * beta(7)) +
-                         strainD_til(5, ii) * (beta(4) * beta(6) + beta(3) * beta(7));
-        strainD(3, ii) = strainD_til(0, ii) * beta(2) * beta(2) + strainD_til(1, ii) * beta(5) * beta(5) +
-                         strainD_til(2, ii) * beta(2) * beta(5) + strainD_til(3, ii) * beta(8) * beta(8) +
-                         strainD_til(4, ii) * beta(2) * beta(8) + strainD_til(5) * beta(5) * beta(8);
-        strainD(4, ii) = strainD_til(0, ii) * 2.0 * beta(0) * beta(2) + strainD_til(1, ii) * 2.0 * beta(3) * beta(5) +
-                         strainD_til(2, ii) * (beta(2) * beta(3) + beta(0) * beta(5)) +
-                         strainD_til(3, ii) * 2.0 * beta(6) * beta(8) +
-                         strainD_til(4, ii) * (beta(2) * beta(6) + beta(0) * beta(8)) +
-                         strainD_til(5, ii) * (beta(5) * beta(6) + beta(3) * beta(8));
-        strainD(5, ii) = strainD_til(0, ii) * 2.0 * beta(1) * beta(2) + strainD_til(1, ii) * 2.0 * beta(4) * beta(5) +
-                         strainD_til(2, ii) * (beta(2) * beta(4) + beta(1) * beta(5)) +
-                         strainD_til(3, ii) * 2.0 * beta(7) * beta(8) +
-                         strainD_til(4, ii) * (beta(2) * beta(7) + beta(1) * beta(8)) +
-                         strainD_til(5, ii) * (beta(5) * beta(7) + beta(4) * beta(8));
-    }
-
-    /// Gd : Jacobian (w.r.t. coordinates) of the initial position vector gradient matrix
-    ChMatrixNM<double, 9, 24> Gd;
 
-    for (int ii = 0; ii < 8; ii++) {
-        Gd(0, 3 * (ii)) = j0(0, 0) * Nx(0, ii) + j0(1, 0) * Ny(0, ii) + j0(2, 0) * Nz(0, ii);
-        Gd(1, 3 * (ii) + 1) = j0(0, 0) * Nx(0, ii) + j0(1, 0) * Ny(0, ii) + j0(2, 0) * Nz(0, ii);
-        Gd(2, 3 * (ii) + 2) = j0(0, 0) * Nx(0, ii) + j0(1, 0) * Ny(0, ii) + j0(2, 0) * Nz(0, ii);
-
-        Gd(3, 3 * (ii)) = j0(0, 1) * Nx(0, ii) + j0(1, 1) * Ny(0, ii) + j0(2, 1) * Nz(0, ii);
-        Gd(4, 3 * (ii) + 1) = j0(0, 1) * Nx(0, ii) + j0(1, 1) * Ny(0, ii) + j0(2, 1) * Nz(0, ii);
-        Gd(5, 3 * (ii) + 2) = j0(0, 1) * Nx(0, ii) + j0(1, 1) * Ny(0, ii) + j0(2, 1) * Nz(0, ii);
+        // Strain derivatives in the orthotropic material frame
+        double sD[6][24];
+        for (int r = 0; r < 6; r++) {
+            for (int ii = 0; ii < 24; ii++)
+                sD[r][ii] = 0;
+            for (int s = 0; s < 6; s++) {
+                double T = gp.T[r][s][p];
+                for (int ii = 0; ii < 24; ii++)
+                    sD[r][ii] += T * strainD_til[s][ii];
+            }
+        }
 
-        Gd(6, 3 * (ii)) = j0(0, 2) * Nx(0, ii) + j0(1, 2) * Ny(0, ii) + j0(2, 2) * Nz(0, ii);
-        Gd(7, 3 * (ii) + 1) = j0(0, 2) * Nx(0, ii) + j0(1, 2) * Ny(0, ii) + j0(2, 2) * Nz(0, ii);
-        Gd(8, 3 * (ii) + 2) = j0(0, 2) * Nx(0, ii) + j0(1, 2) * Ny(0, ii) + j0(2, 2) * Nz(0, ii);
-    }
+        double w = gp.weight[p];
+        for (int r = 0; r < 6; r++) {
+            for (int ii = 0; ii < 24; ii++) {
+                double EsD = 0;
+                for (int s = 0; s < 6; s++)
+                    EsD += E_eps(r, s) * sD[s][ii];
+                strainD(ii, 6 * p + r) = sD[r][ii];
+                EstrainD(ii, 6 * p + r) = EsD * (w * KRfactor);
+            }
+            for (int m = 0; m < 5; m++) {
+                double GE_mr = 0;
+                for (int s = 0; s < 6; s++)
+                    GE_mr += gp.G[s][m][p] * E_eps(s, r);
+                GE(m, 6 * p + r) = GE_mr * w;
+            }
+        }
 
-    // Enhanced Assumed Strain 2nd
-    strain += strain_EAS;
-
-    // Structural damping
-    // Strain time derivative for structural damping
-    ChMatrixNM<double, 6, 1> DEPS;
-    DEPS.Reset();
-    for (int ii = 0; ii < 24; ii++) {
-        DEPS(0, 0) = DEPS(0, 0) + strainD(0, ii) * m_element->m_d_dt(ii, 0);
-        DEPS(1, 0) = DEPS(1, 0) + strainD(1, ii) * m_element->m_d_dt(ii, 0);
-        DEPS(2, 0) = DEPS(2, 0) + strainD(2, ii) * m_element->m_d_dt(ii, 0);
-        DEPS(3, 0) = DEPS(3, 0) + strainD(3, ii) * m_element->m_d_dt(ii, 0);
-        DEPS(4, 0) = DEPS(4, 0) + strainD(4, ii) * m_element->m_d_dt(ii, 0);
-        DEPS(5, 0) = DEPS(5, 0) + strainD(5, ii) * m_element->m_d_dt(ii, 0);
+        // Geometric stiffness: Gd' * Sigm * Gd, with Sigm the (block-diagonal) stress tensor
+        double wK = w * Kfactor;
+        double Sigm[3][3] = {{stress[0][p] * wK, stress[2][p] * wK, stress[4][p] * wK},
+                             {stress[2][p] * wK, stress[1][p] * wK, stress[5][p] * wK},
+                             {stress[4][p] * wK, stress[5][p] * wK, stress[3][p] * wK}};
+        double SGd[3][8];
+        for (int a = 0; a < 3; a++) {
+            for (int j = 0; j < 8; j++)
+                SGd[a][j] = Sigm[a][0] * gp.Gd[0][j][p] + Sigm[a][1] * gp.Gd[1][j][p] + Sigm[a][2] * gp.Gd[2][j][p];
+        }
+        for (int i = 0; i < 8; i++) {
+            for (int j = 0; j < 8; j++)
+                H(i, j) += gp.Gd[0][i][p] * SGd[0][j] + gp.Gd[1][i][p] * SGd[1][j] + gp.Gd[2][i][p] * SGd[2][j];
+        }
     }
 
-    // Add structural damping
-    strain += DEPS * m_element->m_Alpha;
-
-    // Matrix of elastic coefficients: The input assumes the material *could* be orthotropic
-    const ChMatrixNM<double, 6, 6>& E_eps = m_element->GetLayer(m_kl).GetMaterial()->Get_E_eps();
-
-    // Stress tensor calculation
-    ChMatrixNM<double, 6, 1> stress;
-    stress.MatrMultiply(E_eps, strain);
-
-    // Declaration and computation of Sigm, to be removed
-    ChMatrixNM<double, 9, 9> Sigm;  ///< Rearrangement of stress vector (not always needed)
-
-    Sigm(0, 0) = stress(0, 0);  // XX
-    Sigm(1, 1) = stress(0, 0);
-    Sigm(2, 2) = stress(0, 0);
-
-    Sigm(0, 3) = stress(2, 0);  // XY
-    Sigm(1, 4) = stress(2, 0);
-    Sigm(2, 5) = stress(2, 0);
-
-    Sigm(0, 6) = stress(4, 0);  // XZ
-    Sigm(1, 7) = stress(4, 0);
-    Sigm(2, 8) = stress(4, 0);
-
-    Sigm(3, 0) = stress(2, 0);  // XY
-    Sigm(4, 1) = stress(2, 0);
-    Sigm(5, 2) = stress(2, 0);
-
-    Sigm(3, 3) = stress(1, 0);  // YY
-    Sigm(4, 4) = stress(1, 0);
-    Sigm(5, 5) = stress(1, 0);
-
-    Sigm(3, 6) = stress(5, 0);  // YZ
-    Sigm(4, 7) = stress(5, 0);
-    Sigm(5, 8) = stress(5, 0);
-
-    Sigm(6, 0) = stress(4, 0);  // XZ
-    Sigm(7, 1) = stress(4, 0);
-    Sigm(8, 2) = stress(4, 0);
-
-    Sigm(6, 3) = stress(5, 0);  // YZ
-    Sigm(7, 4) = stress(5, 0);
-    Sigm(8, 5) = stress(5, 0);
-
-    Sigm(6, 6) = stress(3, 0);  // ZZ
-    Sigm(7, 7) = stress(3, 0);
-    Sigm(8, 8) = stress(3, 0);
-
-    // Jacobian of internal forces (excluding the EAS contribution).
-    ChMatrixNM<double, 24, 6> temp246;
-    ChMatrixNM<double, 24, 9> temp249;
-    temp246.MatrTMultiply(strainD, E_eps);
-    temp249.MatrTMultiply(Gd, Sigm);
-    ChMatrixNM<double, 24, 24> KTE;
-
-#ifdef CHRONO_HAS_AVX
-    ChMatrixNM<double, 24, 24> KTE_temp1;
-    ChMatrixNM<double, 24, 24> KTE_temp2;
-    KTE_temp1.MatrMultiplyAVX(temp246, strainD);
-    KTE_temp2.MatrMultiplyAVX(temp249, Gd);
-    KTE = KTE_temp1 * (m_Kfactor + m_Rfactor * m_element->m_Alpha) + KTE_temp2 * m_Kfactor;
-#else
-    KTE = (temp246 * strainD) * (m_Kfactor + m_Rfactor * m_element->m_Alpha) + (temp249 * Gd) * m_Kfactor;
-#endif
-
-    KTE *= detJ0 * (m_element->m_GaussScaling);
-
-    // EAS cross-dependency matrix.
-    ChMatrixNM<double, 5, 6> temp56;
-    temp56.MatrTMultiply(G, E_eps);
-
 #ifdef CHRONO_HAS_AVX
-    ChMatrixNM<double, 5, 24> GDEPSP;
-    GDEPSP.MatrMultiplyAVX(temp56, strainD);
-    GDEPSP = GDEPSP * (detJ0 * m_element->m_GaussScaling);
+    KTE.MatrMultiplyTAVX(strainD, EstrainD);
+    GDEPSP.MatrMultiplyTAVX(GE, strainD);
 #else
-    ChMatrixNM<double, 5, 24> GDEPSP = (temp56 * strainD) * (detJ0 * m_element->m_GaussScaling);
+    KTE.MatrMultiplyT(strainD, EstrainD);
+    GDEPSP.MatrMultiplyT(GE, strainD);
 #endif
 
-    // Load result vector (integrand)
-    result.PasteClippedMatrixToVector(KTE, 0, 0, 24, 24, 0);
-    result.PasteClippedMatrixToVector(GDEPSP, 0, 0, 5, 24, 576);
+    for (int i = 0; i < 8; i++) {
+        for (int j = 0; j < 8; j++) {
+            for (int k = 0; k < 3; k++)
+                KTE(3 * i + k, 3 * j + k) += H(i, j);
+        }
+    }
 }
 
 void ChElementShellANCF::ComputeInternalJacobians(double Kfactor, double Rfactor) {
@@ -1056,21 +768,9 @@ void ChElementShellANCF::ComputeInternalJacobians(double Kfactor, double Rfactor
 
     // Loop over all layers.
     for (size_t kl = 0; kl < m_numLayers; kl++) {
-        ChMatrixNM<double, 696, 1> result;
-        MyJacobian formula(this, Kfactor, Rfactor, kl);
-        ChQuadrature::Integrate3D<ChMatrixNM<double, 696, 1> >(result,                          // result of integration
-                                                               formula,                         // integrand formula
-                                                               -1, 1,                           // x limits
-                                                               -1, 1,                           // y limits
-                                                               m_GaussZ[kl], m_GaussZ[kl + 1],  // z limits
-                                                               2                                // order of integration
-        );
-
-        // Extract matrices from result of integration
         ChMatrixNM<double, 24, 24> KTE;
         ChMatrixNM<double, 5, 24> GDEPSP;
-        KTE.PasteClippedVectorToMatrix(result, 0, 0, 24, 24, 0);
-        GDEPSP.PasteClippedVectorToMatrix(result, 0, 0, 5, 24, 576);
+        IntegrateLayerJacobian(kl, Kfactor, Rfactor, KTE, GDEPSP);
 
         // Include EAS contribution to the stiffness component (hence scaled by Kfactor)
         ChMatrixNM<double, 5, 5> KalphaEAS_inv;
@@ -113,8 +113,6 @@ class ChApi ChElementShellANCF : public ChElementShell, public ChLoadableUV, pub
         ChMatrixNM<double, 6, 6> m_T0;
 
         friend class ChElementShellANCF;
-        friend class MyForce;
-        friend class MyJacobian;
     };
 
     /// Get the number of nodes used by this element.
@@ -232,6 +230,26 @@ class ChApi ChElementShellANCF : public ChElementShell, public ChLoadableUV, pub
     static const double m_toleranceEAS;                    ///< tolerance for nonlinear EAS solver (on residual)
     static const int m_maxIterationsEAS;                   ///< maximum number of nonlinear EAS iterations
 
+    /// Number of Gauss points in each layer (2x2x2 quadrature).
+    static const int NP = 8;
+
+    /// Quantities at the Gauss points of a layer that depend only on the initial configuration.
+    /// Arrays are stored with the Gauss point index last (structure of arrays), so that the
+    /// internal force and Jacobian kernels process the Gauss points of a layer in SIMD lanes.
+    struct GaussPoints {
+        double N[4][NP];        ///< shape functions N(0), N(2), N(4), N(6) (ANS interpolation of strain zz)
+        double S_ANS[4][NP];    ///< ANS shape functions
+        double Nx[8][NP];       ///< shape function derivatives w.r.t. x
+        double Ny[8][NP];       ///< shape function derivatives w.r.t. y
+        double Gd[3][8][NP];    ///< shape function derivatives w.r.t. the initial position (columns of j0)
+        double T[6][6][NP];     ///< transformation of strains to the orthotropic material frame
+        double G[6][5][NP];     ///< EAS interpolation matrix T0 * M * (detJ0C / detJ0)
+        double strain0[3][NP];  ///< in-plane strain terms of the initial configuration
+        double weight[NP];      ///< quadrature weight, including detJ0 and the interval scaling
+        ChMatrixNM<double, 5, 5> KALPHA;  ///< EAS Jacobian (constant for a linear material)
+    };
+    std::vector<GaussPoints> m_gaussPoints;  ///< precomputed Gauss point data (one set per layer)
+
   public:
     // Interface to ChElementBase base class
     // -------------------------------------
@@ -330,6 +348,31 @@ class ChApi ChElementShellANCF : public ChElementShell, public ChLoadableUV, pub
     // Calculate the current 24x1 matrix of nodal coordinate derivatives.
     void CalcCoordDerivMatrix(ChMatrixNM<double, 24, 1>& dt);
 
+    // Precompute the data at the Gauss points of all layers (initial configuration).
+    void SetupGaussPoints();
+
+    // Evaluate the stresses at the Gauss points of the specified layer, for the given EAS parameters.
+    // Also return the current position vector gradients rx and ry at the Gauss points.
+    void EvaluateLayerStress(size_t kl,
+                             const ChMatrixNM<double, 5, 1>& alphaEAS,
+                             double rx[3][NP],
+                             double ry[3][NP],
+                             double stress[6][NP]);
+
+    // Integrate the internal force and the EAS residual over the specified layer.
+    void IntegrateLayerForce(size_t kl,
+                             const ChMatrixNM<double, 5, 1>& alphaEAS,
+                             ChMatrixNM<double, 24, 1>& Fint,
+                             ChMatrixNM<double, 5, 1>& HE);
+
+    // Integrate the Jacobian of the internal force (without EAS contribution) and the EAS
+    // cross-dependency matrix over the specified layer.
+    void IntegrateLayerJacobian(size_t kl,
+                                double Kfactor,
+                                double Rfactor,
+                                ChMatrixNM<double, 24, 24>& KTE,
+                                ChMatrixNM<double, 5, 24>& GDEPSP);
+
     // Helper functions
     // ----------------
 
@@ -416,8 +459,6 @@ class ChApi ChElementShellANCF : public ChElementShell, public ChLoadableUV, pub
 
     friend class MyMass;
     friend class MyGravity;
-    friend class MyForce;
-    friend class MyJacobian;
 };
 
 /// @} fea_elements
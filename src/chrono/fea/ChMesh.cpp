@@ -18,6 +18,7 @@
 #include <iostream>
 #include <sstream>
 #include <string>
+#include <unordered_map>
 
 #include "chrono/core/ChMath.h"
 #include "chrono/physics/ChLoad.h"
@@ -46,6 +47,8 @@ ChMesh::ChMesh(const ChMesh& other) : ChIndexedNodes(other) {
     automatic_gravity_load = other.automatic_gravity_load;
     num_points_gravity = other.num_points_gravity;
 
+    coloring_valid = false;
+
     ncalls_internal_forces = 0;
     ncalls_KRMload = 0;
 }
@@ -62,6 +65,8 @@ void ChMesh::SetupInitial() {
         }
     }
 
+    coloring_valid = false;
+
     for (unsigned int i = 0; i < velements.size(); i++) {
         //    - precompute matrices, such as the [Kl] local stiffness of each element, if needed, etc.
         velements[i]->SetupInitial(GetSystem());
@@ -89,17 +94,70 @@ void ChMesh::AddNode(std::shared_ptr<ChNodeFEAbase> m_node) {
 
 void ChMesh::AddElement(std::shared_ptr<ChElementBase> m_elem) {
     velements.push_back(m_elem);
+    coloring_valid = false;
 }
 
 void ChMesh::ClearElements() {
     velements.clear();
     vcontactsurfaces.clear();
+    coloring_valid = false;
 }
 
 void ChMesh::ClearNodes() {
     velements.clear();
     vnodes.clear();
     vcontactsurfaces.clear();
+    coloring_valid = false;
+}
+
+// Maximum number of colors; elements that cannot be colored are processed serially
+#define CH_MESH_MAX_COLORS 64
+
+void ChMesh::UpdateElementColoring() {
+    // Greedy coloring: each element takes the first color not used yet by the elements
+    // sharing one of its nodes (colors used at each node are kept as a bit mask).
+    std::unordered_map<ChNodeFEAbase*, uint64_t> node_colors;
+    std::vector<int> element_color(velements.size());
+    std::vector<int> color_count(CH_MESH_MAX_COLORS, 0);
+
+    serial_elements.clear();
+    for (unsigned int ie = 0; ie < velements.size(); ie++) {
+        int nnodes = velements[ie]->GetNnodes();
+        uint64_t used = 0;
+        for (int in = 0; in < nnodes; in++)
+            used |= node_colors[velements[ie]->GetNodeN(in).get()];
+
+        if (used == ~uint64_t(0)) {
+            element_color[ie] = -1;
+            serial_elements.push_back(ie);
+            continue;
+        }
+
+        int color = 0;
+        while (used & (uint64_t(1) << color))
+            color++;
+        for (int in = 0; in < nnodes; in++)
+            node_colors[velements[ie]->GetNodeN(in).get()] |= uint64_t(1) << color;
+        element_color[ie] = color;
+        color_count[color]++;
+    }
+
+    int ncolors = 0;
+    while (ncolors < CH_MESH_MAX_COLORS && color_count[ncolors] > 0)
+        ncolors++;
+
+    color_ptr.assign(ncolors + 1, 0);
+    for (int ic = 0; ic < ncolors; ic++)
+        color_ptr[ic + 1] = color_ptr[ic] + color_count[ic];
+
+    std::vector<int> fill(color_ptr.begin(), color_ptr.end() - 1);
+    color_elements.resize(color_ptr[ncolors]);
+    for (unsigned int ie = 0; ie < velements.size(); ie++) {
+        if (element_color[ie] >= 0)
+            color_elements[fill[element_color[ie]]++] = ie;
+    }
+
+    coloring_valid = true;
 }
 
 void ChMesh::AddContactSurface(std::shared_ptr<ChContactSurface> m_surf) {
@@ -259,12 +317,18 @@ void ChMesh::IntLoadResidual_F(const unsigned int off,
         }
     }
 
-    // internal forces
+    // internal forces: elements of the same color do not share nodes, so they can
+    // add their forces to R concurrently
     timer_internal_forces.start();
-#pragma omp parallel for schedule(dynamic, 4)
-    for (int ie = 0; ie < velements.size(); ie++) {
-        velements[ie]->EleIntLoadResidual_F(R, c);
+    if (!coloring_valid)
+        UpdateElementColoring();
+    auto scheduler = GetSystem()->GetTaskScheduler();
+    for (int ic = 0; ic + 1 < (int)color_ptr.size(); ic++) {
+        scheduler->ParallelFor(color_ptr[ic], color_ptr[ic + 1],
+                               [&](int k) { velements[color_elements[k]]->EleIntLoadResidual_F(R, c); }, 4);
     }
+    for (auto ie : serial_elements)
+        velements[ie]->EleIntLoadResidual_F(R, c);
     timer_internal_forces.stop();
     ncalls_internal_forces++;
 
@@ -368,9 +432,9 @@ void ChMesh::InjectKRMmatrices(ChSystemDescriptor& mdescriptor) {
 
 void ChMesh::KRMmatricesLoad(double Kfactor, double Rfactor, double Mfactor) {
     timer_KRMload.start();
-#pragma omp parallel for
-    for (int ie = 0; ie < velements.size(); ie++)
-        velements[ie]->KRMmatricesLoad(Kfactor, Rfactor, Mfactor);
+    // Each element only writes its own KRM block: elements are processed as tasks of the system scheduler.
+    GetSystem()->GetTaskScheduler()->ParallelFor(
+        0, (int)velements.size(), [&](int ie) { velements[ie]->KRMmatricesLoad(Kfactor, Rfactor, Mfactor); }, 4);
     timer_KRMload.stop();
     ncalls_KRMload++;
 }
@@ -56,6 +56,12 @@ class ChApi ChMesh : public ChIndexedNodes {
     int ncalls_internal_forces;
     int ncalls_KRMload;
 
+    // Schedule for the parallel evaluation of internal forces (see UpdateElementColoring)
+    bool coloring_valid;               ///< false if the schedule must be rebuilt
+    std::vector<int> color_ptr;        ///< start of each color in color_elements
+    std::vector<int> color_elements;   ///< indices of the elements, sorted by color
+    std::vector<int> serial_elements;  ///< indices of the elements that could not be colored
+
   public:
     ChMesh()
         : n_dofs(0),
@@ -63,7 +69,8 @@ class ChApi ChMesh : public ChIndexedNodes {
           automatic_gravity_load(true),
           num_points_gravity(1),
           ncalls_internal_forces(0),
-          ncalls_KRMload(0) {}
+          ncalls_KRMload(0),
+          coloring_valid(false) {}
     ChMesh(const ChMesh& other);
     ~ChMesh() {}
 
@@ -119,6 +126,13 @@ class ChApi ChMesh : public ChIndexedNodes {
     /// Get cumulative time for Jacobian load calls.
     double GetTimeJacobianLoad() { return timer_KRMload(); }
 
+    /// Partition the elements in colors, such that elements with the same color do not share any
+    /// node. Elements with the same color can then load their internal forces concurrently in
+    /// IntLoadResidual_F(), without races on the residual of the shared nodes.
+    /// This is done automatically when needed, after elements are added or removed; call it
+    /// explicitly if the nodes of some element are changed after the first analysis.
+    void UpdateElementColoring();
+
     /// Add a contact surface.
     void AddContactSurface(std::shared_ptr<ChContactSurface> m_surf);
 
@@ -0,0 +1,179 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+
+#include "chrono/parallel/ChTaskScheduler.h"
+
+namespace chrono {
+
+// Scheduler and queue of the calling thread, if it is a worker thread.
+static thread_local const ChTaskScheduler* tls_scheduler = nullptr;
+static thread_local int tls_queue = 0;
+
+// Number of attempts of an idle worker to find a task, before going to sleep.
+static const int idle_spins = 64;
+
+// -----------------------------------------------------------------------------
+
+void ChTaskScheduler::TaskGroup::Run(Task task) {
+    if (scheduler.m_num_threads < 2) {
+        task();
+        return;
+    }
+    pending.fetch_add(1, std::memory_order_relaxed);
+    scheduler.Submit(std::move(task), this);
+}
+
+void ChTaskScheduler::TaskGroup::Wait() {
+    while (pending.load(std::memory_order_acquire) > 0) {
+        if (!scheduler.ExecuteOne())
+            std::this_thread::yield();
+    }
+}
+
+// -----------------------------------------------------------------------------
+
+ChTaskScheduler::ChTaskScheduler(int num_threads) : m_num_threads(0), m_started(false), m_num_queued(0), m_stop(false) {
+    SetNumThreads(num_threads);
+}
+
+ChTaskScheduler::~ChTaskScheduler() {
+    StopWorkers();
+}
+
+void ChTaskScheduler::SetNumThreads(int num_threads) {
+    num_threads = std::max(num_threads, 1);
+    if (num_threads == m_num_threads)
+        return;
+
+    StopWorkers();
+
+    m_num_threads = num_threads;
+    m_queues.clear();
+    for (int i = 0; i < m_num_threads; i++)
+        m_queues.emplace_back(new Queue);
+}
+
+int ChTaskScheduler::QueueIndex() const {
+    return (tls_scheduler == this) ? tls_queue : 0;
+}
+
+void ChTaskScheduler::Submit(Task&& task, TaskGroup* group) {
+    if (!m_started.load(std::memory_order_acquire))
+        StartWorkers();
+
+    Queue& queue = *m_queues[QueueIndex()];
+    {
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        queue.entries.push_back(Entry{std::move(task), group});
+    }
+    m_num_queued.fetch_add(1);
+
+    // Lock the mutex before notifying, so that a worker cannot miss the wake up between the check of
+    // its waiting condition and the beginning of its wait.
+    { std::lock_guard<std::mutex> lock(m_sleep_mutex); }
+    m_sleep_cv.notify_one();
+}
+
+bool ChTaskScheduler::ExecuteOne() {
+    if (m_num_queued.load() == 0)
+        return false;
+
+    int self = QueueIndex();
+    int nqueues = (int)m_queues.size();
+    Entry entry;
+    bool found = false;
+
+    // Most recent task of the own queue (its data is likely still in cache)...
+    {
+        Queue& queue = *m_queues[self];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        if (!queue.entries.empty()) {
+            entry = std::move(queue.entries.back());
+            queue.entries.pop_back();
+            found = true;
+        }
+    }
+
+    // ...otherwise steal the oldest task of another queue (usually the largest piece of work).
+    for (int k = 1; k < nqueues && !found; k++) {
+        Queue& queue = *m_queues[(self + k) % nqueues];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        if (!queue.entries.empty()) {
+            entry = std::move(queue.entries.front());
+            queue.entries.pop_front();
+            found = true;
+        }
+    }
+
+    if (!found)
+        return false;
+
+    m_num_queued.fetch_sub(1);
+    entry.task();
+    entry.group->pending.fetch_sub(1, std::memory_order_release);
+    return true;
+}
+
+void ChTaskScheduler::StartWorkers() {
+    std::lock_guard<std::mutex> lock(m_start_mutex);
+    if (m_started.load())
+        return;
+
+    m_stop = false;
+    for (int i = 1; i < m_num_threads; i++)
+        m_workers.emplace_back(&ChTaskScheduler::WorkerLoop, this, i);
+
+    m_started.store(true, std::memory_order_release);
+}
+
+void ChTaskScheduler::StopWorkers() {
+    std::lock_guard<std::mutex> lock(m_start_mutex);
+    if (!m_started.load())
+        return;
+
+    {
+        std::lock_guard<std::mutex> sleep_lock(m_sleep_mutex);
+        m_stop = true;
+    }
+    m_sleep_cv.notify_all();
+    for (auto& worker : m_workers)
+        worker.join();
+    m_workers.clear();
+
+    m_started.store(false);
+}
+
+void ChTaskScheduler::WorkerLoop(int index) {
+    tls_scheduler = this;
+    tls_queue = index;
+
+    while (true) {
+        if (ExecuteOne())
+            continue;
+
+        // Tasks often come in bursts: try again a few times before going to sleep.
+        bool busy = false;
+        for (int spin = 0; spin < idle_spins && !busy; spin++) {
+            std::this_thread::yield();
+            busy = m_num_queued.load() > 0;
+        }
+        if (busy)
+            continue;
+
+        std::unique_lock<std::mutex> lock(m_sleep_mutex);
+        m_sleep_cv.wait(lock, [this]() { return m_stop || m_num_queued.load() > 0; });
+        if (m_stop)
+            return;
+    }
+}
+
+}  // end namespace chrono
@@ -0,0 +1,159 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+
+#ifndef CHTASKSCHEDULER_H
+#define CHTASKSCHEDULER_H
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "chrono/core/ChApiCE.h"
+
+namespace chrono {
+
+/// Work-stealing task scheduler.\n
+/// The scheduler owns a pool of worker threads, each with its own double-ended queue of tasks:
+/// a worker pushes and pops the tasks it spawns at the back of its queue, and when its queue is
+/// empty it steals tasks from the front of the queues of the other workers. Tasks submitted by
+/// threads that are not workers of the scheduler go to a shared queue.\n
+/// A thread waiting for a group of tasks executes pending tasks while waiting, so tasks can in turn
+/// spawn and wait for other tasks (nested parallelism) without blocking the workers and without
+/// creating new threads: the number of threads doing work is at most the one set with
+/// SetNumThreads() (workers plus calling thread). Several systems can share the same scheduler,
+/// see ChSystem::SetTaskScheduler().\n
+/// The worker threads are started lazily, at the first parallel submission. Tasks must not throw.
+class ChApi ChTaskScheduler {
+  public:
+    typedef std::function<void()> Task;
+
+    /// A group of tasks that can be waited for.
+    class ChApi TaskGroup {
+      public:
+        TaskGroup(ChTaskScheduler& mscheduler) : scheduler(mscheduler), pending(0) {}
+
+        /// The destructor waits for the completion of all the tasks of the group.
+        ~TaskGroup() { Wait(); }
+
+        /// Submit a task to the scheduler. If the scheduler has a single thread, the task is
+        /// executed immediately by the calling thread.
+        void Run(Task task);
+
+        /// Wait for the completion of all the tasks of the group, executing pending tasks
+        /// (of this group or not) in the meantime.
+        void Wait();
+
+      private:
+        ChTaskScheduler& scheduler;
+        std::atomic<int> pending;
+
+        friend class ChTaskScheduler;
+    };
+
+    /// Create a scheduler using the given number of threads (the calling thread included).
+    ChTaskScheduler(int num_threads = 1);
+
+    ~ChTaskScheduler();
+
+    /// Change the number of threads (the calling thread included, so 1 means serial execution).
+    /// Must not be called while tasks are running.
+    void SetNumThreads(int num_threads);
+
+    /// Get the number of threads (the calling thread included).
+    int GetNumThreads() const { return m_num_threads; }
+
+    /// Execute body(from, to) on sub-ranges [from, to) that cover the range [begin, end), in parallel.
+    /// Sub-ranges have at least 'grain' items (except the last one), and the range is not split in
+    /// more than a few sub-ranges per thread. Returns when all sub-ranges are processed.
+    template <class F>
+    void ParallelForRange(int begin, int end, F&& body, int grain = 1);
+
+    /// Execute body(i) for all i in [begin, end), in parallel (see ParallelForRange).
+    template <class F>
+    void ParallelFor(int begin, int end, F&& body, int grain = 1) {
+        ParallelForRange(begin, end,
+                         [&body](int from, int to) {
+                             for (int i = from; i < to; i++)
+                                 body(i);
+                         },
+                         grain);
+    }
+
+  private:
+    struct Entry {
+        Task task;
+        TaskGroup* group;
+    };
+
+    struct Queue {
+        std::mutex mutex;
+        std::deque<Entry> entries;
+    };
+
+    /// Put a task in the queue of the calling thread (or in the shared queue) and wake up a worker.
+    void Submit(Task&& task, TaskGroup* group);
+
+    /// Pop a task from the queue of the calling thread, or steal one from another queue, and execute it.
+    /// Return false if no task was found.
+    bool ExecuteOne();
+
+    /// Index of the queue of the calling thread (0, the shared queue, if not a worker of this scheduler).
+    int QueueIndex() const;
+
+    void StartWorkers();
+    void StopWorkers();
+    void WorkerLoop(int index);
+
+    int m_num_threads;
+    std::vector<std::unique_ptr<Queue>> m_queues;  ///< shared queue, then one queue per worker
+    std::vector<std::thread> m_workers;
+    std::atomic<bool> m_started;
+    std::mutex m_start_mutex;
+
+    std::atomic<int> m_num_queued;  ///< number of tasks waiting in the queues
+    bool m_stop;
+    std::mutex m_sleep_mutex;
+    std::condition_variable m_sleep_cv;
+};
+
+template <class F>
+void ChTaskScheduler::ParallelForRange(int begin, int end, F&& body, int grain) {
+    int n = end - begin;
+    if (n <= 0)
+        return;
+    grain = std::max(grain, 1);
+    if (m_num_threads < 2 || n <= grain) {
+        body(begin, end);
+        return;
+    }
+
+    int nchunks = std::min((n + grain - 1) / grain, 4 * m_num_threads);
+    int chunk = (n + nchunks - 1) / nchunks;
+
+    TaskGroup group(*this);
+    for (int from = begin + chunk; from < end; from += chunk) {
+        int to = std::min(from + chunk, end);
+        group.Run([&body, from, to]() { body(from, to); });
+    }
+    body(begin, std::min(begin + chunk, end));
+    group.Wait();
+}
+
+}  // end namespace chrono
+
+#endif
@@ -12,6 +12,9 @@
 // Authors: Alessandro Tasora, Radu Serban
 // =============================================================================
 
+#include <algorithm>
+#include <functional>
+
 #include "chrono/physics/ChContactContainerNSC.h"
 #include "chrono/physics/ChSystem.h"
 #include "chrono/solver/ChConstraintTwoTuplesContactN.h"
@@ -24,32 +27,10 @@ using namespace geometry;
 // Register into the object factory, to enable run-time dynamic creation and persistence
 CH_FACTORY_REGISTER(ChContactContainerNSC)
 
-ChContactContainerNSC::ChContactContainerNSC()
-    : n_added_6_6(0),
-      n_added_6_3(0),
-      n_added_3_3(0),
-      n_added_333_3(0),
-      n_added_333_6(0),
-      n_added_333_333(0),
-      n_added_666_3(0),
-      n_added_666_6(0),
-      n_added_666_333(0),
-      n_added_666_666(0),
-      n_added_6_6_rolling(0) {}
-
-ChContactContainerNSC::ChContactContainerNSC(const ChContactContainerNSC& other) : ChContactContainer(other) {
-    n_added_6_6 = 0;
-    n_added_6_3 = 0;
-    n_added_3_3 = 0;
-    n_added_333_3 = 0;
-    n_added_333_6 = 0;
-    n_added_333_333 = 0;
-    n_added_666_3 = 0;
-    n_added_666_6 = 0;
-    n_added_666_333 = 0;
-    n_added_666_666 = 0;
-    n_added_6_6_rolling = 0;
-}
+ChContactContainerNSC::ChContactContainerNSC() : use_contact_cache(false), contact_cache_tolerance(-1) {}
+
+ChContactContainerNSC::ChContactContainerNSC(const ChContactContainerNSC& other)
+    : ChContactContainer(other), use_contact_cache(false), contact_cache_tolerance(other.contact_cache_tolerance) {}
 
 ChContactContainerNSC::~ChContactContainerNSC() {
     RemoveAllContacts();
@@ -60,138 +41,173 @@ void ChContactContainerNSC::Update(double mytime, bool update_assets) {
     ChContactContainer::Update(mytime, update_assets);
 }
 
-template <class Tcont, class Titer>
-void _RemoveAllContacts(std::list<Tcont*>& contactlist, Titer& lastcontact, int& n_added) {
-    typename std::list<Tcont*>::iterator itercontact = contactlist.begin();
-    while (itercontact != contactlist.end()) {
-        delete (*itercontact);
-        (*itercontact) = 0;
-        ++itercontact;
-    }
-    contactlist.clear();
-    lastcontact = contactlist.begin();
-    n_added = 0;
+template <class Tcont>
+void _RemoveAllContacts(ChContactPool<Tcont>& contactlist) {
+    contactlist.Clear();
 }
 
 void ChContactContainerNSC::RemoveAllContacts() {
-    _RemoveAllContacts(contactlist_6_6, lastcontact_6_6, n_added_6_6);
-    _RemoveAllContacts(contactlist_6_3, lastcontact_6_3, n_added_6_3);
-    _RemoveAllContacts(contactlist_3_3, lastcontact_3_3, n_added_3_3);
-    _RemoveAllContacts(contactlist_333_3, lastcontact_333_3, n_added_333_3);
-    _RemoveAllContacts(contactlist_333_6, lastcontact_333_6, n_added_333_6);
-    _RemoveAllContacts(contactlist_333_333, lastcontact_333_333, n_added_333_333);
-    _RemoveAllContacts(contactlist_666_3, lastcontact_666_3, n_added_666_3);
-    _RemoveAllContacts(contactlist_666_6, lastcontact_666_6, n_added_666_6);
-    _RemoveAllContacts(contactlist_666_333, lastcontact_666_333, n_added_666_333);
-    _RemoveAllContacts(contactlist_666_666, lastcontact_666_666, n_added_666_666);
-    _RemoveAllContacts(contactlist_6_6_rolling, lastcontact_6_6_rolling, n_added_6_6_rolling);
-}
-
-void ChContactContainerNSC::BeginAddContact() {
-    lastcontact_6_6 = contactlist_6_6.begin();
-    n_added_6_6 = 0;
-
-    lastcontact_6_3 = contactlist_6_3.begin();
-    n_added_6_3 = 0;
-
-    lastcontact_3_3 = contactlist_3_3.begin();
-    n_added_3_3 = 0;
-
-    lastcontact_333_3 = contactlist_333_3.begin();
-    n_added_333_3 = 0;
-
-    lastcontact_333_6 = contactlist_333_6.begin();
-    n_added_333_6 = 0;
-
-    lastcontact_333_333 = contactlist_333_333.begin();
-    n_added_333_333 = 0;
+    _RemoveAllContacts(contactlist_6_6);
+    _RemoveAllContacts(contactlist_6_3);
+    _RemoveAllContacts(contactlist_3_3);
+    _RemoveAllContacts(contactlist_333_3);
+    _RemoveAllContacts(contactlist_333_6);
+    _RemoveAllContacts(contactlist_333_333);
+    _RemoveAllContacts(contactlist_666_3);
+    _RemoveAllContacts(contactlist_666_6);
+    _RemoveAllContacts(contactlist_666_333);
+    _RemoveAllContacts(contactlist_666_666);
+    _RemoveAllContacts(contactlist_6_6_rolling);
+    contact_constraints.clear();
+    contact_cache.clear();
+}
+
+// Reactions of a contact, to be stored in the contact cache
+template <class Ta, class Tb>
+void _GetCachedReactions(ChContactNSC<Ta, Tb>& contact, float* reactions) {
+    ChVector<> force = contact.GetContactForce();
+    reactions[0] = (float)force.x();
+    reactions[1] = (float)force.y();
+    reactions[2] = (float)force.z();
+    reactions[3] = reactions[4] = reactions[5] = 0;
+}
+
+template <class Ta, class Tb>
+void _GetCachedReactions(ChContactNSCrolling<Ta, Tb>& contact, float* reactions) {
+    ChVector<> force = contact.GetContactForce();
+    ChVector<> torque = contact.GetContactTorque();
+    reactions[0] = (float)force.x();
+    reactions[1] = (float)force.y();
+    reactions[2] = (float)force.z();
+    reactions[3] = (float)torque.x();
+    reactions[4] = (float)torque.y();
+    reactions[5] = (float)torque.z();
+}
+
+// Ordering of the cached contacts by pair of contactables
+struct _CachedContactLess {
+    template <class T>
+    bool operator()(const T& a, const T& b) const {
+        std::less<ChContactable*> less;
+        return less(a.objA, b.objA) || (a.objA == b.objA && less(a.objB, b.objB));
+    }
+};
 
-    lastcontact_666_3 = contactlist_666_3.begin();
-    n_added_666_3 = 0;
+template <class Tcont>
+void ChContactContainerNSC::CacheContacts(ChContactPool<Tcont>& contactlist) {
+    for (int i = 0; i < contactlist.GetNcontacts(); i++) {
+        Tcont& contact = contactlist[i];
+        ChCachedContact cached;
+        cached.objA = contact.GetObjA();
+        cached.objB = contact.GetObjB();
+        cached.pA = contact.GetObjA()->GetCsysForCollisionModel().TransformPointParentToLocal(contact.GetContactP1());
+        _GetCachedReactions(contact, cached.reactions);
+        contact_cache_next.push_back(cached);
+    }
+}
 
-    lastcontact_666_6 = contactlist_666_6.begin();
-    n_added_666_6 = 0;
+float* ChContactContainerNSC::FindCachedReactions(ChContactable* objA,
+                                                  ChContactable* objB,
+                                                  const ChVector<>& pA,
+                                                  double tol) {
+    ChCachedContact key;
+    key.objA = objA;
+    key.objB = objB;
+    auto range = std::equal_range(contact_cache.begin(), contact_cache.end(), key, _CachedContactLess());
+
+    // Pick the closest cached contact between the same contactables, if within tolerance
+    float* reactions = nullptr;
+    double min_dist2 = tol * tol;
+    for (auto it = range.first; it != range.second; ++it) {
+        double dist2 = (it->pA - pA).Length2();
+        if (dist2 <= min_dist2) {
+            min_dist2 = dist2;
+            reactions = it->reactions;
+        }
+    }
+    return reactions;
+}
 
-    lastcontact_666_333 = contactlist_666_333.begin();
-    n_added_666_333 = 0;
+template <class Tcont, class Ta, class Tb>
+void ChContactContainerNSC::InsertContact(ChContactPool<Tcont>& contactlist,
+                                          Ta* objA,
+                                          Tb* objB,
+                                          const collision::ChCollisionInfo& cinfo) {
+    if (!use_contact_cache) {
+        contactlist.Add(this, objA, objB, cinfo);
+        return;
+    }
 
-    lastcontact_666_666 = contactlist_666_666.begin();
-    n_added_666_666 = 0;
+    // The contact reads its initial reactions from the cache, and writes there the reactions
+    // computed by the solver (the cache is not modified until the next BeginAddContact).
+    double tol = contact_cache_tolerance;
+    if (tol < 0)
+        tol = ChMax(cinfo.modelA->GetEnvelope(), cinfo.modelB->GetEnvelope());
 
-    lastcontact_6_6_rolling = contactlist_6_6_rolling.begin();
-    n_added_6_6_rolling = 0;
+    collision::ChCollisionInfo cached_cinfo(cinfo);
+    cached_cinfo.reaction_cache =
+        FindCachedReactions(objA, objB, objA->GetCsysForCollisionModel().TransformPointParentToLocal(cinfo.vpA), tol);
+    contactlist.Add(this, objA, objB, cached_cinfo);
 }
 
-void ChContactContainerNSC::EndAddContact() {
-    // remove contacts that are beyond last contact
-    while (lastcontact_6_6 != contactlist_6_6.end()) {
-        delete (*lastcontact_6_6);
-        lastcontact_6_6 = contactlist_6_6.erase(lastcontact_6_6);
-    }
-    while (lastcontact_6_3 != contactlist_6_3.end()) {
-        delete (*lastcontact_6_3);
-        lastcontact_6_3 = contactlist_6_3.erase(lastcontact_6_3);
-    }
-    while (lastcontact_3_3 != contactlist_3_3.end()) {
-        delete (*lastcontact_3_3);
-        lastcontact_3_3 = contactlist_3_3.erase(lastcontact_3_3);
-    }
-    while (lastcontact_333_3 != contactlist_333_3.end()) {
-        delete (*lastcontact_333_3);
-        lastcontact_333_3 = contactlist_333_3.erase(lastcontact_333_3);
-    }
-    while (lastcontact_333_6 != contactlist_333_6.end()) {
-        delete (*lastcontact_333_6);
-        lastcontact_333_6 = contactlist_333_6.erase(lastcontact_333_6);
-    }
-    while (lastcontact_333_333 != contactlist_333_333.end()) {
-        delete (*lastcontact_333_333);
-        lastcontact_333_333 = contactlist_333_333.erase(lastcontact_333_333);
-    }
-    while (lastcontact_666_3 != contactlist_666_3.end()) {
-        delete (*lastcontact_666_3);
-        lastcontact_666_3 = contactlist_666_3.erase(lastcontact_666_3);
-    }
-    while (lastcontact_666_6 != contactlist_666_6.end()) {
-        delete (*lastcontact_666_6);
-        lastcontact_666_6 = contactlist_666_6.erase(lastcontact_666_6);
-    }
-    while (lastcontact_666_333 != contactlist_666_333.end()) {
-        delete (*lastcontact_666_333);
-        lastcontact_666_333 = contactlist_666_333.erase(lastcontact_666_333);
-    }
-    while (lastcontact_666_666 != contactlist_666_666.end()) {
-        delete (*lastcontact_666_666);
-        lastcontact_666_666 = contactlist_666_666.erase(lastcontact_666_666);
+void ChContactContainerNSC::BeginAddContact() {
+    // With warm starting, keep the contacts of the previous step (with their reactions), so that
+    // they can be matched with the new contacts whatever the order in which these are added.
+    // Otherwise, the reaction caches provided by the collision system (if any) are used.
+    use_contact_cache = GetSystem() && GetSystem()->GetSolverWarmStarting();
+
+    contact_cache_next.clear();
+    if (use_contact_cache) {
+        CacheContacts(contactlist_6_6);
+        CacheContacts(contactlist_6_3);
+        CacheContacts(contactlist_3_3);
+        CacheContacts(contactlist_333_3);
+        CacheContacts(contactlist_333_6);
+        CacheContacts(contactlist_333_333);
+        CacheContacts(contactlist_666_3);
+        CacheContacts(contactlist_666_6);
+        CacheContacts(contactlist_666_333);
+        CacheContacts(contactlist_666_666);
+        CacheContacts(contactlist_6_6_rolling);
+        std::sort(contact_cache_next.begin(), contact_cache_next.end(), _CachedContactLess());
     }
+    contact_cache.swap(contact_cache_next);
 
-    while (lastcontact_6_6_rolling != contactlist_6_6_rolling.end()) {
-        delete (*lastcontact_6_6_rolling);
-        lastcontact_6_6_rolling = contactlist_6_6_rolling.erase(lastcontact_6_6_rolling);
-    }
+    contactlist_6_6.Rewind();
+    contactlist_6_3.Rewind();
+    contactlist_3_3.Rewind();
+    contactlist_333_3.Rewind();
+    contactlist_333_6.Rewind();
+    contactlist_333_333.Rewind();
+    contactlist_666_3.Rewind();
+    contactlist_666_6.Rewind();
+    contactlist_666_333.Rewind();
+    contactlist_666_666.Rewind();
+    contactlist_6_6_rolling.Rewind();
 }
 
-template <class Tcont, class Titer, class Ta, class Tb>
-void _OptimalContactInsert(std::list<Tcont*>& contactlist,          ///< contact list
-                           Titer& lastcontact,                      ///< last contact acquired
-                           int& n_added,                            ///< number of contact inserted
-                           ChContactContainer* mcontainer,          ///< contact container
-                           Ta* objA,                                ///< collidable object A
-                           Tb* objB,                                ///< collidable object B
-                           const collision::ChCollisionInfo& cinfo  ///< collision informations
-) {
-    if (lastcontact != contactlist.end()) {
-        // reuse old contacts
-        (*lastcontact)->Reset(objA, objB, cinfo);
-        lastcontact++;
-
-    } else {
-        // add new contact
-        Tcont* mc = new Tcont(mcontainer, objA, objB, cinfo);
-        contactlist.push_back(mc);
-        lastcontact = contactlist.end();
-    }
-    n_added++;
+template <class Tcont>
+void _AppendConstraints(ChContactPool<Tcont>& contactlist, std::vector<ChConstraint*>& constraints) {
+    for (int i = 0; i < contactlist.GetNcontacts(); i++)
+        contactlist[i].AppendConstraints(constraints);
+}
+
+void ChContactContainerNSC::EndAddContact() {
+    // Contact objects are never moved in their pools, so the pointers to their constraints
+    // remain valid until the next collision detection pass.
+    contact_constraints.clear();
+    contact_constraints.reserve(GetDOC_d());
+    _AppendConstraints(contactlist_6_6, contact_constraints);
+    _AppendConstraints(contactlist_6_3, contact_constraints);
+    _AppendConstraints(contactlist_3_3, contact_constraints);
+    _AppendConstraints(contactlist_333_3, contact_constraints);
+    _AppendConstraints(contactlist_333_6, contact_constraints);
+    _AppendConstraints(contactlist_333_333, contact_constraints);
+    _AppendConstraints(contactlist_666_3, contact_constraints);
+    _AppendConstraints(contactlist_666_6, contact_constraints);
+    _AppendConstraints(contactlist_666_333, contact_constraints);
+    _AppendConstraints(contactlist_666_666, contact_constraints);
+    _AppendConstraints(contactlist_6_6_rolling, contact_constraints);
 }
 
 void ChContactContainerNSC::AddContact(const collision::ChCollisionInfo& mcontact) {
@@ -233,16 +249,15 @@ void ChContactContainerNSC::AddContact(const collision::ChCollisionInfo& mcontac
         if (ChContactable_1vars<6>* mmboB = dynamic_cast<ChContactable_1vars<6>*>(mcontact.modelB->GetContactable())) {
             if ((mmatA->rolling_friction && mmatB->rolling_friction) ||
                 (mmatA->spinning_friction && mmatB->spinning_friction)) {
-                _OptimalContactInsert(contactlist_6_6_rolling, lastcontact_6_6_rolling, n_added_6_6_rolling, this,
-                                      mmboA, mmboB, mcontact);
+                InsertContact(contactlist_6_6_rolling, mmboA, mmboB, mcontact);
             } else {
-                _OptimalContactInsert(contactlist_6_6, lastcontact_6_6, n_added_6_6, this, mmboA, mmboB, mcontact);
+                InsertContact(contactlist_6_6, mmboA, mmboB, mcontact);
             }
             return;
         }
         // 6_3
         if (ChContactable_1vars<3>* mmboB = dynamic_cast<ChContactable_1vars<3>*>(mcontact.modelB->GetContactable())) {
-            _OptimalContactInsert(contactlist_6_3, lastcontact_6_3, n_added_6_3, this, mmboA, mmboB, mcontact);
+            InsertContact(contactlist_6_3, mmboA, mmboB, mcontact);
             return;
         }
     }
@@ -251,12 +266,12 @@ void ChContactContainerNSC::AddContact(const collision::ChCollisionInfo& mcontac
         // 3_6 -> 6_3
         if (ChContactable_1vars<6>* mmboB = dynamic_cast<ChContactable_1vars<6>*>(mcontact.modelB->GetContactable())) {
             collision::ChCollisionInfo swapped_contact(mcontact, true);
-            _OptimalContactInsert(contactlist_6_3, lastcontact_6_3, n_added_6_3, this, mmboB, mmboA, swapped_contact);
+            InsertContact(contactlist_6_3, mmboB, mmboA, swapped_contact);
             return;
         }
         // 3_3
         if (ChContactable_1vars<3>* mmboB = dynamic_cast<ChContactable_1vars<3>*>(mcontact.modelB->GetContactable())) {
-            _OptimalContactInsert(contactlist_3_3, lastcontact_3_3, n_added_3_3, this, mmboA, mmboB, mcontact);
+            InsertContact(contactlist_3_3, mmboA, mmboB, mcontact);
             return;
         }
     }
@@ -264,84 +279,75 @@ void ChContactContainerNSC::AddContact(const collision::ChCollisionInfo& mcontac
     if (auto mmboA = dynamic_cast<ChContactable_1vars<3>*>(contactableA)) {
         if (auto mmboB = dynamic_cast<ChContactable_1vars<3>*>(contactableB)) {
             // 3_3
-            _OptimalContactInsert(contactlist_3_3, lastcontact_3_3, n_added_3_3, this, mmboA, mmboB, mcontact);
+            InsertContact(contactlist_3_3, mmboA, mmboB, mcontact);
         } else if (auto mmboB = dynamic_cast<ChContactable_1vars<6>*>(contactableB)) {
             // 3_6 -> 6_3
             collision::ChCollisionInfo swapped_contact(mcontact, true);
-            _OptimalContactInsert(contactlist_6_3, lastcontact_6_3, n_added_6_3, this, mmboB, mmboA, swapped_contact);
+            InsertContact(contactlist_6_3, mmboB, mmboA, swapped_contact);
         } else if (auto mmboB = dynamic_cast<ChContactable_3vars<3, 3, 3>*>(contactableB)) {
             // 3_333 -> 333_3
             collision::ChCollisionInfo swapped_contact(mcontact, true);
-            _OptimalContactInsert(contactlist_333_3, lastcontact_333_3, n_added_333_3, this, mmboB, mmboA,
-                                  swapped_contact);
+            InsertContact(contactlist_333_3, mmboB, mmboA, swapped_contact);
         } else if (auto mmboB = dynamic_cast<ChContactable_3vars<6, 6, 6>*>(contactableB)) {
             // 3_666 -> 666_3
             collision::ChCollisionInfo swapped_contact(mcontact, true);
-            _OptimalContactInsert(contactlist_666_3, lastcontact_666_3, n_added_666_3, this, mmboB, mmboA,
-                                  swapped_contact);
+            InsertContact(contactlist_666_3, mmboB, mmboA, swapped_contact);
         }
     }
 
     else if (auto mmboA = dynamic_cast<ChContactable_1vars<6>*>(contactableA)) {
         if (auto mmboB = dynamic_cast<ChContactable_1vars<3>*>(contactableB)) {
             // 6_3
-            _OptimalContactInsert(contactlist_6_3, lastcontact_6_3, n_added_6_3, this, mmboA, mmboB, mcontact);
+            InsertContact(contactlist_6_3, mmboA, mmboB, mcontact);
         } else if (auto mmboB = dynamic_cast<ChContactable_1vars<6>*>(contactableB)) {
             // 6_6    ***NOTE: for body-body one could have rolling friction: ***
             if ((mmatA->rolling_friction && mmatB->rolling_friction) ||
                 (mmatA->spinning_friction && mmatB->spinning_friction)) {
-                _OptimalContactInsert(contactlist_6_6_rolling, lastcontact_6_6_rolling, n_added_6_6_rolling, this,
-                                      mmboA, mmboB, mcontact);
+                InsertContact(contactlist_6_6_rolling, mmboA, mmboB, mcontact);
             } else {
-                _OptimalContactInsert(contactlist_6_6, lastcontact_6_6, n_added_6_6, this, mmboA, mmboB, mcontact);
+                InsertContact(contactlist_6_6, mmboA, mmboB, mcontact);
             }
         } else if (auto mmboB = dynamic_cast<ChContactable_3vars<3, 3, 3>*>(contactableB)) {
             // 6_333 -> 333_6
             collision::ChCollisionInfo swapped_contact(mcontact, true);
-            _OptimalContactInsert(contactlist_333_6, lastcontact_333_6, n_added_333_6, this, mmboB, mmboA,
-                                  swapped_contact);
+            InsertContact(contactlist_333_6, mmboB, mmboA, swapped_contact);
         } else if (auto mmboB = dynamic_cast<ChContactable_3vars<6, 6, 6>*>(contactableB)) {
             // 6_666 -> 666_6
             collision::ChCollisionInfo swapped_contact(mcontact, true);
-            _OptimalContactInsert(contactlist_666_6, lastcontact_666_6, n_added_666_6, this, mmboB, mmboA,
-                                  swapped_contact);
+            InsertContact(contactlist_666_6, mmboB, mmboA, swapped_contact);
         }
     }
 
     else if (auto mmboA = dynamic_cast<ChContactable_3vars<3, 3, 3>*>(contactableA)) {
         if (auto mmboB = dynamic_cast<ChContactable_1vars<3>*>(contactableB)) {
             // 333_3
-            _OptimalContactInsert(contactlist_333_3, lastcontact_333_3, n_added_333_3, this, mmboA, mmboB, mcontact);
+            InsertContact(contactlist_333_3, mmboA, mmboB, mcontact);
         } else if (auto mmboB = dynamic_cast<ChContactable_1vars<6>*>(contactableB)) {
             // 333_6
-            _OptimalContactInsert(contactlist_333_6, lastcontact_333_6, n_added_333_6, this, mmboA, mmboB, mcontact);
+            InsertContact(contactlist_333_6, mmboA, mmboB, mcontact);
         } else if (auto mmboB = dynamic_cast<ChContactable_3vars<3, 3, 3>*>(contactableB)) {
             // 333_333
-            _OptimalContactInsert(contactlist_333_333, lastcontact_333_333, n_added_333_333, this, mmboA, mmboB,
-                                  mcontact);
+            InsertContact(contactlist_333_333, mmboA, mmboB, mcontact);
         } else if (auto mmboB = dynamic_cast<ChContactable_3vars<6, 6, 6>*>(contactableB)) {
             // 333_666 -> 666_333
             collision::ChCollisionInfo swapped_contact(mcontact, true);
-            _OptimalContactInsert(contactlist_666_333, lastcontact_666_333, n_added_666_333, this, mmboB, mmboA,
-                                  swapped_contact);
+            InsertContact(contactlist_666_333, mmboB, mmboA, swapped_contact);
         }
     }
 
     else if (auto mmboA = dynamic_cast<ChContactable_3vars<6, 6, 6>*>(contactableA)) {
         if (auto mmboB = dynamic_cast<ChContactable_1vars<3>*>(contactableB)) {
             // 666_3
-            _OptimalContactInsert(contactlist_666_3, lastcontact_666_3, n_added_666_3, this, mmboA, mmboB, mcontact);
+            InsertContact(contactlist_666_3, mmboA, mmboB, mcontact);
         } else if (auto mmboB = dynamic_cast<ChContactable_1vars<6>*>(contactableB)) {
             // 666_6
-            _OptimalContactInsert(contactlist_666_6, lastcontact_666_6, n_added_666_6, this, mmboA, mmboB, mcontact);
+            InsertContact(contactlist_666_6, mmboA, mmboB, mcontact);
         } else if (auto mmboB = dynamic_cast<ChContactable_3vars<3, 3, 3>*>(contactableB)) {
             // 666_333
-            _OptimalContactInsert(contactlist_666_333, lastcontact_666_333, n_added_666_333, this, mmboA, mmboB,
-                                  mcontact);
+            InsertContact(contactlist_666_333, mmboA, mmboB, mcontact);
         } else if (auto mmboB = dynamic_cast<ChContactable_3vars<6, 6, 6>*>(contactableB)) {
             // 666_666
-            _OptimalContactInsert(contactlist_666_666, lastcontact_666_666, n_added_666_666, this, mmboA, mmboB,
-                                  mcontact);
+            InsertContact(contactlist_666_666, mmboA, mmboB, mcontact);
         }
     }
 
@@ -364,31 +370,29 @@ void ChContactContainerNSC::ComputeContactForces() {
 }
 
 template <class Tcont>
-void _ReportAllContacts(std::list<Tcont*>& contactlist, ChContactContainer::ReportContactCallback* mcallback) {
-    typename std::list<Tcont*>::iterator itercontact = contactlist.begin();
-    while (itercontact != contactlist.end()) {
-        bool proceed = mcallback->OnReportContact(
-            (*itercontact)->GetContactP1(), (*itercontact)->GetContactP2(), (*itercontact)->GetContactPlane(),
-            (*itercontact)->GetContactDistance(), (*itercontact)->GetEffectiveCurvatureRadius(),
-            (*itercontact)->GetContactForce(), VNULL, (*itercontact)->GetObjA(), (*itercontact)->GetObjB());
+void _ReportAllContacts(ChContactPool<Tcont>& contactlist, ChContactContainer::ReportContactCallback* mcallback) {
+    for (int i = 0; i < contactlist.GetNcontacts(); i++) {
+        Tcont& contact = contactlist[i];
+        bool proceed = mcallback->OnReportContact(contact.GetContactP1(), contact.GetContactP2(),
+                                                  contact.GetContactPlane(), contact.GetContactDistance(),
+                                                  contact.GetEffectiveCurvatureRadius(), contact.GetContactForce(),
+                                                  VNULL, contact.GetObjA(), contact.GetObjB());
         if (!proceed)
             break;
-        ++itercontact;
     }
 }
 
 template <class Tcont>
-void _ReportAllContactsRolling(std::list<Tcont*>& contactlist, ChContactContainer::ReportContactCallback* mcallback) {
-    typename std::list<Tcont*>::iterator itercontact = contactlist.begin();
-    while (itercontact != contactlist.end()) {
-        bool proceed = mcallback->OnReportContact(
-            (*itercontact)->GetContactP1(), (*itercontact)->GetContactP2(), (*itercontact)->GetContactPlane(),
-            (*itercontact)->GetContactDistance(), (*itercontact)->GetEffectiveCurvatureRadius(),
-            (*itercontact)->GetContactForce(), (*itercontact)->GetContactTorque(), (*itercontact)->GetObjA(),
-            (*itercontact)->GetObjB());
+void _ReportAllContactsRolling(ChContactPool<Tcont>& contactlist,
+                               ChContactContainer::ReportContactCallback* mcallback) {
+    for (int i = 0; i < contactlist.GetNcontacts(); i++) {
+        Tcont& contact = contactlist[i];
+        bool proceed = mcallback->OnReportContact(contact.GetContactP1(), contact.GetContactP2(),
+                                                  contact.GetContactPlane(), contact.GetContactDistance(),
+                                                  contact.GetEffectiveCurvatureRadius(), contact.GetContactForce(),
+                                                  contact.GetContactTorque(), contact.GetObjA(), contact.GetObjB());
         if (!proceed)
             break;
-        ++itercontact;
     }
 }
 
@@ -410,15 +414,13 @@ void ChContactContainerNSC::ReportAllContacts(ReportContactCallback* mcallback)
 
 template <class Tcont>
 void _IntStateGatherReactions(unsigned int& coffset,
-                              std::list<Tcont*>& contactlist,
+                              ChContactPool<Tcont>& contactlist,
                               const unsigned int off_L,
                               ChVectorDynamic<>& L,
                               const int stride) {
-    typename std::list<Tcont*>::iterator itercontact = contactlist.begin();
-    while (itercontact != contactlist.end()) {
-        (*itercontact)->ContIntStateGatherReactions(off_L + coffset, L);
+    for (int i = 0; i < contactlist.GetNcontacts(); i++) {
+        contactlist[i].ContIntStateGatherReactions(off_L + coffset, L);
         coffset += stride;
-        ++itercontact;
     }
 }
 
@@ -439,15 +441,13 @@ void ChContactContainerNSC::IntStateGatherReactions(const unsigned int off_L, Ch
 
 template <class Tcont>
 void _IntStateScatterReactions(unsigned int& coffset,
-                               std::list<Tcont*>& contactlist,
+                               ChContactPool<Tcont>& contactlist,
                                const unsigned int off_L,
                                const ChVectorDynamic<>& L,
                                const int stride) {
-    typename std::list<Tcont*>::iterator itercontact = contactlist.begin();
-    while (itercontact != contactlist.end()) {
-        (*itercontact)->ContIntStateScatterReactions(off_L + coffset, L);
+    for (int i = 0; i < contactlist.GetNcontacts(); i++) {
+        contactlist[i].ContIntStateScatterReactions(off_L + coffset, L);
         coffset += stride;
-        ++itercontact;
     }
 }
 
@@ -468,18 +468,16 @@ void ChContactContainerNSC::IntStateScatterReactions(const unsigned int off_L, c
 
 template <class Tcont>
 void _IntLoadResidual_CqL(unsigned int& coffset,           ///< offset of the contacts
-                          std::list<Tcont*>& contactlist,  ///< list of contacts
+                          ChContactPool<Tcont>& contactlist,  ///< list of contacts
                           const unsigned int off_L,        ///< offset in L multipliers
                           ChVectorDynamic<>& R,            ///< result: the R residual, R += c*Cq'*L
                           const ChVectorDynamic<>& L,      ///< the L vector
                           const double c,                  ///< a scaling factor
                           const int stride                 ///< stride
 ) {
-    typename std::list<Tcont*>::iterator itercontact = contactlist.begin();
-    while (itercontact != contactlist.end()) {
-        (*itercontact)->ContIntLoadResidual_CqL(off_L + coffset, R, L, c);
+    for (int i = 0; i < contactlist.GetNcontacts(); i++) {
+        contactlist[i].ContIntLoadResidual_CqL(off_L + coffset, R, L, c);
         coffset += stride;
-        ++itercontact;
     }
 }
 
@@ -503,7 +501,7 @@ void ChContactContainerNSC::IntLoadResidual_CqL(const unsigned int off_L,
 
 template <class Tcont>
 void _IntLoadConstraint_C(unsigned int& coffset,           ///< contact offset
-                          std::list<Tcont*>& contactlist,  ///< contact list
+                          ChContactPool<Tcont>& contactlist,  ///< contact list
                           const unsigned int off,          ///< offset in Qc residual
                           ChVectorDynamic<>& Qc,           ///< result: the Qc residual, Qc += c*C
                           const double c,                  ///< a scaling factor
@@ -511,11 +509,9 @@ void _IntLoadConstraint_C(unsigned int& coffset,           ///< contact offset
                           double recovery_clamp,           ///< value for min/max clamping of c*C
                           const int stride                 ///< stride
 ) {
-    typename std::list<Tcont*>::iterator itercontact = contactlist.begin();
-    while (itercontact != contactlist.end()) {
-        (*itercontact)->ContIntLoadConstraint_C(off + coffset, Qc, c, do_clamp, recovery_clamp);
+    for (int i = 0; i < contactlist.GetNcontacts(); i++) {
+        contactlist[i].ContIntLoadConstraint_C(off + coffset, Qc, c, do_clamp, recovery_clamp);
         coffset += stride;
-        ++itercontact;
     }
 }
 
@@ -540,7 +536,7 @@ void ChContactContainerNSC::IntLoadConstraint_C(const unsigned int off,
 
 template <class Tcont>
 void _IntToDescriptor(unsigned int& coffset,
-                      std::list<Tcont*>& contactlist,
+                      ChContactPool<Tcont>& contactlist,
                       const unsigned int off_v,
                       const ChStateDelta& v,
                       const ChVectorDynamic<>& R,
@@ -548,11 +544,9 @@ void _IntToDescriptor(unsigned int& coffset,
                       const ChVectorDynamic<>& L,
                       const ChVectorDynamic<>& Qc,
                       const int stride) {
-    typename std::list<Tcont*>::iterator itercontact = contactlist.begin();
-    while (itercontact != contactlist.end()) {
-        (*itercontact)->ContIntToDescriptor(off_L + coffset, L, Qc);
+    for (int i = 0; i < contactlist.GetNcontacts(); i++) {
+        contactlist[i].ContIntToDescriptor(off_L + coffset, L, Qc);
         coffset += stride;
-        ++itercontact;
     }
 }
 
@@ -578,17 +572,15 @@ void ChContactContainerNSC::IntToDescriptor(const unsigned int off_v,
 
 template <class Tcont>
 void _IntFromDescriptor(unsigned int& coffset,
-                        std::list<Tcont*>& contactlist,
+                        ChContactPool<Tcont>& contactlist,
                         const unsigned int off_v,
                         ChStateDelta& v,
                         const unsigned int off_L,
                         ChVectorDynamic<>& L,
                         const int stride) {
-    typename std::list<Tcont*>::iterator itercontact = contactlist.begin();
-    while (itercontact != contactlist.end()) {
-        (*itercontact)->ContIntFromDescriptor(off_L + coffset, L);
+    for (int i = 0; i < contactlist.GetNcontacts(); i++) {
+        contactlist[i].ContIntFromDescriptor(off_L + coffset, L);
         coffset += stride;
-        ++itercontact;
     }
 }
 
@@ -612,35 +604,14 @@ void ChContactContainerNSC::IntFromDescriptor(const unsigned int off_v,
 
 // SOLVER INTERFACES
 
-template <class Tcont>
-void _InjectConstraints(std::list<Tcont*>& contactlist, ChSystemDescriptor& mdescriptor) {
-    typename std::list<Tcont*>::iterator itercontact = contactlist.begin();
-    while (itercontact != contactlist.end()) {
-        (*itercontact)->InjectConstraints(mdescriptor);
-        ++itercontact;
-    }
-}
-
 void ChContactContainerNSC::InjectConstraints(ChSystemDescriptor& mdescriptor) {
-    _InjectConstraints(contactlist_6_6, mdescriptor);
-    _InjectConstraints(contactlist_6_3, mdescriptor);
-    _InjectConstraints(contactlist_3_3, mdescriptor);
-    _InjectConstraints(contactlist_333_3, mdescriptor);
-    _InjectConstraints(contactlist_333_6, mdescriptor);
-    _InjectConstraints(contactlist_333_333, mdescriptor);
-    _InjectConstraints(contactlist_666_3, mdescriptor);
-    _InjectConstraints(contactlist_666_6, mdescriptor);
-    _InjectConstraints(contactlist_666_333, mdescriptor);
-    _InjectConstraints(contactlist_666_666, mdescriptor);
-    _InjectConstraints(contactlist_6_6_rolling, mdescriptor);
+    mdescriptor.InsertConstraints(contact_constraints);
 }
 
 template <class Tcont>
-void _ConstraintsBiReset(std::list<Tcont*>& contactlist) {
-    typename std::list<Tcont*>::iterator itercontact = contactlist.begin();
-    while (itercontact != contactlist.end()) {
-        (*itercontact)->ConstraintsBiReset();
-        ++itercontact;
+void _ConstraintsBiReset(ChContactPool<Tcont>& contactlist) {
+    for (int i = 0; i < contactlist.GetNcontacts(); i++) {
+        contactlist[i].ConstraintsBiReset();
     }
 }
 
@@ -659,11 +630,9 @@ void ChContactContainerNSC::ConstraintsBiReset() {
 }
 
 template <class Tcont>
-void _ConstraintsBiLoad_C(std::list<Tcont*>& contactlist, double factor, double recovery_clamp, bool do_clamp) {
-    typename std::list<Tcont*>::iterator itercontact = contactlist.begin();
-    while (itercontact != contactlist.end()) {
-        (*itercontact)->ConstraintsBiLoad_C(factor, recovery_clamp, do_clamp);
-        ++itercontact;
+void _ConstraintsBiLoad_C(ChContactPool<Tcont>& contactlist, double factor, double recovery_clamp, bool do_clamp) {
+    for (int i = 0; i < contactlist.GetNcontacts(); i++) {
+        contactlist[i].ConstraintsBiLoad_C(factor, recovery_clamp, do_clamp);
     }
 }
 
@@ -686,12 +655,10 @@ void ChContactContainerNSC::ConstraintsLoadJacobians() {
 }
 
 template <class Tcont>
-void _ConstraintsFetch_react(std::list<Tcont*>& contactlist, double factor) {
+void _ConstraintsFetch_react(ChContactPool<Tcont>& contactlist, double factor) {
     // From constraints to react vector:
-    typename std::list<Tcont*>::iterator itercontact = contactlist.begin();
-    while (itercontact != contactlist.end()) {
-        (*itercontact)->ConstraintsFetch_react(factor);
-        ++itercontact;
+    for (int i = 0; i < contactlist.GetNcontacts(); i++) {
+        contactlist[i].ConstraintsFetch_react(factor);
     }
 }
 
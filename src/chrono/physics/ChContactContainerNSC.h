@@ -15,18 +15,20 @@
 #ifndef CH_CONTACTCONTAINER_NSC_H
 #define CH_CONTACTCONTAINER_NSC_H
 
-#include <list>
+#include <vector>
 
 #include "chrono/physics/ChContactContainer.h"
 #include "chrono/physics/ChContactNSC.h"
 #include "chrono/physics/ChContactNSCrolling.h"
+#include "chrono/physics/ChContactPool.h"
 #include "chrono/physics/ChContactable.h"
 
 namespace chrono {
 
 /// Class representing a container of many non-smooth contacts.
-/// This is implemented as a typical linked list of ChContactNSC objects
-/// (that is, contacts between two ChContactable objects, with 3 reactions).
+/// This is implemented with pools of ChContactNSC objects (that is, contacts between two
+/// ChContactable objects, with 3 reactions), one per type of contactable pair, whose contact
+/// objects and constraints are reused from step to step (see ChContactPool).
 /// It might also contain ChContactNSCrolling objects (extended versions of ChContactNSC,
 /// with 6 reactions, that account also for rolling and spinning resistance), but also
 /// for '6dof vs 6dof' contactables.
@@ -47,43 +49,33 @@ class ChApi ChContactContainerNSC : public ChContactContainer {
     typedef ChContactNSCrolling<ChContactable_1vars<6>, ChContactable_1vars<6> > ChContactNSCrolling_6_6;
 
   protected:
-    std::list<ChContactNSC_6_6*> contactlist_6_6;
-    std::list<ChContactNSC_6_3*> contactlist_6_3;
-    std::list<ChContactNSC_3_3*> contactlist_3_3;
-    std::list<ChContactNSC_333_3*> contactlist_333_3;
-    std::list<ChContactNSC_333_6*> contactlist_333_6;
-    std::list<ChContactNSC_333_333*> contactlist_333_333;
-    std::list<ChContactNSC_666_3*> contactlist_666_3;
-    std::list<ChContactNSC_666_6*> contactlist_666_6;
-    std::list<ChContactNSC_666_333*> contactlist_666_333;
-    std::list<ChContactNSC_666_666*> contactlist_666_666;
-
-    std::list<ChContactNSCrolling_6_6*> contactlist_6_6_rolling;
-
-    int n_added_6_6;
-    int n_added_6_3;
-    int n_added_3_3;
-    int n_added_333_3;
-    int n_added_333_6;
-    int n_added_333_333;
-    int n_added_666_3;
-    int n_added_666_6;
-    int n_added_666_333;
-    int n_added_666_666;
-    int n_added_6_6_rolling;
-
-    std::list<ChContactNSC_6_6*>::iterator lastcontact_6_6;
-    std::list<ChContactNSC_6_3*>::iterator lastcontact_6_3;
-    std::list<ChContactNSC_3_3*>::iterator lastcontact_3_3;
-    std::list<ChContactNSC_333_3*>::iterator lastcontact_333_3;
-    std::list<ChContactNSC_333_6*>::iterator lastcontact_333_6;
-    std::list<ChContactNSC_333_333*>::iterator lastcontact_333_333;
-    std::list<ChContactNSC_666_3*>::iterator lastcontact_666_3;
-    std::list<ChContactNSC_666_6*>::iterator lastcontact_666_6;
-    std::list<ChContactNSC_666_333*>::iterator lastcontact_666_333;
-    std::list<ChContactNSC_666_666*>::iterator lastcontact_666_666;
-
-    std::list<ChContactNSCrolling_6_6*>::iterator lastcontact_6_6_rolling;
+    ChContactPool<ChContactNSC_6_6> contactlist_6_6;
+    ChContactPool<ChContactNSC_6_3> contactlist_6_3;
+    ChContactPool<ChContactNSC_3_3> contactlist_3_3;
+    ChContactPool<ChContactNSC_333_3> contactlist_333_3;
+    ChContactPool<ChContactNSC_333_6> contactlist_333_6;
+    ChContactPool<ChContactNSC_333_333> contactlist_333_333;
+    ChContactPool<ChContactNSC_666_3> contactlist_666_3;
+    ChContactPool<ChContactNSC_666_6> contactlist_666_6;
+    ChContactPool<ChContactNSC_666_333> contactlist_666_333;
+    ChContactPool<ChContactNSC_666_666> contactlist_666_666;
+
+    ChContactPool<ChContactNSCrolling_6_6> contactlist_6_6_rolling;
+
+    std::vector<ChConstraint*> contact_constraints;  ///< flat list of the scalar constraints of all contacts
+
+    /// Reactions of a contact of the previous step, used for warm starting the solver.
+    struct ChCachedContact {
+        ChContactable* objA;  ///< first contactable
+        ChContactable* objB;  ///< second contactable
+        ChVector<> pA;        ///< contact point on A, in the collision model frame of A
+        float reactions[6];   ///< N,U,V reactions (and rolling/spinning torques, if any)
+    };
+
+    std::vector<ChCachedContact> contact_cache;       ///< contacts of the previous step, sorted by contactable pair
+    std::vector<ChCachedContact> contact_cache_next;  ///< buffer used to build the next contact cache
+    bool use_contact_cache;                           ///< true if the contact cache is used in the current step
+    double contact_cache_tolerance;                   ///< matching tolerance (if negative, use collision envelopes)
 
   public:
     ChContactContainerNSC();
@@ -95,8 +87,11 @@ class ChApi ChContactContainerNSC : public ChContactContainer {
 
     /// Tell the number of added contacts
     virtual int GetNcontacts() const override {
-        return n_added_3_3 + n_added_6_3 + n_added_6_6 + n_added_333_3 + n_added_333_6 + n_added_333_333 +
-               n_added_666_3 + n_added_666_6 + n_added_666_333 + n_added_666_666 + n_added_6_6_rolling;
+        return contactlist_3_3.GetNcontacts() + contactlist_6_3.GetNcontacts() + contactlist_6_6.GetNcontacts() +
+               contactlist_333_3.GetNcontacts() + contactlist_333_6.GetNcontacts() +
+               contactlist_333_333.GetNcontacts() + contactlist_666_3.GetNcontacts() +
+               contactlist_666_6.GetNcontacts() + contactlist_666_333.GetNcontacts() +
+               contactlist_666_666.GetNcontacts() + contactlist_6_6_rolling.GetNcontacts();
     }
 
     /// Remove (delete) all contained contact data.
@@ -104,19 +99,31 @@ class ChApi ChContactContainerNSC : public ChContactContainer {
 
     /// The collision system will call BeginAddContact() before adding
     /// all contacts (for example with AddContact() or similar). Instead of
-    /// simply deleting all list of the previous contacts, this optimized implementation
-    /// rewinds the link iterator to begin and tries to reuse previous contact objects
+    /// simply deleting all the previous contacts, this optimized implementation
+    /// rewinds the contact pools, so that previous contact objects are reused
     /// until possible, to avoid too much allocation/deallocation.
     virtual void BeginAddContact() override;
 
     /// Add a contact between two frames.
     virtual void AddContact(const collision::ChCollisionInfo& mcontact) override;
 
-    /// The collision system will call BeginAddContact() after adding
+    /// The collision system will call EndAddContact() after adding
     /// all contacts (for example with AddContact() or similar). This optimized version
-    /// purges the end of the list of contacts that were not reused (if any).
+    /// keeps the contact objects that were not reused (if any) for later steps, and
+    /// collects the constraints of all contacts in a flat list for InjectConstraints().
     virtual void EndAddContact() override;
 
+    /// Set the tolerance used to match a new contact with a contact of the previous step, when the
+    /// solver warm starting is enabled (see ChSystem::SetSolverWarmStarting). The reactions of a
+    /// contact of the previous step are used as initial guess for a new contact between the same two
+    /// contactables, if their contact points on the first contactable (in its collision model frame)
+    /// are closer than this tolerance. If negative (default), the largest collision envelope of the
+    /// two collision models is used.
+    void SetContactCacheTolerance(double tol) { contact_cache_tolerance = tol; }
+
+    /// Get the tolerance used to match a new contact with a contact of the previous step.
+    double GetContactCacheTolerance() const { return contact_cache_tolerance; }
+
     /// Scans all the contacts and for each contact executes the OnReportContact()
     /// function of the provided callback object.
     virtual void ReportAllContacts(ReportContactCallback* mcallback) override;
@@ -124,9 +131,8 @@ class ChApi ChContactContainerNSC : public ChContactContainer {
     /// Tell the number of scalar bilateral constraints (actually, friction
     /// constraints aren't exactly as unilaterals, but count them too)
     virtual int GetDOC_d() override {
-        return 3 * (n_added_3_3 + n_added_6_3 + n_added_6_6 + n_added_333_3 + n_added_333_6 + n_added_333_333 +
-                    n_added_666_3 + n_added_666_6 + n_added_666_333 + n_added_666_666) +
-               6 * (n_added_6_6_rolling);
+        return 3 * (GetNcontacts() - contactlist_6_6_rolling.GetNcontacts()) +
+               6 * contactlist_6_6_rolling.GetNcontacts();
     }
 
     /// In detail, it computes jacobians, violations, etc. and stores
@@ -181,6 +187,18 @@ class ChApi ChContactContainerNSC : public ChContactContainer {
 
     /// Method to allow de-serialization of transient data from archives.
     virtual void ArchiveIN(ChArchiveIn& marchive) override;
+
+  protected:
+    /// Store the contacts of the previous step in the contact cache.
+    template <class Tcont>
+    void CacheContacts(ChContactPool<Tcont>& contactlist);
+
+    /// Find the reactions of the cached contact matching a new contact, if any.
+    float* FindCachedReactions(ChContactable* objA, ChContactable* objB, const ChVector<>& pA, double tol);
+
+    /// Add a contact to the given pool, warm starting it from the contact cache if enabled.
+    template <class Tcont, class Ta, class Tb>
+    void InsertContact(ChContactPool<Tcont>& contactlist, Ta* objA, Tb* objB, const collision::ChCollisionInfo& cinfo);
 };
 
 CH_CLASS_VERSION(ChContactContainerNSC, 0)
@@ -23,30 +23,9 @@ using namespace geometry;
 // Register into the object factory, to enable run-time dynamic creation and persistence
 CH_FACTORY_REGISTER(ChContactContainerSMC)
 
-ChContactContainerSMC::ChContactContainerSMC()
-    : n_added_3_3(0),
-      n_added_6_3(0),
-      n_added_6_6(0),
-      n_added_333_3(0),
-      n_added_333_6(0),
-      n_added_333_333(0),
-      n_added_666_3(0),
-      n_added_666_6(0),
-      n_added_666_333(0),
-      n_added_666_666(0) {}
-
-ChContactContainerSMC::ChContactContainerSMC(const ChContactContainerSMC& other) : ChContactContainer(other) {
-    n_added_3_3 = 0;
-    n_added_6_3 = 0;
-    n_added_6_6 = 0;
-    n_added_333_3 = 0;
-    n_added_333_6 = 0;
-    n_added_333_333 = 0;
-    n_added_666_3 = 0;
-    n_added_666_6 = 0;
-    n_added_666_333 = 0;
-    n_added_666_666 = 0;
-}
+ChContactContainerSMC::ChContactContainerSMC() {}
+
+ChContactContainerSMC::ChContactContainerSMC(const ChContactContainerSMC& other) : ChContactContainer(other) {}
 
 ChContactContainerSMC::~ChContactContainerSMC() {
     RemoveAllContacts();
@@ -57,139 +36,76 @@ void ChContactContainerSMC::Update(double mytime, bool update_assets) {
     ChContactContainer::Update(mytime, update_assets);
 }
 
-template <class Tcont, class Titer>
-void _RemoveAllContacts(std::list<Tcont*>& contactlist, Titer& lastcontact, int& n_added) {
-    typename std::list<Tcont*>::iterator itercontact = contactlist.begin();
-    while (itercontact != contactlist.end()) {
-        delete (*itercontact);
-        (*itercontact) = 0;
-        ++itercontact;
-    }
-    contactlist.clear();
-    lastcontact = contactlist.begin();
-    n_added = 0;
+template <class Tcont, class Tbatch>
+void _RemoveAllContacts(ChContactPool<Tcont>& contactlist, Tbatch& batch) {
+    contactlist.Clear();
+    batch.Clear();
 }
 
 void ChContactContainerSMC::RemoveAllContacts() {
-    _RemoveAllContacts(contactlist_3_3, lastcontact_3_3, n_added_3_3);
-    _RemoveAllContacts(contactlist_6_3, lastcontact_6_3, n_added_6_3);
-    _RemoveAllContacts(contactlist_6_6, lastcontact_6_6, n_added_6_6);
-    _RemoveAllContacts(contactlist_333_3, lastcontact_333_3, n_added_333_3);
-    _RemoveAllContacts(contactlist_333_6, lastcontact_333_6, n_added_333_6);
-    _RemoveAllContacts(contactlist_333_333, lastcontact_333_333, n_added_333_333);
-    _RemoveAllContacts(contactlist_666_3, lastcontact_666_3, n_added_666_3);
-    _RemoveAllContacts(contactlist_666_6, lastcontact_666_6, n_added_666_6);
-    _RemoveAllContacts(contactlist_666_333, lastcontact_666_333, n_added_666_333);
-    _RemoveAllContacts(contactlist_666_666, lastcontact_666_666, n_added_666_666);
+    _RemoveAllContacts(contactlist_3_3, batch_3_3);
+    _RemoveAllContacts(contactlist_6_3, batch_6_3);
+    _RemoveAllContacts(contactlist_6_6, batch_6_6);
+    _RemoveAllContacts(contactlist_333_3, batch_333_3);
+    _RemoveAllContacts(contactlist_333_6, batch_333_6);
+    _RemoveAllContacts(contactlist_333_333, batch_333_333);
+    _RemoveAllContacts(contactlist_666_3, batch_666_3);
+    _RemoveAllContacts(contactlist_666_6, batch_666_6);
+    _RemoveAllContacts(contactlist_666_333, batch_666_333);
+    _RemoveAllContacts(contactlist_666_666, batch_666_666);
     //**TODO*** cont. roll.
 }
 
-void ChContactContainerSMC::BeginAddContact() {
-    lastcontact_3_3 = contactlist_3_3.begin();
-    n_added_3_3 = 0;
-
-    lastcontact_6_3 = contactlist_6_3.begin();
-    n_added_6_3 = 0;
-
-    lastcontact_6_6 = contactlist_6_6.begin();
-    n_added_6_6 = 0;
-
-    lastcontact_333_3 = contactlist_333_3.begin();
-    n_added_333_3 = 0;
-
-    lastcontact_333_6 = contactlist_333_6.begin();
-    n_added_333_6 = 0;
-
-    lastcontact_333_333 = contactlist_333_333.begin();
-    n_added_333_333 = 0;
-
-    lastcontact_666_3 = contactlist_666_3.begin();
-    n_added_666_3 = 0;
-
-    lastcontact_666_6 = contactlist_666_6.begin();
-    n_added_666_6 = 0;
-
-    lastcontact_666_333 = contactlist_666_333.begin();
-    n_added_666_333 = 0;
+template <class Tcont, class Tbatch>
+void _BeginAddContact(ChContactPool<Tcont>& contactlist, Tbatch& batch) {
+    contactlist.Rewind();
+    batch.Clear();
+}
 
-    lastcontact_666_666 = contactlist_666_666.begin();
-    n_added_666_666 = 0;
+void ChContactContainerSMC::BeginAddContact() {
+    _BeginAddContact(contactlist_3_3, batch_3_3);
+    _BeginAddContact(contactlist_6_3, batch_6_3);
+    _BeginAddContact(contactlist_6_6, batch_6_6);
+    _BeginAddContact(contactlist_333_3, batch_333_3);
+    _BeginAddContact(contactlist_333_6, batch_333_6);
+    _BeginAddContact(contactlist_333_333, batch_333_333);
+    _BeginAddContact(contactlist_666_3, batch_666_3);
+    _BeginAddContact(contactlist_666_6, batch_666_6);
+    _BeginAddContact(contactlist_666_333, batch_666_333);
+    _BeginAddContact(contactlist_666_666, batch_666_666);
+}
 
-    // lastcontact_roll = contactlist_roll.begin();
-    // n_added_roll = 0;
+template <class Tcont, class Tbatch>
+void _EndAddContact(ChContactPool<Tcont>& contactlist,
+                    Tbatch& batch,
+                    ChContactContainer* mcontainer,
+                    ChTaskScheduler& scheduler) {
+    contactlist.Assign(mcontainer, batch.objA, batch.objB, batch.cinfo, scheduler);
+    batch.Clear();
 }
 
 void ChContactContainerSMC::EndAddContact() {
-    // remove contacts that are beyond last contact
-    while (lastcontact_3_3 != contactlist_3_3.end()) {
-        delete (*lastcontact_3_3);
-        lastcontact_3_3 = contactlist_3_3.erase(lastcontact_3_3);
-    }
-    while (lastcontact_6_3 != contactlist_6_3.end()) {
-        delete (*lastcontact_6_3);
-        lastcontact_6_3 = contactlist_6_3.erase(lastcontact_6_3);
-    }
-    while (lastcontact_6_6 != contactlist_6_6.end()) {
-        delete (*lastcontact_6_6);
-        lastcontact_6_6 = contactlist_6_6.erase(lastcontact_6_6);
-    }
-    while (lastcontact_333_3 != contactlist_333_3.end()) {
-        delete (*lastcontact_333_3);
-        lastcontact_333_3 = contactlist_333_3.erase(lastcontact_333_3);
-    }
-    while (lastcontact_333_6 != contactlist_333_6.end()) {
-        delete (*lastcontact_333_6);
-        lastcontact_333_6 = contactlist_333_6.erase(lastcontact_333_6);
-    }
-    while (lastcontact_333_333 != contactlist_333_333.end()) {
-        delete (*lastcontact_333_333);
-        lastcontact_333_333 = contactlist_333_333.erase(lastcontact_333_333);
-    }
-    while (lastcontact_666_3 != contactlist_666_3.end()) {
-        delete (*lastcontact_666_3);
-        lastcontact_666_3 = contactlist_666_3.erase(lastcontact_666_3);
-    }
-    while (lastcontact_666_6 != contactlist_666_6.end()) {
-        delete (*lastcontact_666_6);
-        lastcontact_666_6 = contactlist_666_6.erase(lastcontact_666_6);
-    }
-    while (lastcontact_666_333 != contactlist_666_333.end()) {
-        delete (*lastcontact_666_333);
-        lastcontact_666_333 = contactlist_666_333.erase(lastcontact_666_333);
-    }
-    while (lastcontact_666_666 != contactlist_666_666.end()) {
-        delete (*lastcontact_666_666);
-        lastcontact_666_666 = contactlist_666_666.erase(lastcontact_666_666);
+    // Contact forces are calculated when (re)initializing the contacts. This is done in parallel,
+    // unless there is a user callback to modify the composite material of each contact.
+    if (GetSystem() && !GetAddContactCallback()) {
+        EndAddContact(*GetSystem()->GetTaskScheduler());
+    } else {
+        ChTaskScheduler serial_scheduler(1);
+        EndAddContact(serial_scheduler);
     }
-
-    // while (lastcontact_roll != contactlist_roll.end()) {
-    //    delete (*lastcontact_roll);
-    //    lastcontact_roll = contactlist_roll.erase(lastcontact_roll);
-    //}
 }
 
-template <class Tcont, class Titer, class Ta, class Tb>
-void _OptimalContactInsert(std::list<Tcont*>& contactlist,
-                           Titer& lastcontact,
-                           int& n_added,
-                           ChContactContainer* mcontainer,
-                           Ta* objA,  ///< collidable object A
-                           Tb* objB,  ///< collidable object B
-                           const collision::ChCollisionInfo& cinfo) {
-    if (lastcontact != contactlist.end()) {
-        // reuse old contacts
-        (*lastcontact)->Reset(objA, objB, cinfo);
-
-        lastcontact++;
-
-    } else {
-        // add new contact
-        Tcont* mc = new Tcont(mcontainer, objA, objB, cinfo);
-
-        contactlist.push_back(mc);
-        lastcontact = contactlist.end();
-    }
-    n_added++;
+void ChContactContainerSMC::EndAddContact(ChTaskScheduler& scheduler) {
+    _EndAddContact(contactlist_3_3, batch_3_3, this, scheduler);
+    _EndAddContact(contactlist_6_3, batch_6_3, this, scheduler);
+    _EndAddContact(contactlist_6_6, batch_6_6, this, scheduler);
+    _EndAddContact(contactlist_333_3, batch_333_3, this, scheduler);
+    _EndAddContact(contactlist_333_6, batch_333_6, this, scheduler);
+    _EndAddContact(contactlist_333_333, batch_333_333, this, scheduler);
+    _EndAddContact(contactlist_666_3, batch_666_3, this, scheduler);
+    _EndAddContact(contactlist_666_6, batch_666_6, this, scheduler);
+    _EndAddContact(contactlist_666_333, batch_666_333, this, scheduler);
+    _EndAddContact(contactlist_666_666, batch_666_666, this, scheduler);
 }
 
 void ChContactContainerSMC::AddContact(const collision::ChCollisionInfo& mcontact) {
@@ -226,78 +142,70 @@ void ChContactContainerSMC::AddContact(const collision::ChCollisionInfo& mcontac
     if (auto mmboA = dynamic_cast<ChContactable_1vars<3>*>(contactableA)) {
         if (auto mmboB = dynamic_cast<ChContactable_1vars<3>*>(contactableB)) {
             // 3_3
-            _OptimalContactInsert(contactlist_3_3, lastcontact_3_3, n_added_3_3, this, mmboA, mmboB, mcontact);
+            batch_3_3.Add(mmboA, mmboB, mcontact);
         } else if (auto mmboB = dynamic_cast<ChContactable_1vars<6>*>(contactableB)) {
             // 3_6 -> 6_3
             collision::ChCollisionInfo swapped_contact(mcontact, true);
-            _OptimalContactInsert(contactlist_6_3, lastcontact_6_3, n_added_6_3, this, mmboB, mmboA, swapped_contact);
+            batch_6_3.Add(mmboB, mmboA, swapped_contact);
         } else if (auto mmboB = dynamic_cast<ChContactable_3vars<3, 3, 3>*>(contactableB)) {
             // 3_333 -> 333_3
             collision::ChCollisionInfo swapped_contact(mcontact, true);
-            _OptimalContactInsert(contactlist_333_3, lastcontact_333_3, n_added_333_3, this, mmboB, mmboA,
-                                  swapped_contact);
+            batch_333_3.Add(mmboB, mmboA, swapped_contact);
         } else if (auto mmboB = dynamic_cast<ChContactable_3vars<6, 6, 6>*>(contactableB)) {
             // 3_666 -> 666_3
             collision::ChCollisionInfo swapped_contact(mcontact, true);
-            _OptimalContactInsert(contactlist_666_3, lastcontact_666_3, n_added_666_3, this, mmboB, mmboA,
-                                  swapped_contact);
+            batch_666_3.Add(mmboB, mmboA, swapped_contact);
         }
     }
 
     else if (auto mmboA = dynamic_cast<ChContactable_1vars<6>*>(contactableA)) {
         if (auto mmboB = dynamic_cast<ChContactable_1vars<3>*>(contactableB)) {
             // 6_3
-            _OptimalContactInsert(contactlist_6_3, lastcontact_6_3, n_added_6_3, this, mmboA, mmboB, mcontact);
+            batch_6_3.Add(mmboA, mmboB, mcontact);
         } else if (auto mmboB = dynamic_cast<ChContactable_1vars<6>*>(contactableB)) {
             // 6_6
-            _OptimalContactInsert(contactlist_6_6, lastcontact_6_6, n_added_6_6, this, mmboA, mmboB, mcontact);
+            batch_6_6.Add(mmboA, mmboB, mcontact);
         } else if (auto mmboB = dynamic_cast<ChContactable_3vars<3, 3, 3>*>(contactableB)) {
             // 6_333 -> 333_6
             collision::ChCollisionInfo swapped_contact(mcontact, true);
-            _OptimalContactInsert(contactlist_333_6, lastcontact_333_6, n_added_333_6, this, mmboB, mmboA,
-                                  swapped_contact);
+            batch_333_6.Add(mmboB, mmboA, swapped_contact);
         } else if (auto mmboB = dynamic_cast<ChContactable_3vars<6, 6, 6>*>(contactableB)) {
             // 6_666 -> 666_6
             collision::ChCollisionInfo swapped_contact(mcontact, true);
-            _OptimalContactInsert(contactlist_666_6, lastcontact_666_6, n_added_666_6, this, mmboB, mmboA,
-                                  swapped_contact);
+            batch_666_6.Add(mmboB, mmboA, swapped_contact);
         }
     }
 
     else if (auto mmboA = dynamic_cast<ChContactable_3vars<3, 3, 3>*>(contactableA)) {
         if (auto mmboB = dynamic_cast<ChContactable_1vars<3>*>(contactableB)) {
             // 333_3
-            _OptimalContactInsert(contactlist_333_3, lastcontact_333_3, n_added_333_3, this, mmboA, mmboB, mcontact);
+            batch_333_3.Add(mmboA, mmboB, mcontact);
         } else if (auto mmboB = dynamic_cast<ChContactable_1vars<6>*>(contactableB)) {
             // 333_6
-            _OptimalContactInsert(contactlist_333_6, lastcontact_333_6, n_added_333_6, this, mmboA, mmboB, mcontact);
+            batch_333_6.Add(mmboA, mmboB, mcontact);
         } else if (auto mmboB = dynamic_cast<ChContactable_3vars<3, 3, 3>*>(contactableB)) {
             // 333_333
-            _OptimalContactInsert(contactlist_333_333, lastcontact_333_333, n_added_333_333, this, mmboA, mmboB,
-                                  mcontact);
+            batch_333_333.Add(mmboA, mmboB, mcontact);
         } else if (auto mmboB = dynamic_cast<ChContactable_3vars<6, 6, 6>*>(contactableB)) {
             // 333_666 -> 666_333
             collision::ChCollisionInfo swapped_contact(mcontact, true);
-            _OptimalContactInsert(contactlist_666_333, lastcontact_666_333, n_added_666_333, this, mmboB, mmboA,
-                                  swapped_contact);
+            batch_666_333.Add(mmboB, mmboA, swapped_contact);
         }
     }
 
     else if (auto mmboA = dynamic_cast<ChContactable_3vars<6, 6, 6>*>(contactableA)) {
         if (auto mmboB = dynamic_cast<ChContactable_1vars<3>*>(contactableB)) {
             // 666_3
-            _OptimalContactInsert(contactlist_666_3, lastcontact_666_3, n_added_666_3, this, mmboA, mmboB, mcontact);
+            batch_666_3.Add(mmboA, mmboB, mcontact);
         } else if (auto mmboB = dynamic_cast<ChContactable_1vars<6>*>(contactableB)) {
             // 666_6
-            _OptimalContactInsert(contactlist_666_6, lastcontact_666_6, n_added_666_6, this, mmboA, mmboB, mcontact);
+            batch_666_6.Add(mmboA, mmboB, mcontact);
         } else if (auto mmboB = dynamic_cast<ChContactable_3vars<3, 3, 3>*>(contactableB)) {
             // 666_333
-            _OptimalContactInsert(contactlist_666_333, lastcontact_666_333, n_added_666_333, this, mmboA, mmboB,
-                                  mcontact);
+            batch_666_333.Add(mmboA, mmboB, mcontact);
         } else if (auto mmboB = dynamic_cast<ChContactable_3vars<6, 6, 6>*>(contactableB)) {
             // 666_666
-            _OptimalContactInsert(contactlist_666_666, lastcontact_666_666, n_added_666_666, this, mmboA, mmboB,
-                                  mcontact);
+            batch_666_666.Add(mmboA, mmboB, mcontact);
         }
     }
 
@@ -319,16 +227,15 @@ void ChContactContainerSMC::ComputeContactForces() {
 }
 
 template <class Tcont>
-void _ReportAllContacts(std::list<Tcont*>& contactlist, ChContactContainer::ReportContactCallback* mcallback) {
-    typename std::list<Tcont*>::iterator itercontact = contactlist.begin();
-    while (itercontact != contactlist.end()) {
-        bool proceed = mcallback->OnReportContact(
-            (*itercontact)->GetContactP1(), (*itercontact)->GetContactP2(), (*itercontact)->GetContactPlane(),
-            (*itercontact)->GetContactDistance(), (*itercontact)->GetEffectiveCurvatureRadius(),
-            (*itercontact)->GetContactForce(), VNULL, (*itercontact)->GetObjA(), (*itercontact)->GetObjB());
+void _ReportAllContacts(ChContactPool<Tcont>& contactlist, ChContactContainer::ReportContactCallback* mcallback) {
+    for (int i = 0; i < contactlist.GetNcontacts(); i++) {
+        Tcont& contact = contactlist[i];
+        bool proceed = mcallback->OnReportContact(contact.GetContactP1(), contact.GetContactP2(),
+                                                  contact.GetContactPlane(), contact.GetContactDistance(),
+                                                  contact.GetEffectiveCurvatureRadius(), contact.GetContactForce(),
+                                                  VNULL, contact.GetObjA(), contact.GetObjB());
         if (!proceed)
             break;
-        ++itercontact;
     }
 }
 
@@ -349,12 +256,10 @@ void ChContactContainerSMC::ReportAllContacts(ReportContactCallback* mcallback)
 // STATE INTERFACE
 
 template <class Tcont>
-void _IntLoadResidual_F(std::list<Tcont*>& contactlist, ChVectorDynamic<>& R, const double c) {
-    typename std::list<Tcont*>::iterator itercontact = contactlist.begin();
-    while (itercontact != contactlist.end()) {
-        (*itercontact)->ContIntLoadResidual_F(R, c);
-        ++itercontact;
-    }
+void _IntLoadResidual_F(ChContactPool<Tcont>& contactlist, ChVectorDynamic<>& R, const double c) {
+    // Note: contacts sharing a contactable object write to the same entries of R, so this loop is serial.
+    for (int i = 0; i < contactlist.GetNcontacts(); i++)
+        contactlist[i].ContIntLoadResidual_F(R, c);
 }
 
 void ChContactContainerSMC::IntLoadResidual_F(const unsigned int off, ChVectorDynamic<>& R, const double c) {
@@ -371,34 +276,38 @@ void ChContactContainerSMC::IntLoadResidual_F(const unsigned int off, ChVectorDy
 }
 
 template <class Tcont>
-void _KRMmatricesLoad(std::list<Tcont*> contactlist, double Kfactor, double Rfactor) {
-    typename std::list<Tcont*>::iterator itercontact = contactlist.begin();
-    while (itercontact != contactlist.end()) {
-        (*itercontact)->ContKRMmatricesLoad(Kfactor, Rfactor);
-        ++itercontact;
-    }
+void _KRMmatricesLoad(ChContactPool<Tcont>& contactlist, double Kfactor, double Rfactor, ChTaskScheduler& scheduler) {
+    // Each contact only writes its own Jacobian block.
+    scheduler.ParallelFor(0, contactlist.GetNcontacts(),
+                          [&](int i) { contactlist[i].ContKRMmatricesLoad(Kfactor, Rfactor); }, 64);
 }
 
 void ChContactContainerSMC::KRMmatricesLoad(double Kfactor, double Rfactor, double Mfactor) {
-    _KRMmatricesLoad(contactlist_3_3, Kfactor, Rfactor);
-    _KRMmatricesLoad(contactlist_6_3, Kfactor, Rfactor);
-    _KRMmatricesLoad(contactlist_6_6, Kfactor, Rfactor);
-    _KRMmatricesLoad(contactlist_333_3, Kfactor, Rfactor);
-    _KRMmatricesLoad(contactlist_333_6, Kfactor, Rfactor);
-    _KRMmatricesLoad(contactlist_333_333, Kfactor, Rfactor);
-    _KRMmatricesLoad(contactlist_666_3, Kfactor, Rfactor);
-    _KRMmatricesLoad(contactlist_666_6, Kfactor, Rfactor);
-    _KRMmatricesLoad(contactlist_666_333, Kfactor, Rfactor);
-    _KRMmatricesLoad(contactlist_666_666, Kfactor, Rfactor);
+    if (GetSystem()) {
+        KRMmatricesLoad(Kfactor, Rfactor, *GetSystem()->GetTaskScheduler());
+    } else {
+        ChTaskScheduler serial_scheduler(1);
+        KRMmatricesLoad(Kfactor, Rfactor, serial_scheduler);
+    }
+}
+
+void ChContactContainerSMC::KRMmatricesLoad(double Kfactor, double Rfactor, ChTaskScheduler& scheduler) {
+    _KRMmatricesLoad(contactlist_3_3, Kfactor, Rfactor, scheduler);
+    _KRMmatricesLoad(contactlist_6_3, Kfactor, Rfactor, scheduler);
+    _KRMmatricesLoad(contactlist_6_6, Kfactor, Rfactor, scheduler);
+    _KRMmatricesLoad(contactlist_333_3, Kfactor, Rfactor, scheduler);
+    _KRMmatricesLoad(contactlist_333_6, Kfactor, Rfactor, scheduler);
+    _KRMmatricesLoad(contactlist_333_333, Kfactor, Rfactor, scheduler);
+    _KRMmatricesLoad(contactlist_666_3, Kfactor, Rfactor, scheduler);
+    _KRMmatricesLoad(contactlist_666_6, Kfactor, Rfactor, scheduler);
+    _KRMmatricesLoad(contactlist_666_333, Kfactor, Rfactor, scheduler);
+    _KRMmatricesLoad(contactlist_666_666, Kfactor, Rfactor, scheduler);
 }
 
 template <class Tcont>
-void _InjectKRMmatrices(std::list<Tcont*> contactlist, ChSystemDescriptor& mdescriptor) {
-    typename std::list<Tcont*>::iterator itercontact = contactlist.begin();
-    while (itercontact != contactlist.end()) {
-        (*itercontact)->ContInjectKRMmatrices(mdescriptor);
-        ++itercontact;
-    }
+void _InjectKRMmatrices(ChContactPool<Tcont>& contactlist, ChSystemDescriptor& mdescriptor) {
+    for (int i = 0; i < contactlist.GetNcontacts(); i++)
+        contactlist[i].ContInjectKRMmatrices(mdescriptor);
 }
 
 void ChContactContainerSMC::InjectKRMmatrices(ChSystemDescriptor& mdescriptor) {
@@ -17,17 +17,20 @@
 
 #include <algorithm>
 #include <cmath>
-#include <list>
+#include <vector>
 
 #include "chrono/physics/ChContactContainer.h"
+#include "chrono/physics/ChContactPool.h"
 #include "chrono/physics/ChContactSMC.h"
 #include "chrono/physics/ChContactable.h"
 
 namespace chrono {
 
 /// Class representing a container of many smooth (penalty) contacts.
-/// This is implemented as a typical linked list of ChContactSMC objects
-/// (that is, contacts between two ChContactable objects).
+/// Contacts are ChContactSMC objects (that is, contacts between two ChContactable objects),
+/// stored in pools (one per type of contactable pair) that are reused from step to step.
+/// Contact pairs are first collected by AddContact(); contact forces (and Jacobians, if needed)
+/// are then computed in a batch in EndAddContact(), in parallel over the contacts.
 class ChApi ChContactContainerSMC : public ChContactContainer {
 
   public:
@@ -43,38 +46,47 @@ class ChApi ChContactContainerSMC : public ChContactContainer {
     typedef ChContactSMC<ChContactable_3vars<6, 6, 6>, ChContactable_3vars<6, 6, 6> > ChContactSMC_666_666;
 
   protected:
-    std::list<ChContactSMC_3_3*> contactlist_3_3;
-    std::list<ChContactSMC_6_3*> contactlist_6_3;
-    std::list<ChContactSMC_6_6*> contactlist_6_6;
-    std::list<ChContactSMC_333_3*> contactlist_333_3;
-    std::list<ChContactSMC_333_6*> contactlist_333_6;
-    std::list<ChContactSMC_333_333*> contactlist_333_333;
-    std::list<ChContactSMC_666_3*> contactlist_666_3;
-    std::list<ChContactSMC_666_6*> contactlist_666_6;
-    std::list<ChContactSMC_666_333*> contactlist_666_333;
-    std::list<ChContactSMC_666_666*> contactlist_666_666;
-
-    int n_added_3_3;
-    int n_added_6_3;
-    int n_added_6_6;
-    int n_added_333_3;
-    int n_added_333_6;
-    int n_added_333_333;
-    int n_added_666_3;
-    int n_added_666_6;
-    int n_added_666_333;
-    int n_added_666_666;
-
-    std::list<ChContactSMC_3_3*>::iterator lastcontact_3_3;
-    std::list<ChContactSMC_6_3*>::iterator lastcontact_6_3;
-    std::list<ChContactSMC_6_6*>::iterator lastcontact_6_6;
-    std::list<ChContactSMC_333_3*>::iterator lastcontact_333_3;
-    std::list<ChContactSMC_333_6*>::iterator lastcontact_333_6;
-    std::list<ChContactSMC_333_333*>::iterator lastcontact_333_333;
-    std::list<ChContactSMC_666_3*>::iterator lastcontact_666_3;
-    std::list<ChContactSMC_666_6*>::iterator lastcontact_666_6;
-    std::list<ChContactSMC_666_333*>::iterator lastcontact_666_333;
-    std::list<ChContactSMC_666_666*>::iterator lastcontact_666_666;
+    /// Contact pairs of one type, collected by AddContact() and processed in a batch by EndAddContact().
+    template <class Ta, class Tb>
+    struct ContactBatch {
+        std::vector<Ta*> objA;
+        std::vector<Tb*> objB;
+        std::vector<collision::ChCollisionInfo> cinfo;
+
+        void Add(Ta* mobjA, Tb* mobjB, const collision::ChCollisionInfo& mcinfo) {
+            objA.push_back(mobjA);
+            objB.push_back(mobjB);
+            cinfo.push_back(mcinfo);
+        }
+
+        void Clear() {
+            objA.clear();
+            objB.clear();
+            cinfo.clear();
+        }
+    };
+
+    ChContactPool<ChContactSMC_3_3> contactlist_3_3;
+    ChContactPool<ChContactSMC_6_3> contactlist_6_3;
+    ChContactPool<ChContactSMC_6_6> contactlist_6_6;
+    ChContactPool<ChContactSMC_333_3> contactlist_333_3;
+    ChContactPool<ChContactSMC_333_6> contactlist_333_6;
+    ChContactPool<ChContactSMC_333_333> contactlist_333_333;
+    ChContactPool<ChContactSMC_666_3> contactlist_666_3;
+    ChContactPool<ChContactSMC_666_6> contactlist_666_6;
+    ChContactPool<ChContactSMC_666_333> contactlist_666_333;
+    ChContactPool<ChContactSMC_666_666> contactlist_666_666;
+
+    ContactBatch<ChContactable_1vars<3>, ChContactable_1vars<3>> batch_3_3;
+    ContactBatch<ChContactable_1vars<6>, ChContactable_1vars<3>> batch_6_3;
+    ContactBatch<ChContactable_1vars<6>, ChContactable_1vars<6>> batch_6_6;
+    ContactBatch<ChContactable_3vars<3, 3, 3>, ChContactable_1vars<3>> batch_333_3;
+    ContactBatch<ChContactable_3vars<3, 3, 3>, ChContactable_1vars<6>> batch_333_6;
+    ContactBatch<ChContactable_3vars<3, 3, 3>, ChContactable_3vars<3, 3, 3>> batch_333_333;
+    ContactBatch<ChContactable_3vars<6, 6, 6>, ChContactable_1vars<3>> batch_666_3;
+    ContactBatch<ChContactable_3vars<6, 6, 6>, ChContactable_1vars<6>> batch_666_6;
+    ContactBatch<ChContactable_3vars<6, 6, 6>, ChContactable_3vars<3, 3, 3>> batch_666_333;
+    ContactBatch<ChContactable_3vars<6, 6, 6>, ChContactable_3vars<6, 6, 6>> batch_666_666;
 
   public:
     ChContactContainerSMC();
@@ -86,8 +98,11 @@ class ChApi ChContactContainerSMC : public ChContactContainer {
 
     /// Tell the number of added contacts
     virtual int GetNcontacts() const override {
-        return n_added_3_3 + n_added_6_3 + n_added_6_6 + n_added_333_3 + n_added_333_6 + n_added_333_333 +
-               n_added_666_3 + n_added_666_6 + n_added_666_333 + n_added_666_666;
+        return contactlist_3_3.GetNcontacts() + contactlist_6_3.GetNcontacts() + contactlist_6_6.GetNcontacts() +
+               contactlist_333_3.GetNcontacts() + contactlist_333_6.GetNcontacts() +
+               contactlist_333_333.GetNcontacts() + contactlist_666_3.GetNcontacts() +
+               contactlist_666_6.GetNcontacts() + contactlist_666_333.GetNcontacts() +
+               contactlist_666_666.GetNcontacts();
     }
 
     /// Remove (delete) all contained contact data.
@@ -95,17 +110,20 @@ class ChApi ChContactContainerSMC : public ChContactContainer {
 
     /// The collision system will call BeginAddContact() before adding
     /// all contacts (for example with AddContact() or similar). Instead of
-    /// simply deleting all list of the previous contacts, this optimized implementation
-    /// rewinds the link iterator to begin and tries to reuse previous contact objects
+    /// simply deleting all the previous contacts, this optimized implementation
+    /// rewinds the contact pools, so that previous contact objects are reused
     /// until possible, to avoid too much allocation/deallocation.
     virtual void BeginAddContact() override;
 
     /// Add a contact between two frames.
+    /// The contact pair is only recorded here; the contact is created in EndAddContact().
     virtual void AddContact(const collision::ChCollisionInfo& mcontact) override;
 
-    /// The collision system will call BeginAddContact() after adding
+    /// The collision system will call EndAddContact() after adding
     /// all contacts (for example with AddContact() or similar). This optimized version
-    /// purges the end of the list of contacts that were not reused (if any).
+    /// reinitializes the pooled contacts with the recorded contact pairs and computes the
+    /// contact forces, in parallel (unless an AddContactCallback is provided, because the
+    /// user callback is not assumed to be thread safe).
     virtual void EndAddContact() override;
 
     /// Scans all the contacts and for each contact executes the OnReportContact()
@@ -136,6 +154,10 @@ class ChApi ChContactContainerSMC : public ChContactContainer {
 
     /// Method to allow de-serialization of transient data from archives.
     virtual void ArchiveIN(ChArchiveIn& marchive) override;
+
+  private:
+    void EndAddContact(ChTaskScheduler& scheduler);
+    void KRMmatricesLoad(double Kfactor, double Rfactor, ChTaskScheduler& scheduler);
 };
 
 CH_CLASS_VERSION(ChContactContainerSMC, 0)
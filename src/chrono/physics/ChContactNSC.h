@@ -36,7 +36,7 @@ class ChContactNSC : public ChContactTuple<Ta, Tb> {
     typedef typename ChContactTuple<Ta, Tb>::typecarr_b typecarr_b;
 
   protected:
-    float* reactions_cache;  ///< N,U,V reactions which might be stored in a persistent contact manifold
+    float* reactions_cache;  ///< N,U,V reactions (and rolling torques) which might be stored in a persistent cache
 
     /// The three scalar constraints, to be fed into the system solver.
     /// They contain jacobians data and special functions.
@@ -265,6 +265,12 @@ class ChContactNSC : public ChContactTuple<Ta, Tb> {
         mdescriptor.InsertConstraint(&Tv);
     }
 
+    virtual void AppendConstraints(std::vector<ChConstraint*>& mconstraints) override {
+        mconstraints.push_back(&Nx);
+        mconstraints.push_back(&Tu);
+        mconstraints.push_back(&Tv);
+    }
+
     virtual void ConstraintsBiReset() override {
         Nx.Set_b_i(0.);
         Tu.Set_b_i(0.);
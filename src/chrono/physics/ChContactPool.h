@@ -0,0 +1,106 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+
+#ifndef CH_CONTACT_POOL_H
+#define CH_CONTACT_POOL_H
+
+#include <algorithm>
+#include <cassert>
+#include <deque>
+#include <vector>
+
+#include "chrono/collision/ChCCollisionInfo.h"
+#include "chrono/parallel/ChTaskScheduler.h"
+
+namespace chrono {
+
+class ChContactContainer;
+
+/// Pool of contact objects of a given type, used by the contact containers.
+/// Contacts are stored by value, in blocks of contiguous memory (std::deque), and they never move,
+/// so pointers to them remain valid until the pool is cleared.\n
+/// At each collision detection pass, the pool is rewound and its contacts are reinitialized (with
+/// Tcont::Reset()) for the new contact pairs. New contact objects are constructed only if the
+/// number of contacts exceeds the number of objects allocated so far, and unused objects are kept
+/// for later reuse rather than deleted. Only the first GetNcontacts() contacts are in use.
+template <class Tcont>
+class ChContactPool {
+  public:
+    ChContactPool() : n_added(0) {}
+    ChContactPool(const ChContactPool&) = delete;
+    ChContactPool& operator=(const ChContactPool&) = delete;
+
+    /// Get the number of contacts in use.
+    int GetNcontacts() const { return n_added; }
+
+    /// Get the number of contact objects allocated in the pool (in use or not).
+    int GetCapacity() const { return static_cast<int>(contacts.size()); }
+
+    /// Access the i-th contact in use.
+    Tcont& operator[](int i) {
+        assert(i < n_added);
+        return contacts[i];
+    }
+
+    /// Access the i-th contact in use.
+    const Tcont& operator[](int i) const {
+        assert(i < n_added);
+        return contacts[i];
+    }
+
+    /// Mark all contacts as unused (their objects are kept for reuse).
+    void Rewind() { n_added = 0; }
+
+    /// Delete all contact objects.
+    void Clear() {
+        contacts.clear();
+        n_added = 0;
+    }
+
+    /// Add a contact, reusing an unused object if possible.
+    template <class Ta, class Tb>
+    Tcont* Add(ChContactContainer* container, Ta* objA, Tb* objB, const collision::ChCollisionInfo& cinfo) {
+        if (n_added < GetCapacity())
+            contacts[n_added].Reset(objA, objB, cinfo);
+        else
+            contacts.emplace_back(container, objA, objB, cinfo);
+        return &contacts[n_added++];
+    }
+
+    /// Replace the contacts in the pool with the given batch of contact pairs.
+    /// Missing contact objects are first allocated serially, as uninitialized contacts of the container
+    /// (Tcont must have a constructor taking only the container). Then all contacts are initialized in
+    /// parallel, as tasks of the given scheduler (Tcont::Reset() must then be thread safe).
+    template <class Ta, class Tb>
+    void Assign(ChContactContainer* container,
+                const std::vector<Ta*>& objA,
+                const std::vector<Tb*>& objB,
+                const std::vector<collision::ChCollisionInfo>& cinfo,
+                ChTaskScheduler& scheduler) {
+        int n = static_cast<int>(cinfo.size());
+
+        while (GetCapacity() < n)
+            contacts.emplace_back(container);
+
+        scheduler.ParallelFor(0, n, [&](int i) { contacts[i].Reset(objA[i], objB[i], cinfo[i]); }, 64);
+
+        n_added = n;
+    }
+
+  private:
+    std::deque<Tcont> contacts;  ///< contact objects (in use or not)
+    int n_added;                 ///< number of contacts in use
+};
+
+}  // end namespace chrono
+
+#endif
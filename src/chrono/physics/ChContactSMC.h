@@ -58,6 +58,9 @@ class ChContactSMC : public ChContactTuple<Ta, Tb> {
   public:
     ChContactSMC() : m_Jac(NULL) {}
 
+    /// Construct an uninitialized contact of the given container (see Reset()).
+    explicit ChContactSMC(ChContactContainer* mcontainer) : ChContactTuple<Ta, Tb>(mcontainer), m_Jac(NULL) {}
+
     ChContactSMC(ChContactContainer* mcontainer,      ///< contact container
                  Ta* mobjA,                               ///< collidable object A
                  Tb* mobjB,                               ///< collidable object B
@@ -55,6 +55,9 @@ class ChContactTuple {
 
     ChContactTuple() {}
 
+    /// Construct an uninitialized contact of the given container (see Reset()).
+    explicit ChContactTuple(ChContactContainer* mcontainer) : container(mcontainer) { assert(mcontainer); }
+
     ChContactTuple(ChContactContainer* mcontainer,      ///< contact container
                    Ta* mobjA,                               ///< ChContactable object A
                    Tb* mobjB,                               ///< ChContactable object B
@@ -177,6 +180,9 @@ class ChContactTuple {
 
     virtual void InjectConstraints(ChSystemDescriptor& mdescriptor) {}
 
+    /// Append to 'mconstraints' the scalar constraints of this contact, in the same order used by InjectConstraints().
+    virtual void AppendConstraints(std::vector<ChConstraint*>& mconstraints) {}
+
     virtual void ConstraintsBiReset() {}
 
     virtual void ConstraintsBiLoad_C(double factor = 1., double recovery_clamp = 0.1, bool do_clamp = false) {}
@@ -27,6 +27,7 @@
 #include "chrono/solver/ChSolverPMINRES.h"
 #include "chrono/solver/ChSolverSOR.h"
 #include "chrono/solver/ChSolverSORmultithread.h"
+#include "chrono/solver/ChSolverSparseLU.h"
 #include "chrono/solver/ChSolverSymmSOR.h"
 #include "chrono/timestepper/ChStaticAnalysis.h"
 #include "chrono/core/ChLinkedListMatrix.h"
@@ -67,6 +68,8 @@ ChSystem::ChSystem()
 
     // Set default number of threads to be equal to number of available cores
     parallel_thread_number = CHOMPfunctions::GetNumProcs();
+    task_scheduler = std::make_shared<ChTaskScheduler>(parallel_thread_number);
+    own_task_scheduler = true;
 
     // Set default collision envelope and margin.
     collision::ChCollisionModel::SetDefaultSuggestedEnvelope(0.03);
@@ -98,8 +101,10 @@ ChSystem::ChSystem(const ChSystem& other) : ChAssembly(other) {
     max_penetration_recovery_speed = other.max_penetration_recovery_speed;
     max_iter_solver_speed = other.max_iter_solver_speed;
     max_iter_solver_stab = other.max_iter_solver_stab;
-    SetSolverType(GetSolverType());
     parallel_thread_number = other.parallel_thread_number;
+    task_scheduler = std::make_shared<ChTaskScheduler>(parallel_thread_number);
+    own_task_scheduler = true;
+    SetSolverType(GetSolverType());
     use_sleeping = other.use_sleeping;
 
     ncontacts = other.ncontacts;
@@ -145,7 +150,7 @@ void ChSystem::SetSolverType(ChSolver::Type type) {
         return;
 
     descriptor = std::make_shared<ChSystemDescriptor>();
-    descriptor->SetNumThreads(parallel_thread_number);
+    descriptor->SetTaskScheduler(task_scheduler);
 
     switch (type) {
         case ChSolver::Type::SOR:
@@ -161,9 +166,15 @@ void ChSystem::SetSolverType(ChSolver::Type type) {
             solver_stab = std::make_shared<ChSolverJacobi>();
             break;
         case ChSolver::Type::SOR_MULTITHREAD:
-            solver_speed = std::make_shared<ChSolverSORmultithread>("speedSolver", parallel_thread_number);
-            solver_stab = std::make_shared<ChSolverSORmultithread>("posSolver", parallel_thread_number);
+        {
+            auto sor_speed = std::make_shared<ChSolverSORmultithread>("speedSolver", parallel_thread_number);
+            auto sor_stab = std::make_shared<ChSolverSORmultithread>("posSolver", parallel_thread_number);
+            sor_speed->SetTaskScheduler(task_scheduler);
+            sor_stab->SetTaskScheduler(task_scheduler);
+            solver_speed = sor_speed;
+            solver_stab = sor_stab;
             break;
+        }
         case ChSolver::Type::PMINRES:
             solver_speed = std::make_shared<ChSolverPMINRES>();
             solver_stab = std::make_shared<ChSolverPMINRES>();
@@ -184,6 +195,15 @@ void ChSystem::SetSolverType(ChSolver::Type type) {
             solver_speed = std::make_shared<ChSolverMINRES>();
             solver_stab = std::make_shared<ChSolverMINRES>();
             break;
+        case ChSolver::Type::SPARSE_LU: {
+            auto lu_speed = std::make_shared<ChSolverSparseLU>();
+            auto lu_stab = std::make_shared<ChSolverSparseLU>();
+            lu_speed->SetTaskScheduler(task_scheduler);
+            lu_stab->SetTaskScheduler(task_scheduler);
+            solver_speed = lu_speed;
+            solver_stab = lu_stab;
+            break;
+        }
         default:
             solver_speed = std::make_shared<ChSolverSymmSOR>();
             solver_stab = std::make_shared<ChSolverSymmSOR>();
@@ -269,7 +289,9 @@ void ChSystem::SetParallelThreadNumber(int mthreads) {
 
     parallel_thread_number = mthreads;
 
-    descriptor->SetNumThreads(mthreads);
+    // A scheduler provided with SetTaskScheduler may be used by other systems and is never resized here
+    if (own_task_scheduler)
+        task_scheduler->SetNumThreads(mthreads);
 
     if (solver_speed->GetType() == ChSolver::Type::SOR_MULTITHREAD) {
         std::static_pointer_cast<ChSolverSORmultithread>(solver_speed)->ChangeNumberOfThreads(mthreads);
@@ -277,20 +299,51 @@ void ChSystem::SetParallelThreadNumber(int mthreads) {
     }
 }
 
+void ChSystem::SetTaskScheduler(std::shared_ptr<ChTaskScheduler> scheduler) {
+    assert(scheduler);
+    task_scheduler = scheduler;
+    own_task_scheduler = false;
+
+    if (collision_system)
+        collision_system->SetTaskScheduler(task_scheduler);
+
+    descriptor->SetTaskScheduler(task_scheduler);
+
+    if (solver_speed->GetType() == ChSolver::Type::SOR_MULTITHREAD) {
+        std::static_pointer_cast<ChSolverSORmultithread>(solver_speed)->SetTaskScheduler(task_scheduler);
+        std::static_pointer_cast<ChSolverSORmultithread>(solver_stab)->SetTaskScheduler(task_scheduler);
+    }
+    if (auto lu_solver_speed = std::dynamic_pointer_cast<ChSolverSparseLU>(solver_speed))
+        lu_solver_speed->SetTaskScheduler(task_scheduler);
+    if (auto lu_solver_stab = std::dynamic_pointer_cast<ChSolverSparseLU>(solver_stab))
+        lu_solver_stab->SetTaskScheduler(task_scheduler);
+
+    SetParallelThreadNumber(task_scheduler->GetNumThreads());
+}
+
 // Plug-in components configuration
 
 void ChSystem::SetSystemDescriptor(std::shared_ptr<ChSystemDescriptor> newdescriptor) {
     assert(newdescriptor);
     descriptor = newdescriptor;
+    descriptor->SetTaskScheduler(task_scheduler);
 }
 void ChSystem::SetSolver(std::shared_ptr<ChSolver> newsolver) {
     assert(newsolver);
     solver_speed = newsolver;
+    if (auto lu_solver = std::dynamic_pointer_cast<ChSolverSparseLU>(newsolver)) {
+        if (!lu_solver->GetTaskScheduler())
+            lu_solver->SetTaskScheduler(task_scheduler);
+    }
 }
 
 void ChSystem::SetStabSolver(std::shared_ptr<ChSolver> newsolver) {
     assert(newsolver);
     solver_stab = newsolver;
+    if (auto lu_solver = std::dynamic_pointer_cast<ChSolverSparseLU>(newsolver)) {
+        if (!lu_solver->GetTaskScheduler())
+            lu_solver->SetTaskScheduler(task_scheduler);
+    }
 }
 
 void ChSystem::SetContactContainer(std::shared_ptr<ChContactContainer> container) {
@@ -303,6 +356,7 @@ void ChSystem::SetCollisionSystem(std::shared_ptr<ChCollisionSystem> newcollsyst
     assert(GetNbodies() == 0);
     assert(newcollsystem);
     collision_system = newcollsystem;
+    collision_system->SetTaskScheduler(task_scheduler);
 }
 
 void ChSystem::SetMaterialCompositionStrategy(std::unique_ptr<ChMaterialCompositionStrategy<float>>&& strategy) {
@@ -34,6 +34,7 @@
 #include "chrono/physics/ChGlobal.h"
 #include "chrono/physics/ChLinksAll.h"
 #include "chrono/physics/ChProbe.h"
+#include "chrono/parallel/ChTaskScheduler.h"
 #include "chrono/solver/ChSystemDescriptor.h"
 #include "chrono/timestepper/ChAssemblyAnalysis.h"
 #include "chrono/solver/ChSolver.h"
@@ -184,6 +185,7 @@ class ChApi ChSystem : public ChAssembly, public ChIntegrableIIorder {
     ///   - Suggested solver for speed, but lower precision: SOR
     ///   - Suggested solver for higher precision: BARZILAIBORWEIN or APGD
     ///   - For problems that involve a stiffness matrix: MINRES
+    ///   - For stiff problems (FEA, implicit integrators) without unilateral constraints: SPARSE_LU
     ///
     /// *Notes*:
     ///   - Do not use CUSTOM type, as this type is reserved for external solvers
@@ -259,11 +261,24 @@ class ChApi ChSystem : public ChAssembly, public ChIntegrableIIorder {
     /// Changes the number of parallel threads (by default is n.of cores).
     /// Note that not all solvers use parallel computation.
     /// If you have a N-core processor, this should be set at least =N for maximum performance.
+    /// This also resizes the task scheduler of the system, unless the scheduler was provided with
+    /// SetTaskScheduler and may thus be used by other systems; in that case, the
+    /// number of threads running the tasks is set by the owner of the scheduler.
     void SetParallelThreadNumber(int mthreads = 2);
     /// Get the number of parallel threads.
     /// Note that not all solvers use parallel computation.
     int GetParallelThreadNumber() { return parallel_thread_number; }
 
+    /// Get the task scheduler of the system, used by the multithreaded parts of the computation
+    /// (FEA element loops, contact forces, collision detection, solvers) to run their tasks.
+    std::shared_ptr<ChTaskScheduler> GetTaskScheduler() const { return task_scheduler; }
+
+    /// Replace the task scheduler of the system, for example to share one scheduler among several
+    /// systems in the same process, so that they do not oversubscribe the cores when stepped concurrently.
+    /// The number of parallel threads of the system is set to the number of threads of the scheduler.
+    /// The scheduler is not owned by the system: SetParallelThreadNumber does not resize it afterwards.
+    void SetTaskScheduler(std::shared_ptr<ChTaskScheduler> scheduler);
+
     /// Sets the G (gravity) acceleration vector, affecting all the bodies in the system.
     void Set_G_acc(const ChVector<>& m_acc) { G_acc = m_acc; }
     /// Gets the G (gravity) acceleration vector affecting all the bodies in the system.
@@ -825,6 +840,9 @@ class ChApi ChSystem : public ChAssembly, public ChIntegrableIIorder {
 
     int parallel_thread_number;  ///< used for multithreaded solver
 
+    std::shared_ptr<ChTaskScheduler> task_scheduler;  ///< runs the tasks of multithreaded computations
+    bool own_task_scheduler;                          ///< true if the scheduler was created by this system
+
     size_t stepcount;  ///< internal counter for steps
 
     int setupcount;  ///< number of calls to the solver's Setup()
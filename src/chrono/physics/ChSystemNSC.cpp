@@ -51,10 +51,11 @@ ChSystemNSC::ChSystemNSC(unsigned int max_objects, double scene_size, bool init_
 
         // Set default collision engine
         collision_system = std::make_shared<collision::ChCollisionSystemBullet>(max_objects, scene_size);
+        collision_system->SetTaskScheduler(task_scheduler);
 
         // Set the system descriptor
         descriptor = std::make_shared<ChSystemDescriptor>();
-        descriptor->SetNumThreads(parallel_thread_number);
+        descriptor->SetTaskScheduler(task_scheduler);
 
         // Set default solver
         SetSolverType(ChSolver::Type::SYMMSOR);
@@ -40,12 +40,13 @@ ChSystemSMC::ChSystemSMC(bool use_material_properties, unsigned int max_objects,
       m_tdispl_model(OneStep),
       m_stiff_contact(false) {
     descriptor = std::make_shared<ChSystemDescriptor>();
-    descriptor->SetNumThreads(parallel_thread_number);
+    descriptor->SetTaskScheduler(task_scheduler);
 
     solver_speed = std::make_shared<ChSolverSMC>();
     solver_stab = std::make_shared<ChSolverSMC>();
 
     collision_system = std::make_shared<collision::ChCollisionSystemBullet>(max_objects, scene_size);
+    collision_system->SetTaskScheduler(task_scheduler);
 
     // For default SMC there is no need to create contacts 'in advance'
     // when models are closer than the safety envelope, so set default envelope to 0
@@ -15,6 +15,8 @@
 #ifndef CHCONSTRAINT_H
 #define CHCONSTRAINT_H
 
+#include <vector>
+
 #include "chrono/core/ChApiCE.h"
 #include "chrono/core/ChClassFactory.h"
 #include "chrono/core/ChMatrix.h"
@@ -22,6 +24,8 @@
 
 namespace chrono {
 
+class ChVariables;
+
 /// Modes for constraint
 enum eChConstraintMode {
     CONSTRAINT_FREE = 0,        ///< the constraint does not enforce anything
@@ -298,6 +302,13 @@ class ChApi ChConstraint {
     /// Same as Build_Cq, but puts the _transposed_ jacobian row as a column.
     virtual void Build_CqT(ChSparseMatrix& storage, int inscol) = 0;
 
+    /// Append to 'vars' the ChVariables objects referenced by this constraint,
+    /// i.e. those modified by Increment_q() and MultiplyTandAdd().
+    /// This is used by ChSystemDescriptor to find constraints that can be processed
+    /// concurrently. The default implementation appends nothing, meaning that the
+    /// referenced variables are unknown and the constraint is always processed serially.
+    virtual void CollectVariables(std::vector<ChVariables*>& vars) {}
+
     /// Set offset in global q vector (set automatically by ChSystemDescriptor)
     void SetOffset(int moff) { offset = moff; }
 
@@ -65,6 +65,10 @@ class ChApi ChConstraintNgeneric : public ChConstraint {
     /// automatically creating/resizing jacobians if needed.
     virtual void SetVariables(std::vector<ChVariables*> mvars);
 
+    virtual void CollectVariables(std::vector<ChVariables*>& vars) override {
+        vars.insert(vars.end(), variables.begin(), variables.end());
+    }
+
 	/// This function updates the following auxiliary data:
 	///  - the Eq  matrices
 	///  - the g_i product
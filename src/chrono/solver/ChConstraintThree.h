@@ -73,6 +73,12 @@ class ChApi ChConstraintThree : public ChConstraint {
     /// automatically creating/resizing jacobians if needed.
     virtual void SetVariables(ChVariables* mvariables_a, ChVariables* mvariables_b, ChVariables* mvariables_c) = 0;
 
+    virtual void CollectVariables(std::vector<ChVariables*>& vars) override {
+        vars.push_back(variables_a);
+        vars.push_back(variables_b);
+        vars.push_back(variables_c);
+    }
+
     /// Method to allow serialization of transient data to archives.
     virtual void ArchiveOUT(ChArchiveOut& marchive) override;
 
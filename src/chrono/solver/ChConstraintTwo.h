@@ -66,6 +66,11 @@ class ChApi ChConstraintTwo : public ChConstraint {
     /// automatically creating/resizing jacobians if needed.
     virtual void SetVariables(ChVariables* mvariables_a, ChVariables* mvariables_b) = 0;
 
+    virtual void CollectVariables(std::vector<ChVariables*>& vars) override {
+        vars.push_back(variables_a);
+        vars.push_back(variables_b);
+    }
+
     /// Method to allow serialization of transient data to archives.
     virtual void ArchiveOUT(ChArchiveOut& marchive) override;
 
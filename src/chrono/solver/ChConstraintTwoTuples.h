@@ -123,6 +123,11 @@ class ChConstraintTwoTuples : public ChConstraint {
         tuple_a.Build_CqT(storage, inscol);
         tuple_b.Build_CqT(storage, inscol);
     }
+
+    virtual void CollectVariables(std::vector<ChVariables*>& vars) override {
+        tuple_a.CollectVariables(vars);
+        tuple_b.CollectVariables(vars);
+    }
 };
 
 }  // end namespace chrono
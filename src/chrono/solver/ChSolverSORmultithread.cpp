@@ -25,7 +25,7 @@ namespace chrono {
 // Register into the object factory, to enable run-time dynamic creation and persistence
 CH_FACTORY_REGISTER(ChSolverSORmultithread)
 
-// Each thread will own an instance of the following data:
+// Each task (one per slice of constraints) will own an instance of the following data:
 
 struct thread_data {
     ChSolverSORmultithread* solver;  // reference to solver
@@ -47,16 +47,10 @@ struct thread_data {
     std::vector<ChVariables*>* mvariables;
 };
 
-// Don't create local store memory, just return 0
-
-void* SolverMemoryFunc() {
-    return 0;
-}
-
 // The following is the function which will be executed by
-// each thread, when threads are launched at each Solve()
+// each task, for each stage of Solve()
 
-void SolverThreadFunc(void* userPtr, void* lsMemory) {
+static void SolverThreadFunc(void* userPtr) {
     double maxviolation = 0.;
     double maxdeltalambda = 0.;
     int i_friction_comp = 0;
@@ -248,8 +242,8 @@ void SolverThreadFunc(void* userPtr, void* lsMemory) {
     }  // end stage  switching
 }
 
-// When the solver object is created, threads are also
-// created and initialized, in 'wait' mode.
+// When the solver object is created, it also creates its own task scheduler
+// (worker threads are started at the first Solve()).
 
 ChSolverSORmultithread::ChSolverSORmultithread(const char* uniquename,
                                                int nthreads,
@@ -257,25 +251,17 @@ ChSolverSORmultithread::ChSolverSORmultithread(const char* uniquename,
                                                bool mwarm_start,
                                                double mtolerance,
                                                double momega)
-    : ChIterativeSolver(mmax_iters, mwarm_start, mtolerance, momega) {
-    ChThreadConstructionInfo create_args(uniquename, SolverThreadFunc, SolverMemoryFunc, nthreads);
-
-    solver_threads = new ChThreads(create_args);
+    : ChIterativeSolver(mmax_iters, mwarm_start, mtolerance, momega), own_scheduler(true) {
+    num_threads = (nthreads < 1) ? 1 : nthreads;
+    scheduler = std::make_shared<ChTaskScheduler>(num_threads);
 }
 
-ChSolverSORmultithread::~ChSolverSORmultithread() {
-    if (solver_threads) {
-        solver_threads->flush();
-        delete (solver_threads);
-        solver_threads = 0;
-    }
-}
+ChSolverSORmultithread::~ChSolverSORmultithread() {}
 
 // The SOR solver process has been modified so that some
 // parallelizable code has been moved to the SolverThreadFunc().
-// So, the N threads must be started (each executing SolverThreadFunc() )
-// and, after waiting for all them to be completed, with flush(), the
-// solution is done.
+// So, the N tasks must be submitted (each executing SolverThreadFunc() )
+// and, after waiting for all them to be completed, the next stage can start.
 
 double ChSolverSORmultithread::Solve(
     ChSystemDescriptor& sysd  ///< system description with constraints and variables
@@ -293,9 +279,9 @@ double ChSolverSORmultithread::Solve(
     ChMutexSpinlock spinlock;
 
     // --0--  preparation:
-    //        subdivide the workload to the threads and prepare their 'thread_data':
+    //        subdivide the workload to the tasks and prepare their 'thread_data':
 
-    int numthreads = this->solver_threads->getNumberOfThreads();
+    int numthreads = num_threads;
     std::vector<thread_data> mdataN(numthreads);
 
     int var_slice = 0;
@@ -334,33 +320,25 @@ double ChSolverSORmultithread::Solve(
     }
 
     // LAUNCH THE PARALLEL COMPUTATION ON THREADS !!!!
+    //... each stage returns only when all the tasks finished it.
+
+    auto run_stage = [&](thread_data::solver_stage stage) {
+        for (int nth = 0; nth < numthreads; nth++)
+            mdataN[nth].stage = stage;
+        scheduler->ParallelFor(0, numthreads, [&](int nth) { SolverThreadFunc(&mdataN[nth]); });
+    };
 
     // --1--  stage:
     //        precompute aux variables in constraints.
-    for (int nth = 0; nth < numthreads; nth++) {
-        mdataN[nth].stage = thread_data::STAGE1_PREPARE;
-        solver_threads->sendRequest(1, &mdataN[nth], nth);
-    }
-    //... must wait that the all the threads finished their stage!!!
-    solver_threads->flush();
+    run_stage(thread_data::STAGE1_PREPARE);
 
     // --2--  stage:
     //        add external forces and mass effects, on variables.
-    for (int nth = 0; nth < numthreads; nth++) {
-        mdataN[nth].stage = thread_data::STAGE2_ADDFORCES;
-        solver_threads->sendRequest(1, &mdataN[nth], nth);
-    }
-    //... must wait that the all the threads finished their stage!!!
-    solver_threads->flush();
+    run_stage(thread_data::STAGE2_ADDFORCES);
 
     // --3--  stage:
     //        loop on constraints.
-    for (int nth = 0; nth < numthreads; nth++) {
-        mdataN[nth].stage = thread_data::STAGE3_LOOPCONSTRAINTS;
-        solver_threads->sendRequest(1, &mdataN[nth], nth);
-    }
-    //... must wait that the all the threads finished their stage!!!
-    solver_threads->flush();
+    run_stage(thread_data::STAGE3_LOOPCONSTRAINTS);
 
     return 0;
 }
@@ -369,16 +347,15 @@ void ChSolverSORmultithread::ChangeNumberOfThreads(int mthreads) {
     if (mthreads < 1)
         mthreads = 1;
 
-    char mname[100];
-    strncpy(mname, solver_threads->getUniqueName().c_str(), sizeof(mname)-1);
+    num_threads = mthreads;
 
-    solver_threads->flush();
-    delete (solver_threads);
-    solver_threads = 0;
-
-    ChThreadConstructionInfo create_args(mname, SolverThreadFunc, SolverMemoryFunc, mthreads);
+    if (own_scheduler)
+        scheduler->SetNumThreads(mthreads);
+}
 
-    solver_threads = new ChThreads(create_args);
+void ChSolverSORmultithread::SetTaskScheduler(std::shared_ptr<ChTaskScheduler> mscheduler) {
+    scheduler = mscheduler;
+    own_scheduler = false;
 }
 
 } // end namespace chrono
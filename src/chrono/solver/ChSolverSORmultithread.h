@@ -16,21 +16,25 @@
 #define CHSOLVERSORMULTITHREAD_H
 
 #include "chrono/solver/ChIterativeSolver.h"
-#include "chrono/parallel/ChThreads.h"
+#include "chrono/parallel/ChTaskScheduler.h"
 
 namespace chrono {
 /// An iterative solver based on projective fixed point method, with overrelaxation
 /// and immediate variable update as in SOR methods. Multi-threaded.\n
+/// The constraints are split in as many slices as threads, and the slices are processed in parallel
+/// as tasks of a ChTaskScheduler (the solver's own one, or the one of the system, see SetTaskScheduler).\n
 /// See ChSystemDescriptor for more information about the problem formulation and the data structures
 /// passed to the solver.
 
 class ChApi ChSolverSORmultithread : public ChIterativeSolver {
 
   protected:
-    ChThreads* solver_threads;
+    std::shared_ptr<ChTaskScheduler> scheduler;
+    bool own_scheduler;
+    int num_threads;
 
   public:
-    ChSolverSORmultithread(const char* uniquename = "solver",  ///< this name must be unique.
+    ChSolverSORmultithread(const char* uniquename = "solver",  ///< name (unused, kept for compatibility)
                            int nthreads = 2,                   ///< number of threads
                            int mmax_iters = 50,                ///< max.number of iterations
                            bool mwarm_start = false,           ///< uses warm start?
@@ -48,8 +52,16 @@ class ChApi ChSolverSORmultithread : public ChIterativeSolver {
     virtual double Solve(ChSystemDescriptor& sysd  ///< system description with constraints and variables
                          ) override;
 
-    /// Changes the number of threads which run in parallel (should be > 1 )
+    /// Changes the number of threads which run in parallel (should be > 1 ).
+    /// This is also the number of slices of constraints. If the solver uses its own task scheduler,
+    /// the scheduler is resized too.
     void ChangeNumberOfThreads(int mthreads = 2);
+
+    /// Use a shared task scheduler (for example the one of the ChSystem) instead of the solver's own one.
+    void SetTaskScheduler(std::shared_ptr<ChTaskScheduler> mscheduler);
+
+    /// Get the task scheduler used by the solver.
+    std::shared_ptr<ChTaskScheduler> GetTaskScheduler() const { return scheduler; }
 };
 
 }  // end namespace chrono
@@ -0,0 +1,135 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+
+#include "chrono/solver/ChSolverSparseLU.h"
+
+namespace chrono {
+
+// Register into the object factory, to enable run-time dynamic creation and persistence
+CH_FACTORY_REGISTER(ChSolverSparseLU)
+
+ChSolverSparseLU::ChSolverSparseLU() : m_mat(1, 1) {
+    SetSparsityPatternLock(true);
+}
+
+bool ChSolverSparseLU::Setup(ChSystemDescriptor& sysd) {
+    m_timer_setup_assembly.start();
+
+    // Calculate problem size; a change in size always invalidates the sparsity pattern.
+    int dim = sysd.CountActiveVariables() + sysd.CountActiveConstraints();
+    bool resized = (dim != m_dim);
+    m_dim = dim;
+
+    // Let the matrix acquire the information about ChSystem
+    bool pattern_changed = resized || !m_lock;
+    if (m_force_sparsity_pattern_update) {
+        m_force_sparsity_pattern_update = false;
+        pattern_changed = true;
+
+        ChSparsityPatternLearner sparsity_learner(m_dim, m_dim, true);
+        sysd.ConvertToMatrixForm(&sparsity_learner, nullptr);
+        m_mat.LoadSparsityPattern(sparsity_learner);
+    } else {
+        // If an NNZ value for the underlying matrix was specified, perform an initial resizing, *before*
+        // a call to ChSystemDescriptor::ConvertToMatrixForm(), to allow for possible size optimizations.
+        // Otherwise, do this only at the first call, using the default sparsity fill-in.
+        if (m_nnz == 0 && !m_lock || m_setup_call == 0 || resized)
+            m_mat.Reset(m_dim, m_dim, static_cast<int>(m_dim * (m_dim * SPM_DEF_FULLNESS)));
+        else if (m_nnz > 0)
+            m_mat.Reset(m_dim, m_dim, m_nnz);
+    }
+
+    // Please mind that Reset will be called again on m_mat, inside ConvertToMatrixForm
+    sysd.ConvertToMatrixForm(&m_mat, nullptr);
+
+    // Allow the matrix to be compressed.
+    m_mat.Compress();
+
+    m_timer_setup_assembly.stop();
+
+    // Perform the factorization. If the sparsity pattern is locked, the engine reuses the previous
+    // symbolic factorization (provided the pattern did not actually change).
+    m_timer_setup_solvercall.start();
+    bool success = m_engine.Factorize(m_mat, !pattern_changed);
+    m_timer_setup_solvercall.stop();
+
+    m_setup_call++;
+
+    if (verbose) {
+        GetLog() << " SparseLU setup n = " << m_dim << "  nnz = " << m_mat.GetNNZ()
+                 << "  nnz(L+U) = " << m_engine.GetFactorNNZ() << "  levels = " << m_engine.GetNumLevels() << "\n";
+        GetLog() << "  assembly: " << m_timer_setup_assembly.GetTimeSecondsIntermediate() << "s"
+                 << "  solver_call: " << m_timer_setup_solvercall.GetTimeSecondsIntermediate() << "\n";
+    }
+
+    if (!success) {
+        GetLog() << "SparseLU factorization error: singular matrix\n";
+        return false;
+    }
+
+    return true;
+}
+
+double ChSolverSparseLU::Solve(ChSystemDescriptor& sysd) {
+    // Assemble the problem right-hand side vector.
+    m_timer_solve_assembly.start();
+    sysd.ConvertToMatrixForm(nullptr, &m_rhs);
+    m_timer_solve_assembly.stop();
+
+    if (!m_engine.IsFactorized() || m_rhs.GetRows() != m_engine.GetSize()) {
+        GetLog() << "SparseLU solve error: no valid factorization\n";
+        return -1.0;
+    }
+
+    // Solve the problem with forward/backward substitutions.
+    m_timer_solve_solvercall.start();
+    m_engine.Solve(m_rhs, m_sol);
+    m_timer_solve_solvercall.stop();
+
+    m_solve_call++;
+
+    if (verbose) {
+        GetLog() << " SparseLU solve call " << m_solve_call << "\n";
+        GetLog() << "  assembly: " << m_timer_solve_assembly.GetTimeSecondsIntermediate() << "s\n"
+                 << "  solver_call: " << m_timer_solve_solvercall.GetTimeSecondsIntermediate() << "\n";
+    }
+
+    // Scatter solution vector to the system descriptor.
+    m_timer_solve_assembly.start();
+    sysd.FromVectorToUnknowns(m_sol);
+    m_timer_solve_assembly.stop();
+
+    return 0.0;
+}
+
+void ChSolverSparseLU::ArchiveOUT(ChArchiveOut& marchive) {
+    // version number
+    marchive.VersionWrite<ChSolverSparseLU>();
+    // serialize parent class
+    ChSolver::ArchiveOUT(marchive);
+    // serialize all member data:
+    marchive << CHNVP(m_lock);
+    marchive << CHNVP(m_nnz);
+}
+
+void ChSolverSparseLU::ArchiveIN(ChArchiveIn& marchive) {
+    // version number
+    int version = marchive.VersionRead<ChSolverSparseLU>();
+    // deserialize parent class
+    ChSolver::ArchiveIN(marchive);
+    // stream in all member data:
+    marchive >> CHNVP(m_lock);
+    marchive >> CHNVP(m_nnz);
+    SetSparsityPatternLock(m_lock);
+}
+
+}  // end namespace chrono
@@ -0,0 +1,160 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+
+#ifndef CHSOLVERSPARSELU_H
+#define CHSOLVERSPARSELU_H
+
+#include "chrono/core/ChCSMatrix.h"
+#include "chrono/core/ChMatrixDynamic.h"
+#include "chrono/core/ChTimer.h"
+#include "chrono/solver/ChSolver.h"
+#include "chrono/solver/ChSparseLUEngine.h"
+#include "chrono/solver/ChSystemDescriptor.h"
+
+namespace chrono {
+
+/// @addtogroup chrono_solver
+/// @{
+
+/** \class ChSolverSparseLU
+\brief Built-in sparse direct solver, based on a multithreaded sparse LU factorization.
+
+Sparse linear direct solver, with no external dependencies (see ChSparseLUEngine).
+Cannot handle VI and complementarity problems, so it cannot be used with NSC formulations.
+
+As ChSolverMKL, the solver is equipped with two main features:
+- sparsity pattern lock
+- sparsity pattern learning
+
+If the sparsity pattern \e lock is enabled (default), the symbolic factorization (fill-reducing ordering, pivot
+sequence and patterns of the factors) is reused from call to call, as long as the sparsity pattern of the assembled
+matrix does not change. In that case, only a numeric refactorization is performed, in parallel over independent
+columns of the factors.\n
+Is controlled by #SetSparsityPatternLock();
+
+The sparsity pattern \e learning feature acquires the sparsity pattern in advance, in order to speed up
+the first build of the matrix.\n
+Is controlled by #ForceSparsityPatternUpdate();
+
+Minimal usage example, to be put anywhere in the code, before starting the main simulation loop:
+\code{.cpp}
+my_system.SetSolverType(ChSolver::Type::SPARSE_LU);
+\endcode
+or
+\code{.cpp}
+auto lu_solver = std::make_shared<ChSolverSparseLU>();
+my_system.SetSolver(lu_solver);
+\endcode
+
+See ChSystemDescriptor for more information about the problem formulation and the data structures
+passed to the solver.
+*/
+class ChApi ChSolverSparseLU : public ChSolver {
+  public:
+    ChSolverSparseLU();
+
+    ~ChSolverSparseLU() override {}
+
+    virtual Type GetType() const override { return Type::SPARSE_LU; }
+
+    /// Get a handle to the underlying factorization engine.
+    ChSparseLUEngine& GetEngine() { return m_engine; }
+
+    /// Get a handle to the underlying matrix.
+    ChCSMatrix& GetMatrix() { return m_mat; }
+
+    /// Enable/disable locking the sparsity pattern (default: true).\n
+    /// If \a val is set to true, then the sparsity pattern of the problem matrix is assumed
+    /// to be unchanged from call to call and the symbolic factorization is reused.
+    void SetSparsityPatternLock(bool val) {
+        m_lock = val;
+        m_mat.SetSparsityPatternLock(m_lock);
+    }
+
+    /// Call an update of the sparsity pattern on the underlying matrix.\n
+    /// It is used to inform the solver (and the underlying matrices) that the sparsity pattern is changed.\n
+    /// It is suggested to call this function just after the construction of the solver.
+    void ForceSparsityPatternUpdate(bool val = true) { m_force_sparsity_pattern_update = val; }
+
+    /// Set the number of non-zero entries in the problem matrix.
+    void SetMatrixNNZ(int nnz) { m_nnz = nnz; }
+
+    /// Set the task scheduler running the numeric refactorization (the ChSystem sets its own scheduler).
+    void SetTaskScheduler(std::shared_ptr<ChTaskScheduler> scheduler) { m_engine.SetTaskScheduler(scheduler); }
+
+    /// Get the task scheduler running the numeric refactorization.
+    std::shared_ptr<ChTaskScheduler> GetTaskScheduler() const { return m_engine.GetTaskScheduler(); }
+
+    /// Reset timers for internal phases in Solve and Setup.
+    void ResetTimers() {
+        m_timer_setup_assembly.reset();
+        m_timer_setup_solvercall.reset();
+        m_timer_solve_assembly.reset();
+        m_timer_solve_solvercall.reset();
+    }
+
+    /// Get cumulative time for assembly operations in Solve phase.
+    double GetTimeSolve_Assembly() const { return m_timer_solve_assembly(); }
+    /// Get cumulative time for triangular solves in Solve phase.
+    double GetTimeSolve_SolverCall() const { return m_timer_solve_solvercall(); }
+    /// Get cumulative time for assembly operations in Setup phase.
+    double GetTimeSetup_Assembly() const { return m_timer_setup_assembly(); }
+    /// Get cumulative time for factorization in Setup phase.
+    double GetTimeSetup_SolverCall() const { return m_timer_setup_solvercall(); }
+    /// Return the number of calls to the solver's Setup function.
+    int GetNumSetupCalls() const { return m_setup_call; }
+    /// Return the number of calls to the solver's Solve function.
+    int GetNumSolveCalls() const { return m_solve_call; }
+
+    /// Indicate whether or not the #Solve() phase requires an up-to-date problem matrix.
+    /// As typical of direct solvers, the matrix is only needed in the #Setup() phase.
+    virtual bool SolveRequiresMatrix() const override { return false; }
+
+    /// Perform the solver setup operations.
+    /// This means assembling and factorizing the system matrix.
+    /// Returns true if successful and false otherwise.
+    virtual bool Setup(ChSystemDescriptor& sysd) override;
+
+    /// Solve using the current factorization, obtained at the last call to Setup().
+    virtual double Solve(ChSystemDescriptor& sysd) override;
+
+    /// Method to allow serialization of transient data to archives.
+    virtual void ArchiveOUT(ChArchiveOut& marchive) override;
+
+    /// Method to allow de-serialization of transient data from archives.
+    virtual void ArchiveIN(ChArchiveIn& marchive) override;
+
+  private:
+    ChSparseLUEngine m_engine;      ///< sparse LU factorization
+    ChCSMatrix m_mat;               ///< problem matrix
+    ChMatrixDynamic<double> m_rhs;  ///< right-hand side vector
+    ChMatrixDynamic<double> m_sol;  ///< solution vector
+
+    int m_dim = 0;         ///< problem size
+    int m_nnz = 0;         ///< user-supplied estimate of NNZ
+    int m_solve_call = 0;  ///< counter for calls to Solve
+    int m_setup_call = 0;  ///< counter for calls to Setup
+
+    bool m_lock = false;                           ///< is the matrix sparsity pattern locked?
+    bool m_force_sparsity_pattern_update = false;  ///< is the sparsity pattern changed compared to last call?
+
+    ChTimer<> m_timer_setup_assembly;    ///< timer for matrix assembly
+    ChTimer<> m_timer_setup_solvercall;  ///< timer for factorization
+    ChTimer<> m_timer_solve_assembly;    ///< timer for RHS assembly
+    ChTimer<> m_timer_solve_solvercall;  ///< timer for solution
+};
+
+/// @} chrono_solver
+
+}  // end namespace chrono
+
+#endif
@@ -0,0 +1,504 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <cmath>
+#include <cstring>
+#include <iterator>
+#include <set>
+#include <utility>
+
+#include "chrono/solver/ChSparseLUEngine.h"
+
+namespace chrono {
+
+ChSparseLUEngine::ChSparseLUEngine()
+    : m_ordering(Ordering::MIN_DEGREE),
+      m_pivot_tol(0.1),
+      m_refactor_tol(1e-8),
+      m_n(0),
+      m_factorized(false),
+      m_num_symbolic(0),
+      m_num_refactor(0),
+      m_row_major(true) {}
+
+// -----------------------------------------------------------------------------
+
+bool ChSparseLUEngine::Factorize(const ChCSMatrix& A, bool reuse_symbolic) {
+    assert(A.GetNumRows() == A.GetNumColumns());
+
+    if (reuse_symbolic && m_factorized && SamePattern(A)) {
+        LoadValues(A);
+        if (Refactorize()) {
+            m_num_refactor++;
+            return true;
+        }
+        // Pivot sequence no longer acceptable; fall back to a complete factorization
+        // (the pattern of A is unchanged, so the ordering is reused).
+        m_factorized = FactorizeFull();
+        m_num_symbolic++;
+        return m_factorized;
+    }
+
+    AnalyzePattern(A);
+    LoadValues(A);
+    ComputeOrdering();
+    m_factorized = FactorizeFull();
+    m_num_symbolic++;
+
+    return m_factorized;
+}
+
+// -----------------------------------------------------------------------------
+
+void ChSparseLUEngine::AnalyzePattern(const ChCSMatrix& A) {
+    m_n = A.GetNumRows();
+    m_row_major = A.IsRowMajor();
+
+    const int* lead = A.GetCS_LeadingIndexArray();
+    const int* trail = A.GetCS_TrailingIndexArray();
+    int nnz = lead[m_n];
+
+    m_in_lead.assign(lead, lead + m_n + 1);
+    m_in_trail.assign(trail, trail + nnz);
+    m_in_map.resize(nnz);
+
+    m_Ap.assign(m_n + 1, 0);
+    m_Ai.resize(nnz);
+    m_Ax.resize(nnz);
+
+    if (!m_row_major) {
+        // Already column-compressed: identity map.
+        m_Ap = m_in_lead;
+        m_Ai = m_in_trail;
+        for (int p = 0; p < nnz; p++)
+            m_in_map[p] = p;
+        return;
+    }
+
+    // Transpose the CSR pattern into CSC.
+    for (int p = 0; p < nnz; p++)
+        m_Ap[trail[p] + 1]++;
+    for (int j = 0; j < m_n; j++)
+        m_Ap[j + 1] += m_Ap[j];
+
+    std::vector<int> next(m_Ap.begin(), m_Ap.end() - 1);
+    for (int i = 0; i < m_n; i++) {
+        for (int p = lead[i]; p < lead[i + 1]; p++) {
+            int dest = next[trail[p]]++;
+            m_Ai[dest] = i;
+            m_in_map[p] = dest;
+        }
+    }
+}
+
+bool ChSparseLUEngine::SamePattern(const ChCSMatrix& A) const {
+    if (A.GetNumRows() != m_n || A.IsRowMajor() != m_row_major)
+        return false;
+
+    const int* lead = A.GetCS_LeadingIndexArray();
+    if (lead[m_n] != static_cast<int>(m_in_trail.size()))
+        return false;
+
+    const int* trail = A.GetCS_TrailingIndexArray();
+    return std::memcmp(lead, m_in_lead.data(), (m_n + 1) * sizeof(int)) == 0 &&
+           std::memcmp(trail, m_in_trail.data(), m_in_trail.size() * sizeof(int)) == 0;
+}
+
+void ChSparseLUEngine::LoadValues(const ChCSMatrix& A) {
+    const double* values = A.GetCS_ValueArray();
+    int nnz = static_cast<int>(m_in_map.size());
+    for (int p = 0; p < nnz; p++)
+        m_Ax[m_in_map[p]] = values[p];
+}
+
+// -----------------------------------------------------------------------------
+
+void ChSparseLUEngine::ComputeOrdering() {
+    m_q.resize(m_n);
+
+    if (m_ordering == Ordering::NATURAL) {
+        for (int k = 0; k < m_n; k++)
+            m_q[k] = k;
+        return;
+    }
+
+    // Adjacency structure of A+A' (diagonal excluded).
+    std::vector<std::vector<int>> adj(m_n);
+    for (int j = 0; j < m_n; j++) {
+        for (int p = m_Ap[j]; p < m_Ap[j + 1]; p++) {
+            int i = m_Ai[p];
+            if (i == j)
+                continue;
+            adj[i].push_back(j);
+            adj[j].push_back(i);
+        }
+    }
+    for (auto& nbrs : adj) {
+        std::sort(nbrs.begin(), nbrs.end());
+        nbrs.erase(std::unique(nbrs.begin(), nbrs.end()), nbrs.end());
+    }
+
+    if (m_ordering == Ordering::MIN_DEGREE) {
+        ComputeMinDegreeOrdering(adj);
+        return;
+    }
+
+    // Cuthill-McKee: breadth-first traversal of each connected component, starting from a node of minimum degree
+    // and visiting neighbors in order of increasing degree.
+    auto by_degree = [&adj](int a, int b) { return adj[a].size() < adj[b].size(); };
+
+    std::vector<int> nodes(m_n);
+    for (int k = 0; k < m_n; k++)
+        nodes[k] = k;
+    std::stable_sort(nodes.begin(), nodes.end(), by_degree);
+
+    std::vector<char> visited(m_n, 0);
+    std::vector<int> nbrs;
+    int count = 0;
+    for (int start : nodes) {
+        if (visited[start])
+            continue;
+        int head = count;
+        m_q[count++] = start;
+        visited[start] = 1;
+        while (head < count) {
+            int node = m_q[head++];
+            nbrs.clear();
+            for (int nbr : adj[node]) {
+                if (!visited[nbr]) {
+                    visited[nbr] = 1;
+                    nbrs.push_back(nbr);
+                }
+            }
+            std::stable_sort(nbrs.begin(), nbrs.end(), by_degree);
+            for (int nbr : nbrs)
+                m_q[count++] = nbr;
+        }
+    }
+
+    // Reverse.
+    std::reverse(m_q.begin(), m_q.end());
+}
+
+void ChSparseLUEngine::ComputeMinDegreeOrdering(std::vector<std::vector<int>>& adj) {
+    // Elimination graph: eliminating a node connects all its neighbors to each other. The node of minimum
+    // degree (lowest index among ties) is eliminated first. The adjacency lists only hold uneliminated nodes.
+    std::set<std::pair<int, int>> queue;  // (degree, node)
+    for (int i = 0; i < m_n; i++)
+        queue.insert(std::make_pair((int)adj[i].size(), i));
+
+    std::vector<int> nbrs;
+    std::vector<int> merged;
+    int count = 0;
+    while (!queue.empty()) {
+        int node = queue.begin()->second;
+        queue.erase(queue.begin());
+        m_q[count++] = node;
+
+        nbrs.swap(adj[node]);
+        adj[node].clear();
+        for (int nbr : nbrs) {
+            // New neighbors of 'nbr': its old ones and those of 'node', except itself and 'node'
+            std::vector<int>& list = adj[nbr];
+            queue.erase(std::make_pair((int)list.size(), nbr));
+            merged.clear();
+            std::set_union(list.begin(), list.end(), nbrs.begin(), nbrs.end(), std::back_inserter(merged));
+            list.clear();
+            for (int i : merged) {
+                if (i != nbr && i != node)
+                    list.push_back(i);
+            }
+            queue.insert(std::make_pair((int)list.size(), nbr));
+        }
+    }
+}
+
+// -----------------------------------------------------------------------------
+
+int ChSparseLUEngine::Reach(int col, std::vector<int>& xi, std::vector<int>& stack, std::vector<int>& pstack) {
+    int top = m_n;
+
+    for (int p = m_Ap[col]; p < m_Ap[col + 1]; p++) {
+        int root = m_Ai[p];
+        if (m_marked[root])
+            continue;
+
+        // Non-recursive depth-first search in the graph of L, starting at 'root'.
+        int head = 0;
+        stack[0] = root;
+        while (head >= 0) {
+            int j = stack[head];
+            int jnew = m_pinv[j];
+            if (!m_marked[j]) {
+                m_marked[j] = 1;
+                pstack[head] = (jnew < 0) ? 0 : m_Lp[jnew];
+            }
+            bool done = true;
+            int pend = (jnew < 0) ? 0 : m_Lp[jnew + 1];
+            for (int q = pstack[head]; q < pend; q++) {
+                int i = m_Li[q];
+                if (m_marked[i])
+                    continue;
+                pstack[head] = q;
+                stack[++head] = i;
+                done = false;
+                break;
+            }
+            if (done) {
+                head--;
+                xi[--top] = j;
+            }
+        }
+    }
+
+    // Restore the marks.
+    for (int p = top; p < m_n; p++)
+        m_marked[xi[p]] = 0;
+
+    return top;
+}
+
+bool ChSparseLUEngine::FactorizeFull() {
+    int n = m_n;
+    int anz = m_Ap[n];
+
+    m_pinv.assign(n, -1);
+    m_Lp.assign(n + 1, 0);
+    m_Up.assign(n + 1, 0);
+    m_Li.clear();
+    m_Lx.clear();
+    m_Ui.clear();
+    m_Ux.clear();
+    m_Li.reserve(4 * anz + n);
+    m_Lx.reserve(4 * anz + n);
+    m_Ui.reserve(4 * anz + n);
+    m_Ux.reserve(4 * anz + n);
+
+    m_marked.assign(n, 0);
+    std::vector<int> xi(n);
+    std::vector<int> stack(n);
+    std::vector<int> pstack(n);
+    std::vector<double> x(n, 0.0);
+
+    for (int k = 0; k < n; k++) {
+        m_Lp[k] = static_cast<int>(m_Li.size());
+        m_Up[k] = static_cast<int>(m_Ui.size());
+
+        // Sparse triangular solve x = L \ A(:,col)
+        int col = m_q[k];
+        int top = Reach(col, xi, stack, pstack);
+        for (int p = top; p < n; p++)
+            x[xi[p]] = 0;
+        for (int p = m_Ap[col]; p < m_Ap[col + 1]; p++)
+            x[m_Ai[p]] = m_Ax[p];
+        for (int p = top; p < n; p++) {
+            int j = xi[p];
+            int J = m_pinv[j];
+            if (J < 0)
+                continue;
+            double xj = x[j];
+            for (int q = m_Lp[J] + 1; q < m_Lp[J + 1]; q++)
+                x[m_Li[q]] -= m_Lx[q] * xj;
+        }
+
+        // Select the pivot and store the column of U
+        int ipiv = -1;
+        double amax = -1;
+        for (int p = top; p < n; p++) {
+            int i = xi[p];
+            if (m_pinv[i] < 0) {
+                double t = std::abs(x[i]);
+                if (t > amax) {
+                    amax = t;
+                    ipiv = i;
+                }
+            } else {
+                m_Ui.push_back(m_pinv[i]);
+                m_Ux.push_back(x[i]);
+            }
+        }
+        if (ipiv == -1 || amax <= 0)
+            return false;
+
+        // Prefer the diagonal entry, if large enough
+        if (m_pinv[col] < 0 && std::abs(x[col]) >= amax * m_pivot_tol)
+            ipiv = col;
+
+        double pivot = x[ipiv];
+        m_Ui.push_back(k);
+        m_Ux.push_back(pivot);
+        m_pinv[ipiv] = k;
+
+        // Store the column of L (unit diagonal first)
+        m_Li.push_back(ipiv);
+        m_Lx.push_back(1);
+        for (int p = top; p < n; p++) {
+            int i = xi[p];
+            if (m_pinv[i] < 0) {
+                m_Li.push_back(i);
+                m_Lx.push_back(x[i] / pivot);
+            }
+            x[i] = 0;
+        }
+    }
+    m_Lp[n] = static_cast<int>(m_Li.size());
+    m_Up[n] = static_cast<int>(m_Ui.size());
+
+    // Express L in pivot row ordering.
+    for (auto& i : m_Li)
+        i = m_pinv[i];
+
+    // Sort the columns of U by increasing row index, as needed by the refactorization.
+    // The diagonal entry remains the last one in each column.
+    std::vector<std::pair<int, double>> ucol;
+    for (int k = 0; k < n; k++) {
+        int pbeg = m_Up[k];
+        int pend = m_Up[k + 1];
+        ucol.clear();
+        for (int p = pbeg; p < pend; p++)
+            ucol.push_back(std::make_pair(m_Ui[p], m_Ux[p]));
+        std::sort(ucol.begin(), ucol.end(),
+                  [](const std::pair<int, double>& a, const std::pair<int, double>& b) { return a.first < b.first; });
+        for (int p = pbeg; p < pend; p++) {
+            m_Ui[p] = ucol[p - pbeg].first;
+            m_Ux[p] = ucol[p - pbeg].second;
+        }
+    }
+
+    BuildLevelSchedule();
+
+    return true;
+}
+
+// -----------------------------------------------------------------------------
+
+void ChSparseLUEngine::BuildLevelSchedule() {
+    // Column k of the factors can be computed as soon as all columns r of L, with U(r,k) != 0, are available.
+    std::vector<int> level(m_n, 0);
+    int num_levels = 0;
+    for (int k = 0; k < m_n; k++) {
+        int lev = 0;
+        for (int p = m_Up[k]; p < m_Up[k + 1] - 1; p++)
+            lev = std::max(lev, level[m_Ui[p]] + 1);
+        level[k] = lev;
+        num_levels = std::max(num_levels, lev + 1);
+    }
+
+    m_level_ptr.assign(num_levels + 1, 0);
+    for (int k = 0; k < m_n; k++)
+        m_level_ptr[level[k] + 1]++;
+    for (int l = 0; l < num_levels; l++)
+        m_level_ptr[l + 1] += m_level_ptr[l];
+
+    m_level_cols.resize(m_n);
+    std::vector<int> next(m_level_ptr.begin(), m_level_ptr.end() - 1);
+    for (int k = 0; k < m_n; k++)
+        m_level_cols[next[level[k]]++] = k;
+}
+
+bool ChSparseLUEngine::Refactorize() {
+    int n = m_n;
+    int num_levels = GetNumLevels();
+    std::atomic<bool> success(true);
+
+    // Refactorize the columns lbeg..lend-1 of a level; the dense workspace is left zeroed.
+    auto refactorize_columns = [&](int lbeg, int lend) {
+        static thread_local std::vector<double> work;
+        if (work.size() < (size_t)n)
+            work.assign(n, 0.0);
+        double* x = work.data();
+
+        for (int lk = lbeg; lk < lend; lk++) {
+            int k = m_level_cols[lk];
+            int col = m_q[k];
+
+            // Scatter the permuted column of A
+            for (int p = m_Ap[col]; p < m_Ap[col + 1]; p++)
+                x[m_pinv[m_Ai[p]]] = m_Ax[p];
+
+            // Column of U (off-diagonal entries, in increasing row order)
+            for (int p = m_Up[k]; p < m_Up[k + 1] - 1; p++) {
+                int r = m_Ui[p];
+                double ur = x[r];
+                m_Ux[p] = ur;
+                x[r] = 0;
+                for (int q = m_Lp[r] + 1; q < m_Lp[r + 1]; q++)
+                    x[m_Li[q]] -= m_Lx[q] * ur;
+            }
+
+            // Pivot
+            double pivot = x[k];
+            x[k] = 0;
+            m_Ux[m_Up[k + 1] - 1] = pivot;
+
+            // Column of L
+            double amax = 0;
+            for (int q = m_Lp[k] + 1; q < m_Lp[k + 1]; q++) {
+                int i = m_Li[q];
+                amax = std::max(amax, std::abs(x[i]));
+                m_Lx[q] = x[i] / pivot;
+                x[i] = 0;
+            }
+
+            if (!(std::abs(pivot) > m_refactor_tol * amax) || !std::isfinite(pivot))
+                success = false;
+        }
+    };
+
+    for (int l = 0; l < num_levels; l++) {
+        if (m_scheduler)
+            m_scheduler->ParallelForRange(m_level_ptr[l], m_level_ptr[l + 1], refactorize_columns, 8);
+        else
+            refactorize_columns(m_level_ptr[l], m_level_ptr[l + 1]);
+    }
+
+    return success;
+}
+
+// -----------------------------------------------------------------------------
+
+void ChSparseLUEngine::Solve(const ChMatrix<>& b, ChMatrix<>& x) const {
+    assert(m_factorized);
+    assert(b.GetRows() == m_n);
+
+    int n = m_n;
+    std::vector<double> y(n);
+
+    // y = P*b
+    for (int i = 0; i < n; i++)
+        y[m_pinv[i]] = b(i);
+
+    // Forward substitution with unit lower triangular L
+    for (int j = 0; j < n; j++) {
+        double yj = y[j];
+        for (int p = m_Lp[j] + 1; p < m_Lp[j + 1]; p++)
+            y[m_Li[p]] -= m_Lx[p] * yj;
+    }
+
+    // Backward substitution with upper triangular U
+    for (int j = n - 1; j >= 0; j--) {
+        y[j] /= m_Ux[m_Up[j + 1] - 1];
+        double yj = y[j];
+        for (int p = m_Up[j]; p < m_Up[j + 1] - 1; p++)
+            y[m_Ui[p]] -= m_Ux[p] * yj;
+    }
+
+    // x = Q*y
+    x.Resize(n, 1);
+    for (int k = 0; k < n; k++)
+        x(m_q[k]) = y[k];
+}
+
+}  // end namespace chrono
@@ -0,0 +1,179 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+// Native sparse LU factorization engine (no external dependencies).
+// =============================================================================
+
+#ifndef CHSPARSELUENGINE_H
+#define CHSPARSELUENGINE_H
+
+#include <memory>
+#include <vector>
+
+#include "chrono/core/ChCSMatrix.h"
+#include "chrono/core/ChMatrix.h"
+#include "chrono/parallel/ChTaskScheduler.h"
+
+namespace chrono {
+
+/// @addtogroup chrono_solver
+/// @{
+
+/// Sparse direct LU factorization engine operating on ChCSMatrix objects.
+/// The factorization P*A*Q = L*U is computed with a left-looking (Gilbert-Peierls) algorithm using threshold
+/// partial pivoting with preference for the diagonal entry, which makes it suitable for the symmetric indefinite
+/// KKT matrices assembled by ChSystemDescriptor::ConvertToMatrixForm (with zero diagonal blocks for ideal constraints).
+///
+/// The factorization is split in two phases:
+/// - a \e symbolic phase, which computes a fill-reducing column ordering Q, the row pivoting P and the sparsity
+///   patterns of the L and U factors;
+/// - a \e numeric phase, which only recomputes the values of L and U.
+///
+/// If the sparsity pattern of the input matrix did not change since the last symbolic phase, Factorize() can skip
+/// the symbolic phase and only perform a numeric refactorization, keeping the previous pivot sequence. Columns of the
+/// factors that do not depend on each other are grouped in levels and refactorized in parallel, on the task
+/// scheduler set with SetTaskScheduler().
+/// If a pivot becomes too small during refactorization, a full factorization is performed instead.
+class ChApi ChSparseLUEngine {
+  public:
+    /// Fill-reducing column ordering.
+    enum class Ordering {
+        NATURAL,    ///< no reordering
+        RCM,        ///< reverse Cuthill-McKee on the pattern of A+A'
+        MIN_DEGREE  ///< minimum degree on the pattern of A+A'
+    };
+
+    ChSparseLUEngine();
+    ~ChSparseLUEngine() {}
+
+    /// Set the fill-reducing ordering used in the symbolic phase (default: MIN_DEGREE).
+    /// The minimum degree ordering eliminates the loosely coupled unknowns first, which gives less fill-in and a
+    /// wide elimination tree (many columns per level of the refactorization schedule). On a connected system the
+    /// banded RCM ordering gives a nearly linear elimination tree, with few columns per level.
+    void SetOrdering(Ordering ordering) { m_ordering = ordering; }
+
+    /// Set the threshold for diagonal pivoting preference, in (0,1] (default: 0.1).
+    /// The diagonal entry is chosen as pivot if its magnitude is at least this fraction of the largest candidate.
+    void SetPivotTolerance(double tol) { m_pivot_tol = tol; }
+
+    /// Set the relative threshold below which a pivot obtained by numeric refactorization is rejected,
+    /// forcing a complete factorization (default: 1e-8).
+    void SetRefactorizationTolerance(double tol) { m_refactor_tol = tol; }
+
+    /// Set the task scheduler running the numeric refactorization (serial execution if null, the default).
+    void SetTaskScheduler(std::shared_ptr<ChTaskScheduler> scheduler) { m_scheduler = scheduler; }
+
+    /// Get the task scheduler running the numeric refactorization.
+    std::shared_ptr<ChTaskScheduler> GetTaskScheduler() const { return m_scheduler; }
+
+    /// Factorize the given square matrix.
+    /// If \a reuse_symbolic is true and the sparsity pattern of \a A matches the one of the last symbolic
+    /// factorization, only a numeric refactorization is performed.
+    /// Returns false if the matrix is structurally or numerically singular.
+    bool Factorize(const ChCSMatrix& A, bool reuse_symbolic = false);
+
+    /// Solve the system A*x = b, using the current factorization.
+    /// The solution vector \a x is resized if necessary.
+    void Solve(const ChMatrix<>& b, ChMatrix<>& x) const;
+
+    /// Return true if a valid factorization is available.
+    bool IsFactorized() const { return m_factorized; }
+
+    /// Return the problem size.
+    int GetSize() const { return m_n; }
+
+    /// Return the number of non-zeros in the L and U factors (the unit diagonal of L is included).
+    int GetFactorNNZ() const { return static_cast<int>(m_Li.size() + m_Ui.size()); }
+
+    /// Return the number of levels in the parallel refactorization schedule.
+    int GetNumLevels() const { return m_level_ptr.empty() ? 0 : static_cast<int>(m_level_ptr.size()) - 1; }
+
+    /// Return the number of symbolic (complete) factorizations performed so far.
+    int GetNumSymbolicFactorizations() const { return m_num_symbolic; }
+
+    /// Return the number of numeric-only refactorizations performed so far.
+    int GetNumNumericRefactorizations() const { return m_num_refactor; }
+
+  private:
+    /// Cache the pattern of A and build the (column-compressed) copy of A, together with the map from
+    /// the entries of A to the entries of the copy.
+    void AnalyzePattern(const ChCSMatrix& A);
+
+    /// Check if the pattern of A matches the cached one.
+    bool SamePattern(const ChCSMatrix& A) const;
+
+    /// Copy the values of A in the column-compressed copy.
+    void LoadValues(const ChCSMatrix& A);
+
+    /// Compute the fill-reducing column ordering.
+    void ComputeOrdering();
+
+    /// Compute the minimum degree ordering of the graph with the given adjacency lists (destroyed).
+    void ComputeMinDegreeOrdering(std::vector<std::vector<int>>& adj);
+
+    /// Complete left-looking factorization with partial pivoting.
+    bool FactorizeFull();
+
+    /// Numeric refactorization reusing pivot sequence and patterns of L and U.
+    bool Refactorize();
+
+    /// Compute the set of rows reached from column \a col of A in the graph of L.
+    /// Returns the top of the stack in \a xi (the reach is stored in xi[top..n-1] in topological order).
+    int Reach(int col, std::vector<int>& xi, std::vector<int>& stack, std::vector<int>& pstack);
+
+    /// Group the columns of the factors in levels of mutually independent columns.
+    void BuildLevelSchedule();
+
+    Ordering m_ordering;
+    double m_pivot_tol;
+    double m_refactor_tol;
+    std::shared_ptr<ChTaskScheduler> m_scheduler;
+
+    int m_n;  ///< problem size
+    bool m_factorized;
+    int m_num_symbolic;
+    int m_num_refactor;
+
+    // Cached pattern of the input matrix
+    bool m_row_major;
+    std::vector<int> m_in_lead;   ///< leading index array of input
+    std::vector<int> m_in_trail;  ///< trailing index array of input
+    std::vector<int> m_in_map;    ///< position of each input entry in the column-compressed copy
+
+    // Column-compressed copy of the input matrix
+    std::vector<int> m_Ap;
+    std::vector<int> m_Ai;
+    std::vector<double> m_Ax;
+
+    // Permutations
+    std::vector<int> m_q;     ///< column ordering: column k of the factors is column m_q[k] of A
+    std::vector<int> m_pinv;  ///< inverse row permutation: row i of A is row m_pinv[i] of the factors
+
+    // Factors, in column-compressed form (unit diagonal of L stored first, diagonal of U stored last)
+    std::vector<int> m_Lp;
+    std::vector<int> m_Li;
+    std::vector<double> m_Lx;
+    std::vector<int> m_Up;
+    std::vector<int> m_Ui;
+    std::vector<double> m_Ux;
+
+    // Parallel refactorization schedule
+    std::vector<int> m_level_ptr;
+    std::vector<int> m_level_cols;
+
+    std::vector<char> m_marked;  ///< workspace for the graph traversal
+};
+
+/// @} chrono_solver
+
+}  // end namespace chrono
+
+#endif
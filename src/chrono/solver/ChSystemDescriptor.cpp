@@ -10,10 +10,15 @@
 //
 // =============================================================================
 
+#include <algorithm>
+#include <cstdint>
+#include <unordered_map>
+
 #include "chrono/solver/ChSystemDescriptor.h"
 #include "chrono/solver/ChConstraintTwoTuplesContactN.h"
 #include "chrono/solver/ChConstraintTwoTuplesFrictionT.h"
 #include "chrono/core/ChLinkedListMatrix.h"
+#include "chrono/solver/ChKblockGeneric.h"
 
 namespace chrono {
 
@@ -23,6 +28,15 @@ CH_FACTORY_REGISTER(ChSystemDescriptor)
 
 #define CH_SPINLOCK_HASHSIZE 203
 
+// Minimum number of constraints for running the constraint loops in parallel
+#define CH_DESCRIPTOR_PARALLEL_MIN_CONSTRAINTS 1000
+
+// Maximum number of colors; constraints that cannot be colored are processed serially
+#define CH_DESCRIPTOR_MAX_COLORS 64
+
+// Minimum number of items processed by a task of the scheduler
+#define CH_DESCRIPTOR_GRAIN 256
+
 ChSystemDescriptor::ChSystemDescriptor() {
     vconstraints.clear();
     vvariables.clear();
@@ -34,7 +48,10 @@ ChSystemDescriptor::ChSystemDescriptor() {
     n_c = 0;
     freeze_count = false;
 
-    this->num_threads = CHOMPfunctions::GetNumProcs();
+    coloring_valid = false;
+    groups_independent = false;
+
+    kmap_matrix = nullptr;
 
     spinlocktable = new ChSpinlock[CH_SPINLOCK_HASHSIZE];
 }
@@ -165,12 +182,8 @@ void ChSystemDescriptor::ConvertToMatrixForm(ChSparseMatrix* Cq,
 
     // If some stiffness / hessian matrix has been added to H ,
     // also add it to the sparse H
-    int s_k = 0;
-    if (H) {
-        for (unsigned int ik = 0; ik < this->vstiffness.size(); ik++) {
-            this->vstiffness[ik]->Build_K(*H, true);
-        }
-    }
+    if (H)
+        BuildKblocks(*H);
 
     // Fills Cq jacobian, E 'compliance' matrix , the 'b' vector and friction coeff.vector,
     // by looping on constraints
@@ -201,6 +214,158 @@ void ChSystemDescriptor::ConvertToMatrixForm(ChSparseMatrix* Cq,
     }
 }
 
+// Key of the K blocks for the map of BuildKblocks(): the map remains valid as long as the
+// blocks, their matrices and the offsets of their variables do not change.
+static bool MakeKblocksKey(std::vector<ChKblock*>& vstiffness, std::vector<std::intptr_t>& key) {
+    key.clear();
+    for (auto block : vstiffness) {
+        auto generic = dynamic_cast<ChKblockGeneric*>(block);
+        if (!generic || !generic->Get_K())
+            return false;
+        key.push_back(reinterpret_cast<std::intptr_t>(generic));
+        key.push_back(reinterpret_cast<std::intptr_t>(generic->Get_K()->GetAddress()));
+        key.push_back(generic->Get_K()->GetRows());
+        for (unsigned int iv = 0; iv < generic->GetNvars(); iv++) {
+            ChVariables* var = generic->GetVariableN(iv);
+            key.push_back(var->IsActive() ? var->GetOffset() : -1);
+            key.push_back(var->Get_ndof());
+        }
+    }
+    return true;
+}
+
+bool ChSystemDescriptor::UpdateKblocksMap(const ChCSMatrix& matrix) {
+    const int* lead_index = matrix.GetCS_LeadingIndexArray();
+    const int* trail_index = matrix.GetCS_TrailingIndexArray();
+    bool row_major = matrix.IsRowMajor();
+
+    // Locate the nonzero of each entry of the blocks (same entries, and same order, as in ChKblockGeneric::Build_K)
+    std::vector<int> entry_nonzero;
+    std::vector<const double*> entry_value;
+    for (auto block : vstiffness) {
+        auto generic = static_cast<ChKblockGeneric*>(block);
+        const ChMatrix<double>* K = generic->Get_K();
+        int kio = 0;
+        for (unsigned int iv = 0; iv < generic->GetNvars(); iv++) {
+            ChVariables* ivar = generic->GetVariableN(iv);
+            int in = ivar->Get_ndof();
+            if (ivar->IsActive()) {
+                int kjo = 0;
+                for (unsigned int jv = 0; jv < generic->GetNvars(); jv++) {
+                    ChVariables* jvar = generic->GetVariableN(jv);
+                    int jn = jvar->Get_ndof();
+                    if (jvar->IsActive()) {
+                        for (int i = 0; i < in; i++) {
+                            for (int j = 0; j < jn; j++) {
+                                int row = ivar->GetOffset() + i;
+                                int col = jvar->GetOffset() + j;
+                                int lead = row_major ? row : col;
+                                int trail = row_major ? col : row;
+                                const int* first = trail_index + lead_index[lead];
+                                const int* last = trail_index + lead_index[lead + 1];
+                                const int* found = std::lower_bound(first, last, trail);
+                                if (found == last || *found != trail)
+                                    return false;
+                                entry_nonzero.push_back(static_cast<int>(found - trail_index));
+                                entry_value.push_back(K->GetAddress() + (kio + i) * K->GetColumns() + kjo + j);
+                            }
+                        }
+                    }
+                    kjo += jn;
+                }
+            }
+            kio += in;
+        }
+    }
+
+    // Sort the entries by nonzero, keeping the order of the blocks for each nonzero
+    int nnz = matrix.GetNNZ();
+    std::vector<int> count(nnz + 1, 0);
+    for (auto nz : entry_nonzero)
+        count[nz + 1]++;
+    for (int nz = 0; nz < nnz; nz++)
+        count[nz + 1] += count[nz];
+
+    kmap_entries.resize(entry_value.size());
+    for (size_t e = 0; e < entry_value.size(); e++)
+        kmap_entries[count[entry_nonzero[e]]++] = entry_value[e];
+
+    kmap_nonzeros.clear();
+    kmap_lead.clear();
+    kmap_trail.clear();
+    kmap_ptr.clear();
+    int lead = 0;
+    int start = 0;
+    for (int nz = 0; nz < nnz; nz++) {
+        // after the scatter above, count[nz] is the end of the entries of nz
+        if (count[nz] > start) {
+            while (lead_index[lead + 1] <= nz)
+                lead++;
+            kmap_nonzeros.push_back(nz);
+            kmap_lead.push_back(lead);
+            kmap_trail.push_back(trail_index[nz]);
+            kmap_ptr.push_back(start);
+        }
+        start = count[nz];
+    }
+    kmap_ptr.push_back(start);
+
+    kmap_matrix = &matrix;
+    return true;
+}
+
+void ChSystemDescriptor::BuildKblocks(ChSparseMatrix& storage) {
+    auto matrix = dynamic_cast<ChCSMatrix*>(&storage);
+
+    bool use_map = matrix && matrix->IsCompressed() && task_scheduler && task_scheduler->GetNumThreads() > 1;
+    if (use_map) {
+        std::vector<std::intptr_t> key;
+        use_map = MakeKblocksKey(vstiffness, key);
+        if (use_map && (kmap_matrix != matrix || key != kmap_key)) {
+            kmap_key.swap(key);
+            use_map = UpdateKblocksMap(*matrix);
+        }
+    }
+    if (!use_map) {
+        kmap_matrix = nullptr;
+        for (unsigned int ik = 0; ik < vstiffness.size(); ik++)
+            vstiffness[ik]->Build_K(storage, true);
+        return;
+    }
+
+    // Check that the sparsity pattern did not change since the map was built
+    const int* lead_index = matrix->GetCS_LeadingIndexArray();
+    const int* trail_index = matrix->GetCS_TrailingIndexArray();
+    int lead_dim = matrix->IsRowMajor() ? matrix->GetNumRows() : matrix->GetNumColumns();
+    int nnz = matrix->GetNNZ();
+    int ntouched = static_cast<int>(kmap_nonzeros.size());
+    bool pattern_valid = true;
+    for (int t = 0; t < ntouched && pattern_valid; t++) {
+        int nz = kmap_nonzeros[t];
+        int lead = kmap_lead[t];
+        pattern_valid = lead < lead_dim && nz < nnz && lead_index[lead] <= nz && nz < lead_index[lead + 1] &&
+                        trail_index[nz] == kmap_trail[t];
+    }
+    if (!pattern_valid && !UpdateKblocksMap(*matrix)) {
+        kmap_matrix = nullptr;
+        for (unsigned int ik = 0; ik < vstiffness.size(); ik++)
+            vstiffness[ik]->Build_K(storage, true);
+        return;
+    }
+
+    // Each nonzero sums its entries in the order of the blocks, so the result is the same as with Build_K()
+    double* values = matrix->GetCS_ValueArray();
+    ntouched = static_cast<int>(kmap_nonzeros.size());
+    task_scheduler->ParallelFor(0, ntouched,
+                                [&](int t) {
+                                    double value = values[kmap_nonzeros[t]];
+                                    for (int e = kmap_ptr[t]; e < kmap_ptr[t + 1]; e++)
+                                        value += *kmap_entries[e];
+                                    values[kmap_nonzeros[t]] = value;
+                                },
+                                CH_DESCRIPTOR_GRAIN);
+}
+
 void ChSystemDescriptor::ConvertToMatrixForm(ChSparseMatrix* Z, ChMatrix<>* rhs) {
 
     std::vector<ChConstraint*>& mconstraints = this->GetConstraintsList();
@@ -232,10 +397,7 @@ void ChSystemDescriptor::ConvertToMatrixForm(ChSparseMatrix* Z, ChMatrix<>* rhs)
 		}
 
 		// If present, add stiffness matrix K to upper-left block of Z.
-		int s_k = 0;
-		for (unsigned int ik = 0; ik < this->vstiffness.size(); ik++) {
-			this->vstiffness[ik]->Build_K(*Z, true);
-		}
+		BuildKblocks(*Z);
 
 		// Fill Z by looping over constraints.
 		int s_c = 0;
@@ -542,32 +704,93 @@ int ChSystemDescriptor::FromVectorToUnknowns(ChMatrix<>& mvector) {
     return n_q + n_c;
 }
 
-void ChSystemDescriptor::ShurComplementProduct(ChMatrix<>& result, ChMatrix<>* lvector, std::vector<bool>* enabled) {
-    assert(this->vstiffness.size() == 0); // currently, the case with ChKblock items is not supported (only diagonal M is supported, no K)
-    assert(lvector->GetRows() == CountActiveConstraints());
-    assert(lvector->GetColumns() == 1);
+void ChSystemDescriptor::UpdateConstraintColoring() {
+    int nconstr = (int)vconstraints.size();
+
+    std::unordered_map<ChVariables*, uint64_t> var_colors;  // colors already used by the constraints of each variable
+    std::vector<int> constr_color(nconstr);
+    std::vector<int> color_count(CH_DESCRIPTOR_MAX_COLORS, 0);
+    std::vector<ChVariables*> vars;
+    std::vector<ChVariables*> group_vars;
+
+    serial_constraints.clear();
+    group_ptr.clear();
+    groups_independent = true;
+
+    for (int ic = 0; ic < nconstr; ic++) {
+        vars.clear();
+        vconstraints[ic]->CollectVariables(vars);
+
+        // Consecutive constraints referencing the same variables (e.g. the N,U,V components of a
+        // contact) are coupled in the projection, so they are kept in the same group.
+        if (ic == 0 || vars.empty() || vars != group_vars)
+            group_ptr.push_back(ic);
+        group_vars = vars;
+
+        // Unknown variables: this constraint must be processed serially.
+        if (vars.empty()) {
+            groups_independent = false;
+            constr_color[ic] = -1;
+            serial_constraints.push_back(vconstraints[ic]);
+            continue;
+        }
 
-    result.Reset(n_c, 1);  // fast! Reset() method does not realloc if size doesn't change
+        // Inactive variables are never written, so they do not cause conflicts.
+        uint64_t used = 0;
+        for (auto var : vars) {
+            if (var && var->IsActive())
+                used |= var_colors[var];
+        }
 
-// Performs the sparse product    result = [N]*l = [ [Cq][M^(-1)][Cq'] - [E] ] *l
-// in different phases:
+        int color = 0;
+        while (color < CH_DESCRIPTOR_MAX_COLORS && ((used >> color) & 1))
+            color++;
 
-// 1 - set the qb vector (aka speeds, in each ChVariable sparse data) as zero
+        if (color == CH_DESCRIPTOR_MAX_COLORS) {
+            constr_color[ic] = -1;
+            serial_constraints.push_back(vconstraints[ic]);
+            continue;
+        }
 
-    for (int iv = 0; iv < (int)vvariables.size(); iv++) {
-        if (vvariables[iv]->IsActive())
-            vvariables[iv]->Get_qb().FillElem(0);
+        for (auto var : vars) {
+            if (var && var->IsActive())
+                var_colors[var] |= (uint64_t(1) << color);
+        }
+        constr_color[ic] = color;
+        color_count[color]++;
+    }
+    group_ptr.push_back(nconstr);
+
+    // Sort the colored constraints by color (counting sort, preserving the insertion order).
+    int ncolors = 0;
+    while (ncolors < CH_DESCRIPTOR_MAX_COLORS && color_count[ncolors] > 0)
+        ncolors++;
+
+    color_ptr.assign(ncolors + 1, 0);
+    for (int color = 0; color < ncolors; color++)
+        color_ptr[color + 1] = color_ptr[color] + color_count[color];
+
+    color_constraints.resize(color_ptr[ncolors]);
+    std::vector<int> pos(color_ptr.begin(), color_ptr.end() - 1);
+    for (int ic = 0; ic < nconstr; ic++) {
+        if (constr_color[ic] >= 0)
+            color_constraints[pos[constr_color[ic]]++] = vconstraints[ic];
     }
 
-    // 2 - performs    qb=[M^(-1)][Cq']*l  by
-    //     iterating over all constraints (when implemented in parallel this
-    //     could be non-trivial because race conditions might occur -> reduction buffer etc.)
-    //     Also, begin to add the cfm term ( -[E]*l ) to the result.
+    coloring_valid = true;
+}
 
-    // ATTENTION:  this loop cannot be parallelized! Concurrent write to some q may happen
-    for (int ic = 0; ic < (int)vconstraints.size(); ic++) {
-        if (vconstraints[ic]->IsActive()) {
-            int s_c = vconstraints[ic]->GetOffset();
+void ChSystemDescriptor::ShurComplementProduct(ChMatrix<>& result, ChMatrix<>* lvector, std::vector<bool>* enabled) {
+    assert(this->vstiffness.size() == 0); // currently, the case with ChKblock items is not supported (only diagonal M is supported, no K)
+    assert(lvector->GetRows() == CountActiveConstraints());
+    assert(lvector->GetColumns() == 1);
+
+    result.Reset(n_c, 1);  // fast! Reset() method does not realloc if size doesn't change
+
+    // Performs    qb+=[M^(-1)][Cq']*l_i   and    result = cfm * l_i = -[E]*l_i   for one constraint
+    auto increment_q = [&](ChConstraint* constr) {
+        if (constr->IsActive()) {
+            int s_c = constr->GetOffset();
 
             bool process = true;
             if (enabled)
@@ -579,35 +802,85 @@ void ChSystemDescriptor::ShurComplementProduct(ChMatrix<>& result, ChMatrix<>* l
                 if (lvector)
                     li = (*lvector)(s_c, 0);
                 else
-                    li = vconstraints[ic]->Get_l_i();
+                    li = constr->Get_l_i();
 
                 // Compute qb += [M^(-1)][Cq']*l_i
-                //  NOTE! concurrent update to same q data, risk of collision if parallel!!
-                vconstraints[ic]->Increment_q(li);  // <----!!!  fpu intensive
+                constr->Increment_q(li);  // <----!!!  fpu intensive
 
                 // Add constraint force mixing term  result = cfm * l_i = -[E]*l_i
-                result(s_c, 0) = vconstraints[ic]->Get_cfm_i() * li;
+                result(s_c, 0) = constr->Get_cfm_i() * li;
             }
         }
-    }
+    };
 
-// 3 - performs    result=[Cq']*qb    by
-//     iterating over all constraints
-
-    for (int ic = 0; ic < (int)vconstraints.size(); ic++) {
-        if (vconstraints[ic]->IsActive()) {
+    // Performs    result+=[Cq]*qb   for one constraint
+    auto compute_Cq_q = [&](ChConstraint* constr) {
+        if (constr->IsActive()) {
             bool process = true;
             if (enabled)
-                if ((*enabled)[vconstraints[ic]->GetOffset()] == false)
+                if ((*enabled)[constr->GetOffset()] == false)
                     process = false;
 
             if (process)
-                result(vconstraints[ic]->GetOffset(), 0) +=
-                    vconstraints[ic]->Compute_Cq_q();  // <----!!!  fpu intensive
+                result(constr->GetOffset(), 0) += constr->Compute_Cq_q();  // <----!!!  fpu intensive
             else
-                result(vconstraints[ic]->GetOffset(), 0) = 0;  // not enabled constraints, just set to 0 result
+                result(constr->GetOffset(), 0) = 0;  // not enabled constraints, just set to 0 result
         }
+    };
+
+    int nvars = (int)vvariables.size();
+    int nconstr = (int)vconstraints.size();
+
+    if (RunInParallel()) {
+        if (!coloring_valid)
+            UpdateConstraintColoring();
+        int ncolors = GetNumConstraintColors();
+
+        // 1 - set the qb vector as zero
+        task_scheduler->ParallelFor(0, nvars,
+                                    [&](int iv) {
+                                        if (vvariables[iv]->IsActive())
+                                            vvariables[iv]->Get_qb().FillElem(0);
+                                    },
+                                    CH_DESCRIPTOR_GRAIN);
+
+        // 2 - performs    qb=[M^(-1)][Cq']*l   color by color: constraints with the same color
+        //     do not share any variable, so there is no concurrent write to the same q data.
+        for (int color = 0; color < ncolors; color++) {
+            task_scheduler->ParallelFor(color_ptr[color], color_ptr[color + 1],
+                                        [&](int i) { increment_q(color_constraints[i]); }, CH_DESCRIPTOR_GRAIN);
+        }
+        for (int i = 0; i < (int)serial_constraints.size(); i++)
+            increment_q(serial_constraints[i]);
+
+        // 3 - performs    result=[Cq']*qb   (only reads the q data)
+        task_scheduler->ParallelFor(0, nconstr, [&](int ic) { compute_Cq_q(vconstraints[ic]); }, CH_DESCRIPTOR_GRAIN);
+
+        return;
+    }
+
+// Performs the sparse product    result = [N]*l = [ [Cq][M^(-1)][Cq'] - [E] ] *l
+// in different phases:
+
+// 1 - set the qb vector (aka speeds, in each ChVariable sparse data) as zero
+
+    for (int iv = 0; iv < nvars; iv++) {
+        if (vvariables[iv]->IsActive())
+            vvariables[iv]->Get_qb().FillElem(0);
     }
+
+    // 2 - performs    qb=[M^(-1)][Cq']*l  by
+    //     iterating over all constraints.
+    //     Also, begin to add the cfm term ( -[E]*l ) to the result.
+
+    for (int ic = 0; ic < nconstr; ic++)
+        increment_q(vconstraints[ic]);
+
+// 3 - performs    result=[Cq']*qb    by
+//     iterating over all constraints
+
+    for (int ic = 0; ic < nconstr; ic++)
+        compute_Cq_q(vconstraints[ic]);
 }
 
 void ChSystemDescriptor::SystemProduct(
@@ -636,32 +909,76 @@ void ChSystemDescriptor::SystemProduct(
 
     result.Reset(n_q + n_c, 1);  // fast! Reset() method does not realloc if size doesn't change
 
-// 1) First row: result.q part =  [M + K]*x.q + [Cq']*x.l
-
-// 1.1)  do  M*x.q
-    for (int iv = 0; iv < (int)vvariables.size(); iv++)
-        if (vvariables[iv]->IsActive()) {
-            vvariables[iv]->MultiplyAndAdd(result, *x, this->c_a);
+    int nvars = (int)vvariables.size();
+    int nconstr = (int)vconstraints.size();
+
+    if (RunInParallel()) {
+        if (!coloring_valid)
+            UpdateConstraintColoring();
+        int ncolors = GetNumConstraintColors();
+
+        // 1.1)  do  M*x.q  (each variable writes its own rows)
+        task_scheduler->ParallelFor(0, nvars,
+                                    [&](int iv) {
+                                        if (vvariables[iv]->IsActive())
+                                            vvariables[iv]->MultiplyAndAdd(result, *vect, this->c_a);
+                                    },
+                                    CH_DESCRIPTOR_GRAIN);
+
+        // 1.2)  add also K*x.q  (serially, K blocks may share variables)
+        for (int ik = 0; ik < (int)vstiffness.size(); ik++)
+            vstiffness[ik]->MultiplyAndAdd(result, *vect);
+
+        // 1.3)  add also [Cq]'*x.l, color by color
+        auto multiply_T = [&](ChConstraint* constr) {
+            if (constr->IsActive())
+                constr->MultiplyTandAdd(result, (*vect)(constr->GetOffset() + n_q));
+        };
+        for (int color = 0; color < ncolors; color++) {
+            task_scheduler->ParallelFor(color_ptr[color], color_ptr[color + 1],
+                                        [&](int i) { multiply_T(color_constraints[i]); }, CH_DESCRIPTOR_GRAIN);
         }
+        for (int i = 0; i < (int)serial_constraints.size(); i++)
+            multiply_T(serial_constraints[i]);
+
+        // 2) Second row: result.l part =  [C_q]*x.q + [E]*x.l  (each constraint writes its own row)
+        task_scheduler->ParallelFor(0, nconstr,
+                                    [&](int ic) {
+                                        if (vconstraints[ic]->IsActive()) {
+                                            int s_c = vconstraints[ic]->GetOffset() + n_q;
+                                            vconstraints[ic]->MultiplyAndAdd(result(s_c), (*vect));
+                                            result(s_c) -= vconstraints[ic]->Get_cfm_i() * (*vect)(s_c);
+                                        }
+                                    },
+                                    CH_DESCRIPTOR_GRAIN);
+    } else {
+        // 1) First row: result.q part =  [M + K]*x.q + [Cq']*x.l
 
-    // 1.2)  add also K*x.q  (NON straight parallelizable - risk of concurrency in writing)
-    for (int ik = 0; ik < (int)vstiffness.size(); ik++) {
-        vstiffness[ik]->MultiplyAndAdd(result, *x);
-    }
+        // 1.1)  do  M*x.q
+        for (int iv = 0; iv < nvars; iv++)
+            if (vvariables[iv]->IsActive()) {
+                vvariables[iv]->MultiplyAndAdd(result, *vect, this->c_a);
+            }
 
-    // 1.3)  add also [Cq]'*x.l  (NON straight parallelizable - risk of concurrency in writing)
-    for (int ic = 0; ic < (int)vconstraints.size(); ic++) {
-        if (vconstraints[ic]->IsActive()) {
-            vconstraints[ic]->MultiplyTandAdd(result, (*x)(vconstraints[ic]->GetOffset() + n_q));
+        // 1.2)  add also K*x.q  (NON straight parallelizable - risk of concurrency in writing)
+        for (int ik = 0; ik < (int)vstiffness.size(); ik++) {
+            vstiffness[ik]->MultiplyAndAdd(result, *vect);
         }
-    }
 
-// 2) Second row: result.l part =  [C_q]*x.q + [E]*x.l
-    for (int ic = 0; ic < (int)vconstraints.size(); ic++) {
-        if (vconstraints[ic]->IsActive()) {
-            int s_c = vconstraints[ic]->GetOffset() + n_q;
-            vconstraints[ic]->MultiplyAndAdd(result(s_c), (*x));       // result.l_i += [C_q_i]*x.q
-            result(s_c) -= vconstraints[ic]->Get_cfm_i() * (*x)(s_c);  // result.l_i += [E]*x.l_i  NOTE:  cfm = -E
+        // 1.3)  add also [Cq]'*x.l  (NON straight parallelizable - risk of concurrency in writing)
+        for (int ic = 0; ic < nconstr; ic++) {
+            if (vconstraints[ic]->IsActive()) {
+                vconstraints[ic]->MultiplyTandAdd(result, (*vect)(vconstraints[ic]->GetOffset() + n_q));
+            }
+        }
+
+        // 2) Second row: result.l part =  [C_q]*x.q + [E]*x.l
+        for (int ic = 0; ic < nconstr; ic++) {
+            if (vconstraints[ic]->IsActive()) {
+                int s_c = vconstraints[ic]->GetOffset() + n_q;
+                vconstraints[ic]->MultiplyAndAdd(result(s_c), (*vect));       // result.l_i += [C_q_i]*x.q
+                result(s_c) -= vconstraints[ic]->Get_cfm_i() * (*vect)(s_c);  // result.l_i += [E]*x.l_i  NOTE:  cfm = -E
+            }
         }
     }
 
@@ -675,9 +992,29 @@ void ChSystemDescriptor::ConstraintsProject(
     ) {
     this->FromVectorToConstraints(multipliers);
 
-    for (int ic = 0; ic < (int)vconstraints.size(); ic++) {
-        if (vconstraints[ic]->IsActive())
-            vconstraints[ic]->Project();
+    int nconstr = (int)vconstraints.size();
+
+    bool parallel = RunInParallel();
+    if (parallel && !coloring_valid)
+        UpdateConstraintColoring();
+
+    if (parallel && groups_independent) {
+        // The projection of a constraint may only affect the other constraints of its group
+        // (e.g. the friction components of a contact), so groups are projected concurrently.
+        int ngroups = (int)group_ptr.size() - 1;
+        task_scheduler->ParallelFor(0, ngroups,
+                                    [&](int ig) {
+                                        for (int ic = group_ptr[ig]; ic < group_ptr[ig + 1]; ic++) {
+                                            if (vconstraints[ic]->IsActive())
+                                                vconstraints[ic]->Project();
+                                        }
+                                    },
+                                    CH_DESCRIPTOR_GRAIN / 4);
+    } else {
+        for (int ic = 0; ic < nconstr; ic++) {
+            if (vconstraints[ic]->IsActive())
+                vconstraints[ic]->Project();
+        }
     }
 
     this->FromConstraintsToVector(multipliers, false);
@@ -711,11 +1048,9 @@ void ChSystemDescriptor::UnknownsProject(
     }
 }
 
-void ChSystemDescriptor::SetNumThreads(int nthreads) {
-    if (nthreads == this->num_threads)
-        return;
-
-    this->num_threads = nthreads;
+bool ChSystemDescriptor::RunInParallel() const {
+    return task_scheduler && task_scheduler->GetNumThreads() > 1 &&
+           vconstraints.size() >= CH_DESCRIPTOR_PARALLEL_MIN_CONSTRAINTS;
 }
 
 }  // end namespace chrono
@@ -13,9 +13,13 @@
 #ifndef CHSYSTEMDESCRIPTOR_H
 #define CHSYSTEMDESCRIPTOR_H
 
+#include <cstdint>
+#include <memory>
 #include <vector>
 
+#include "chrono/core/ChCSMatrix.h"
 #include "chrono/parallel/ChOpenMP.h"
+#include "chrono/parallel/ChTaskScheduler.h"
 #include "chrono/parallel/ChThreadsSync.h"
 #include "chrono/solver/ChConstraint.h"
 #include "chrono/solver/ChKblock.h"
@@ -78,13 +82,38 @@ class ChApi ChSystemDescriptor {
     std::vector<ChVariables*> vvariables;     ///< list of pointers to all the ChVariables in the current Chrono system
     std::vector<ChKblock*> vstiffness;        ///< list of pointers to all the ChKblock in the current Chrono system
 
-    int num_threads;
+    std::shared_ptr<ChTaskScheduler> task_scheduler;  ///< runs the parallel loops (serial execution if null)
 
     ChSpinlock* spinlocktable;
 
     double c_a;  // coefficient form M mass matrices in vvariables
 
+    // Schedule for the multithreaded products and projection (see UpdateConstraintColoring)
+    bool coloring_valid;                            ///< false if the schedule must be rebuilt
+    std::vector<int> color_ptr;                     ///< start of each color in color_constraints
+    std::vector<ChConstraint*> color_constraints;   ///< constraints sorted by color
+    std::vector<ChConstraint*> serial_constraints;  ///< constraints that could not be colored
+    std::vector<int> group_ptr;                     ///< start of each group of coupled constraints in vconstraints
+    bool groups_independent;                        ///< true if groups can be projected concurrently
+
+    // Map from the entries of the K blocks to the nonzeros of a ChCSMatrix (see BuildKblocks)
+    const ChCSMatrix* kmap_matrix;          ///< matrix the map was built for (null if no valid map)
+    std::vector<std::intptr_t> kmap_key;    ///< blocks, matrices and variable offsets the map was built for
+    std::vector<int> kmap_nonzeros;         ///< indices (in the value array) of the nonzeros touched by the blocks
+    std::vector<int> kmap_lead;             ///< leading index (row, if row major) of each touched nonzero
+    std::vector<int> kmap_trail;            ///< trailing index (column, if row major) of each touched nonzero
+    std::vector<int> kmap_ptr;              ///< start of the entries of each touched nonzero in kmap_entries
+    std::vector<const double*> kmap_entries;  ///< entries of the K blocks, sorted by nonzero and then by block
+
   private:
+    /// Return true if the constraint loops are run on the task scheduler (more than one thread and
+    /// enough constraints).
+    bool RunInParallel() const;
+
+    /// Build the map used by BuildKblocks() for the given matrix. Return false if some entry of
+    /// the blocks is not in the sparsity pattern of the matrix.
+    bool UpdateKblocksMap(const ChCSMatrix& matrix);
+
     int n_q;            ///< number of active variables
     int n_c;            ///< number of active constraints
     bool freeze_count;  ///< for optimization: avoid to re-count the number of active variables and constraints
@@ -114,11 +143,17 @@ class ChApi ChSystemDescriptor {
         vconstraints.clear();
         vvariables.clear();
         vstiffness.clear();
+        coloring_valid = false;
     }
 
     /// Insert reference to a ChConstraint object
     virtual void InsertConstraint(ChConstraint* mc) { vconstraints.push_back(mc); }
 
+    /// Insert references to many ChConstraint objects at once (e.g. all the constraints of a contact container)
+    virtual void InsertConstraints(const std::vector<ChConstraint*>& mcs) {
+        vconstraints.insert(vconstraints.end(), mcs.begin(), mcs.end());
+    }
+
     /// Insert reference to a ChVariables object
     virtual void InsertVariables(ChVariables* mv) { vvariables.push_back(mv); }
 
@@ -126,7 +161,10 @@ class ChApi ChSystemDescriptor {
     virtual void InsertKblock(ChKblock* mk) { vstiffness.push_back(mk); }
 
     /// End insertion of items
-    virtual void EndInsertion() { UpdateCountsAndOffsets(); }
+    virtual void EndInsertion() {
+        UpdateCountsAndOffsets();
+        coloring_valid = false;
+    }
 
     /// Count & returns the scalar variables in the system (excluding ChVariable objects
     /// that have  IsActive() as false). Note: the number of scalar variables is not necessarily
@@ -268,6 +306,8 @@ class ChApi ChSystemDescriptor {
     /// NOTE! currently this function does NOT support the cases that use also ChKblock
     /// objects, because it would need to invert the global M+K, that is not diagonal,
     /// for doing = [N]*l = [ [Cq][(M+K)^(-1)][Cq'] - [E] ] * l
+    /// If multiple threads are used, constraints are processed by colors (see UpdateConstraintColoring()),
+    /// to avoid concurrent writes to the same q data.
     virtual void ShurComplementProduct(ChMatrix<>& result,   ///< matrix which contains the result of  N*l_i
                                        ChMatrix<>* lvector,  ///< optional matrix with the vector to be multiplied (if
                                        /// null, use current constr. multipliers l_i)
@@ -321,11 +361,27 @@ class ChApi ChSystemDescriptor {
     // MISC
     //
 
-    /// Set the number of threads (some operations like ShurComplementProduct
-    /// are CPU intensive, so they can be run in parallel threads).
-    /// By default, the number of threads is the same of max.available OpenMP cores
-    virtual void SetNumThreads(int nthreads);
-    virtual int GetNumThreads() { return this->num_threads; }
+    /// Set the task scheduler used to run the CPU intensive operations in parallel (the ChSystem sets its
+    /// own scheduler). ShurComplementProduct(), SystemProduct(), ConstraintsProject() and the assembly of
+    /// the K blocks are run in parallel only if the scheduler has more than one thread and the number of
+    /// constraints is large enough. Without a scheduler (the default), they are run serially.
+    void SetTaskScheduler(std::shared_ptr<ChTaskScheduler> scheduler) { task_scheduler = scheduler; }
+
+    /// Get the task scheduler used to run the parallel operations (null if none).
+    std::shared_ptr<ChTaskScheduler> GetTaskScheduler() const { return task_scheduler; }
+
+    /// Partition the constraints in colors, such that constraints with the same color do not
+    /// share any active ChVariables (see ChConstraint::CollectVariables()). Constraints with the
+    /// same color can then be processed concurrently in ShurComplementProduct() and SystemProduct().
+    /// Also, identify groups of consecutive constraints acting on the same variables (e.g. the
+    /// normal and tangential components of a contact), which are projected concurrently in
+    /// ConstraintsProject().
+    /// This is done automatically when needed, after each EndInsertion(); call it explicitly
+    /// if the active state of variables is changed after the insertion.
+    void UpdateConstraintColoring();
+
+    /// Return the number of colors used for the concurrent processing of constraints.
+    int GetNumConstraintColors() const { return color_ptr.empty() ? 0 : (int)color_ptr.size() - 1; }
 
     //
     // LOGGING/OUTPUT/ETC.
@@ -358,6 +414,15 @@ class ChApi ChSystemDescriptor {
                                      ChMatrix<>* rhs     ///< [out] assembled RHS vector
     );
 
+    /// Add all the K blocks to the sparse matrix 'storage', at the offsets of their variables
+    /// (as used by ConvertToMatrixForm).
+    /// If 'storage' is a compressed ChCSMatrix whose sparsity pattern already holds all the entries
+    /// of the blocks (typically with the sparsity pattern lock, after the first assembly), the blocks
+    /// are scattered in parallel, using a map from block entries to nonzeros: the map is rebuilt
+    /// only if the blocks, the variable offsets or the matrix change. Otherwise, the blocks are
+    /// added one at a time with ChKblock::Build_K(). The result is the same in both cases.
+    void BuildKblocks(ChSparseMatrix& storage);
+
     /// Saves to disk the LAST used matrices of the problem.
     /// If assembled == true,
     ///    dump_Z.dat   has the assembled optimization matrix (Matlab sparse format)
@@ -376,7 +441,6 @@ class ChApi ChSystemDescriptor {
         marchive.VersionWrite<ChSystemDescriptor>();
         // serialize parent class
         // serialize all member data:
-        marchive << CHNVP(num_threads);
     }
 
     /// Method to allow de-serialization of transient data from archives.
@@ -385,7 +449,6 @@ class ChApi ChSystemDescriptor {
         int version = marchive.VersionRead<ChSystemDescriptor>();
         // deserialize parent class
         // stream in all member data:
-        marchive >> CHNVP(num_threads);
     }
 };
 
@@ -20,8 +20,13 @@
 #ifndef CH_BENCHMARK_H
 #define CH_BENCHMARK_H
 
+#include <string>
+#include <utility>
+#include <vector>
+
 #include "benchmark/benchmark.h"
 #include "chrono/physics/ChSystem.h"
+#include "chrono/solver/ChIterativeSolver.h"
 
 namespace chrono {
 namespace utils {
@@ -42,6 +47,9 @@ class ChBenchmarkTest {
     void Simulate(int num_steps);
     void ResetTimers();
 
+    /// Report the timers and the solver statistics as counters of the given benchmark state.
+    void Report(benchmark::State& st) const;
+
     double m_timer_step;              ///< time for performing simulation
     double m_timer_advance;           ///< time for integration
     double m_timer_jacobian;          ///< time for evaluating/loading Jacobian data
@@ -51,6 +59,11 @@ class ChBenchmarkTest {
     double m_timer_collision_broad;   ///< time for broad-phase collision
     double m_timer_collision_narrow;  ///< time for narrow-phase collision
     double m_timer_update;            ///< time for system update
+
+    int m_num_steps;             ///< number of simulated steps
+    int m_solver_calls;          ///< number of solver calls
+    int m_solver_iterations;     ///< number of iterations of the last solver call of each step (iterative solvers)
+    double m_solver_violation;   ///< constraint violation at the end of the last solver call (if recorded)
 };
 
 inline ChBenchmarkTest::ChBenchmarkTest()
@@ -62,7 +75,11 @@ inline ChBenchmarkTest::ChBenchmarkTest()
       m_timer_collision(0),
       m_timer_collision_broad(0),
       m_timer_collision_narrow(0),
-      m_timer_update(0) {}
+      m_timer_update(0),
+      m_num_steps(0),
+      m_solver_calls(0),
+      m_solver_iterations(0),
+      m_solver_violation(0) {}
 
 inline void ChBenchmarkTest::Simulate(int num_steps) {
     ////std::cout << "  simulate from t=" << GetSystem()->GetChTime() << " for steps=" << num_steps << std::endl;
@@ -78,6 +95,14 @@ inline void ChBenchmarkTest::Simulate(int num_steps) {
         m_timer_collision_broad += GetSystem()->GetTimerCollisionBroad();
         m_timer_collision_narrow += GetSystem()->GetTimerCollisionNarrow();
         m_timer_update += GetSystem()->GetTimerUpdate();
+
+        m_num_steps++;
+        m_solver_calls += GetSystem()->GetSolverCallsCount();
+        if (auto solver = std::dynamic_pointer_cast<ChIterativeSolver>(GetSystem()->GetSolver())) {
+            m_solver_iterations += solver->GetTotalIterations();
+            if (!solver->GetViolationHistory().empty())
+                m_solver_violation = solver->GetViolationHistory().back();
+        }
     }
 }
 
@@ -91,6 +116,27 @@ inline void ChBenchmarkTest::ResetTimers() {
     m_timer_collision_broad = 0;
     m_timer_collision_narrow = 0;
     m_timer_update = 0;
+    m_num_steps = 0;
+    m_solver_calls = 0;
+    m_solver_iterations = 0;
+    m_solver_violation = 0;
+}
+
+inline void ChBenchmarkTest::Report(benchmark::State& st) const {
+    st.counters["Step_Total"] = m_timer_step * 1e3;
+    st.counters["Step_Advance"] = m_timer_advance * 1e3;
+    st.counters["Step_Update"] = m_timer_update * 1e3;
+    st.counters["LS_Jacobian"] = m_timer_jacobian * 1e3;
+    st.counters["LS_Setup"] = m_timer_setup * 1e3;
+    st.counters["LS_Solve"] = m_timer_solver * 1e3;
+    st.counters["CD_Total"] = m_timer_collision * 1e3;
+    st.counters["CD_Broad"] = m_timer_collision_broad * 1e3;
+    st.counters["CD_Narrow"] = m_timer_collision_narrow * 1e3;
+    if (m_num_steps > 0) {
+        st.counters["LS_Calls"] = (double)m_solver_calls / m_num_steps;
+        st.counters["LS_Iterations"] = (double)m_solver_iterations / m_num_steps;
+    }
+    st.counters["LS_Violation"] = m_solver_violation;
 }
 
 // =============================================================================
@@ -153,17 +199,7 @@ class ChBenchmarkFixture : public ::benchmark::Fixture {
 
     ~ChBenchmarkFixture() { delete m_test; }
 
-    void Report(benchmark::State& st) {
-        st.counters["Step_Total"] = m_test->m_timer_step * 1e3;
-        st.counters["Step_Advance"] = m_test->m_timer_advance * 1e3;
-        st.counters["Step_Update"] = m_test->m_timer_update * 1e3;
-        st.counters["LS_Jacobian"] = m_test->m_timer_jacobian * 1e3;
-        st.counters["LS_Setup"] = m_test->m_timer_setup * 1e3;
-        st.counters["LS_Solve"] = m_test->m_timer_solver * 1e3;
-        st.counters["CD_Total"] = m_test->m_timer_collision * 1e3;
-        st.counters["CD_Broad"] = m_test->m_timer_collision_broad * 1e3;
-        st.counters["CD_Narrow"] = m_test->m_timer_collision_narrow * 1e3;
-    }
+    void Report(benchmark::State& st) { m_test->Report(st); }
 
     void Reset(int num_init_steps) {
         ////std::cout << "RESET" << std::endl;
@@ -175,6 +211,78 @@ class ChBenchmarkFixture : public ::benchmark::Fixture {
     TEST* m_test;
 };
 
+// =============================================================================
+
+/// Solver types swept by RegisterSolverSweep (all the solvers available in the Chrono core module).
+inline const std::vector<std::pair<ChSolver::Type, std::string>>& GetBenchmarkSolverTypes() {
+    static const std::vector<std::pair<ChSolver::Type, std::string>> types = {
+        {ChSolver::Type::SOR, "SOR"},
+        {ChSolver::Type::SYMMSOR, "SYMMSOR"},
+        {ChSolver::Type::JACOBI, "JACOBI"},
+        {ChSolver::Type::SOR_MULTITHREAD, "SOR_MULTITHREAD"},
+        {ChSolver::Type::PMINRES, "PMINRES"},
+        {ChSolver::Type::BARZILAIBORWEIN, "BARZILAIBORWEIN"},
+        {ChSolver::Type::PCG, "PCG"},
+        {ChSolver::Type::APGD, "APGD"},
+        {ChSolver::Type::MINRES, "MINRES"},
+        {ChSolver::Type::SPARSE_LU, "SPARSE_LU"}};
+    return types;
+}
+
+/// Timestepper types swept by RegisterSolverSweep (all the timesteppers of the Chrono core module).
+inline const std::vector<std::pair<ChTimestepper::Type, std::string>>& GetBenchmarkTimestepperTypes() {
+    static const std::vector<std::pair<ChTimestepper::Type, std::string>> types = {
+        {ChTimestepper::Type::EULER_IMPLICIT_LINEARIZED, "EULER_IMPLICIT_LINEARIZED"},
+        {ChTimestepper::Type::EULER_IMPLICIT_PROJECTED, "EULER_IMPLICIT_PROJECTED"},
+        {ChTimestepper::Type::EULER_IMPLICIT, "EULER_IMPLICIT"},
+        {ChTimestepper::Type::TRAPEZOIDAL, "TRAPEZOIDAL"},
+        {ChTimestepper::Type::TRAPEZOIDAL_LINEARIZED, "TRAPEZOIDAL_LINEARIZED"},
+        {ChTimestepper::Type::HHT, "HHT"},
+        {ChTimestepper::Type::HEUN, "HEUN"},
+        {ChTimestepper::Type::RUNGEKUTTA45, "RUNGEKUTTA45"},
+        {ChTimestepper::Type::EULER_EXPLICIT, "EULER_EXPLICIT"},
+        {ChTimestepper::Type::LEAPFROG, "LEAPFROG"},
+        {ChTimestepper::Type::NEWMARK, "NEWMARK"}};
+    return types;
+}
+
+/// Register benchmarks of the ChBenchmarkTest TEST for all the combinations of solver and timestepper
+/// types supported by the test. TEST must provide:
+///   - a constructor TEST(ChSolver::Type solver_type, ChTimestepper::Type timestepper_type)
+///   - a static function bool Supports(ChSolver::Type solver_type, ChTimestepper::Type timestepper_type)
+/// The benchmarks are named NAME/solver/timestepper. For each measurement, the model is created, an
+/// initial SKIP_STEPS integration steps are performed for hot start, then batches of SIM_STEPS are timed.
+/// Besides the timers, each benchmark reports the number of solver calls and iterations per step and
+/// the final constraint violation (violation history recording is enabled on iterative solvers).
+/// Must be called before benchmark::RunSpecifiedBenchmarks (e.g. in main).
+template <typename TEST>
+void RegisterSolverSweep(const std::string& name, int skip_steps, int sim_steps, int repetitions) {
+    for (const auto& solver : GetBenchmarkSolverTypes()) {
+        for (const auto& stepper : GetBenchmarkTimestepperTypes()) {
+            if (!TEST::Supports(solver.first, stepper.first))
+                continue;
+            ChSolver::Type solver_type = solver.first;
+            ChTimestepper::Type stepper_type = stepper.first;
+            std::string test_name = name + "/" + solver.second + "/" + stepper.second;
+            benchmark::RegisterBenchmark(test_name.c_str(),
+                                         [=](benchmark::State& st) {
+                                             TEST test(solver_type, stepper_type);
+                                             auto iterative = std::dynamic_pointer_cast<ChIterativeSolver>(
+                                                 test.GetSystem()->GetSolver());
+                                             if (iterative)
+                                                 iterative->SetRecordViolation(true);
+                                             test.Simulate(skip_steps);
+                                             while (st.KeepRunning()) {
+                                                 test.Simulate(sim_steps);
+                                             }
+                                             test.Report(st);
+                                         })
+                ->Unit(benchmark::kMillisecond)
+                ->Repetitions(repetitions);
+        }
+    }
+}
+
 }  // end namespace utils
 }  // end namespace chrono
 
@@ -14,6 +14,9 @@
 
 #pragma once
 
+#include "chrono/core/ChQuaternion.h"
+#include "chrono/core/ChVector.h"
+
 #include "chrono_distributed/ChApiDistributed.h"
 #include "chrono_distributed/other_types.h"
 #include "chrono_distributed/physics/ChSystemDistributed.h"
@@ -65,7 +68,11 @@ class CH_DISTR_API ChDistributedDataManager {
     /* Basic distributed values */
     std::vector<unsigned int> global_id;                ///< Global id of each body. Maps local index to global index.
     std::vector<distributed::COMM_STATUS> comm_status;  ///< Communication status of each body.
-    std::vector<distributed::COMM_STATUS> curr_status;  ///< Used as a reference only by ChCommDistributed.
+    std::vector<unsigned int> ghost_mask;  ///< For bodies owned by this rank, mask of the neighbors holding a ghost.
+                                           ///< Bit n refers to neighbor n of ChDomainDistributed::GetNeighbors.
+    std::vector<ChVector<double>> ref_pos;      ///< Reference position of each shared body and ghost. Updates are
+                                                ///< sent as changes from it and it is advanced alike on all ranks.
+    std::vector<ChQuaternion<double>> ref_rot;  ///< Reference rotation of each shared body and ghost.
 
     std::unordered_map<uint, int> gid_to_localid;  ///< Maps gloabl id to local id on this rank
 
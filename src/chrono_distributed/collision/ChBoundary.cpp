@@ -15,6 +15,7 @@
 #include <cmath>
 
 #include "chrono_distributed/collision/ChBoundary.h"
+#include "chrono_distributed/physics/ChSystemDistributed.h"
 
 namespace chrono {
 
@@ -84,13 +85,53 @@ void ChBoundary::AddVisualization(double thickness) {
 }
 
 ChBoundary::Plane::Plane(const ChFrame<>& frame_loc, const ChFrame<>& frame, const ChVector2<>& lengths)
-    : m_frame_loc(frame_loc), m_frame(frame), m_hlen(lengths * 0.5), m_normal(frame.GetA().Get_A_Zaxis()) {}
+    : m_frame_loc(frame_loc),
+      m_frame(frame),
+      m_hlen(lengths * 0.5),
+      m_normal(frame.GetA().Get_A_Zaxis()),
+      m_active(true) {}
+
+void ChBoundary::UpdateActivePlanes(ChSystem* system) {
+    auto sys = dynamic_cast<ChSystemDistributed*>(system);
+    if (!sys) {
+        for (auto& plane : m_planes)
+            plane.m_active = true;
+        return;
+    }
+
+    // Sub-domain extended by the ghost layer across interior faces only; the sub-domains
+    // at the boundary of the global domain extend to infinity.
+    ChDomainDistributed* domain = sys->GetDomain();
+    ChVector<int> dims = domain->GetDecomposition();
+    ChVector<int> coords = domain->GetGridCoords();
+    ChVector<> sublo = domain->GetSubLo();
+    ChVector<> subhi = domain->GetSubHi();
+    double ghost_layer = sys->GetGhostLayer();
+
+    for (auto& plane : m_planes) {
+        // Axis-aligned bounding box of the plane
+        ChVector<> center = plane.m_frame.GetPos();
+        ChVector<> u = plane.m_frame.GetA().Get_A_Xaxis();
+        ChVector<> v = plane.m_frame.GetA().Get_A_Yaxis();
+        plane.m_active = true;
+        for (int a = 0; a < 3; a++) {
+            double ext = std::abs(u[a]) * plane.m_hlen.x() + std::abs(v[a]) * plane.m_hlen.y();
+            if (coords[a] > 0 && center[a] + ext < sublo[a] - ghost_layer)
+                plane.m_active = false;
+            if (coords[a] < dims[a] - 1 && center[a] - ext > subhi[a] + ghost_layer)
+                plane.m_active = false;
+        }
+    }
+}
 
 void ChBoundary::OnCustomCollision(ChSystem* system) {
     auto sys = static_cast<ChSystemParallel*>(system);
+    auto dsys = dynamic_cast<ChSystemDistributed*>(system);
 
     m_crt_count = 0;
 
+    UpdateActivePlanes(system);
+
     // Loop over all bodies in the system
     //// TODO: maybe better to loop over all collision shapes in the system?
     for (auto body : *sys->data_manager->body_list) {
@@ -98,6 +139,12 @@ void ChBoundary::OnCustomCollision(ChSystem* system) {
             continue;
         if (!sys->data_manager->host_data.active_rigid[body->GetId()])
             continue;
+        // The state of a ghost body is overwritten by its owner rank
+        if (dsys) {
+            distributed::COMM_STATUS status = dsys->ddm->comm_status[body->GetId()];
+            if (status != distributed::OWNED && status != distributed::SHARED)
+                continue;
+        }
 
         auto model = std::dynamic_pointer_cast<collision::ChCollisionModelParallel>(body->GetCollisionModel());
 
@@ -129,13 +176,15 @@ void ChBoundary::OnCustomCollision(ChSystem* system) {
 
 void ChBoundary::CheckSphere(std::shared_ptr<collision::ChCollisionModel> model, const ChVector<>& center, double radius) {
     for (auto& plane : m_planes) {
-        CheckSpherePlane(model, center, radius, plane);
+        if (plane.m_active)
+            CheckSpherePlane(model, center, radius, plane);
     }
 }
 
 void ChBoundary::CheckBox(std::shared_ptr<collision::ChCollisionModel> model, const ChFrame<>& frame, const ChVector<>& size) {
     for (auto& plane : m_planes) {
-        CheckBoxPlane(model, frame, size, plane);
+        if (plane.m_active)
+            CheckBoxPlane(model, frame, size, plane);
     }
 }
 
@@ -29,6 +29,8 @@ namespace chrono {
 /// @{
 
 /// Utility class for specifying a collision boundary composed of multiple semi-planes.
+/// In a distributed system, contacts are only generated for bodies owned by this rank and
+/// planes not reaching the rank's sub-domain (extended by the ghost layer) are skipped.
 class CH_DISTR_API ChBoundary : public ChSystem::CustomCollisionCallback {
   public:
     ChBoundary(std::shared_ptr<ChBody> body);
@@ -77,10 +79,14 @@ class CH_DISTR_API ChBoundary : public ChSystem::CustomCollisionCallback {
         ChVector2<> m_hlen;                     ///< half-extents in X and Y directions
         ChVector<> m_normal;                    ///< cached plane normal, expressed in global
         std::shared_ptr<ChBoxShape> m_vis_box;  ///< visualization box
+        bool m_active;                          ///< plane intersects the sub-domain of this rank
     };
 
     virtual void OnCustomCollision(ChSystem* system) override;
 
+    /// Flag the planes which intersect the sub-domain of this rank (all planes if not distributed).
+    void UpdateActivePlanes(ChSystem* system);
+
     void CheckSphere(std::shared_ptr<collision::ChCollisionModel> model, const ChVector<>& center, double radius);
     void CheckSpherePlane(std::shared_ptr<collision::ChCollisionModel> model,
                           const ChVector<>& center,
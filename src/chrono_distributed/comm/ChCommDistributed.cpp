@@ -14,10 +14,11 @@
 
 #include <mpi.h>
 #include <omp.h>
+#include <algorithm>
 #include <climits>
-#include <forward_list>
 #include <memory>
 #include <string>
+#include <vector>
 
 #include "chrono_distributed/ChDistributedDataManager.h"
 #include "chrono_distributed/collision/ChCollisionModelDistributed.h"
@@ -61,12 +62,12 @@ ChCommDistributed::ChCommDistributed(ChSystemDistributed* my_sys) {
     MPI_Type_commit(&BodyExchangeType);
 
     // Update
-    MPI_Datatype type_update[3] = {MPI_UNSIGNED, MPI_INT, MPI_DOUBLE};
+    MPI_Datatype type_update[3] = {MPI_UNSIGNED, MPI_INT, MPI_FLOAT};
     int blocklen_update[3] = {1, 1, 13};
     MPI_Aint disp_update[3];
     disp_update[0] = offsetof(BodyUpdate, gid);
     disp_update[1] = offsetof(BodyUpdate, update_type);
-    disp_update[2] = offsetof(BodyUpdate, pos);
+    disp_update[2] = offsetof(BodyUpdate, dpos);
     MPI_Type_create_struct(3, blocklen_update, disp_update, type_update, &BodyUpdateType);
     MPI_Type_commit(&BodyUpdateType);
 
@@ -85,15 +86,15 @@ ChCommDistributed::ChCommDistributed(ChSystemDistributed* my_sys) {
     MPI_Type_get_extent(temp_type_s, &lb_s, &extent_s);
     MPI_Type_create_resized(temp_type_s, lb_s, extent_s, &ShapeType);
     MPI_Type_commit(&ShapeType);
+
+    // Exchange messages use their own communicator, so that they cannot be matched by other
+    // communication on the system's communicator while an exchange is in progress.
+    MPI_Comm_dup(my_sys->world, &exchange_comm);
 }
 
 ChCommDistributed::~ChCommDistributed() {}
 
-void ChCommDistributed::ProcessExchanges(int num_recv, BodyExchange* buf, int updown) {
-    if (buf->gid == UINT_MAX) {
-        return;
-    }
-
+void ChCommDistributed::ProcessExchanges(int num_recv, BodyExchange* buf) {
     ddm->first_empty = 0;
     std::shared_ptr<ChBody> body;
 
@@ -121,44 +122,42 @@ void ChCommDistributed::ProcessExchanges(int num_recv, BodyExchange* buf, int up
         UnpackExchange(buf + n, body);
 
         // Add the new body
-        distributed::COMM_STATUS status = (updown == 1) ? distributed::GHOST_UP : distributed::GHOST_DOWN;
         if (ddm->first_empty == data_manager->num_rigid_bodies) {
-            my_sys->AddBodyExchange(body, status);  // NOTE: Does not call colsys::add
+            my_sys->AddBodyExchange(body, distributed::GHOST);  // NOTE: Does not call colsys::add
         } else {
-            ddm->comm_status[ddm->first_empty] = status;
+            ddm->comm_status[ddm->first_empty] = distributed::GHOST;
+            ddm->ghost_mask[ddm->first_empty] = 0;
             body->SetBodyFixed(false);
             ddm->gid_to_localid[body->GetGid()] = body->GetId();
             ddm->global_id[body->GetId()] = body->GetGid();
         }
+        ddm->ref_pos[body->GetId()] = body->GetPos();
+        ddm->ref_rot[body->GetId()] = body->GetRot();
         // NOTE: At this point, the body has collide == false and it has not touched the collision system
     }
 }
 
 void ChCommDistributed::ProcessUpdates(int num_recv, BodyUpdate* buf) {
-    // If the buffer is empty
-    if (buf->gid == UINT_MAX) {
-        return;
-    }
-    std::shared_ptr<ChBody> body;
     for (int n = 0; n < num_recv; n++) {
         // Find the existing body
         int index = ddm->GetLocalIndex((buf + n)->gid);
 
         if (index != -1 && ddm->comm_status[index] != distributed::EMPTY) {
-            if (ddm->comm_status[index] != distributed::GHOST_UP &&
-                ddm->comm_status[index] != distributed::GHOST_DOWN) {
+            if (ddm->comm_status[index] != distributed::GHOST) {
                 my_sys->ErrorAbort(std::string("Trying to update a non-ghost body on rank ") +
                                    std::to_string(my_sys->my_rank) + std::string("GID ") +
                                    std::to_string((buf + n)->gid) + std::string("\n"));
             }
-            body = (*data_manager->body_list)[index];
-            UnpackUpdate(buf + n, body);
+            if ((buf + n)->update_type == distributed::FINAL_UPDATE_TAKE) {
+                my_sys->RemoveBodyExchange(index);
+                continue;
+            }
+            UnpackUpdate(buf + n, index);
             if ((buf + n)->update_type == distributed::FINAL_UPDATE_GIVE) {
-                GetLog() << "GIVE " << ddm->global_id[index] << " to rank " << my_sys->my_rank << "\n";
-                ddm->comm_status[index] = distributed::OWNED;
-            } else if ((buf + n)->update_type == distributed::UPDATE_TRANSFER_SHARE) {
-                ddm->comm_status[index] = (ddm->comm_status[index] == distributed::GHOST_UP) ? distributed::SHARED_UP
-                                                                                             : distributed::SHARED_DOWN;
+                // The previous owner has left ghosts exactly on the ranks whose ghost regions contain the
+                // reference position of the body, which this rank now holds bit for bit.
+                ddm->ghost_mask[index] = my_sys->domain->GetGhostMask(ddm->ref_pos[index]);
+                ddm->comm_status[index] = ddm->ghost_mask[index] ? distributed::SHARED : distributed::OWNED;
             }
         } else {
             GetLog() << "GID " << (buf + n)->gid << " NOT found rank " << my_sys->my_rank << "\n";
@@ -167,22 +166,8 @@ void ChCommDistributed::ProcessUpdates(int num_recv, BodyUpdate* buf) {
     }
 }
 
-void ChCommDistributed::ProcessTakes(int num_recv, uint* buf) {
-    if (buf[0] == UINT_MAX) {
-        return;
-    }
-    for (int i = 0; i < num_recv; i++) {
-        int index = ddm->GetLocalIndex(buf[i]);
-        my_sys->RemoveBodyExchange(index);
-    }
-}
-
 // TODO might be able to do in parallel if check the number of shapes per body in a first pass
 void ChCommDistributed::ProcessShapes(int num_recv, Shape* buf) {
-    if (buf->gid == UINT_MAX) {
-        return;
-    }
-
     int n = 0;
     uint gid;
 
@@ -240,449 +225,204 @@ void ChCommDistributed::ProcessShapes(int num_recv, Shape* buf) {
 }
 
 // Handle all necessary communication
-void ChCommDistributed::Exchange() {
-    int my_rank = my_sys->my_rank;
-    int num_ranks = my_sys->num_ranks;
-    std::forward_list<int> exchanges_up;
-    std::forward_list<int> exchanges_down;
-
-    // Saves a reference copy for consistency in the threads.
-    ddm->curr_status = ddm->comm_status;
-    std::vector<BodyExchange> exchange_up_buf;
-    std::vector<BodyExchange> exchange_down_buf;
-    std::vector<BodyUpdate> update_up_buf;
-    std::vector<BodyUpdate> update_down_buf;
-    std::vector<Shape> shapes_up;
-    std::vector<Shape> shapes_down;
-    std::vector<uint> update_take_up;
-    std::vector<uint> update_take_down;
-
-    // Send Counts
-    int num_exchange_up = 0;
-    int num_exchange_down = 0;
-    int num_update_up = 0;
-    int num_update_down = 0;
-    int num_shapes_up = 0;
-    int num_shapes_down = 0;
-    int num_take_up = 0;
-    int num_take_down = 0;
-
-#pragma omp parallel sections
-    {
-// Exchange Loop
-#pragma omp section
-        {
-            for (uint i = 0; i < data_manager->num_rigid_bodies; i++) {
-                // Skip empty bodies or those that this rank isn't responsible for
-                int curr_status = ddm->curr_status[i];
-                if (curr_status != distributed::OWNED)
-                    continue;
-                int location = my_sys->domain->GetBodyRegion(i);
-
-                // If the body now affects the next sub-domain
-                // If the body is being marked as shared for the first time, the whole
-                // body must be packed to create a ghost on another rank
-                if ((location == distributed::GHOST_UP || location == distributed::SHARED_UP)) {
-                    BodyExchange b_ex = {};
-                    PackExchange(&b_ex, i);
-                    exchange_up_buf.push_back(b_ex);
+void ChCommDistributed::PostReceives() {
+    const std::vector<int>& neighbors = my_sys->domain->GetNeighbors();
+    int num_neighbors = static_cast<int>(neighbors.size());
 
-                    num_exchange_up++;  // TODO might be able to eliminate
-                    ddm->comm_status[i] = distributed::SHARED_UP;
-                    exchanges_up.push_front(i);
-                }
+    send_msg.resize(num_neighbors);
+    recv_msg.resize(num_neighbors);
+    header_requests.assign(num_neighbors, MPI_REQUEST_NULL);
 
-                // If the body now affects the previous sub-domain:
-                // If the body is being
-                // marked as shared for the first time, the whole
-                // body must be packed to create a ghost on another rank
-                else if ((location == distributed::GHOST_DOWN || location == distributed::SHARED_DOWN)) {
-                    BodyExchange b_ex = {};
-                    PackExchange(&b_ex, i);
-                    exchange_down_buf.push_back(b_ex);
+    // The sizes of the messages from each neighbor are received first
+    for (int n = 0; n < num_neighbors; n++) {
+        MPI_Irecv(recv_msg[n].counts, 3, MPI_INT, neighbors[n], 0, exchange_comm, &header_requests[n]);
+    }
+}
 
-                    num_exchange_down++;  // TODO might be able to eliminate
-                    ddm->comm_status[i] = distributed::SHARED_DOWN;
-                    exchanges_down.push_front(i);
-                }
-            }
-        }  // end of exchange section
-
-        // Update Loop
-#pragma omp section
-        {
-            // PACKING and UPDATING comm_status of existing bodies
-            for (uint i = 0; i < data_manager->num_rigid_bodies; i++) {
-                // Skip empty bodies or those that this rank isn't responsible for
-                int curr_status = ddm->curr_status[i];
-                int location = my_sys->domain->GetBodyRegion(i);
-
-                if (curr_status != distributed::SHARED_UP && curr_status != distributed::SHARED_DOWN)
-                    continue;
-
-                // If the body has already been shared, it need only update its
-                // corresponding ghost
-                if (location == distributed::SHARED_UP && curr_status == distributed::SHARED_UP) {
-                    BodyUpdate b_upd = {};
-                    PackUpdate(&b_upd, i, distributed::UPDATE);
-                    update_up_buf.push_back(b_upd);
-
-                    num_update_up++;  // TODO might be able to eliminate
-                } else if (location == distributed::GHOST_UP && curr_status == distributed::SHARED_UP) {
-                    BodyUpdate b_upd = {};
-                    PackUpdate(&b_upd, i, distributed::UPDATE_TRANSFER_SHARE);
-                    update_up_buf.push_back(b_upd);
-
-                    ddm->comm_status[i] = distributed::GHOST_UP;
-                    num_update_up++;  // TODO might be able to eliminate
-                }
+void ChCommDistributed::PostExchange(const std::vector<int>& bodies) {
+    ChDomainDistributed* domain = my_sys->domain;
+    const std::vector<int>& neighbors = domain->GetNeighbors();
+    int num_neighbors = static_cast<int>(neighbors.size());
+    ChVector<int> coords = domain->GetGridCoords();
+
+    // Outgoing messages, one set per neighbor
+    for (auto& msg : send_msg) {
+        msg.exchanges.clear();
+        msg.updates.clear();
+        msg.shapes.clear();
+    }
 
-                // If the body has already been shared, it need only update its
-                // corresponding ghost
-                else if (location == distributed::SHARED_DOWN && curr_status == distributed::SHARED_DOWN) {
-                    BodyUpdate b_upd = {};
-                    PackUpdate(&b_upd, i, distributed::UPDATE);
-                    update_down_buf.push_back(b_upd);
-
-                    num_update_down++;  // TODO might be able to eliminate
-                } else if (location == distributed::GHOST_DOWN && curr_status == distributed::SHARED_DOWN) {
-                    BodyUpdate b_upd = {};
-                    PackUpdate(&b_upd, i, distributed::UPDATE_TRANSFER_SHARE);
-                    update_down_buf.push_back(b_upd);
-
-                    ddm->comm_status[i] = distributed::GHOST_DOWN;
-                    num_update_down++;  // TODO might be able to eliminate
-                }
-                // If is shared up/down AND
-                // If the body is no longer involved with this rank, it must be removed from
-                // this rank
-                else if ((location == distributed::UNOWNED_UP || location == distributed::UNOWNED_DOWN) &&
-                         (ddm->comm_status[i] == distributed::SHARED_UP ||
-                          ddm->comm_status[i] == distributed::SHARED_DOWN)) {
-                    int up;
-                    if (location == distributed::UNOWNED_UP && my_rank != num_ranks - 1) {
-                        GetLog() << "GIVE " << ddm->global_id[i] << " from rank " << my_rank << "\n";
-                        BodyUpdate b_upd = {};
-                        PackUpdate(&b_upd, i, distributed::FINAL_UPDATE_GIVE);
-                        update_up_buf.push_back(b_upd);
-                        num_update_up++;  // TODO might be able to eliminate
-                        up = 1;
-                    } else if (location == distributed::UNOWNED_DOWN && my_rank != 0) {
-                        GetLog() << "GIVE " << ddm->global_id[i] << " from rank " << my_rank << "\n";
-                        BodyUpdate b_upd = {};
-                        PackUpdate(&b_upd, i, distributed::FINAL_UPDATE_GIVE);
-                        update_down_buf.push_back(b_upd);
-
-                        num_update_down++;  // TODO might be able to eliminate
-                        up = -1;
-                    }
+    // PACKING and UPDATING comm_status of the bodies owned by this rank.
+    // The owner of a body alone decides which neighbors hold a ghost of it.
+    for (int i : bodies) {
+        int curr_status = ddm->comm_status[i];
+        if (curr_status != distributed::OWNED && curr_status != distributed::SHARED)
+            continue;
+
+        unsigned int have = ddm->ghost_mask[i];  // Neighbors holding a ghost of the body
+
+        // The update is the same for all ghosts, which hold the same reference pose.
+        // Without ghosts, the reference pose is reset to the current pose (and the update carries no change).
+        if (!have) {
+            real3 p = data_manager->host_data.pos_rigid[i];
+            ddm->ref_pos[i] = ChVector<double>(p.x, p.y, p.z);
+            quaternion rot = data_manager->host_data.rot_rigid[i];
+            ddm->ref_rot[i] = ChQuaternion<double>(rot.w, rot.x, rot.y, rot.z);
+        }
+        BodyUpdate b_upd = {};
+        PackUpdate(&b_upd, i, distributed::UPDATE);
+
+        // The body is classified from its updated reference position, which is the position held by the
+        // ghosts after the exchange: the rank taking ownership computes the same ghost mask from it.
+        const ChVector<double>& pos = ddm->ref_pos[i];
+        unsigned int need = domain->GetGhostMask(pos);  // Neighbors whose ghost region contains the body
+
+        // Neighbor index of the rank taking ownership of the body, if it left this sub-domain
+        int new_owner = -1;
+        int owner = domain->GetRank(pos);
+        if (owner != my_sys->my_rank) {
+            new_owner = domain->GetNeighborIndex(owner);
+            if (new_owner == -1) {
+                my_sys->ErrorAbort(std::string("GID ") + std::to_string(ddm->global_id[i]) +
+                                   " moved beyond the neighbors of rank " + std::to_string(my_sys->my_rank) + "\n");
+            }
+        }
 
-                    my_sys->RemoveBodyExchange(i);
+        for (int n = 0; n < num_neighbors; n++) {
+            unsigned int bit = 1u << n;
+            if (need & bit) {
+                // If the body enters the ghost region of the neighbor, the whole
+                // body must be packed to create a ghost there
+                if (!(have & bit)) {
+                    BodyExchange b_ex = {};
+                    PackExchange(&b_ex, i);
+                    send_msg[n].exchanges.push_back(b_ex);
+                    PackShapes(&send_msg[n].shapes, i);
                 }
-            }  // End of packing for loop
-        }      // End of update section
-
-        // Update Take Loop
-#pragma omp section
-        {
-            // PACKING and UPDATING comm_status of existing bodies
-            for (uint i = 0; i < data_manager->num_rigid_bodies; i++) {
-                // Skip empty bodies or those that this rank isn't responsible for
-                int curr_status = ddm->curr_status[i];
-                if (curr_status != distributed::SHARED_DOWN && curr_status != distributed::SHARED_UP)
-                    continue;
-
-                int location = my_sys->domain->GetBodyRegion(i);
-
-                // If the body is no longer involved with either neighbor, remove it from
-                // the other rank and take ownership on this rank
-                if (location == distributed::OWNED) {
-                    if (curr_status == distributed::SHARED_UP) {
-                        uint b_ut;
-                        PackUpdateTake(&b_ut, i);
-                        update_take_up.push_back(b_ut);
-                        num_take_up++;  // TODO might be able to eliminate
-
-                    } else if (curr_status == distributed::SHARED_DOWN) {
-                        uint b_ut;
-                        PackUpdateTake(&b_ut, i);
-                        update_take_down.push_back(b_ut);
-                        num_take_down++;  // TODO might be able to eliminate
+                // The new owner always holds a ghost, which it turns into the body.
+                // Other existing ghosts need only be updated.
+                if (n == new_owner) {
+                    send_msg[n].updates.push_back(b_upd);
+                    BodyUpdate& b_give = send_msg[n].updates.back();
+                    b_give.update_type = distributed::FINAL_UPDATE_GIVE;
+                    // A ghost created by this exchange already holds the updated reference pose
+                    if (!(have & bit)) {
+                        std::fill(b_give.dpos, b_give.dpos + 3, 0.0f);
+                        std::fill(b_give.drot, b_give.drot + 4, 0.0f);
                     }
-                    ddm->comm_status[i] = distributed::OWNED;
+                } else if (have & bit) {
+                    send_msg[n].updates.push_back(b_upd);
                 }
-            }  // End of packing for loop
-        }      // End of update take loop
-    }          // End of parallel sections
-
-    //MPI_Status status_exchange_up;
-    //MPI_Status status_exchange_down;
-    //MPI_Status status_update_up;
-    //MPI_Status status_update_down;
-    //MPI_Status status_take_up;
-    //MPI_Status status_take_down;
-    //MPI_Status status_shapes_up;
-    //MPI_Status status_shapes_down;
-
-    MPI_Request rq_exchange_up;
-    MPI_Request rq_exchange_down;
-    MPI_Request rq_update_up;
-    MPI_Request rq_update_down;
-    MPI_Request rq_take_up;
-    MPI_Request rq_take_down;
-    MPI_Request rq_shapes_up;
-    MPI_Request rq_shapes_down;
-
-    MPI_Status recv_status_exchange_up;
-    MPI_Status recv_status_exchange_down;
-    MPI_Status recv_status_update_up;
-    MPI_Status recv_status_update_down;
-    MPI_Status recv_status_take_up;
-    MPI_Status recv_status_take_down;
-    MPI_Status recv_status_shapes_up;
-    MPI_Status recv_status_shapes_down;
-
-    int num_recv_exchange_up;
-    int num_recv_exchange_down;
-    int num_recv_update_up;
-    int num_recv_update_down;
-    int num_recv_take_up;
-    int num_recv_take_down;
-    int num_recv_shapes_up;
-    int num_recv_shapes_down;
-
-    BodyExchange* recv_exchange_down = NULL;
-    BodyExchange* recv_exchange_up = NULL;
-    BodyUpdate* recv_update_down = NULL;
-    BodyUpdate* recv_update_up = NULL;
-    uint* recv_take_down = NULL;
-    uint* recv_take_up = NULL;
-    Shape* recv_shapes_down = NULL;
-    Shape* recv_shapes_up = NULL;
-
-#pragma omp parallel sections
-    {
-// Send/Recv
-#pragma omp section
-        {
-            // SENDING - TODO sequential for now
-
-            // Send empty message if there is nothing to send
-            if (num_exchange_up == 0) {
-                BodyExchange b_e = {};
-                b_e.gid = UINT_MAX;
-                exchange_up_buf.push_back(b_e);
-                num_exchange_up = 1;
-            }
-            if (num_exchange_down == 0) {
-                BodyExchange b_e = {};
-                b_e.gid = UINT_MAX;
-                exchange_down_buf.push_back(b_e);
-                num_exchange_down = 1;
-            }
-            if (num_update_up == 0) {
-                BodyUpdate b_u = {};
-                b_u.gid = UINT_MAX;
-                update_up_buf.push_back(b_u);
-                num_update_up = 1;
-            }
-            if (num_update_down == 0) {
-                BodyUpdate b_u = {};
-                b_u.gid = UINT_MAX;
-                update_down_buf.push_back(b_u);
-                num_update_down = 1;
-            }
-            if (num_take_up == 0) {
-                update_take_up.push_back(UINT_MAX);
-                num_take_up = 1;
-            }
-            if (num_take_down == 0) {
-                update_take_down.push_back(UINT_MAX);
-                num_take_down = 1;
-            }
-
-            // Send Exchanges
-            if (my_rank != num_ranks - 1) {
-                MPI_Isend(&(exchange_up_buf[0]), num_exchange_up, BodyExchangeType, my_rank + 1, 1, my_sys->world,
-                          &rq_exchange_up);
-            }
-            if (my_rank != 0) {
-                MPI_Isend(&(exchange_down_buf[0]), num_exchange_down, BodyExchangeType, my_rank - 1, 2, my_sys->world,
-                          &rq_exchange_down);
-            }
-
-            // Recv Exchanges
-            if (my_rank != 0) {
-                MPI_Probe(my_rank - 1, 1, my_sys->world, &recv_status_exchange_down);
-                MPI_Get_count(&recv_status_exchange_down, BodyExchangeType, &num_recv_exchange_down);
-                recv_exchange_down = new BodyExchange[num_recv_exchange_down];
-                MPI_Recv(recv_exchange_down, num_recv_exchange_down, BodyExchangeType, my_rank - 1, 1, my_sys->world,
-                         &recv_status_exchange_down);
-            }
-            if (my_rank != num_ranks - 1) {
-                MPI_Probe(my_rank + 1, 2, my_sys->world, &recv_status_exchange_up);
-                MPI_Get_count(&recv_status_exchange_up, BodyExchangeType, &num_recv_exchange_up);
-                recv_exchange_up = new BodyExchange[num_recv_exchange_up];
-                MPI_Recv(recv_exchange_up, num_recv_exchange_up, BodyExchangeType, my_rank + 1, 2, my_sys->world,
-                         &recv_status_exchange_up);
-            }
-
-            // Send Updates
-            if (my_rank != num_ranks - 1) {
-                MPI_Isend(&(update_up_buf[0]), num_update_up, BodyUpdateType, my_rank + 1, 3, my_sys->world,
-                          &rq_update_up);
-            }
-            if (my_rank != 0) {
-                MPI_Isend(&(update_down_buf[0]), num_update_down, BodyUpdateType, my_rank - 1, 4, my_sys->world,
-                          &rq_update_down);
-            }
-
-            // Recv Updates
-            if (my_rank != 0) {
-                MPI_Probe(my_rank - 1, 3, my_sys->world, &recv_status_update_down);
-                MPI_Get_count(&recv_status_update_down, BodyUpdateType, &num_recv_update_down);
-                recv_update_down = new BodyUpdate[num_recv_update_down];
-                MPI_Recv(recv_update_down, num_recv_update_down, BodyUpdateType, my_rank - 1, 3, my_sys->world,
-                         &recv_status_update_down);
-            }
-            if (my_rank != num_ranks - 1) {
-                MPI_Probe(my_rank + 1, 4, my_sys->world, &recv_status_update_up);
-                MPI_Get_count(&recv_status_update_up, BodyUpdateType, &num_recv_update_up);
-                recv_update_up = new BodyUpdate[num_recv_update_up];
-                MPI_Recv(recv_update_up, num_recv_update_up, BodyUpdateType, my_rank + 1, 4, my_sys->world,
-                         &recv_status_update_up);
-            }
-
-            // Send Takes
-            if (my_rank != num_ranks - 1) {
-                MPI_Isend(&(update_take_up[0]), num_take_up, MPI_UNSIGNED, my_rank + 1, 5, my_sys->world, &rq_take_up);
-            }
-            if (my_rank != 0) {
-                MPI_Isend(&(update_take_down[0]), num_take_down, MPI_UNSIGNED, my_rank - 1, 6, my_sys->world,
-                          &rq_take_down);
-            }
-
-            // Recv Takes
-            if (my_rank != 0) {
-                MPI_Probe(my_rank - 1, 5, my_sys->world, &recv_status_take_down);
-                MPI_Get_count(&recv_status_take_down, MPI_UNSIGNED, &num_recv_take_down);
-                recv_take_down = new uint[num_recv_take_down];
-                MPI_Recv(recv_take_down, num_recv_take_down, MPI_UNSIGNED, my_rank - 1, 5, my_sys->world,
-                         &recv_status_take_down);
-            }
-            if (my_rank != num_ranks - 1) {
-                MPI_Probe(my_rank + 1, 6, my_sys->world, &recv_status_take_up);
-                MPI_Get_count(&recv_status_take_up, MPI_UNSIGNED, &num_recv_take_up);
-                recv_take_up = new uint[num_recv_take_up];
-                MPI_Recv(recv_take_up, num_recv_take_up, MPI_UNSIGNED, my_rank + 1, 6, my_sys->world,
-                         &recv_status_take_up);
-            }
-
-            // Make sure all non-blocking communications are done.
-            if (my_rank != num_ranks - 1) {
-                MPI_Wait(&rq_exchange_up, MPI_STATUS_IGNORE);
-                MPI_Wait(&rq_update_up, MPI_STATUS_IGNORE);
-                MPI_Wait(&rq_take_up, MPI_STATUS_IGNORE);
-            }
-            if (my_rank != 0) {
-                MPI_Wait(&rq_exchange_down, MPI_STATUS_IGNORE);
-                MPI_Wait(&rq_update_down, MPI_STATUS_IGNORE);
-                MPI_Wait(&rq_take_down, MPI_STATUS_IGNORE);
-            }
-        }  // End of send/recv section
-
-// TODO could do in parallel if counting the spaces in the buffers in the first pass
-// Pack Shapes Up
-#pragma omp section
-        {
-            for (auto itr_up = exchanges_up.begin(); itr_up != exchanges_up.end(); itr_up++) {
-                num_shapes_up += PackShapes(&shapes_up, *itr_up);
+            } else if (have & bit) {
+                // The body left the ghost region of the neighbor
+                BodyUpdate b_ut;
+                PackUpdateTake(&b_ut, i);
+                send_msg[n].updates.push_back(b_ut);
             }
+        }
 
-            if (num_shapes_up == 0) {
-                Shape shape;
-                shape.gid = UINT_MAX;
-                shapes_up.push_back(shape);
-                num_shapes_up = 1;
+        if (new_owner == -1) {
+            ddm->ghost_mask[i] = need;
+            ddm->comm_status[i] = need ? distributed::SHARED : distributed::OWNED;
+        } else {
+            // Keep a ghost only if the body is still in this rank's ghost region
+            ddm->ghost_mask[i] = 0;
+            if (domain->InGhostRegion(coords.x(), coords.y(), coords.z(), pos)) {
+                ddm->comm_status[i] = distributed::GHOST;
+            } else {
+                my_sys->RemoveBodyExchange(i);
             }
-        }  // End of pack shapes up section
+        }
+    }
 
-// Pack Shapes Down
-#pragma omp section
-        {
-            for (auto itr_down = exchanges_down.begin(); itr_down != exchanges_down.end(); itr_down++) {
-                num_shapes_down += PackShapes(&shapes_down, *itr_down);
-            }
-            if (num_shapes_down == 0) {
-                Shape shape;
-                shape.gid = UINT_MAX;
-                shapes_down.push_back(shape);
-                num_shapes_down = 1;
-            }
-        }  // End of pack shapes down section
-    }      // End of parallel sections
-
-    // TODO sections?
-    if (my_rank != 0)
-        ProcessExchanges(num_recv_exchange_down, recv_exchange_down, 0);
-    if (my_rank != num_ranks - 1)
-        ProcessExchanges(num_recv_exchange_up, recv_exchange_up, 1);
-    if (my_rank != 0)
-        ProcessUpdates(num_recv_update_down, recv_update_down);
-    if (my_rank != num_ranks - 1)
-        ProcessUpdates(num_recv_update_up, recv_update_up);
-    if (my_rank != 0)
-        ProcessTakes(num_recv_take_down, recv_take_down);
-    if (my_rank != num_ranks - 1)
-        ProcessTakes(num_recv_take_up, recv_take_up);
-
-    // Send Shapes
-    if (my_rank != num_ranks - 1) {
-        MPI_Isend(&(shapes_up[0]), num_shapes_up, ShapeType, my_rank + 1, 7, my_sys->world, &rq_shapes_up);
+    // Send the sizes of the messages, followed by the non-empty messages, to all neighbors
+    send_requests.assign(4 * num_neighbors, MPI_REQUEST_NULL);
+    for (int n = 0; n < num_neighbors; n++) {
+        ExchangeMessages& msg = send_msg[n];
+        msg.counts[0] = static_cast<int>(msg.exchanges.size());
+        msg.counts[1] = static_cast<int>(msg.updates.size());
+        msg.counts[2] = static_cast<int>(msg.shapes.size());
+
+        MPI_Isend(msg.counts, 3, MPI_INT, neighbors[n], 0, exchange_comm, &send_requests[4 * n]);
+        if (msg.counts[0])
+            MPI_Isend(msg.exchanges.data(), msg.counts[0], BodyExchangeType, neighbors[n], 1, exchange_comm,
+                      &send_requests[4 * n + 1]);
+        if (msg.counts[1])
+            MPI_Isend(msg.updates.data(), msg.counts[1], BodyUpdateType, neighbors[n], 2, exchange_comm,
+                      &send_requests[4 * n + 2]);
+        if (msg.counts[2])
+            MPI_Isend(msg.shapes.data(), msg.counts[2], ShapeType, neighbors[n], 3, exchange_comm,
+                      &send_requests[4 * n + 3]);
     }
-    if (my_rank != 0) {
-        MPI_Isend(&(shapes_down[0]), num_shapes_down, ShapeType, my_rank - 1, 8, my_sys->world, &rq_shapes_down);
+}
+
+void ChCommDistributed::CompleteExchange() {
+    const std::vector<int>& neighbors = my_sys->domain->GetNeighbors();
+    int num_neighbors = static_cast<int>(neighbors.size());
+
+    // As the sizes arrive from a neighbor, post the receives of its messages.
+    // The messages of a neighbor are processed as soon as they are all received.
+    std::vector<MPI_Request> data_requests(3 * num_neighbors, MPI_REQUEST_NULL);
+    std::vector<int> pending(num_neighbors, 0);
+    for (int k = 0; k < num_neighbors; k++) {
+        int n;
+        MPI_Waitany(num_neighbors, header_requests.data(), &n, MPI_STATUS_IGNORE);
+        ExchangeMessages& msg = recv_msg[n];
+        msg.exchanges.resize(msg.counts[0]);
+        msg.updates.resize(msg.counts[1]);
+        msg.shapes.resize(msg.counts[2]);
+
+        if (msg.counts[0])
+            MPI_Irecv(msg.exchanges.data(), msg.counts[0], BodyExchangeType, neighbors[n], 1, exchange_comm,
+                      &data_requests[3 * n]);
+        if (msg.counts[1])
+            MPI_Irecv(msg.updates.data(), msg.counts[1], BodyUpdateType, neighbors[n], 2, exchange_comm,
+                      &data_requests[3 * n + 1]);
+        if (msg.counts[2])
+            MPI_Irecv(msg.shapes.data(), msg.counts[2], ShapeType, neighbors[n], 3, exchange_comm,
+                      &data_requests[3 * n + 2]);
+
+        for (int t = 0; t < 3; t++) {
+            if (msg.counts[t])
+                pending[n]++;
+        }
     }
 
-    // Recv Shapes
-    if (my_rank != 0) {
-        MPI_Probe(my_rank - 1, 7, my_sys->world, &recv_status_shapes_down);
-        MPI_Get_count(&recv_status_shapes_down, ShapeType, &num_recv_shapes_down);
-        recv_shapes_down = new Shape[num_recv_shapes_down];
-        MPI_Recv(recv_shapes_down, num_recv_shapes_down, ShapeType, my_rank - 1, 7, my_sys->world,
-                 &recv_status_shapes_down);
+    for (int n = 0; n < num_neighbors; n++) {
+        if (pending[n] == 0)
+            ProcessMessages(recv_msg[n]);
     }
-    if (my_rank != num_ranks - 1) {
-        MPI_Probe(my_rank + 1, 8, my_sys->world, &recv_status_shapes_up);
-        MPI_Get_count(&recv_status_shapes_up, ShapeType, &num_recv_shapes_up);
-        ////GetLog() << "num_recv_shapes_up" << num_recv_shapes_up << "\n";
-        recv_shapes_up = new Shape[num_recv_shapes_up];
-        MPI_Recv(recv_shapes_up, num_recv_shapes_up, ShapeType, my_rank + 1, 8, my_sys->world, &recv_status_shapes_up);
+    while (true) {
+        int r;
+        MPI_Waitany(3 * num_neighbors, data_requests.data(), &r, MPI_STATUS_IGNORE);
+        if (r == MPI_UNDEFINED)
+            break;
+        if (--pending[r / 3] == 0)
+            ProcessMessages(recv_msg[r / 3]);
     }
 
-    if (my_rank != 0)
-        ProcessShapes(num_recv_shapes_down, recv_shapes_down);
-    if (my_rank != num_ranks - 1)
-        ProcessShapes(num_recv_shapes_up, recv_shapes_up);
+    // Make sure all non-blocking communications are done.
+    MPI_Waitall(static_cast<int>(send_requests.size()), send_requests.data(), MPI_STATUSES_IGNORE);
+}
 
-    if (my_rank != num_ranks - 1) {
-        MPI_Wait(&rq_shapes_up, MPI_STATUS_IGNORE);
-    }
-    if (my_rank != 0) {
-        MPI_Wait(&rq_shapes_down, MPI_STATUS_IGNORE);
-    }
+void ChCommDistributed::Exchange() {
+    std::vector<int> bodies(data_manager->num_rigid_bodies);
+    for (int i = 0; i < static_cast<int>(bodies.size()); i++)
+        bodies[i] = i;
+
+    PostReceives();
+    PostExchange(bodies);
+    CompleteExchange();
+}
 
-    // Free all dynamic memory used for recving
-    delete[] recv_exchange_down;
-    delete[] recv_exchange_up;
-    delete[] recv_update_down;
-    delete[] recv_update_up;
-    delete[] recv_take_down;
-    delete[] recv_take_up;
-    delete[] recv_shapes_down;
-    delete[] recv_shapes_up;
-
-    MPI_Barrier(my_sys->world);
+void ChCommDistributed::ProcessMessages(ExchangeMessages& msg) {
+    // New ghosts must exist before they are updated (or given) and receive their shapes.
+    // Updates also remove the ghosts which are no longer needed.
+    // A neighbor only sends messages about the bodies it owns, so the messages of
+    // different neighbors can be processed in any order.
+    ProcessExchanges(msg.counts[0], msg.exchanges.data());
+    ProcessUpdates(msg.counts[1], msg.updates.data());
+    ProcessShapes(msg.counts[2], msg.shapes.data());
 }
 
 void ChCommDistributed::PackExchange(BodyExchange* buf, int index) {
@@ -692,18 +432,18 @@ void ChCommDistributed::PackExchange(BodyExchange* buf, int index) {
     // User-controlled identifier
     buf->identifier = my_sys->bodylist[index]->GetIdentifier();
 
-    // Position and rotation
-    real3 pos = data_manager->host_data.pos_rigid[index];
-    buf->pos[0] = pos.x;
-    buf->pos[1] = pos.y;
-    buf->pos[2] = pos.z;
+    // Position and rotation: the updated reference pose, which the existing ghosts of the body also hold
+    const ChVector<double>& pos = ddm->ref_pos[index];
+    buf->pos[0] = pos.x();
+    buf->pos[1] = pos.y();
+    buf->pos[2] = pos.z();
 
     // Rotation
-    quaternion rot = data_manager->host_data.rot_rigid[index];
-    buf->rot[0] = rot.w;
-    buf->rot[1] = rot.x;
-    buf->rot[2] = rot.y;
-    buf->rot[3] = rot.z;
+    const ChQuaternion<double>& rot = ddm->ref_rot[index];
+    buf->rot[0] = rot.e0();
+    buf->rot[1] = rot.e1();
+    buf->rot[2] = rot.e2();
+    buf->rot[3] = rot.e3();
 
     // Velocity
     buf->vel[0] = data_manager->host_data.v[index * 6];
@@ -823,35 +563,46 @@ void ChCommDistributed::PackUpdate(BodyUpdate* buf, int index, int update_type)
     // Global Id
     buf->gid = ddm->global_id[index];
 
-    // Position
-    buf->pos[0] = data_manager->host_data.pos_rigid[index].x;
-    buf->pos[1] = data_manager->host_data.pos_rigid[index].y;
-    buf->pos[2] = data_manager->host_data.pos_rigid[index].z;
+    // Position and rotation, as the change from the reference pose. The reference pose is advanced by
+    // the rounded change, exactly as on the receiving ranks, so the rounding errors do not accumulate.
+    real3 pos = data_manager->host_data.pos_rigid[index];
+    ChVector<double> dpos = ChVector<double>(pos.x, pos.y, pos.z) - ddm->ref_pos[index];
+    for (int k = 0; k < 3; k++) {
+        buf->dpos[k] = static_cast<float>(dpos[k]);
+        ddm->ref_pos[index][k] += buf->dpos[k];
+    }
 
-    // Rotation
-    buf->rot[0] = data_manager->host_data.rot_rigid[index].w;
-    buf->rot[1] = data_manager->host_data.rot_rigid[index].x;
-    buf->rot[2] = data_manager->host_data.rot_rigid[index].y;
-    buf->rot[3] = data_manager->host_data.rot_rigid[index].z;
+    quaternion rot = data_manager->host_data.rot_rigid[index];
+    ChQuaternion<double> drot = ChQuaternion<double>(rot.w, rot.x, rot.y, rot.z) - ddm->ref_rot[index];
+    for (int k = 0; k < 4; k++) {
+        buf->drot[k] = static_cast<float>(drot[k]);
+        ddm->ref_rot[index][k] += buf->drot[k];
+    }
 
     // Velocity
-    buf->vel[0] = data_manager->host_data.v[index * 6];
-    buf->vel[1] = data_manager->host_data.v[index * 6 + 1];
-    buf->vel[2] = data_manager->host_data.v[index * 6 + 2];
+    buf->vel[0] = static_cast<float>(data_manager->host_data.v[index * 6]);
+    buf->vel[1] = static_cast<float>(data_manager->host_data.v[index * 6 + 1]);
+    buf->vel[2] = static_cast<float>(data_manager->host_data.v[index * 6 + 2]);
 
     // Angular Velocity
     ChVector<> omega((*data_manager->body_list)[index]->GetWvel_par());
-    buf->vel[3] = omega.x();
-    buf->vel[4] = omega.y();
-    buf->vel[5] = omega.z();
+    buf->vel[3] = static_cast<float>(omega.x());
+    buf->vel[4] = static_cast<float>(omega.y());
+    buf->vel[5] = static_cast<float>(omega.z());
 }
 
-void ChCommDistributed::UnpackUpdate(BodyUpdate* buf, std::shared_ptr<ChBody> body) {
+void ChCommDistributed::UnpackUpdate(BodyUpdate* buf, int index) {
+    std::shared_ptr<ChBody> body = (*data_manager->body_list)[index];
+
     // Position
-    body->SetPos(ChVector<double>(buf->pos[0], buf->pos[1], buf->pos[2]));
+    for (int k = 0; k < 3; k++)
+        ddm->ref_pos[index][k] += buf->dpos[k];
+    body->SetPos(ddm->ref_pos[index]);
 
     // Rotation
-    body->SetRot(ChQuaternion<double>(buf->rot[0], buf->rot[1], buf->rot[2], buf->rot[3]));
+    for (int k = 0; k < 4; k++)
+        ddm->ref_rot[index][k] += buf->drot[k];
+    body->SetRot(ddm->ref_rot[index].GetNormalized());
 
     // Linear Velocity
     body->SetPos_dt(ChVector<double>(buf->vel[0], buf->vel[1], buf->vel[2]));
@@ -923,6 +674,8 @@ int ChCommDistributed::PackShapes(std::vector<Shape>* buf, int index) {
     return shape_count;
 }
 
-inline void ChCommDistributed::PackUpdateTake(uint* buf, int index) {
-    *buf = ddm->global_id[index];
+inline void ChCommDistributed::PackUpdateTake(BodyUpdate* buf, int index) {
+    *buf = {};
+    buf->gid = ddm->global_id[index];
+    buf->update_type = distributed::FINAL_UPDATE_TAKE;
 }
\ No newline at end of file
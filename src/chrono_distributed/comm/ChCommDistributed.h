@@ -15,6 +15,7 @@
 #pragma once
 
 #include <memory>
+#include <vector>
 
 #include "chrono/physics/ChBody.h"
 
@@ -55,13 +56,15 @@ typedef struct BodyExchange {
 /// @addtogroup distributed_comm
 /// @{
 
-/// Structure of data for sending an update of an existing body to a rank
+/// Structure of data for sending an update of an existing body to a rank.
+/// The pose is sent as the change from the reference pose of the body (see ChDistributedDataManager::ref_pos),
+/// in single precision as are the velocities.
 typedef struct BodyUpdate {
     uint gid;
     int update_type;
-    double pos[3];
-    double rot[4];
-    double vel[6];
+    float dpos[3];
+    float drot[4];
+    float vel[6];
 } BodyUpdate;
 /// @} distributed_comm
 
@@ -87,17 +90,20 @@ typedef struct Shape {
 /// creation of a ghost. The class also decides how to update the comm_status of
 /// each body based on its position and its comm_status.
 ///
-/// Actions:
+/// Each rank exchanges messages with all of its (up to 26) neighbors in the sub-domain grid.
+/// Only the owner of a body sends messages about it, based on the neighbors whose ghost regions contain it.
 ///
-/// A body with an OWNED comm_status will be packed for exchange to create a ghost body on another rank when it
-/// passes into one of this rank's shared regions, at which point the body is given a SHARED comm_status on this rank.
+/// Actions:
 ///
-/// A body with a SHARED comm_status will become OWNED when it moves into the owned region on this rank.
-/// A body with a SHARED comm_status will become GHOST when it crosses subhi or sublo and the other rank will change its
-/// comm_status for the body to SHARED.
+/// A body with an OWNED or SHARED comm_status is packed for exchange to create a ghost body on each neighbor
+/// whose ghost region it enters, and sent to update the ghosts on the neighbors whose ghost regions it remains in.
+/// The ghosts on the neighbors whose ghost regions it leaves are removed with a take update.
+/// Material and shape data are only sent with the exchange which creates a ghost.
+/// The body is SHARED while it has ghosts and OWNED otherwise.
 ///
-/// A body with a GHOST comm_status will become OWNED when it moves into the owned region of this rank.
-/// A body with a GHOST comm_status will be removed when it moves into the one of this rank's unowned regions.
+/// A body with an OWNED or SHARED comm_status which leaves this rank's sub-domain is given to the neighbor whose
+/// sub-domain it entered, which turns its ghost into the body. This rank keeps a GHOST of the body
+/// if it is still in its ghost region.
 class CH_DISTR_API ChCommDistributed {
   public:
     ChCommDistributed(ChSystemDistributed* my_sys);
@@ -107,10 +113,25 @@ class CH_DISTR_API ChCommDistributed {
     ///	- need to be sent to another rank to create ghosts
     /// - need to be sent to another rank to update ghosts
     ///	- need to update their comm_status
-    /// Sends updates via mpi to the appropriate rank
-    /// Processes incoming updates from other ranks
+    /// Sends updates via mpi to the neighbor ranks
+    /// Processes incoming updates from the neighbor ranks
+    /// Equivalent to PostReceives, PostExchange for all bodies and CompleteExchange.
     void Exchange();
 
+    /// First phase of a split-phase exchange: posts the receives for the messages from the neighbor ranks.
+    void PostReceives();
+
+    /// Second phase of a split-phase exchange: packs the bodies with the given local indices, updates
+    /// their comm_status, and starts sending the messages to the neighbor ranks.
+    /// The bodies must include all those owned by this rank which are in or may enter the ghost regions
+    /// of the neighbors, and their states must be final for the step. Other bodies are not accessed,
+    /// so they can be advanced while the messages are in transit.
+    void PostExchange(const std::vector<int>& bodies);
+
+    /// Last phase of a split-phase exchange: completes the receives, processing the messages of each
+    /// neighbor as soon as they have arrived, and waits for the sends to complete.
+    void CompleteExchange();
+
   protected:
     ChSystemDistributed* my_sys;
 
@@ -125,16 +146,32 @@ class CH_DISTR_API ChCommDistributed {
     /// Set of data for scaffolding on top of chrono::parallel
     ChDistributedDataManager* ddm;
 
+    /// Communicator used for the exchange messages only
+    MPI_Comm exchange_comm;
+
   private:
+    /// Messages exchanged with one neighbor rank
+    struct ExchangeMessages {
+        int counts[3];                        ///< number of new bodies, updates and shapes
+        std::vector<BodyExchange> exchanges;  ///< new ghost bodies
+        std::vector<BodyUpdate> updates;      ///< updates and removals of ghost bodies
+        std::vector<Shape> shapes;            ///< collision shapes of the new ghost bodies
+    };
+
+    std::vector<ExchangeMessages> send_msg;    ///< outgoing messages, per neighbor
+    std::vector<ExchangeMessages> recv_msg;    ///< incoming messages, per neighbor
+    std::vector<MPI_Request> send_requests;    ///< requests of the outgoing messages
+    std::vector<MPI_Request> header_requests;  ///< requests of the incoming message sizes
+
+    /// Processes all incoming messages from one neighbor.
+    void ProcessMessages(ExchangeMessages& msg);
+
     /// Helper function for processing incoming exchange messages.
-    void ProcessExchanges(int num_recv, BodyExchange* buf, int updown);
+    void ProcessExchanges(int num_recv, BodyExchange* buf);
 
     /// Helper function for processing incoming update messages.
     void ProcessUpdates(int num_recv, BodyUpdate* buf);
 
-    /// Helper function for processing incoming take messages.
-    void ProcessTakes(int num_recv, uint* buf);
-
     /// Helper function for processing incoming shape messages.
     void ProcessShapes(int num_recv, Shape* buf);
 
@@ -148,11 +185,11 @@ class CH_DISTR_API ChCommDistributed {
     /// Packs a body to be sent to update its ghost on another rank
     void PackUpdate(BodyUpdate* buf, int index, int update_type);
 
-    /// Unpacks an incoming body to update a ghost
-    void UnpackUpdate(BodyUpdate* buf, std::shared_ptr<ChBody> body);
+    /// Unpacks an incoming body to update the ghost at index
+    void UnpackUpdate(BodyUpdate* buf, int index);
 
-    /// Packs the gid of the body at index index into buf
-    void PackUpdateTake(uint* buf, int index);
+    /// Packs the removal of the ghosts of the body at index into buf
+    void PackUpdateTake(BodyUpdate* buf, int index);
 
     /// Packs all shapes for the body at index into buf and returns
     /// the number of shapes that it has packed.
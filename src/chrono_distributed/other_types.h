@@ -22,16 +22,13 @@ namespace distributed {
 
 /// Location and status of a given body with respect to this rank
 typedef enum COMM_STATUS {
-    EMPTY = 0,         /// None, empty, disabled
-    OWNED = 1,         /// exclusive to this rank
-    GHOST_UP = 2,      /// a proxy for a body on high neighbor rank
-    GHOST_DOWN = 3,    /// a proxy for a body on low neighbor rank
-    SHARED_UP = 4,     /// has a proxy body on high neighbor rank
-    SHARED_DOWN = 5,   /// has a proxy body on low neighbor rank
-    UNOWNED_UP = 6,    /// unrelated to this rank
-    UNOWNED_DOWN = 7,  /// unrelated to this rank
-    GLOBAL = 8,        /// Present on all ranks
-    UNDEFINED = 9
+    EMPTY = 0,    /// None, empty, disabled
+    OWNED = 1,    /// exclusive to this rank
+    GHOST = 2,    /// a proxy for a body owned by a neighbor rank
+    SHARED = 3,   /// owned by this rank, with proxies on neighbor ranks
+    UNOWNED = 4,  /// unrelated to this rank
+    GLOBAL = 5,   /// Present on all ranks
+    UNDEFINED = 6
 } COMM_STATUS;
 /// @} distributed_module
 
@@ -40,13 +37,23 @@ typedef enum COMM_STATUS {
 
 /// Types of internal message that can be sent
 typedef enum MESSAGE_TYPE {
-    EXCHANGE,              /// Introduction of new body to a rank
-    UPDATE,                /// Update for an existing body on a rank from the owning rank
-    FINAL_UPDATE_GIVE,     /// Update which ends in the other rank taking exclusive ownership
-    FINAL_UPDATE_TAKE,     /// Update which ends in this rank taking exclusive ownership
-    UPDATE_TRANSFER_SHARE  /// Update which updates the primary rank for the body
+    EXCHANGE,           /// Introduction of new body to a rank
+    UPDATE,             /// Update for an existing body on a rank from the owning rank
+    FINAL_UPDATE_GIVE,  /// Update which ends in the other rank taking exclusive ownership
+    FINAL_UPDATE_TAKE   /// Removal of a proxy body which is no longer needed on the other rank
 } MESSAGE_TYPE;
 /// @} distributed_module
 
+/// @addtogroup distributed_module
+/// @{
+
+/// Measure of the work done by each rank, used for balancing the sub-domains
+typedef enum LOAD_METRIC {
+    BODY_COUNT,     /// number of bodies (owned, shared and ghost) on the rank
+    CONTACT_COUNT,  /// number of rigid contacts found by the rank
+    STEP_TIME       /// measured wall time of the rank's dynamics, excluding communication
+} LOAD_METRIC;
+/// @} distributed_module
+
 }  // End namespace distributed
 }  // End namespace chrono
@@ -23,8 +23,12 @@
 
 #include <mpi.h>
 #include <stdlib.h>
+#include <algorithm>
+#include <cmath>
 #include <iostream>
 #include <memory>
+#include <numeric>
+#include <vector>
 
 using namespace chrono;
 
@@ -33,6 +37,11 @@ ChDomainDistributed::ChDomainDistributed(ChSystemDistributed* sys) {
     split_axis = 0;
     split = false;
     axis_set = false;
+    dims_set = false;
+    for (int i = 0; i < 3; i++) {
+        dims[i] = 1;
+        coords[i] = 0;
+    }
 }
 
 ChDomainDistributed::~ChDomainDistributed() {}
@@ -47,6 +56,32 @@ void ChDomainDistributed::SetSplitAxis(int i) {
     }
 }
 
+void ChDomainDistributed::SetDecomposition(int nx, int ny, int nz) {
+    assert(!split);
+    int num_ranks = my_sys->num_ranks;
+    int d[3] = {nx, ny, nz};
+
+    // The fixed entries must divide the number of ranks
+    int fixed = 1;
+    for (int i = 0; i < 3; i++) {
+        if (d[i] < 0)
+            my_sys->ErrorAbort("Invalid number of sub-domains.");
+        if (d[i] > 0)
+            fixed *= d[i];
+    }
+    if (num_ranks % fixed != 0)
+        my_sys->ErrorAbort("Number of sub-domains does not match the number of ranks.");
+
+    MPI_Dims_create(num_ranks, 3, d);
+    if (d[0] * d[1] * d[2] != num_ranks)
+        my_sys->ErrorAbort("Number of sub-domains does not match the number of ranks.");
+
+    for (int i = 0; i < 3; i++) {
+        dims[i] = d[i];
+    }
+    dims_set = true;
+}
+
 void ChDomainDistributed::SetSimDomain(double xlo, double xhi, double ylo, double yhi, double zlo, double zhi) {
     assert(!split);
 
@@ -60,104 +95,225 @@ void ChDomainDistributed::SetSimDomain(double xlo, double xhi, double ylo, doubl
     if (len_x <= 0 || len_y <= 0 || len_z <= 0)
         my_sys->ErrorAbort("Invalid domain dimensions.");
 
-    if (!axis_set) {
-        // Index of the longest domain axis 0=x, 1=y, 2=z
-        split_axis = (len_x >= len_y) ? 0 : 1;
-        split_axis = (len_z >= boxhi[split_axis] - boxlo[split_axis]) ? 2 : split_axis;
+    if (dims_set) {
+        // Axis with the most sub-domains
+        split_axis = (dims[0] >= dims[1]) ? 0 : 1;
+        split_axis = (dims[2] > dims[split_axis]) ? 2 : split_axis;
+    } else {
+        if (!axis_set) {
+            // Index of the longest domain axis 0=x, 1=y, 2=z
+            split_axis = (len_x >= len_y) ? 0 : 1;
+            split_axis = (len_z >= boxhi[split_axis] - boxlo[split_axis]) ? 2 : split_axis;
+        }
+        // Slabs along the split axis
+        dims[split_axis] = my_sys->num_ranks;
     }
 
     SplitDomain();
 }
 
 void ChDomainDistributed::SplitDomain() {
-    // Length of this subdomain along the long axis
-    double sub_len = (boxhi[split_axis] - boxlo[split_axis]) / my_sys->num_ranks;
+    int my_rank = my_sys->my_rank;
+    coords[0] = my_rank % dims[0];
+    coords[1] = (my_rank / dims[0]) % dims[1];
+    coords[2] = my_rank / (dims[0] * dims[1]);
 
-    for (int i = 0; i < 3; i++) {
-        if (split_axis == i) {
-            sublo[i] = boxlo[i] + my_sys->my_rank * sub_len;
-            subhi[i] = sublo[i] + sub_len;
-        } else {
-            sublo[i] = boxlo[i];
-            subhi[i] = boxhi[i];
+    for (int a = 0; a < 3; a++) {
+        // Length of each subdomain along this axis
+        double sub_len = (boxhi[a] - boxlo[a]) / dims[a];
+
+        split_bounds[a].resize(dims[a] + 1);
+        for (int i = 0; i < dims[a]; i++) {
+            split_bounds[a][i] = boxlo[a] + i * sub_len;
+        }
+        split_bounds[a][dims[a]] = boxhi[a];
+    }
+
+    // Ranks of the sub-domains sharing a face, an edge or a corner with this one
+    neighbors.clear();
+    for (int k = coords[2] - 1; k <= coords[2] + 1; k++) {
+        for (int j = coords[1] - 1; j <= coords[1] + 1; j++) {
+            for (int i = coords[0] - 1; i <= coords[0] + 1; i++) {
+                if (i < 0 || i >= dims[0] || j < 0 || j >= dims[1] || k < 0 || k >= dims[2])
+                    continue;
+                int rank = GetRankAt(i, j, k);
+                if (rank != my_rank)
+                    neighbors.push_back(rank);
+            }
         }
     }
+
+    SetSubDomain();
     split = true;
 }
 
+void ChDomainDistributed::SetSubDomain() {
+    for (int a = 0; a < 3; a++) {
+        sublo[a] = split_bounds[a][coords[a]];
+        subhi[a] = split_bounds[a][coords[a] + 1];
+    }
+}
+
+void ChDomainDistributed::SetSplitBounds(int axis, const std::vector<double>& bounds) {
+    assert(split);
+    if (bounds.size() != split_bounds[axis].size() || !std::is_sorted(bounds.begin(), bounds.end())) {
+        my_sys->ErrorAbort("Invalid sub-domain boundaries\n");
+    }
+    split_bounds[axis] = bounds;
+    SetSubDomain();
+}
+
+int ChDomainDistributed::GetCoord(int axis, double x) const {
+    const std::vector<double>& bounds = split_bounds[axis];
+    // First interior boundary above the position
+    auto itr = std::upper_bound(bounds.begin() + 1, bounds.end() - 1, x);
+    return (int)(itr - (bounds.begin() + 1));
+}
+
 int ChDomainDistributed::GetRank(ChVector<double> pos) {
-    double sub_len = subhi[split_axis] - sublo[split_axis];
-    double pt = pos[split_axis] - boxlo[split_axis];
+    return GetRankAt(GetCoord(0, pos.x()), GetCoord(1, pos.y()), GetCoord(2, pos.z()));
+}
 
-    return (int)(pt / sub_len);
+int ChDomainDistributed::GetNeighborIndex(int rank) const {
+    auto itr = std::find(neighbors.begin(), neighbors.end(), rank);
+    return (itr == neighbors.end()) ? -1 : (int)(itr - neighbors.begin());
 }
 
-distributed::COMM_STATUS ChDomainDistributed::GetRegion(double pos) {
+bool ChDomainDistributed::InGhostRegion(int i, int j, int k, const ChVector<double>& pos) const {
+    double ghost_layer = my_sys->GetGhostLayer();
+    int c[3] = {i, j, k};
+    for (int a = 0; a < 3; a++) {
+        if (c[a] > 0 && pos[a] < split_bounds[a][c[a]] - ghost_layer)
+            return false;
+        if (c[a] < dims[a] - 1 && pos[a] >= split_bounds[a][c[a] + 1] + ghost_layer)
+            return false;
+    }
+    return true;
+}
+
+bool ChDomainDistributed::InBoundaryZone(const ChVector<double>& pos, double width) const {
+    for (int a = 0; a < 3; a++) {
+        if (coords[a] > 0 && pos[a] < split_bounds[a][coords[a]] + width)
+            return true;
+        if (coords[a] < dims[a] - 1 && pos[a] >= split_bounds[a][coords[a] + 1] - width)
+            return true;
+    }
+    return false;
+}
+
+unsigned int ChDomainDistributed::GetGhostMask(ChVector<double> pos) {
+    unsigned int mask = 0;
+    for (int n = 0; n < (int)neighbors.size(); n++) {
+        int rank = neighbors[n];
+        int i = rank % dims[0];
+        int j = (rank / dims[0]) % dims[1];
+        int k = rank / (dims[0] * dims[1]);
+        if (InGhostRegion(i, j, k, pos))
+            mask |= 1u << n;
+    }
+    return mask;
+}
+
+bool ChDomainDistributed::Rebalance(double load, double tolerance) {
+    assert(split);
     int num_ranks = my_sys->num_ranks;
     if (num_ranks == 1) {
-        return distributed::OWNED;
+        return false;
     }
-    int my_rank = my_sys->my_rank;
+
+    std::vector<double> loads(num_ranks);
+    MPI_Allgather(&load, 1, MPI_DOUBLE, loads.data(), 1, MPI_DOUBLE, my_sys->world);
+
+    // All ranks work on the same gathered values and therefore compute the same boundaries.
+    double total = std::accumulate(loads.begin(), loads.end(), 0.0);
+    double max_load = *std::max_element(loads.begin(), loads.end());
+    if (total <= 0 || max_load <= tolerance * total / num_ranks) {
+        return false;
+    }
+
     double ghost_layer = my_sys->GetGhostLayer();
-    double high = subhi[split_axis];
-    double low = sublo[split_axis];
-
-    if (my_rank != 0 && my_rank != num_ranks - 1) {
-        if (pos >= low + ghost_layer && pos < high - ghost_layer) {
-            return distributed::OWNED;
-        } else if (pos >= high && pos < high + ghost_layer) {
-            return distributed::GHOST_UP;
-        } else if (pos >= high - ghost_layer && pos < high) {
-            return distributed::SHARED_UP;
-        } else if (pos >= low && pos < low + ghost_layer) {
-            return distributed::SHARED_DOWN;
-        } else if (pos >= low - ghost_layer && pos < low) {
-            return distributed::GHOST_DOWN;
-        } else if (pos >= high + ghost_layer) {
-            return distributed::UNOWNED_UP;
-        } else if (pos < low - ghost_layer) {
-            return distributed::UNOWNED_DOWN;
+    double max_shift = 0.5 * ghost_layer;
+    double min_len = 2 * ghost_layer;
+
+    std::vector<double> bounds[3];
+    bool moved = false;
+    for (int a = 0; a < 3; a++) {
+        bounds[a] = split_bounds[a];
+        int n = dims[a];
+        if (n == 1)
+            continue;
+
+        // Load of each layer of sub-domains along this axis
+        std::vector<double> layer_loads(n, 0.0);
+        for (int rank = 0; rank < num_ranks; rank++) {
+            int c[3] = {rank % dims[0], (rank / dims[0]) % dims[1], rank / (dims[0] * dims[1])};
+            layer_loads[c[a]] += loads[rank];
         }
-    }
 
-    else if (my_rank == 0) {
-        if (pos >= low && pos < high - ghost_layer) {
-            return distributed::OWNED;
-        } else if (pos >= high && pos < high + ghost_layer) {
-            return distributed::GHOST_UP;
-        } else if (pos >= high - ghost_layer && pos < high) {
-            return distributed::SHARED_UP;
-        } else if (pos >= high + ghost_layer) {
-            return distributed::UNOWNED_UP;
-        } else if (pos < low) {
-            return distributed::UNOWNED_DOWN;
+        // Place each interior boundary at its share of the cumulative load, assuming
+        // the load of a layer is spread uniformly over its length.
+        const std::vector<double>& old_bounds = split_bounds[a];
+        int r = 0;
+        double cumulative = 0;
+        for (int j = 1; j < n; j++) {
+            double target = j * total / n;
+            while (r < n - 1 && cumulative + layer_loads[r] <= target) {
+                cumulative += layer_loads[r];
+                r++;
+            }
+            double frac = (layer_loads[r] > 0) ? std::min((target - cumulative) / layer_loads[r], 1.0) : 0.0;
+            double pos = old_bounds[r] + frac * (old_bounds[r + 1] - old_bounds[r]);
+
+            bounds[a][j] = std::max(old_bounds[j] - max_shift, std::min(old_bounds[j] + max_shift, pos));
         }
-    }
 
-    else if (my_rank == num_ranks - 1) {
-        if (pos >= low + ghost_layer && pos < high) {
-            return distributed::OWNED;
-        } else if (pos >= low && pos < low + ghost_layer) {
-            return distributed::SHARED_DOWN;
-        } else if (pos >= low - ghost_layer && pos < low) {
-            return distributed::GHOST_DOWN;
-        } else if (pos >= high) {
-            return distributed::UNOWNED_UP;
-        } else if (pos < low - ghost_layer) {
-            return distributed::UNOWNED_DOWN;
+        // Keep every sub-domain longer than two ghost layers so that bodies are only
+        // shared with neighbor sub-domains.
+        for (int j = 1; j < n; j++) {
+            bounds[a][j] = std::max(bounds[a][j], bounds[a][j - 1] + min_len);
         }
+        for (int j = n - 1; j > 0; j--) {
+            bounds[a][j] = std::min(bounds[a][j], bounds[a][j + 1] - min_len);
+        }
+        for (int j = 1; j <= n; j++) {
+            if (bounds[a][j] - bounds[a][j - 1] < min_len ||
+                std::abs(bounds[a][j] - old_bounds[j]) > 1.001 * max_shift) {
+                bounds[a] = old_bounds;
+                break;
+            }
+        }
+        moved = moved || bounds[a] != old_bounds;
+    }
+
+    if (!moved) {
+        return false;
     }
 
-    GetLog() << "Error classifying body\n";
-    return distributed::UNDEFINED;
+    for (int a = 0; a < 3; a++) {
+        split_bounds[a] = bounds[a];
+    }
+    SetSubDomain();
+    return true;
+}
+
+distributed::COMM_STATUS ChDomainDistributed::GetRegion(const ChVector<double>& pos) {
+    int my_rank = my_sys->my_rank;
+    if (GetRank(pos) == my_rank) {
+        return GetGhostMask(pos) ? distributed::SHARED : distributed::OWNED;
+    }
+    if (InGhostRegion(coords[0], coords[1], coords[2], pos)) {
+        return distributed::GHOST;
+    }
+    return distributed::UNOWNED;
 }
 
 distributed::COMM_STATUS ChDomainDistributed::GetBodyRegion(int index) {
-    return GetRegion(my_sys->data_manager->host_data.pos_rigid[index][split_axis]);
+    real3 pos = my_sys->data_manager->host_data.pos_rigid[index];
+    return GetRegion(ChVector<double>(pos.x, pos.y, pos.z));
 }
 
 distributed::COMM_STATUS ChDomainDistributed::GetBodyRegion(std::shared_ptr<ChBody> body) {
-    return GetRegion(body->GetPos()[split_axis]);
+    return GetRegion(body->GetPos());
 }
 
 void ChDomainDistributed::PrintDomain() {
@@ -171,9 +327,12 @@ void ChDomainDistributed::PrintDomain() {
              << "\n"
                 "\tZ: "
              << boxlo.z() << " to " << boxhi.z()
+             << "\n"
+                "Grid: "
+             << dims[0] << " x " << dims[1] << " x " << dims[2]
              << "\n"
                 "Subdomain: Rank "
-             << my_sys->my_rank
+             << my_sys->my_rank << " (" << coords[0] << ", " << coords[1] << ", " << coords[2] << ")"
              << "\n"
                 "\tX: "
              << sublo.x() << " to " << subhi.x()
@@ -15,6 +15,7 @@
 #pragma once
 
 #include <memory>
+#include <vector>
 
 #include "chrono/core/ChVector.h"
 #include "chrono/physics/ChBody.h"
@@ -31,80 +32,39 @@ class ChSystemDistributed;
 /// @{
 
 /// This class maps sub-domains of the global simulation domain to each MPI rank.
-/// The global domain is split along the longest axis.
-/// Within each sub-domain, there are layers of ownership:
+/// The global domain is divided by a Cartesian grid of nx * ny * nz axis-aligned boxes,
+/// one per rank. By default, the grid has a single layer of boxes (slabs) along the longest axis.
+/// Rank r has grid coordinates (i, j, k) with r = i + nx * (j + ny * k).
+/// The neighbors of a rank are the (up to 26) ranks whose boxes share a face, an edge or a corner with its box.
+/// Boxes on the boundary of the global domain extend to infinity beyond it.
 ///
+/// Each body is owned by the rank whose box contains its center. The ghost region of a rank is its box
+/// expanded by the ghost layer on every face that is interior to the global domain. A body whose center is in
+/// the ghost region of neighbor ranks has a proxy (ghost) on each of those ranks:
 ///
-/// 0 < RANK < NUM_RANKS - 1:
-///
-/// Unowned_up (high + ghostlayer <= pos)
-/// Ghost_up (high <= pos < high + ghostlayer)
-/// Shared_up (high - ghostlayer <= pos < high)
-/// Owned (low + ghostlayer <= pos < high - ghostlayer)
-/// Shared_down (low <= pos < low + ghostlayer)
-/// Ghost_down (low - ghost_layer <= pos < low)
-/// Unowned_down (pos < low - ghostlayer)
-///
-///
-/// RANK = 0:
-///
-/// Unowned_up (high + ghostlayer <= pos)
-/// Ghost_up (high <= pos < high + ghostlayer)
-/// Shared_up (high - ghostlayer <= pos < high)
-/// Owned (low <= pos < high - ghostlayer)
-/// Unowned_down (pos < low)
-///
-///
-/// RANK = NUM_RANKS - 1:
-///
-/// Unowned_up (high <= pos)
-/// Owned (low + ghostlayer <= pos < high)
-/// Shared_down (low <= pos < low + ghostlayer)
-/// Ghost_down (low - ghost_layer <= pos < low)
-/// Unowned_down (pos < low - ghostlayer)
-///
-///
-/// At AddBody:
-/// ** Unowned_up/Unowned_down:
-/// 		Bodies in this region do not interact with this rank
-/// ** Ghost_up/Ghost_down:
-/// 		Bodies in these regions are added to this rank, and expect to be updated
-/// 		by a neighbor rank every timestep
-/// ** Shared_up/Shared_down:
-/// 		Bodies in these regions are added to this rank, and send updates to a neighbor
-/// 		rank every timestep
-/// ** Owned:
-/// 		Bodies in this region are added to this rank only and have no interaction with other ranks.
-///
-///
-/// Mid-Simulation:
-/// ** Unowned_up/Unowned_down:
-/// 		Bodies in these regions do not interact with this rank
-/// ** Ghost_up/Ghost_down:
-/// 		--If a body in one of these regions was most recently in this rank, it will be simulated on this
-/// 		rank and sent to update a ghost body on a neighbor rank every timestep.
-/// 		--If a body in one of these regions was most recently in another rank, it will be simulated on this
-/// 		rank and will be updated by a neighbor rank every timestep.
-/// ** Shared_up/Shared_down:
-/// 		--If a body in one of these regions was most recently in this rank, it will be simulated on this
-/// 		rank and sent to update a ghost body on a neighbor rank every timestep.
-/// 		--If a body in one of these regions was most recently in another rank, it will be simulated on this
-/// 		rank and will be updated by a neighbor rank every timestep.
 /// ** Owned:
-/// 		Bodies in this region are simulated only on this rank.
-///
-///
-/// Actions:
-///
-/// A body with an OWNED comm_status will be packed for exchange to create a ghost body on another rank when it
-/// passes into one of this rank's shared regions, at which point the body is given a SHARED comm_status on this rank.
-///
-/// A body with a SHARED comm_status will become OWNED when it moves into the owned region on this rank.
-/// A body with a SHARED comm_status will become GHOST when it moves outside of [sublo, subhi), the other rank
-/// updates its comm_status for that body to SHARED and takes charge of updating the body.
-///
-/// A body with a GHOST comm_status will become OWNED when it moves into the owned region of this rank.
-/// A body with a GHOST comm_status will be removed when it moves into the one of this rank's unowned regions.
+/// 		The body is in this rank's box and in no neighbor's ghost region. It is simulated only on this rank.
+/// ** Shared:
+/// 		The body is in this rank's box and in the ghost region of at least one neighbor. It is simulated on
+/// 		this rank, which sends its state to update the ghosts on those neighbors every timestep.
+/// ** Ghost:
+/// 		The body is in a neighbor's box and in this rank's ghost region. It is updated by the owning neighbor
+/// 		every timestep.
+/// ** Unowned:
+/// 		The body does not interact with this rank.
+///
+/// A body crossing a face, an edge or a corner of this rank's box changes owner: the owner hands the body
+/// over to the neighbor whose box now contains it and keeps a ghost if the body is still in its ghost region.
+/// A body can move into the box of a neighbor only, so bodies must move less than the ghost layer per
+/// step and every box must be at least twice as long as the ghost layer.
+///
+///
+/// Load balancing:
+///
+/// The boxes are initially of equal size. Rebalance moves the grid planes between boxes so that the load measured
+/// on each rank is evened out. A plane moves by at most half of the ghost layer per call, so that to
+/// ChCommDistributed a plane shift looks like the motion of the bodies near it: the next Exchange migrates them.
+/// NOTE: Fixed bodies added with GLOBAL status are kept only on the ranks they intersected when added.
 class CH_DISTR_API ChDomainDistributed {
   public:
     ChDomainDistributed(ChSystemDistributed* sys);
@@ -131,14 +91,58 @@ class CH_DISTR_API ChDomainDistributed {
     /// Get the upper bounds of the local sub-domain
     ChVector<double> GetSubHi() { return subhi; }
 
-    /// Sets the axis along which the domain will be split x=0, y=1, z=2
+    /// Sets the axis along which the domain will be split into slabs x=0, y=1, z=2
     void SetSplitAxis(int i);
-    /// x = 0, y = 1, z = 2
+    /// Returns the axis with the most sub-domains x = 0, y = 1, z = 2
     int GetSplitAxis() { return split_axis; }
 
+    /// Sets the number of sub-domains along each axis. The product must equal the number of ranks.
+    /// As for MPI_Dims_create, entries equal to 0 are filled in with a balanced factorization.
+    /// Must be called before SetSimDomain.
+    void SetDecomposition(int nx, int ny, int nz);
+    /// Returns the number of sub-domains along each axis
+    ChVector<int> GetDecomposition() { return ChVector<int>(dims[0], dims[1], dims[2]); }
+    /// Returns the grid coordinates of this rank's sub-domain
+    ChVector<int> GetGridCoords() { return ChVector<int>(coords[0], coords[1], coords[2]); }
+
     /// Returns the rank which has ownership of a body with the given position
     int GetRank(ChVector<double> pos);
 
+    /// Returns the ranks of all neighbors of this rank.
+    /// The index of a rank in this list is its neighbor index.
+    const std::vector<int>& GetNeighbors() const { return neighbors; }
+
+    /// Returns the neighbor index of the given rank, or -1 if the rank is not a neighbor.
+    int GetNeighborIndex(int rank) const;
+
+    /// Returns a mask with bit n set if the ghost region of neighbor n contains the given position.
+    unsigned int GetGhostMask(ChVector<double> pos);
+
+    /// Returns true if the ghost region of the sub-domain with the given grid coordinates contains pos.
+    /// Sub-domains on the boundary of the global domain extend to infinity beyond it.
+    bool InGhostRegion(int i, int j, int k, const ChVector<double>& pos) const;
+
+    /// Returns true if pos is within the given distance of a face this rank's sub-domain shares
+    /// with a neighbor, or outside of the sub-domain.
+    bool InBoundaryZone(const ChVector<double>& pos, double width) const;
+
+    /// Returns the boundaries of all sub-domains along the given axis.
+    /// Sub-domains with grid coordinate i along the axis span [bounds[i], bounds[i+1]).
+    const std::vector<double>& GetSplitBounds(int axis) const { return split_bounds[axis]; }
+
+    /// Replaces the boundaries of all sub-domains along the given axis, e.g. to restore the
+    /// boundaries of a load-balanced run. There must be one more bound than sub-domains along the axis.
+    void SetSplitBounds(int axis, const std::vector<double>& bounds);
+
+    /// Moves the sub-domain boundaries towards an even distribution of the load.
+    /// Must be called on all ranks with the load measured on the calling rank.
+    /// Along each divided axis, the loads of the layers of sub-domains are assumed uniformly
+    /// distributed within each layer and the new boundaries are placed at equal quantiles of
+    /// the cumulative load, limited to a shift of half the ghost layer and a sub-domain length
+    /// of at least two ghost layers. No boundary is moved unless the ratio of the largest to
+    /// the average load exceeds the given tolerance. Returns true if the boundaries were moved.
+    virtual bool Rebalance(double load, double tolerance);
+
     /// Returns true if the domain has been set.
     bool IsSplit() { return split; }
 
@@ -153,19 +157,35 @@ class CH_DISTR_API ChDomainDistributed {
   protected:
     ChSystemDistributed* my_sys;
 
-    int split_axis;  ///< Index of the dimension of the longest edge of the global domain
+    int split_axis;  ///< Index of the dimension with the most sub-domains
 
-    /// Divides the domain into equal-volume, orthogonal, axis-aligned regions along
-    /// the longest axis. Needs to be called right after the system is created so that
+    int dims[3];    ///< Number of sub-domains along each axis
+    int coords[3];  ///< Grid coordinates of this rank's sub-domain
+
+    /// Divides the domain into equal-volume, orthogonal, axis-aligned regions.
+    /// Needs to be called right after the system is created so that
     /// bodies are added correctly.
     virtual void SplitDomain();
     bool split;     ///< Flag indicating that the domain has been divided into sub-domains.
     bool axis_set;  ///< Flag indicating that the splitting axis has been set.
+    bool dims_set;  ///< Flag indicating that the number of sub-domains per axis has been set.
+
+    std::vector<double> split_bounds[3];  ///< Boundaries of the sub-domains along each axis
+    std::vector<int> neighbors;           ///< Ranks of the neighbors of this rank
+
+    /// Sets sublo and subhi from the boundaries of this rank's sub-domain.
+    void SetSubDomain();
+
+    /// Returns the rank of the sub-domain with the given grid coordinates.
+    int GetRankAt(int i, int j, int k) const { return i + dims[0] * (j + dims[1] * k); }
+
+    /// Returns the grid coordinate along the given axis of the sub-domain containing x.
+    int GetCoord(int axis, double x) const;
 
   private:
     /// Helper function that is called by the public GetRegion methods to get
     /// the region classification for a body based on the center position.
-    distributed::COMM_STATUS GetRegion(double pos);
+    distributed::COMM_STATUS GetRegion(const ChVector<double>& pos);
 };
 /// @} distributed_physics
 
@@ -22,11 +22,16 @@
 #include <fstream>
 #include <iostream>
 #include <memory>
+#include <limits>
 #include <numeric>
+#include <sstream>
 #include <string>
+#include <unordered_set>
 
 #include "chrono/collision/ChCCollisionSystem.h"
 #include "chrono/physics/ChBody.h"
+#include "chrono/physics/ChMaterialSurfaceSMC.h"
+#include "chrono/utils/ChUtilsInputOutput.h"
 
 #include "chrono_distributed/ChDistributedDataManager.h"
 #include "chrono_distributed/collision/ChCollisionModelDistributed.h"
@@ -57,7 +62,14 @@ static void PrintNode(LocalShapeNode* node) {
 }
 
 ChSystemDistributed::ChSystemDistributed(MPI_Comm communicator, double ghostlayer, unsigned int maxobjects)
-    : ghost_layer(ghostlayer), master_rank(0), num_bodies_global(0) {
+    : ghost_layer(ghostlayer),
+      master_rank(0),
+      num_bodies_global(0),
+      balance_interval(0),
+      balance_metric(distributed::BODY_COUNT),
+      balance_tolerance(1.1),
+      balance_steps(0),
+      balance_time(0) {
     MPI_Comm_dup(communicator, &world);
     MPI_Comm_size(world, &num_ranks);
     MPI_Comm_rank(world, &my_rank);
@@ -76,6 +88,9 @@ ChSystemDistributed::ChSystemDistributed(MPI_Comm communicator, double ghostlaye
 
     ddm->global_id.reserve(init);
     ddm->comm_status.reserve(init);
+    ddm->ghost_mask.reserve(init);
+    ddm->ref_pos.reserve(init);
+    ddm->ref_rot.reserve(init);
     ddm->body_shapes.reserve(init);
     ddm->body_shape_start.reserve(init);
     ddm->body_shape_count.reserve(init);
@@ -121,24 +136,31 @@ ChSystemDistributed::~ChSystemDistributed() {
 }
 
 bool ChSystemDistributed::InSub(const ChVector<double>& pos) const {
-    int split_axis = domain->GetSplitAxis();
-
-    double pos_axis = pos[split_axis];
-    double lo = domain->sublo[split_axis];
-    double hi = domain->subhi[split_axis];
-
-    return (pos_axis >= lo - this->ghost_layer) && (pos_axis <= hi + this->ghost_layer);
+    ChVector<int> coords = domain->GetGridCoords();
+    return domain->InGhostRegion(coords.x(), coords.y(), coords.z(), pos);
 }
 
 bool ChSystemDistributed::Integrate_Y() {
     assert(domain->IsSplit());
     ddm->initial_add = false;
 
+    if (num_ranks != 1)
+        comm->PostReceives();
+
+    // The exchange is started in AdvanceRigidBodies
     bool ret = ChSystemParallelSMC::Integrate_Y();
     if (num_ranks != 1) {
+        // Communication within the step (rebalance, packing and posting of the exchange), not part of the load
+        double exchange_time = data_manager->system_timer.GetTime("Exchange");
+
         data_manager->system_timer.start("Exchange");
-        comm->Exchange();
+        comm->CompleteExchange();
         data_manager->system_timer.stop("Exchange");
+
+        if (balance_interval > 0) {
+            balance_time += data_manager->system_timer.GetTime("step") - exchange_time;
+            balance_steps++;
+        }
     }
 #ifdef DistrProfile
     PrintEfficiency();
@@ -146,6 +168,77 @@ bool ChSystemDistributed::Integrate_Y() {
     return ret;
 }
 
+void ChSystemDistributed::AdvanceRigidBodies() {
+    if (num_ranks == 1) {
+        ChSystemParallel::AdvanceRigidBodies();
+        return;
+    }
+
+    data_manager->system_timer.start("Exchange");
+    // Boundaries moved here are accounted for by the following exchange
+    if (balance_interval > 0 && balance_steps >= balance_interval) {
+        domain->Rebalance(GetLoad(), balance_tolerance);
+        balance_steps = 0;
+        balance_time = 0;
+    }
+
+    // Split the bodies into those which may have to be sent to a neighbor and the interior
+    // bodies, from their positions at the beginning of the step. Since bodies move less than
+    // the ghost layer in a step, only bodies with ghosts or within two ghost layers of a
+    // neighbor may enter a ghost region or leave the sub-domain.
+    std::vector<int> boundary;
+    std::vector<int> interior;
+    for (int i = 0; i < (int)data_manager->num_rigid_bodies; i++) {
+        if ((ddm->comm_status[i] == distributed::OWNED || ddm->comm_status[i] == distributed::SHARED) &&
+            (ddm->ghost_mask[i] != 0 || domain->InBoundaryZone(bodylist[i]->GetPos(), 2 * ghost_layer))) {
+            boundary.push_back(i);
+        } else {
+            interior.push_back(i);
+        }
+    }
+    data_manager->system_timer.stop("Exchange");
+
+#pragma omp parallel for
+    for (int k = 0; k < boundary.size(); k++) {
+        AdvanceRigidBody(boundary[k]);
+    }
+
+    // The messages are in transit while the interior bodies are advanced
+    data_manager->system_timer.start("Exchange");
+    comm->PostExchange(boundary);
+    data_manager->system_timer.stop("Exchange");
+
+#pragma omp parallel for
+    for (int k = 0; k < interior.size(); k++) {
+        AdvanceRigidBody(interior[k]);
+    }
+}
+
+void ChSystemDistributed::SetLoadBalancing(int interval, distributed::LOAD_METRIC metric, double tolerance) {
+    balance_interval = interval;
+    balance_metric = metric;
+    balance_tolerance = tolerance;
+    balance_steps = 0;
+    balance_time = 0;
+}
+
+double ChSystemDistributed::GetLoad() const {
+    switch (balance_metric) {
+        case distributed::CONTACT_COUNT:
+            return data_manager->num_rigid_contacts;
+        case distributed::STEP_TIME:
+            return balance_time;
+        default: {
+            int count = 0;
+            for (uint i = 0; i < data_manager->num_rigid_bodies; i++) {
+                if (ddm->comm_status[i] != distributed::EMPTY && ddm->comm_status[i] != distributed::GLOBAL)
+                    count++;
+            }
+            return count;
+        }
+    }
+}
+
 void ChSystemDistributed::UpdateRigidBodies() {
     this->ChSystemParallel::UpdateRigidBodies();
 
@@ -173,6 +266,9 @@ void ChSystemDistributed::AddBodyAllRanks(std::shared_ptr<ChBody> newbody) {
     ddm->body_shape_count.push_back(0);
 
     ddm->comm_status.push_back(status);
+    ddm->ghost_mask.push_back(0);
+    ddm->ref_pos.push_back(newbody->GetPos());
+    ddm->ref_rot.push_back(newbody->GetRot());
     ddm->global_id.push_back(newbody->GetGid());
 
     newbody->SetId(data_manager->num_rigid_bodies);
@@ -228,7 +324,7 @@ void ChSystemDistributed::AddBody(std::shared_ptr<ChBody> newbody) {
         }
     }
 
-    if (status == distributed::UNOWNED_UP || status == distributed::UNOWNED_DOWN) {
+    if (status == distributed::UNOWNED) {
         return;
     }
 
@@ -237,6 +333,10 @@ void ChSystemDistributed::AddBody(std::shared_ptr<ChBody> newbody) {
     ddm->body_shape_count.push_back(0);
 
     ddm->comm_status.push_back(status);
+    // All ranks classify the body alike, so the neighbors in the mask create the ghosts
+    ddm->ghost_mask.push_back(status == distributed::SHARED ? domain->GetGhostMask(newbody->GetPos()) : 0);
+    ddm->ref_pos.push_back(newbody->GetPos());
+    ddm->ref_rot.push_back(newbody->GetRot());
     ddm->global_id.push_back(newbody->GetGid());
 
     newbody->SetId(data_manager->num_rigid_bodies);
@@ -260,6 +360,9 @@ void ChSystemDistributed::AddBody(std::shared_ptr<ChBody> newbody) {
 // Should only be called to add a body when there are no free spaces to insert it into
 void ChSystemDistributed::AddBodyExchange(std::shared_ptr<ChBody> newbody, distributed::COMM_STATUS status) {
     ddm->comm_status.push_back(status);
+    ddm->ghost_mask.push_back(0);
+    ddm->ref_pos.push_back(newbody->GetPos());
+    ddm->ref_rot.push_back(newbody->GetRot());
     ddm->global_id.push_back(newbody->GetGid());
     newbody->SetId(data_manager->num_rigid_bodies);
     bodylist.push_back(newbody);
@@ -337,14 +440,10 @@ void ChSystemDistributed::PrintBodyStatus() {
         unsigned int gid = ddm->global_id[i];
 
         if (status != distributed::EMPTY) {
-            if (status == distributed::SHARED_DOWN) {
-                GetLog() << "\tGlobal ID: " << gid << " Shared down";
-            } else if (status == distributed::SHARED_UP) {
-                GetLog() << "\tGlobal ID: " << gid << " Shared up";
-            } else if (status == distributed::GHOST_UP) {
-                GetLog() << "\tGlobal ID: " << gid << " Ghost up";
-            } else if (status == distributed::GHOST_DOWN) {
-                GetLog() << "\tGlobal ID: " << gid << " Ghost down";
+            if (status == distributed::SHARED) {
+                GetLog() << "\tGlobal ID: " << gid << " Shared";
+            } else if (status == distributed::GHOST) {
+                GetLog() << "\tGlobal ID: " << gid << " Ghost";
             } else if (status == distributed::OWNED) {
                 GetLog() << "\tGlobal ID: " << gid << " Owned";
             } else if (status == distributed::GLOBAL) {
@@ -456,7 +555,7 @@ void ChSystemDistributed::SanityCheck() {
         if (*itr != UINT_MAX) {
             int local_id = *itr;
             distributed::COMM_STATUS stat = ddm->comm_status[local_id];
-            if (stat == distributed::UNOWNED_UP || stat == distributed::UNOWNED_DOWN) {
+            if (stat == distributed::UNOWNED) {
                 GetLog() << "ERROR: Deactivated shape on Activated id. ID: " << local_id << " rank " << my_rank << "\n";
             }
         }
@@ -500,8 +599,7 @@ int ChSystemDistributed::RemoveBodiesBelow(double z) {
         auto status = ddm->comm_status[i];
         if (status != distributed::EMPTY && data_manager->host_data.pos_rigid[i][2] < z) {
             RemoveBody(bodylist[i]);
-            if (status == distributed::OWNED || status == distributed::SHARED_DOWN ||
-                status == distributed::SHARED_UP) {
+            if (status == distributed::OWNED || status == distributed::SHARED) {
                 count++;
             }
         }
@@ -577,8 +675,7 @@ void ChSystemDistributed::SetTriangleShape(uint gid, int shape_idx, const TriDat
 //         uint gid = gids[i];
 //         int local = ddm->GetLocalIndex(gid);
 //         if (local != -1 &&
-//             (ddm->comm_status[local] == distributed::OWNED || ddm->comm_status[local] == distributed::SHARED_UP ||
-//              ddm->comm_status[local] == distributed::SHARED_DOWN)) {
+//             (ddm->comm_status[local] == distributed::OWNED || ddm->comm_status[local] == distributed::SHARED)) {
 //             // Get force on body at index local
 //             int contact_index = data_manager->host_data.ct_body_map[local];
 //             if (contact_index != -1) {
@@ -657,8 +754,7 @@ std::vector<std::pair<uint, ChVector<>>> ChSystemDistributed::GetBodyContactForc
         uint gid = gids[i];
         int local = ddm->GetLocalIndex(gid);
         if (local != -1 &&
-            (ddm->comm_status[local] == distributed::OWNED || ddm->comm_status[local] == distributed::SHARED_UP ||
-             ddm->comm_status[local] == distributed::SHARED_DOWN)) {
+            (ddm->comm_status[local] == distributed::OWNED || ddm->comm_status[local] == distributed::SHARED)) {
             // Get force on body at index local
             int contact_index = data_manager->host_data.ct_body_map[local];
             if (contact_index != -1) {
@@ -712,8 +808,7 @@ real3 ChSystemDistributed::GetBodyContactForce(uint gid) const {
     // Check if specified body is owned by this rank and get force
     int local = ddm->GetLocalIndex(gid);
     bool found = local != -1 &&
-                 (ddm->comm_status[local] == distributed::OWNED || ddm->comm_status[local] == distributed::SHARED_UP ||
-                  ddm->comm_status[local] == distributed::SHARED_DOWN);
+                 (ddm->comm_status[local] == distributed::OWNED || ddm->comm_status[local] == distributed::SHARED);
     if (found) {
         // Get force on body at index local
         int contact_index = data_manager->host_data.ct_body_map[local];
@@ -761,3 +856,308 @@ real3 ChSystemDistributed::GetBodyContactForce(uint gid) const {
 
     return force;
 }
+
+// -----------------------------------------------------------------------------
+// Checkpointing
+//
+// Each rank writes the file <filename>.<rank> containing:
+//   - a header line: number of files, time, global number of bodies, decomposition of the domain
+//   - one line per axis with the sub-domain boundaries
+//   - the number of bodies, followed by the bodies owned by the rank and its global bodies
+//     (body data, material and collision shapes on separate lines)
+//   - the number of contact history entries, followed by one line per entry
+// -----------------------------------------------------------------------------
+
+// Index of the given shape (in the data manager) among the shapes of the body, or -1
+static int LocalShapeIndex(ChDistributedDataManager* ddm, int body, int shape) {
+    for (int k = 0; k < ddm->body_shape_count[body]; k++) {
+        if (ddm->body_shapes[ddm->body_shape_start[body] + k] == shape)
+            return k;
+    }
+    return -1;
+}
+
+void ChSystemDistributed::WriteCheckpoint(const std::string& filename) {
+    utils::CSV_writer csv(" ");
+    csv.stream().precision(std::numeric_limits<double>::max_digits10);
+
+    csv << num_ranks << GetChTime() << num_bodies_global << domain->GetDecomposition() << std::endl;
+    for (int a = 0; a < 3; a++)
+        csv << domain->GetSplitBounds(a) << std::endl;
+
+    // Ghosts are written by their owners. Global bodies are written by all ranks holding them.
+    auto written = [this](int i) {
+        return ddm->comm_status[i] == distributed::OWNED || ddm->comm_status[i] == distributed::SHARED ||
+               ddm->comm_status[i] == distributed::GLOBAL;
+    };
+
+    int num_bodies = 0;
+    for (int i = 0; i < (int)data_manager->num_rigid_bodies; i++) {
+        if (written(i))
+            num_bodies++;
+    }
+    csv << num_bodies << std::endl;
+
+    for (int i = 0; i < (int)data_manager->num_rigid_bodies; i++) {
+        if (!written(i))
+            continue;
+        auto body = bodylist[i];
+        auto model = std::static_pointer_cast<ChCollisionModelDistributed>(body->GetCollisionModel());
+
+        // Global id, identifier, flags, collision family, mass, inertia and state
+        csv << body->GetGid() << body->GetIdentifier() << (ddm->comm_status[i] == distributed::GLOBAL);
+        csv << body->GetBodyFixed() << body->GetCollide();
+        csv << model->GetFamilyGroup() << model->GetFamilyMask();
+        csv << body->GetMass() << body->GetInertiaXX() << body->GetInertiaXY();
+        csv << body->GetPos() << body->GetRot() << body->GetPos_dt() << body->GetRot_dt();
+        csv << std::endl;
+
+        // SMC material
+        std::shared_ptr<ChMaterialSurfaceSMC> mat = body->GetMaterialSurfaceSMC();
+        csv << mat->young_modulus << mat->poisson_ratio;
+        csv << mat->static_friction << mat->sliding_friction;
+        csv << mat->restitution << mat->constant_adhesion << mat->adhesionMultDMT;
+        csv << mat->kn << mat->gn << mat->kt << mat->gt;
+        csv << std::endl;
+
+        // Collision shapes, as stored in the collision model
+        csv << model->mData.size() << std::endl;
+        for (auto& shape : model->mData) {
+            csv << shape.type;
+            csv << shape.A.x << shape.A.y << shape.A.z << shape.B.x << shape.B.y << shape.B.z;
+            csv << shape.C.x << shape.C.y << shape.C.z << shape.R.w << shape.R.x << shape.R.y << shape.R.z;
+            csv << std::endl;
+        }
+    }
+
+    // Contact history of the contacts involving an owned body, identified by the global ids of the
+    // body storing the history and of the other body, and the indices of the shapes within each body
+    std::vector<std::string> entries;
+    if (data_manager->settings.solver.tangential_displ_mode == ChSystemSMC::TangentialDisplacementModel::MultiStep) {
+        auto owned = [this](int i) {
+            return ddm->comm_status[i] == distributed::OWNED || ddm->comm_status[i] == distributed::SHARED;
+        };
+        for (int h = 0; h < (int)data_manager->num_rigid_bodies; h++) {
+            if (ddm->comm_status[h] == distributed::EMPTY)
+                continue;
+            for (int c = 0; c < max_shear; c++) {
+                vec3 neigh = data_manager->host_data.shear_neigh[max_shear * h + c];
+                int o = neigh.x;
+                if (o == -1 || (!owned(h) && !owned(o)))
+                    continue;
+                bool first_on_h = data_manager->shape_data.id_rigid[neigh.y] == (uint)h;
+                int k_h = LocalShapeIndex(ddm, h, first_on_h ? neigh.y : neigh.z);
+                int k_o = LocalShapeIndex(ddm, o, first_on_h ? neigh.z : neigh.y);
+                if (k_h == -1 || k_o == -1)
+                    continue;
+                real3 disp = data_manager->host_data.shear_disp[max_shear * h + c];
+                utils::CSV_writer entry(" ");
+                entry.stream().precision(std::numeric_limits<double>::max_digits10);
+                entry << ddm->global_id[h] << ddm->global_id[o] << k_h << k_o << disp.x << disp.y << disp.z;
+                entries.push_back(entry.stream().str());
+            }
+        }
+    }
+    csv << entries.size() << std::endl;
+    for (auto& entry : entries)
+        csv.stream() << entry << std::endl;
+
+    csv.write_to_file(filename + "." + std::to_string(my_rank));
+}
+
+void ChSystemDistributed::ReadCheckpoint(const std::string& filename) {
+    if (!domain->IsSplit()) {
+        ErrorAbort("ReadCheckpoint: the simulation domain must be set first\n");
+    }
+
+    struct HistoryEntry {
+        uint gid_h, gid_o;
+        int k_h, k_o;
+        real3 disp;
+    };
+    std::vector<HistoryEntry> history;
+
+    std::unordered_set<uint> added;  // Global bodies appear in the files of several ranks
+    unsigned int num_bodies_checkpoint = 0;
+    int num_files = 1;
+
+    for (int f = 0; f < num_files; f++) {
+        std::string fname = filename + "." + std::to_string(f);
+        std::ifstream ifile(fname.c_str());
+        if (!ifile.is_open()) {
+            ErrorAbort("ReadCheckpoint: cannot open " + fname + "\n");
+        }
+        std::string line;
+
+        // Header and sub-domain boundaries
+        int file_ranks;
+        double time;
+        ChVector<int> dims;
+        std::getline(ifile, line);
+        std::istringstream(line) >> file_ranks >> time >> num_bodies_checkpoint >> dims.x() >> dims.y() >> dims.z();
+
+        std::vector<double> bounds[3];
+        for (int a = 0; a < 3; a++) {
+            std::getline(ifile, line);
+            std::istringstream iss(line);
+            double b;
+            while (iss >> b)
+                bounds[a].push_back(b);
+        }
+
+        if (f == 0) {
+            num_files = file_ranks;
+            SetChTime(time);
+            if (dims == domain->GetDecomposition()) {
+                for (int a = 0; a < 3; a++)
+                    domain->SetSplitBounds(a, bounds[a]);
+            }
+        }
+
+        // Bodies
+        int num_bodies;
+        std::getline(ifile, line);
+        std::istringstream(line) >> num_bodies;
+
+        for (int n = 0; n < num_bodies; n++) {
+            uint gid;
+            int identifier, global, fixed, collide;
+            short family_group, family_mask;
+            double mass;
+            ChVector<> inertiaXX, inertiaXY, pos, pos_dt;
+            ChQuaternion<> rot, rot_dt;
+            std::getline(ifile, line);
+            std::istringstream iss1(line);
+            iss1 >> gid >> identifier >> global >> fixed >> collide >> family_group >> family_mask >> mass;
+            iss1 >> inertiaXX.x() >> inertiaXX.y() >> inertiaXX.z() >> inertiaXY.x() >> inertiaXY.y() >> inertiaXY.z();
+            iss1 >> pos.x() >> pos.y() >> pos.z() >> rot.e0() >> rot.e1() >> rot.e2() >> rot.e3();
+            iss1 >> pos_dt.x() >> pos_dt.y() >> pos_dt.z() >> rot_dt.e0() >> rot_dt.e1() >> rot_dt.e2() >> rot_dt.e3();
+
+            auto mat = std::make_shared<ChMaterialSurfaceSMC>();
+            std::getline(ifile, line);
+            std::istringstream iss2(line);
+            iss2 >> mat->young_modulus >> mat->poisson_ratio;
+            iss2 >> mat->static_friction >> mat->sliding_friction;
+            iss2 >> mat->restitution >> mat->constant_adhesion >> mat->adhesionMultDMT;
+            iss2 >> mat->kn >> mat->gn >> mat->kt >> mat->gt;
+
+            int num_shapes;
+            std::getline(ifile, line);
+            std::istringstream(line) >> num_shapes;
+            std::vector<ConvexModel> shapes(num_shapes);
+            for (auto& shape : shapes) {
+                int type;
+                std::getline(ifile, line);
+                std::istringstream iss(line);
+                iss >> type;
+                iss >> shape.A.x >> shape.A.y >> shape.A.z >> shape.B.x >> shape.B.y >> shape.B.z;
+                iss >> shape.C.x >> shape.C.y >> shape.C.z >> shape.R.w >> shape.R.x >> shape.R.y >> shape.R.z;
+                shape.type = (shape_type)type;
+            }
+
+            // Bodies added on all ranks have no collision shapes (see AddBodyAllRanks).
+            // Other bodies are kept by the ranks whose sub-domain they belong to (see AddBody).
+            bool all_ranks = global && shapes.empty();
+            if (added.count(gid) || (!all_ranks && !InSub(pos)))
+                continue;
+
+            std::shared_ptr<ChBody> body(NewBody());
+            body->SetIdentifier(identifier);
+            body->SetMass(mass);
+            body->SetInertiaXX(inertiaXX);
+            body->SetInertiaXY(inertiaXY);
+            body->SetPos(pos);
+            body->SetRot(rot);
+            body->SetPos_dt(pos_dt);
+            body->SetRot_dt(rot_dt);
+            body->SetBodyFixed(fixed != 0);
+            body->SetCollide(collide != 0);
+            body->SetMaterialSurface(mat);
+
+            body->GetCollisionModel()->ClearModel();
+            for (auto& shape : shapes) {
+                ChVector<> A(shape.A.x, shape.A.y, shape.A.z);
+                ChMatrix33<> R(ChQuaternion<>(shape.R.w, shape.R.x, shape.R.y, shape.R.z));
+                switch (shape.type) {
+                    case SPHERE:
+                        body->GetCollisionModel()->AddSphere(shape.B.x, A);
+                        break;
+                    case BOX:
+                        body->GetCollisionModel()->AddBox(shape.B.x, shape.B.y, shape.B.z, A, R);
+                        break;
+                    case ELLIPSOID:
+                        body->GetCollisionModel()->AddEllipsoid(shape.B.x, shape.B.y, shape.B.z, A, R);
+                        break;
+                    case TRIANGLEMESH:
+                        std::static_pointer_cast<ChCollisionModelDistributed>(body->GetCollisionModel())
+                            ->AddTriangle(A, ChVector<>(shape.B.x, shape.B.y, shape.B.z),
+                                          ChVector<>(shape.C.x, shape.C.y, shape.C.z), ChVector<>(0, 0, 0), R);
+                        break;
+                    default:
+                        ErrorAbort("ReadCheckpoint: unsupported collision shape type\n");
+                }
+            }
+            body->GetCollisionModel()->SetFamilyGroup(family_group);
+            body->GetCollisionModel()->SetFamilyMask(family_mask);
+            body->GetCollisionModel()->BuildModel();
+
+            // The body is assigned the next global id
+            num_bodies_global = gid;
+            if (all_ranks)
+                AddBodyAllRanks(body);
+            else
+                AddBody(body);
+            added.insert(gid);
+        }
+
+        // Contact history
+        int num_entries;
+        std::getline(ifile, line);
+        std::istringstream(line) >> num_entries;
+        for (int n = 0; n < num_entries; n++) {
+            HistoryEntry entry;
+            std::getline(ifile, line);
+            std::istringstream(line) >> entry.gid_h >> entry.gid_o >> entry.k_h >> entry.k_o >> entry.disp.x >>
+                entry.disp.y >> entry.disp.z;
+            history.push_back(entry);
+        }
+    }
+
+    num_bodies_global = num_bodies_checkpoint;
+
+    if (data_manager->settings.solver.tangential_displ_mode != ChSystemSMC::TangentialDisplacementModel::MultiStep)
+        return;
+
+    // Store each history entry on the body with the larger local index, as the SMC solver does.
+    // The tangential displacement is relative to the body storing it.
+    custom_vector<vec3>& shear_neigh = data_manager->host_data.shear_neigh;
+    custom_vector<real3>& shear_disp = data_manager->host_data.shear_disp;
+    for (auto& entry : history) {
+        int h = ddm->GetLocalIndex(entry.gid_h);
+        int o = ddm->GetLocalIndex(entry.gid_o);
+        if (h == -1 || o == -1 || entry.k_h >= ddm->body_shape_count[h] || entry.k_o >= ddm->body_shape_count[o])
+            continue;
+        int shape_h = ddm->body_shapes[ddm->body_shape_start[h] + entry.k_h];
+        int shape_o = ddm->body_shapes[ddm->body_shape_start[o] + entry.k_o];
+        int body1 = std::max(h, o);
+        vec3 neigh(std::min(h, o), std::max(shape_h, shape_o), std::min(shape_h, shape_o));
+        real3 disp = (body1 == h) ? entry.disp : -entry.disp;
+
+        // Entries of contacts across sub-domains are written by both owners
+        int free_slot = -1;
+        bool found = false;
+        for (int c = 0; c < max_shear; c++) {
+            vec3& stored = shear_neigh[max_shear * body1 + c];
+            if (stored.x == neigh.x && stored.y == neigh.y && stored.z == neigh.z) {
+                found = true;
+                break;
+            }
+            if (stored.x == -1 && free_slot == -1)
+                free_slot = c;
+        }
+        if (!found && free_slot != -1) {
+            shear_neigh[max_shear * body1 + free_slot] = neigh;
+            shear_disp[max_shear * body1 + free_slot] = disp;
+        }
+    }
+}
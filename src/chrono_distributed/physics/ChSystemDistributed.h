@@ -77,10 +77,22 @@ class CH_DISTR_API ChSystemDistributed : public ChSystemParallelSMC {
     /// Return the distance into the neighboring sub-domain that is considered shared.
     double GetGhostLayer() const { return ghost_layer; }
 
+    /// Enable periodic load balancing of the sub-domains.
+    /// Every interval steps, the load of each rank is measured with the given metric and the
+    /// sub-domain boundaries are moved towards an even distribution (see ChDomainDistributed::Rebalance),
+    /// if the largest load exceeds the average by more than the given tolerance ratio.
+    /// An interval of 0 (default) disables load balancing.
+    void SetLoadBalancing(int interval,
+                          distributed::LOAD_METRIC metric = distributed::BODY_COUNT,
+                          double tolerance = 1.1);
+
+    /// Return the load of this rank, as measured by the load balancing metric.
+    double GetLoad() const;
+
     /// Return the current global number of bodies in the system.
     unsigned int GetNumBodiesGlobal() const { return num_bodies_global; }
 
-    /// Return true if pos is within this rank's sub-domain.
+    /// Return true if pos is within this rank's sub-domain, extended by the ghost layer.
     bool InSub(const ChVector<double>& pos) const;
 
     /// Create a new body, consistent with the contact method and collision model used by this system.
@@ -107,9 +119,14 @@ class CH_DISTR_API ChSystemDistributed : public ChSystemParallelSMC {
     virtual void RemoveBody(std::shared_ptr<ChBody> body) override;
 
     /// Wraps the super-class Integrate_Y call and introduces a call that carries
-    /// out all inter-rank communication.
+    /// out all inter-rank communication. Communication with the neighbor ranks
+    /// overlaps with the update of the bodies at the end of the step.
     virtual bool Integrate_Y() override;
 
+    /// Advances the bodies which may have to be sent to a neighbor rank first and starts the exchange
+    /// with the neighbors, which completes at the end of Integrate_Y, before advancing the other bodies.
+    virtual void AdvanceRigidBodies() override;
+
     /// Wraps super-class UpdateRigidBodies and adds a gid update.
     virtual void UpdateRigidBodies() override;
 
@@ -204,6 +221,19 @@ class CH_DISTR_API ChSystemDistributed : public ChSystemParallelSMC {
                            const std::vector<TriData>& new_shapes);
     void SetTriangleShape(uint gid, int shape_idx, const TriData& new_shape);
 
+    /// Write a checkpoint of the simulation, to be read with ReadCheckpoint.
+    /// Must be called on all system ranks. Each rank writes the file filename.<rank> with the domain
+    /// boundaries, the bodies it owns (including their collision shapes and materials) and the contact
+    /// history (tangential displacements) of their contacts.
+    void WriteCheckpoint(const std::string& filename);
+
+    /// Restart the simulation from a checkpoint written with WriteCheckpoint, possibly by a different number
+    /// of ranks. Must be called on all system ranks, after SetSimDomain and before the first step.
+    /// Each rank reads all files of the checkpoint and keeps the bodies which belong to its sub-domain.
+    /// If the checkpoint was written with the same decomposition of the domain, its sub-domain boundaries are
+    /// restored. Global IDs, the simulation time and the contact history are preserved.
+    void ReadCheckpoint(const std::string& filename);
+
     /// Get contact forces experienced by any of the bodies specified through their global IDs.
     /// Must be called on all system ranks; return value valid only on 'master' rank.
     /// Returns a vector of pairs of global IDs and corresponding contact forces.
@@ -246,6 +276,13 @@ class CH_DISTR_API ChSystemDistributed : public ChSystemParallelSMC {
     /// Type for internally sending contact forces
     MPI_Datatype InternalForceType;
 
+    /// Load balancing settings and state
+    int balance_interval;                     ///< Number of steps between rebalances (0 to disable)
+    distributed::LOAD_METRIC balance_metric;  ///< Measure of the load of a rank
+    double balance_tolerance;                 ///< Accepted ratio of the largest to the average load
+    int balance_steps;                        ///< Steps since the last rebalance
+    double balance_time;                      ///< Step time minus exchange time since the last rebalance
+
     friend class ChCommDistributed;
     friend class ChDomainDistributed;
 };
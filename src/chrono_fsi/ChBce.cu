@@ -21,6 +21,7 @@
 namespace chrono {
 namespace fsi {
 
+#ifndef CHRONO_FSI_HOST
 // double precision atomic add function
 __device__ double atomicAdd(double* address, double val) {
     unsigned long long int* address_as_ull = (unsigned long long int*)address;
@@ -34,6 +35,7 @@ __device__ double atomicAdd(double* address, double val) {
 
     return __longlong_as_double(old);
 }
+#endif
 //--------------------------------------------------------------------------------------------------------------------------------
 __global__ void Populate_RigidSPH_MeshPos_LRF_kernel(Real3* rigidSPH_MeshPos_LRF_D,
                                                      Real4* posRadD,
@@ -744,7 +746,7 @@ void ChBce::Populate_RigidSPH_MeshPos_LRF(SphMarkerDataD* sphMarkersD, FsiBodies
     uint nThreads_SphMarkers;
     computeGridSize(numObjectsH->numRigid_SphMarkers, 256, nBlocks_numRigid_SphMarkers, nThreads_SphMarkers);
 
-    Populate_RigidSPH_MeshPos_LRF_kernel<<<nBlocks_numRigid_SphMarkers, nThreads_SphMarkers>>>(
+    CH_FSI_LAUNCH(Populate_RigidSPH_MeshPos_LRF_kernel, nBlocks_numRigid_SphMarkers, nThreads_SphMarkers)(
         mR3CAST(fsiGeneralData->rigidSPH_MeshPos_LRF_D), mR4CAST(sphMarkersD->posRadD),
         U1CAST(fsiGeneralData->rigidIdentifierD), mR3CAST(fsiBodiesD->posRigid_fsiBodies_D),
         mR4CAST(fsiBodiesD->q_fsiBodies_D));
@@ -783,7 +785,7 @@ void ChBce::Populate_FlexSPH_MeshPos_LRF(SphMarkerDataD* sphMarkersD, FsiMeshDat
     //      fsiMeshD->pos_fsi_fea_D.size());
 
     thrust::device_vector<Real3> FlexSPH_MeshPos_LRF_H = fsiGeneralData->FlexSPH_MeshPos_LRF_H;
-    Populate_FlexSPH_MeshPos_LRF_kernel<<<nBlocks_numFlex_SphMarkers, nThreads_SphMarkers>>>(
+    CH_FSI_LAUNCH(Populate_FlexSPH_MeshPos_LRF_kernel, nBlocks_numFlex_SphMarkers, nThreads_SphMarkers)(
         mR3CAST(fsiGeneralData->FlexSPH_MeshPos_LRF_D), mR3CAST(FlexSPH_MeshPos_LRF_H), mR4CAST(sphMarkersD->posRadD),
         U1CAST(fsiGeneralData->FlexIdentifierD), numObjectsH->numFlexBodies1D,
         U2CAST(fsiGeneralData->CableElementsNodes), U4CAST(fsiGeneralData->ShellElementsNodes),
@@ -816,7 +818,7 @@ void ChBce::RecalcSortedVelocityPressure_BCE(thrust::device_vector<Real3>& velMa
     uint numThreads, numBlocks;
     computeGridSize(updatePortion.y - updatePortion.x, 64, numBlocks, numThreads);
 
-    new_BCE_VelocityPressure<<<numBlocks, numThreads>>>(
+    CH_FSI_LAUNCH(new_BCE_VelocityPressure, numBlocks, numThreads)(
         mR3CAST(velMas_ModifiedBCE),
         mR4CAST(rhoPreMu_ModifiedBCE),  // input: sorted velocities
         mR4CAST(sortedPosRad), mR3CAST(sortedVelMas), mR4CAST(sortedRhoPreMu), U1CAST(cellStart), U1CAST(cellEnd),
@@ -846,7 +848,7 @@ void ChBce::CalcBceAcceleration(thrust::device_vector<Real3>& bceAcc,
     uint numThreads, numBlocks;
     computeGridSize(numRigid_SphMarkers, 64, numBlocks, numThreads);
 
-    calcBceAcceleration_kernel<<<numBlocks, numThreads>>>(
+    CH_FSI_LAUNCH(calcBceAcceleration_kernel, numBlocks, numThreads)(
         mR3CAST(bceAcc), mR4CAST(q_fsiBodies_D), mR3CAST(accRigid_fsiBodies_D), mR3CAST(omegaVelLRF_fsiBodies_D),
         mR3CAST(omegaAccLRF_fsiBodies_D), mR3CAST(rigidSPH_MeshPos_LRF_D), U1CAST(rigidIdentifierD));
 
@@ -905,13 +907,13 @@ void ChBce::Rigid_Forces_Torques(SphMarkerDataD* sphMarkersD, FsiBodiesDataD* fs
     uint nBlocks_numRigid_SphMarkers;
     uint nThreads_SphMarkers;
     computeGridSize(numObjectsH->numRigid_SphMarkers, 256, nBlocks_numRigid_SphMarkers, nThreads_SphMarkers);
-    Calc_Rigid_FSI_ForcesD<<<nBlocks_numRigid_SphMarkers, nThreads_SphMarkers>>>(
+    CH_FSI_LAUNCH(Calc_Rigid_FSI_ForcesD, nBlocks_numRigid_SphMarkers, nThreads_SphMarkers)(
         mR3CAST(fsiGeneralData->rigid_FSI_ForcesD), mR4CAST(fsiGeneralData->derivVelRhoD),
         U1CAST(fsiGeneralData->rigidIdentifierD));
     cudaDeviceSynchronize();
     cudaCheckError();
 
-    Calc_Markers_TorquesD<<<nBlocks_numRigid_SphMarkers, nThreads_SphMarkers>>>(
+    CH_FSI_LAUNCH(Calc_Markers_TorquesD, nBlocks_numRigid_SphMarkers, nThreads_SphMarkers)(
         mR3CAST(fsiGeneralData->rigid_FSI_TorquesD), mR4CAST(fsiGeneralData->derivVelRhoD),
         mR4CAST(sphMarkersD->posRadD), U1CAST(fsiGeneralData->rigidIdentifierD),
         mR3CAST(fsiBodiesD->posRigid_fsiBodies_D));
@@ -930,7 +932,7 @@ void ChBce::Flex_Forces(SphMarkerDataD* sphMarkersD, FsiMeshDataD* fsiMeshD) {
     uint nThreads_SphMarkers;
     computeGridSize(numObjectsH->numFlex_SphMarkers, 256, nBlocks_numFlex_SphMarkers, nThreads_SphMarkers);
 
-    Calc_Flex_FSI_ForcesD<<<nBlocks_numFlex_SphMarkers, nThreads_SphMarkers>>>(
+    CH_FSI_LAUNCH(Calc_Flex_FSI_ForcesD, nBlocks_numFlex_SphMarkers, nThreads_SphMarkers)(
         mR3CAST(fsiGeneralData->FlexSPH_MeshPos_LRF_D), U1CAST(fsiGeneralData->FlexIdentifierD),
         numObjectsH->numFlexBodies1D, U2CAST(fsiGeneralData->CableElementsNodes),
         U4CAST(fsiGeneralData->ShellElementsNodes), mR4CAST(fsiGeneralData->derivVelRhoD),
@@ -955,7 +957,7 @@ void ChBce::UpdateRigidMarkersPositionVelocity(SphMarkerDataD* sphMarkersD, FsiB
     //** "posRadD2"/"velMasD2" associated to BCE markers are updated based on new
     // rigid body (position,
     // orientation)/(velocity, angular velocity)
-    UpdateRigidMarkersPositionVelocityD<<<nBlocks_numRigid_SphMarkers, nThreads_SphMarkers>>>(
+    CH_FSI_LAUNCH(UpdateRigidMarkersPositionVelocityD, nBlocks_numRigid_SphMarkers, nThreads_SphMarkers)(
         mR4CAST(sphMarkersD->posRadD), mR3CAST(sphMarkersD->velMasD), mR3CAST(fsiGeneralData->rigidSPH_MeshPos_LRF_D),
         U1CAST(fsiGeneralData->rigidIdentifierD), mR3CAST(fsiBodiesD->posRigid_fsiBodies_D),
         mR4CAST(fsiBodiesD->velMassRigid_fsiBodies_D), mR3CAST(fsiBodiesD->omegaVelLRF_fsiBodies_D),
@@ -974,7 +976,7 @@ void ChBce::UpdateFlexMarkersPositionVelocity(SphMarkerDataD* sphMarkersD, FsiMe
     printf("UpdateFlexMarkersPositionVelocity..\n");
 
     computeGridSize(numObjectsH->numFlex_SphMarkers, 256, nBlocks_numFlex_SphMarkers, nThreads_SphMarkers);
-    UpdateFlexMarkersPositionVelocityAccD<<<nBlocks_numFlex_SphMarkers, nThreads_SphMarkers>>>(
+    CH_FSI_LAUNCH(UpdateFlexMarkersPositionVelocityAccD, nBlocks_numFlex_SphMarkers, nThreads_SphMarkers)(
         mR4CAST(sphMarkersD->posRadD), mR3CAST(fsiGeneralData->FlexSPH_MeshPos_LRF_D), mR3CAST(sphMarkersD->velMasD),
         U1CAST(fsiGeneralData->FlexIdentifierD), numObjectsH->numFlexBodies1D,
         U2CAST(fsiGeneralData->CableElementsNodes), U4CAST(fsiGeneralData->ShellElementsNodes),
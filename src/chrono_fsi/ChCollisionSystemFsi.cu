@@ -112,10 +112,11 @@ __global__ void reorderDataAndFindCellStartD(uint* cellStartD,      // output: c
                                              Real3* velMasD,             // input: sorted velocity array
                                              Real4* rhoPresMuD,
                                              uint numAllMarkers) {
-    extern __shared__ uint sharedHash[];  // blockSize + 1 elements
     /* Get the particle index the current thread is supposed to be looking at. */
     uint index = blockIdx.x * blockDim.x + threadIdx.x;
     uint hash;
+#ifndef CHRONO_FSI_HOST
+    extern __shared__ uint sharedHash[];  // blockSize + 1 elements
     /* handle case when no. of particles not multiple of block size */
     if (index < numAllMarkers) {
         hash = gridMarkerHashD[index];
@@ -133,6 +134,17 @@ __global__ void reorderDataAndFindCellStartD(uint* cellStartD,      // output: c
 
     __syncthreads();
 
+    uint prevHash = sharedHash[threadIdx.x];
+#else
+    /* no shared memory on the host: read the neighbor particle hash directly */
+    uint prevHash = 0;
+    if (index < numAllMarkers) {
+        hash = gridMarkerHashD[index];
+        if (index > 0)
+            prevHash = gridMarkerHashD[index - 1];
+    }
+#endif
+
     if (index < numAllMarkers) {
         /* If this particle has a different cell index to the previous particle then
          * it must be
@@ -141,10 +153,10 @@ __global__ void reorderDataAndFindCellStartD(uint* cellStartD,      // output: c
          * isn't the first particle, it must also be the cell end of the previous
          * particle's cell
          */
-        if (index == 0 || hash != sharedHash[threadIdx.x]) {
+        if (index == 0 || hash != prevHash) {
             cellStartD[hash] = index;
             if (index > 0)
-                cellEndD[sharedHash[threadIdx.x]] = index;
+                cellEndD[prevHash] = index;
         }
 
         if (index == numAllMarkers - 1) {
@@ -233,9 +245,9 @@ void ChCollisionSystemFsi::calcHash() {
     computeGridSize(numObjectsH->numAllMarkers, 256, numBlocks, numThreads);
     /* Execute Kernel */
 
-    calcHashD<<<numBlocks, numThreads>>>(U1CAST(markersProximityD->gridMarkerHashD),
-                                         U1CAST(markersProximityD->gridMarkerIndexD), mR4CAST(sphMarkersD->posRadD),
-                                         numObjectsH->numAllMarkers, isErrorD);
+    CH_FSI_LAUNCH(calcHashD, numBlocks, numThreads)(
+        U1CAST(markersProximityD->gridMarkerHashD), U1CAST(markersProximityD->gridMarkerIndexD),
+        mR4CAST(sphMarkersD->posRadD), numObjectsH->numAllMarkers, isErrorD);
 
     /* Check for errors in kernel execution */
     cudaDeviceSynchronize();
@@ -268,7 +280,7 @@ void ChCollisionSystemFsi::reorderDataAndFindCellStart() {
     computeGridSize(numObjectsH->numAllMarkers, 256, numBlocks, numThreads);  //?$ 256 is blockSize
 
     uint smemSize = sizeof(uint) * (numThreads + 1);
-    reorderDataAndFindCellStartD<<<numBlocks, numThreads, smemSize>>>(
+    CH_FSI_LAUNCH(reorderDataAndFindCellStartD, numBlocks, numThreads, smemSize)(
         U1CAST(markersProximityD->cellStartD), U1CAST(markersProximityD->cellEndD), mR4CAST(sortedSphMarkersD->posRadD),
         mR3CAST(sortedSphMarkersD->velMasD), mR4CAST(sortedSphMarkersD->rhoPresMuD),
         U1CAST(markersProximityD->gridMarkerHashD), U1CAST(markersProximityD->gridMarkerIndexD),
@@ -17,7 +17,7 @@
 
 #ifndef CH_DEVICEUTILS_H_
 #define CH_DEVICEUTILS_H_
-#include <cuda_runtime.h>  // for __host__ __device__ flags
+#include "chrono_fsi/ChFsiBackend.h"  // for __host__ __device__ flags
 #include <thrust/device_vector.h>
 #include <thrust/host_vector.h>
 
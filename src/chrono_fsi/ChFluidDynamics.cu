@@ -15,6 +15,7 @@
 // Class for performing time integration in fluid system.//
 // =============================================================================
 
+#include <iostream>
 #include "chrono_fsi/ChFluidDynamics.cuh"
 
 namespace chrono {
@@ -426,7 +427,7 @@ void ChFluidDynamics::UpdateFluid(SphMarkerDataD* sphMarkersD, Real dT) {
     //------------------------
     uint nBlock_UpdateFluid, nThreads;
     computeGridSize(updatePortion.y - updatePortion.x, 128, nBlock_UpdateFluid, nThreads);
-    UpdateFluidD<<<nBlock_UpdateFluid, nThreads>>>(
+    CH_FSI_LAUNCH(UpdateFluidD, nBlock_UpdateFluid, nThreads)(
         mR4CAST(sphMarkersD->posRadD), mR3CAST(sphMarkersD->velMasD), mR3CAST(fsiData->fsiGeneralData.vel_XSPH_D),
         mR4CAST(sphMarkersD->rhoPresMuD), mR4CAST(fsiData->fsiGeneralData.derivVelRhoD), updatePortion, dT, isErrorD);
     cudaDeviceSynchronize();
@@ -457,7 +458,7 @@ void ChFluidDynamics::UpdateFluid_Implicit(SphMarkerDataD* sphMarkersD) {
     cudaMalloc((void**)&isErrorD, sizeof(bool));
     *isErrorH = false;
     cudaMemcpy(isErrorD, isErrorH, sizeof(bool), cudaMemcpyHostToDevice);
-    Update_Fluid_State<<<numBlocks, numThreads>>>(
+    CH_FSI_LAUNCH(Update_Fluid_State, numBlocks, numThreads)(
         mR3CAST(fsiData->fsiGeneralData.vel_XSPH_D), mR4CAST(sphMarkersD->posRadD), mR3CAST(sphMarkersD->velMasD),
         mR4CAST(sphMarkersD->rhoPresMuD), updatePortion, numObjectsH->numAllMarkers, paramsH->dT, isErrorD);
     cudaDeviceSynchronize();
@@ -481,17 +482,17 @@ void ChFluidDynamics::UpdateFluid_Implicit(SphMarkerDataD* sphMarkersD) {
 void ChFluidDynamics::ApplyBoundarySPH_Markers(SphMarkerDataD* sphMarkersD) {
     uint nBlock_NumSpheres, nThreads_SphMarkers;
     computeGridSize(numObjectsH->numAllMarkers, 256, nBlock_NumSpheres, nThreads_SphMarkers);
-    ApplyPeriodicBoundaryXKernel<<<nBlock_NumSpheres, nThreads_SphMarkers>>>(mR4CAST(sphMarkersD->posRadD),
-                                                                             mR4CAST(sphMarkersD->rhoPresMuD));
+    CH_FSI_LAUNCH(ApplyPeriodicBoundaryXKernel, nBlock_NumSpheres, nThreads_SphMarkers)(
+        mR4CAST(sphMarkersD->posRadD), mR4CAST(sphMarkersD->rhoPresMuD));
     cudaDeviceSynchronize();
     cudaCheckError();
     //    // these are useful anyway for out of bound particles
-    ApplyPeriodicBoundaryYKernel<<<nBlock_NumSpheres, nThreads_SphMarkers>>>(mR4CAST(sphMarkersD->posRadD),
-                                                                             mR4CAST(sphMarkersD->rhoPresMuD));
+    CH_FSI_LAUNCH(ApplyPeriodicBoundaryYKernel, nBlock_NumSpheres, nThreads_SphMarkers)(
+        mR4CAST(sphMarkersD->posRadD), mR4CAST(sphMarkersD->rhoPresMuD));
     cudaDeviceSynchronize();
     cudaCheckError();
-    ApplyPeriodicBoundaryZKernel<<<nBlock_NumSpheres, nThreads_SphMarkers>>>(mR4CAST(sphMarkersD->posRadD),
-                                                                             mR4CAST(sphMarkersD->rhoPresMuD));
+    CH_FSI_LAUNCH(ApplyPeriodicBoundaryZKernel, nBlock_NumSpheres, nThreads_SphMarkers)(
+        mR4CAST(sphMarkersD->posRadD), mR4CAST(sphMarkersD->rhoPresMuD));
     cudaDeviceSynchronize();
     cudaCheckError();
     //    SetOutputPressureToZero_X<<<nBlock_NumSpheres, nThreads_SphMarkers>>>(mR3CAST(posRadD), mR4CAST(rhoPresMuD));
@@ -512,17 +513,17 @@ void ChFluidDynamics::ApplyBoundarySPH_Markers(SphMarkerDataD* sphMarkersD) {
 void ChFluidDynamics::ApplyModifiedBoundarySPH_Markers(SphMarkerDataD* sphMarkersD) {
     uint nBlock_NumSpheres, nThreads_SphMarkers;
     computeGridSize(numObjectsH->numAllMarkers, 256, nBlock_NumSpheres, nThreads_SphMarkers);
-    ApplyInletBoundaryXKernel<<<nBlock_NumSpheres, nThreads_SphMarkers>>>(
+    CH_FSI_LAUNCH(ApplyInletBoundaryXKernel, nBlock_NumSpheres, nThreads_SphMarkers)(
         mR4CAST(sphMarkersD->posRadD), mR3CAST(sphMarkersD->velMasD), mR4CAST(sphMarkersD->rhoPresMuD));
     cudaDeviceSynchronize();
     cudaCheckError();
     // these are useful anyway for out of bound particles
-    ApplyPeriodicBoundaryYKernel<<<nBlock_NumSpheres, nThreads_SphMarkers>>>(mR4CAST(sphMarkersD->posRadD),
-                                                                             mR4CAST(sphMarkersD->rhoPresMuD));
+    CH_FSI_LAUNCH(ApplyPeriodicBoundaryYKernel, nBlock_NumSpheres, nThreads_SphMarkers)(
+        mR4CAST(sphMarkersD->posRadD), mR4CAST(sphMarkersD->rhoPresMuD));
     cudaDeviceSynchronize();
     cudaCheckError();
-    ApplyPeriodicBoundaryZKernel<<<nBlock_NumSpheres, nThreads_SphMarkers>>>(mR4CAST(sphMarkersD->posRadD),
-                                                                             mR4CAST(sphMarkersD->rhoPresMuD));
+    CH_FSI_LAUNCH(ApplyPeriodicBoundaryZKernel, nBlock_NumSpheres, nThreads_SphMarkers)(
+        mR4CAST(sphMarkersD->posRadD), mR4CAST(sphMarkersD->rhoPresMuD));
     cudaDeviceSynchronize();
     cudaCheckError();
 }
@@ -537,7 +538,7 @@ void ChFluidDynamics::DensityReinitialization() {
     thrust::device_vector<Real4> dummySortedRhoPreMu(numObjectsH->numAllMarkers);
     thrust::fill(dummySortedRhoPreMu.begin(), dummySortedRhoPreMu.end(), mR4(0.0));
 
-    ReCalcDensityD_F1<<<nBlock_NumSpheres, nThreads_SphMarkers>>>(
+    CH_FSI_LAUNCH(ReCalcDensityD_F1, nBlock_NumSpheres, nThreads_SphMarkers)(
         mR4CAST(dummySortedRhoPreMu), mR4CAST(fsiData->sortedSphMarkersD.posRadD),
         mR3CAST(fsiData->sortedSphMarkersD.velMasD), mR4CAST(fsiData->sortedSphMarkersD.rhoPresMuD),
         U1CAST(fsiData->markersProximityD.gridMarkerIndexD), U1CAST(fsiData->markersProximityD.cellStartD),
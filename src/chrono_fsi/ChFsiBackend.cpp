@@ -9,16 +9,17 @@
 // http://projectchrono.org/license-chrono.txt.
 //
 // =============================================================================
+//
+// Execution backend of the FSI module (see ChFsiBackend.h).
+// =============================================================================
 
-#include "chrono/parallel/ChThreads.h"
-
-namespace chrono {
+#include "chrono_fsi/ChFsiBackend.h"
 
-/*
-ChThreads::~ChThreads()
-{
+#ifdef CHRONO_FSI_HOST
 
-}
-*/
+thread_local uint3 threadIdx = {0, 0, 0};
+thread_local uint3 blockIdx = {0, 0, 0};
+thread_local dim3 blockDim;
+thread_local dim3 gridDim;
 
-}  // end namespace chrono
+#endif
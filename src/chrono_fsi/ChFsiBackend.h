@@ -0,0 +1,369 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+//
+// Execution backend of the FSI module.
+//
+// With the CUDA backend this header only pulls in the CUDA runtime. With the
+// host backend (CHRONO_FSI_HOST), the .cu sources are compiled as C++ and this
+// header provides the subset of the CUDA language and runtime they use:
+// qualifiers, vector types, thread indices, atomics, memory management and
+// kernel launches. Kernels are executed on the CPU cores with OpenMP, one
+// thread block per task; the thrust containers and algorithms use the thrust
+// OMP system (see THRUST_DEVICE_SYSTEM in the CMake configuration).
+//
+// Kernels must be launched with CH_FSI_LAUNCH(kernel, numBlocks, numThreads)
+// instead of the <<<...>>> syntax, so that the same sources build with both
+// backends.
+//
+// The host backend is meant for portability and testing, not for performance.
+// The CUDA threads of a block run one after the other, so the SPH force and
+// BCE kernels are executed scalar. Only the host loops of the linear solver
+// (sparse matrix-vector product and vector operations) are vectorized.
+// =============================================================================
+
+#ifndef CH_FSI_BACKEND_H_
+#define CH_FSI_BACKEND_H_
+
+#include "chrono_fsi/ChConfigFSI.h"
+
+#ifndef CHRONO_FSI_HOST
+
+#include <cuda_runtime.h>
+
+#define CH_FSI_LAUNCH(kernel, ...) kernel<<<__VA_ARGS__>>>
+
+#else
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <utility>
+
+// ----------------------------------------------------------------------------
+// Function and variable qualifiers
+// ----------------------------------------------------------------------------
+
+#define __host__
+#define __device__
+#define __global__
+#define __forceinline__ inline
+#define __inline__ inline
+// Constant memory is private to each CUDA translation unit (no relocatable
+// device code), which is also how the simulation parameters are copied.
+#define __constant__ static
+
+// ----------------------------------------------------------------------------
+// Built-in vector types (same layout and alignment as in CUDA)
+// ----------------------------------------------------------------------------
+
+struct alignas(8) int2 {
+    int x, y;
+};
+struct int3 {
+    int x, y, z;
+};
+struct alignas(16) int4 {
+    int x, y, z, w;
+};
+struct alignas(8) uint2 {
+    unsigned int x, y;
+};
+struct uint3 {
+    unsigned int x, y, z;
+};
+struct alignas(16) uint4 {
+    unsigned int x, y, z, w;
+};
+struct alignas(8) float2 {
+    float x, y;
+};
+struct float3 {
+    float x, y, z;
+};
+struct alignas(16) float4 {
+    float x, y, z, w;
+};
+struct alignas(16) double2 {
+    double x, y;
+};
+struct double3 {
+    double x, y, z;
+};
+struct alignas(16) double4 {
+    double x, y, z, w;
+};
+
+// Constructors of the vector types. Within chrono::fsi they are hidden by the
+// overloads of custom_math.h, as the CUDA ones are.
+inline int2 make_int2(int x, int y) {
+    return {x, y};
+}
+
+inline int3 make_int3(int x, int y, int z) {
+    return {x, y, z};
+}
+
+inline int4 make_int4(int x, int y, int z, int w) {
+    return {x, y, z, w};
+}
+
+inline uint2 make_uint2(unsigned int x, unsigned int y) {
+    return {x, y};
+}
+
+inline uint3 make_uint3(unsigned int x, unsigned int y, unsigned int z) {
+    return {x, y, z};
+}
+
+inline uint4 make_uint4(unsigned int x, unsigned int y, unsigned int z, unsigned int w) {
+    return {x, y, z, w};
+}
+
+inline float2 make_float2(float x, float y) {
+    return {x, y};
+}
+
+inline float3 make_float3(float x, float y, float z) {
+    return {x, y, z};
+}
+
+inline float4 make_float4(float x, float y, float z, float w) {
+    return {x, y, z, w};
+}
+
+inline double2 make_double2(double x, double y) {
+    return {x, y};
+}
+
+inline double3 make_double3(double x, double y, double z) {
+    return {x, y, z};
+}
+
+inline double4 make_double4(double x, double y, double z, double w) {
+    return {x, y, z, w};
+}
+
+struct dim3 {
+    unsigned int x, y, z;
+    dim3(unsigned int vx = 1, unsigned int vy = 1, unsigned int vz = 1) : x(vx), y(vy), z(vz) {}
+};
+
+// ----------------------------------------------------------------------------
+// Thread indices of the kernel being executed by the calling thread
+// ----------------------------------------------------------------------------
+
+extern thread_local uint3 threadIdx;
+extern thread_local uint3 blockIdx;
+extern thread_local dim3 blockDim;
+extern thread_local dim3 gridDim;
+
+// ----------------------------------------------------------------------------
+// Device functions
+// ----------------------------------------------------------------------------
+
+/// Atomic addition; unlike the CUDA function, the previous value is not returned.
+inline void atomicAdd(double* address, double val) {
+#pragma omp atomic
+    *address += val;
+}
+
+inline void atomicAdd(float* address, float val) {
+#pragma omp atomic
+    *address += val;
+}
+
+inline void atomicAdd(int* address, int val) {
+#pragma omp atomic
+    *address += val;
+}
+
+inline void atomicAdd(unsigned int* address, unsigned int val) {
+#pragma omp atomic
+    *address += val;
+}
+
+inline int __mul24(int x, int y) {
+    return x * y;
+}
+
+// The CUDA math functions are also declared in the global namespace
+using std::isfinite;
+using std::isinf;
+using std::isnan;
+
+// ----------------------------------------------------------------------------
+// Runtime API (all memory is host memory, all calls are synchronous)
+// ----------------------------------------------------------------------------
+
+enum cudaError { cudaSuccess = 0 };
+typedef enum cudaError cudaError_t;
+
+enum cudaMemcpyKind {
+    cudaMemcpyHostToHost = 0,
+    cudaMemcpyHostToDevice = 1,
+    cudaMemcpyDeviceToHost = 2,
+    cudaMemcpyDeviceToDevice = 3,
+    cudaMemcpyDefault = 4
+};
+
+typedef void* cudaStream_t;
+
+inline cudaError_t cudaGetLastError() {
+    return cudaSuccess;
+}
+
+inline const char* cudaGetErrorString(cudaError_t error) {
+    return "no error";
+}
+
+inline cudaError_t cudaDeviceSynchronize() {
+    return cudaSuccess;
+}
+
+inline cudaError_t cudaMalloc(void** ptr, size_t size) {
+    *ptr = std::malloc(size);
+    return cudaSuccess;
+}
+
+inline cudaError_t cudaFree(void* ptr) {
+    std::free(ptr);
+    return cudaSuccess;
+}
+
+inline cudaError_t cudaMemset(void* ptr, int value, size_t count) {
+    std::memset(ptr, value, count);
+    return cudaSuccess;
+}
+
+inline cudaError_t cudaMemcpy(void* dst, const void* src, size_t count, cudaMemcpyKind kind) {
+    std::memcpy(dst, src, count);
+    return cudaSuccess;
+}
+
+template <class T>
+cudaError_t cudaMemcpyToSymbol(T& symbol,
+                               const void* src,
+                               size_t count,
+                               size_t offset = 0,
+                               cudaMemcpyKind kind = cudaMemcpyHostToDevice) {
+    std::memcpy(reinterpret_cast<char*>(&symbol) + offset, src, count);
+    return cudaSuccess;
+}
+
+template <class T>
+cudaError_t cudaMemcpyToSymbolAsync(T& symbol,
+                                    const void* src,
+                                    size_t count,
+                                    size_t offset = 0,
+                                    cudaMemcpyKind kind = cudaMemcpyHostToDevice,
+                                    cudaStream_t stream = 0) {
+    return cudaMemcpyToSymbol(symbol, src, count, offset, kind);
+}
+
+template <class T>
+cudaError_t cudaMemcpyFromSymbol(void* dst,
+                                 const T& symbol,
+                                 size_t count,
+                                 size_t offset = 0,
+                                 cudaMemcpyKind kind = cudaMemcpyDeviceToHost) {
+    std::memcpy(dst, reinterpret_cast<const char*>(&symbol) + offset, count);
+    return cudaSuccess;
+}
+
+// Events record wall clock time points.
+typedef std::chrono::high_resolution_clock::time_point* cudaEvent_t;
+
+inline cudaError_t cudaEventCreate(cudaEvent_t* event) {
+    *event = new std::chrono::high_resolution_clock::time_point;
+    return cudaSuccess;
+}
+
+inline cudaError_t cudaEventDestroy(cudaEvent_t event) {
+    delete event;
+    return cudaSuccess;
+}
+
+inline cudaError_t cudaEventRecord(cudaEvent_t event, cudaStream_t stream = 0) {
+    *event = std::chrono::high_resolution_clock::now();
+    return cudaSuccess;
+}
+
+inline cudaError_t cudaEventSynchronize(cudaEvent_t event) {
+    return cudaSuccess;
+}
+
+inline cudaError_t cudaEventElapsedTime(float* ms, cudaEvent_t start, cudaEvent_t end) {
+    *ms = std::chrono::duration<float, std::milli>(*end - *start).count();
+    return cudaSuccess;
+}
+
+// ----------------------------------------------------------------------------
+// Kernel launches
+// ----------------------------------------------------------------------------
+
+namespace chrono {
+namespace fsi {
+
+/// Launch of a kernel on the host.
+/// The thread blocks are distributed over the OpenMP threads; the threads of a
+/// block are executed in sequence by the same OpenMP thread. Kernels must not
+/// synchronize the threads of a block (__syncthreads) or use shared memory.
+/// The kernel is called through a generic lambda (see CH_FSI_LAUNCH), so that
+/// overloaded kernels are resolved from the launch arguments, as with <<<...>>>.
+template <typename Kernel>
+class ChHostKernelLaunch {
+  public:
+    ChHostKernelLaunch(Kernel kernel, dim3 grid, dim3 block) : m_kernel(kernel), m_grid(grid), m_block(block) {}
+
+    template <typename... Args>
+    void operator()(Args&&... args) const {
+        Kernel kernel = m_kernel;
+        dim3 grid = m_grid;
+        dim3 block = m_block;
+        int num_blocks = (int)grid.x;
+
+#pragma omp parallel for schedule(dynamic)
+        for (int ib = 0; ib < num_blocks; ib++) {
+            gridDim = grid;
+            blockDim = block;
+            blockIdx = {(unsigned int)ib, 0, 0};
+            for (unsigned int it = 0; it < block.x; it++) {
+                threadIdx = {it, 0, 0};
+                kernel(args...);
+            }
+        }
+    }
+
+  private:
+    Kernel m_kernel;
+    dim3 m_grid;
+    dim3 m_block;
+};
+
+template <typename Kernel>
+ChHostKernelLaunch<Kernel> HostKernelLaunch(Kernel kernel, dim3 grid, dim3 block, size_t shared_mem = 0) {
+    return ChHostKernelLaunch<Kernel>(kernel, grid, block);
+}
+
+}  // end namespace fsi
+}  // end namespace chrono
+
+#define CH_FSI_LAUNCH(kernel, ...)                                                                  \
+    ::chrono::fsi::HostKernelLaunch(                                                                \
+        [](auto&&... kernel_args) { kernel(std::forward<decltype(kernel_args)>(kernel_args)...); }, \
+        __VA_ARGS__)
+
+#endif
+
+#endif
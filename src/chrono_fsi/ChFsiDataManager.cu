@@ -15,6 +15,7 @@
 // Base class for managing data in chrono_fsi, aka fluid system.//
 // =============================================================================
 
+#include <iostream>
 #include <thrust/sort.h>
 #include "chrono_fsi/ChDeviceUtils.cuh"
 #include "chrono_fsi/ChFsiDataManager.cuh"
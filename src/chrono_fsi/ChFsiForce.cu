@@ -15,6 +15,7 @@
 // Base class for processing sph force in fsi system.//
 // =============================================================================
 
+#include <iostream>
 #include <thrust/extrema.h>
 #include <thrust/sort.h>
 #include "chrono_fsi/ChDeviceUtils.cuh"
@@ -421,7 +421,7 @@ void ChFsiForceExplicitSPH::CalculateXSPH_velocity() {
     computeGridSize(numObjectsH->numAllMarkers, 64, numBlocks, numThreads);
 
     /* Execute the kernel */
-    newVel_XSPH_D<<<numBlocks, numThreads>>>(
+    CH_FSI_LAUNCH(newVel_XSPH_D, numBlocks, numThreads)(
         mR3CAST(vel_XSPH_Sorted_D), mR4CAST(sortedSphMarkersD->posRadD), mR3CAST(sortedSphMarkersD->velMasD),
         mR4CAST(sortedSphMarkersD->rhoPresMuD), U1CAST(markersProximityD->gridMarkerIndexD),
         U1CAST(markersProximityD->cellStartD), U1CAST(markersProximityD->cellEndD), numObjectsH->numAllMarkers,
@@ -469,7 +469,7 @@ void ChFsiForceExplicitSPH::collide(
     computeGridSize(numObjectsH->numAllMarkers, 64, numBlocks, numThreads);
 
     // execute the kernel
-    collideD<<<numBlocks, numThreads>>>(
+    CH_FSI_LAUNCH(collideD, numBlocks, numThreads)(
         mR4CAST(sortedDerivVelRho_fsi_D), mR4CAST(sortedPosRad), mR3CAST(sortedVelMas), mR3CAST(vel_XSPH_Sorted_D),
         mR4CAST(sortedRhoPreMu), mR3CAST(velMas_ModifiedBCE), mR4CAST(rhoPreMu_ModifiedBCE), U1CAST(gridMarkerIndex),
         U1CAST(cellStart), U1CAST(cellEnd), numObjectsH->numAllMarkers, isErrorD);
@@ -11,6 +11,7 @@
 // =============================================================================
 // Author: Milad Rakhsha
 // =============================================================================
+#include <iostream>
 #include <thrust/extrema.h>
 #include <thrust/sort.h>
 #include "chrono_fsi/ChFsiForceIISPH.cuh"
@@ -19,6 +20,7 @@
 //==========================================================================================================================================
 namespace chrono {
 namespace fsi {
+#ifndef CHRONO_FSI_HOST
 // double precision atomic add function
 __device__ inline double datomicAdd(double* address, double val) {
     unsigned long long int* address_as_ull = (unsigned long long int*)address;
@@ -32,6 +34,7 @@ __device__ inline double datomicAdd(double* address, double val) {
 
     return __longlong_as_double(old);
 }
+#endif
 
 ChFsiForceIISPH::ChFsiForceIISPH(
     ChBce* otherBceWorker,                   ///< Pointer to the ChBce object that handles BCE markers
@@ -1497,7 +1500,7 @@ void ChFsiForceIISPH::calcPressureIISPH(thrust::device_vector<Real4> velMassRigi
     thrust::fill(V_np.begin(), V_np.end(), mR3(0.0));
     *isErrorH = false;
     cudaMemcpy(isErrorD, isErrorH, sizeof(bool), cudaMemcpyHostToDevice);
-    V_i_np__AND__d_ii_kernel<<<numBlocks, numThreads>>>(
+    CH_FSI_LAUNCH(V_i_np__AND__d_ii_kernel, numBlocks, numThreads)(
         mR4CAST(sortedSphMarkersD->posRadD), mR3CAST(sortedSphMarkersD->velMasD),
         mR4CAST(sortedSphMarkersD->rhoPresMuD), mR3CAST(d_ii), mR3CAST(V_np), R1CAST(sumWij_inv), R1CAST(G_i),
         R1CAST(L_i), U1CAST(markersProximityD->cellStartD), U1CAST(markersProximityD->cellEndD), paramsH->dT,
@@ -1519,7 +1522,7 @@ void ChFsiForceIISPH::calcPressureIISPH(thrust::device_vector<Real4> velMassRigi
 
     *isErrorH = false;
     cudaMemcpy(isErrorD, isErrorH, sizeof(bool), cudaMemcpyHostToDevice);
-    Rho_np_AND_a_ii_AND_sum_m_GradW<<<numBlocks, numThreads>>>(
+    CH_FSI_LAUNCH(Rho_np_AND_a_ii_AND_sum_m_GradW, numBlocks, numThreads)(
         mR4CAST(sortedSphMarkersD->posRadD), mR4CAST(sortedSphMarkersD->rhoPresMuD), R1CAST(rho_np), R1CAST(a_ii),
         R1CAST(p_old), mR3CAST(V_np), mR3CAST(d_ii), mR3CAST(summGradW), U1CAST(markersProximityD->cellStartD),
         U1CAST(markersProximityD->cellEndD), paramsH->dT, numAllMarkers, isErrorD);
@@ -1572,7 +1575,7 @@ void ChFsiForceIISPH::calcPressureIISPH(thrust::device_vector<Real4> velMassRigi
 
         *isErrorH = false;
         cudaMemcpy(isErrorD, isErrorH, sizeof(bool), cudaMemcpyHostToDevice);
-        CalcNumber_Contacts<<<numBlocks, numThreads>>>(
+        CH_FSI_LAUNCH(CalcNumber_Contacts, numBlocks, numThreads)(
             U1CAST(numContacts), mR4CAST(sortedSphMarkersD->posRadD), mR4CAST(sortedSphMarkersD->rhoPresMuD),
             U1CAST(markersProximityD->cellStartD), U1CAST(markersProximityD->cellEndD), numAllMarkers, isErrorD);
 
@@ -1603,7 +1606,7 @@ void ChFsiForceIISPH::calcPressureIISPH(thrust::device_vector<Real4> velMassRigi
         std::cout << "updatePortion of  BC: " << updatePortion.x << " " << updatePortion.y << " " << updatePortion.z
                   << " " << updatePortion.w << "\n ";
 
-        FormAXB<<<numBlocks, numThreads>>>(
+        CH_FSI_LAUNCH(FormAXB, numBlocks, numThreads)(
             R1CAST(csrValA), U1CAST(csrColIndA), LU1CAST(GlobalcsrColIndA), U1CAST(numContacts), R1CAST(a_ij),
             R1CAST(B_i), mR3CAST(d_ii), R1CAST(a_ii), mR3CAST(summGradW), mR4CAST(sortedSphMarkersD->posRadD),
             mR3CAST(sortedSphMarkersD->velMasD), mR4CAST(sortedSphMarkersD->rhoPresMuD), mR3CAST(V_new), R1CAST(p_old),
@@ -1666,9 +1669,9 @@ void ChFsiForceIISPH::calcPressureIISPH(thrust::device_vector<Real4> velMassRigi
            Iteration < paramsH->LinearSolver_Max_Iter) {
         *isErrorH = false;
         cudaMemcpy(isErrorD, isErrorH, sizeof(bool), cudaMemcpyHostToDevice);
-        Initialize_Variables<<<numBlocks, numThreads>>>(mR4CAST(sortedSphMarkersD->rhoPresMuD), R1CAST(p_old),
-                                                        mR3CAST(sortedSphMarkersD->velMasD), mR3CAST(V_new),
-                                                        numAllMarkers, isErrorD);
+        CH_FSI_LAUNCH(Initialize_Variables, numBlocks, numThreads)(
+            mR4CAST(sortedSphMarkersD->rhoPresMuD), R1CAST(p_old), mR3CAST(sortedSphMarkersD->velMasD), mR3CAST(V_new),
+            numAllMarkers, isErrorD);
         cudaDeviceSynchronize();
         cudaCheckError();
         cudaMemcpy(isErrorH, isErrorD, sizeof(bool), cudaMemcpyDeviceToHost);
@@ -1679,7 +1682,7 @@ void ChFsiForceIISPH::calcPressureIISPH(thrust::device_vector<Real4> velMassRigi
         if (mySolutionType == MATRIX_FREE) {
             *isErrorH = false;
             cudaMemcpy(isErrorD, isErrorH, sizeof(bool), cudaMemcpyHostToDevice);
-            Calc_dij_pj<<<numBlocks, numThreads>>>(
+            CH_FSI_LAUNCH(Calc_dij_pj, numBlocks, numThreads)(
                 mR3CAST(dij_pj), mR3CAST(F_p), mR3CAST(d_ii), mR4CAST(sortedSphMarkersD->posRadD),
                 mR3CAST(sortedSphMarkersD->velMasD), mR4CAST(sortedSphMarkersD->rhoPresMuD), R1CAST(p_old),
                 U1CAST(markersProximityD->cellStartD), U1CAST(markersProximityD->cellEndD), paramsH->dT, numAllMarkers,
@@ -1693,7 +1696,7 @@ void ChFsiForceIISPH::calcPressureIISPH(thrust::device_vector<Real4> velMassRigi
 
             *isErrorH = false;
             cudaMemcpy(isErrorD, isErrorH, sizeof(bool), cudaMemcpyHostToDevice);
-            Calc_Pressure<<<numBlocks, numThreads>>>(
+            CH_FSI_LAUNCH(Calc_Pressure, numBlocks, numThreads)(
                 R1CAST(a_ii), mR3CAST(d_ii), mR3CAST(dij_pj), R1CAST(rho_np), R1CAST(rho_p), R1CAST(Residuals),
                 mR3CAST(F_p), mR4CAST(sortedSphMarkersD->posRadD), mR3CAST(sortedSphMarkersD->velMasD),
                 mR4CAST(sortedSphMarkersD->rhoPresMuD), mR4CAST(velMassRigid_fsiBodies_D),
@@ -1715,7 +1718,7 @@ void ChFsiForceIISPH::calcPressureIISPH(thrust::device_vector<Real4> velMassRigi
         if (mySolutionType == FORM_SPARSE_MATRIX) {
             *isErrorH = false;
             cudaMemcpy(isErrorD, isErrorH, sizeof(bool), cudaMemcpyHostToDevice);
-            Calc_Pressure_AXB_USING_CSR<<<numBlocks, numThreads>>>(
+            CH_FSI_LAUNCH(Calc_Pressure_AXB_USING_CSR, numBlocks, numThreads)(
                 R1CAST(csrValA), R1CAST(a_ii), U1CAST(csrColIndA), U1CAST(numContacts),
                 mR4CAST(sortedSphMarkersD->rhoPresMuD), R1CAST(sumWij_inv), mR3CAST(sortedSphMarkersD->velMasD),
                 mR3CAST(V_new), R1CAST(p_old), R1CAST(B_i), R1CAST(Residuals), numAllMarkers, isErrorD);
@@ -1729,7 +1732,7 @@ void ChFsiForceIISPH::calcPressureIISPH(thrust::device_vector<Real4> velMassRigi
         *isErrorH = false;
         cudaMemcpy(isErrorD, isErrorH, sizeof(bool), cudaMemcpyHostToDevice);
 
-        Update_AND_Calc_Res<<<numBlocks, numThreads>>>(
+        CH_FSI_LAUNCH(Update_AND_Calc_Res, numBlocks, numThreads)(
             mR3CAST(sortedSphMarkersD->velMasD), mR4CAST(sortedSphMarkersD->rhoPresMuD), R1CAST(p_old), mR3CAST(V_new),
             R1CAST(rho_p), R1CAST(rho_np), R1CAST(Residuals), numAllMarkers, Iteration, paramsH->PPE_relaxation, false,
             isErrorD);
@@ -1773,7 +1776,7 @@ void ChFsiForceIISPH::calcPressureIISPH(thrust::device_vector<Real4> velMassRigi
         //        printf("Shifting pressure values by %f\n", -shift_p);
         *isErrorH = false;
         cudaMemcpy(isErrorD, isErrorH, sizeof(bool), cudaMemcpyHostToDevice);
-        FinalizePressure<<<numBlocks, numThreads>>>(
+        CH_FSI_LAUNCH(FinalizePressure, numBlocks, numThreads)(
             mR4CAST(sortedSphMarkersD->posRadD), mR4CAST(sortedSphMarkersD->rhoPresMuD), R1CAST(p_old), mR3CAST(F_p),
             U1CAST(markersProximityD->cellStartD), U1CAST(markersProximityD->cellEndD), numAllMarkers, shift_p,
             isErrorD);
@@ -1884,7 +1887,7 @@ void ChFsiForceIISPH::ForceSPH(SphMarkerDataD* otherSphMarkersD,
 
     thrust::device_vector<uint> Contact_i(numAllMarkers);
     thrust::fill(Contact_i.begin(), Contact_i.end(), 0);
-    calcRho_kernel<<<numBlocks, numThreads>>>(
+    CH_FSI_LAUNCH(calcRho_kernel, numBlocks, numThreads)(
         mR4CAST(sortedSphMarkersD->posRadD), mR4CAST(sortedSphMarkersD->rhoPresMuD), R1CAST(_sumWij_inv),
         U1CAST(markersProximityD->cellStartD), U1CAST(markersProximityD->cellEndD), U1CAST(Contact_i), numAllMarkers,
         isErrorD);
@@ -1898,7 +1901,7 @@ void ChFsiForceIISPH::ForceSPH(SphMarkerDataD* otherSphMarkersD,
     thrust::device_vector<Real3> Normals(numAllMarkers);
 
     if (paramsH->Conservative_Form) {
-        calcNormalizedRho_kernel<<<numBlocks, numThreads>>>(
+        CH_FSI_LAUNCH(calcNormalizedRho_kernel, numBlocks, numThreads)(
             mR4CAST(sortedSphMarkersD->posRadD), mR3CAST(sortedSphMarkersD->velMasD),
             mR4CAST(sortedSphMarkersD->rhoPresMuD), R1CAST(_sumWij_inv), R1CAST(G_i), mR3CAST(Normals), R1CAST(Color),
             U1CAST(markersProximityD->cellStartD), U1CAST(markersProximityD->cellEndD), numAllMarkers, isErrorD);
@@ -1916,7 +1919,7 @@ void ChFsiForceIISPH::ForceSPH(SphMarkerDataD* otherSphMarkersD,
 
         thrust::device_vector<uint> csrColInd(NNZ);
 
-        calcNormalizedRho_Gi_fillInMatrixIndices<<<numBlocks, numThreads>>>(
+        CH_FSI_LAUNCH(calcNormalizedRho_Gi_fillInMatrixIndices, numBlocks, numThreads)(
             mR4CAST(sortedSphMarkersD->posRadD), mR3CAST(sortedSphMarkersD->velMasD),
             mR4CAST(sortedSphMarkersD->rhoPresMuD), R1CAST(_sumWij_inv), R1CAST(G_i), mR3CAST(Normals),
             U1CAST(csrColInd), U1CAST(Contact_i), U1CAST(markersProximityD->cellStartD),
@@ -1927,9 +1930,9 @@ void ChFsiForceIISPH::ForceSPH(SphMarkerDataD* otherSphMarkersD,
         if (*isErrorH == true) {
             throw std::runtime_error("Error! program crashed after calcNormalizedRho_kernel!\n");
         }
-        calc_A_tensor<<<numBlocks, numThreads>>>(R1CAST(A_i), R1CAST(G_i), mR4CAST(sortedSphMarkersD->posRadD),
-                                                 mR4CAST(sortedSphMarkersD->rhoPresMuD), R1CAST(_sumWij_inv),
-                                                 U1CAST(csrColInd), U1CAST(Contact_i), numAllMarkers, isErrorD);
+        CH_FSI_LAUNCH(calc_A_tensor, numBlocks, numThreads)(
+            R1CAST(A_i), R1CAST(G_i), mR4CAST(sortedSphMarkersD->posRadD), mR4CAST(sortedSphMarkersD->rhoPresMuD),
+            R1CAST(_sumWij_inv), U1CAST(csrColInd), U1CAST(Contact_i), numAllMarkers, isErrorD);
 
         cudaDeviceSynchronize();
         cudaCheckError();
@@ -1938,10 +1941,10 @@ void ChFsiForceIISPH::ForceSPH(SphMarkerDataD* otherSphMarkersD,
             throw std::runtime_error("Error! program crashed after calcRho_kernel!\n");
         }
 
-        calc_L_tensor<<<numBlocks, numThreads>>>(R1CAST(A_i), R1CAST(L_i), R1CAST(G_i),
-                                                 mR4CAST(sortedSphMarkersD->posRadD),
-                                                 mR4CAST(sortedSphMarkersD->rhoPresMuD), R1CAST(_sumWij_inv),
-                                                 U1CAST(csrColInd), U1CAST(Contact_i), numAllMarkers, isErrorD);
+        CH_FSI_LAUNCH(calc_L_tensor, numBlocks, numThreads)(
+            R1CAST(A_i), R1CAST(L_i), R1CAST(G_i), mR4CAST(sortedSphMarkersD->posRadD),
+            mR4CAST(sortedSphMarkersD->rhoPresMuD), R1CAST(_sumWij_inv), U1CAST(csrColInd), U1CAST(Contact_i),
+            numAllMarkers, isErrorD);
         cudaDeviceSynchronize();
         cudaCheckError();
         cudaMemcpy(isErrorH, isErrorD, sizeof(bool), cudaMemcpyDeviceToHost);
@@ -1968,7 +1971,7 @@ void ChFsiForceIISPH::ForceSPH(SphMarkerDataD* otherSphMarkersD,
 
     thrust::device_vector<Real3> NEW_Vel(numAllMarkers, mR3(0.0));
 
-    CalcForces<<<numBlocks, numThreads>>>(
+    CH_FSI_LAUNCH(CalcForces, numBlocks, numThreads)(
         mR3CAST(NEW_Vel), mR4CAST(derivVelRhoD_Sorted_D), mR4CAST(sortedSphMarkersD->posRadD),
         mR3CAST(sortedSphMarkersD->velMasD), mR4CAST(sortedSphMarkersD->rhoPresMuD), R1CAST(_sumWij_inv), R1CAST(p_old),
         R1CAST(G_i), R1CAST(L_i), mR3CAST(dr_shift), U1CAST(markersProximityD->cellStartD),
@@ -1995,7 +1998,7 @@ void ChFsiForceIISPH::ForceSPH(SphMarkerDataD* otherSphMarkersD,
     thrust::fill(helpers_normal.begin(), helpers_normal.end(), mR3(0));
 
     sortedSphMarkersD->velMasD = NEW_Vel;
-    UpdateDensity<<<numBlocks, numThreads>>>(
+    CH_FSI_LAUNCH(UpdateDensity, numBlocks, numThreads)(
         mR3CAST(vel_vis_Sorted_D), mR3CAST(vel_XSPH_Sorted_D), mR3CAST(sortedSphMarkersD->velMasD),
         mR4CAST(sortedSphMarkersD->posRadD), mR4CAST(sortedSphMarkersD->rhoPresMuD), R1CAST(_sumWij_inv),
         U1CAST(markersProximityD->cellStartD), U1CAST(markersProximityD->cellEndD), numAllMarkers, isErrorD);
@@ -19,13 +19,11 @@
 #define CHFSILINEARSOLVER_H_
 
 #include <ctype.h>
-#include <cuda_runtime.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 #include <typeinfo>
-#include "cublas_v2.h"
-#include "cusparse_v2.h"
+#include "chrono_fsi/ChFsiBackend.h"
 
 namespace chrono {
 namespace fsi {
@@ -17,17 +17,23 @@
 
 #include <chrono_fsi/ChFsiLinearSolverBiCGStab.h>
 #include <ctype.h>
-#include <cuda_runtime.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <cmath>
 #include <typeinfo>
+#include <vector>
+#ifndef CHRONO_FSI_HOST
+#include <cuda_runtime.h>
 #include "cublas_v2.h"
 #include "cusparse_v2.h"
+#endif
 
 namespace chrono {
 namespace fsi {
 
+#ifndef CHRONO_FSI_HOST
+
 void ChFsiLinearSolverBiCGStab::Solve(int SIZE,
                                       int NNZ,
                                       double* A,
@@ -303,5 +309,122 @@ void ChFsiLinearSolverBiCGStab::Solve(int SIZE,
     cudaFree(M);
 }
 
+#else
+
+// y = A*x, with A in CSR format
+static void CsrMv(int SIZE,
+                  const double* A,
+                  const unsigned int* ArowIdx,
+                  const unsigned int* AcolIdx,
+                  const double* x,
+                  double* y) {
+#pragma omp parallel for
+    for (int i = 0; i < SIZE; i++) {
+        double sum = 0;
+#pragma omp simd reduction(+ : sum)
+        for (unsigned int k = ArowIdx[i]; k < ArowIdx[i + 1]; k++)
+            sum += A[k] * x[AcolIdx[k]];
+        y[i] = sum;
+    }
+}
+
+static double Dot(int SIZE, const double* x, const double* y) {
+    double sum = 0;
+#pragma omp parallel for simd reduction(+ : sum)
+    for (int i = 0; i < SIZE; i++)
+        sum += x[i] * y[i];
+    return sum;
+}
+
+// y = a*x + y
+static void Axpy(int SIZE, double a, const double* x, double* y) {
+#pragma omp parallel for simd
+    for (int i = 0; i < SIZE; i++)
+        y[i] += a * x[i];
+}
+
+// Same iterations as the CUDA implementation (no preconditioner), with OpenMP loops in place of the CUBLAS and
+// CUSPARSE calls.
+void ChFsiLinearSolverBiCGStab::Solve(int SIZE,
+                                      int NNZ,
+                                      double* A,
+                                      unsigned int* ArowIdx,
+                                      unsigned int* AcolIdx,
+                                      double* x,
+                                      double* b) {
+    std::vector<double> r(SIZE), r_old(SIZE), rh(SIZE), p(SIZE, 0.0), AMp(SIZE, 0.0), s(SIZE), AMs(SIZE);
+
+    double rho = 1, rho_old = 1, beta = 1, alpha = 1, omega = 1, temp = 1, temp2 = 1;
+    double nrmr, nrmr0;
+
+    // compute initial residual r0=b-Ax0 (using initial guess in x)
+    CsrMv(SIZE, A, ArowIdx, AcolIdx, x, r.data());
+#pragma omp parallel for simd
+    for (int i = 0; i < SIZE; i++)
+        r[i] = b[i] - r[i];
+    nrmr0 = std::sqrt(Dot(SIZE, r.data(), r.data()));
+    nrmr = nrmr0;
+    rh = r;
+    r_old = r;
+    rho_old = Dot(SIZE, rh.data(), r.data());
+
+    for (Iterations = 0; Iterations < max_iter; Iterations++) {
+        rho = Dot(SIZE, rh.data(), r_old.data());
+
+        // p_{j+1} = r_{j+1} + beta*(p_j - omega*A*p)
+        beta = rho / rho_old * alpha / omega;
+#pragma omp parallel for simd
+        for (int i = 0; i < SIZE; i++)
+            p[i] = beta * p[i] + r_old[i] - beta * omega * AMp[i];
+
+        // AMp=A*p
+        CsrMv(SIZE, A, ArowIdx, AcolIdx, p.data(), AMp.data());
+
+        // alpha=rho/(rh'*AMp)
+        temp = Dot(SIZE, rh.data(), AMp.data());
+        alpha = rho / temp;
+        nrmr = std::sqrt(Dot(SIZE, p.data(), p.data()));
+
+        if (nrmr < rel_res * nrmr0 || nrmr < abs_res) {
+            // x = x+ alpha*p
+            Axpy(SIZE, alpha, p.data(), x);
+            residual = nrmr;
+            solver_status = 1;
+            break;
+        }
+
+        // s = r_old-alpha*AMp
+#pragma omp parallel for simd
+        for (int i = 0; i < SIZE; i++)
+            s[i] = r_old[i] - alpha * AMp[i];
+
+        // AMs=A*s
+        CsrMv(SIZE, A, ArowIdx, AcolIdx, s.data(), AMs.data());
+
+        // w_new
+        temp = Dot(SIZE, AMs.data(), s.data());
+        temp2 = Dot(SIZE, AMs.data(), AMs.data());
+        omega = temp / temp2;
+
+        // x_{j+1} = x_j + alpha*p + omega*s
+        // r_{j+1} = s_j - omega*AMs
+#pragma omp parallel for simd
+        for (int i = 0; i < SIZE; i++) {
+            x[i] += alpha * p[i] + omega * s[i];
+            r[i] = s[i] - omega * AMs[i];
+        }
+        nrmr = std::sqrt(Dot(SIZE, r.data(), r.data()));
+        r_old = r;
+
+        rho_old = rho;
+        residual = nrmr;
+
+        if (verbose)
+            printf("Iterations=%d\t ||b-A*x||=%.4e\n", Iterations, nrmr);
+    }
+}
+
+#endif
+
 }  // end namespace fsi
 }  // end namespace chrono
@@ -20,13 +20,11 @@
 
 #include <chrono_fsi/ChFsiLinearSolver.h>
 #include <ctype.h>
-#include <cuda_runtime.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 #include <typeinfo>
-#include "cublas_v2.h"
-#include "cusparse_v2.h"
+#include "chrono_fsi/ChFsiBackend.h"
 
 namespace chrono {
 namespace fsi {
@@ -35,7 +33,7 @@ typedef char MM_typecode[4];
 /// @addtogroup fsi_solver
 /// @{
 
-/// @brief GPU implementation of BICGSTAB method via CUDA libraries
+/// @brief Implementation of BICGSTAB method via CUDA libraries (or OpenMP loops with the host backend)
 class ChFsiLinearSolverBiCGStab : public ChFsiLinearSolver {
   public:
     ChFsiLinearSolverBiCGStab(double mrel_res = 1e-8,  ///< relative residual of the linear solver
@@ -19,10 +19,13 @@
 // ----------------------------------------------------------------------------
 // CUDA headers
 // ----------------------------------------------------------------------------
+#include "chrono_fsi/ChFsiBackend.h"
+#ifndef CHRONO_FSI_HOST
 #include <cuda.h>
 #include <cuda_runtime.h>
 #include <cuda_runtime_api.h>
 #include <device_launch_parameters.h>
+#endif
 #include "chrono_fsi/ChApiFsi.h"
 #include "chrono_fsi/ChDeviceUtils.cuh"
 #include "chrono_fsi/ChFsiDataManager.cuh"
@@ -17,7 +17,7 @@
 #ifndef CH_SOLVER6X6_H_
 #define CH_SOLVER6X6_H_
 
-#include <cuda_runtime.h>  // for __host__ __device__ flags
+#include "chrono_fsi/ChFsiBackend.h"  // for __host__ __device__ flags
 #include "chrono_fsi/ChConfigFSI.h"
 namespace chrono {
 namespace fsi {
@@ -20,8 +20,8 @@
 #ifndef CHFSI_CUSTOM_MATH_H
 #define CHFSI_CUSTOM_MATH_H
 
-#include <cuda_runtime.h>  // for __host__ __device__ flags
 #include "chrono_fsi/ChConfigFSI.h"
+#include "chrono_fsi/ChFsiBackend.h"  // for __host__ __device__ flags
 #ifndef __CUDACC__
 #include <cmath>
 #endif
@@ -17,6 +17,7 @@
 
 #include <cstdio>
 #include <fstream>
+#include <iostream>
 #include <sstream>
 
 #include "chrono_fsi/ChDeviceUtils.cuh"
@@ -17,6 +17,8 @@
 #ifndef CHUTILSPRINTSTRUCT_H
 #define CHUTILSPRINTSTRUCT_H
 
+#include <iostream>
+
 #include "chrono_fsi/ChApiFsi.h"
 #include "chrono_fsi/custom_math.h"
 #include <thrust/device_vector.h>
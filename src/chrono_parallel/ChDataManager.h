@@ -381,6 +381,9 @@ struct host_container {
     /// a temporary variable used here for illustrative purposes. In reality the
     /// entire operation happens inline without a temp variable.
     CompressedMatrix<real> M_invD;
+    /// Single precision D_T and M_invD, used by the Schur products in mixed precision mode (where M_invD is
+    /// not computed).
+    CompressedMatrix<float> D_T_single, M_invD_single;
 
     DynamicVector<real> R_full;  ///< The right hand side of the system
     DynamicVector<real> R;       ///< The rhs of the system, changes during solve
@@ -405,6 +408,33 @@ struct host_container {
     custom_vector<uint> bin_aabb_number;
     custom_vector<uint> bin_start_index;
     custom_vector<uint> bin_num_contact;
+
+    // Incremental grid broadphase (see collision_settings::incremental_broadphase)
+    custom_vector<real3> bin_aabb_min;         ///< Inflated AABBs the bins were computed with
+    custom_vector<real3> bin_aabb_max;         ///< Inflated AABBs the bins were computed with
+    custom_vector<short2> bin_fam;             ///< Collision families the pairs were computed with
+    custom_vector<uint> bin_id;                ///< Shape bodies the pairs were computed with
+    custom_vector<char> bin_active;            ///< Body activity the pairs were computed with
+    custom_vector<char> bin_collide;           ///< Body collision flags the pairs were computed with
+    custom_vector<char> bin_moved;             ///< Shapes which left their inflated AABB
+    custom_vector<uint> bin_moved_shapes;      ///< List of the shapes which left their inflated AABB
+    custom_vector<uint> bin_number_moved;      ///< Bins intersected by the moved shapes
+    custom_vector<uint> bin_aabb_number_moved;
+    custom_vector<uint> bin_number_merged;     ///< Bin intersections after the update
+    custom_vector<uint> bin_aabb_number_merged;
+    custom_vector<long long> bin_pairs;        ///< Pairs of overlapping inflated AABBs
+
+    // For n leaves, nodes 0..n-2 of the hierarchy are internal (0 is the root)
+    // and nodes n-1..2n-2 are the leaves, in Morton order.
+    custom_vector<long long> bvh_keys;   ///< Morton code (high bits) and shape index (low bits) of each leaf
+    custom_vector<uint> bvh_leaf_shape;  ///< Shape of each leaf
+    custom_vector<vec2> bvh_children;    ///< Left and right child of each internal node
+    custom_vector<vec2> bvh_range;       ///< First and last leaf below each internal node
+    custom_vector<int> bvh_parent;       ///< Parent of each node (-1 for the root)
+    custom_vector<int> bvh_visits;       ///< Number of children visited while computing the node AABBs
+    custom_vector<real3> bvh_aabb_min;   ///< Lower corner of the AABB of each node
+    custom_vector<real3> bvh_aabb_max;   ///< Upper corner of the AABB of each node
+    custom_vector<uint> bvh_num_contact;
 };
 
 /// Global data manager for Chrono::Parallel.
@@ -130,6 +130,12 @@ enum class CollisionSystemType {
     COLLSYS_BULLET_PARALLEL  ///< Bullet-based collision system
 };
 
+/// Enumeration of broad-phase collision methods.
+enum class BroadPhaseType {
+    BROADPHASE_GRID,  ///< uniform grid of bins
+    BROADPHASE_LBVH   ///< linear bounding volume hierarchy (Morton-ordered binary tree)
+};
+
 /// Enumeration of narrow-phase collision methods.
 enum class NarrowPhaseType {
     NARROWPHASE_MPR,        ///< Minkovski Portal Refinement
@@ -52,6 +52,9 @@ class collision_settings {
         // NOTE!!! this really depends on the architecture that you run on and how
         // many cores you are using.
         bins_per_axis = vec3(20, 20, 20);
+        broadphase_algorithm = BroadPhaseType::BROADPHASE_GRID;
+        incremental_broadphase = false;
+        broadphase_margin = 0;
         narrowphase_algorithm = NarrowPhaseType::NARROWPHASE_HYBRID_MPR;
         grid_density = 5;
         fixed_bins = true;
@@ -78,6 +81,23 @@ class collision_settings {
     /// the broadphase stage the extents of the simulation are computed and then
     /// sliced according to the variable.
     vec3 bins_per_axis;
+    /// The broadphase algorithm used to find the pairs of overlapping AABBs.
+    /// The uniform grid works best when the shapes have similar sizes and fill the
+    /// domain. The bounding volume hierarchy does not depend on a grid resolution and
+    /// is better suited for scenes mixing very large and very small shapes or with
+    /// sparse, elongated domains. Rigid bodies interacting with fluid or FEA nodes always
+    /// use the grid, as the rigid-particle narrowphase relies on its bins.
+    BroadPhaseType broadphase_algorithm;
+    /// Update the grid broadphase incrementally, using temporal coherence.
+    /// The bins are computed with AABBs inflated by a margin and kept, along with their
+    /// sorted order and the pairs found, until a shape leaves its inflated AABB. Only the
+    /// entries of these shapes are then updated, so that the cost of the broadphase on
+    /// resting beds is driven by the number of moving shapes. The grid is kept as long as it
+    /// contains all shapes. Not used with fluid or FEA nodes, or with the LBVH broadphase.
+    bool incremental_broadphase;
+    /// Inflation of the AABBs used by the incremental broadphase, in addition to the distance
+    /// traveled in one step by the body of each shape at its current (linear) speed.
+    real broadphase_margin;
     /// There are multiple narrowphase algorithms implemented in the collision
     /// detection code. The narrowphase_algorithm parameter can be used to change
     /// the type of narrowphase used at runtime.
@@ -103,6 +123,7 @@ class solver_settings {
         bilateral_clamp_speed = .6;
         clamp_bilaterals = true;
         compute_N = false;
+        mixed_precision = false;
         use_full_inertia_tensor = true;
         max_iteration = 100;
         max_iteration_normal = 0;
@@ -161,6 +182,11 @@ class solver_settings {
     /// Experimental options that probably don't work for all solvers.
     bool update_rhs;
     bool compute_N;
+    /// When set to true, the products with the Jacobians in the Schur complement are performed
+    /// with single precision D_T and M_invD, halving the memory traffic of the solver. The double
+    /// precision M_invD is not computed. The unknowns, the compliance, the right hand side and the
+    /// products stay in double precision, as do the velocity updates. compute_N is ignored.
+    bool mixed_precision;
     bool test_objective;
     bool use_full_inertia_tensor;
     bool cache_step_length;
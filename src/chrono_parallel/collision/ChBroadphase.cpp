@@ -24,6 +24,9 @@
 #include <thrust/transform_reduce.h>
 #include <thrust/sort.h>
 #include <thrust/sequence.h>
+#include <thrust/merge.h>
+#include <thrust/remove.h>
+#include <thrust/iterator/zip_iterator.h>
 #include <thrust/iterator/constant_iterator.h>
 
 #if defined(CHRONO_OPENMP_ENABLED)
@@ -181,6 +184,23 @@ void ChCBroadphase::DetermineBoundingBox() {
     min_point = min_point - fraction * size;
     max_point = max_point + fraction * size;
 
+    if (data_manager->settings.collision.incremental_broadphase) {
+        // Keep the grid of the previous step as long as it contains all shapes, so that the
+        // bins remain valid. Otherwise leave some room for the shapes to move in the new grid.
+        const real3& grid_min = data_manager->measures.collision.min_bounding_point;
+        const real3& grid_max = data_manager->measures.collision.max_bounding_point;
+        if (!rebuild_bins && min_point.x >= grid_min.x && min_point.y >= grid_min.y && min_point.z >= grid_min.z &&
+            max_point.x <= grid_max.x && max_point.y <= grid_max.y && max_point.z <= grid_max.z) {
+            min_point = grid_min;
+            max_point = grid_max;
+        } else {
+            real3 room = 0.05 * size + data_manager->settings.collision.broadphase_margin;
+            min_point = min_point - room;
+            max_point = max_point + room;
+            rebuild_bins = true;
+        }
+    }
+
     data_manager->measures.collision.min_bounding_point = min_point;
     data_manager->measures.collision.max_bounding_point = max_point;
     data_manager->measures.collision.global_origin = min_point;
@@ -232,7 +252,7 @@ void ChCBroadphase::ComputeTopLevelResolution() {
 }
 
 // =========================================================================================================
-ChCBroadphase::ChCBroadphase() {
+ChCBroadphase::ChCBroadphase() : rebuild_bins(true), bins_per_axis_built(0) {
     data_manager = 0;
 }
 // =========================================================================================================
@@ -240,21 +260,35 @@ ChCBroadphase::ChCBroadphase() {
 // let user define their own narrow-phase collision detection
 void ChCBroadphase::DispatchRigid() {
     if (data_manager->num_rigid_shapes != 0) {
-        OneLevelBroadphase();
+        // The rigid-fluid and rigid-FEA narrowphase use the bins of the grid
+        bool particles = data_manager->num_fluid_bodies != 0 || data_manager->num_fea_nodes != 0;
+        if (data_manager->settings.collision.broadphase_algorithm == BroadPhaseType::BROADPHASE_LBVH && !particles) {
+            TreeBroadphase();
+            rebuild_bins = true;
+        } else if (data_manager->settings.collision.incremental_broadphase && !particles) {
+            IncrementalBroadphase();
+        } else {
+            OneLevelBroadphase();
+            rebuild_bins = true;
+        }
         data_manager->num_rigid_contacts = data_manager->measures.collision.number_of_contacts_possible;
     }
     return;
 }
 
 void ChCBroadphase::OneLevelBroadphase() {
+    OneLevelBroadphase(data_manager->host_data.aabb_min, data_manager->host_data.aabb_max,
+                       data_manager->host_data.contact_pairs);
+}
+
+void ChCBroadphase::OneLevelBroadphase(const custom_vector<real3>& aabb_min,
+                                       const custom_vector<real3>& aabb_max,
+                                       custom_vector<long long>& contact_pairs) {
     LOG(TRACE) << "ChCBroadphase::OneLevelBroadphase()";
-    const custom_vector<real3>& aabb_min = data_manager->host_data.aabb_min;
-    const custom_vector<real3>& aabb_max = data_manager->host_data.aabb_max;
     const custom_vector<short2>& fam_data = data_manager->shape_data.fam_rigid;
     const custom_vector<char>& obj_active = data_manager->host_data.active_rigid;
     const custom_vector<char>& obj_collide = data_manager->host_data.collide_rigid;
     const custom_vector<uint>& obj_data_id = data_manager->shape_data.id_rigid;
-    custom_vector<long long>& contact_pairs = data_manager->host_data.contact_pairs;
 
     custom_vector<uint>& bin_intersections = data_manager->host_data.bin_intersections;
     custom_vector<uint>& bin_number = data_manager->host_data.bin_number;
@@ -341,5 +375,327 @@ void ChCBroadphase::OneLevelBroadphase() {
     LOG(TRACE) << "Number of unique collisions: " << number_of_contacts_possible;
 }
 
+// Bin intersection of a shape which left its inflated AABB.
+struct BinOfMovedShape {
+    BinOfMovedShape(const custom_vector<char>* moved) : m_moved(moved) {}
+    bool operator()(const thrust::tuple<uint, uint>& entry) { return (*m_moved)[thrust::get<1>(entry)] != 0; }
+    const custom_vector<char>* m_moved;
+};
+
+// Pair involving a shape which left its inflated AABB.
+struct PairOfMovedShape {
+    PairOfMovedShape(const custom_vector<char>* moved) : m_moved(moved) {}
+    bool operator()(long long pair) {
+        return (*m_moved)[(uint)(pair >> 32)] != 0 || (*m_moved)[(uint)(pair & 0xffffffff)] != 0;
+    }
+    const custom_vector<char>* m_moved;
+};
+
+void ChCBroadphase::IncrementalBroadphase() {
+    LOG(TRACE) << "ChCBroadphase::IncrementalBroadphase()";
+    const custom_vector<real3>& aabb_min = data_manager->host_data.aabb_min;
+    const custom_vector<real3>& aabb_max = data_manager->host_data.aabb_max;
+    const custom_vector<short2>& fam_data = data_manager->shape_data.fam_rigid;
+    const custom_vector<char>& obj_active = data_manager->host_data.active_rigid;
+    const custom_vector<char>& obj_collide = data_manager->host_data.collide_rigid;
+    const custom_vector<uint>& obj_data_id = data_manager->shape_data.id_rigid;
+    const DynamicVector<real>& v = data_manager->host_data.v;
+    custom_vector<long long>& contact_pairs = data_manager->host_data.contact_pairs;
+
+    custom_vector<real3>& bin_aabb_min = data_manager->host_data.bin_aabb_min;
+    custom_vector<real3>& bin_aabb_max = data_manager->host_data.bin_aabb_max;
+    custom_vector<short2>& bin_fam = data_manager->host_data.bin_fam;
+    custom_vector<uint>& bin_id = data_manager->host_data.bin_id;
+    custom_vector<char>& bin_active = data_manager->host_data.bin_active;
+    custom_vector<char>& bin_collide = data_manager->host_data.bin_collide;
+    custom_vector<char>& bin_moved = data_manager->host_data.bin_moved;
+    custom_vector<uint>& bin_moved_shapes = data_manager->host_data.bin_moved_shapes;
+    custom_vector<long long>& bin_pairs = data_manager->host_data.bin_pairs;
+
+    custom_vector<uint>& bin_intersections = data_manager->host_data.bin_intersections;
+    custom_vector<uint>& bin_number = data_manager->host_data.bin_number;
+    custom_vector<uint>& bin_aabb_number = data_manager->host_data.bin_aabb_number;
+    custom_vector<uint>& bin_number_moved = data_manager->host_data.bin_number_moved;
+    custom_vector<uint>& bin_aabb_number_moved = data_manager->host_data.bin_aabb_number_moved;
+    custom_vector<uint>& bin_number_merged = data_manager->host_data.bin_number_merged;
+    custom_vector<uint>& bin_aabb_number_merged = data_manager->host_data.bin_aabb_number_merged;
+    custom_vector<uint>& bin_num_contact = data_manager->host_data.bin_num_contact;
+
+    const vec3& bins_per_axis = data_manager->settings.collision.bins_per_axis;
+    const real3& inv_bin_size = data_manager->measures.collision.inv_bin_size;
+    const int num_shapes = data_manager->num_rigid_shapes;
+    const int num_bodies = (int)obj_active.size();
+    uint& number_of_contacts_possible = data_manager->measures.collision.number_of_contacts_possible;
+
+    const real margin = data_manager->settings.collision.broadphase_margin;
+    const real step_size = data_manager->settings.step_size;
+    const real3 diagonal = data_manager->measures.collision.max_bounding_point -
+                           data_manager->measures.collision.global_origin;
+
+    // Inflate the AABB of a shape by the margin and the distance traveled by its body in one
+    // step, without extending it beyond the grid.
+    auto inflate = [&](int i) {
+        uint body = obj_data_id[i];
+        real3 vel(v[body * 6 + 0], v[body * 6 + 1], v[body * 6 + 2]);
+        real d = margin + Length(vel) * step_size;
+        bin_aabb_min[i] = Max(aabb_min[i] - d, Min(aabb_min[i], real3(0)));
+        bin_aabb_max[i] = Min(aabb_max[i] + d, Max(aabb_max[i], diagonal));
+    };
+
+    bool rebuild = rebuild_bins || bin_id.size() != num_shapes || bin_active.size() != num_bodies ||
+                   bins_per_axis.x != bins_per_axis_built.x || bins_per_axis.y != bins_per_axis_built.y ||
+                   bins_per_axis.z != bins_per_axis_built.z;
+
+    // Changes in the collision families or flags invalidate the pairs
+    if (!rebuild) {
+        bool changed = false;
+#pragma omp parallel for reduction(|| : changed)
+        for (int i = 0; i < num_shapes; i++) {
+            changed = changed || bin_id[i] != obj_data_id[i] || bin_fam[i].x != fam_data[i].x ||
+                      bin_fam[i].y != fam_data[i].y;
+        }
+#pragma omp parallel for reduction(|| : changed)
+        for (int i = 0; i < num_bodies; i++) {
+            changed = changed || bin_active[i] != obj_active[i] || bin_collide[i] != obj_collide[i];
+        }
+        rebuild = changed;
+    }
+
+    // Find the shapes which left their inflated AABB
+    if (!rebuild) {
+        bin_moved.resize(num_shapes);
+#pragma omp parallel for
+        for (int i = 0; i < num_shapes; i++) {
+            const real3& lo = bin_aabb_min[i];
+            const real3& hi = bin_aabb_max[i];
+            bin_moved[i] = obj_data_id[i] != UINT_MAX &&
+                           !(aabb_min[i].x >= lo.x && aabb_min[i].y >= lo.y && aabb_min[i].z >= lo.z &&
+                             aabb_max[i].x <= hi.x && aabb_max[i].y <= hi.y && aabb_max[i].z <= hi.z);
+        }
+        bin_moved_shapes.clear();
+        for (int i = 0; i < num_shapes; i++) {
+            if (bin_moved[i])
+                bin_moved_shapes.push_back(i);
+        }
+        // Updating a large fraction of the shapes is slower than rebuilding the bins
+        rebuild = bin_moved_shapes.size() > num_shapes / 4;
+    }
+
+    if (rebuild) {
+        LOG(TRACE) << "ChCBroadphase::IncrementalBroadphase() rebuild";
+        bin_aabb_min.resize(num_shapes);
+        bin_aabb_max.resize(num_shapes);
+#pragma omp parallel for
+        for (int i = 0; i < num_shapes; i++) {
+            if (obj_data_id[i] == UINT_MAX) {
+                bin_aabb_min[i] = aabb_min[i];
+                bin_aabb_max[i] = aabb_max[i];
+                continue;
+            }
+            inflate(i);
+        }
+
+        OneLevelBroadphase(bin_aabb_min, bin_aabb_max, bin_pairs);
+        bin_pairs.resize(number_of_contacts_possible);
+
+        bin_fam = fam_data;
+        bin_id = obj_data_id;
+        bin_active = obj_active;
+        bin_collide = obj_collide;
+        bins_per_axis_built = bins_per_axis;
+        rebuild_bins = false;
+    } else if (!bin_moved_shapes.empty()) {
+        const int num_moved = (int)bin_moved_shapes.size();
+        LOG(TRACE) << "ChCBroadphase::IncrementalBroadphase() update " << num_moved;
+
+#pragma omp parallel for
+        for (int m = 0; m < num_moved; m++) {
+            inflate(bin_moved_shapes[m]);
+        }
+
+        // Remove the bin intersections and the pairs of the moved shapes (preserving the order)
+        auto first = thrust::make_zip_iterator(thrust::make_tuple(bin_number.begin(), bin_aabb_number.begin()));
+        auto last = thrust::make_zip_iterator(thrust::make_tuple(bin_number.end(), bin_aabb_number.end()));
+        size_t num_kept = thrust::remove_if(THRUST_PAR first, last, BinOfMovedShape(&bin_moved)) - first;
+        bin_number.resize(num_kept);
+        bin_aabb_number.resize(num_kept);
+        bin_pairs.resize(thrust::remove_if(THRUST_PAR bin_pairs.begin(), bin_pairs.end(), PairOfMovedShape(&bin_moved)) -
+                         bin_pairs.begin());
+
+        // Bin the moved shapes and merge their intersections into the sorted list
+        bin_intersections.resize(num_shapes + 1);
+#pragma omp parallel for
+        for (int i = 0; i <= num_shapes; i++) {
+            bin_intersections[i] = 0;
+        }
+#pragma omp parallel for
+        for (int m = 0; m < num_moved; m++) {
+            f_Count_AABB_BIN_Intersection(bin_moved_shapes[m], inv_bin_size, bin_aabb_min, bin_aabb_max,
+                                          bin_intersections);
+        }
+        Thrust_Exclusive_Scan(bin_intersections);
+        uint num_new = bin_intersections.back();
+
+        bin_number_moved.resize(num_new);
+        bin_aabb_number_moved.resize(num_new);
+#pragma omp parallel for
+        for (int m = 0; m < num_moved; m++) {
+            f_Store_AABB_BIN_Intersection(bin_moved_shapes[m], bins_per_axis, inv_bin_size, bin_aabb_min,
+                                          bin_aabb_max, bin_intersections, bin_number_moved, bin_aabb_number_moved);
+        }
+        Thrust_Sort_By_Key(bin_number_moved, bin_aabb_number_moved);
+
+        bin_number_merged.resize(num_kept + num_new);
+        bin_aabb_number_merged.resize(num_kept + num_new);
+        thrust::merge_by_key(THRUST_PAR bin_number.begin(), bin_number.end(), bin_number_moved.begin(),
+                             bin_number_moved.end(), bin_aabb_number.begin(), bin_aabb_number_moved.begin(),
+                             bin_number_merged.begin(), bin_aabb_number_merged.begin());
+        std::swap(bin_number, bin_number_merged);
+        std::swap(bin_aabb_number, bin_aabb_number_merged);
+
+        // Find the pairs of the moved shapes
+        bin_num_contact.resize(num_moved + 1);
+        bin_num_contact[num_moved] = 0;
+#pragma omp parallel for
+        for (int m = 0; m < num_moved; m++) {
+            bin_num_contact[m] = f_Moved_AABB_AABB_Intersection(
+                bin_moved_shapes[m], inv_bin_size, bins_per_axis, bin_aabb_min, bin_aabb_max, bin_number,
+                bin_aabb_number, bin_moved, fam_data, obj_active, obj_collide, obj_data_id, nullptr);
+        }
+        Thrust_Exclusive_Scan(bin_num_contact);
+
+        size_t num_pairs = bin_pairs.size();
+        bin_pairs.resize(num_pairs + bin_num_contact.back());
+#pragma omp parallel for
+        for (int m = 0; m < num_moved; m++) {
+            f_Moved_AABB_AABB_Intersection(bin_moved_shapes[m], inv_bin_size, bins_per_axis, bin_aabb_min,
+                                           bin_aabb_max, bin_number, bin_aabb_number, bin_moved, fam_data,
+                                           obj_active, obj_collide, obj_data_id,
+                                           bin_pairs.data() + num_pairs + bin_num_contact[m]);
+        }
+    }
+
+    // The narrowphase compacts the list of pairs, keep the one of the bins
+    contact_pairs = bin_pairs;
+    number_of_contacts_possible = (uint)contact_pairs.size();
+    LOG(TRACE) << "Number of possible collisions: " << number_of_contacts_possible;
+}
+
+void ChCBroadphase::TreeBroadphase() {
+    LOG(TRACE) << "ChCBroadphase::TreeBroadphase()";
+    const custom_vector<real3>& aabb_min = data_manager->host_data.aabb_min;
+    const custom_vector<real3>& aabb_max = data_manager->host_data.aabb_max;
+    const custom_vector<short2>& fam_data = data_manager->shape_data.fam_rigid;
+    const custom_vector<char>& obj_active = data_manager->host_data.active_rigid;
+    const custom_vector<char>& obj_collide = data_manager->host_data.collide_rigid;
+    const custom_vector<uint>& obj_data_id = data_manager->shape_data.id_rigid;
+    custom_vector<long long>& contact_pairs = data_manager->host_data.contact_pairs;
+
+    custom_vector<long long>& keys = data_manager->host_data.bvh_keys;
+    custom_vector<uint>& leaf_shape = data_manager->host_data.bvh_leaf_shape;
+    custom_vector<vec2>& children = data_manager->host_data.bvh_children;
+    custom_vector<vec2>& range = data_manager->host_data.bvh_range;
+    custom_vector<int>& parent = data_manager->host_data.bvh_parent;
+    custom_vector<int>& visits = data_manager->host_data.bvh_visits;
+    custom_vector<real3>& node_min = data_manager->host_data.bvh_aabb_min;
+    custom_vector<real3>& node_max = data_manager->host_data.bvh_aabb_max;
+    custom_vector<uint>& bvh_num_contact = data_manager->host_data.bvh_num_contact;
+
+    const int num_shapes = data_manager->num_rigid_shapes;
+    uint& number_of_contacts_possible = data_manager->measures.collision.number_of_contacts_possible;
+
+    // The AABBs are offset by the global origin, scale them to the unit cube
+    real3 diagonal = data_manager->measures.collision.max_bounding_point - data_manager->measures.collision.global_origin;
+    real3 inv_diagonal(diagonal.x > 0 ? 1 / diagonal.x : 0, diagonal.y > 0 ? 1 / diagonal.y : 0,
+                       diagonal.z > 0 ? 1 / diagonal.z : 0);
+
+    // Key the active shapes of colliding bodies by the Morton code of their AABB center. The other shapes get
+    // the largest key (above any 30-bit Morton code), so that they are dropped after sorting.
+    keys.resize(num_shapes);
+    int num_leaves = 0;
+#pragma omp parallel for reduction(+ : num_leaves)
+    for (int i = 0; i < num_shapes; i++) {
+        if (obj_data_id[i] == UINT_MAX || obj_collide[obj_data_id[i]] == 0) {
+            keys[i] = LLONG_MAX;
+            continue;
+        }
+        uint code = Morton_Code(0.5 * (aabb_min[i] + aabb_max[i]) * inv_diagonal);
+        keys[i] = ((long long)code << 32 | (long long)i);
+        num_leaves++;
+    }
+
+    Thrust_Sort(keys);
+    keys.resize(num_leaves);
+
+    if (num_leaves < 2) {
+        number_of_contacts_possible = 0;
+        return;
+    }
+
+    int num_nodes = 2 * num_leaves - 1;
+    leaf_shape.resize(num_leaves);
+    children.resize(num_leaves - 1);
+    range.resize(num_leaves - 1);
+    parent.resize(num_nodes);
+    visits.resize(num_leaves - 1);
+    node_min.resize(num_nodes);
+    node_max.resize(num_nodes);
+
+    parent[0] = -1;
+
+#pragma omp parallel for
+    for (int i = 0; i < num_leaves; i++) {
+        leaf_shape[i] = (uint)(keys[i] & 0xffffffff);
+        node_min[num_leaves - 1 + i] = aabb_min[leaf_shape[i]];
+        node_max[num_leaves - 1 + i] = aabb_max[leaf_shape[i]];
+    }
+
+#pragma omp parallel for
+    for (int i = 0; i < num_leaves - 1; i++) {
+        f_Build_BVH_Node(i, num_leaves, keys, children, range, parent);
+        visits[i] = 0;
+    }
+
+    // Compute the AABBs of the internal nodes bottom-up. The second thread reaching
+    // a node (once the AABBs of both children are known) continues towards the root.
+#pragma omp parallel for
+    for (int i = 0; i < num_leaves; i++) {
+        int node = parent[num_leaves - 1 + i];
+        while (node != -1) {
+            int visited;
+#pragma omp flush
+#pragma omp atomic capture
+            visited = visits[node]++;
+            if (visited == 0)
+                break;
+#pragma omp flush
+            vec2 child = children[node];
+            node_min[node] = Min(node_min[child.x], node_min[child.y]);
+            node_max[node] = Max(node_max[child.x], node_max[child.y]);
+            node = parent[node];
+        }
+    }
+
+    bvh_num_contact.resize(num_leaves + 1);
+    bvh_num_contact[num_leaves] = 0;
+
+#pragma omp parallel for
+    for (int i = 0; i < num_leaves; i++) {
+        bvh_num_contact[i] = f_Traverse_BVH(i, num_leaves, leaf_shape, children, range, node_min, node_max, fam_data,
+                                            obj_active, obj_data_id, nullptr);
+    }
+
+    Thrust_Exclusive_Scan(bvh_num_contact);
+    number_of_contacts_possible = bvh_num_contact.back();
+    contact_pairs.resize(number_of_contacts_possible);
+    LOG(TRACE) << "Number of possible collisions: " << number_of_contacts_possible;
+
+#pragma omp parallel for
+    for (int i = 0; i < num_leaves; i++) {
+        f_Traverse_BVH(i, num_leaves, leaf_shape, children, range, node_min, node_max, fam_data, obj_active,
+                       obj_data_id, contact_pairs.data() + bvh_num_contact[i]);
+    }
+}
+
 } // end namespace collision
 } // end namespace chrono
@@ -18,8 +18,13 @@
 
 #pragma once
 
+#include <algorithm>
 #include <climits>
 
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
 #include "chrono_parallel/ChParallelDefines.h"
 #include "chrono_parallel/math/ChParallelMath.h"
 #include "chrono_parallel/ChDataManager.h"
@@ -413,6 +418,227 @@ static inline void f_Store_AABB_AABB_Intersection(const uint index,
     }
 }
 
+/// Function to count (and store if potential_contacts is not null) the AABB-AABB intersections of a
+/// shape with the shapes in the bins it intersects, for the incremental broadphase.
+/// A pair of two moved shapes is reported only by the shape with the smaller index.
+static inline uint f_Moved_AABB_AABB_Intersection(const uint shapeA,
+                                                  const real3 inv_bin_size_vec,
+                                                  const vec3 bins_per_axis,
+                                                  const custom_vector<real3>& aabb_min_data,
+                                                  const custom_vector<real3>& aabb_max_data,
+                                                  const custom_vector<uint>& bin_number,
+                                                  const custom_vector<uint>& aabb_number,
+                                                  const custom_vector<char>& moved,
+                                                  const custom_vector<short2>& fam_data,
+                                                  const custom_vector<char>& body_active,
+                                                  const custom_vector<char>& body_collide,
+                                                  const custom_vector<uint>& body_id,
+                                                  long long* potential_contacts) {
+    real3 Amin = aabb_min_data[shapeA];
+    real3 Amax = aabb_max_data[shapeA];
+    short2 famA = fam_data[shapeA];
+    uint bodyA = body_id[shapeA];
+
+    if (bodyA == UINT_MAX)
+        return 0;
+    if (body_collide[bodyA] == 0)
+        return 0;
+
+    uint count = 0, i, j, k;
+    vec3 gmin = HashMin(Amin, inv_bin_size_vec);
+    vec3 gmax = HashMax(Amax, inv_bin_size_vec);
+    for (i = gmin.x; i <= (uint)gmax.x; i++) {
+        for (j = gmin.y; j <= (uint)gmax.y; j++) {
+            for (k = gmin.z; k <= (uint)gmax.z; k++) {
+                uint bin = Hash_Index(vec3(i, j, k), bins_per_axis);
+                size_t start = std::lower_bound(bin_number.begin(), bin_number.end(), bin) - bin_number.begin();
+                for (size_t n = start; n < bin_number.size() && bin_number[n] == bin; n++) {
+                    uint shapeB = aabb_number[n];
+                    uint bodyB = body_id[shapeB];
+                    real3 Bmin = aabb_min_data[shapeB];
+                    real3 Bmax = aabb_max_data[shapeB];
+
+                    if (shapeA == shapeB)
+                        continue;
+                    if (moved[shapeB] && shapeB < shapeA)
+                        continue;
+                    if (bodyB == UINT_MAX)
+                        continue;
+                    if (bodyA == bodyB)
+                        continue;
+                    if (body_collide[bodyB] == 0)
+                        continue;
+                    if (!body_active[bodyA] && !body_active[bodyB])
+                        continue;
+                    if (!collide(famA, fam_data[shapeB]))
+                        continue;
+                    if (!overlap(Amin, Amax, Bmin, Bmax))
+                        continue;
+                    if (current_bin(Amin, Amax, Bmin, Bmax, inv_bin_size_vec, bins_per_axis, bin) == false)
+                        continue;
+
+                    if (potential_contacts) {
+                        // the two indices of the shapes that make up the contact
+                        uint first = std::min(shapeA, shapeB);
+                        uint second = std::max(shapeA, shapeB);
+                        potential_contacts[count] = ((long long)first << 32 | (long long)second);
+                    }
+                    count++;
+                }
+            }
+        }
+    }
+
+    return count;
+}
+
+// BOUNDING VOLUME HIERARCHY ================================================================================
+
+/// Spread the lower 10 bits of x so that there are two zero bits between consecutive bits.
+static inline uint Expand_Bits(uint x) {
+    x = (x * 0x00010001u) & 0xFF0000FFu;
+    x = (x * 0x00000101u) & 0x0F00F00Fu;
+    x = (x * 0x00000011u) & 0xC30C30C3u;
+    x = (x * 0x00000005u) & 0x49249249u;
+    return x;
+}
+
+/// Compute the 30 bit Morton code of a point with coordinates in [0,1].
+static inline uint Morton_Code(const real3& p) {
+    uint x = (uint)Clamp(p.x * 1024, 0, 1023);
+    uint y = (uint)Clamp(p.y * 1024, 0, 1023);
+    uint z = (uint)Clamp(p.z * 1024, 0, 1023);
+    return (Expand_Bits(x) << 2) + (Expand_Bits(y) << 1) + Expand_Bits(z);
+}
+
+/// Number of leading zero bits of a non-zero value.
+static inline int Count_Leading_Zeros(unsigned long long x) {
+#if defined(_MSC_VER)
+    unsigned long index;
+    _BitScanReverse64(&index, x);
+    return 63 - (int)index;
+#else
+    return __builtin_clzll(x);
+#endif
+}
+
+/// Length of the common prefix of the keys of leaves i and j, -1 if j is not a leaf.
+/// Keys are unique, as they contain the shape index in their lower bits.
+static inline int Common_Prefix(const custom_vector<long long>& keys, const int num_leaves, int i, int j) {
+    if (j < 0 || j >= num_leaves)
+        return -1;
+    return Count_Leading_Zeros((unsigned long long)(keys[i] ^ keys[j]));
+}
+
+/// Function to build internal node i of the hierarchy over the sorted keys (Karras, 2012).
+/// The node covers the range of leaves sharing the longest common prefix with leaf i in the
+/// direction of its neighbor with the longer common prefix, and is split where this prefix grows.
+static inline void f_Build_BVH_Node(const int i,
+                                    const int num_leaves,
+                                    const custom_vector<long long>& keys,
+                                    custom_vector<vec2>& children,
+                                    custom_vector<vec2>& range,
+                                    custom_vector<int>& parent) {
+    // Direction of the range
+    int d = (Common_Prefix(keys, num_leaves, i, i + 1) - Common_Prefix(keys, num_leaves, i, i - 1)) < 0 ? -1 : 1;
+    int prefix_min = Common_Prefix(keys, num_leaves, i, i - d);
+
+    // Upper bound for the length of the range, then binary search for its other end
+    int lmax = 2;
+    while (Common_Prefix(keys, num_leaves, i, i + lmax * d) > prefix_min)
+        lmax *= 2;
+    int l = 0;
+    for (int t = lmax / 2; t >= 1; t /= 2) {
+        if (Common_Prefix(keys, num_leaves, i, i + (l + t) * d) > prefix_min)
+            l += t;
+    }
+    int j = i + l * d;
+
+    // Binary search for the split position
+    int prefix_node = Common_Prefix(keys, num_leaves, i, j);
+    int s = 0;
+    int t = l;
+    do {
+        t = (t + 1) / 2;
+        if (Common_Prefix(keys, num_leaves, i, i + (s + t) * d) > prefix_node)
+            s += t;
+    } while (t > 1);
+    int split = i + s * d + std::min(d, 0);
+
+    int first = std::min(i, j);
+    int last = std::max(i, j);
+    int left = (first == split) ? num_leaves - 1 + split : split;
+    int right = (last == split + 1) ? num_leaves - 1 + split + 1 : split + 1;
+
+    children[i] = vec2(left, right);
+    range[i] = vec2(first, last);
+    parent[left] = i;
+    parent[right] = i;
+}
+
+/// Function to count (and store if potential_contacts is not null) the AABB-AABB intersections
+/// of leaf index with the leaves after it in the hierarchy.
+static inline uint f_Traverse_BVH(const int index,
+                                  const int num_leaves,
+                                  const custom_vector<uint>& leaf_shape,
+                                  const custom_vector<vec2>& children,
+                                  const custom_vector<vec2>& range,
+                                  const custom_vector<real3>& node_min,
+                                  const custom_vector<real3>& node_max,
+                                  const custom_vector<short2>& fam_data,
+                                  const custom_vector<char>& body_active,
+                                  const custom_vector<uint>& body_id,
+                                  long long* potential_contacts) {
+    uint shapeA = leaf_shape[index];
+    real3 Amin = node_min[num_leaves - 1 + index];
+    real3 Amax = node_max[num_leaves - 1 + index];
+    short2 famA = fam_data[shapeA];
+    uint bodyA = body_id[shapeA];
+    uint count = 0;
+
+    // The depth of the hierarchy is at most the number of bits in the keys
+    int stack[128];
+    int top = 0;
+    stack[top++] = 0;
+    while (top > 0) {
+        int node = stack[--top];
+        if (node < num_leaves - 1) {
+            if (range[node].y <= index)
+                continue;
+            if (!overlap(Amin, Amax, node_min[node], node_max[node]))
+                continue;
+            stack[top++] = children[node].x;
+            stack[top++] = children[node].y;
+            continue;
+        }
+
+        int leaf = node - (num_leaves - 1);
+        if (leaf <= index)
+            continue;
+        uint shapeB = leaf_shape[leaf];
+        uint bodyB = body_id[shapeB];
+
+        if (bodyA == bodyB)
+            continue;
+        if (!body_active[bodyA] && !body_active[bodyB])
+            continue;
+        if (!collide(famA, fam_data[shapeB]))
+            continue;
+        if (!overlap(Amin, Amax, node_min[node], node_max[node]))
+            continue;
+
+        if (potential_contacts) {
+            // the two indices of the shapes that make up the contact
+            uint first = std::min(shapeA, shapeB);
+            uint second = std::max(shapeA, shapeB);
+            potential_contacts[count] = ((long long)first << 32 | (long long)second);
+        }
+        count++;
+    }
+
+    return count;
+}
+
 /// @} parallel_colision
 
 } // end namespace collision
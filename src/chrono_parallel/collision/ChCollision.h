@@ -47,6 +47,17 @@ class CH_PARALLEL_API ChCBroadphase {
     ChCBroadphase();
     void DispatchRigid();
     void OneLevelBroadphase();
+    /// Bin the given AABBs in the grid and find the overlapping pairs.
+    void OneLevelBroadphase(const custom_vector<real3>& aabb_min,
+                            const custom_vector<real3>& aabb_max,
+                            custom_vector<long long>& contact_pairs);
+    /// Update the bins and pairs of the previous step for the shapes which left their
+    /// inflated AABB, or rebuild them if the grid or the shapes changed.
+    void IncrementalBroadphase();
+    /// Find the overlapping AABBs with a linear bounding volume hierarchy:
+    /// the shapes are sorted along a Morton curve, the tree is built in parallel over
+    /// the sorted keys and then traversed in parallel once per shape.
+    void TreeBroadphase();
     void DetermineBoundingBox();
     void OffsetAABB();
     void ComputeTopLevelResolution();
@@ -56,6 +67,8 @@ class CH_PARALLEL_API ChCBroadphase {
     ChParallelDataManager* data_manager;
 
   private:
+    bool rebuild_bins;         ///< The incremental broadphase must rebuild the bins
+    vec3 bins_per_axis_built;  ///< Grid resolution the bins were built with
 };
 
 /// Class for performing narrow-phase collision detection.
@@ -380,20 +380,12 @@ void ChConstraintRigidRigid::Build_s() {
     const DynamicVector<real>& M_invk = data_manager->host_data.M_invk;
     const DynamicVector<real>& gamma = data_manager->host_data.gamma;
 
-    const SubMatrixType& M_invD_n = _MINVDN_;
-    const SubMatrixType& M_invD_t = _MINVDT_;
-    const SubMatrixType& M_invD_s = _MINVDS_;
-    const SubMatrixType& M_invD_b = _MINVDB_;
-    const CompressedMatrix<real, blaze::columnMajor>& M_invD = data_manager->host_data.M_invD;
-
-    uint num_contacts = data_manager->num_rigid_contacts;
-    uint num_unilaterals = data_manager->num_unilaterals;
-    uint num_bilaterals = data_manager->num_bilaterals;
-
-    ConstSubVectorType gamma_b = subvector(gamma, num_unilaterals, num_bilaterals);
-    ConstSubVectorType gamma_n = subvector(gamma, 0, num_contacts);
-
-    v_new = M_invk + M_invD * gamma;
+    // In mixed precision mode M_invD is only available in single precision
+    if (data_manager->settings.solver.mixed_precision) {
+        v_new = M_invk + data_manager->host_data.M_inv * (data_manager->host_data.D * gamma);
+    } else {
+        v_new = M_invk + data_manager->host_data.M_invD * gamma;
+    }
 
 #pragma omp parallel for
     for (int index = 0; index < (signed)data_manager->num_rigid_contacts; index++) {
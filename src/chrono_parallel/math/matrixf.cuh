@@ -18,6 +18,7 @@
 #pragma once
 
 #include "chrono_parallel/ChCudaDefines.h"
+#include <cmath>
 #include <iostream>
 
 //#include "chrono_parallel/math/float.h"
@@ -28,6 +29,33 @@ namespace chrono {
 #define FLT_MAX 3.40282347E+38F
 #endif
 
+#ifndef __CUDACC__
+// Host replacements for the CUDA built-in vector types, so that these functions
+// can also be used by the host MPM solver.
+struct float2 {
+    float x, y;
+};
+struct float3 {
+    float x, y, z;
+};
+struct int3 {
+    int x, y, z;
+};
+static inline float2 make_float2(float x, float y) {
+    float2 t;
+    t.x = x;
+    t.y = y;
+    return t;
+}
+static inline float3 make_float3(float x, float y, float z) {
+    float3 t;
+    t.x = x;
+    t.y = y;
+    t.z = z;
+    return t;
+}
+#endif
+
 #define OPERATOR_EQUALSALT(op, tin, tout)                           \
     static inline tout& operator op##=(tout& a, const tin& scale) { \
         a = a op scale;                                             \
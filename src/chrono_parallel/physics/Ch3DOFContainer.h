@@ -196,6 +196,7 @@ class CH_PARALLEL_API ChFluidContainer : public Ch3DOFContainer {
 
     int mpm_iterations;
     std::thread mpm_thread;
+    bool mpm_solved;
     bool mpm_init;
     MPM_Settings temp_settings;
     custom_vector<float> mpm_pos, mpm_vel, mpm_jejp;
@@ -313,6 +314,7 @@ class CH_PARALLEL_API ChParticleContainer : public Ch3DOFContainer {
     custom_vector<float> mpm_pos, mpm_vel, mpm_jejp;
 
     std::thread mpm_thread;
+    bool mpm_solved;
     bool mpm_init;
     MPM_Settings temp_settings;
 
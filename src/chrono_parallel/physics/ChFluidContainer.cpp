@@ -61,6 +61,7 @@ ChFluidContainer::ChFluidContainer() {
     theta_c = 2.5e-2;
     alpha_flip = .95;
     mpm_init = false;
+    mpm_solved = false;
 }
 
 void ChFluidContainer::AddBodies(const std::vector<real3>& positions, const std::vector<real3>& velocities) {
@@ -81,7 +82,6 @@ void ChFluidContainer::Update(double ChTime) {
     custom_vector<real3>& vel_fluid = data_manager->host_data.vel_3dof;
     real3 g_acc = data_manager->settings.gravity;
     real3 h_gravity = data_manager->settings.step_size * mass * g_acc;
-#ifdef CHRONO_PARALLEL_USE_CUDA
     if (mpm_init) {
         temp_settings.dt = (float)data_manager->settings.step_size;
         temp_settings.kernel_radius = (float)kernel_radius;
@@ -120,7 +120,15 @@ void ChFluidContainer::Update(double ChTime) {
             MPM_UpdateDeformationGradient(std::ref(temp_settings), std::ref(mpm_pos), std::ref(mpm_vel),
                                           std::ref(mpm_jejp));
 
+#ifdef CHRONO_PARALLEL_USE_CUDA
+            // The GPU solve overlaps with the host computations; its result is collected in PreSolve
             mpm_thread = std::thread(MPM_Solve, std::ref(temp_settings), std::ref(mpm_pos), std::ref(mpm_vel));
+#else
+            // The host solve uses the OpenMP threads of the system: running it concurrently with the
+            // rest of the step would oversubscribe the cores
+            MPM_Solve(temp_settings, mpm_pos, mpm_vel);
+#endif
+            mpm_solved = true;
 
             for (int i = 0; i < (signed)data_manager->num_fluid_bodies; i++) {
                 data_manager->host_data.vel_3dof[i].x = mpm_vel[i * 3 + 0];
@@ -129,7 +137,6 @@ void ChFluidContainer::Update(double ChTime) {
             }
         }
     }
-#endif
 #pragma omp parallel for
     for (int i = 0; i < (signed)num_fluid_bodies; i++) {
         // This was moved to after fluid collision detection
@@ -293,7 +300,6 @@ void ChFluidContainer::Setup(int start_constraint) {
 }
 
 void ChFluidContainer::Initialize() {
-#ifdef CHRONO_PARALLEL_USE_CUDA
     temp_settings.dt = (float)data_manager->settings.step_size;
     temp_settings.kernel_radius = (float)kernel_radius;
     temp_settings.inv_radius = float(1.0 / kernel_radius);
@@ -324,7 +330,6 @@ void ChFluidContainer::Initialize() {
         MPM_Initialize(temp_settings, mpm_pos);
     }
     mpm_init = true;
-#endif
 }
 void ChFluidContainer::Density_FluidMPM() {
     custom_vector<real3>& sorted_pos = data_manager->host_data.sorted_pos_3dof;
@@ -651,9 +656,10 @@ void ChFluidContainer::GenerateSparsity() {
 }
 
 void ChFluidContainer::PreSolve() {
-#ifdef CHRONO_PARALLEL_USE_CUDA
-    if (mpm_thread.joinable()) {
+    if (mpm_thread.joinable())
         mpm_thread.join();
+    if (mpm_solved) {
+        mpm_solved = false;
 #pragma omp parallel for
         for (int p = 0; p < (signed)num_fluid_bodies; p++) {
             int index = data_manager->host_data.reverse_mapping_3dof[p];
@@ -662,7 +668,6 @@ void ChFluidContainer::PreSolve() {
             data_manager->host_data.v[body_offset + index * 3 + 2] = mpm_vel[p * 3 + 2];
         }
     }
-#endif
 
     if (gamma_old.size() > 0) {
         if (enable_viscosity) {
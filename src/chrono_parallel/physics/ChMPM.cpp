@@ -0,0 +1,659 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2016 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+//
+// Description: Host (OpenMP) implementation of the pure MPM solve, used when
+// Chrono::Parallel is built without CUDA. It performs the same steps as the
+// CUDA implementation in ChMPM.cu, with two differences in the data layout:
+// - the background grid is sparse: it only stores the blocks of 4x4x4 nodes
+//   that are in the support of at least one marker;
+// - particle-to-grid transfers do not use atomics. Markers are sorted by the
+//   block containing the first node of their stencil (their home block). The
+//   stencil then only covers the home block and its successors along each axis,
+//   so home blocks are processed in 8 colors (parity of the block coordinates)
+//   and markers processed concurrently never write to the same grid block.
+// =============================================================================
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+#include "chrono_parallel/ChParallelDefines.h"
+#include "chrono_parallel/physics/ChMPM.cuh"
+#include "chrono_parallel/physics/MPMUtils.h"
+
+//#define BOX_YIELD
+#define SPHERE_YIELD
+
+namespace chrono {
+
+#define a_min 1e-13
+#define a_max 1e13
+#define neg_BB1_fallback 0.11
+#define neg_BB2_fallback 0.12
+
+// Grid blocks have 2^block_shift nodes along each axis.
+static const int block_shift = 2;
+static const int block_mask = (1 << block_shift) - 1;
+static const int nodes_per_block = 1 << (3 * block_shift);
+
+static MPM_Settings host_settings;
+
+static float3 min_bounding_point;
+static float3 max_bounding_point;
+
+// Sparse grid
+static int3 blocks_per_axis;
+static std::vector<int> block_slot;         // block -> index in the list of active blocks (-1 if inactive)
+static std::vector<int> active_blocks;      // active block -> block
+static std::vector<int> marker_block;       // marker -> home block
+static std::vector<int> marker_order;       // markers sorted by home block
+static std::vector<int> block_start;        // active block -> first marker in marker_order
+static std::vector<int> color_blocks[8];    // active blocks with at least one marker, by color
+
+// Marker data
+static std::vector<float> pos, vel, JE_JP;
+static std::vector<float> marker_volume;
+static std::vector<float> marker_plasticity;
+static std::vector<Mat33f> marker_Fe, marker_Fe_hat, marker_Fp;
+static std::vector<Mat33f> PolarR;
+static std::vector<SymMat33f> PolarS;
+
+// Node data
+static std::vector<float> node_mass;
+static std::vector<float> grid_vel, old_vel_node_mpm, delta_v;
+static std::vector<float> rhs;
+static std::vector<float> ml, mg, mg_p, ml_p;
+
+// Interpolation weights of a marker: 5 nodes per axis, starting at grid coordinates 'first'.
+struct MPM_Stencil {
+    int first[3];
+    float w[3][5];
+    float dw[3][5];
+};
+
+static inline void ComputeStencil(int p, MPM_Stencil& s) {
+    const float bin_edge = host_settings.bin_edge;
+    const float inv_bin_edge = host_settings.inv_bin_edge;
+    const float minimum[3] = {min_bounding_point.x, min_bounding_point.y, min_bounding_point.z};
+
+    for (int axis = 0; axis < 3; axis++) {
+        const float xi = pos[p * 3 + axis];
+        const int c = GridCoord(xi, inv_bin_edge, minimum[axis]);
+        s.first[axis] = c - 2;
+        for (int n = 0; n < 5; n++) {
+            const float node_location = (c - 2 + n) * bin_edge + minimum[axis];
+            const float T = (xi - node_location) * inv_bin_edge;
+            s.w[axis][n] = N(T);
+            s.dw[axis][n] = dN(T) * inv_bin_edge;
+        }
+    }
+}
+
+// Call f(node, weight, weight_gradient) for all the nodes in the support of a marker.
+template <typename F>
+static inline void ForEachNode(const MPM_Stencil& s, F f) {
+    // Block offset (0 or 1) and local coordinate of the stencil nodes along each axis
+    int block[3][5], local[3][5];
+    for (int axis = 0; axis < 3; axis++) {
+        const int first_block = s.first[axis] >> block_shift;
+        for (int n = 0; n < 5; n++) {
+            block[axis][n] = ((s.first[axis] + n) >> block_shift) - first_block;
+            local[axis][n] = (s.first[axis] + n) & block_mask;
+        }
+    }
+    // Offsets in the node arrays of the (at most) 2x2x2 grid blocks covered by the stencil
+    const int3 b = {s.first[0] >> block_shift, s.first[1] >> block_shift, s.first[2] >> block_shift};
+    int offset[2][2][2];
+    for (int k = 0; k < 2; k++) {
+        for (int j = 0; j < 2; j++) {
+            for (int i = 0; i < 2; i++) {
+                offset[k][j][i] = block_slot[GridHash(b.x + i, b.y + j, b.z + k, blocks_per_axis)] * nodes_per_block;
+            }
+        }
+    }
+
+    for (int k = 0; k < 5; k++) {
+        for (int j = 0; j < 5; j++) {
+            const int local_jk = ((local[2][k] << block_shift) + local[1][j]) << block_shift;
+            const float wjk = s.w[1][j] * s.w[2][k];
+            const float dwjk_y = s.dw[1][j] * s.w[2][k];
+            const float dwjk_z = s.w[1][j] * s.dw[2][k];
+            for (int i = 0; i < 5; i++) {
+                const int node = offset[block[2][k]][block[1][j]][block[0][i]] + local_jk + local[0][i];
+                const float3 dw = make_float3(s.dw[0][i] * wjk, s.w[0][i] * dwjk_y, s.w[0][i] * dwjk_z);
+                f(node, s.w[0][i] * wjk, dw);
+            }
+        }
+    }
+}
+
+// Call f(p) for all markers, so that markers processed concurrently never write to the same grid block.
+template <typename F>
+static void ScatterMarkers(F f) {
+    for (int color = 0; color < 8; color++) {
+        const std::vector<int>& blocks = color_blocks[color];
+        const int num_blocks = (int)blocks.size();
+#pragma omp parallel for schedule(dynamic)
+        for (int b = 0; b < num_blocks; b++) {
+            const int slot = blocks[b];
+            for (int m = block_start[slot]; m < block_start[slot + 1]; m++) {
+                f(marker_order[m]);
+            }
+        }
+    }
+}
+
+// Velocity gradient (or gradient of any nodal vector field) at a marker.
+static inline Mat33f MarkerGradient(const MPM_Stencil& s, const std::vector<float>& field) {
+    Mat33f grad(0.0f);
+    ForEachNode(s, [&](int node, float w, const float3& dw) {
+        const float vnx = field[node * 3 + 0];
+        const float vny = field[node * 3 + 1];
+        const float vnz = field[node * 3 + 2];
+        grad[0] += vnx * dw.x;
+        grad[1] += vny * dw.x;
+        grad[2] += vnz * dw.x;
+        grad[3] += vnx * dw.y;
+        grad[4] += vny * dw.y;
+        grad[5] += vnz * dw.y;
+        grad[6] += vnx * dw.z;
+        grad[7] += vny * dw.z;
+        grad[8] += vnz * dw.z;
+    });
+    return grad;
+}
+
+static inline float CurrentMu(int p) {
+#if defined(BOX_YIELD) || defined(SPHERE_YIELD)
+    return host_settings.mu * expf(host_settings.hardening_coefficient * marker_plasticity[p]);
+#else
+    return host_settings.mu;
+#endif
+}
+
+// Compute the grid bounds and the set of active grid blocks, and sort the markers by home block.
+static void MPM_ComputeBounds() {
+    const int num_markers = host_settings.num_mpm_markers;
+
+    max_bounding_point = make_float3(-FLT_MAX, -FLT_MAX, -FLT_MAX);
+    min_bounding_point = make_float3(FLT_MAX, FLT_MAX, FLT_MAX);
+    for (int p = 0; p < num_markers; p++) {
+        const float3 xi = make_float3(pos[p * 3 + 0], pos[p * 3 + 1], pos[p * 3 + 2]);
+        max_bounding_point = Max(max_bounding_point, xi);
+        min_bounding_point = Min(min_bounding_point, xi);
+    }
+
+    const float radius = host_settings.kernel_radius;
+    min_bounding_point.x = radius * roundf(min_bounding_point.x / radius);
+    min_bounding_point.y = radius * roundf(min_bounding_point.y / radius);
+    min_bounding_point.z = radius * roundf(min_bounding_point.z / radius);
+
+    max_bounding_point.x = radius * roundf(max_bounding_point.x / radius);
+    max_bounding_point.y = radius * roundf(max_bounding_point.y / radius);
+    max_bounding_point.z = radius * roundf(max_bounding_point.z / radius);
+
+    max_bounding_point = max_bounding_point + radius * 8;
+    min_bounding_point = min_bounding_point - radius * 6;
+
+    host_settings.bin_edge = radius * 2;
+    host_settings.inv_bin_edge = float(1.) / host_settings.bin_edge;
+
+    host_settings.bins_per_axis_x = int((max_bounding_point.x - min_bounding_point.x) * host_settings.inv_bin_edge);
+    host_settings.bins_per_axis_y = int((max_bounding_point.y - min_bounding_point.y) * host_settings.inv_bin_edge);
+    host_settings.bins_per_axis_z = int((max_bounding_point.z - min_bounding_point.z) * host_settings.inv_bin_edge);
+
+    // The stencil of a marker covers its home block and the next block along each axis.
+    blocks_per_axis.x = (host_settings.bins_per_axis_x >> block_shift) + 2;
+    blocks_per_axis.y = (host_settings.bins_per_axis_y >> block_shift) + 2;
+    blocks_per_axis.z = (host_settings.bins_per_axis_z >> block_shift) + 2;
+
+    const float inv_bin_edge = host_settings.inv_bin_edge;
+    marker_block.resize(num_markers);
+#pragma omp parallel for
+    for (int p = 0; p < num_markers; p++) {
+        const int i = GridCoord(pos[p * 3 + 0], inv_bin_edge, min_bounding_point.x) - 2;
+        const int j = GridCoord(pos[p * 3 + 1], inv_bin_edge, min_bounding_point.y) - 2;
+        const int k = GridCoord(pos[p * 3 + 2], inv_bin_edge, min_bounding_point.z) - 2;
+        marker_block[p] = GridHash(i >> block_shift, j >> block_shift, k >> block_shift, blocks_per_axis);
+    }
+
+    // Flag the blocks in the support of the markers, then number them in grid order
+    block_slot.assign(blocks_per_axis.x * blocks_per_axis.y * blocks_per_axis.z, -1);
+    for (int p = 0; p < num_markers; p++) {
+        const int3 b = GridDecode(marker_block[p], blocks_per_axis);
+        for (int k = 0; k < 2; k++) {
+            for (int j = 0; j < 2; j++) {
+                for (int i = 0; i < 2; i++) {
+                    block_slot[GridHash(b.x + i, b.y + j, b.z + k, blocks_per_axis)] = 0;
+                }
+            }
+        }
+    }
+    active_blocks.clear();
+    for (int b = 0; b < (signed)block_slot.size(); b++) {
+        if (block_slot[b] != -1) {
+            block_slot[b] = (int)active_blocks.size();
+            active_blocks.push_back(b);
+        }
+    }
+    const int num_active = (int)active_blocks.size();
+    host_settings.num_mpm_nodes = num_active * nodes_per_block;
+
+    // Counting sort of the markers by home block
+    block_start.assign(num_active + 1, 0);
+    for (int p = 0; p < num_markers; p++) {
+        block_start[block_slot[marker_block[p]] + 1]++;
+    }
+    for (int b = 0; b < num_active; b++) {
+        block_start[b + 1] += block_start[b];
+    }
+    std::vector<int> block_fill(block_start.begin(), block_start.end() - 1);
+    marker_order.resize(num_markers);
+    for (int p = 0; p < num_markers; p++) {
+        marker_order[block_fill[block_slot[marker_block[p]]]++] = p;
+    }
+
+    for (int color = 0; color < 8; color++) {
+        color_blocks[color].clear();
+    }
+    for (int b = 0; b < num_active; b++) {
+        if (block_start[b + 1] > block_start[b]) {
+            const int3 c = GridDecode(active_blocks[b], blocks_per_axis);
+            color_blocks[(c.x & 1) + ((c.y & 1) << 1) + ((c.z & 1) << 2)].push_back(b);
+        }
+    }
+}
+
+// Transfer the marker mass (and optionally momentum) to the grid.
+static void MPM_Rasterize(bool momentum) {
+    node_mass.assign(host_settings.num_mpm_nodes, 0.0f);
+    if (momentum) {
+        grid_vel.assign(host_settings.num_mpm_nodes * 3, 0.0f);
+    }
+
+    const float mass = host_settings.mass;
+    ScatterMarkers([&](int p) {
+        MPM_Stencil s;
+        ComputeStencil(p, s);
+        if (!momentum) {
+            ForEachNode(s, [&](int node, float w, const float3& dw) { node_mass[node] += w * mass; });
+            return;
+        }
+        const float vix = vel[p * 3 + 0];
+        const float viy = vel[p * 3 + 1];
+        const float viz = vel[p * 3 + 2];
+        ForEachNode(s, [&](int node, float w, const float3& dw) {
+            const float weight = w * mass;
+            node_mass[node] += weight;
+            grid_vel[node * 3 + 0] += weight * vix;
+            grid_vel[node * 3 + 1] += weight * viy;
+            grid_vel[node * 3 + 2] += weight * viz;
+        });
+    });
+}
+
+static void MPM_NormalizeWeights() {
+    const int num_nodes = host_settings.num_mpm_nodes;
+#pragma omp parallel for
+    for (int i = 0; i < num_nodes; i++) {
+        const float n_mass = node_mass[i];
+        if (n_mass > FLT_EPSILON) {
+            grid_vel[i * 3 + 0] /= n_mass;
+            grid_vel[i * 3 + 1] /= n_mass;
+            grid_vel[i * 3 + 2] /= n_mass;
+        }
+    }
+}
+
+static void MPM_ComputeParticleVolumes() {
+    const int num_markers = host_settings.num_mpm_markers;
+    const float bin_edge = host_settings.bin_edge;
+    marker_volume.resize(num_markers);
+#pragma omp parallel for
+    for (int m = 0; m < num_markers; m++) {
+        const int p = marker_order[m];
+        MPM_Stencil s;
+        ComputeStencil(p, s);
+        float particle_density = 0;
+        ForEachNode(s, [&](int node, float w, const float3& dw) { particle_density += node_mass[node] * w; });
+        // Inverse density to remove division
+        particle_density = (bin_edge * bin_edge * bin_edge) / particle_density;
+        marker_volume[p] = host_settings.mass * particle_density;
+    }
+}
+
+static void MPM_FeHat() {
+    const int num_markers = host_settings.num_mpm_markers;
+#pragma omp parallel for
+    for (int m = 0; m < num_markers; m++) {
+        const int p = marker_order[m];
+        MPM_Stencil s;
+        ComputeStencil(p, s);
+        const Mat33f Fe_hat_t = MarkerGradient(s, grid_vel);
+        marker_Fe_hat[p] = (Mat33f(1.0f) + host_settings.dt * Fe_hat_t) * marker_Fe[p];
+    }
+}
+
+static void MPM_ApplyForces() {
+    ScatterMarkers([&](int p) {
+        const Mat33f& FE = marker_Fe[p];
+        const Mat33f& FE_hat = marker_Fe_hat[p];
+
+        const float a = -one_third;
+        const float J = Determinant(FE_hat);
+        const float Ja = powf(J, a);
+        const float current_mu = CurrentMu(p);
+
+        Mat33f JaFE = Ja * FE;
+        Mat33f UE, VE;
+        float3 EE;
+        SVD(JaFE, UE, EE, VE); /* Perform a polar decomposition, FE=RE*SE, RE is the Unitary part*/
+        Mat33f RE = MultTranspose(UE, VE);
+        Mat33f SE = VE * MultTranspose(EE, VE);
+        PolarR[p] = RE;
+        PolarS[p] = SymMat33f(SE[0], SE[1], SE[2], SE[4], SE[5], SE[8]);
+
+        const Mat33f H = AdjointTranspose(FE_hat) * (1.0f / J);
+        const Mat33f A = 2.f * current_mu * (JaFE - RE);
+        const Mat33f Z_B = Z__B(A, FE_hat, Ja, a, H);
+        const Mat33f vPEDFepT = host_settings.dt * marker_volume[p] * MultTranspose(Z_B, FE);
+
+        MPM_Stencil s;
+        ComputeStencil(p, s);
+        ForEachNode(s, [&](int node, float w, const float3& dw) {
+            const float mass = node_mass[node];
+            if (mass > 0) {
+                const float3 f = vPEDFepT * dw;
+                grid_vel[node * 3 + 0] -= f.x / mass;
+                grid_vel[node * 3 + 1] -= f.y / mass;
+                grid_vel[node * 3 + 2] -= f.z / mass;
+            }
+        });
+    });
+}
+
+static void MPM_Rhs() {
+    const int num_nodes = host_settings.num_mpm_nodes;
+    rhs.resize(num_nodes * 3);
+#pragma omp parallel for
+    for (int i = 0; i < num_nodes; i++) {
+        const float mass = node_mass[i];
+        rhs[i * 3 + 0] = mass > 0 ? mass * grid_vel[i * 3 + 0] : 0;
+        rhs[i * 3 + 1] = mass > 0 ? mass * grid_vel[i * 3 + 1] : 0;
+        rhs[i * 3 + 2] = mass > 0 ? mass * grid_vel[i * 3 + 2] : 0;
+    }
+}
+
+// output += A * input, with A the Hessian of the elastic potential plus the nodal mass matrix.
+static void Multiply(const std::vector<float>& input, std::vector<float>& output) {
+    ScatterMarkers([&](int p) {
+        MPM_Stencil s;
+        ComputeStencil(p, s);
+
+        const Mat33f& m_FE = marker_Fe[p];
+        const Mat33f delta_F = MarkerGradient(s, input) * m_FE;
+        const float current_mu = 2.0f * CurrentMu(p);
+
+        const Mat33f& RE = PolarR[p];
+        const SymMat33f& SE = PolarS[p];
+        const Mat33f& F = marker_Fe_hat[p];
+        const float a = -one_third;
+        const float J = Determinant(F);
+        const float Ja = powf(J, a);
+        const Mat33f H = AdjointTranspose(F) * (1.0f / J);
+
+        const Mat33f B_Z = B__Z(delta_F, F, Ja, a, H);
+        const Mat33f WE = TransposeMult(RE, B_Z);
+        // C is the original second derivative
+        const Mat33f C_B_Z = current_mu * (B_Z - Solve_dR(RE, SE, WE));
+
+        const Mat33f FE = Ja * F;
+        const Mat33f A = current_mu * (FE - RE);
+        const Mat33f P1 = Z__B(C_B_Z, F, Ja, a, H);
+        const Mat33f P2 = (a * DoubleDot(H, delta_F)) * Z__B(A, F, Ja, a, H);
+        const Mat33f P3 = (a * Ja * DoubleDot(A, delta_F)) * H;
+        const Mat33f P4 = (-a * Ja * DoubleDot(A, F)) * H * TransposeMult(delta_F, H);
+
+        const Mat33f VAP = marker_volume[p] * MultTranspose(P1 + P2 + P3 + P4, m_FE);
+
+        ForEachNode(s, [&](int node, float w, const float3& dw) {
+            const float3 res = VAP * dw;
+            output[node * 3 + 0] += res.x;
+            output[node * 3 + 1] += res.y;
+            output[node * 3 + 2] += res.z;
+        });
+    });
+
+    const int num_nodes = host_settings.num_mpm_nodes;
+#pragma omp parallel for
+    for (int i = 0; i < num_nodes; i++) {
+        const float mass = node_mass[i];
+        if (mass > 0) {
+            output[i * 3 + 0] += mass * input[i * 3 + 0];
+            output[i * 3 + 1] += mass * input[i * 3 + 1];
+            output[i * 3 + 2] += mass * input[i * 3 + 2];
+        }
+    }
+}
+
+// Barzilai-Borwein iterations for A * delta_v = r, keeping the iterate with the smallest residual.
+static void MPM_BBSolver(const std::vector<float>& r, std::vector<float>& delta_v) {
+    const int size = (int)r.size();
+    float lastgoodres = 10e30f;
+
+    ml = delta_v;
+    mg.assign(size, 0.0f);
+    ml_p.resize(size);
+    mg_p.resize(size);
+
+    Multiply(ml, mg);
+#pragma omp parallel for
+    for (int i = 0; i < size; i++) {
+        mg[i] = mg[i] - r[i];
+    }
+
+    float alpha = 0.0001f;
+
+    for (int current_iteration = 0; current_iteration < host_settings.num_iterations; current_iteration++) {
+#pragma omp parallel for
+        for (int i = 0; i < size; i++) {
+            ml_p[i] = ml[i] - alpha * mg[i];
+        }
+        std::fill(mg_p.begin(), mg_p.end(), 0.0f);
+
+        Multiply(ml_p, mg_p);
+
+        const bool even = (current_iteration % 2 == 0);
+        float dot_ms_ms = 0;
+        float dot_ms_my = 0;
+        float dot_my_my = 0;
+        float dot_g_proj_norm = 0;
+#pragma omp parallel for reduction(+ : dot_ms_ms, dot_ms_my, dot_my_my, dot_g_proj_norm)
+        for (int i = 0; i < size; i++) {
+            mg_p[i] = mg_p[i] - r[i];
+            const float ms = ml_p[i] - ml[i];
+            const float my = mg_p[i] - mg[i];
+            if (even) {
+                dot_ms_ms += ms * ms;
+            } else {
+                dot_my_my += my * my;
+            }
+            dot_ms_my += ms * my;
+            dot_g_proj_norm += mg_p[i] * mg_p[i];
+        }
+
+        if (dot_ms_my <= 0) {
+            alpha = even ? float(neg_BB1_fallback) : float(neg_BB2_fallback);
+        } else if (even) {
+            alpha = fminf(float(a_max), fmaxf(float(a_min), dot_ms_ms / dot_ms_my));
+        } else {
+            alpha = fminf(float(a_max), fmaxf(float(a_min), dot_ms_my / dot_my_my));
+        }
+
+        ml.swap(ml_p);
+        mg.swap(mg_p);
+
+        const float g_proj_norm = sqrtf(dot_g_proj_norm);
+        if (g_proj_norm < lastgoodres) {
+            lastgoodres = g_proj_norm;
+            delta_v = ml;
+        }
+    }
+}
+
+static void MPM_IncrementVelocity() {
+    const int size = host_settings.num_mpm_nodes * 3;
+#pragma omp parallel for
+    for (int i = 0; i < size; i++) {
+        grid_vel[i] += delta_v[i] - old_vel_node_mpm[i];
+    }
+}
+
+static void MPM_UpdateParticleVelocity() {
+    const int num_markers = host_settings.num_mpm_markers;
+    const float alpha = host_settings.alpha_flip;
+#pragma omp parallel for
+    for (int m = 0; m < num_markers; m++) {
+        const int p = marker_order[m];
+        MPM_Stencil s;
+        ComputeStencil(p, s);
+
+        float3 V_flip = make_float3(vel[p * 3 + 0], vel[p * 3 + 1], vel[p * 3 + 2]);
+        float3 V_pic = make_float3(0.0f, 0.0f, 0.0f);
+
+        ForEachNode(s, [&](int node, float w, const float3& dw) {
+            const float vnx = grid_vel[node * 3 + 0];
+            const float vny = grid_vel[node * 3 + 1];
+            const float vnz = grid_vel[node * 3 + 2];
+
+            V_pic.x += vnx * w;
+            V_pic.y += vny * w;
+            V_pic.z += vnz * w;
+            V_flip.x += (vnx - old_vel_node_mpm[node * 3 + 0]) * w;
+            V_flip.y += (vny - old_vel_node_mpm[node * 3 + 1]) * w;
+            V_flip.z += (vnz - old_vel_node_mpm[node * 3 + 2]) * w;
+        });
+        float3 new_vel = (1.0f - alpha) * V_pic + alpha * V_flip;
+
+        const float speed = Length(new_vel);
+        if (speed > host_settings.max_velocity) {
+            new_vel = new_vel * host_settings.max_velocity / speed;
+        }
+        vel[p * 3 + 0] = new_vel.x;
+        vel[p * 3 + 1] = new_vel.y;
+        vel[p * 3 + 2] = new_vel.z;
+    }
+}
+
+static void MPM_UpdateMarkerDeformation() {
+    const int num_markers = host_settings.num_mpm_markers;
+#pragma omp parallel for
+    for (int m = 0; m < num_markers; m++) {
+        const int p = marker_order[m];
+        MPM_Stencil s;
+        ComputeStencil(p, s);
+
+        const Mat33f vel_grad = MarkerGradient(s, grid_vel);
+        const Mat33f delta_F = (Mat33f(1.0f) + host_settings.dt * vel_grad);
+
+        const Mat33f Fe_tmp = delta_F * marker_Fe[p];
+        const Mat33f F_tmp = Fe_tmp * marker_Fp[p];
+        Mat33f U, V;
+        float3 E;
+        SVD(Fe_tmp, U, E, V);
+        float3 E_clamped = E;
+
+#if defined(BOX_YIELD)
+        // Simple box clamp
+        E_clamped.x = Clamp(E.x, 1.0f - host_settings.theta_c, 1.0f + host_settings.theta_s);
+        E_clamped.y = Clamp(E.y, 1.0f - host_settings.theta_c, 1.0f + host_settings.theta_s);
+        E_clamped.z = Clamp(E.z, 1.0f - host_settings.theta_c, 1.0f + host_settings.theta_s);
+        marker_plasticity[p] = fabsf(E.x * E.y * E.z - E_clamped.x * E_clamped.y * E_clamped.z);
+#elif defined(SPHERE_YIELD)
+        // Clamp to sphere (better)
+        const float center = 1.0f + (host_settings.theta_s - host_settings.theta_c) * .5f;
+        const float radius = (host_settings.theta_s + host_settings.theta_c) * .5f;
+        float3 offset = E - center;
+        const float lent = Length(offset);
+        if (lent > radius) {
+            offset = offset * radius / lent;
+        }
+        E_clamped = offset + center;
+        marker_plasticity[p] = fabsf(E.x * E.y * E.z - E_clamped.x * E_clamped.y * E_clamped.z);
+#endif
+
+        // Inverse of Diagonal E_clamped matrix is 1/E_clamped
+        const Mat33f m_FP = V * MultTranspose(Mat33f(1.0f / E_clamped), U) * F_tmp;
+        const float JP_new = Determinant(m_FP);
+        // Ensure that F_p is purely deviatoric
+        const Mat33f T1 = powf(JP_new, 1.0f / 3.0f) * U * MultTranspose(Mat33f(E_clamped), V);
+        const Mat33f T2 = powf(JP_new, -1.0f / 3.0f) * m_FP;
+
+        JE_JP[p * 2 + 0] = Determinant(T1);
+        JE_JP[p * 2 + 1] = Determinant(T2);
+
+        marker_Fe[p] = T1;
+        marker_Fp[p] = T2;
+    }
+}
+
+void MPM_UpdateDeformationGradient(MPM_Settings& settings,
+                                   std::vector<float>& positions,
+                                   std::vector<float>& velocities,
+                                   std::vector<float>& jejp) {
+    host_settings = settings;
+    pos = positions;
+    vel = velocities;
+
+    MPM_ComputeBounds();
+    MPM_Rasterize(true);
+    MPM_NormalizeWeights();
+    MPM_UpdateMarkerDeformation();
+
+    jejp = JE_JP;
+}
+
+void MPM_Solve(MPM_Settings& settings, std::vector<float>& positions, std::vector<float>& velocities) {
+    old_vel_node_mpm = grid_vel;
+
+    MPM_FeHat();
+    MPM_ApplyForces();
+    MPM_Rhs();
+
+    delta_v = old_vel_node_mpm;
+    MPM_BBSolver(rhs, delta_v);
+
+    MPM_IncrementVelocity();
+    MPM_UpdateParticleVelocity();
+
+    velocities = vel;
+}
+
+void MPM_Initialize(MPM_Settings& settings, std::vector<float>& positions) {
+    host_settings = settings;
+    pos = positions;
+
+    MPM_ComputeBounds();
+    MPM_Rasterize(false);
+    MPM_ComputeParticleVolumes();
+
+    const int num_markers = host_settings.num_mpm_markers;
+    marker_Fe.assign(num_markers, Mat33f(1.0f));
+    marker_Fe_hat.assign(num_markers, Mat33f(1.0f));
+    marker_Fp.assign(num_markers, Mat33f(1.0f));
+    PolarR.assign(num_markers, Mat33f(1.0f));
+    PolarS.assign(num_markers, SymMat33f(1.0f));
+    JE_JP.assign(num_markers * 2, 1.0f);
+    marker_plasticity.assign(num_markers, 0.0f);
+}
+
+}  // end namespace chrono
@@ -17,15 +17,16 @@
 // =============================================================================
 
 #include <vector>
+#include "chrono_parallel/ChApiParallel.h"
 #include "chrono_parallel/physics/ChMPMSettings.h"
 
 namespace chrono {
 
-void MPM_Initialize(MPM_Settings& settings, std::vector<float>& positions);
-void MPM_Solve(MPM_Settings& settings, std::vector<float>& positions, std::vector<float>& velocities);
+CH_PARALLEL_API void MPM_Initialize(MPM_Settings& settings, std::vector<float>& positions);
+CH_PARALLEL_API void MPM_Solve(MPM_Settings& settings, std::vector<float>& positions, std::vector<float>& velocities);
 
-void MPM_UpdateDeformationGradient(MPM_Settings& settings,
-                                   std::vector<float>& positions,
-                                   std::vector<float>& velocities,
-                                   std::vector<float>& jejp);
+CH_PARALLEL_API void MPM_UpdateDeformationGradient(MPM_Settings& settings,
+                                                   std::vector<float>& positions,
+                                                   std::vector<float>& velocities,
+                                                   std::vector<float>& jejp);
 }
@@ -53,6 +53,7 @@ ChParticleContainer::ChParticleContainer() {
     theta_c = 2.5e-2;
     alpha_flip = .95;
     mpm_init = false;
+    mpm_solved = false;
 }
 
 void ChParticleContainer::AddBodies(const std::vector<real3>& positions, const std::vector<real3>& velocities) {
@@ -70,7 +71,6 @@ void ChParticleContainer::Update(double ChTime) {
     uint num_rigid_bodies = data_manager->num_rigid_bodies;
     uint num_shafts = data_manager->num_shafts;
     real3 h_gravity = data_manager->settings.step_size * mass * data_manager->settings.gravity;
-#ifdef CHRONO_PARALLEL_USE_CUDA
     if (mpm_init) {
         temp_settings.dt = (float)data_manager->settings.step_size;
         temp_settings.kernel_radius = (float)kernel_radius;
@@ -109,7 +109,15 @@ void ChParticleContainer::Update(double ChTime) {
             MPM_UpdateDeformationGradient(std::ref(temp_settings), std::ref(mpm_pos), std::ref(mpm_vel),
                                           std::ref(mpm_jejp));
 
+#ifdef CHRONO_PARALLEL_USE_CUDA
+            // The GPU solve overlaps with the host computations; its result is collected in PreSolve
             mpm_thread = std::thread(MPM_Solve, std::ref(temp_settings), std::ref(mpm_pos), std::ref(mpm_vel));
+#else
+            // The host solve uses the OpenMP threads of the system: running it concurrently with the
+            // rest of the step would oversubscribe the cores
+            MPM_Solve(temp_settings, mpm_pos, mpm_vel);
+#endif
+            mpm_solved = true;
 
             //            for (int i = 0; i < data_manager->num_fluid_bodies; i++) {
             //                data_manager->host_data.vel_3dof[i].x = mpm_vel[i * 3 + 0];
@@ -118,7 +126,6 @@ void ChParticleContainer::Update(double ChTime) {
             //            }
         }
     }
-#endif
 
 #pragma omp parallel for
     for (int i = 0; i < (signed)num_fluid_bodies; i++) {
@@ -290,7 +297,6 @@ void ChParticleContainer::Setup(int start_constraint) {
 }
 
 void ChParticleContainer::Initialize() {
-#ifdef CHRONO_PARALLEL_USE_CUDA
     temp_settings.dt = (float)data_manager->settings.step_size;
     temp_settings.kernel_radius = (float)kernel_radius;
     temp_settings.inv_radius = float(1.0 / kernel_radius);
@@ -321,7 +327,6 @@ void ChParticleContainer::Initialize() {
         MPM_Initialize(temp_settings, mpm_pos);
     }
     mpm_init = true;
-#endif
 }
 
 void ChParticleContainer::Build_D() {
@@ -541,9 +546,10 @@ real3 ChParticleContainer::GetBodyContactTorque(uint body_id) {
 }
 
 void ChParticleContainer::PreSolve() {
-#ifdef CHRONO_PARALLEL_USE_CUDA
-    if (mpm_thread.joinable()) {
+    if (mpm_thread.joinable())
         mpm_thread.join();
+    if (mpm_solved) {
+        mpm_solved = false;
 #pragma omp parallel for
         for (int p = 0; p < (signed)num_fluid_bodies; p++) {
             int index = data_manager->host_data.reverse_mapping_3dof[p];
@@ -552,7 +558,6 @@ void ChParticleContainer::PreSolve() {
             data_manager->host_data.v[body_offset + index * 3 + 2] = mpm_vel[p * 3 + 2];
         }
     }
-#endif
 }
 
 void ChParticleContainer::PostSolve() {}
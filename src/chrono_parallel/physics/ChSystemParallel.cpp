@@ -146,30 +146,8 @@ bool ChSystemParallel::Integrate_Y() {
     // Scatter the states to the Chrono objects (bodies and shafts) and update
     // all physics items at the end of the step.
     DynamicVector<real>& velocities = data_manager->host_data.v;
-    custom_vector<real3>& pos_pointer = data_manager->host_data.pos_rigid;
-    custom_vector<quaternion>& rot_pointer = data_manager->host_data.rot_rigid;
 
-#pragma omp parallel for
-    for (int i = 0; i < bodylist.size(); i++) {
-        if (data_manager->host_data.active_rigid[i] != 0) {
-            bodylist[i]->Variables().Get_qb().SetElement(0, 0, velocities[i * 6 + 0]);
-            bodylist[i]->Variables().Get_qb().SetElement(1, 0, velocities[i * 6 + 1]);
-            bodylist[i]->Variables().Get_qb().SetElement(2, 0, velocities[i * 6 + 2]);
-            bodylist[i]->Variables().Get_qb().SetElement(3, 0, velocities[i * 6 + 3]);
-            bodylist[i]->Variables().Get_qb().SetElement(4, 0, velocities[i * 6 + 4]);
-            bodylist[i]->Variables().Get_qb().SetElement(5, 0, velocities[i * 6 + 5]);
-
-            bodylist[i]->VariablesQbIncrementPosition(this->GetStep());
-            bodylist[i]->VariablesQbSetSpeed(this->GetStep());
-
-            bodylist[i]->Update(ChTime);
-
-            // update the position and rotation vectors
-            pos_pointer[i] = (real3(bodylist[i]->GetPos().x(), bodylist[i]->GetPos().y(), bodylist[i]->GetPos().z()));
-            rot_pointer[i] = (quaternion(bodylist[i]->GetRot().e0(), bodylist[i]->GetRot().e1(),
-                                         bodylist[i]->GetRot().e2(), bodylist[i]->GetRot().e3()));
-        }
-    }
+    AdvanceRigidBodies();
 
     ////#pragma omp parallel for
     for (int i = 0; i < (signed)data_manager->num_shafts; i++) {
@@ -200,6 +178,38 @@ bool ChSystemParallel::Integrate_Y() {
     return true;
 }
 
+void ChSystemParallel::AdvanceRigidBodies() {
+#pragma omp parallel for
+    for (int i = 0; i < bodylist.size(); i++) {
+        AdvanceRigidBody(i);
+    }
+}
+
+void ChSystemParallel::AdvanceRigidBody(int index) {
+    if (data_manager->host_data.active_rigid[index] == 0)
+        return;
+
+    DynamicVector<real>& velocities = data_manager->host_data.v;
+    auto& body = bodylist[index];
+
+    body->Variables().Get_qb().SetElement(0, 0, velocities[index * 6 + 0]);
+    body->Variables().Get_qb().SetElement(1, 0, velocities[index * 6 + 1]);
+    body->Variables().Get_qb().SetElement(2, 0, velocities[index * 6 + 2]);
+    body->Variables().Get_qb().SetElement(3, 0, velocities[index * 6 + 3]);
+    body->Variables().Get_qb().SetElement(4, 0, velocities[index * 6 + 4]);
+    body->Variables().Get_qb().SetElement(5, 0, velocities[index * 6 + 5]);
+
+    body->VariablesQbIncrementPosition(this->GetStep());
+    body->VariablesQbSetSpeed(this->GetStep());
+
+    body->Update(ChTime);
+
+    // update the position and rotation vectors
+    data_manager->host_data.pos_rigid[index] = real3(body->GetPos().x(), body->GetPos().y(), body->GetPos().z());
+    data_manager->host_data.rot_rigid[index] =
+        quaternion(body->GetRot().e0(), body->GetRot().e1(), body->GetRot().e2(), body->GetRot().e3());
+}
+
 //
 // Add the specified body to the system.
 // A unique identifier is assigned to each body for indexing purposes.
@@ -115,6 +115,14 @@ class CH_PARALLEL_API ChSystemParallel : public ChSystem {
     /// Calculate current body AABBs.
     void CalculateBodyAABB();
 
+    /// Advance the states of all rigid bodies with the velocities computed by the solver
+    /// and load the new positions and rotations in the data manager.
+    /// Called at the end of each step, after the solver.
+    virtual void AdvanceRigidBodies();
+
+    /// Advance the state of the rigid body with the specified index (see AdvanceRigidBodies).
+    void AdvanceRigidBody(int index);
+
     /// Get the contact force on the body with specified id.
     virtual real3 GetBodyContactForce(uint body_id) const = 0;
     /// Get the contact torque on the body with specified id.
@@ -257,10 +257,14 @@ void ChIterativeSolverParallelNSC::ComputeD() {
             break;
     }
 
+    bool mixed_precision = data_manager->settings.solver.mixed_precision;
+
     CLEAR_RESERVE_RESIZE(D_T, nnz_total, num_rows, num_dof)
     // D is automatically reserved during transpose!
     // CLEAR_RESERVE_RESIZE(D, nnz_total, num_dof, num_rows)
-    CLEAR_RESERVE_RESIZE(M_invD, nnz_total, num_dof, num_rows)
+    if (!mixed_precision) {
+        CLEAR_RESERVE_RESIZE(M_invD, nnz_total, num_dof, num_rows)
+    }
 
     data_manager->rigid_rigid->GenerateSparsity();
     data_manager->bilateral->GenerateSparsity();
@@ -280,9 +284,16 @@ void ChIterativeSolverParallelNSC::ComputeD() {
     LOG(INFO) << "ChIterativeSolverParallelNSC::ComputeD - D = trans(D_T)";
     // using the .transpose(); function will do in place transpose and copy
     data_manager->host_data.D = trans(D_T);
-    LOG(INFO) << "ChIterativeSolverParallelNSC::ComputeD - M_inv * D";
-
-    data_manager->host_data.M_invD = M_inv * data_manager->host_data.D;
+    if (mixed_precision) {
+        // Only the single precision copies are used in the Schur product, M_invD is not kept in double precision
+        LOG(INFO) << "ChIterativeSolverParallelNSC::ComputeD - single precision D_T and M_inv * D";
+        data_manager->host_data.D_T_single = D_T;
+        data_manager->host_data.M_invD_single = M_inv * data_manager->host_data.D;
+        M_invD = CompressedMatrix<real>();
+    } else {
+        LOG(INFO) << "ChIterativeSolverParallelNSC::ComputeD - M_inv * D";
+        data_manager->host_data.M_invD = M_inv * data_manager->host_data.D;
+    }
 
     data_manager->system_timer.stop("ChIterativeSolverParallel_D");
 }
@@ -334,7 +345,7 @@ void ChIterativeSolverParallelNSC::ComputeR() {
 }
 
 void ChIterativeSolverParallelNSC::ComputeN() {
-    if (data_manager->settings.solver.compute_N == false) {
+    if (data_manager->settings.solver.compute_N == false || data_manager->settings.solver.mixed_precision) {
         return;
     }
 
@@ -412,7 +423,11 @@ void ChIterativeSolverParallelNSC::ComputeImpulses() {
 
     if (data_manager->num_constraints > 0) {
         // Compute new velocity based on the lagrange multipliers
-        v = v + M_inv * hf + data_manager->host_data.M_invD * gamma;
+        if (data_manager->settings.solver.mixed_precision) {
+            v = v + M_inv * (hf + data_manager->host_data.D * gamma);
+        } else {
+            v = v + M_inv * hf + data_manager->host_data.M_invD * gamma;
+        }
     } else {
         // When there are no constraints we need to still apply gravity and other
         // body forces!
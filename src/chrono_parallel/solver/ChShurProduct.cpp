@@ -33,7 +33,44 @@ void ChShurProduct::operator()(const DynamicVector<real>& x, DynamicVector<real>
     const CompressedMatrix<real>& D_T = data_manager->host_data.D_T;
     const CompressedMatrix<real>& Nshur = data_manager->host_data.Nshur;
 
-    if (data_manager->settings.solver.local_solver_mode == data_manager->settings.solver.solver_mode) {
+    if (data_manager->settings.solver.mixed_precision) {
+        // D_T and M_invD are stored in single precision, x and the products are in double precision.
+        const CompressedMatrix<float>& D_T_single = data_manager->host_data.D_T_single;
+        const CompressedMatrix<float>& M_invD_single = data_manager->host_data.M_invD_single;
+
+        if (data_manager->settings.solver.local_solver_mode == data_manager->settings.solver.solver_mode) {
+            output = D_T_single * (M_invD_single * x) + E * x;
+        } else {
+            // Only the contact rows of the local solver mode (stored first) and the bilateral rows are used
+            uint num_dof = data_manager->num_dof;
+            uint num_contact_rows = 0;
+            switch (data_manager->settings.solver.local_solver_mode) {
+                case SolverMode::NORMAL:
+                    num_contact_rows = num_rigid_contacts;
+                    break;
+                case SolverMode::SLIDING:
+                    num_contact_rows = num_rigid_contacts * 3;
+                    break;
+                case SolverMode::SPINNING:
+                    num_contact_rows = num_rigid_contacts * 6;
+                    break;
+                default:
+                    break;
+            }
+
+            ConstSubVectorType x_c = subvector(x, 0, num_contact_rows);
+            ConstSubVectorType x_b = subvector(x, num_unilaterals, num_bilaterals);
+
+            blaze::DynamicVector<real> tmp =
+                submatrix(M_invD_single, 0, 0, num_dof, num_contact_rows) * x_c +
+                submatrix(M_invD_single, 0, num_unilaterals, num_dof, num_bilaterals) * x_b;
+            subvector(output, 0, num_contact_rows) = submatrix(D_T_single, 0, 0, num_contact_rows, num_dof) * tmp +
+                                                     subvector(E, 0, num_contact_rows) * x_c;
+            subvector(output, num_unilaterals, num_bilaterals) =
+                submatrix(D_T_single, num_unilaterals, 0, num_bilaterals, num_dof) * tmp +
+                subvector(E, num_unilaterals, num_bilaterals) * x_b;
+        }
+    } else if (data_manager->settings.solver.local_solver_mode == data_manager->settings.solver.solver_mode) {
         if (data_manager->settings.solver.compute_N) {
             output = Nshur * x + E * x;
         } else {
@@ -109,7 +146,12 @@ void ChShurProductBilateral::Setup(ChParallelDataManager* data_container_) {
     if (data_manager->num_bilaterals == 0) {
         return;
     }
-    NshurB = _DBT_ * _MINVDB_;
+    if (data_manager->settings.solver.mixed_precision) {
+        NshurB = _DBT_ * submatrix(data_manager->host_data.M_invD_single, 0, _num_uni_,
+                                   _num_rigid_dof_ + _num_shaft_dof_, _num_bil_);
+    } else {
+        NshurB = _DBT_ * _MINVDB_;
+    }
 }
 
 void ChShurProductBilateral::operator()(const DynamicVector<real>& x, DynamicVector<real>& output) {
@@ -141,6 +183,15 @@ void ChShurProductFEM::operator()(const DynamicVector<real>& x, DynamicVector<re
     int num_constraints = data_manager->num_fea_tets * (6 + 1);
     uint start_nodes =
         data_manager->num_rigid_bodies * 6 + data_manager->num_shafts + data_manager->num_fluid_bodies * 3;
+    if (data_manager->settings.solver.mixed_precision) {
+        output = submatrix(data_manager->host_data.D_T_single, start_tet, start_nodes, num_constraints,
+                           data_manager->num_fea_nodes * 3) *
+                     (submatrix(data_manager->host_data.M_invD_single, start_nodes, start_tet,
+                                data_manager->num_fea_nodes * 3, num_constraints) *
+                      x) +
+                 blaze::subvector(data_manager->host_data.E, start_tet, num_constraints) * x;
+        return;
+    }
     output = submatrix(data_manager->host_data.D_T, start_tet, start_nodes, num_constraints,
                        data_manager->num_fea_nodes * 3) *
                  submatrix(data_manager->host_data.M_invD, start_nodes, start_tet, data_manager->num_fea_nodes * 3,
@@ -43,7 +43,12 @@ uint ChSolverParallelJacobi::Solve(ChShurProduct& ShurProduct,
     temp.resize(size);
     DynamicVector<real> deltal;
     deltal.resize(size);
-    CompressedMatrix<real> Nshur = data_manager->host_data.D_T * data_manager->host_data.M_invD;
+    CompressedMatrix<real> Nshur;
+    if (data_manager->settings.solver.mixed_precision) {
+        Nshur = data_manager->host_data.D_T * data_manager->host_data.M_invD_single;
+    } else {
+        Nshur = data_manager->host_data.D_T * data_manager->host_data.M_invD;
+    }
     DynamicVector<real> D;
     D.resize(num_constraints, false);
     real theta = 1;
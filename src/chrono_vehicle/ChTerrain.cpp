@@ -23,5 +23,21 @@ namespace vehicle {
 
 ChTerrain::ChTerrain() : m_friction_fun(nullptr) {}
 
+void ChTerrain::GetProperties(double x, double y, double& height, ChVector<>& normal, float& friction) const {
+    height = GetHeight(x, y);
+    normal = GetNormal(x, y);
+    friction = GetCoefficientFriction(x, y);
+}
+
+void ChTerrain::GetProperties(int num_locations,
+                              const ChVector<>* locations,
+                              double* heights,
+                              ChVector<>* normals,
+                              float* frictions) const {
+    for (int i = 0; i < num_locations; i++) {
+        GetProperties(locations[i].x(), locations[i].y(), heights[i], normals[i], frictions[i]);
+    }
+}
+
 }  // end namespace vehicle
 }  // end namespace chrono
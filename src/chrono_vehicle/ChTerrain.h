@@ -54,6 +54,20 @@ class CH_VEHICLE_API ChTerrain {
     /// with other objects (including tire models that do not explicitly use it).
     virtual float GetCoefficientFriction(double x, double y) const = 0;
 
+    /// Get the terrain height, normal, and coefficient of friction at the specified (x,y) location.
+    /// The default implementation calls GetHeight, GetNormal, and GetCoefficientFriction. Derived
+    /// classes can override it to locate the point on the terrain only once.
+    virtual void GetProperties(double x, double y, double& height, ChVector<>& normal, float& friction) const;
+
+    /// Get the terrain height, normal, and coefficient of friction at several (x,y) locations.
+    /// The z components of the locations are ignored. The output arrays must hold num_locations values.
+    /// The default implementation calls the single-point GetProperties for each location.
+    virtual void GetProperties(int num_locations,
+                               const ChVector<>* locations,
+                               double* heights,
+                               ChVector<>* normals,
+                               float* frictions) const;
+
     /// Class to be used as a functor interface for location-dependent coefficient of friction.
     class ChApi FrictionFunctor {
       public:
@@ -16,6 +16,7 @@
 //
 // =============================================================================
 
+#include <algorithm>
 #include <cmath>
 #include <cstdio>
 
@@ -42,12 +43,13 @@ namespace vehicle {
 // -----------------------------------------------------------------------------
 // Default constructor.
 // -----------------------------------------------------------------------------
-RigidTerrain::RigidTerrain(ChSystem* system) : m_system(system), m_num_patches(0) {}
+RigidTerrain::RigidTerrain(ChSystem* system) : m_system(system), m_num_patches(0), m_indexed(false) {}
 
 // -----------------------------------------------------------------------------
 // Constructor from JSON file
 // -----------------------------------------------------------------------------
-RigidTerrain::RigidTerrain(ChSystem* system, const std::string& filename) : m_system(system), m_num_patches(0) {
+RigidTerrain::RigidTerrain(ChSystem* system, const std::string& filename)
+    : m_system(system), m_num_patches(0), m_indexed(false) {
     // Open the JSON file and read data
     FILE* fp = fopen(filename.c_str(), "r");
 
@@ -151,6 +153,7 @@ void RigidTerrain::LoadPatch(const rapidjson::Value& d) {
 // -----------------------------------------------------------------------------
 std::shared_ptr<RigidTerrain::Patch> RigidTerrain::AddPatch(const ChCoordsys<>& position) {
     m_num_patches++;
+    m_indexed = false;
     auto patch = std::make_shared<Patch>();
 
     // Create the rigid body for this patch (fixed)
@@ -224,6 +227,7 @@ std::shared_ptr<RigidTerrain::Patch> RigidTerrain::AddPatch(const ChCoordsys<>&
         patch->m_body->AddAsset(box);
     }
 
+    patch->m_size = size;
     patch->m_type = BOX;
 
     return patch;
@@ -236,11 +240,22 @@ std::shared_ptr<RigidTerrain::Patch> RigidTerrain::AddPatch(const ChCoordsys<>&
                                                             const std::string& mesh_name,
                                                             double sweep_sphere_radius,
                                                             bool visualization) {
-    auto patch = AddPatch(position);
-
     // Load mesh from file
-    patch->m_trimesh = std::make_shared<geometry::ChTriangleMeshConnected>();
-    patch->m_trimesh->LoadWavefrontMesh(mesh_file, true, true);
+    auto trimesh = std::make_shared<geometry::ChTriangleMeshConnected>();
+    trimesh->LoadWavefrontMesh(mesh_file, true, true);
+
+    return AddPatch(position, trimesh, mesh_name, sweep_sphere_radius, visualization);
+}
+
+// -----------------------------------------------------------------------------
+
+std::shared_ptr<RigidTerrain::Patch> RigidTerrain::AddPatch(const ChCoordsys<>& position,
+                                                            std::shared_ptr<geometry::ChTriangleMeshConnected> trimesh,
+                                                            const std::string& mesh_name,
+                                                            double sweep_sphere_radius,
+                                                            bool visualization) {
+    auto patch = AddPatch(position);
+    patch->m_trimesh = trimesh;
 
     // Create the collision model
     patch->m_body->GetCollisionModel()->ClearModel();
@@ -483,16 +498,133 @@ std::shared_ptr<ChBody> RigidTerrain::Patch::GetGroundBody() const {
 // Initialize all terrain patches
 // -----------------------------------------------------------------------------
 void RigidTerrain::Initialize() {
-    // Nothing to do here.
-    // Kept for consistency and possible future extensions.
+    BuildIndex();
+}
+
+// -----------------------------------------------------------------------------
+// Build a uniform 2D grid over the (x,y) projection of the triangles of all
+// patch surfaces (box faces and mesh faces, in the absolute frame). Each cell
+// lists the triangles whose bounding box overlaps it.
+// -----------------------------------------------------------------------------
+void RigidTerrain::BuildIndex() {
+    m_triangles.clear();
+
+    auto add_triangle = [this](const ChVector<>& v0, const ChVector<>& v1, const ChVector<>& v2, int patch) {
+        // Skip degenerate and vertical triangles, which a vertical ray cannot hit
+        ChVector<> normal = Vcross(v1 - v0, v2 - v0);
+        double length = normal.Length();
+        if (std::abs(normal.z()) <= 1e-12 * length)
+            return;
+        normal /= (normal.z() > 0) ? length : -length;
+        m_triangles.push_back({v0, v1, v2, normal, patch});
+    };
+
+    for (int ip = 0; ip < (int)m_patches.size(); ip++) {
+        const auto& patch = m_patches[ip];
+        switch (patch->m_type) {
+            case BOX: {
+                ChVector<> corners[8];
+                for (int i = 0; i < 8; i++) {
+                    ChVector<> loc(i & 1 ? 0.5 : -0.5, i & 2 ? 0.5 : -0.5, i & 4 ? 0.5 : -0.5);
+                    corners[i] = patch->m_body->TransformPointLocalToParent(loc * patch->m_size);
+                }
+                static const int faces[6][4] = {{0, 2, 6, 4}, {1, 3, 7, 5}, {0, 1, 5, 4},
+                                                {2, 3, 7, 6}, {0, 1, 3, 2}, {4, 5, 7, 6}};
+                for (int i = 0; i < 6; i++) {
+                    add_triangle(corners[faces[i][0]], corners[faces[i][1]], corners[faces[i][2]], ip);
+                    add_triangle(corners[faces[i][0]], corners[faces[i][2]], corners[faces[i][3]], ip);
+                }
+                break;
+            }
+            case MESH:
+            case HEIGHT_MAP: {
+                const auto& vertices = patch->m_trimesh->getCoordsVertices();
+                for (const auto& face : patch->m_trimesh->getIndicesVertexes()) {
+                    add_triangle(patch->m_body->TransformPointLocalToParent(vertices[face.x()]),
+                                 patch->m_body->TransformPointLocalToParent(vertices[face.y()]),
+                                 patch->m_body->TransformPointLocalToParent(vertices[face.z()]), ip);
+                }
+                break;
+            }
+        }
+    }
+
+    m_cell_start.clear();
+    m_cell_triangles.clear();
+    m_grid_nx = 0;
+    m_grid_ny = 0;
+    m_indexed = true;
+
+    if (m_triangles.empty())
+        return;
+
+    // Bounding box of all triangles in the (x,y) plane
+    double xmin = m_triangles[0].v0.x();
+    double xmax = xmin;
+    double ymin = m_triangles[0].v0.y();
+    double ymax = ymin;
+    for (const auto& tri : m_triangles) {
+        xmin = std::min({xmin, tri.v0.x(), tri.v1.x(), tri.v2.x()});
+        xmax = std::max({xmax, tri.v0.x(), tri.v1.x(), tri.v2.x()});
+        ymin = std::min({ymin, tri.v0.y(), tri.v1.y(), tri.v2.y()});
+        ymax = std::max({ymax, tri.v0.y(), tri.v1.y(), tri.v2.y()});
+    }
+
+    // Square cells, about as many as triangles (and at most 2048 per direction)
+    const int max_cells = 2048;
+    double cell_size = std::sqrt((xmax - xmin) * (ymax - ymin) / m_triangles.size());
+    cell_size = std::max({cell_size, (xmax - xmin) / max_cells, (ymax - ymin) / max_cells, 1e-6});
+    m_grid_nx = std::min((int)((xmax - xmin) / cell_size) + 1, max_cells);
+    m_grid_ny = std::min((int)((ymax - ymin) / cell_size) + 1, max_cells);
+    m_grid_x0 = xmin;
+    m_grid_y0 = ymin;
+    m_grid_inv_size = 1 / cell_size;
+
+    // Range of cells overlapped by the bounding box of a triangle
+    auto cell_range = [this](const Triangle& tri, int& i0, int& i1, int& j0, int& j1) {
+        double x0 = std::min({tri.v0.x(), tri.v1.x(), tri.v2.x()});
+        double x1 = std::max({tri.v0.x(), tri.v1.x(), tri.v2.x()});
+        double y0 = std::min({tri.v0.y(), tri.v1.y(), tri.v2.y()});
+        double y1 = std::max({tri.v0.y(), tri.v1.y(), tri.v2.y()});
+        i0 = std::max((int)((x0 - m_grid_x0) * m_grid_inv_size), 0);
+        i1 = std::min((int)((x1 - m_grid_x0) * m_grid_inv_size), m_grid_nx - 1);
+        j0 = std::max((int)((y0 - m_grid_y0) * m_grid_inv_size), 0);
+        j1 = std::min((int)((y1 - m_grid_y0) * m_grid_inv_size), m_grid_ny - 1);
+    };
+
+    // Count the triangles in each cell, then fill the cell lists
+    m_cell_start.assign(m_grid_nx * m_grid_ny + 1, 0);
+    int i0, i1, j0, j1;
+    for (const auto& tri : m_triangles) {
+        cell_range(tri, i0, i1, j0, j1);
+        for (int j = j0; j <= j1; j++)
+            for (int i = i0; i <= i1; i++)
+                m_cell_start[j * m_grid_nx + i + 1]++;
+    }
+    for (int ic = 0; ic < m_grid_nx * m_grid_ny; ic++)
+        m_cell_start[ic + 1] += m_cell_start[ic];
+
+    m_cell_triangles.resize(m_cell_start.back());
+    std::vector<int> cell_fill(m_cell_start.begin(), m_cell_start.end() - 1);
+    for (int it = 0; it < (int)m_triangles.size(); it++) {
+        cell_range(m_triangles[it], i0, i1, j0, j1);
+        for (int j = j0; j <= j1; j++)
+            for (int i = i0; i <= i1; i++)
+                m_cell_triangles[cell_fill[j * m_grid_nx + i]++] = it;
+    }
 }
 
 // -----------------------------------------------------------------------------
 // Functions for obtaining the terrain height, normal, and coefficient of
 // friction  at the specified location.
-// This is done by casting vertical rays into each patch collision model.
+// This is done by intersecting a vertical line with the triangles listed in the
+// grid cell containing the location or, if the grid index is not available, by
+// casting vertical rays into each patch collision model.
 // -----------------------------------------------------------------------------
 bool RigidTerrain::FindPoint(double x, double y, double& height, ChVector<>& normal, float& friction) const {
+    if (m_indexed)
+        return FindPointIndexed(x, y, height, normal, friction);
+
     bool hit = false;
     height = -1000;
     normal = ChVector<>(0, 0, 1);
@@ -515,6 +647,46 @@ bool RigidTerrain::FindPoint(double x, double y, double& height, ChVector<>& nor
     return hit;
 }
 
+bool RigidTerrain::FindPointIndexed(double x, double y, double& height, ChVector<>& normal, float& friction) const {
+    bool hit = false;
+    height = -1000;
+    normal = ChVector<>(0, 0, 1);
+    friction = 0.8f;
+
+    int i = (int)std::floor((x - m_grid_x0) * m_grid_inv_size);
+    int j = (int)std::floor((y - m_grid_y0) * m_grid_inv_size);
+    if (i < 0 || i >= m_grid_nx || j < 0 || j >= m_grid_ny)
+        return false;
+
+    int ic = j * m_grid_nx + i;
+    for (int k = m_cell_start[ic]; k < m_cell_start[ic + 1]; k++) {
+        const Triangle& tri = m_triangles[m_cell_triangles[k]];
+
+        // Barycentric coordinates of (x,y) in the projected triangle
+        double e1x = tri.v1.x() - tri.v0.x();
+        double e1y = tri.v1.y() - tri.v0.y();
+        double e2x = tri.v2.x() - tri.v0.x();
+        double e2y = tri.v2.y() - tri.v0.y();
+        double px = x - tri.v0.x();
+        double py = y - tri.v0.y();
+        double det = e1x * e2y - e1y * e2x;
+        double b1 = (px * e2y - py * e2x) / det;
+        double b2 = (e1x * py - e1y * px) / det;
+        if (b1 < -1e-10 || b2 < -1e-10 || b1 + b2 > 1 + 1e-10)
+            continue;
+
+        double z = tri.v0.z() + b1 * (tri.v1.z() - tri.v0.z()) + b2 * (tri.v2.z() - tri.v0.z());
+        if (z > height) {
+            hit = true;
+            height = z;
+            normal = tri.normal;
+            friction = m_patches[tri.patch]->m_friction;
+        }
+    }
+
+    return hit;
+}
+
 double RigidTerrain::GetHeight(double x, double y) const {
     double height;
     ChVector<> normal;
@@ -548,6 +720,16 @@ float RigidTerrain::GetCoefficientFriction(double x, double y) const {
     return friction;
 }
 
+void RigidTerrain::GetProperties(double x, double y, double& height, ChVector<>& normal, float& friction) const {
+    bool hit = FindPoint(x, y, height, normal, friction);
+
+    if (!hit)
+        height = 0.0;
+
+    if (m_friction_fun)
+        friction = (*m_friction_fun)(x, y);
+}
+
 // -----------------------------------------------------------------------------
 // Export all patch meshes as macros in PovRay include files.
 // -----------------------------------------------------------------------------
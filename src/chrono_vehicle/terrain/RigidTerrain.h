@@ -98,6 +98,7 @@ class CH_VEHICLE_API RigidTerrain : public ChTerrain {
         std::shared_ptr<ChBody> m_body;
         std::shared_ptr<geometry::ChTriangleMeshConnected> m_trimesh;
         std::string m_mesh_name;
+        ChVector<> m_size;
         float m_friction;
 
         friend class RigidTerrain;
@@ -135,6 +136,17 @@ class CH_VEHICLE_API RigidTerrain : public ChTerrain {
         bool visualization = true        ///< [in] enable/disable construction of visualization assets
     );
 
+    /// Add a terrain patch represented by a triangular mesh.
+    /// The mesh, used for both contact and visualization, is not modified and can be shared with other terrains
+    /// (see ChVehicleBatch::GetMesh). The collision shape and the query index built from it are not shared.
+    std::shared_ptr<Patch> AddPatch(
+        const ChCoordsys<>& position,                                 ///< [in] patch location and orientation
+        std::shared_ptr<geometry::ChTriangleMeshConnected> trimesh,  ///< [in] triangular mesh
+        const std::string& mesh_name,                                 ///< [in] name of the mesh asset
+        double sweep_sphere_radius = 0,                               ///< [in] radius of sweep sphere
+        bool visualization = true  ///< [in] enable/disable construction of visualization assets
+    );
+
     /// Add a terrain patch represented by a height-field map.
     /// The height map is specified through a BMP gray-scale image.
     std::shared_ptr<Patch> AddPatch(
@@ -149,6 +161,9 @@ class CH_VEHICLE_API RigidTerrain : public ChTerrain {
     );
 
     /// Initialize all defined terrain patches.
+    /// This builds a 2D grid index of the patch surfaces, used by the height, normal, and friction queries.
+    /// Patches are assumed fixed after this call. If patches are added later, Initialize must be called
+    /// again; until then, the queries cast rays through the collision system.
     void Initialize();
 
     /// Get the terrain height at the specified (x,y) location.
@@ -166,6 +181,16 @@ class CH_VEHICLE_API RigidTerrain : public ChTerrain {
     /// value from the appropriate patch, as specified through SetContactFrictionCoefficient.
     virtual float GetCoefficientFriction(double x, double y) const override;
 
+    using ChTerrain::GetProperties;
+
+    /// Get the terrain height, normal, and coefficient of friction at the specified (x,y) location.
+    /// The point is located on the terrain only once.
+    virtual void GetProperties(double x,
+                               double y,
+                               double& height,
+                               ChVector<>& normal,
+                               float& friction) const override;
+
     /// Export all patch meshes as macros in PovRay include files.
     void ExportMeshPovray(const std::string& out_dir  ///< [in] output directory
     );
@@ -175,10 +200,29 @@ class CH_VEHICLE_API RigidTerrain : public ChTerrain {
     int m_num_patches;
     std::vector<std::shared_ptr<Patch>> m_patches;
 
+    /// Triangle of a patch surface, in the absolute frame.
+    struct Triangle {
+        ChVector<> v0, v1, v2;  ///< vertices
+        ChVector<> normal;      ///< face normal, pointing upward
+        int patch;              ///< index of the patch
+    };
+
+    bool m_indexed;                       ///< true if the grid index is up to date
+    std::vector<Triangle> m_triangles;    ///< triangles of all patch surfaces
+    int m_grid_nx;                        ///< number of grid cells in X direction
+    int m_grid_ny;                        ///< number of grid cells in Y direction
+    double m_grid_x0;                     ///< X coordinate of the grid lower corner
+    double m_grid_y0;                     ///< Y coordinate of the grid lower corner
+    double m_grid_inv_size;               ///< inverse of the grid cell size
+    std::vector<int> m_cell_start;        ///< start of the triangle list of each cell
+    std::vector<int> m_cell_triangles;    ///< triangles overlapping each cell
+
     std::shared_ptr<Patch> AddPatch(const ChCoordsys<>& position);
     void LoadPatch(const rapidjson::Value& a);
 
+    void BuildIndex();
     bool FindPoint(double x, double y, double& height, ChVector<>& normal, float& friction) const;
+    bool FindPointIndexed(double x, double y, double& height, ChVector<>& normal, float& friction) const;
 };
 
 /// @} vehicle_terrain
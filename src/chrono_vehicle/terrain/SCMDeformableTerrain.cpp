@@ -17,9 +17,12 @@
 //
 // =============================================================================
 
+#include <algorithm>
+#include <atomic>
 #include <cstdio>
 #include <cmath>
 #include <queue>
+#include <unordered_set>
 
 #include "chrono/physics/ChMaterialSurfaceNSC.h"
 #include "chrono/physics/ChMaterialSurfaceSMC.h"
@@ -169,6 +172,14 @@ void SCMDeformableTerrain::EnableMovingPatch(std::shared_ptr<ChBody> body,
     m_ground->m_moving_patch = true;
 }
 
+// Enable sparse storage
+void SCMDeformableTerrain::EnableSparseStorage(int tile_size, size_t max_full_tiles, size_t max_tiles) {
+    m_ground->m_sparse = true;
+    m_ground->m_tile_size = tile_size;
+    m_ground->m_max_full_tiles = max_full_tiles;
+    m_ground->m_max_tiles = max_tiles;
+}
+
 // Initialize the terrain as a flat grid
 void SCMDeformableTerrain::Initialize(double height, double sizeX, double sizeY, int divX, int divY) {
     m_ground->Initialize(height, sizeX, sizeY, divX, divY);
@@ -217,6 +228,10 @@ void SCMDeformableTerrain::PrintStepStatistics(std::ostream& os) const {
     os << "   Number faces:            " << m_ground->m_num_faces << std::endl;
     if (m_ground->do_refinement)
         os << "   Number faces refinement: " << m_ground->m_num_marked_faces << std::endl;
+    if (m_ground->m_sparse) {
+        os << "   Number tiles:            " << m_ground->m_tiles.size() << std::endl;
+        os << "   Number full tiles:       " << m_ground->m_full_tiles.size() << std::endl;
+    }
 }
 
 // -----------------------------------------------------------------------------
@@ -254,6 +269,13 @@ SCMDeformableSoil::SCMDeformableSoil(ChSystem* system) {
     Janosi_shear = 0.01;
     elastic_K = 50000000;
 
+    m_sparse = false;
+    m_tile_size = 32;
+    m_max_full_tiles = 1024;
+    m_max_tiles = 0;
+    m_step = 0;
+    m_mesh_current = false;
+
     Initialize(0,3,3,10,10);
     
     plot_type = SCMDeformableTerrain::PLOT_NONE;
@@ -270,6 +292,13 @@ SCMDeformableSoil::SCMDeformableSoil(ChSystem* system) {
 
 // Initialize the terrain as a flat grid
 void SCMDeformableSoil::Initialize(double height, double sizeX, double sizeY, int nX, int nY) {
+    if (m_sparse) {
+        m_height = height;
+        m_grid_height0.clear();
+        SetupSparseGrid(nX + 1, nY + 1, sizeX, sizeY);
+        return;
+    }
+
     m_trimesh_shape->GetMesh()->Clear();
     // Readability aliases
     auto trimesh = m_trimesh_shape->GetMesh();
@@ -327,6 +356,13 @@ void SCMDeformableSoil::Initialize(double height, double sizeX, double sizeY, in
         }
     }
 
+    m_grid = true;
+    m_grid_nx = nvx;
+    m_grid_ny = nvy;
+    m_grid_dx = dx;
+    m_grid_dy = dy;
+    m_grid_origin = ChVector2<>(-0.5 * sizeX, -0.5 * sizeY);
+
     // Needed! pre-computes aux.topology 
     // data structures for the mesh, aux. material data, etc.
     SetupAuxData();
@@ -336,6 +372,9 @@ void SCMDeformableSoil::Initialize(double height, double sizeX, double sizeY, in
 void SCMDeformableSoil::Initialize(const std::string& mesh_file) {
     m_trimesh_shape->GetMesh()->Clear();
     m_trimesh_shape->GetMesh()->LoadWavefrontMesh(mesh_file, true, true);
+    m_grid = false;
+
+    SetupAuxData();
 }
 
 // Initialize the terrain from a specified height map.
@@ -356,6 +395,21 @@ void SCMDeformableSoil::Initialize(const std::string& heightmap_file,
     int nv_x = hmap.TellWidth();
     int nv_y = hmap.TellHeight();
 
+    // With sparse storage, only keep the initial heights
+    if (m_sparse) {
+        double h_scale = (hMax - hMin) / 255;
+        m_grid_height0.resize(nv_x * nv_y);
+        unsigned int iv = 0;
+        for (int iy = nv_y - 1; iy >= 0; --iy) {
+            for (int ix = 0; ix < nv_x; ++ix) {
+                double gray = 0.299 * hmap(ix, iy)->Red + 0.587 * hmap(ix, iy)->Green + 0.114 * hmap(ix, iy)->Blue;
+                m_grid_height0[iv++] = (float)(hMin + gray * h_scale);
+            }
+        }
+        SetupSparseGrid(nv_x, nv_y, sizeX, sizeY);
+        return;
+    }
+
     // Construct a triangular mesh of sizeX x sizeY.
     // Each pixel in the BMP represents a vertex.
     // The gray level of a pixel is mapped to the height range, with black corresponding
@@ -453,6 +507,13 @@ void SCMDeformableSoil::Initialize(const std::string& heightmap_file,
         normals[in] /= (double)accumulators[in];
     }
 
+    m_grid = true;
+    m_grid_nx = nv_x;
+    m_grid_ny = nv_y;
+    m_grid_dx = dx;
+    m_grid_dy = dy;
+    m_grid_origin = ChVector2<>(-0.5 * sizeX, -0.5 * sizeY);
+
     // Needed! pre-computes auxiliary topology 
     // data structures for the mesh, aux. material data, etc.
     SetupAuxData();
@@ -489,6 +550,7 @@ void SCMDeformableSoil::SetupAuxData() {
         p_level_initial[i] = p_level[i];
     }
 
+    connected_vertexes.clear();
     connected_vertexes.resize( vertices.size() );
     for (unsigned int iface = 0; iface < idx_vertices.size(); ++iface) {
         connected_vertexes[idx_vertices[iface][0]].insert(idx_vertices[iface][1]);
@@ -525,6 +587,11 @@ void SCMDeformableSoil::ComputeInternalForces() {
     this->GetLoadList().clear();
     m_contact_forces.clear();
 
+    if (m_sparse && m_grid) {
+        ComputeInternalForcesSparse();
+        return;
+    }
+
     //
     // Compute (pseudo)areas per node
     //
@@ -573,220 +640,153 @@ void SCMDeformableSoil::ComputeInternalForces() {
         patch_max.y() = center.y() + m_patch_dim.y() / 2;
     }
 
-    // Loop through all vertices.
-    // - set default SCM quantities (in case no ray-hit)
-    // - skip vertices outside moving patch (if option enabled)
-    // - cast ray and record result in a map (key: vertex index)
-    // - initialize patch id to -1 (not set)
-    struct HitRecord {
-        ChContactable* contactable;  // pointer to hit object
-        ChVector<> abs_point;        // hit point, expressed in global frame
-        int patch_id;                // index of associated patch id
-    };
-    std::unordered_map<int, HitRecord> hits;
-
-    for (int i = 0; i < vertices.size(); ++i) {
-        // Initialize SCM quantities at current vertex
-        p_sigma[i] = 0;
-        p_sinkage_elastic[i] = 0;
-        p_step_plastic_flow[i] = 0;
-        p_erosion[i] = false;
-        p_level[i] = plane.TransformParentToLocal(vertices[i]).y();
-        p_hit_level[i] = 1e9;
+    std::vector<std::pair<int, HitRecord>> hit_list;
+    int num_patches = 0;
 
-        // Skip vertices outside moving patch
-        if (m_moving_patch) {
-            if (vertices[i].x() < patch_min.x() || vertices[i].x() > patch_max.x() || vertices[i].y() < patch_min.y() ||
-                vertices[i].y() > patch_max.y()) {
-                continue;
+    if (m_grid) {
+        // Structured grid: the vertices under the moving patch are found by index arithmetic, the rays
+        // are cast in parallel and the contact patches are flood-filled over the implicit grid topology.
+        int num_vertices = (int)vertices.size();
+
+        // Initialize SCM quantities at all vertices (the bits of p_erosion are shared between vertices)
+        std::fill(p_erosion.begin(), p_erosion.end(), false);
+        GetSystem()->GetTaskScheduler()->ParallelFor(0, num_vertices,
+                                                     [&](int i) {
+                                                         p_sigma[i] = 0;
+                                                         p_sinkage_elastic[i] = 0;
+                                                         p_step_plastic_flow[i] = 0;
+                                                         p_level[i] = plane.TransformParentToLocal(vertices[i]).y();
+                                                         p_hit_level[i] = 1e9;
+                                                     },
+                                                     1024);
+
+        int ix_min, ix_max, iy_min, iy_max;
+        GetGridRange(patch_min, patch_max, ix_min, ix_max, iy_min, iy_max);
+        std::vector<HitRecord> grid_hits;
+        num_patches = CastGridRays(ix_min, ix_max, iy_min, iy_max, patch_min, patch_max, grid_hits);
+
+        int nx = ix_max - ix_min + 1;
+        for (int k = 0; k < (int)grid_hits.size(); ++k) {
+            if (grid_hits[k].contactable) {
+                int i = (ix_min + k % nx) + m_grid_nx * (iy_min + k / nx);
+                hit_list.push_back(std::make_pair(i, grid_hits[k]));
             }
         }
+    } else {
+        // Loop through all vertices.
+        // - set default SCM quantities (in case no ray-hit)
+        // - skip vertices outside moving patch (if option enabled)
+        // - cast ray and record result in a map (key: vertex index)
+        // - initialize patch id to -1 (not set)
+        std::unordered_map<int, HitRecord> hits;
+
+        for (int i = 0; i < vertices.size(); ++i) {
+            // Initialize SCM quantities at current vertex
+            p_sigma[i] = 0;
+            p_sinkage_elastic[i] = 0;
+            p_step_plastic_flow[i] = 0;
+            p_erosion[i] = false;
+            p_level[i] = plane.TransformParentToLocal(vertices[i]).y();
+            p_hit_level[i] = 1e9;
+
+            // Skip vertices outside moving patch
+            if (m_moving_patch) {
+                if (vertices[i].x() < patch_min.x() || vertices[i].x() > patch_max.x() ||
+                    vertices[i].y() < patch_min.y() || vertices[i].y() > patch_max.y()) {
+                    continue;
+                }
+            }
 
-        // Perform ray casting from current vertex
-        collision::ChCollisionSystem::ChRayhitResult mrayhit_result;
-        ChVector<> to = vertices[i] + N * test_high_offset;
-        ChVector<> from = to - N * test_low_offset;
-        this->GetSystem()->GetCollisionSystem()->RayHit(from, to, mrayhit_result);
-        m_num_ray_casts++;
-        if (mrayhit_result.hit) {
-            HitRecord record = { mrayhit_result.hitModel->GetContactable(), mrayhit_result.abs_hitPoint, -1 };
-            hits.insert(std::make_pair(i, record));
+            // Perform ray casting from current vertex
+            collision::ChCollisionSystem::ChRayhitResult mrayhit_result;
+            ChVector<> to = vertices[i] + N * test_high_offset;
+            ChVector<> from = to - N * test_low_offset;
+            this->GetSystem()->GetCollisionSystem()->RayHit(from, to, mrayhit_result);
+            m_num_ray_casts++;
+            if (mrayhit_result.hit) {
+                HitRecord record = { mrayhit_result.hitModel->GetContactable(), mrayhit_result.abs_hitPoint, -1 };
+                hits.insert(std::make_pair(i, record));
+            }
         }
-    }
 
-    // Loop through all hit vertices and determine to which contact patch they belong.
-    // We use here the connected_vertexes map (from a vertex to its adjacent vertices) which is
-    // set up at initialization and updated when the mesh is refined (if refinement is enabled).
-    // Use a queue-based flood-filling algorithm.
-    int num_patches = 0;
-    for (auto& h : hits) {
-        int i = h.first;
-        if (h.second.patch_id != -1)                               // move on if vertex already assigned to a patch
-            continue;                                              //
-        std::queue<int> todo;                                      //
-        h.second.patch_id = num_patches++;                         // assign this vertex to a new patch
-        todo.push(i);                                              // add vertex to end of queue
-        while (!todo.empty()) {                                    //
-            auto crt = hits.find(todo.front());                    // current vertex is first element in queue
-            todo.pop();                                            // remove first element of queue
-            auto crt_i = crt->first;                               //
-            auto crt_patch = crt->second.patch_id;                 //
-            for (const auto& nbr_i : connected_vertexes[crt_i]) {  // loop over all neighbors
-                auto nbr = hits.find(nbr_i);                       // look for neighbor in list of hit vertices
-                if (nbr == hits.end())                             // move on if neighbor is not a hit vertex
-                    continue;                                      //
-                if (nbr->second.patch_id != -1)                    // (COULD BE REMOVED, unless we update patch area)
-                    continue;                                      //
-                nbr->second.patch_id = crt_patch;                  // assign neighbor to same patch
-                todo.push(nbr_i);                                  // add neighbor to end of queue
+        // Loop through all hit vertices and determine to which contact patch they belong.
+        // We use here the connected_vertexes map (from a vertex to its adjacent vertices) which is
+        // set up at initialization and updated when the mesh is refined (if refinement is enabled).
+        // Use a queue-based flood-filling algorithm.
+        for (auto& h : hits) {
+            int i = h.first;
+            if (h.second.patch_id != -1)                               // move on if vertex already assigned to a patch
+                continue;                                              //
+            std::queue<int> todo;                                      //
+            h.second.patch_id = num_patches++;                         // assign this vertex to a new patch
+            todo.push(i);                                              // add vertex to end of queue
+            while (!todo.empty()) {                                    //
+                auto crt = hits.find(todo.front());                    // current vertex is first element in queue
+                todo.pop();                                            // remove first element of queue
+                auto crt_i = crt->first;                               //
+                auto crt_patch = crt->second.patch_id;                 //
+                for (const auto& nbr_i : connected_vertexes[crt_i]) {  // loop over all neighbors
+                    auto nbr = hits.find(nbr_i);                       // look for neighbor in list of hit vertices
+                    if (nbr == hits.end())                             // move on if neighbor is not a hit vertex
+                        continue;                                      //
+                    if (nbr->second.patch_id != -1)                    // (COULD BE REMOVED, unless we update patch area)
+                        continue;                                      //
+                    nbr->second.patch_id = crt_patch;                  // assign neighbor to same patch
+                    todo.push(nbr_i);                                  // add neighbor to end of queue
+                }
             }
         }
+
+        // Process the hit vertices in index order, as on a grid, independently of the hash map
+        hit_list.assign(hits.begin(), hits.end());
+        std::sort(hit_list.begin(), hit_list.end(),
+                  [](const std::pair<int, HitRecord>& a, const std::pair<int, HitRecord>& b) { return a.first < b.first; });
     }
 
     // Collect hit vertices assigned to each patch.
-    struct PatchRecord {
-        std::vector<ChVector2<>> points;  // points in patch (projected on reference plane)
-        double area;                      // patch area
-        double perimeter;                 // patch perimeter
-        double Kc_b;                      // approximate Bekker Kc/b value
-    };
     std::vector<PatchRecord> patches(num_patches);
-    for (auto& h : hits) {
+    for (auto& h : hit_list) {
         ChVector<> v = plane.TransformParentToLocal(vertices[h.first]);
         patches[h.second.patch_id].points.push_back(ChVector2<>(v.x(), v.z()));
     }
 
     // Calculate area and perimeter of each patch.
     // Calculate approximation to Beker term Kc/b.
-    for (auto& p : patches) {
-        if (Bekker_Kc == 0) {
-            p.Kc_b = 0;
-            continue;
-        }
-
-        utils::ChConvexHull2D ch(p.points);
-        p.area = ch.GetArea();
-        p.perimeter = ch.GetPerimeter();
-        if (p.area < 1e-6) {
-            p.Kc_b = 0;
-        } else {
-            double b = 2 * p.area / p.perimeter;
-            p.Kc_b = Bekker_Kc / b;
-        }
-    }
+    ComputePatchKcb(patches);
 
     // Process only hit vertices
-    for (auto& h : hits) {
+    for (auto& h : hit_list) {
         int i = h.first;
         ChContactable* contactable = h.second.contactable;
         const ChVector<>& abs_point = h.second.abs_point;
         int patch_id = h.second.patch_id;
 
-        double p_hit_offset = 1e9;
-
         p_hit_level[i] = plane.TransformParentToLocal(abs_point).y();
-        p_hit_offset = -p_hit_level[i] + p_level_initial[i];
+        double p_hit_offset = -p_hit_level[i] + p_level_initial[i];
 
         p_speeds[i] = contactable->GetContactPointSpeed(vertices[i]);
 
-        ChVector<> T = -p_speeds[i];
-        T = plane.TransformDirectionParentToLocal(T);
-        double Vn = -T.y();
-        T.y() = 0;
-        T = plane.TransformDirectionLocalToParent(T);
-        T.Normalize();
-
-        // Compute i-th force:
-        ChVector<> Fn;
-        ChVector<> Ft;
-
-        // Elastic try:
-        p_sigma[i] = elastic_K * (p_hit_offset - p_sinkage_plastic[i]);
-
-        // Handle unilaterality:
-        if (p_sigma[i] < 0) {
-            p_sigma[i] = 0;
-        } else {
-            // add compressive speed-proportional damping
-            ////if (Vn < 0) {
-            ////    p_sigma[i] += -Vn * this->damping_R;
-            ////}
-
-            p_sinkage[i] = p_hit_offset;
+        NodeState node = {p_sinkage[i], p_sinkage_plastic[i], p_sinkage_elastic[i], p_step_plastic_flow[i],
+                          p_kshear[i],  p_sigma[i],           p_sigma_yeld[i],       p_tau[i]};
+        ChVector<> force;
+        bool loaded = ComputeNodeForce(node, p_hit_offset, p_speeds[i], p_area[i], patches[patch_id].Kc_b, force);
+        p_sinkage[i] = node.sinkage;
+        p_sinkage_plastic[i] = node.sinkage_plastic;
+        p_sinkage_elastic[i] = node.sinkage_elastic;
+        p_step_plastic_flow[i] = node.step_plastic_flow;
+        p_kshear[i] = node.kshear;
+        p_sigma[i] = node.sigma;
+        p_sigma_yeld[i] = node.sigma_yeld;
+        p_tau[i] = node.tau;
+
+        if (loaded) {
             p_level[i] = p_hit_level[i];
 
-            // Accumulate shear for Janosi-Hanamoto
-            p_kshear[i] += Vdot(p_speeds[i], -T) * GetSystem()->GetStep();
-
-            // Plastic correction:
-            if (p_sigma[i] > p_sigma_yeld[i]) {
-                // Bekker formula
-                p_sigma[i] = (patches[patch_id].Kc_b + Bekker_Kphi) * pow(p_sinkage[i], Bekker_n);
-                p_sigma_yeld[i] = p_sigma[i];
-                double old_sinkage_plastic = p_sinkage_plastic[i];
-                p_sinkage_plastic[i] = p_sinkage[i] - p_sigma[i] / elastic_K;
-                p_step_plastic_flow[i] = (p_sinkage_plastic[i] - old_sinkage_plastic) / GetSystem()->GetStep();
-            }
-
-            p_sinkage_elastic[i] = p_sinkage[i] - p_sinkage_plastic[i];
-
-            // add compressive speed-proportional damping (not clamped by pressure yield)
-            ////if (Vn < 0) {
-            p_sigma[i] += -Vn * damping_R;
-            ////}
-
-            // Mohr-Coulomb
-            double tau_max = Mohr_cohesion + p_sigma[i] * tan(Mohr_friction * CH_C_DEG_TO_RAD);
-
-            // Janosi-Hanamoto
-            p_tau[i] = tau_max * (1.0 - exp(-(p_kshear[i] / Janosi_shear)));
-
-            Fn = N * p_area[i] * p_sigma[i];
-            Ft = T * p_area[i] * p_tau[i];
-
-            if (ChBody* rigidbody = dynamic_cast<ChBody*>(contactable)) {
-                // [](){} Trick: no deletion for this shared ptr, since 'rigidbody' was not a new ChBody()
-                // object, but an already used pointer because mrayhit_result.hitModel->GetPhysicsItem()
-                // cannot return it as shared_ptr, as needed by the ChLoadBodyForce:
-                std::shared_ptr<ChBody> srigidbody(rigidbody, [](ChBody*) {});
-                std::shared_ptr<ChLoadBodyForce> mload(
-                    new ChLoadBodyForce(srigidbody, Fn + Ft, false, vertices[i], false));
-                this->Add(mload);
-
-                // Accumulate contact force for this rigid body.
-                // The resultant force is assumed to be applied at the body COM.
-                // All components of the generalized terrain force are expressed in the global frame.
-                auto itr = m_contact_forces.find(contactable);
-                if (itr == m_contact_forces.end()) {
-                    // Create new entry and initialize generalized force.
-                    ChVector<> force = Fn + Ft;
-                    TerrainForce frc;
-                    frc.point = srigidbody->GetPos();
-                    frc.force = force;
-                    frc.moment = Vcross(Vsub(vertices[i], srigidbody->GetPos()), force);
-                    m_contact_forces.insert(std::make_pair(contactable, frc));
-                } else {
-                    // Update generalized force.
-                    ChVector<> force = Fn + Ft;
-                    itr->second.force += force;
-                    itr->second.moment += Vcross(Vsub(vertices[i], srigidbody->GetPos()), force);
-                }
-            } else if (ChLoadableUV* surf = dynamic_cast<ChLoadableUV*>(contactable)) {
-                // [](){} Trick: no deletion for this shared ptr
-                std::shared_ptr<ChLoadableUV> ssurf(surf, [](ChLoadableUV*) {});
-                std::shared_ptr<ChLoad<ChLoaderForceOnSurface>> mload(new ChLoad<ChLoaderForceOnSurface>(ssurf));
-                mload->loader.SetForce(Fn + Ft);
-                mload->loader.SetApplication(0.5, 0.5);  //***TODO*** set UV, now just in middle
-                this->Add(mload);
-
-                // Accumulate contact forces for this surface.
-                //// TODO
-            }
+            AddNodeForce(contactable, vertices[i], force);
 
             // Update mesh representation
             vertices[i] = p_vertices_initial[i] - N * p_sinkage[i];
-
-        }  // end positive contact force
+        }
 
     } // end loop on ray hits
 
@@ -800,6 +800,8 @@ void SCMDeformableSoil::ComputeInternalForces() {
     m_timer_refinement.start();
 
     if (do_refinement) {
+        // The refined mesh is no longer a regular grid
+        m_grid = false;
 
         std::vector<std::vector<double>*> aux_data_double;
         aux_data_double.push_back(&p_level);
@@ -976,138 +978,83 @@ void SCMDeformableSoil::ComputeInternalForces() {
 
         }  // end for islands
 
-        //***TEST***
-        // int mm = p_massremainder.size();
-        // p_massremainder.clear();p_massremainder.resize(mm);
-
         // Erosion domain area select, by topologically dilation of all the
-        // boundaries of the islands:
-        std::set<int> domain_erosion= domain_boundaries;
-        for (const auto& ie : domain_boundaries)
-            p_erosion[ie] = true;
-        std::set<int> front_erosion = domain_boundaries;
-        for (int iloop = 0; iloop <10; ++iloop) {
-            std::set<int> front_erosion2;
-            for(const auto& is : front_erosion) {
-                for (const auto& ivconnect : connected_vertexes[is]) {
-                    if ((p_id_island[ivconnect]==0) && (p_erosion[ivconnect]==0)) {
-                        front_erosion2.insert(ivconnect);
-                        p_erosion[ivconnect] = true;
+        // boundaries of the islands. The slot of a vertex is its index in the list of the vertices
+        // exchanging material in the erosion: the erosion domain first, then its neighbors.
+        std::vector<int> erosion_slot(vertices.size(), -1);
+        std::vector<int> erosion_vertices(domain_boundaries.begin(), domain_boundaries.end());
+        for (int k = 0; k < (int)erosion_vertices.size(); ++k)
+            erosion_slot[erosion_vertices[k]] = k;
+        size_t front_begin = 0;
+        for (int iloop = 0; iloop < bulldozing_erosion_n_propagations; ++iloop) {
+            size_t front_end = erosion_vertices.size();
+            for (size_t k = front_begin; k < front_end; ++k) {
+                for (const auto& ivconnect : connected_vertexes[erosion_vertices[k]]) {
+                    if ((p_id_island[ivconnect] == 0) && (erosion_slot[ivconnect] == -1)) {
+                        erosion_slot[ivconnect] = (int)erosion_vertices.size();
+                        erosion_vertices.push_back(ivconnect);
                     }
                 }
             }
-            domain_erosion.insert(front_erosion2.begin(), front_erosion2.end());
-            front_erosion = front_erosion2;
+            front_begin = front_end;
         }
-        // Erosion smoothing algorithm on domain
-        for (int ismo = 0; ismo <3; ++ismo) {
-            for (const auto& is : domain_erosion) {
-                for (const auto& ivc : connected_vertexes[is]) {
-                    ChVector<> vis = this->plane.TransformParentToLocal(vertices[is]);
-                    // flow remainder material 
-                    if (true) {
-                        if (p_massremainder[is]>p_massremainder[ivc]) {
-                            double clamped_d_y_i;
-                            double clamped_d_y_c;
- 
-                            // if i higher than c: clamp c upward correction as it might invalidate 
-                            // the ceiling constraint, if collision is nearby
-                            double d_y_c = (p_massremainder[is]-p_massremainder[ivc])* (1/(double)connected_vertexes[is].size()) *  p_area[is]/(p_area[is]+p_area[ivc]);
-                            clamped_d_y_c = d_y_c; 
-                            if (d_y_c > p_hit_level[ivc]-p_level[ivc]) {
-                                p_massremainder[ivc] += d_y_c - (p_hit_level[ivc]-p_level[ivc]);
-                                clamped_d_y_c = p_hit_level[ivc]-p_level[ivc];
-                            }
-                            double d_y_i = - d_y_c * p_area[ivc]/p_area[is];
-                            clamped_d_y_i = d_y_i;
-                            if (p_massremainder[is] >  -d_y_i) {
-                                p_massremainder[is] -= -d_y_i;
-                                clamped_d_y_i = 0;
-                            } else
-                            if ((p_massremainder[is] < -d_y_i) && (p_massremainder[is] >0)) {
-                                p_massremainder[is] = 0;
-                                clamped_d_y_i = d_y_i + p_massremainder[is];
-                            }
-                            
-                            // correct vertexes
-                            p_level[ivc]            += clamped_d_y_c;
-                            p_level_initial[ivc]    += clamped_d_y_c;
-                            vertices[ivc]           += N * clamped_d_y_c;
-                            p_vertices_initial[ivc] += N * clamped_d_y_c;
-
-                            p_level[is]             += clamped_d_y_i;
-                            p_level_initial[is]     += clamped_d_y_i;
-                            vertices[is]            += N * clamped_d_y_i;
-                            p_vertices_initial[is]  += N * clamped_d_y_i;      
-                        }
-                    }
-                    // smooth
-                    if (p_sigma[ivc] == 0) {
-                        ChVector<> vic = this->plane.TransformParentToLocal(vertices[ivc]);
-                        ChVector<> vdist = vic-vis;
-                        vdist.y() = 0;
-                        double ddist = vdist.Length();
-                        double dy = p_level[is] + p_massremainder[is]  - p_level[ivc] - p_massremainder[ivc];
-                        double dy_lim = ddist * tan(bulldozing_erosion_angle*CH_C_DEG_TO_RAD);
-                        if (fabs(dy)>dy_lim) {
-                            double clamped_d_y_i;
-                            double clamped_d_y_c;
-                            if (dy > 0) { 
-                                // if i higher than c: clamp c upward correction as it might invalidate 
-                                // the ceiling constraint, if collision is nearby
-                                double d_y_c = (fabs(dy)-dy_lim)* (1/(double)connected_vertexes[is].size()) *  p_area[is]/(p_area[is]+p_area[ivc]);
-                                clamped_d_y_c = d_y_c; //clamped_d_y_c = ChMin(d_y_c, p_hit_level[ivc]-p_level[ivc] );
-                                if (d_y_c > p_hit_level[ivc]-p_level[ivc]) {
-                                    p_massremainder[ivc] += d_y_c - (p_hit_level[ivc]-p_level[ivc]);
-                                    clamped_d_y_c = p_hit_level[ivc]-p_level[ivc];
-                                }
-                                double d_y_i = - d_y_c * p_area[ivc]/p_area[is];
-                                clamped_d_y_i = d_y_i;
-                                if (p_massremainder[is] >  -d_y_i) {
-                                    p_massremainder[is] -= -d_y_i;
-                                    clamped_d_y_i = 0;
-                                } else
-                                if ((p_massremainder[is] < -d_y_i) && (p_massremainder[is] >0)) {
-                                    p_massremainder[is] = 0;
-                                    clamped_d_y_i = d_y_i + p_massremainder[is];
-                                }
-                            } else {
-                                // if c higher than i: clamp i upward correction as it might invalidate 
-                                // the ceiling constraint, if collision is nearby
-                                double d_y_i = (fabs(dy)-dy_lim)* (1/(double)connected_vertexes[is].size()) *  p_area[is]/(p_area[is]+p_area[ivc]);
-                                clamped_d_y_i = d_y_i; 
-                                if (d_y_i > p_hit_level[is]-p_level[is]) {
-                                    p_massremainder[is] += d_y_i - (p_hit_level[is]-p_level[is]);
-                                    clamped_d_y_i = p_hit_level[is]-p_level[is];
-                                }
-                                double d_y_c = - d_y_i * p_area[is]/p_area[ivc];
-                                clamped_d_y_c = d_y_c;
-                                if (p_massremainder[ivc] >  -d_y_c) {
-                                    p_massremainder[ivc] -= -d_y_c;
-                                    clamped_d_y_c = 0;
-                                } else
-                                if ((p_massremainder[ivc] < -d_y_c) && (p_massremainder[ivc] >0)) {
-                                    p_massremainder[ivc] = 0;
-                                    clamped_d_y_c = d_y_c + p_massremainder[ivc];
-                                }
-                            }
-
-                            // correct vertexes
-                            p_level[ivc]            += clamped_d_y_c;
-                            p_level_initial[ivc]    += clamped_d_y_c;
-                            vertices[ivc]           += N * clamped_d_y_c;
-                            p_vertices_initial[ivc] += N * clamped_d_y_c;
-
-                            p_level[is]             += clamped_d_y_i;
-                            p_level_initial[is]     += clamped_d_y_i;
-                            vertices[is]            += N * clamped_d_y_i;
-                            p_vertices_initial[is]  += N * clamped_d_y_i;      
-                        }
-                    }
+        int num_erosion_domain = (int)erosion_vertices.size();
+        for (int k = 0; k < num_erosion_domain; ++k) {
+            p_erosion[erosion_vertices[k]] = true;
+            for (const auto& ivc : connected_vertexes[erosion_vertices[k]]) {
+                if (erosion_slot[ivc] == -1) {
+                    erosion_slot[ivc] = (int)erosion_vertices.size();
+                    erosion_vertices.push_back(ivc);
                 }
             }
         }
 
+        // Erosion smoothing algorithm on domain (Jacobi iterations).
+        // The volume exchanged along each edge with an end in the erosion domain is evaluated from the state
+        // at the beginning of the iteration, identically for both ends, and the net volume of each vertex is
+        // applied afterwards. Hence the volume is conserved and the result does not depend on the number of
+        // threads.
+        auto scheduler = GetSystem()->GetTaskScheduler();
+        int num_erosion_vertices = (int)erosion_vertices.size();
+        double tan_erosion_angle = tan(bulldozing_erosion_angle * CH_C_DEG_TO_RAD);
+        std::vector<double> erosion_volume(num_erosion_vertices);
+        for (int ismo = 0; ismo < bulldozing_erosion_n_iterations; ++ismo) {
+            scheduler->ParallelFor(0, num_erosion_vertices, [&](int k) {
+                int iv = erosion_vertices[k];
+                double volume = 0;
+                for (const auto& ivc : connected_vertexes[iv]) {
+                    // only the edges with an end in the erosion domain
+                    if (k >= num_erosion_domain && (erosion_slot[ivc] == -1 || erosion_slot[ivc] >= num_erosion_domain))
+                        continue;
+                    volume += ComputeErosionFlow(ivc, iv, tan_erosion_angle) -
+                              ComputeErosionFlow(iv, ivc, tan_erosion_angle);
+                }
+                erosion_volume[k] = volume;
+            }, 64);
+
+            scheduler->ParallelFor(0, num_erosion_vertices, [&](int k) {
+                int iv = erosion_vertices[k];
+                double d_y = erosion_volume[k] / p_area[iv];
+                double clamped_d_y;
+                if (d_y > 0) {
+                    // deposit below the ceiling of the colliding objects, keep the rest as remainder
+                    clamped_d_y = std::min(d_y, std::max(p_hit_level[iv] - p_level[iv], 0.0));
+                    p_massremainder[iv] += d_y - clamped_d_y;
+                } else {
+                    // take from the remainder first
+                    double d_remainder = std::min(-d_y, std::max(p_massremainder[iv], 0.0));
+                    p_massremainder[iv] -= d_remainder;
+                    clamped_d_y = d_y + d_remainder;
+                }
+
+                // correct vertexes
+                p_level[iv]            += clamped_d_y;
+                p_level_initial[iv]    += clamped_d_y;
+                vertices[iv]           += N * clamped_d_y;
+                p_vertices_initial[iv] += N * clamped_d_y;
+            }, 256);
+        }
+
     } // end bulldozing flow 
 
     m_timer_bulldozing.stop();
@@ -1224,5 +1171,676 @@ void SCMDeformableSoil::ComputeInternalForces() {
     //  ChPhysicsItem::Update(0, true);
 }
 
+// -----------------------------------------------------------------------------
+// Helper functions shared by the mesh, grid and sparse grid representations
+// -----------------------------------------------------------------------------
+
+// Range of grid vertices to test. The patch extent is given in the absolute X-Y plane, so the
+// range can be narrowed only if the soil plane is horizontal.
+void SCMDeformableSoil::GetGridRange(const ChVector2<>& patch_min,
+                                     const ChVector2<>& patch_max,
+                                     int& ix_min,
+                                     int& ix_max,
+                                     int& iy_min,
+                                     int& iy_max) const {
+    ix_min = 0;
+    ix_max = m_grid_nx - 1;
+    iy_min = 0;
+    iy_max = m_grid_ny - 1;
+
+    ChVector<> N = plane.TransformDirectionLocalToParent(ChVector<>(0, 1, 0));
+    if (!m_moving_patch || std::abs(N.z()) < 1 - 1e-9)
+        return;
+
+    ChVector<> corners[4] = {plane.TransformParentToLocal(ChVector<>(patch_min.x(), patch_min.y(), 0)),
+                             plane.TransformParentToLocal(ChVector<>(patch_max.x(), patch_min.y(), 0)),
+                             plane.TransformParentToLocal(ChVector<>(patch_min.x(), patch_max.y(), 0)),
+                             plane.TransformParentToLocal(ChVector<>(patch_max.x(), patch_max.y(), 0))};
+    double x_min = corners[0].x();
+    double x_max = corners[0].x();
+    double z_min = corners[0].z();
+    double z_max = corners[0].z();
+    for (int k = 1; k < 4; k++) {
+        x_min = std::min(x_min, corners[k].x());
+        x_max = std::max(x_max, corners[k].x());
+        z_min = std::min(z_min, corners[k].z());
+        z_max = std::max(z_max, corners[k].z());
+    }
+    ix_min = std::max(ix_min, (int)std::floor((x_min - m_grid_origin.x()) / m_grid_dx));
+    ix_max = std::min(ix_max, (int)std::ceil((x_max - m_grid_origin.x()) / m_grid_dx));
+    iy_min = std::max(iy_min, (int)std::floor((z_min - m_grid_origin.y()) / m_grid_dy));
+    iy_max = std::min(iy_max, (int)std::ceil((z_max - m_grid_origin.y()) / m_grid_dy));
+}
+
+// Current position of a grid vertex, in the absolute frame.
+ChVector<> SCMDeformableSoil::GetGridVertex(int ix, int iy) const {
+    if (!m_sparse)
+        return m_trimesh_shape->GetMesh()->getCoordsVertices()[ix + m_grid_nx * iy];
+
+    double sinkage = GetNodeState(ix, iy).sinkage;
+    return plane * ChVector<>(m_grid_origin.x() + ix * m_grid_dx, GetInitialHeight(ix, iy) - sinkage,
+                              m_grid_origin.y() + iy * m_grid_dy);
+}
+
+// Cast rays from the grid vertices in the given range (k indexes the vertices in range, row after row)
+// and flood-fill the contact patches. Return the number of patches.
+int SCMDeformableSoil::CastGridRays(int ix_min,
+                                    int ix_max,
+                                    int iy_min,
+                                    int iy_max,
+                                    const ChVector2<>& patch_min,
+                                    const ChVector2<>& patch_max,
+                                    std::vector<HitRecord>& grid_hits) {
+    ChVector<> N = plane.TransformDirectionLocalToParent(ChVector<>(0, 1, 0));
+    int nx = std::max(ix_max - ix_min + 1, 0);
+    int ny = std::max(iy_max - iy_min + 1, 0);
+
+    grid_hits.resize(nx * ny);
+    auto collision_system = GetSystem()->GetCollisionSystem();
+    std::atomic<int> num_ray_casts(0);
+
+    auto cast_rays = [&](int k_begin, int k_end) {
+        int num_range_casts = 0;
+        for (int k = k_begin; k < k_end; ++k) {
+            ChVector<> vertex = GetGridVertex(ix_min + k % nx, iy_min + k / nx);
+            grid_hits[k].contactable = nullptr;
+            grid_hits[k].patch_id = -1;
+
+            // Skip vertices outside moving patch
+            if (m_moving_patch) {
+                if (vertex.x() < patch_min.x() || vertex.x() > patch_max.x() || vertex.y() < patch_min.y() ||
+                    vertex.y() > patch_max.y()) {
+                    continue;
+                }
+            }
+
+            collision::ChCollisionSystem::ChRayhitResult mrayhit_result;
+            ChVector<> to = vertex + N * test_high_offset;
+            ChVector<> from = to - N * test_low_offset;
+            collision_system->RayHit(from, to, mrayhit_result);
+            num_range_casts++;
+            if (mrayhit_result.hit) {
+                grid_hits[k].contactable = mrayhit_result.hitModel->GetContactable();
+                grid_hits[k].abs_point = mrayhit_result.abs_hitPoint;
+            }
+        }
+        num_ray_casts += num_range_casts;
+    };
+    GetSystem()->GetTaskScheduler()->ParallelForRange(0, nx * ny, cast_rays, 256);
+    m_num_ray_casts = num_ray_casts;
+
+    // Flood-fill the contact patches. Each vertex is connected to the vertices along the grid lines
+    // and along the diagonal of the grid cells shared by its triangles.
+    static const int nbr_dx[6] = {1, -1, 0, 0, 1, -1};
+    static const int nbr_dy[6] = {0, 0, 1, -1, 1, -1};
+    int num_patches = 0;
+    std::queue<int> todo;
+    for (int k = 0; k < nx * ny; ++k) {
+        if (!grid_hits[k].contactable || grid_hits[k].patch_id != -1)
+            continue;
+        grid_hits[k].patch_id = num_patches++;
+        todo.push(k);
+        while (!todo.empty()) {
+            int crt = todo.front();
+            todo.pop();
+            int kx = crt % nx;
+            int ky = crt / nx;
+            for (int n = 0; n < 6; n++) {
+                int nbr_x = kx + nbr_dx[n];
+                int nbr_y = ky + nbr_dy[n];
+                if (nbr_x < 0 || nbr_x >= nx || nbr_y < 0 || nbr_y >= ny)
+                    continue;
+                int nbr = nbr_x + nx * nbr_y;
+                if (!grid_hits[nbr].contactable || grid_hits[nbr].patch_id != -1)
+                    continue;
+                grid_hits[nbr].patch_id = grid_hits[k].patch_id;
+                todo.push(nbr);
+            }
+        }
+    }
+
+    return num_patches;
+}
+
+// Calculate area and perimeter of each patch and the approximation to the Bekker term Kc/b.
+void SCMDeformableSoil::ComputePatchKcb(std::vector<PatchRecord>& patches) const {
+    for (auto& p : patches) {
+        if (Bekker_Kc == 0) {
+            p.Kc_b = 0;
+            continue;
+        }
+
+        utils::ChConvexHull2D ch(p.points);
+        p.area = ch.GetArea();
+        p.perimeter = ch.GetPerimeter();
+        if (p.area < 1e-6) {
+            p.Kc_b = 0;
+        } else {
+            double b = 2 * p.area / p.perimeter;
+            p.Kc_b = Bekker_Kc / b;
+        }
+    }
+}
+
+// Apply the SCM model at a vertex hit by a ray at the given offset below its initial level,
+// with the given speed of the hit object. Return false if the vertex is not loaded.
+bool SCMDeformableSoil::ComputeNodeForce(NodeState& node,
+                                         double hit_offset,
+                                         const ChVector<>& speed,
+                                         double area,
+                                         double Kc_b,
+                                         ChVector<>& force) const {
+    ChVector<> N = plane.TransformDirectionLocalToParent(ChVector<>(0, 1, 0));
+
+    ChVector<> T = -speed;
+    T = plane.TransformDirectionParentToLocal(T);
+    double Vn = -T.y();
+    T.y() = 0;
+    T = plane.TransformDirectionLocalToParent(T);
+    T.Normalize();
+
+    // Elastic try:
+    node.sigma = elastic_K * (hit_offset - node.sinkage_plastic);
+
+    // Handle unilaterality:
+    if (node.sigma < 0) {
+        node.sigma = 0;
+        return false;
+    }
+
+    node.sinkage = hit_offset;
+
+    // Accumulate shear for Janosi-Hanamoto
+    node.kshear += Vdot(speed, -T) * GetSystem()->GetStep();
+
+    // Plastic correction:
+    if (node.sigma > node.sigma_yeld) {
+        // Bekker formula
+        node.sigma = (Kc_b + Bekker_Kphi) * pow(node.sinkage, Bekker_n);
+        node.sigma_yeld = node.sigma;
+        double old_sinkage_plastic = node.sinkage_plastic;
+        node.sinkage_plastic = node.sinkage - node.sigma / elastic_K;
+        node.step_plastic_flow = (node.sinkage_plastic - old_sinkage_plastic) / GetSystem()->GetStep();
+    }
+
+    node.sinkage_elastic = node.sinkage - node.sinkage_plastic;
+
+    // add compressive speed-proportional damping (not clamped by pressure yield)
+    node.sigma += -Vn * damping_R;
+
+    // Mohr-Coulomb
+    double tau_max = Mohr_cohesion + node.sigma * tan(Mohr_friction * CH_C_DEG_TO_RAD);
+
+    // Janosi-Hanamoto
+    node.tau = tau_max * (1.0 - exp(-(node.kshear / Janosi_shear)));
+
+    ChVector<> Fn = N * area * node.sigma;
+    ChVector<> Ft = T * area * node.tau;
+    force = Fn + Ft;
+
+    return true;
+}
+
+// Apply the force of the soil at a vertex to the hit object.
+void SCMDeformableSoil::AddNodeForce(ChContactable* contactable, const ChVector<>& point, const ChVector<>& force) {
+    if (ChBody* rigidbody = dynamic_cast<ChBody*>(contactable)) {
+        // [](){} Trick: no deletion for this shared ptr, since 'rigidbody' was not a new ChBody()
+        // object, but an already used pointer because mrayhit_result.hitModel->GetPhysicsItem()
+        // cannot return it as shared_ptr, as needed by the ChLoadBodyForce:
+        std::shared_ptr<ChBody> srigidbody(rigidbody, [](ChBody*) {});
+        std::shared_ptr<ChLoadBodyForce> mload(new ChLoadBodyForce(srigidbody, force, false, point, false));
+        this->Add(mload);
+
+        // Accumulate contact force for this rigid body.
+        // The resultant force is assumed to be applied at the body COM.
+        // All components of the generalized terrain force are expressed in the global frame.
+        auto itr = m_contact_forces.find(contactable);
+        if (itr == m_contact_forces.end()) {
+            // Create new entry and initialize generalized force.
+            TerrainForce frc;
+            frc.point = srigidbody->GetPos();
+            frc.force = force;
+            frc.moment = Vcross(Vsub(point, srigidbody->GetPos()), force);
+            m_contact_forces.insert(std::make_pair(contactable, frc));
+        } else {
+            // Update generalized force.
+            itr->second.force += force;
+            itr->second.moment += Vcross(Vsub(point, srigidbody->GetPos()), force);
+        }
+    } else if (ChLoadableUV* surf = dynamic_cast<ChLoadableUV*>(contactable)) {
+        // [](){} Trick: no deletion for this shared ptr
+        std::shared_ptr<ChLoadableUV> ssurf(surf, [](ChLoadableUV*) {});
+        std::shared_ptr<ChLoad<ChLoaderForceOnSurface>> mload(new ChLoad<ChLoaderForceOnSurface>(ssurf));
+        mload->loader.SetForce(force);
+        mload->loader.SetApplication(0.5, 0.5);  //***TODO*** set UV, now just in middle
+        this->Add(mload);
+
+        // Accumulate contact forces for this surface.
+        //// TODO
+    }
+}
+
+// Volume of soil flowing from vertex a to vertex b in an erosion iteration: the material that could not be
+// deposited because of the ceiling of the colliding objects is spread out, and slopes steeper than the
+// erosion angle are flattened (outside contact areas).
+double SCMDeformableSoil::ComputeErosionFlow(int a, int b, double tan_erosion_angle) const {
+    const std::vector<ChVector<>>& vertices = m_trimesh_shape->GetMesh()->getCoordsVertices();
+    size_t num_connected = std::max(connected_vertexes[a].size(), connected_vertexes[b].size());
+    double weight = p_area[a] * p_area[b] / (p_area[a] + p_area[b]) / num_connected;
+
+    double flow = 0;
+    if (p_massremainder[a] > p_massremainder[b]) {
+        flow += (p_massremainder[a] - p_massremainder[b]) * weight;
+    }
+    if (p_sigma[a] == 0 && p_sigma[b] == 0) {
+        ChVector<> vdist = plane.TransformDirectionParentToLocal(vertices[b] - vertices[a]);
+        vdist.y() = 0;
+        double dy = p_level[a] + p_massremainder[a] - p_level[b] - p_massremainder[b];
+        double dy_lim = vdist.Length() * tan_erosion_angle;
+        if (dy > dy_lim) {
+            flow += (dy - dy_lim) * weight;
+        }
+    }
+    return flow;
+}
+
+// -----------------------------------------------------------------------------
+// Sparse storage of the soil state
+// -----------------------------------------------------------------------------
+
+// Set up the grid for sparse storage. No vertex is resident until it is loaded.
+void SCMDeformableSoil::SetupSparseGrid(int nv_x, int nv_y, double sizeX, double sizeY) {
+    m_grid = true;
+    m_grid_nx = nv_x;
+    m_grid_ny = nv_y;
+    m_grid_dx = sizeX / (nv_x - 1);
+    m_grid_dy = sizeY / (nv_y - 1);
+    m_grid_origin = ChVector2<>(-0.5 * sizeX, -0.5 * sizeY);
+
+    m_tiles.clear();
+    m_full_tiles.clear();
+    m_compressed_tiles.clear();
+    m_loaded_tiles.clear();
+    m_mesh_tiles.clear();
+    m_mesh_current = true;
+    m_step = 0;
+
+    // Release the mesh and the per-vertex data of the dense representation
+    m_trimesh_shape->GetMesh()->Clear();
+    SetupAuxData();
+}
+
+// Initial (undeformed) level of a grid vertex.
+double SCMDeformableSoil::GetInitialHeight(int ix, int iy) const {
+    if (m_grid_height0.empty())
+        return m_height;
+    return m_grid_height0[ix + m_grid_nx * iy];
+}
+
+// Projected area associated with a grid vertex: one third of the area of the adjacent triangles.
+double SCMDeformableSoil::GetGridArea(int ix, int iy) const {
+    bool cell_right = ix < m_grid_nx - 1;
+    bool cell_left = ix > 0;
+    bool cell_up = iy < m_grid_ny - 1;
+    bool cell_down = iy > 0;
+    int num_triangles = 2 * (cell_right && cell_up) + (cell_left && cell_up) + (cell_right && cell_down) +
+                        2 * (cell_left && cell_down);
+    return num_triangles * m_grid_dx * m_grid_dy / 6;
+}
+
+long long SCMDeformableSoil::GetTileKey(int ix, int iy) const {
+    long long num_tiles_x = (m_grid_nx + m_tile_size - 1) / m_tile_size;
+    return (iy / m_tile_size) * num_tiles_x + ix / m_tile_size;
+}
+
+// State of a grid vertex. Untouched vertices have a zero state.
+SCMDeformableSoil::NodeState SCMDeformableSoil::GetNodeState(int ix, int iy) const {
+    NodeState node = {0, 0, 0, 0, 0, 0, 0, 0};
+    auto tile = m_tiles.find(GetTileKey(ix, iy));
+    if (tile == m_tiles.end())
+        return node;
+
+    int j = (ix % m_tile_size) + m_tile_size * (iy % m_tile_size);
+    if (!tile->second.nodes.empty())
+        return tile->second.nodes[j];
+
+    node.sinkage = tile->second.compressed[4 * j + 0];
+    node.sinkage_plastic = tile->second.compressed[4 * j + 1];
+    node.kshear = tile->second.compressed[4 * j + 2];
+    node.sigma_yeld = tile->second.compressed[4 * j + 3];
+    node.sinkage_elastic = node.sinkage - node.sinkage_plastic;
+    return node;
+}
+
+// State of a grid vertex, for modification. The tile of the vertex is created or expanded if needed.
+// The first modification of a tile in a step makes it the most recently loaded tile.
+SCMDeformableSoil::NodeState& SCMDeformableSoil::GetNode(int ix, int iy) {
+    long long key = GetTileKey(ix, iy);
+    auto found = m_tiles.find(key);
+    if (found == m_tiles.end()) {
+        found = m_tiles.insert(std::make_pair(key, Tile())).first;
+        Tile& tile = found->second;
+        tile.last_step = -1;
+        tile.mesh_slot = -1;
+        m_full_tiles.push_front(key);
+        tile.lru = m_full_tiles.begin();
+    }
+    Tile& tile = found->second;
+
+    int n = m_tile_size * m_tile_size;
+    if (tile.nodes.empty()) {
+        NodeState zero = {0, 0, 0, 0, 0, 0, 0, 0};
+        tile.nodes.resize(n, zero);
+        if (!tile.compressed.empty()) {
+            for (int j = 0; j < n; j++) {
+                tile.nodes[j].sinkage = tile.compressed[4 * j + 0];
+                tile.nodes[j].sinkage_plastic = tile.compressed[4 * j + 1];
+                tile.nodes[j].kshear = tile.compressed[4 * j + 2];
+                tile.nodes[j].sigma_yeld = tile.compressed[4 * j + 3];
+                tile.nodes[j].sinkage_elastic = tile.nodes[j].sinkage - tile.nodes[j].sinkage_plastic;
+            }
+            std::vector<float>().swap(tile.compressed);
+            m_full_tiles.splice(m_full_tiles.begin(), m_compressed_tiles, tile.lru);
+        }
+    }
+    if (tile.last_step != m_step) {
+        tile.last_step = m_step;
+        m_full_tiles.splice(m_full_tiles.begin(), m_full_tiles, tile.lru);
+        m_loaded_tiles.push_back(key);
+    }
+    return tile.nodes[(ix % m_tile_size) + m_tile_size * (iy % m_tile_size)];
+}
+
+// Keep the stored tiles within the memory budget: the least recently loaded tiles are compressed
+// to the state needed to continue the simulation (sinkage, plastic sinkage, shear accumulator, yield
+// pressure) and, beyond the maximum number of tiles, discarded.
+// A tile is compressed only when it is the least recently loaded full tile, so all compressed tiles are
+// older than the full tiles and the two recency lists together order all the tiles.
+void SCMDeformableSoil::UpdateTiles() {
+    int n = m_tile_size * m_tile_size;
+    while (m_full_tiles.size() > m_max_full_tiles) {
+        long long key = m_full_tiles.back();
+        Tile& tile = m_tiles[key];
+        tile.compressed.resize(4 * n);
+        for (int j = 0; j < n; j++) {
+            tile.compressed[4 * j + 0] = (float)tile.nodes[j].sinkage;
+            tile.compressed[4 * j + 1] = (float)tile.nodes[j].sinkage_plastic;
+            tile.compressed[4 * j + 2] = (float)tile.nodes[j].kshear;
+            tile.compressed[4 * j + 3] = (float)tile.nodes[j].sigma_yeld;
+        }
+        std::vector<NodeState>().swap(tile.nodes);
+        if (tile.mesh_slot != -1)
+            RemoveTileMesh(tile);
+        m_compressed_tiles.splice(m_compressed_tiles.begin(), m_full_tiles, tile.lru);
+    }
+
+    while (m_max_tiles > 0 && m_tiles.size() > m_max_tiles) {
+        std::list<long long>& oldest = m_compressed_tiles.empty() ? m_full_tiles : m_compressed_tiles;
+        auto tile = m_tiles.find(oldest.back());
+        if (tile->second.mesh_slot != -1)
+            RemoveTileMesh(tile->second);
+        oldest.pop_back();
+        m_tiles.erase(tile);
+    }
+}
+
+// Compute the soil forces with sparse storage of the soil state.
+// Only the vertices under the moving patch are tested and only the loaded vertices are stored.
+void SCMDeformableSoil::ComputeInternalForcesSparse() {
+    ChVector<> N = plane.TransformDirectionLocalToParent(ChVector<>(0, 1, 0));
+    if (!m_moving_patch || std::abs(N.z()) < 1 - 1e-9) {
+        throw ChException("SCM sparse storage requires a horizontal soil plane and a moving patch");
+    }
+    if (do_bulldozing || do_refinement) {
+        throw ChException("SCM sparse storage does not support bulldozing and automatic refinement");
+    }
+    m_step++;
+
+    m_timer_ray_casting.start();
+
+    // Reset the per-step SCM quantities of the vertices loaded in the previous step (they are zero elsewhere)
+    std::vector<long long> prev_loaded_tiles;
+    prev_loaded_tiles.swap(m_loaded_tiles);
+    for (long long key : prev_loaded_tiles) {
+        auto t = m_tiles.find(key);
+        if (t == m_tiles.end())
+            continue;
+        for (auto& node : t->second.nodes) {
+            node.sigma = 0;
+            node.sinkage_elastic = 0;
+            node.step_plastic_flow = 0;
+        }
+    }
+
+    ChVector<> center = m_body->GetFrame_REF_to_abs().TransformPointLocalToParent(m_body_point);
+    ChVector2<> patch_min(center.x() - m_patch_dim.x() / 2, center.y() - m_patch_dim.y() / 2);
+    ChVector2<> patch_max(center.x() + m_patch_dim.x() / 2, center.y() + m_patch_dim.y() / 2);
+
+    int ix_min, ix_max, iy_min, iy_max;
+    GetGridRange(patch_min, patch_max, ix_min, ix_max, iy_min, iy_max);
+    std::vector<HitRecord> grid_hits;
+    int num_patches = CastGridRays(ix_min, ix_max, iy_min, iy_max, patch_min, patch_max, grid_hits);
+    int nx = ix_max - ix_min + 1;
+
+    std::vector<PatchRecord> patches(num_patches);
+    for (int k = 0; k < (int)grid_hits.size(); ++k) {
+        if (grid_hits[k].contactable) {
+            int ix = ix_min + k % nx;
+            int iy = iy_min + k / nx;
+            patches[grid_hits[k].patch_id].points.push_back(
+                ChVector2<>(m_grid_origin.x() + ix * m_grid_dx, m_grid_origin.y() + iy * m_grid_dy));
+        }
+    }
+    ComputePatchKcb(patches);
+
+    // Process only hit vertices. Vertices are stored only if loaded.
+    for (int k = 0; k < (int)grid_hits.size(); ++k) {
+        ChContactable* contactable = grid_hits[k].contactable;
+        if (!contactable)
+            continue;
+        int ix = ix_min + k % nx;
+        int iy = iy_min + k / nx;
+
+        ChVector<> vertex = GetGridVertex(ix, iy);
+        double hit_level = plane.TransformParentToLocal(grid_hits[k].abs_point).y();
+        double hit_offset = -hit_level + GetInitialHeight(ix, iy);
+        ChVector<> speed = contactable->GetContactPointSpeed(vertex);
+
+        NodeState node = GetNodeState(ix, iy);
+        ChVector<> force;
+        if (ComputeNodeForce(node, hit_offset, speed, GetGridArea(ix, iy), patches[grid_hits[k].patch_id].Kc_b,
+                             force)) {
+            GetNode(ix, iy) = node;
+            AddNodeForce(contactable, vertex, force);
+        }
+    }
+
+    UpdateTiles();
+
+    m_timer_ray_casting.stop();
+
+    //
+    // Update the visualization mesh, which covers the full tiles. Only the tiles loaded in this step or in
+    // the previous one have changed, together with the tiles sharing vertices with them.
+    // The mesh is released while the visualization asset is hidden.
+    //
+
+    m_timer_visualization.start();
+
+    if (!m_trimesh_shape->IsVisible()) {
+        if (m_mesh_current) {
+            for (long long key : m_mesh_tiles)
+                m_tiles[key].mesh_slot = -1;
+            m_mesh_tiles.clear();
+            m_trimesh_shape->GetMesh()->Clear();
+            m_mesh_current = false;
+        }
+    } else if (!m_mesh_current) {
+        for (long long key : m_full_tiles)
+            AddTileMesh(key, m_tiles[key]);
+        m_mesh_current = true;
+    } else {
+        long long num_tiles_x = (m_grid_nx + m_tile_size - 1) / m_tile_size;
+        std::unordered_set<long long> changed;
+        for (auto keys : {&prev_loaded_tiles, &m_loaded_tiles}) {
+            for (long long key : *keys) {
+                // The tiles to the left and below also cover the first column and row of vertices of this tile
+                bool left = key % num_tiles_x > 0;
+                bool below = key >= num_tiles_x;
+                changed.insert(key);
+                if (left)
+                    changed.insert(key - 1);
+                if (below)
+                    changed.insert(key - num_tiles_x);
+                if (left && below)
+                    changed.insert(key - num_tiles_x - 1);
+            }
+        }
+        for (long long key : changed) {
+            auto t = m_tiles.find(key);
+            if (t == m_tiles.end() || t->second.nodes.empty())
+                continue;
+            if (t->second.mesh_slot == -1)
+                AddTileMesh(key, t->second);
+            else
+                UpdateTileMesh(key, t->second);
+        }
+    }
+
+    m_num_vertices = m_trimesh_shape->GetMesh()->getCoordsVertices().size();
+    m_num_faces = m_trimesh_shape->GetMesh()->getIndicesVertexes().size();
+
+    m_timer_visualization.stop();
+}
+
+// The visualization mesh is made of blocks of (tile_size + 1) x (tile_size + 1) vertices, one block per
+// meshed tile, which also covers the cells shared with the next tiles in X and Y. On the boundary of the
+// grid, the vertices beyond the last grid vertex are collapsed on it (and their triangles are degenerate),
+// so that all blocks have the same layout.
+void SCMDeformableSoil::AddTileMesh(long long key, Tile& tile) {
+    auto trimesh = m_trimesh_shape->GetMesh();
+    std::vector<ChVector<int>>& idx_vertices = trimesh->getIndicesVertexes();
+    int bn = m_tile_size + 1;
+    int v0 = bn * bn * (int)m_mesh_tiles.size();
+
+    tile.mesh_slot = (int)m_mesh_tiles.size();
+    m_mesh_tiles.push_back(key);
+
+    trimesh->getCoordsVertices().resize(v0 + bn * bn);
+    trimesh->getCoordsNormals().resize(v0 + bn * bn);
+    for (int iy = 0; iy < bn - 1; ++iy) {
+        for (int ix = 0; ix < bn - 1; ++ix) {
+            int v = v0 + ix + bn * iy;
+            idx_vertices.push_back(ChVector<int>(v, v + bn + 1, v + bn));
+            idx_vertices.push_back(ChVector<int>(v, v + 1, v + bn + 1));
+        }
+    }
+    std::vector<ChVector<int>>& idx_normals = trimesh->getIndicesNormals();
+    idx_normals.insert(idx_normals.end(), idx_vertices.end() - 2 * m_tile_size * m_tile_size, idx_vertices.end());
+
+    UpdateTileMesh(key, tile);
+}
+
+// Remove the mesh block of a tile. The last block of the mesh is moved to its slot.
+void SCMDeformableSoil::RemoveTileMesh(Tile& tile) {
+    auto trimesh = m_trimesh_shape->GetMesh();
+    std::vector<ChVector<>>& vertices = trimesh->getCoordsVertices();
+    std::vector<ChVector<>>& normals = trimesh->getCoordsNormals();
+    std::vector<ChVector<float>>& colors = trimesh->getCoordsColors();
+    int bn = m_tile_size + 1;
+    int slot = tile.mesh_slot;
+    int last = (int)m_mesh_tiles.size() - 1;
+
+    if (slot != last) {
+        std::copy(vertices.begin() + bn * bn * last, vertices.end(), vertices.begin() + bn * bn * slot);
+        std::copy(normals.begin() + bn * bn * last, normals.end(), normals.begin() + bn * bn * slot);
+        if (!colors.empty())
+            std::copy(colors.begin() + bn * bn * last, colors.end(), colors.begin() + bn * bn * slot);
+        m_mesh_tiles[slot] = m_mesh_tiles[last];
+        m_tiles[m_mesh_tiles[slot]].mesh_slot = slot;
+    }
+    m_mesh_tiles.pop_back();
+    tile.mesh_slot = -1;
+
+    vertices.resize(bn * bn * last);
+    normals.resize(bn * bn * last);
+    if (!colors.empty())
+        colors.resize(bn * bn * last);
+    trimesh->getIndicesVertexes().resize(2 * m_tile_size * m_tile_size * last);
+    trimesh->getIndicesNormals().resize(2 * m_tile_size * m_tile_size * last);
+}
+
+// Set the mesh block of a tile from the current soil state.
+void SCMDeformableSoil::UpdateTileMesh(long long key, const Tile& tile) {
+    auto trimesh = m_trimesh_shape->GetMesh();
+    std::vector<ChVector<>>& vertices = trimesh->getCoordsVertices();
+    std::vector<ChVector<>>& normals = trimesh->getCoordsNormals();
+    std::vector<ChVector<float>>& colors = trimesh->getCoordsColors();
+    ChVector<> N = plane.TransformDirectionLocalToParent(ChVector<>(0, 1, 0));
+
+    long long num_tiles_x = (m_grid_nx + m_tile_size - 1) / m_tile_size;
+    int tx0 = (int)(key % num_tiles_x) * m_tile_size;
+    int ty0 = (int)(key / num_tiles_x) * m_tile_size;
+    int bn = m_tile_size + 1;
+    int v = bn * bn * tile.mesh_slot;
+
+    if (plot_type != SCMDeformableTerrain::PLOT_NONE)
+        colors.resize(vertices.size());
+
+    for (int jy = 0; jy < bn; ++jy) {
+        for (int jx = 0; jx < bn; ++jx, ++v) {
+            int ix = std::min(tx0 + jx, m_grid_nx - 1);
+            int iy = std::min(ty0 + jy, m_grid_ny - 1);
+            NodeState node = GetNodeState(ix, iy);
+            double level_initial = GetInitialHeight(ix, iy);
+            vertices[v] = plane * ChVector<>(m_grid_origin.x() + ix * m_grid_dx, level_initial - node.sinkage,
+                                             m_grid_origin.y() + iy * m_grid_dy);
+            normals[v] = N;
+            if (plot_type == SCMDeformableTerrain::PLOT_NONE)
+                continue;
+            double value = 0;
+            switch (plot_type) {
+                case SCMDeformableTerrain::PLOT_LEVEL:
+                    value = level_initial - node.sinkage;
+                    break;
+                case SCMDeformableTerrain::PLOT_LEVEL_INITIAL:
+                    value = level_initial;
+                    break;
+                case SCMDeformableTerrain::PLOT_SINKAGE:
+                    value = node.sinkage;
+                    break;
+                case SCMDeformableTerrain::PLOT_SINKAGE_ELASTIC:
+                    value = node.sinkage_elastic;
+                    break;
+                case SCMDeformableTerrain::PLOT_SINKAGE_PLASTIC:
+                    value = node.sinkage_plastic;
+                    break;
+                case SCMDeformableTerrain::PLOT_STEP_PLASTIC_FLOW:
+                    value = node.step_plastic_flow;
+                    break;
+                case SCMDeformableTerrain::PLOT_K_JANOSI:
+                    value = node.kshear;
+                    break;
+                case SCMDeformableTerrain::PLOT_PRESSURE:
+                    value = node.sigma;
+                    break;
+                case SCMDeformableTerrain::PLOT_PRESSURE_YELD:
+                    value = node.sigma_yeld;
+                    break;
+                case SCMDeformableTerrain::PLOT_SHEAR:
+                    value = node.tau;
+                    break;
+                case SCMDeformableTerrain::PLOT_IS_TOUCHED:
+                    value = node.sigma > 0 ? plot_v_max : plot_v_min;
+                    break;
+                default:
+                    break;
+            }
+            ChColor mcolor = ChColor::ComputeFalseColor(value, plot_v_min, plot_v_max);
+            colors[v] = ChVector<float>(mcolor.R, mcolor.G, mcolor.B);
+        }
+    }
+}
+
 }  // end namespace vehicle
 }  // end namespace chrono
@@ -20,6 +20,7 @@
 #ifndef SCM_DEFORMABLE_TERRAIN_H
 #define SCM_DEFORMABLE_TERRAIN_H
 
+#include <list>
 #include <set>
 #include <string>
 #include <unordered_map>
@@ -111,7 +112,7 @@ class CH_VEHICLE_API SCMDeformableTerrain : public ChTerrain {
     const ChCoordsys<>& GetPlane() const;
 
     /// Get the mesh.
-    /// The soil mesh is defined by a trimesh.
+    /// The soil mesh is defined by a trimesh. With sparse storage, hide the mesh (SetVisible) to skip its update.
     const std::shared_ptr<ChTriangleMeshShape> GetMesh() const;
 
     /// Set the properties of the SCM soil model.
@@ -181,8 +182,28 @@ class CH_VEHICLE_API SCMDeformableTerrain : public ChTerrain {
                            double dimY                       ///< [in] patch Y dimension
     );
 
+    /// Enable sparse storage of the soil state (default: disabled). Must be called before Initialize.
+    /// With the flat and height map initializations, the soil state is then stored only for the vertices
+    /// that were loaded, in square tiles of tile_size x tile_size vertices. Untouched vertices are at
+    /// their initial height and no mesh is kept for them. When more than max_full_tiles tiles are stored,
+    /// the least recently loaded tiles are compressed to the sinkage, plastic sinkage, shear accumulator
+    /// and yield pressure of their vertices (in single precision). If max_tiles is not 0, the least
+    /// recently loaded tiles in excess of max_tiles are discarded and their soil reverts to its initial state.
+    /// The visualization mesh covers the uncompressed tiles only; it is updated incrementally and released
+    /// while the mesh asset is hidden (see GetMesh).
+    /// Requires a horizontal soil plane (Z up) and a moving patch. Bulldozing (SetBulldozingFlow) and automatic
+    /// refinement (SetAutomaticRefinement) are not supported with sparse storage. If any of these conditions
+    /// is not met, a ChException is thrown at the first step.
+    void EnableSparseStorage(int tile_size = 32,            ///< [in] number of vertices per tile side
+                             size_t max_full_tiles = 1024,  ///< [in] maximum number of uncompressed tiles
+                             size_t max_tiles = 0           ///< [in] maximum number of tiles (0: unlimited)
+                             );
+
     /// Initialize the terrain system (flat).
     /// This version creates a flat array of points.
+    /// The soil is stored as a regular grid: ray casting is performed in parallel (using the number of
+    /// threads of the containing system) and only over the grid vertices under the moving patch, if enabled.
+    /// Automatic refinement turns the grid into a generic mesh.
     void Initialize(double height,  ///< [in] terrain height
                     double sizeX,   ///< [in] terrain dimension in the X direction
                     double sizeY,   ///< [in] terrain dimension in the Y direction
@@ -196,7 +217,8 @@ class CH_VEHICLE_API SCMDeformableTerrain : public ChTerrain {
                     );
 
     /// Initialize the terrain system (height map).
-    /// The initial undeformed mesh is provided via the specified BMP file as a height map
+    /// The initial undeformed mesh is provided via the specified BMP file as a height map.
+    /// As for the flat terrain, the soil is stored as a regular grid.
     void Initialize(const std::string& heightmap_file,  ///< [in] filename for the height map (BMP)
                     const std::string& mesh_name,       ///< [in] name of the mesh asset
                     double sizeX,                       ///< [in] terrain dimension in the X direction
@@ -246,6 +268,42 @@ class CH_VEHICLE_API SCMDeformableSoil : public ChLoadContainer {
                     );
 
   private:
+    // Record of a vertex hit by a ray
+    struct HitRecord {
+        ChContactable* contactable;  // pointer to hit object
+        ChVector<> abs_point;        // hit point, expressed in global frame
+        int patch_id;                // index of associated patch id
+    };
+
+    // Contact patch
+    struct PatchRecord {
+        std::vector<ChVector2<>> points;  // points in patch (projected on reference plane)
+        double area;                      // patch area
+        double perimeter;                 // patch perimeter
+        double Kc_b;                      // approximate Bekker Kc/b value
+    };
+
+    // SCM state of a vertex
+    struct NodeState {
+        double sinkage;
+        double sinkage_plastic;
+        double sinkage_elastic;
+        double step_plastic_flow;
+        double kshear;  // Janosi-Hanamoto shear accumulator
+        double sigma;
+        double sigma_yeld;
+        double tau;
+    };
+
+    // Tile of the sparse storage
+    struct Tile {
+        std::vector<NodeState> nodes;        // vertex states (empty if compressed)
+        std::vector<float> compressed;       // sinkage, plastic sinkage, shear accumulator and yield pressure
+        int last_step;                       // last step in which a vertex of the tile was loaded
+        int mesh_slot;                       // index of the tile block in the visualization mesh (-1 if none)
+        std::list<long long>::iterator lru;  // position in the list of full or compressed tiles
+    };
+
     // Updates the forces and the geometry, at the beginning of each timestep
     virtual void Setup() override {
         // GetLog() << " Setup update soil t= "<< this->ChTime << "\n";
@@ -283,6 +341,44 @@ class CH_VEHICLE_API SCMDeformableSoil : public ChLoadContainer {
     // data structures for the mesh, aux. material data, etc.
     void SetupAuxData();
 
+    // Helper functions shared by the mesh, grid and sparse grid representations
+    void GetGridRange(const ChVector2<>& patch_min,
+                      const ChVector2<>& patch_max,
+                      int& ix_min,
+                      int& ix_max,
+                      int& iy_min,
+                      int& iy_max) const;
+    ChVector<> GetGridVertex(int ix, int iy) const;
+    int CastGridRays(int ix_min,
+                     int ix_max,
+                     int iy_min,
+                     int iy_max,
+                     const ChVector2<>& patch_min,
+                     const ChVector2<>& patch_max,
+                     std::vector<HitRecord>& grid_hits);
+    void ComputePatchKcb(std::vector<PatchRecord>& patches) const;
+    bool ComputeNodeForce(NodeState& node,
+                          double hit_offset,
+                          const ChVector<>& speed,
+                          double area,
+                          double Kc_b,
+                          ChVector<>& force) const;
+    void AddNodeForce(ChContactable* contactable, const ChVector<>& point, const ChVector<>& force);
+    double ComputeErosionFlow(int a, int b, double tan_erosion_angle) const;
+
+    // Sparse storage of the soil state
+    void SetupSparseGrid(int nv_x, int nv_y, double sizeX, double sizeY);
+    double GetInitialHeight(int ix, int iy) const;
+    double GetGridArea(int ix, int iy) const;
+    long long GetTileKey(int ix, int iy) const;
+    NodeState GetNodeState(int ix, int iy) const;
+    NodeState& GetNode(int ix, int iy);
+    void UpdateTiles();
+    void ComputeInternalForcesSparse();
+    void AddTileMesh(long long key, Tile& tile);
+    void RemoveTileMesh(Tile& tile);
+    void UpdateTileMesh(long long key, const Tile& tile);
+
     std::shared_ptr<ChColorAsset> m_color;
     std::shared_ptr<ChTriangleMeshShape> m_trimesh_shape;
     double m_height;
@@ -324,6 +420,29 @@ class CH_VEHICLE_API SCMDeformableSoil : public ChLoadContainer {
     std::vector<std::set<int>> connected_vertexes;
     std::vector<std::array<int, 4>> tri_map;
 
+    // Structured grid data (flat and height map initializations).
+    // Vertex (ix, iy) has index ix + m_grid_nx * iy and plane coordinates m_grid_origin + (ix * dx, iy * dy).
+    bool m_grid;                ///< vertices form a regular grid?
+    int m_grid_nx;              ///< number of grid vertices in the X direction
+    int m_grid_ny;              ///< number of grid vertices in the Y direction
+    double m_grid_dx;           ///< grid spacing in the X direction
+    double m_grid_dy;           ///< grid spacing in the Y direction
+    ChVector2<> m_grid_origin;  ///< plane coordinates (X, Z) of the first grid vertex
+
+    // Sparse storage of the soil state (grid only)
+    bool m_sparse;                                ///< sparse storage enabled?
+    int m_tile_size;                              ///< number of vertices per tile side
+    size_t m_max_full_tiles;                      ///< maximum number of uncompressed tiles
+    size_t m_max_tiles;                           ///< maximum number of tiles (0: unlimited)
+    std::unordered_map<long long, Tile> m_tiles;  ///< stored tiles, keyed by tile index
+    std::list<long long> m_full_tiles;            ///< uncompressed tiles, most recently loaded first
+    std::list<long long> m_compressed_tiles;      ///< compressed tiles, most recently loaded first
+    std::vector<long long> m_loaded_tiles;        ///< tiles loaded in the current step
+    std::vector<long long> m_mesh_tiles;          ///< tile of each block of the visualization mesh
+    bool m_mesh_current;                          ///< visualization mesh up to date with the tiles?
+    std::vector<float> m_grid_height0;            ///< initial heights (height map), empty if flat at m_height
+    int m_step;                                   ///< number of force computations, for tile recency
+
     bool do_bulldozing;
     double bulldozing_flow_factor;
     double bulldozing_erosion_angle;
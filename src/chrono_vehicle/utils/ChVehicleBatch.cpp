@@ -0,0 +1,160 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+//
+// Runner for batches of independent vehicle simulations.
+//
+// =============================================================================
+
+#include <algorithm>
+#include <cmath>
+#include <exception>
+
+#include "chrono_vehicle/utils/ChVehicleBatch.h"
+
+namespace chrono {
+namespace vehicle {
+
+ChVehicleBatch::ChVehicleBatch(int num_threads)
+    : m_num_threads(num_threads > 0 ? num_threads : CHOMPfunctions::GetMaxThreads()),
+      m_time(0),
+      m_output(false),
+      m_output_step(0),
+      m_next_output_time(0) {}
+
+ChVehicleBatch::~ChVehicleBatch() {}
+
+void ChVehicleBatch::AddInstance(std::shared_ptr<Instance> instance) {
+    m_instances.push_back(instance);
+}
+
+int ChVehicleBatch::GetNumActive() const {
+    int num_active = 0;
+    for (const auto& instance : m_instances) {
+        if (!instance->m_done)
+            num_active++;
+    }
+    return num_active;
+}
+
+void ChVehicleBatch::SetOutput(const std::string& filename, double output_step) {
+    m_output_stream.open(filename);
+    m_output = m_output_stream.is_open();
+    m_output_step = output_step;
+    m_next_output_time = m_time;
+}
+
+// -----------------------------------------------------------------------------
+// Initialize and step the instances.
+// With a static schedule of chunk size 1, instance i is always processed by
+// thread (i mod number of threads). The OpenMP regions nested in the instances
+// get a single thread, whether or not nested parallelism is enabled.
+// -----------------------------------------------------------------------------
+void ChVehicleBatch::Initialize() {
+    int num_instances = (int)m_instances.size();
+
+#pragma omp parallel num_threads(m_num_threads)
+    {
+        // Parallel regions nested in the instances run on the calling thread only
+        CHOMPfunctions::SetNumThreads(1);
+
+#pragma omp for schedule(static, 1)
+        for (int i = 0; i < num_instances; i++) {
+            Instance& instance = *m_instances[i];
+            try {
+                instance.Initialize(*this);
+            } catch (std::exception& e) {
+                instance.m_done = true;
+                instance.m_error = e.what();
+            }
+        }
+    }
+}
+
+void ChVehicleBatch::Advance(int num_steps, double step) {
+    int num_instances = (int)m_instances.size();
+
+#pragma omp parallel num_threads(m_num_threads)
+    {
+        CHOMPfunctions::SetNumThreads(1);
+
+#pragma omp for schedule(static, 1)
+        for (int i = 0; i < num_instances; i++) {
+            Instance& instance = *m_instances[i];
+            double time = m_time;
+            for (int is = 0; is < num_steps && !instance.m_done; is++) {
+                try {
+                    instance.Step(time, step);
+                    instance.m_done = instance.IsComplete();
+                } catch (std::exception& e) {
+                    instance.m_done = true;
+                    instance.m_error = e.what();
+                }
+                time += step;
+            }
+        }
+    }
+
+    m_time += num_steps * step;
+}
+
+void ChVehicleBatch::Run(double end_time, double step) {
+    while (m_time < end_time - 0.5 * step && GetNumActive() > 0) {
+        if (m_output && m_time >= m_next_output_time - 0.5 * step) {
+            Output();
+            m_next_output_time += m_output_step;
+        }
+
+        // Step all instances independently until the next output time (or the end time)
+        double next_time = m_output ? std::min(m_next_output_time, end_time) : end_time;
+        int num_steps = std::max((int)std::round((next_time - m_time) / step), 1);
+        Advance(num_steps, step);
+    }
+
+    if (m_output && m_time >= m_next_output_time - 0.5 * step) {
+        Output();
+        m_next_output_time += m_output_step;
+    }
+}
+
+// -----------------------------------------------------------------------------
+// Write the output of all running instances, in order.
+// -----------------------------------------------------------------------------
+void ChVehicleBatch::Output() {
+    for (int i = 0; i < (int)m_instances.size(); i++) {
+        if (m_instances[i]->m_done)
+            continue;
+        m_output_stream << i << " " << m_time << " ";
+        m_instances[i]->Output(m_time, m_output_stream);
+        m_output_stream << "\n";
+    }
+    m_output_stream.flush();
+}
+
+// -----------------------------------------------------------------------------
+// Shared triangle meshes, loaded on first request.
+// -----------------------------------------------------------------------------
+std::shared_ptr<geometry::ChTriangleMeshConnected> ChVehicleBatch::GetMesh(const std::string& filename) {
+    CHOMPscopedLock lock(m_mesh_mutex);
+
+    auto found = m_meshes.find(filename);
+    if (found != m_meshes.end())
+        return found->second;
+
+    auto mesh = std::make_shared<geometry::ChTriangleMeshConnected>();
+    mesh->LoadWavefrontMesh(filename, true, true);
+    m_meshes[filename] = mesh;
+
+    return mesh;
+}
+
+}  // end namespace vehicle
+}  // end namespace chrono
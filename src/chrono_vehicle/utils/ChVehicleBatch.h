@@ -0,0 +1,151 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+//
+// Runner for batches of independent vehicle simulations.
+//
+// =============================================================================
+
+#ifndef CH_VEHICLE_BATCH_H
+#define CH_VEHICLE_BATCH_H
+
+#include <fstream>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "chrono/geometry/ChTriangleMeshConnected.h"
+#include "chrono/parallel/ChOpenMP.h"
+
+#include "chrono_vehicle/ChApiVehicle.h"
+
+namespace chrono {
+namespace vehicle {
+
+/// @addtogroup vehicle_utils
+/// @{
+
+/// Runner for a batch of independent simulations, such as the vehicle, terrain, and driver stacks of a
+/// design of experiments, in a single process.
+///
+/// The instances are stepped in parallel by a team of OpenMP threads. Instance i is always initialized
+/// and stepped by thread (i mod number of threads), so that its data stays in the caches (and, with
+/// OMP_PROC_BIND set, in the memory) of the same core. Each instance should own its Chrono system; the
+/// systems should use a single thread (ChSystem::SetParallelThreadNumber). OpenMP parallel regions nested
+/// in the instances run on the calling thread only.
+/// Read-only data loaded once for all instances (e.g. terrain meshes) can be obtained from the batch with
+/// GetMesh. Only the mesh data is shared: the structures built from it by each instance (e.g. the collision
+/// shape and its bounding volume hierarchy, the query index of RigidTerrain) are not.
+///
+/// If an instance throws an exception, it is stopped and the error message is available through
+/// Instance::GetError; the other instances are not affected.
+class CH_VEHICLE_API ChVehicleBatch {
+  public:
+    /// Interface of a simulation in the batch.
+    /// A derived class holds the vehicle, terrain, driver, etc. of one simulation and implements the
+    /// exchange of data between them and their advance in time.
+    class CH_VEHICLE_API Instance {
+      public:
+        Instance() : m_done(false) {}
+        virtual ~Instance() {}
+
+        /// Construct the system and the subsystems of this instance.
+        /// Called on the thread which steps this instance.
+        virtual void Initialize(ChVehicleBatch& batch) {}
+
+        /// Synchronize all subsystems at the specified time and advance them by the given step.
+        virtual void Step(double time, double step) = 0;
+
+        /// Return true if this simulation is complete (e.g. end of the maneuver). It is then no longer stepped.
+        virtual bool IsComplete() const { return false; }
+
+        /// Write the output of this instance at the specified time (a single line, without the end of line).
+        /// The batch prefixes it with the instance index and the time.
+        virtual void Output(double time, std::ostream& stream) const {}
+
+        /// Return true if this instance was stopped (completed or failed).
+        bool IsDone() const { return m_done; }
+
+        /// Return the error message of the exception which stopped this instance (empty if none).
+        const std::string& GetError() const { return m_error; }
+
+      private:
+        bool m_done;
+        std::string m_error;
+
+        friend class ChVehicleBatch;
+    };
+
+    /// Construct a batch stepped by the specified number of threads.
+    /// By default, the maximum number of OpenMP threads is used.
+    ChVehicleBatch(int num_threads = 0);
+
+    ~ChVehicleBatch();
+
+    /// Add a simulation to the batch.
+    void AddInstance(std::shared_ptr<Instance> instance);
+
+    /// Return the number of simulations in the batch.
+    int GetNumInstances() const { return (int)m_instances.size(); }
+
+    /// Return the specified simulation.
+    std::shared_ptr<Instance> GetInstance(int i) const { return m_instances[i]; }
+
+    /// Return the number of threads stepping the batch.
+    int GetNumThreads() const { return m_num_threads; }
+
+    /// Return the number of simulations which are still running.
+    int GetNumActive() const;
+
+    /// Return the current time of the batch.
+    double GetTime() const { return m_time; }
+
+    /// Enable the aggregated output of all instances, at the given interval, in the specified file.
+    /// Each record is written on a line starting with the instance index and the time, in the order of the
+    /// instances, followed by the output of the instance (see Instance::Output).
+    void SetOutput(const std::string& filename, double output_step);
+
+    /// Initialize all simulations.
+    void Initialize();
+
+    /// Advance all running simulations until the specified time, with the given step.
+    /// The threads synchronize only at output times.
+    void Run(double end_time, double step);
+
+    /// Return a triangle mesh loaded from the specified Wavefront file.
+    /// A file is loaded only once, the mesh is shared by all callers and must not be modified.
+    /// This function can be called concurrently from Instance::Initialize.
+    std::shared_ptr<geometry::ChTriangleMeshConnected> GetMesh(const std::string& filename);
+
+  private:
+    void Advance(int num_steps, double step);
+    void Output();
+
+    int m_num_threads;
+    std::vector<std::shared_ptr<Instance>> m_instances;
+
+    double m_time;
+    bool m_output;
+    double m_output_step;
+    double m_next_output_time;
+    std::ofstream m_output_stream;
+
+    CHOMPmutex m_mesh_mutex;
+    std::unordered_map<std::string, std::shared_ptr<geometry::ChTriangleMeshConnected>> m_meshes;
+};
+
+/// @} vehicle_utils
+
+}  // end namespace vehicle
+}  // end namespace chrono
+
+#endif
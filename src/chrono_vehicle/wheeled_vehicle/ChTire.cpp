@@ -60,7 +60,10 @@ void ChTire::CalculateKinematics(double time, const WheelState& state, const ChT
     ChVector<> wheel_normal = state.rot.GetYaxis();
 
     // Terrain normal at wheel location (expressed in global frame)
-    ChVector<> Z_dir = terrain.GetNormal(state.pos.x(), state.pos.y());
+    double height;
+    ChVector<> Z_dir;
+    float mu;
+    terrain.GetProperties(state.pos.x(), state.pos.y(), height, Z_dir, mu);
 
     // Longitudinal (heading) and lateral directions, in the terrain plane
     ChVector<> X_dir = Vcross(wheel_normal, Z_dir);
@@ -107,15 +110,27 @@ bool ChTire::disc_terrain_contact(const ChTerrain& terrain,
                                   double disc_radius,
                                   ChCoordsys<>& contact,
                                   double& depth) {
-    // Find terrain height below disc center. There is no contact if the disc
-    // center is below the terrain or farther away by more than its radius.
-    double hc = terrain.GetHeight(disc_center.x(), disc_center.y());
+    float mu;
+    return disc_terrain_contact(terrain, disc_center, disc_normal, disc_radius, contact, depth, mu);
+}
+
+bool ChTire::disc_terrain_contact(const ChTerrain& terrain,
+                                  const ChVector<>& disc_center,
+                                  const ChVector<>& disc_normal,
+                                  double disc_radius,
+                                  ChCoordsys<>& contact,
+                                  double& depth,
+                                  float& mu) {
+    // Find terrain height (and coefficient of friction) below disc center. There is no contact if the
+    // disc center is below the terrain or farther away by more than its radius.
+    double hc;
+    ChVector<> nhelp;
+    terrain.GetProperties(disc_center.x(), disc_center.y(), hc, nhelp, mu);
     if (disc_center.z() <= hc || disc_center.z() >= hc + disc_radius)
         return false;
 
     // Find the lowest point on the disc. There is no contact if the disc is
     // (almost) horizontal.
-    ChVector<> nhelp = terrain.GetNormal(disc_center.x(), disc_center.y());
     ChVector<> dir1 = Vcross(disc_normal, nhelp);
     double sinTilt2 = dir1.Length2();
 
@@ -127,14 +142,16 @@ bool ChTire::disc_terrain_contact(const ChTerrain& terrain,
 
     // Find terrain height at lowest point. No contact if lowest point is above
     // the terrain.
-    double hp = terrain.GetHeight(ptD.x(), ptD.y());
+    double hp;
+    ChVector<> normal;
+    float mu_p;
+    terrain.GetProperties(ptD.x(), ptD.y(), hp, normal, mu_p);
 
     if (ptD.z() > hp)
         return false;
 
     // Approximate the terrain with a plane. Define the projection of the lowest
     // point onto this plane as the contact point on the terrain.
-    ChVector<> normal = terrain.GetNormal(ptD.x(), ptD.y());
     ChVector<> longitudinal = Vcross(disc_normal, normal);
     longitudinal.Normalize();
     ChVector<> lateral = Vcross(normal, longitudinal);
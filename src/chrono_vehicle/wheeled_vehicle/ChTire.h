@@ -156,6 +156,18 @@ class CH_VEHICLE_API ChTire : public ChPart {
         double& depth                   ///< [out] penetration depth (positive if contact occurred)
         );
 
+    /// Perform disc-terrain collision detection, also returning the terrain coefficient of friction below
+    /// the disc center (obtained with the same terrain query as the height at that location).
+    static bool disc_terrain_contact(
+        const ChTerrain& terrain,       ///< [in] reference to terrain system
+        const ChVector<>& disc_center,  ///< [in] global location of the disc center
+        const ChVector<>& disc_normal,  ///< [in] disc normal, expressed in the global frame
+        double disc_radius,             ///< [in] disc radius
+        ChCoordsys<>& contact,          ///< [out] contact coordinate system (relative to the global frame)
+        double& depth,                  ///< [out] penetration depth (positive if contact occurred)
+        float& mu                       ///< [out] coefficient of friction below the disc center
+        );
+
     VehicleSide m_side;               ///< tire mounted on left/right side
     std::shared_ptr<ChBody> m_wheel;  ///< associated wheel body
     double m_stepsize;                ///< tire integration step size (if applicable)
@@ -102,16 +102,17 @@ void ChFialaTire::Synchronize(double time, const WheelState& wheel_state, const
     m_tireforce.force = ChVector<>(0, 0, 0);
     m_tireforce.moment = ChVector<>(0, 0, 0);
     m_tireforce.point = wheel_state.pos;
-    
-    m_mu = terrain.GetCoefficientFriction(m_tireforce.point.x(), m_tireforce.point.y());
 
     // Extract the wheel normal (expressed in global frame)
     ChMatrix33<> A(wheel_state.rot);
     ChVector<> disc_normal = A.Get_A_Yaxis();
 
-    // Assuming the tire is a disc, check contact with terrain
+    // Assuming the tire is a disc, check contact with terrain.
+    // The coefficient of friction below the wheel center is obtained with the same terrain query.
+    float mu;
     m_data.in_contact =
-        disc_terrain_contact(terrain, wheel_state.pos, disc_normal, m_unloaded_radius, m_data.frame, m_data.depth);
+        disc_terrain_contact(terrain, wheel_state.pos, disc_normal, m_unloaded_radius, m_data.frame, m_data.depth, mu);
+    m_mu = mu;
     if (m_data.in_contact) {
         // Wheel velocity in the ISO-C Frame
         ChVector<> vel = wheel_state.lin_vel;
@@ -438,7 +438,10 @@ void ChPacejkaTire::update_W_frame(const ChTerrain& terrain) {
     ChVector<> wheel_normal = m_tireState.rot.GetYaxis();
 
     // Terrain normal at wheel center location (expressed in global frame)
-    ChVector<> Z_dir = terrain.GetNormal(m_tireState.pos.x(), m_tireState.pos.y());
+    double height;
+    ChVector<> Z_dir;
+    float mu;
+    terrain.GetProperties(m_tireState.pos.x(), m_tireState.pos.y(), height, Z_dir, mu);
 
     // Longitudinal (heading) and lateral directions, in the terrain plane.
     ChVector<> X_dir = Vcross(wheel_normal, Z_dir);
@@ -137,17 +137,19 @@ void ChTMeasyTire::Synchronize(double time, const WheelState& wheel_state, const
     m_tireforce.force = ChVector<>(0, 0, 0);
     m_tireforce.moment = ChVector<>(0, 0, 0);
     m_tireforce.point = wheel_state.pos;
-    m_mu = terrain.GetCoefficientFriction(m_tireforce.point.x(), m_tireforce.point.y());
-    // Ensure that m_mu stays realistic and the formulae don't degenerate
-    ChClampValue(m_mu, 0.1, 1.0);
 
     // Extract the wheel normal (expressed in global frame)
     ChMatrix33<> A(wheel_state.rot);
     ChVector<> disc_normal = A.Get_A_Yaxis();
 
-    // Assuming the tire is a disc, check contact with terrain
-    m_data.in_contact =
-        disc_terrain_contact_3d(terrain, wheel_state.pos, disc_normal, m_unloaded_radius, m_data.frame, m_data.depth);
+    // Assuming the tire is a disc, check contact with terrain.
+    // The coefficient of friction below the wheel center is obtained with the same terrain query.
+    float mu;
+    m_data.in_contact = disc_terrain_contact_3d(terrain, wheel_state.pos, disc_normal, m_unloaded_radius,
+                                                m_data.frame, m_data.depth, mu);
+    m_mu = mu;
+    // Ensure that m_mu stays realistic and the formulae don't degenerate
+    ChClampValue(m_mu, 0.1, 1.0);
     UpdateVerticalStiffness();
     if (m_data.in_contact) {
         // Wheel velocity in the ISO-C Frame
@@ -432,14 +434,17 @@ bool ChTMeasyTire::disc_terrain_contact_3d(
     const ChVector<>& disc_normal,  // [in] disc normal, expressed in the global frame
     double disc_radius,             // [in] disc radius
     ChCoordsys<>& contact,          // [out] contact coordinate system (relative to the global frame)
-    double& depth                   // [out] penetration depth (positive if contact occurred)
+    double& depth,                  // [out] penetration depth (positive if contact occurred)
+    float& mu                       // [out] coefficient of friction below the disc center
 ) {
     double dx = 0.1 * m_unloaded_radius;
     double dy = 0.3 * m_width;
 
-    // Find terrain height below disc center. There is no contact if the disc
-    // center is below the terrain or farther away by more than its radius.
-    double hc = terrain.GetHeight(disc_center.x(), disc_center.y());
+    // Find terrain height (and coefficient of friction) below disc center. There is no contact if the
+    // disc center is below the terrain or farther away by more than its radius.
+    double hc;
+    ChVector<> nc;
+    terrain.GetProperties(disc_center.x(), disc_center.y(), hc, nc, mu);
     if (disc_center.z() <= hc || disc_center.z() >= hc + disc_radius)
         return false;
 
@@ -456,23 +461,25 @@ bool ChTMeasyTire::disc_terrain_contact_3d(
 
     // Approximate the terrain with a plane. Define the projection of the lowest
     // point onto this plane as the contact point on the terrain.
-    ChVector<> normal = terrain.GetNormal(ptD.x(), ptD.y());
+    double hD;
+    ChVector<> normal;
+    float muD;
+    terrain.GetProperties(ptD.x(), ptD.y(), hD, normal, muD);
     ChVector<> longitudinal = Vcross(disc_normal, normal);
     longitudinal.Normalize();
     ChVector<> lateral = Vcross(normal, longitudinal);
 
-    // Calculate four contact points in the contact patch
-    ChVector<> ptQ1 = ptD + dx * longitudinal;
-    ptQ1.z() = terrain.GetHeight(ptQ1.x(), ptQ1.y());
-
-    ChVector<> ptQ2 = ptD - dx * longitudinal;
-    ptQ2.z() = terrain.GetHeight(ptQ2.x(), ptQ2.y());
-
-    ChVector<> ptQ3 = ptD + dy * lateral;
-    ptQ3.z() = terrain.GetHeight(ptQ3.x(), ptQ3.y());
-
-    ChVector<> ptQ4 = ptD - dy * lateral;
-    ptQ4.z() = terrain.GetHeight(ptQ4.x(), ptQ4.y());
+    // Calculate four contact points in the contact patch (single terrain query)
+    ChVector<> ptQ[4] = {ptD + dx * longitudinal, ptD - dx * longitudinal, ptD + dy * lateral, ptD - dy * lateral};
+    double hQ[4];
+    ChVector<> nQ[4];
+    float muQ[4];
+    terrain.GetProperties(4, ptQ, hQ, nQ, muQ);
+
+    ChVector<> ptQ1(ptQ[0].x(), ptQ[0].y(), hQ[0]);
+    ChVector<> ptQ2(ptQ[1].x(), ptQ[1].y(), hQ[1]);
+    ChVector<> ptQ3(ptQ[2].x(), ptQ[2].y(), hQ[2]);
+    ChVector<> ptQ4(ptQ[3].x(), ptQ[3].y(), hQ[3]);
 
     // Calculate a smoothed road surface normal
     ChVector<> rQ2Q1 = ptQ1 - ptQ2;
@@ -211,7 +211,8 @@ class CH_VEHICLE_API ChTMeasyTire : public ChTire {
         const ChVector<>& disc_normal,  ///< [in] disc normal, expressed in the global frame
         double disc_radius,             ///< [in] disc radius
         ChCoordsys<>& contact,          ///< [out] contact coordinate system (relative to the global frame)
-        double& depth                   ///< [out] penetration depth (positive if contact occurred)
+        double& depth,                  ///< [out] penetration depth (positive if contact occurred)
+        float& mu                       ///< [out] coefficient of friction below the disc center
     );
 
     /// Return the vertical tire stiffness contribution to the normal force.
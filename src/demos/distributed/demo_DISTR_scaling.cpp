@@ -30,7 +30,7 @@ using namespace chrono::collision;
 #define MASTER 0
 
 // ID values to identify command line arguments
-enum { OPT_HELP, OPT_THREADS, OPT_X, OPT_Y, OPT_Z, OPT_TIME, OPT_MONITOR, OPT_OUTPUT_DIR, OPT_VERBOSE };
+enum { OPT_HELP, OPT_THREADS, OPT_X, OPT_Y, OPT_Z, OPT_TIME, OPT_MONITOR, OPT_OUTPUT_DIR, OPT_VERBOSE, OPT_BALANCE };
 
 // Table of CSimpleOpt::Soption structures. Each entry specifies:
 // - the ID for the option (returned from OptionId() during processing)
@@ -47,6 +47,7 @@ CSimpleOptA::SOption g_options[] = {{OPT_HELP, "--help", SO_NONE},
                                     {OPT_MONITOR, "-m", SO_NONE},
                                     {OPT_OUTPUT_DIR, "-o", SO_REQ_CMB},
                                     {OPT_VERBOSE, "-v", SO_NONE},
+                                    {OPT_BALANCE, "-b", SO_REQ_CMB},
                                     SO_END_OF_OPTIONS};
 
 bool GetProblemSpecs(int argc,
@@ -57,7 +58,8 @@ bool GetProblemSpecs(int argc,
                      bool& monitor,
                      bool& verbose,
                      bool& output_data,
-                     std::string& outdir);
+                     std::string& outdir,
+                     int& balance_interval);
 void ShowUsage();
 
 // Granular Properties
@@ -213,7 +215,9 @@ int main(int argc, char* argv[]) {
     bool verbose;
     bool monitor;
     bool output_data;
-    if (!GetProblemSpecs(argc, argv, my_rank, num_threads, time_end, monitor, verbose, output_data, outdir)) {
+    int balance_interval;
+    if (!GetProblemSpecs(argc, argv, my_rank, num_threads, time_end, monitor, verbose, output_data, outdir,
+                         balance_interval)) {
         MPI_Finalize();
         return 1;
     }
@@ -246,6 +250,7 @@ int main(int argc, char* argv[]) {
         std::cout << "Simulation length:          " << time_end << std::endl;
         std::cout << "Monitor?                    " << monitor << std::endl;
         std::cout << "Output?                     " << output_data << std::endl;
+        std::cout << "Rebalance interval:         " << balance_interval << std::endl;
         if (output_data)
             std::cout << "Output directory:           " << outdir << std::endl;
     }
@@ -273,6 +278,9 @@ int main(int argc, char* argv[]) {
     if (verbose)
         my_sys.GetDomain()->PrintDomain();
 
+    // Periodically move the sub-domain boundaries to even out the number of bodies per rank
+    my_sys.SetLoadBalancing(balance_interval, distributed::BODY_COUNT);
+
     // Set solver parameters
     my_sys.GetSettings()->solver.max_iteration_bilateral = max_iteration;
     my_sys.GetSettings()->solver.tolerance = tolerance;
@@ -357,9 +365,11 @@ bool GetProblemSpecs(int argc,
                      bool& monitor,
                      bool& verbose,
                      bool& output_data,
-                     std::string& outdir) {
+                     std::string& outdir,
+                     int& balance_interval) {
     // Initialize parameters.
     num_threads = -1;
+    balance_interval = 0;
     time_end = -1;
     verbose = false;
     monitor = false;
@@ -418,6 +428,10 @@ bool GetProblemSpecs(int argc,
             case OPT_VERBOSE:
                 verbose = true;
                 break;
+
+            case OPT_BALANCE:
+                balance_interval = std::stoi(args.OptionArg());
+                break;
         }
     }
 
@@ -441,6 +455,7 @@ void ShowUsage() {
     std::cout << "-z=<zsize>      Patch dimension in Z direction [REQUIRED]" << std::endl;
     std::cout << "-t=<end_time>   Simulation length [REQUIRED]" << std::endl;
     std::cout << "-o=<outdir>     Output directory (must not exist)" << std::endl;
+    std::cout << "-b=<interval>   Rebalance the sub-domains every <interval> steps (default: 0, disabled)" << std::endl;
     std::cout << "-m              Enable performance monitoring (default: false)" << std::endl;
     std::cout << "-v              Enable verbose output (default: false)" << std::endl;
     std::cout << "-h              Print usage help" << std::endl;
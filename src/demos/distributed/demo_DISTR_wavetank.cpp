@@ -115,8 +115,7 @@ void WriteCSV(ChSystemDistributed& m_sys, size_t frame) {
     for (auto bl_itr = m_sys.data_manager->body_list->begin(); bl_itr != m_sys.data_manager->body_list->end();
          bl_itr++, i++) {
         auto status = m_sys.ddm->comm_status[i];
-        if (status == chrono::distributed::OWNED || status == chrono::distributed::SHARED_UP ||
-            status == chrono::distributed::SHARED_DOWN) {
+        if (status == chrono::distributed::OWNED || status == chrono::distributed::SHARED) {
             ChVector<> pos = (*bl_itr)->GetPos();
             ChVector<> vel = (*bl_itr)->GetPos_dt();
 
@@ -0,0 +1,264 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+//
+// Benchmark tests sweeping all combinations of solver and timestepper types on
+// a set of standard models:
+//   - GranularPile: spheres settling in a box (NSC contacts)
+//   - Mechanism:    chain of links connected by revolute joints
+//   - ANCFCable:    cantilever cable of ANCF elements (SMC, stiffness matrices)
+// Only the combinations that are meaningful for a given model are registered
+// (see the Supports() function of each test).
+//
+// Besides the timers of the simulation phases, each benchmark reports the
+// number of solver calls and iterations per step and the final constraint
+// violation, to detect performance regressions.
+//
+// =============================================================================
+
+#include "chrono/utils/ChBenchmark.h"
+
+#include "chrono/physics/ChBodyEasy.h"
+#include "chrono/physics/ChSystemNSC.h"
+#include "chrono/physics/ChSystemSMC.h"
+#include "chrono/timestepper/ChTimestepperHHT.h"
+
+#include "chrono/fea/ChBuilderBeam.h"
+#include "chrono/fea/ChMesh.h"
+
+using namespace chrono;
+using namespace chrono::fea;
+
+// Solver types for problems with unilateral (contact) constraints.
+static bool IsComplementaritySolver(ChSolver::Type type) {
+    switch (type) {
+        case ChSolver::Type::SOR:
+        case ChSolver::Type::SYMMSOR:
+        case ChSolver::Type::JACOBI:
+        case ChSolver::Type::SOR_MULTITHREAD:
+        case ChSolver::Type::PMINRES:
+        case ChSolver::Type::BARZILAIBORWEIN:
+        case ChSolver::Type::APGD:
+            return true;
+        default:
+            return false;
+    }
+}
+
+// Timestepper types that can be used with stiff (FEA) problems.
+static bool IsImplicitTimestepper(ChTimestepper::Type type) {
+    switch (type) {
+        case ChTimestepper::Type::EULER_IMPLICIT_LINEARIZED:
+        case ChTimestepper::Type::EULER_IMPLICIT:
+        case ChTimestepper::Type::TRAPEZOIDAL:
+        case ChTimestepper::Type::TRAPEZOIDAL_LINEARIZED:
+        case ChTimestepper::Type::HHT:
+        case ChTimestepper::Type::NEWMARK:
+            return true;
+        default:
+            return false;
+    }
+}
+
+// =============================================================================
+
+class GranularPile : public utils::ChBenchmarkTest {
+  public:
+    GranularPile(ChSolver::Type solver_type, ChTimestepper::Type timestepper_type);
+    ~GranularPile() { delete m_system; }
+
+    ChSystem* GetSystem() override { return m_system; }
+    void ExecuteStep() override { m_system->DoStepDynamics(1e-3); }
+
+    // Contacts are handled as complementarity constraints only by the Euler implicit linearized schemes.
+    static bool Supports(ChSolver::Type solver_type, ChTimestepper::Type timestepper_type) {
+        return IsComplementaritySolver(solver_type) &&
+               (timestepper_type == ChTimestepper::Type::EULER_IMPLICIT_LINEARIZED ||
+                timestepper_type == ChTimestepper::Type::EULER_IMPLICIT_PROJECTED);
+    }
+
+  private:
+    ChSystemNSC* m_system;
+};
+
+GranularPile::GranularPile(ChSolver::Type solver_type, ChTimestepper::Type timestepper_type) {
+    m_system = new ChSystemNSC();
+    m_system->SetSolverType(solver_type);
+    m_system->SetTimestepperType(timestepper_type);
+    m_system->SetMaxItersSolverSpeed(100);
+    m_system->SetMaxPenetrationRecoverySpeed(1.0);
+
+    double radius = 0.05;
+    int num_x = 10;
+    int num_z = 10;
+    int num_layers = 8;
+    double hx = num_x * radius * 1.1;
+    double hz = num_z * radius * 1.1;
+
+    // Container (floor and four walls)
+    auto container = std::make_shared<ChBody>();
+    container->SetBodyFixed(true);
+    container->SetCollide(true);
+    container->GetCollisionModel()->ClearModel();
+    container->GetCollisionModel()->AddBox(hx + 0.1, 0.1, hz + 0.1, ChVector<>(0, -0.1, 0));
+    container->GetCollisionModel()->AddBox(0.1, 1, hz + 0.1, ChVector<>(-hx - 0.1, 1, 0));
+    container->GetCollisionModel()->AddBox(0.1, 1, hz + 0.1, ChVector<>(hx + 0.1, 1, 0));
+    container->GetCollisionModel()->AddBox(hx + 0.1, 1, 0.1, ChVector<>(0, 1, -hz - 0.1));
+    container->GetCollisionModel()->AddBox(hx + 0.1, 1, 0.1, ChVector<>(0, 1, hz + 0.1));
+    container->GetCollisionModel()->BuildModel();
+    m_system->AddBody(container);
+
+    // Layers of spheres, slightly perturbed so that the pile does not stay in a lattice
+    for (int il = 0; il < num_layers; il++) {
+        for (int ix = 0; ix < num_x; ix++) {
+            for (int iz = 0; iz < num_z; iz++) {
+                auto ball = std::make_shared<ChBodyEasySphere>(radius, 1000, true, false);
+                double x = -hx + radius * 1.1 * (2 * ix + 1) + 0.01 * radius * (il % 2);
+                double z = -hz + radius * 1.1 * (2 * iz + 1) - 0.01 * radius * (il % 3);
+                ball->SetPos(ChVector<>(x, radius * (2.2 * il + 1.1), z));
+                ball->GetMaterialSurfaceNSC()->SetFriction(0.4f);
+                m_system->AddBody(ball);
+            }
+        }
+    }
+}
+
+// =============================================================================
+
+class Mechanism : public utils::ChBenchmarkTest {
+  public:
+    Mechanism(ChSolver::Type solver_type, ChTimestepper::Type timestepper_type);
+    ~Mechanism() { delete m_system; }
+
+    ChSystem* GetSystem() override { return m_system; }
+    void ExecuteStep() override { m_system->DoStepDynamics(1e-3); }
+
+    // Bilateral constraints only. The explicit timesteppers do not stabilize the constraints and the
+    // joints drift apart; the Newton iterations of the nonlinear implicit timesteppers require the
+    // accurate solutions of a Krylov or direct solver.
+    static bool Supports(ChSolver::Type solver_type, ChTimestepper::Type timestepper_type) {
+        if (timestepper_type == ChTimestepper::Type::EULER_IMPLICIT_LINEARIZED ||
+            timestepper_type == ChTimestepper::Type::EULER_IMPLICIT_PROJECTED)
+            return true;
+        return (solver_type == ChSolver::Type::MINRES || solver_type == ChSolver::Type::PMINRES ||
+                solver_type == ChSolver::Type::SPARSE_LU) &&
+               IsImplicitTimestepper(timestepper_type);
+    }
+
+  private:
+    ChSystemNSC* m_system;
+};
+
+Mechanism::Mechanism(ChSolver::Type solver_type, ChTimestepper::Type timestepper_type) {
+    m_system = new ChSystemNSC();
+    m_system->SetSolverType(solver_type);
+    m_system->SetTimestepperType(timestepper_type);
+    m_system->SetMaxItersSolverSpeed(100);
+    m_system->SetMaxItersSolverStab(100);
+    m_system->SetTolForce(1e-10);
+
+    // With the default tolerances, HHT keeps reducing the step size.
+    if (auto stepper = std::dynamic_pointer_cast<ChTimestepperHHT>(m_system->GetTimestepper())) {
+        stepper->SetAlpha(-0.2);
+        stepper->SetMaxiters(20);
+        stepper->SetAbsTolerances(1e-5);
+        stepper->SetMode(ChTimestepperHHT::POSITION);
+        stepper->SetScaling(true);
+    }
+
+    int num_links = 50;
+    double length = 0.1;
+
+    auto ground = std::make_shared<ChBody>();
+    ground->SetBodyFixed(true);
+    m_system->AddBody(ground);
+
+    // Horizontal chain of links, released from rest and swinging under gravity
+    std::shared_ptr<ChBody> prev = ground;
+    for (int i = 0; i < num_links; i++) {
+        auto link = std::make_shared<ChBodyEasyBox>(length, 0.02, 0.02, 1000, false, false);
+        link->SetPos(ChVector<>((i + 0.5) * length, 0, 0));
+        m_system->AddBody(link);
+
+        auto joint = std::make_shared<ChLinkLockRevolute>();
+        joint->Initialize(prev, link, ChCoordsys<>(ChVector<>(i * length, 0, 0), QUNIT));
+        m_system->AddLink(joint);
+
+        prev = link;
+    }
+}
+
+// =============================================================================
+
+class ANCFCable : public utils::ChBenchmarkTest {
+  public:
+    ANCFCable(ChSolver::Type solver_type, ChTimestepper::Type timestepper_type);
+    ~ANCFCable() { delete m_system; }
+
+    ChSystem* GetSystem() override { return m_system; }
+    void ExecuteStep() override { m_system->DoStepDynamics(1e-3); }
+
+    // The solver must support stiffness matrices, the timestepper must be implicit.
+    static bool Supports(ChSolver::Type solver_type, ChTimestepper::Type timestepper_type) {
+        return (solver_type == ChSolver::Type::MINRES || solver_type == ChSolver::Type::PMINRES ||
+                solver_type == ChSolver::Type::SPARSE_LU) &&
+               IsImplicitTimestepper(timestepper_type);
+    }
+
+  private:
+    ChSystemSMC* m_system;
+};
+
+ANCFCable::ANCFCable(ChSolver::Type solver_type, ChTimestepper::Type timestepper_type) {
+    m_system = new ChSystemSMC();
+    m_system->SetSolverType(solver_type);
+    m_system->SetTimestepperType(timestepper_type);
+    m_system->SetSolverWarmStarting(true);
+    m_system->SetMaxItersSolverSpeed(200);
+    m_system->SetMaxItersSolverStab(200);
+    m_system->SetTolForce(1e-13);
+
+    // Settings of the FEA demos; with the default tolerances HHT keeps reducing the step size.
+    if (auto stepper = std::dynamic_pointer_cast<ChTimestepperHHT>(m_system->GetTimestepper())) {
+        stepper->SetAlpha(-0.2);
+        stepper->SetMaxiters(20);
+        stepper->SetAbsTolerances(1e-5);
+        stepper->SetMode(ChTimestepperHHT::POSITION);
+        stepper->SetScaling(true);
+    }
+
+    auto mesh = std::make_shared<ChMesh>();
+
+    auto section = std::make_shared<ChBeamSectionCable>();
+    section->SetDiameter(0.015);
+    section->SetYoungModulus(0.01e9);
+    section->SetBeamRaleyghDamping(0.000);
+
+    // Horizontal cantilever cable
+    ChBuilderBeamANCF builder;
+    builder.BuildBeam(mesh, section, 50, ChVector<>(0, 0, 0), ChVector<>(1, 0, 0));
+    builder.GetLastBeamNodes().front()->SetFixed(true);
+    builder.GetLastBeamNodes().back()->SetForce(ChVector<>(0, -0.2, 0));
+
+    m_system->Add(mesh);
+    m_system->SetupInitial();
+}
+
+// =============================================================================
+
+int main(int argc, char* argv[]) {
+    utils::RegisterSolverSweep<GranularPile>("GranularPile", 100, 20, 3);
+    utils::RegisterSolverSweep<Mechanism>("Mechanism", 100, 50, 3);
+    utils::RegisterSolverSweep<ANCFCable>("ANCFCable", 50, 20, 3);
+
+    ::benchmark::Initialize(&argc, argv);
+    ::benchmark::RunSpecifiedBenchmarks();
+}
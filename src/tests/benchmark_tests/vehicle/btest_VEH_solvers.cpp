@@ -0,0 +1,119 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+//
+// Benchmark test sweeping the solver and timestepper types applicable to a
+// wheeled vehicle (reduced HMMWV with rigid tires) driving on rigid terrain.
+//
+// =============================================================================
+
+#include <algorithm>
+
+#include "chrono/utils/ChBenchmark.h"
+
+#include "chrono_vehicle/terrain/RigidTerrain.h"
+
+#include "chrono_models/vehicle/hmmwv/HMMWV.h"
+
+using namespace chrono;
+using namespace chrono::vehicle;
+using namespace chrono::vehicle::hmmwv;
+
+// =============================================================================
+
+class HmmwvRigidTerrain : public utils::ChBenchmarkTest {
+  public:
+    HmmwvRigidTerrain(ChSolver::Type solver_type, ChTimestepper::Type timestepper_type);
+    ~HmmwvRigidTerrain();
+
+    ChSystem* GetSystem() override { return m_hmmwv->GetSystem(); }
+    void ExecuteStep() override;
+
+    // Tire-terrain contacts are complementarity constraints (NSC).
+    static bool Supports(ChSolver::Type solver_type, ChTimestepper::Type timestepper_type);
+
+  private:
+    HMMWV_Reduced* m_hmmwv;
+    RigidTerrain* m_terrain;
+    double m_step;
+};
+
+HmmwvRigidTerrain::HmmwvRigidTerrain(ChSolver::Type solver_type, ChTimestepper::Type timestepper_type)
+    : m_step(1e-3) {
+    m_hmmwv = new HMMWV_Reduced();
+    m_hmmwv->SetContactMethod(ChMaterialSurface::NSC);
+    m_hmmwv->SetChassisFixed(false);
+    m_hmmwv->SetInitPosition(ChCoordsys<>(ChVector<>(-40, 0, 0.7), QUNIT));
+    m_hmmwv->SetTireType(TireModelType::RIGID);
+    m_hmmwv->SetTireStepSize(m_step);
+    m_hmmwv->SetVehicleStepSize(m_step);
+    m_hmmwv->Initialize();
+
+    m_hmmwv->SetChassisVisualizationType(VisualizationType::NONE);
+    m_hmmwv->SetSuspensionVisualizationType(VisualizationType::NONE);
+    m_hmmwv->SetSteeringVisualizationType(VisualizationType::NONE);
+    m_hmmwv->SetWheelVisualizationType(VisualizationType::NONE);
+    m_hmmwv->SetTireVisualizationType(VisualizationType::NONE);
+
+    ChSystem* system = m_hmmwv->GetSystem();
+    system->SetSolverType(solver_type);
+    system->SetTimestepperType(timestepper_type);
+    system->SetMaxItersSolverSpeed(150);
+    system->SetMaxItersSolverStab(150);
+
+    m_terrain = new RigidTerrain(system);
+    auto patch = m_terrain->AddPatch(ChCoordsys<>(ChVector<>(0, 0, -5), QUNIT), ChVector<>(200, 20, 10));
+    patch->SetContactFrictionCoefficient(0.9f);
+    patch->SetContactRestitutionCoefficient(0.01f);
+    m_terrain->Initialize();
+}
+
+HmmwvRigidTerrain::~HmmwvRigidTerrain() {
+    delete m_terrain;
+    delete m_hmmwv;
+}
+
+void HmmwvRigidTerrain::ExecuteStep() {
+    double time = m_hmmwv->GetSystem()->GetChTime();
+    double throttle = std::min(time, 0.5);
+
+    m_terrain->Synchronize(time);
+    m_hmmwv->Synchronize(time, 0, 0, throttle, *m_terrain);
+
+    m_terrain->Advance(m_step);
+    m_hmmwv->Advance(m_step);
+}
+
+bool HmmwvRigidTerrain::Supports(ChSolver::Type solver_type, ChTimestepper::Type timestepper_type) {
+    switch (solver_type) {
+        case ChSolver::Type::SOR:
+        case ChSolver::Type::SYMMSOR:
+        case ChSolver::Type::JACOBI:
+        case ChSolver::Type::SOR_MULTITHREAD:
+        case ChSolver::Type::PMINRES:
+        case ChSolver::Type::BARZILAIBORWEIN:
+        case ChSolver::Type::APGD:
+            break;
+        default:
+            return false;
+    }
+    return timestepper_type == ChTimestepper::Type::EULER_IMPLICIT_LINEARIZED ||
+           timestepper_type == ChTimestepper::Type::EULER_IMPLICIT_PROJECTED;
+}
+
+// =============================================================================
+
+int main(int argc, char* argv[]) {
+    utils::RegisterSolverSweep<HmmwvRigidTerrain>("HmmwvRigidTerrain", 500, 50, 3);
+
+    ::benchmark::Initialize(&argc, argv);
+    ::benchmark::RunSpecifiedBenchmarks();
+}
@@ -0,0 +1,198 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+//
+// Unit test for the built-in sparse LU factorization engine.
+//
+// =============================================================================
+
+#include <cmath>
+
+#include "gtest/gtest.h"
+
+#include "chrono/core/ChCSMatrix.h"
+#include "chrono/core/ChMatrixDynamic.h"
+#include "chrono/physics/ChLinkDistance.h"
+#include "chrono/physics/ChLinkLock.h"
+#include "chrono/physics/ChSystemSMC.h"
+#include "chrono/solver/ChSolverSparseLU.h"
+#include "chrono/solver/ChSparseLUEngine.h"
+
+using namespace chrono;
+
+// Assemble a KKT matrix [K Cq'; Cq 0] with K a 1D stiffness chain (diagonal shifted by 'shift')
+// and Cq fixing the first and last nodes. The lower-right block is zero.
+void BuildKKT(ChCSMatrix& Z, int n, double shift) {
+    int dim = n + 2;
+    Z.Reset(dim, dim);
+    for (int i = 0; i < n; i++) {
+        Z.SetElement(i, i, 2.0 + shift);
+        if (i > 0)
+            Z.SetElement(i, i - 1, -1.0);
+        if (i < n - 1)
+            Z.SetElement(i, i + 1, -1.0);
+    }
+    Z.SetElement(n, 0, 1.0);
+    Z.SetElement(0, n, 1.0);
+    Z.SetElement(n + 1, n - 1, 1.0);
+    Z.SetElement(n - 1, n + 1, 1.0);
+    Z.Compress();
+}
+
+double ResidualNorm(const ChCSMatrix& Z, const ChMatrixDynamic<>& b, const ChMatrixDynamic<>& x) {
+    ChMatrixDynamic<> Zx(b.GetRows(), 1);
+    Z.MatrMultiply(x, Zx);
+    double res = 0;
+    for (int i = 0; i < b.GetRows(); i++)
+        res = std::max(res, std::abs(Zx(i) - b(i)));
+    return res;
+}
+
+TEST(ChSparseLUEngine, unsymmetric) {
+    int n = 50;
+    ChCSMatrix A(n, n);
+    for (int i = 0; i < n; i++) {
+        A.SetElement(i, i, 4.0 + 0.1 * i);
+        A.SetElement(i, (i + 7) % n, -1.5);
+        A.SetElement((i + 3) % n, i, 0.5 + 0.01 * i);
+    }
+    A.Compress();
+
+    ChMatrixDynamic<> b(n, 1);
+    for (int i = 0; i < n; i++)
+        b(i) = std::sin(1.0 * i);
+
+    for (auto ordering : {ChSparseLUEngine::Ordering::NATURAL, ChSparseLUEngine::Ordering::RCM,
+                          ChSparseLUEngine::Ordering::MIN_DEGREE}) {
+        ChSparseLUEngine engine;
+        engine.SetOrdering(ordering);
+        ASSERT_TRUE(engine.Factorize(A));
+
+        ChMatrixDynamic<> x;
+        engine.Solve(b, x);
+        ASSERT_LT(ResidualNorm(A, b, x), 1e-10);
+    }
+}
+
+TEST(ChSparseLUEngine, kkt_refactorization) {
+    int n = 200;
+    ChCSMatrix Z(1, 1);
+    Z.SetSparsityPatternLock(true);
+    BuildKKT(Z, n, 0.0);
+
+    ChMatrixDynamic<> b(n + 2, 1);
+    for (int i = 0; i < n + 2; i++)
+        b(i) = 1.0 + 0.01 * i;
+
+    ChSparseLUEngine engine;
+    engine.SetTaskScheduler(std::make_shared<ChTaskScheduler>(2));
+    ASSERT_TRUE(engine.Factorize(Z, true));
+    ASSERT_EQ(engine.GetNumSymbolicFactorizations(), 1);
+
+    ChMatrixDynamic<> x;
+    engine.Solve(b, x);
+    ASSERT_LT(ResidualNorm(Z, b, x), 1e-8);
+
+    // Same pattern, different values: only a numeric refactorization is expected.
+    BuildKKT(Z, n, 0.5);
+    ASSERT_TRUE(engine.Factorize(Z, true));
+    ASSERT_EQ(engine.GetNumSymbolicFactorizations(), 1);
+    ASSERT_EQ(engine.GetNumNumericRefactorizations(), 1);
+
+    engine.Solve(b, x);
+    ASSERT_LT(ResidualNorm(Z, b, x), 1e-8);
+
+    // Without reuse, a complete factorization is performed.
+    ASSERT_TRUE(engine.Factorize(Z, false));
+    ASSERT_EQ(engine.GetNumSymbolicFactorizations(), 2);
+}
+
+TEST(ChSparseLUEngine, singular) {
+    ChCSMatrix A(3, 3);
+    A.SetElement(0, 0, 1.0);
+    A.SetElement(1, 1, 1.0);
+    A.SetElement(2, 1, 1.0);
+    A.Compress();
+
+    ChSparseLUEngine engine;
+    ASSERT_FALSE(engine.Factorize(A));
+}
+
+// KKT matrix of a multibody system: a net of bodies, connected by spherical joints along the rows and by distance
+// constraints between the rows. The first body of each row is jointed to the ground.
+TEST(ChSparseLUEngine, level_schedule) {
+    const int nrows = 8;
+    const int ncols = 15;
+
+    ChSystemSMC system;
+    system.Set_G_acc(ChVector<>(0, 0, -9.81));
+    system.SetSolverType(ChSolver::Type::SPARSE_LU);
+
+    auto ground = std::make_shared<ChBody>();
+    ground->SetBodyFixed(true);
+    system.AddBody(ground);
+
+    std::vector<std::shared_ptr<ChBody>> previous_row;
+    for (int ir = 0; ir < nrows; ir++) {
+        std::vector<std::shared_ptr<ChBody>> row;
+        auto parent = ground;
+        for (int ic = 0; ic < ncols; ic++) {
+            auto body = std::make_shared<ChBody>();
+            body->SetMass(1 + 0.1 * ic);
+            body->SetInertiaXX(ChVector<>(0.1, 0.1, 0.1));
+            body->SetPos(ChVector<>(ic + 0.5, ir, 0));
+            system.AddBody(body);
+
+            auto spherical = std::make_shared<ChLinkLockSpherical>();
+            spherical->Initialize(body, parent, ChCoordsys<>(ChVector<>(ic, ir, 0)));
+            system.AddLink(spherical);
+
+            if (ir > 0) {
+                auto distance = std::make_shared<ChLinkDistance>();
+                distance->Initialize(body, previous_row[ic], false, body->GetPos(), previous_row[ic]->GetPos());
+                system.AddLink(distance);
+            }
+            row.push_back(body);
+            parent = body;
+        }
+        previous_row = row;
+    }
+
+    system.DoStepDynamics(1e-3);
+    auto solver = std::static_pointer_cast<ChSolverSparseLU>(system.GetSolver());
+    const ChCSMatrix& Z = solver->GetMatrix();
+    int n = Z.GetNumRows();
+    ASSERT_EQ(n, nrows * ncols * (6 + 3) + (nrows - 1) * ncols);
+    ASSERT_EQ(solver->GetEngine().GetSize(), n);
+
+    ChMatrixDynamic<> b(n, 1);
+    for (int i = 0; i < n; i++)
+        b(i) = std::cos(0.1 * i);
+
+    // The minimum degree ordering (default) gives several independent columns per level of the refactorization,
+    // the banded RCM ordering an elimination tree with about one column per level.
+    ChSparseLUEngine engine_md;
+    ChSparseLUEngine engine_rcm;
+    engine_rcm.SetOrdering(ChSparseLUEngine::Ordering::RCM);
+    ASSERT_TRUE(engine_md.Factorize(Z));
+    ASSERT_TRUE(engine_rcm.Factorize(Z));
+    ASSERT_EQ(solver->GetEngine().GetNumLevels(), engine_md.GetNumLevels());
+
+    ChMatrixDynamic<> x;
+    engine_md.Solve(b, x);
+    ASSERT_LT(ResidualNorm(Z, b, x), 1e-8);
+
+    double columns_md = (double)n / engine_md.GetNumLevels();
+    double columns_rcm = (double)n / engine_rcm.GetNumLevels();
+    ASSERT_GT(columns_md, 4.0);
+    ASSERT_GT(columns_md, 2 * columns_rcm);
+    ASSERT_LE(engine_md.GetFactorNNZ(), engine_rcm.GetFactorNNZ());
+}
@@ -0,0 +1,319 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+//
+// Unit test for the multithreaded products, projection and assembly of
+// ChSystemDescriptor: results must match those obtained with a single thread,
+// and constraints with the same color must not share any active variable.
+//
+// =============================================================================
+
+#include <cmath>
+#include <memory>
+#include <set>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "chrono/core/ChCSMatrix.h"
+#include "chrono/core/ChMatrixDynamic.h"
+#include "chrono/solver/ChConstraintTwoBodies.h"
+#include "chrono/solver/ChConstraintTwoTuplesContactN.h"
+#include "chrono/solver/ChConstraintTwoTuplesFrictionT.h"
+#include "chrono/solver/ChKblockGeneric.h"
+#include "chrono/solver/ChSystemDescriptor.h"
+#include "chrono/solver/ChVariablesBodyOwnMass.h"
+
+using namespace chrono;
+
+// Descriptor exposing the schedule of the multithreaded operations
+class ChSystemDescriptorSchedule : public ChSystemDescriptor {
+  public:
+    // Check that every constraint is scheduled once, and that constraints with the same color do not share active
+    // variables. Return the number of constraints that were colored.
+    int CheckColoring() {
+        UpdateConstraintColoring();
+        int ncolors = GetNumConstraintColors();
+        EXPECT_EQ(color_constraints.size() + serial_constraints.size(), vconstraints.size());
+        for (int color = 0; color < ncolors; color++) {
+            std::set<ChVariables*> color_vars;
+            for (int k = color_ptr[color]; k < color_ptr[color + 1]; k++) {
+                std::vector<ChVariables*> vars;
+                color_constraints[k]->CollectVariables(vars);
+                std::set<ChVariables*> constr_vars;
+                for (auto var : vars) {
+                    if (var->IsActive() && constr_vars.insert(var).second)
+                        EXPECT_TRUE(color_vars.insert(var).second) << "variable shared in color " << color;
+                }
+            }
+        }
+        return (int)color_constraints.size();
+    }
+
+    int GetNumGroups() const { return (int)group_ptr.size() - 1; }
+    bool GroupsIndependent() const { return groups_independent; }
+};
+
+class ChSystemDescriptorTest : public ::testing::Test {
+  protected:
+    void SetUp() override {
+        int nbodies = 300;
+        int nconstr = 3000;
+
+        for (int ib = 0; ib < nbodies; ib++) {
+            auto var = std::make_shared<ChVariablesBodyOwnMass>();
+            var->SetBodyMass(1.0 + 0.01 * ib);
+            var->SetDisabled(ib == 0);  // one fixed body, shared by many constraints
+            variables.push_back(var);
+        }
+
+        for (int ic = 0; ic < nconstr; ic++) {
+            // Pairs with many repeated bodies, to exercise the coloring
+            int ia = (ic * 7) % nbodies;
+            int ib = (ic % 5 == 0) ? 0 : (ic * 13 + 1) % nbodies;
+            if (ia == ib)
+                ib = (ib + 1) % nbodies;
+
+            auto constr = std::make_shared<ChConstraintTwoBodies>(variables[ia].get(), variables[ib].get());
+            for (int j = 0; j < 6; j++) {
+                (*constr->Get_Cq_a())(0, j) = std::sin(1.0 * (ic + j));
+                (*constr->Get_Cq_b())(0, j) = std::cos(1.0 * (ic - j));
+            }
+            constr->Set_cfm_i(1e-3 * (ic % 3));
+            constr->Update_auxiliary();
+            constraints.push_back(constr);
+        }
+
+        descriptor.BeginInsertion();
+        for (auto& var : variables)
+            descriptor.InsertVariables(var.get());
+        for (auto& constr : constraints)
+            descriptor.InsertConstraint(constr.get());
+        descriptor.EndInsertion();
+    }
+
+    ChSystemDescriptorSchedule descriptor;
+    std::vector<std::shared_ptr<ChVariablesBodyOwnMass>> variables;
+    std::vector<std::shared_ptr<ChConstraintTwoBodies>> constraints;
+};
+
+double MaxDifference(const ChMatrix<>& a, const ChMatrix<>& b) {
+    double diff = 0;
+    for (int i = 0; i < a.GetRows(); i++)
+        diff = std::max(diff, std::abs(a(i) - b(i)));
+    return diff;
+}
+
+TEST_F(ChSystemDescriptorTest, shur_product) {
+    int n_c = descriptor.CountActiveConstraints();
+    ChMatrixDynamic<> l(n_c, 1);
+    for (int i = 0; i < n_c; i++)
+        l(i) = std::sin(0.1 * i);
+
+    ChMatrixDynamic<> result_serial;
+    descriptor.SetTaskScheduler(nullptr);
+    descriptor.ShurComplementProduct(result_serial, &l);
+
+    ChMatrixDynamic<> result_parallel;
+    descriptor.SetTaskScheduler(std::make_shared<ChTaskScheduler>(4));
+    descriptor.ShurComplementProduct(result_parallel, &l);
+
+    ASSERT_GT(descriptor.GetNumConstraintColors(), 1);
+    ASSERT_LT(MaxDifference(result_serial, result_parallel), 1e-10);
+}
+
+TEST_F(ChSystemDescriptorTest, coloring) {
+    ASSERT_EQ(descriptor.CheckColoring(), (int)constraints.size());
+    ASSERT_GT(descriptor.GetNumConstraintColors(), 1);
+}
+
+TEST_F(ChSystemDescriptorTest, system_product) {
+    int n = descriptor.CountActiveVariables() + descriptor.CountActiveConstraints();
+    ChMatrixDynamic<> x(n, 1);
+    for (int i = 0; i < n; i++)
+        x(i) = std::cos(0.1 * i);
+
+    ChMatrixDynamic<> result_serial;
+    descriptor.SetTaskScheduler(nullptr);
+    descriptor.SystemProduct(result_serial, &x);
+
+    ChMatrixDynamic<> result_parallel;
+    descriptor.SetTaskScheduler(std::make_shared<ChTaskScheduler>(4));
+    descriptor.SystemProduct(result_parallel, &x);
+
+    ASSERT_LT(MaxDifference(result_serial, result_parallel), 1e-10);
+}
+
+TEST_F(ChSystemDescriptorTest, kblocks_assembly) {
+    // Stiffness blocks between pairs of bodies
+    std::vector<std::shared_ptr<ChKblockGeneric>> kblocks;
+    for (int ik = 0; ik < 500; ik++) {
+        int ia = (ik * 3) % variables.size();
+        int ib = (ik * 11 + 1) % variables.size();
+        auto block = std::make_shared<ChKblockGeneric>(variables[ia].get(), variables[ib].get());
+        for (int i = 0; i < 12; i++)
+            for (int j = 0; j < 12; j++)
+                (*block->Get_K())(i, j) = std::sin(0.01 * (ik + 12 * i + j));
+        kblocks.push_back(block);
+    }
+
+    descriptor.BeginInsertion();
+    for (auto& var : variables)
+        descriptor.InsertVariables(var.get());
+    for (auto& constr : constraints)
+        descriptor.InsertConstraint(constr.get());
+    for (auto& block : kblocks)
+        descriptor.InsertKblock(block.get());
+    descriptor.EndInsertion();
+
+    // Reference: blocks added one at a time
+    ChCSMatrix Z_serial;
+    descriptor.SetTaskScheduler(nullptr);
+    descriptor.ConvertToMatrixForm(&Z_serial, nullptr);
+
+    // Locked sparsity pattern: after the first assembly, blocks are scattered in parallel
+    ChCSMatrix Z_parallel;
+    Z_parallel.SetSparsityPatternLock(true);
+    descriptor.SetTaskScheduler(std::make_shared<ChTaskScheduler>(4));
+    for (int k = 0; k < 3; k++) {
+        descriptor.ConvertToMatrixForm(&Z_parallel, nullptr);
+        Z_parallel.Compress();
+    }
+
+    int n = Z_serial.GetNumRows();
+    ASSERT_EQ(Z_parallel.GetNumRows(), n);
+
+    ChMatrixDynamic<> x(n, 1);
+    for (int i = 0; i < n; i++)
+        x(i) = std::cos(0.1 * i);
+
+    ChMatrixDynamic<> result_serial(n, 1);
+    ChMatrixDynamic<> result_parallel(n, 1);
+    Z_serial.MatrMultiply(x, result_serial);
+    Z_parallel.MatrMultiply(x, result_parallel);
+
+    ASSERT_LT(MaxDifference(result_serial, result_parallel), 1e-10);
+}
+
+// -----------------------------------------------------------------------------
+
+// Body carrying the variables of the contact constraints
+class ContactBody : public ChVariableTupleCarrier_1vars<6> {
+  public:
+    virtual ChVariables* GetVariables1() override { return &variables; }
+    ChVariablesBodyOwnMass variables;
+};
+
+typedef ChVariableTupleCarrier_1vars<6> ContactTuple;
+
+// Frictional contacts (N, U, V constraints) between bodies with many shared contacts
+TEST(ChSystemDescriptor, contact_projection) {
+    int nbodies = 600;
+    int ncontacts = 1200;
+
+    std::vector<std::shared_ptr<ContactBody>> bodies;
+    for (int ib = 0; ib < nbodies; ib++) {
+        auto body = std::make_shared<ContactBody>();
+        body->variables.SetBodyMass(1.0 + 0.01 * ib);
+        body->variables.SetDisabled(ib == 0);  // ground, in contact with many bodies
+        bodies.push_back(body);
+    }
+
+    std::vector<std::shared_ptr<ChConstraintTwoTuplesContactN<ContactTuple, ContactTuple>>> normals;
+    std::vector<std::shared_ptr<ChConstraintTwoTuplesFrictionT<ContactTuple, ContactTuple>>> tangents;
+    ChSystemDescriptorSchedule descriptor;
+    descriptor.BeginInsertion();
+    for (auto& body : bodies)
+        descriptor.InsertVariables(&body->variables);
+
+    for (int ic = 0; ic < ncontacts; ic++) {
+        int ia = (ic * 17) % nbodies;
+        int ib = (ic % 4 == 0) ? 0 : (ic * 31 + 5) % nbodies;
+        if (ia == ib)
+            ib = (ib + 1) % nbodies;
+
+        auto N = std::make_shared<ChConstraintTwoTuplesContactN<ContactTuple, ContactTuple>>();
+        auto U = std::make_shared<ChConstraintTwoTuplesFrictionT<ContactTuple, ContactTuple>>();
+        auto V = std::make_shared<ChConstraintTwoTuplesFrictionT<ContactTuple, ContactTuple>>();
+        N->SetTangentialConstraintU(U.get());
+        N->SetTangentialConstraintV(V.get());
+        N->SetFrictionCoefficient(0.2 + 0.1 * (ic % 5));
+
+        ChConstraintTwoTuples<ContactTuple, ContactTuple>* rows[3] = {N.get(), U.get(), V.get()};
+        for (int k = 0; k < 3; k++) {
+            rows[k]->Get_tuple_a().SetVariables(*bodies[ia]);
+            rows[k]->Get_tuple_b().SetVariables(*bodies[ib]);
+            for (int j = 0; j < 6; j++) {
+                (*rows[k]->Get_tuple_a().Get_Cq())(0, j) = std::sin(1.0 * (3 * ic + k + j));
+                (*rows[k]->Get_tuple_b().Get_Cq())(0, j) = -std::cos(1.0 * (3 * ic + k - j));
+            }
+            rows[k]->Update_auxiliary();
+            descriptor.InsertConstraint(rows[k]);
+        }
+
+        normals.push_back(N);
+        tangents.push_back(U);
+        tangents.push_back(V);
+    }
+    descriptor.EndInsertion();
+
+    int n_c = descriptor.CountActiveConstraints();
+    ASSERT_EQ(n_c, 3 * ncontacts);
+
+    // Coloring: the N, U, V components of a contact form a group of the projection
+    int ncolored = descriptor.CheckColoring();
+    ASSERT_GT(descriptor.GetNumConstraintColors(), 1);
+    ASSERT_GT(ncolored, n_c / 2);
+    ASSERT_TRUE(descriptor.GroupsIndependent());
+    ASSERT_LE(descriptor.GetNumGroups(), ncontacts);
+
+    // Multipliers inside, above and below the friction cones
+    ChMatrixDynamic<> l(n_c, 1);
+    for (int i = 0; i < n_c; i++)
+        l(i) = 2 * std::sin(0.37 * i);
+
+    ChMatrixDynamic<> proj_serial(l);
+    descriptor.SetTaskScheduler(nullptr);
+    descriptor.ConstraintsProject(proj_serial);
+
+    ChMatrixDynamic<> proj_parallel(l);
+    descriptor.SetTaskScheduler(std::make_shared<ChTaskScheduler>(4));
+    descriptor.ConstraintsProject(proj_parallel);
+
+    ASSERT_GT(MaxDifference(l, proj_serial), 0.1);
+    ASSERT_LT(MaxDifference(proj_serial, proj_parallel), 1e-14);
+
+    // Products with the projected multipliers
+    ChMatrixDynamic<> shur_serial;
+    descriptor.SetTaskScheduler(nullptr);
+    descriptor.ShurComplementProduct(shur_serial, &proj_serial);
+
+    ChMatrixDynamic<> shur_parallel;
+    descriptor.SetTaskScheduler(std::make_shared<ChTaskScheduler>(4));
+    descriptor.ShurComplementProduct(shur_parallel, &proj_serial);
+
+    ASSERT_LT(MaxDifference(shur_serial, shur_parallel), 1e-10);
+
+    int n = descriptor.CountActiveVariables() + n_c;
+    ChMatrixDynamic<> x(n, 1);
+    for (int i = 0; i < n; i++)
+        x(i) = std::cos(0.1 * i);
+
+    ChMatrixDynamic<> sys_serial;
+    descriptor.SetTaskScheduler(nullptr);
+    descriptor.SystemProduct(sys_serial, &x);
+
+    ChMatrixDynamic<> sys_parallel;
+    descriptor.SetTaskScheduler(std::make_shared<ChTaskScheduler>(4));
+    descriptor.SystemProduct(sys_parallel, &x);
+
+    ASSERT_LT(MaxDifference(sys_serial, sys_parallel), 1e-10);
+}
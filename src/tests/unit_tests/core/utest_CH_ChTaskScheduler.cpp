@@ -0,0 +1,87 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+//
+// Unit test for ChTaskScheduler: parallel loops (also nested, and with several
+// threads submitting to the same scheduler) must process every item once.
+//
+// =============================================================================
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "chrono/parallel/ChTaskScheduler.h"
+
+using namespace chrono;
+
+class ChTaskSchedulerTest : public ::testing::TestWithParam<int> {};
+
+TEST_P(ChTaskSchedulerTest, parallel_for) {
+    ChTaskScheduler scheduler(GetParam());
+
+    std::vector<int> count(10000, 0);
+    scheduler.ParallelFor(0, (int)count.size(), [&](int i) { count[i]++; }, 16);
+
+    for (int i = 0; i < (int)count.size(); i++)
+        ASSERT_EQ(count[i], 1);
+}
+
+TEST_P(ChTaskSchedulerTest, nested) {
+    ChTaskScheduler scheduler(GetParam());
+
+    std::vector<int> sums(200, 0);
+    scheduler.ParallelFor(0, (int)sums.size(), [&](int i) {
+        std::atomic<int> sum(0);
+        scheduler.ParallelFor(0, 100, [&](int j) { sum += j; }, 4);
+        sums[i] = sum + i;
+    });
+
+    for (int i = 0; i < (int)sums.size(); i++)
+        ASSERT_EQ(sums[i], 4950 + i);
+}
+
+TEST_P(ChTaskSchedulerTest, shared) {
+    // Several threads (e.g. several systems stepped concurrently) use the same scheduler.
+    ChTaskScheduler scheduler(GetParam());
+
+    std::vector<std::vector<int>> counts(4, std::vector<int>(5000, 0));
+    std::vector<std::thread> threads;
+    for (auto& count : counts) {
+        threads.emplace_back([&scheduler, &count]() {
+            for (int rep = 0; rep < 10; rep++)
+                scheduler.ParallelFor(0, (int)count.size(), [&](int i) { count[i]++; }, 32);
+        });
+    }
+    for (auto& thread : threads)
+        thread.join();
+
+    for (auto& count : counts)
+        for (int i = 0; i < (int)count.size(); i++)
+            ASSERT_EQ(count[i], 10);
+}
+
+TEST(ChTaskSchedulerTest, resize) {
+    ChTaskScheduler scheduler(2);
+
+    for (int nthreads = 1; nthreads <= 4; nthreads++) {
+        scheduler.SetNumThreads(nthreads);
+        ASSERT_EQ(scheduler.GetNumThreads(), nthreads);
+
+        std::atomic<int> sum(0);
+        scheduler.ParallelForRange(0, 1000, [&](int from, int to) { sum += to - from; }, 10);
+        ASSERT_EQ(sum, 1000);
+    }
+}
+
+INSTANTIATE_TEST_CASE_P(ChTaskScheduler, ChTaskSchedulerTest, ::testing::Values(1, 2, 4));
@@ -0,0 +1,217 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2018 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+//
+// Chrono::Distributed unit test for the checkpoints of a simulation.
+// To be run on several MPI ranks: mpirun -np 2 utest_DISTR_checkpoint
+//
+// Pairs of bodies with spheres, boxes and ellipsoids collide across the
+// sub-domain boundaries. A checkpoint is written while they are in contact, and
+// read into a second system. The bodies of the second system must be those of
+// the first one (state, mass, material and collision shapes), and the two
+// systems must then have the same motion.
+//
+// =============================================================================
+
+#include <mpi.h>
+
+#include <cmath>
+#include <cstdio>
+#include <memory>
+#include <string>
+
+#include "chrono_distributed/collision/ChCollisionModelDistributed.h"
+#include "chrono_distributed/physics/ChDomainDistributed.h"
+#include "chrono_distributed/physics/ChSystemDistributed.h"
+
+using namespace chrono;
+using namespace chrono::collision;
+
+const double time_step = 1e-3;
+
+void Setup(ChSystemDistributed& sys) {
+    sys.Set_G_acc(ChVector<>(0, 0, 0));
+    sys.GetSettings()->solver.contact_force_model = ChSystemSMC::ContactForceModel::Hertz;
+    sys.GetSettings()->solver.tangential_displ_mode = ChSystemSMC::TangentialDisplacementModel::MultiStep;
+    sys.GetSettings()->collision.bins_per_axis = vec3(8, 8, 8);
+    sys.GetDomain()->SetDecomposition(0, 0, 1);
+    sys.GetDomain()->SetSimDomain(0, 4, 0, 4, 0, 4);
+}
+
+// Add a body with the given shape: 0 sphere, 1 box, 2 ellipsoid, 3 sphere and ellipsoid
+void AddBody(ChSystemDistributed& sys, int shape, const ChVector<>& pos, const ChVector<>& vel) {
+    auto mat = std::make_shared<ChMaterialSurfaceSMC>();
+    mat->SetYoungModulus(1e4f + 1e3f * shape);
+    mat->SetPoissonRatio(0.3f);
+    mat->SetFriction(0.5f);
+    mat->SetRestitution(0.2f);
+
+    auto body = std::make_shared<ChBody>(std::make_shared<ChCollisionModelDistributed>(), ChMaterialSurface::SMC);
+    body->SetIdentifier(100 + shape);
+    body->SetMaterialSurface(mat);
+    body->SetMass(1 + shape);
+    body->SetInertiaXX(ChVector<>(0.01, 0.02, 0.03));
+    body->SetPos(pos);
+    body->SetRot(Q_from_AngAxis(0.3 * shape, ChVector<>(1, 1, 0).GetNormalized()));
+    body->SetPos_dt(vel);
+    body->SetWvel_par(ChVector<>(0, 0, 0.5 * shape));
+    body->SetCollide(true);
+
+    ChMatrix33<> rot(Q_from_AngZ(0.4));
+    body->GetCollisionModel()->ClearModel();
+    switch (shape) {
+        case 0:
+            body->GetCollisionModel()->AddSphere(0.15, ChVector<>(0, 0, 0));
+            break;
+        case 1:
+            body->GetCollisionModel()->AddBox(0.12, 0.1, 0.08, ChVector<>(0, 0, 0), rot);
+            break;
+        case 2:
+            body->GetCollisionModel()->AddEllipsoid(0.15, 0.1, 0.08, ChVector<>(0, 0, 0), rot);
+            break;
+        case 3:
+            body->GetCollisionModel()->AddSphere(0.1, ChVector<>(-0.05, 0, 0));
+            body->GetCollisionModel()->AddEllipsoid(0.1, 0.06, 0.05, ChVector<>(0.05, 0.02, 0), rot);
+            break;
+    }
+    body->GetCollisionModel()->SetFamilyGroup(1 + shape);
+    body->GetCollisionModel()->BuildModel();
+    sys.AddBody(body);
+}
+
+bool Near(const ChVector<>& a, const ChVector<>& b, double tol) {
+    return (a - b).Length() <= tol;
+}
+
+bool Near(const ChQuaternion<>& a, const ChQuaternion<>& b, double tol) {
+    return (a - b).Length() <= tol;
+}
+
+// Compare the bodies of the restarted system with those of the original system on this rank.
+// The states are compared with the given tolerance, the rest of the bodies only if compare_model is true.
+bool CompareBodies(ChSystemDistributed& sys, ChSystemDistributed& restart, double tol, bool compare_model) {
+    bool ok = true;
+    for (int i = 0; i < (int)sys.data_manager->num_rigid_bodies; i++) {
+        int status = sys.ddm->comm_status[i];
+        if (status != distributed::OWNED && status != distributed::SHARED)
+            continue;
+        int gid = sys.ddm->global_id[i];
+        int j = restart.ddm->GetLocalIndex(gid);
+        if (j == -1 || restart.ddm->comm_status[j] != status) {
+            printf("Rank %d: GID %d (status %d) not restored\n", sys.GetCommRank(), gid, status);
+            ok = false;
+            continue;
+        }
+
+        auto body = sys.Get_bodylist()[i];
+        auto body_r = restart.Get_bodylist()[j];
+        if (!Near(body->GetPos(), body_r->GetPos(), tol) || !Near(body->GetRot(), body_r->GetRot(), tol) ||
+            !Near(body->GetPos_dt(), body_r->GetPos_dt(), tol) ||
+            !Near(body->GetWvel_par(), body_r->GetWvel_par(), tol)) {
+            printf("Rank %d: GID %d state not restored\n", sys.GetCommRank(), gid);
+            ok = false;
+        }
+        if (!compare_model)
+            continue;
+
+        if (body->GetIdentifier() != body_r->GetIdentifier() || body->GetMass() != body_r->GetMass() ||
+            body->GetInertiaXX() != body_r->GetInertiaXX()) {
+            printf("Rank %d: GID %d mass properties not restored\n", sys.GetCommRank(), gid);
+            ok = false;
+        }
+
+        auto mat = body->GetMaterialSurfaceSMC();
+        auto mat_r = body_r->GetMaterialSurfaceSMC();
+        if (mat->young_modulus != mat_r->young_modulus || mat->poisson_ratio != mat_r->poisson_ratio ||
+            mat->sliding_friction != mat_r->sliding_friction || mat->restitution != mat_r->restitution) {
+            printf("Rank %d: GID %d material not restored\n", sys.GetCommRank(), gid);
+            ok = false;
+        }
+
+        auto model = std::static_pointer_cast<ChCollisionModelParallel>(body->GetCollisionModel());
+        auto model_r = std::static_pointer_cast<ChCollisionModelParallel>(body_r->GetCollisionModel());
+        if (model->GetFamilyGroup() != model_r->GetFamilyGroup() || model->mData.size() != model_r->mData.size()) {
+            printf("Rank %d: GID %d collision model not restored\n", sys.GetCommRank(), gid);
+            ok = false;
+            continue;
+        }
+        for (size_t k = 0; k < model->mData.size(); k++) {
+            const ConvexModel& shape = model->mData[k];
+            const ConvexModel& shape_r = model_r->mData[k];
+            if (shape.type != shape_r.type || Length(shape.A - shape_r.A) > 1e-12 ||
+                Length(shape.B - shape_r.B) > 1e-12 || Length(shape.C - shape_r.C) > 1e-12 ||
+                std::abs(Dot(shape.R, shape_r.R)) < 1 - 1e-12) {
+                printf("Rank %d: GID %d shape %d (type %d) not restored\n", sys.GetCommRank(), gid, (int)k,
+                       shape.type);
+                ok = false;
+            }
+        }
+    }
+    return ok;
+}
+
+int main(int argc, char* argv[]) {
+    MPI_Init(&argc, &argv);
+    int my_rank;
+    MPI_Comm_rank(MPI_COMM_WORLD, &my_rank);
+
+    ChSystemDistributed sys(MPI_COMM_WORLD, 0.4, 1000);
+    Setup(sys);
+
+    // Pairs of bodies meeting at x = 1, 2 and 3, and a body crossing x = 2 before the checkpoint
+    for (int k = 0; k < 12; k++) {
+        double xc = 1 + k % 3;
+        double y = 0.4 + 0.3 * k;
+        AddBody(sys, k % 4, ChVector<>(xc - 0.2, y, 2), ChVector<>(0.5, 0, 0));
+        AddBody(sys, (k + 1) % 4, ChVector<>(xc + 0.2, y + 0.03, 2), ChVector<>(-0.5, 0, 0.01 * k));
+    }
+    AddBody(sys, 2, ChVector<>(1.6, 3.9, 3), ChVector<>(4, 0, 0));
+
+    for (int step = 0; step < 150; step++)
+        sys.DoStepDynamics(time_step);
+
+    // The checkpoint is written while bodies are in contact
+    int num_history = 0;
+    for (auto& neigh : sys.data_manager->host_data.shear_neigh)
+        num_history += (neigh.x != -1);
+    MPI_Allreduce(MPI_IN_PLACE, &num_history, 1, MPI_INT, MPI_SUM, MPI_COMM_WORLD);
+    bool ok = num_history > 0;
+
+    std::string filename = "utest_DISTR_checkpoint";
+    sys.WriteCheckpoint(filename);
+    MPI_Barrier(MPI_COMM_WORLD);
+
+    ChSystemDistributed restart(MPI_COMM_WORLD, 0.4, 1000);
+    Setup(restart);
+    restart.ReadCheckpoint(filename);
+    MPI_Barrier(MPI_COMM_WORLD);
+    std::remove((filename + "." + std::to_string(my_rank)).c_str());
+
+    ok = ok && restart.GetNumBodiesGlobal() == sys.GetNumBodiesGlobal();
+    ok = ok && restart.GetChTime() == sys.GetChTime();
+    ok = ok && CompareBodies(sys, restart, 1e-12, true);
+
+    // Same motion after the restart (the contact history is restored). The ghosts of the original system hold the
+    // poses of their owners rounded to single precision, those of the restarted system the exact poses.
+    for (int step = 0; step < 150; step++) {
+        sys.DoStepDynamics(time_step);
+        restart.DoStepDynamics(time_step);
+    }
+    ok = ok && CompareBodies(sys, restart, 1e-5, false);
+
+    if (my_rank == 0)
+        printf("Contact history entries: %d\n", num_history);
+
+    int failed = !ok;
+    MPI_Allreduce(MPI_IN_PLACE, &failed, 1, MPI_INT, MPI_MAX, MPI_COMM_WORLD);
+    MPI_Finalize();
+    return failed;
+}
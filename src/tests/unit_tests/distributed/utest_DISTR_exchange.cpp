@@ -0,0 +1,321 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2018 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+//
+// Chrono::Distributed unit test for the exchange of bodies between sub-domains.
+// To be run on several MPI ranks: mpirun -np 2 utest_DISTR_exchange
+// (on 4 ranks, the domain is divided in 2 x 2 sub-domains).
+//
+// Spinning spheres are thrown across the sub-domain boundaries, some of them in
+// pairs colliding near a boundary, while the load balancing moves the boundaries
+// over spheres at rest and in front of a fast sphere. Throughout the simulation:
+// - every body is owned by exactly one rank;
+// - the ghosts of a body are exactly on the ranks in the ghost mask of its owner;
+// - the ghosts hold the pose of the owner, up to the single precision rounding
+//   of the last update (the updates are changes of the pose, whose rounding
+//   errors must not accumulate).
+// At the end, the states of the bodies must be those of the same simulation with
+// a single (non-distributed) system.
+//
+// =============================================================================
+
+#include <mpi.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <memory>
+#include <vector>
+
+#include "chrono/utils/ChUtilsCreators.h"
+
+#include "chrono_distributed/collision/ChCollisionModelDistributed.h"
+#include "chrono_distributed/physics/ChDomainDistributed.h"
+#include "chrono_distributed/physics/ChSystemDistributed.h"
+
+using namespace chrono;
+using namespace chrono::collision;
+
+const double ghost_layer = 0.5;
+const double radius = 0.2;
+const double time_step = 1e-3;
+const int num_steps = 400;
+
+// Global state of a body on one rank: gid, rank, status, ranks holding a ghost (owner only), position, rotation
+const int rec_size = 11;
+
+void SetSettings(ChSystemParallelSMC& sys) {
+    sys.Set_G_acc(ChVector<>(0, 0, 0));
+    sys.GetSettings()->solver.contact_force_model = ChSystemSMC::ContactForceModel::Hertz;
+    sys.GetSettings()->solver.adhesion_force_model = ChSystemSMC::AdhesionForceModel::Constant;
+    sys.GetSettings()->collision.narrowphase_algorithm = NarrowPhaseType::NARROWPHASE_R;
+    sys.GetSettings()->collision.bins_per_axis = vec3(10, 10, 10);
+}
+
+std::shared_ptr<ChBody> AddSphere(ChSystemParallelSMC& sys,
+                                  bool distributed,
+                                  const ChVector<>& pos,
+                                  const ChVector<>& vel,
+                                  const ChVector<>& omega) {
+    auto mat = std::make_shared<ChMaterialSurfaceSMC>();
+    mat->SetYoungModulus(1e7f);
+    mat->SetFriction(0.4f);
+    mat->SetRestitution(0.5f);
+
+    std::shared_ptr<ChCollisionModel> model;
+    if (distributed)
+        model = std::make_shared<ChCollisionModelDistributed>();
+    else
+        model = std::make_shared<ChCollisionModelParallel>();
+    auto ball = std::make_shared<ChBody>(model, ChMaterialSurface::SMC);
+    ball->SetMaterialSurface(mat);
+    ball->SetMass(1);
+    ball->SetInertiaXX(ChVector<>(0.016, 0.016, 0.016));
+    ball->SetPos(pos);
+    ball->SetPos_dt(vel);
+    ball->SetWvel_par(omega);
+    ball->SetCollide(true);
+    ball->GetCollisionModel()->ClearModel();
+    utils::AddSphereGeometry(ball.get(), radius);
+    ball->GetCollisionModel()->BuildModel();
+    sys.AddBody(ball);
+    return ball;
+}
+
+// Add the same bodies, in the same order, to the distributed system and to the reference system.
+// The domain is [0,10]^3, divided along x and y.
+void AddBodies(ChSystemParallelSMC& sys, bool distributed) {
+    // Spheres crossing the boundaries in both directions
+    double speeds[] = {0.5, 3, 8, 15, 24};
+    for (int k = 0; k < 10; k++) {
+        double v = (k % 2 ? -1 : 1) * speeds[k % 5];
+        double x = 5 - v * num_steps * time_step / 2;
+        AddSphere(sys, distributed, ChVector<>(x, 0.5 + k, 5), ChVector<>(v, 0, 0.1 * k), ChVector<>(k, 1, -2));
+    }
+
+    // Pairs of spheres colliding near x = 2.5, 5 and 7.5
+    for (int k = 0; k < 9; k++) {
+        double xc = 2.5 * (1 + k % 3) + 0.1 * (k - 4);
+        double v = 2 + k;
+        double t = 0.15;  // approximate time of the collision
+        AddSphere(sys, distributed, ChVector<>(xc - v * t - radius, 0.5 + k, 2), ChVector<>(v, 0, 0),
+                  ChVector<>(0, 0, k));
+        AddSphere(sys, distributed, ChVector<>(xc + v * t + radius, 0.5 + k + 0.1, 2), ChVector<>(-v, 0, 0),
+                  ChVector<>(0, 0, 0));
+    }
+
+    // Fast sphere, in the ghost region of the sub-domain above (with 2 x 2 sub-domains), which crosses x = 4.75
+    // in the first step after the load balancing moved the boundary from x = 5 to x = 4.75 (at step 21): the
+    // ghost on the new owner is created by the exchange handing the body over.
+    AddSphere(sys, distributed, ChVector<>(4.46 - 20 * 0.3, 4.6, 6.5), ChVector<>(0.3 / time_step, 0, 0), VNULL);
+
+    // Spheres at rest, near x = 5 and in the lower half of the domain, which the load balancing moves the
+    // boundaries over
+    for (int i = 0; i < 8; i++) {
+        AddSphere(sys, distributed, ChVector<>(3.25 + 0.5 * i, 2.5, 8), VNULL, VNULL);
+    }
+    for (int i = 0; i < 8; i++) {
+        for (int j = 0; j < 8; j++) {
+            AddSphere(sys, distributed, ChVector<>(0.5 + 0.5 * i, 4 + 0.5 * j, 8), VNULL, VNULL);
+        }
+    }
+}
+
+// Gather the states of all bodies held by all ranks on rank 0
+std::vector<double> GatherStates(ChSystemDistributed& sys) {
+    const std::vector<int>& neighbors = sys.GetDomain()->GetNeighbors();
+    std::vector<double> local;
+    for (int i = 0; i < (int)sys.data_manager->num_rigid_bodies; i++) {
+        int status = sys.ddm->comm_status[i];
+        if (status == distributed::EMPTY || status == distributed::GLOBAL)
+            continue;
+        unsigned int ranks = 0;
+        for (int n = 0; n < (int)neighbors.size(); n++) {
+            if (sys.ddm->ghost_mask[i] & (1u << n))
+                ranks |= 1u << neighbors[n];
+        }
+        auto body = sys.Get_bodylist()[i];
+        ChVector<> pos = body->GetPos();
+        ChQuaternion<> rot = body->GetRot();
+        double rec[rec_size] = {(double)sys.ddm->global_id[i],
+                                (double)sys.GetCommRank(),
+                                (double)status,
+                                (double)ranks,
+                                pos.x(),
+                                pos.y(),
+                                pos.z(),
+                                rot.e0(),
+                                rot.e1(),
+                                rot.e2(),
+                                rot.e3()};
+        local.insert(local.end(), rec, rec + rec_size);
+    }
+
+    int num_ranks = sys.GetCommSize();
+    int count = (int)local.size();
+    std::vector<int> counts(num_ranks);
+    MPI_Gather(&count, 1, MPI_INT, counts.data(), 1, MPI_INT, 0, MPI_COMM_WORLD);
+    std::vector<int> displs(num_ranks, 0);
+    for (int r = 1; r < num_ranks; r++)
+        displs[r] = displs[r - 1] + counts[r - 1];
+    std::vector<double> all(sys.GetCommRank() == 0 ? displs.back() + counts.back() : 0);
+    MPI_Gatherv(local.data(), count, MPI_DOUBLE, all.data(), counts.data(), displs.data(), MPI_DOUBLE, 0,
+                MPI_COMM_WORLD);
+    return all;
+}
+
+// Check the consistency of the owners and the ghosts of all bodies. Returns the owner of each body.
+std::vector<int> CheckStates(const std::vector<double>& all, unsigned int num_bodies, int step, bool& ok) {
+    std::vector<int> owner(num_bodies, -1);
+    std::vector<const double*> owner_rec(num_bodies, nullptr);
+    for (size_t k = 0; k < all.size(); k += rec_size) {
+        const double* rec = &all[k];
+        int gid = (int)rec[0];
+        int status = (int)rec[2];
+        if (status != distributed::OWNED && status != distributed::SHARED)
+            continue;
+        if (owner[gid] != -1) {
+            printf("Step %d: GID %d owned by ranks %d and %d\n", step, gid, owner[gid], (int)rec[1]);
+            ok = false;
+        }
+        if ((status == distributed::SHARED) != (rec[3] != 0)) {
+            printf("Step %d: GID %d has status %d and ghost ranks %x\n", step, gid, status, (unsigned int)rec[3]);
+            ok = false;
+        }
+        owner[gid] = (int)rec[1];
+        owner_rec[gid] = rec;
+    }
+
+    std::vector<unsigned int> ghosts(num_bodies, 0);
+    for (size_t k = 0; k < all.size(); k += rec_size) {
+        const double* rec = &all[k];
+        int gid = (int)rec[0];
+        int rank = (int)rec[1];
+        if ((int)rec[2] != distributed::GHOST)
+            continue;
+        if (!owner_rec[gid]) {
+            printf("Step %d: ghost of GID %d on rank %d without owner\n", step, gid, rank);
+            ok = false;
+            continue;
+        }
+        ghosts[gid] |= 1u << rank;
+
+        // The poses differ by the rounding of the last change only
+        double dpos = 0;
+        double drot = 0;
+        for (int c = 0; c < 3; c++)
+            dpos = std::max(dpos, std::abs(rec[4 + c] - owner_rec[gid][4 + c]));
+        for (int c = 0; c < 4; c++)
+            drot = std::max(drot, std::abs(rec[7 + c] - owner_rec[gid][7 + c]));
+        if (dpos > 1e-6 || drot > 1e-6) {
+            printf("Step %d: ghost of GID %d on rank %d off by %g (position) %g (rotation)\n", step, gid, rank, dpos,
+                   drot);
+            ok = false;
+        }
+    }
+
+    for (unsigned int gid = 0; gid < num_bodies; gid++) {
+        if (owner[gid] == -1) {
+            printf("Step %d: GID %d has no owner\n", step, gid);
+            ok = false;
+        } else if (ghosts[gid] != (unsigned int)owner_rec[gid][3]) {
+            printf("Step %d: GID %d has ghosts on ranks %x, its owner on ranks %x\n", step, gid, ghosts[gid],
+                   (unsigned int)owner_rec[gid][3]);
+            ok = false;
+        }
+    }
+    return owner;
+}
+
+int main(int argc, char* argv[]) {
+    MPI_Init(&argc, &argv);
+    int my_rank;
+    MPI_Comm_rank(MPI_COMM_WORLD, &my_rank);
+    int num_ranks;
+    MPI_Comm_size(MPI_COMM_WORLD, &num_ranks);
+    if (num_ranks < 2) {
+        printf("To be run on several MPI ranks\n");
+        MPI_Finalize();
+        return 1;
+    }
+
+    ChSystemDistributed sys(MPI_COMM_WORLD, ghost_layer, 1000);
+    SetSettings(sys);
+    sys.GetDomain()->SetDecomposition(0, 0, 1);
+    sys.GetDomain()->SetSimDomain(0, 10, 0, 10, 0, 10);
+    sys.SetLoadBalancing(20, distributed::BODY_COUNT);
+    AddBodies(sys, true);
+    unsigned int num_bodies = sys.GetNumBodiesGlobal();
+    std::vector<double> initial_bounds = sys.GetDomain()->GetSplitBounds(0);
+
+    // Reference simulation on rank 0
+    ChSystemParallelSMC ref;
+    if (my_rank == 0) {
+        SetSettings(ref);
+        AddBodies(ref, false);
+    }
+
+    bool ok = true;
+    int num_migrations = 0;
+    std::vector<int> owner = CheckStates(GatherStates(sys), my_rank == 0 ? num_bodies : 0, 0, ok);
+    for (int step = 1; step <= num_steps; step++) {
+        sys.DoStepDynamics(time_step);
+        if (my_rank == 0)
+            ref.DoStepDynamics(time_step);
+
+        std::vector<double> all = GatherStates(sys);
+        if (my_rank == 0) {
+            std::vector<int> new_owner = CheckStates(all, num_bodies, step, ok);
+            for (unsigned int gid = 0; gid < num_bodies; gid++) {
+                if (new_owner[gid] != owner[gid])
+                    num_migrations++;
+            }
+            owner = new_owner;
+
+            if (step == num_steps) {
+                // Same motion as without domain decomposition
+                double max_dpos = 0;
+                double max_drot = 0;
+                for (size_t k = 0; k < all.size(); k += rec_size) {
+                    int status = (int)all[k + 2];
+                    if (status != distributed::OWNED && status != distributed::SHARED)
+                        continue;
+                    auto body = ref.Get_bodylist()[(int)all[k]];
+                    ChVector<> pos(all[k + 4], all[k + 5], all[k + 6]);
+                    ChQuaternion<> rot(all[k + 7], all[k + 8], all[k + 9], all[k + 10]);
+                    max_dpos = std::max(max_dpos, (body->GetPos() - pos).Length());
+                    max_drot = std::max(max_drot, (body->GetRot() - rot).Length());
+                }
+                printf("Migrations: %d   Position error: %g   Rotation error: %g\n", num_migrations, max_dpos,
+                       max_drot);
+                if (max_dpos > 1e-6 || max_drot > 1e-6)
+                    ok = false;
+                if (num_migrations < 20)
+                    ok = false;
+            }
+        }
+        int failed = !ok;
+        MPI_Bcast(&failed, 1, MPI_INT, 0, MPI_COMM_WORLD);
+        if (failed)
+            break;
+    }
+
+    // The load balancing moved the boundaries towards the spheres at rest
+    if (my_rank == 0 && sys.GetDomain()->GetSplitBounds(0)[1] >= initial_bounds[1]) {
+        printf("The sub-domain boundaries were not moved\n");
+        ok = false;
+    }
+
+    int failed = !ok;
+    MPI_Bcast(&failed, 1, MPI_INT, 0, MPI_COMM_WORLD);
+    MPI_Finalize();
+    return failed;
+}
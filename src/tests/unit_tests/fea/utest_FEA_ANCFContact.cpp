@@ -168,16 +168,15 @@ int main(int argc, char* argv[]) {
 class MyContactContainer : public ChContactContainerSMC {
   public:
     MyContactContainer() {}
-    // Traverse the list contactlist_6_6
+    // Traverse the contacts in contactlist_333_333
     bool isThereContacts(std::shared_ptr<ChElementBase> myShellANCF, bool print) {
-        auto iter = contactlist_333_333.begin();
         int num_contact = 0;
-        while (iter != contactlist_333_333.end()) {
-            ChContactable* objA = (*iter)->GetObjA();
-            ChContactable* objB = (*iter)->GetObjB();
-            ChVector<> p1 = (*iter)->GetContactP1();
-            ChVector<> p2 = (*iter)->GetContactP2();
-            double CD = (*iter)->GetContactDistance();
+        for (int i = 0; i < contactlist_333_333.GetNcontacts(); i++) {
+            ChContactable* objA = contactlist_333_333[i].GetObjA();
+            ChContactable* objB = contactlist_333_333[i].GetObjB();
+            ChVector<> p1 = contactlist_333_333[i].GetContactP1();
+            ChVector<> p2 = contactlist_333_333[i].GetContactP2();
+            double CD = contactlist_333_333[i].GetContactDistance();
 
             if (print) {
                 printf("P1=[%f %f %f]\n", p1.x(), p1.y(), p1.z());
@@ -185,7 +184,6 @@ class MyContactContainer : public ChContactContainerSMC {
                 printf("Contact Distance=%f\n\n", CD);
             }
             num_contact++;
-            ++iter;
         }
         return num_contact > 0;
     }
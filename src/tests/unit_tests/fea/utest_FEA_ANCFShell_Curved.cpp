@@ -0,0 +1,129 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+//
+// Unit test for the Jacobian of the ANCF shell element in a curved reference
+// configuration.
+//
+// The nodes of a single element are placed on a sphere, with directions tilted
+// from the surface normals, so that all the terms of the transformation of the
+// strains to the element frame are nonzero (the flat elements of the other
+// shell tests do not exercise the couplings with the thickness direction).
+// The stiffness matrix in the reference configuration is compared with the
+// central finite differences of the internal forces. The check is done in the
+// stress-free state, where the geometric stiffness vanishes and the analytical
+// Jacobian is exact.
+//
+// =============================================================================
+
+#include <algorithm>
+#include <cmath>
+
+#include "chrono/physics/ChSystemNSC.h"
+#include "chrono/fea/ChElementShellANCF.h"
+#include "chrono/fea/ChMesh.h"
+
+using namespace chrono;
+using namespace chrono::fea;
+
+const double precision = 1e-6;  // Used to accept/reject implementation (relative to the largest stiffness entry)
+
+int main(int argc, char* argv[]) {
+    ChSystemNSC my_system;
+
+    auto my_mesh = std::make_shared<ChMesh>();
+    my_mesh->SetAutomaticGravity(false);
+
+    // Element on a sphere of radius R, spanning the angles [-a, a] about the X and Y axes
+    double R = 1.0;
+    double a = 0.2;
+    double thickness = 0.02;
+    double angles[4][2] = {{-a, -a}, {a, -a}, {a, a}, {-a, a}};
+
+    std::shared_ptr<ChNodeFEAxyzD> nodes[4];
+    for (int i = 0; i < 4; i++) {
+        double tx = angles[i][0];
+        double ty = angles[i][1];
+        ChVector<> normal(std::sin(tx), std::sin(ty), std::cos(tx) * std::cos(ty));
+        normal.Normalize();
+        ChVector<> dir = normal + ChVector<>(0.05 * (i - 1.5), 0.03 * (i % 2), 0);
+        dir.Normalize();
+        nodes[i] = std::make_shared<ChNodeFEAxyzD>(R * normal, dir);
+        nodes[i]->SetMass(0);
+        my_mesh->AddNode(nodes[i]);
+    }
+
+    auto mat = std::make_shared<ChMaterialShellANCF>(500, 2.1e8, 0.3);
+
+    auto element = std::make_shared<ChElementShellANCF>();
+    element->SetNodes(nodes[0], nodes[1], nodes[2], nodes[3]);
+    element->SetDimensions(2 * a * R, 2 * a * R);
+    element->AddLayer(thickness, 20 * CH_C_DEG_TO_RAD, mat);
+    element->SetAlphaDamp(0.0);
+    element->SetGravityOn(false);
+    my_mesh->AddElement(element);
+
+    my_system.Add(my_mesh);
+    my_system.SetupInitial();
+
+    // Analytical Jacobian in the reference configuration
+    ChMatrixDynamic<> Fi(24, 1);
+    element->ComputeInternalForces(Fi);
+    ChMatrixDynamic<> K(24, 24);
+    element->ComputeKRMmatricesGlobal(K, 1.0, 0.0, 0.0);
+
+    // Central finite differences of the internal forces (K = -dF/dq)
+    double h = 1e-7;
+    ChMatrixDynamic<> Fp(24, 1);
+    ChMatrixDynamic<> Fm(24, 1);
+    double max_K = 0;
+    double max_err = 0;
+    for (int j = 0; j < 24; j++) {
+        auto node = nodes[j / 6];
+        int k = j % 6;
+        ChVector<> pos = node->GetPos();
+        ChVector<> dir = node->GetD();
+        ChVector<> delta(k % 3 == 0 ? h : 0, k % 3 == 1 ? h : 0, k % 3 == 2 ? h : 0);
+
+        if (k < 3)
+            node->SetPos(pos + delta);
+        else
+            node->SetD(dir + delta);
+        element->ComputeInternalForces(Fp);
+
+        if (k < 3)
+            node->SetPos(pos - delta);
+        else
+            node->SetD(dir - delta);
+        element->ComputeInternalForces(Fm);
+
+        node->SetPos(pos);
+        node->SetD(dir);
+
+        for (int i = 0; i < 24; i++) {
+            double K_fd = -(Fp(i) - Fm(i)) / (2 * h);
+            max_K = std::max(max_K, std::abs(K(i, j)));
+            max_err = std::max(max_err, std::abs(K(i, j) - K_fd));
+        }
+    }
+
+    double rel_err = max_err / max_K;
+    std::cout << "Largest stiffness entry: " << max_K << "\n";
+    std::cout << "Largest difference from finite differences: " << max_err << " (relative " << rel_err << ")\n";
+
+    if (rel_err > precision) {
+        std::cout << "Unit test check failed\n";
+        return 1;
+    }
+
+    std::cout << "Unit test check succeeded\n";
+    return 0;
+}
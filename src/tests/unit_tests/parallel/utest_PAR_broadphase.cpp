@@ -0,0 +1,218 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+//
+// ChronoParallel unit tests comparing the pairs found by the grid (full and
+// incremental) and the bounding volume hierarchy broadphase algorithms, for a
+// scene mixing a large container and small particles, and the pairs found by
+// the incremental grid over many steps of a bed of particles hit by projectiles
+// with those found by the full grid.
+// =============================================================================
+
+#include <algorithm>
+#include <random>
+
+#include "chrono/utils/ChUtilsCreators.h"
+
+#include "chrono_parallel/collision/ChCollision.h"
+#include "chrono_parallel/collision/ChCollisionSystemParallel.h"
+#include "chrono_parallel/physics/ChSystemParallel.h"
+
+#include "unit_testing.h"
+
+using namespace chrono;
+using namespace chrono::collision;
+
+// Create a container with the given broadphase, fill it with spheres and return the overlapping pairs.
+std::vector<long long> FindPairs(BroadPhaseType broadphase, bool incremental = false) {
+    ChSystemParallelNSC msystem;
+    CHOMPfunctions::SetNumThreads(2);
+    msystem.GetSettings()->max_threads = 2;
+    msystem.GetSettings()->collision.broadphase_algorithm = broadphase;
+    msystem.GetSettings()->collision.incremental_broadphase = incremental;
+    msystem.GetSettings()->collision.bins_per_axis = vec3(10, 10, 10);
+    msystem.GetSettings()->collision.collision_envelope = 0.01;
+
+    auto material = std::make_shared<ChMaterialSurfaceNSC>();
+
+    auto container = std::make_shared<ChBody>(std::make_shared<ChCollisionModelParallel>());
+    container->SetMaterialSurface(material);
+    container->SetBodyFixed(true);
+    container->SetCollide(true);
+    container->GetCollisionModel()->ClearModel();
+    utils::AddBoxGeometry(container.get(), ChVector<>(50, 50, 0.5), ChVector<>(0, 0, -0.5));
+    utils::AddBoxGeometry(container.get(), ChVector<>(0.5, 50, 5), ChVector<>(-50.5, 0, 5));
+    utils::AddBoxGeometry(container.get(), ChVector<>(0.5, 50, 5), ChVector<>(50.5, 0, 5));
+    container->GetCollisionModel()->BuildModel();
+    msystem.AddBody(container);
+
+    std::mt19937 rng(11);
+    std::uniform_real_distribution<double> x(-50, 50);
+    std::uniform_real_distribution<double> y(-2, 2);
+    std::uniform_real_distribution<double> z(0, 1);
+    for (int i = 0; i < 2000; i++) {
+        auto ball = std::make_shared<ChBody>(std::make_shared<ChCollisionModelParallel>());
+        ball->SetMaterialSurface(material);
+        ball->SetPos(ChVector<>(x(rng), y(rng), z(rng)));
+        ball->SetCollide(true);
+        ball->GetCollisionModel()->ClearModel();
+        utils::AddSphereGeometry(ball.get(), 0.1);
+        ball->GetCollisionModel()->BuildModel();
+        msystem.AddBody(ball);
+    }
+
+    msystem.DoStepDynamics(1e-4);
+
+    std::vector<long long> pairs(msystem.data_manager->host_data.contact_pairs.begin(),
+                                 msystem.data_manager->host_data.contact_pairs.end());
+    std::sort(pairs.begin(), pairs.end());
+    return pairs;
+}
+
+TEST(ChronoParallel, broadphase) {
+    auto grid_pairs = FindPairs(BroadPhaseType::BROADPHASE_GRID);
+    auto lbvh_pairs = FindPairs(BroadPhaseType::BROADPHASE_LBVH);
+    auto incremental_pairs = FindPairs(BroadPhaseType::BROADPHASE_GRID, true);
+
+    ASSERT_GT(grid_pairs.size(), 0);
+    ASSERT_EQ(grid_pairs.size(), lbvh_pairs.size());
+    ASSERT_TRUE(std::equal(grid_pairs.begin(), grid_pairs.end(), lbvh_pairs.begin()));
+
+    // Bodies at rest and no margin: the inflated AABBs are the AABBs
+    ASSERT_EQ(grid_pairs.size(), incremental_pairs.size());
+    ASSERT_TRUE(std::equal(grid_pairs.begin(), grid_pairs.end(), incremental_pairs.begin()));
+}
+
+// Create a container with a bed of spheres at rest and a few fast spheres thrown at it.
+void CreateBed(ChSystemParallelNSC& msystem, std::vector<std::shared_ptr<ChBody>>& bodies) {
+    auto material = std::make_shared<ChMaterialSurfaceNSC>();
+
+    auto container = std::make_shared<ChBody>(std::make_shared<ChCollisionModelParallel>());
+    container->SetMaterialSurface(material);
+    container->SetBodyFixed(true);
+    container->SetCollide(true);
+    container->GetCollisionModel()->ClearModel();
+    utils::AddBoxGeometry(container.get(), ChVector<>(6, 6, 0.5), ChVector<>(0, 0, -0.5));
+    container->GetCollisionModel()->BuildModel();
+    msystem.AddBody(container);
+    bodies.push_back(container);
+
+    for (int i = 0; i < 30; i++) {
+        for (int j = 0; j < 30; j++) {
+            auto ball = std::make_shared<ChBody>(std::make_shared<ChCollisionModelParallel>());
+            ball->SetMaterialSurface(material);
+            ball->SetPos(ChVector<>(-3.625 + 0.25 * i, -3.625 + 0.25 * j, 0.1));
+            ball->SetCollide(true);
+            ball->GetCollisionModel()->ClearModel();
+            utils::AddSphereGeometry(ball.get(), 0.1);
+            ball->GetCollisionModel()->BuildModel();
+            msystem.AddBody(ball);
+            bodies.push_back(ball);
+        }
+    }
+
+    for (int k = 0; k < 15; k++) {
+        auto ball = std::make_shared<ChBody>(std::make_shared<ChCollisionModelParallel>());
+        ball->SetMaterialSurface(material);
+        ball->SetPos(ChVector<>(-4.2, -3.5 + 0.5 * k, 0.12));
+        ball->SetPos_dt(ChVector<>(20, 2 * std::sin(k), 0));
+        ball->SetCollide(true);
+        ball->GetCollisionModel()->ClearModel();
+        utils::AddSphereGeometry(ball.get(), 0.12);
+        ball->GetCollisionModel()->BuildModel();
+        msystem.AddBody(ball);
+        bodies.push_back(ball);
+    }
+}
+
+// Run the broadphase of a system (without the narrowphase, which discards the pairs which are not in contact).
+void RunBroadphase(ChSystemParallelNSC& msystem) {
+    msystem.Setup();
+    msystem.Update();
+    msystem.data_manager->aabb_generator->GenerateAABB();
+    msystem.data_manager->broadphase->DetermineBoundingBox();
+    msystem.data_manager->broadphase->OffsetAABB();
+    msystem.data_manager->broadphase->ComputeTopLevelResolution();
+    msystem.data_manager->broadphase->DispatchRigid();
+}
+
+TEST(ChronoParallel, incremental_broadphase) {
+    const double step = 1e-3;
+    const double margin = 0.01;
+
+    // System simulated with the incremental grid
+    ChSystemParallelNSC msystem;
+    CHOMPfunctions::SetNumThreads(2);
+    msystem.GetSettings()->max_threads = 2;
+    msystem.GetSettings()->solver.max_iteration_normal = 0;
+    msystem.GetSettings()->solver.max_iteration_sliding = 20;
+    msystem.GetSettings()->collision.collision_envelope = 0.01;
+    msystem.GetSettings()->collision.bins_per_axis = vec3(20, 20, 2);
+    msystem.GetSettings()->collision.incremental_broadphase = true;
+    msystem.GetSettings()->collision.broadphase_margin = margin;
+    std::vector<std::shared_ptr<ChBody>> bodies;
+    CreateBed(msystem, bodies);
+
+    // Same bodies, with the full grid
+    ChSystemParallelNSC reference;
+    reference.GetSettings()->max_threads = 2;
+    reference.GetSettings()->collision.collision_envelope = 0.01;
+    reference.GetSettings()->collision.bins_per_axis = vec3(20, 20, 2);
+    std::vector<std::shared_ptr<ChBody>> ref_bodies;
+    CreateBed(reference, ref_bodies);
+    reference.DoStepDynamics(step);  // set up the data manager of the system
+
+    int num_updates = 0;
+    double max_speed = 0;
+    for (int is = 0; is < 100; is++) {
+        // The reference finds the pairs for the states at the beginning of the step
+        for (size_t i = 0; i < bodies.size(); i++) {
+            max_speed = std::max(max_speed, bodies[i]->GetPos_dt().Length());
+            ref_bodies[i]->SetPos(bodies[i]->GetPos());
+            ref_bodies[i]->SetRot(bodies[i]->GetRot());
+            ref_bodies[i]->SetPos_dt(bodies[i]->GetPos_dt());
+            ref_bodies[i]->SetWvel_par(bodies[i]->GetWvel_par());
+        }
+        RunBroadphase(reference);
+        std::vector<long long> ref_pairs(reference.data_manager->host_data.contact_pairs.begin(),
+                                         reference.data_manager->host_data.contact_pairs.end());
+        std::sort(ref_pairs.begin(), ref_pairs.end());
+
+        msystem.DoStepDynamics(step);
+        const auto& host_data = msystem.data_manager->host_data;
+        std::vector<long long> pairs(host_data.bin_pairs.begin(), host_data.bin_pairs.end());
+        std::sort(pairs.begin(), pairs.end());
+        size_t num_moved = host_data.bin_moved_shapes.size();
+        if (num_moved > 0 && num_moved <= bodies.size() / 4)
+            num_updates++;
+
+        // No pair is missed, no pair is reported twice
+        ASSERT_GT(ref_pairs.size(), 0);
+        ASSERT_TRUE(std::includes(pairs.begin(), pairs.end(), ref_pairs.begin(), ref_pairs.end())) << "step " << is;
+        ASSERT_TRUE(std::adjacent_find(pairs.begin(), pairs.end()) == pairs.end()) << "step " << is;
+
+        // The additional pairs are close: the AABBs are inflated by the margin and the distance traveled in a step
+        // (at the speed of the step in which they were last inflated)
+        const auto& aabb_min = reference.data_manager->host_data.aabb_min;
+        const auto& aabb_max = reference.data_manager->host_data.aabb_max;
+        for (long long pair : pairs) {
+            int a = (int)(pair >> 32);
+            int b = (int)(pair & 0xffffffff);
+            real3 gap = Max(aabb_min[a] - aabb_max[b], aabb_min[b] - aabb_max[a]);
+            ASSERT_LE(std::max(gap.x, std::max(gap.y, gap.z)), 2 * (margin + max_speed * step) + 1e-9)
+                << "step " << is;
+        }
+    }
+
+    // The projectiles reached the bed (its first row is at x = -3.625) and many steps updated the moved shapes only
+    ASSERT_GT(bodies.back()->GetPos().x(), -3.8);
+    ASSERT_GT(num_updates, 30);
+}
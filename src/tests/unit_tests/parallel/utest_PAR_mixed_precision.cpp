@@ -0,0 +1,175 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+//
+// ChronoParallel unit tests for the mixed precision Schur product of the NSC
+// solver. The same pile of spheres, with a pendulum jointed to the container,
+// is simulated with the double precision and the mixed precision products. The
+// Schur products of the two systems (for all constraints and for the subsets
+// used by the local solver modes) must agree to single precision, and so must
+// the states of the bodies after a short simulation.
+//
+// =============================================================================
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+
+#include "chrono/physics/ChLinkLock.h"
+#include "chrono/utils/ChUtilsCreators.h"
+
+#include "chrono_parallel/physics/ChSystemParallel.h"
+#include "chrono_parallel/solver/ChSolverParallel.h"
+
+#include "unit_testing.h"
+
+using namespace chrono;
+using namespace chrono::collision;
+
+// Create a container with a pile of spheres and a pendulum jointed to the container.
+void CreatePile(ChSystemParallelNSC& msystem, bool mixed_precision, std::vector<std::shared_ptr<ChBody>>& bodies) {
+    CHOMPfunctions::SetNumThreads(2);
+    msystem.GetSettings()->max_threads = 2;
+    msystem.Set_G_acc(ChVector<>(0, 0, -9.81));
+    msystem.GetSettings()->solver.solver_mode = SolverMode::SLIDING;
+    msystem.GetSettings()->solver.max_iteration_normal = 20;
+    msystem.GetSettings()->solver.max_iteration_sliding = 50;
+    msystem.GetSettings()->solver.max_iteration_spinning = 0;
+    msystem.GetSettings()->solver.max_iteration_bilateral = 20;
+    msystem.GetSettings()->solver.tolerance = 0;
+    msystem.GetSettings()->solver.mixed_precision = mixed_precision;
+    msystem.GetSettings()->collision.collision_envelope = 0.01;
+    msystem.GetSettings()->collision.bins_per_axis = vec3(10, 10, 10);
+    msystem.ChangeSolverType(SolverType::APGD);
+
+    auto material = std::make_shared<ChMaterialSurfaceNSC>();
+    material->SetFriction(0.4f);
+
+    auto container = utils::CreateBoxContainer(&msystem, 0, material, ChVector<>(0.8, 0.8, 1), 0.1, ChVector<>(0, 0, 0),
+                                               QUNIT, true, false, true, false);
+    bodies.push_back(container);
+
+    int id = 1;
+    for (int k = 0; k < 2; k++) {
+        for (int j = 0; j < 6; j++) {
+            for (int i = 0; i < 6; i++) {
+                auto ball = std::make_shared<ChBody>(std::make_shared<ChCollisionModelParallel>());
+                ball->SetIdentifier(id++);
+                ball->SetMaterialSurface(material);
+                ball->SetMass(1);
+                ball->SetInertiaXX(ChVector<>(0.004, 0.004, 0.004));
+                ball->SetPos(ChVector<>(-0.5 + 0.2 * i + 0.01 * k, -0.5 + 0.2 * j - 0.01 * k, 0.1 + 0.199 * k));
+                ball->SetCollide(true);
+                ball->GetCollisionModel()->ClearModel();
+                utils::AddSphereGeometry(ball.get(), 0.1);
+                ball->GetCollisionModel()->BuildModel();
+                msystem.AddBody(ball);
+                bodies.push_back(ball);
+            }
+        }
+    }
+
+    auto pendulum = std::make_shared<ChBody>(std::make_shared<ChCollisionModelParallel>());
+    pendulum->SetIdentifier(id++);
+    pendulum->SetMass(2);
+    pendulum->SetInertiaXX(ChVector<>(0.1, 0.1, 0.1));
+    pendulum->SetPos(ChVector<>(0.5, 0, 1.5));
+    pendulum->SetCollide(false);
+    msystem.AddBody(pendulum);
+    bodies.push_back(pendulum);
+
+    auto revolute = std::make_shared<ChLinkLockRevolute>();
+    revolute->Initialize(pendulum, container, ChCoordsys<>(ChVector<>(0, 0, 1.5), Q_from_AngX(CH_C_PI_2)));
+    msystem.AddLink(revolute);
+}
+
+// Schur products of the two systems for the given local solver mode, with the same random vector.
+void CompareProducts(ChSystemParallelNSC& sys_double, ChSystemParallelNSC& sys_mixed, SolverMode mode) {
+    uint num_constraints = sys_double.data_manager->num_constraints;
+    ASSERT_EQ(num_constraints, sys_mixed.data_manager->num_constraints);
+
+    std::mt19937 rng(3);
+    std::uniform_real_distribution<double> dist(-1, 1);
+    DynamicVector<real> x(num_constraints);
+    for (uint i = 0; i < num_constraints; i++)
+        x[i] = dist(rng);
+
+    DynamicVector<real> out_double(num_constraints);
+    DynamicVector<real> out_mixed(num_constraints);
+    sys_double.data_manager->settings.solver.local_solver_mode = mode;
+    sys_mixed.data_manager->settings.solver.local_solver_mode = mode;
+    ChShurProduct product_double;
+    ChShurProduct product_mixed;
+    product_double.Setup(sys_double.data_manager);
+    product_mixed.Setup(sys_mixed.data_manager);
+    product_double(x, out_double);
+    product_mixed(x, out_mixed);
+
+    double max_out = 0;
+    double max_err = 0;
+    for (uint i = 0; i < num_constraints; i++) {
+        max_out = std::max(max_out, std::abs(out_double[i]));
+        max_err = std::max(max_err, std::abs(out_mixed[i] - out_double[i]));
+        // The rows left out by the local solver mode are left out by both products
+        if (out_double[i] == 0)
+            ASSERT_EQ(out_mixed[i], 0);
+    }
+    ASSERT_GT(max_out, 0);
+    ASSERT_LT(max_err, 1e-5 * max_out);
+}
+
+TEST(ChronoParallel, mixed_precision) {
+    const double step = 1e-3;
+
+    ChSystemParallelNSC sys_double;
+    ChSystemParallelNSC sys_mixed;
+    std::vector<std::shared_ptr<ChBody>> bodies_double;
+    std::vector<std::shared_ptr<ChBody>> bodies_mixed;
+    CreatePile(sys_double, false, bodies_double);
+    CreatePile(sys_mixed, true, bodies_mixed);
+
+    // Same state at the beginning of the first step: the Jacobians of the two systems are the same
+    sys_double.DoStepDynamics(step);
+    sys_mixed.DoStepDynamics(step);
+    ASSERT_GT(sys_double.data_manager->num_rigid_contacts, 50);
+    ASSERT_GT(sys_double.data_manager->num_bilaterals, 0);
+
+    // The double precision M_invD is not computed in mixed precision mode
+    ASSERT_EQ(sys_mixed.data_manager->host_data.M_invD.nonZeros(), 0);
+    ASSERT_EQ(sys_mixed.data_manager->host_data.M_invD_single.nonZeros(),
+              sys_double.data_manager->host_data.M_invD.nonZeros());
+
+    CompareProducts(sys_double, sys_mixed, SolverMode::SLIDING);
+    CompareProducts(sys_double, sys_mixed, SolverMode::NORMAL);
+    CompareProducts(sys_double, sys_mixed, SolverMode::BILATERAL);
+
+    // The solutions differ by the single precision roundoff of the products, amplified by the iterations of the
+    // solver (the impulses are small: a few 1e-10 for the velocities, and a few 1e-12 for the positions)
+    for (int is = 0; is < 50; is++) {
+        sys_double.DoStepDynamics(step);
+        sys_mixed.DoStepDynamics(step);
+    }
+    double max_pos = 0;
+    double max_vel = 0;
+    for (size_t i = 0; i < bodies_double.size(); i++) {
+        max_pos = std::max(max_pos, (bodies_double[i]->GetPos() - bodies_mixed[i]->GetPos()).Length());
+        max_vel = std::max(max_vel, (bodies_double[i]->GetPos_dt() - bodies_mixed[i]->GetPos_dt()).Length());
+    }
+    ASSERT_GT(max_vel, 0);
+    ASSERT_LT(max_pos, 1e-9);
+    ASSERT_LT(max_vel, 1e-7);
+
+    // The pendulum swung about the joint and the spheres remained in the container
+    ASSERT_LT(bodies_double.back()->GetPos().z(), 1.5 - 1e-3);
+    ASSERT_NEAR((bodies_double.back()->GetPos() - ChVector<>(0, 0, 1.5)).Length(), 0.5, 1e-3);
+    for (size_t i = 1; i < bodies_double.size() - 1; i++)
+        ASSERT_GT(bodies_double[i]->GetPos().z(), 0.09);
+}
@@ -0,0 +1,143 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+//
+// ChronoParallel unit test for the MPM solver (host implementation without
+// CUDA): a block of MPM markers settling under gravity on a fixed box.
+// =============================================================================
+
+#include <cmath>
+#include <vector>
+
+#include "chrono_parallel/physics/Ch3DOFContainer.h"
+#include "chrono_parallel/physics/ChSystemParallel.h"
+
+#include "chrono/utils/ChUtilsCreators.h"
+
+#include "unit_testing.h"
+
+using namespace chrono;
+using namespace chrono::collision;
+
+TEST(ChronoParallel, mpm_block) {
+    double time_step = 1e-3;
+    double kernel_radius = 0.032;
+    double max_velocity = 10;
+
+    ChSystemParallelNSC msystem;
+    msystem.Set_G_acc(ChVector<>(0, 0, -9.81));
+    CHOMPfunctions::SetNumThreads(1);
+    msystem.GetSettings()->max_threads = 1;
+
+    msystem.GetSettings()->solver.solver_mode = SolverMode::SLIDING;
+    msystem.GetSettings()->solver.max_iteration_normal = 0;
+    msystem.GetSettings()->solver.max_iteration_sliding = 40;
+    msystem.GetSettings()->solver.max_iteration_spinning = 0;
+    msystem.GetSettings()->solver.max_iteration_bilateral = 0;
+    msystem.GetSettings()->solver.tolerance = 0;
+    msystem.GetSettings()->solver.alpha = 0;
+    msystem.GetSettings()->solver.contact_recovery_speed = 100;
+    msystem.ChangeSolverType(SolverType::BB);
+    msystem.GetSettings()->collision.narrowphase_algorithm = NarrowPhaseType::NARROWPHASE_HYBRID_MPR;
+    msystem.GetSettings()->collision.collision_envelope = kernel_radius * 0.05;
+    msystem.GetSettings()->collision.bins_per_axis = vec3(2, 2, 2);
+
+    // MPM container (snow-like material)
+    auto mpm_container = std::make_shared<ChParticleContainer>();
+    msystem.Add3DOFContainer(mpm_container);
+
+    double youngs_modulus = 1.4e6;
+    double poissons_ratio = 0.2;
+    double rho = 400;
+    mpm_container->mu = 0;
+    mpm_container->alpha = 0;
+    mpm_container->cohesion = 0;
+    mpm_container->theta_c = 1;
+    mpm_container->theta_s = 1;
+    mpm_container->lame_lambda = youngs_modulus * poissons_ratio / ((1. + poissons_ratio) * (1. - 2. * poissons_ratio));
+    mpm_container->lame_mu = youngs_modulus / (2. * (1. + poissons_ratio));
+    mpm_container->youngs_modulus = youngs_modulus;
+    mpm_container->nu = poissons_ratio;
+    mpm_container->alpha_flip = 0.95;
+    mpm_container->hardening_coefficient = 10.0;
+    mpm_container->mpm_iterations = 30;
+    mpm_container->kernel_radius = kernel_radius;
+    mpm_container->collision_envelope = kernel_radius * 0.05;
+    mpm_container->contact_recovery_speed = 10;
+    mpm_container->contact_cohesion = 0;
+    mpm_container->contact_mu = 0;
+    mpm_container->max_velocity = max_velocity;
+    mpm_container->compliance = 0;
+
+    // Block of 6 x 6 x 6 markers, just above the ground
+    double dist = 2 * kernel_radius;
+    mpm_container->mass = rho * dist * dist * dist;
+    std::vector<real3> pos_markers;
+    std::vector<real3> vel_markers;
+    for (int k = 0; k < 6; k++) {
+        for (int j = 0; j < 6; j++) {
+            for (int i = 0; i < 6; i++) {
+                pos_markers.push_back(real3((i - 2.5) * dist, (j - 2.5) * dist, (k + 0.5) * dist + kernel_radius));
+                vel_markers.push_back(real3(0, 0, 0));
+            }
+        }
+    }
+    mpm_container->UpdatePosition(0);
+    mpm_container->AddBodies(pos_markers, vel_markers);
+    int num_markers = (int)pos_markers.size();
+
+    // Fixed ground box, with its top face at z = 0
+    auto mat = std::make_shared<ChMaterialSurfaceNSC>();
+    mat->SetFriction(0.4f);
+    auto ground = std::make_shared<ChBody>(std::make_shared<ChCollisionModelParallel>());
+    ground->SetMaterialSurface(mat);
+    ground->SetBodyFixed(true);
+    ground->SetCollide(true);
+    ground->GetCollisionModel()->ClearModel();
+    utils::AddBoxGeometry(ground.get(), ChVector<>(0.5, 0.5, 0.05), ChVector<>(0, 0, -0.05));
+    ground->GetCollisionModel()->BuildModel();
+    msystem.AddBody(ground);
+
+    msystem.Initialize();
+
+    // The block falls, lands and comes to rest. Markers are neither lost nor created (the mass of the block is
+    // conserved), and the velocity field stays bounded, well below the clamping velocity of the MPM solver.
+    double initial_height = 5 * dist;
+    double vmax = 0;
+    double zmin = 0;
+    double zmax = 0;
+    for (int step = 0; step < 400; step++) {
+        msystem.DoStepDynamics(time_step);
+
+        ASSERT_EQ((int)mpm_container->GetNumParticles(), num_markers);
+        ASSERT_EQ((int)msystem.data_manager->num_fluid_bodies, num_markers);
+
+        vmax = 0;
+        zmin = 1e9;
+        zmax = -1e9;
+        for (int i = 0; i < num_markers; i++) {
+            real3 p = mpm_container->GetPos(i);
+            real3 v = mpm_container->GetPos_dt(i);
+            ASSERT_TRUE(std::isfinite(p.x) && std::isfinite(p.y) && std::isfinite(p.z));
+            ASSERT_TRUE(std::isfinite(v.x) && std::isfinite(v.y) && std::isfinite(v.z));
+            vmax = std::max(vmax, (double)Length(v));
+            zmin = std::min(zmin, (double)p.z);
+            zmax = std::max(zmax, (double)p.z);
+        }
+        ASSERT_LT(vmax, 0.2 * max_velocity);
+    }
+
+    // At rest on the ground, compressed by its weight but not collapsed
+    ASSERT_LT(vmax, 0.3);
+    ASSERT_GT(zmin, 0);
+    ASSERT_LT(zmax - zmin, initial_height);
+    ASSERT_GT(zmax - zmin, 0.5 * initial_height);
+}
@@ -0,0 +1,171 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+//
+// Unit tests for the NSC contact container.
+//
+// - reference: a stack of boxes and a few spheres with rolling and spinning
+//   friction (so that both the sliding and the rolling contact pools are used)
+//   are simulated without warm starting; the final body positions must match
+//   those obtained with the list-based contact container of earlier versions.
+// - warm_start: with solver warm starting enabled, the initial reactions of the
+//   contacts must be those of the previous contacts between the same pair of
+//   contactables, whatever the order in which the contacts are added.
+//
+// =============================================================================
+
+#include <map>
+#include <memory>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "chrono/physics/ChBodyEasy.h"
+#include "chrono/physics/ChContactContainerNSC.h"
+#include "chrono/physics/ChSystemNSC.h"
+
+using namespace chrono;
+using namespace chrono::collision;
+
+// Create a fixed ground, a stack of boxes and a row of rolling spheres.
+static void CreateScene(ChSystemNSC& system, std::vector<std::shared_ptr<ChBody>>& bodies) {
+    auto ground = std::make_shared<ChBodyEasyBox>(20, 1, 20, 1000, true);
+    ground->SetPos(ChVector<>(0, -0.5, 0));
+    ground->SetBodyFixed(true);
+    ground->GetMaterialSurfaceNSC()->SetFriction(0.6f);
+    system.AddBody(ground);
+    bodies.push_back(ground);
+
+    for (int k = 0; k < 4; k++) {
+        auto box = std::make_shared<ChBodyEasyBox>(1, 0.5, 1, 1000, true);
+        box->SetPos(ChVector<>(0.02 * k, 0.26 + 0.51 * k, -0.01 * k));
+        box->GetMaterialSurfaceNSC()->SetFriction(0.6f);
+        system.AddBody(box);
+        bodies.push_back(box);
+    }
+
+    for (int i = 0; i < 3; i++) {
+        auto ball = std::make_shared<ChBodyEasySphere>(0.3, 1000, true);
+        ball->SetPos(ChVector<>(-3.0 + 0.5 * i, 0.32, 2.0 - 2.0 * i));
+        ball->SetPos_dt(ChVector<>(1.0 + 0.5 * i, 0, 0.2 * i));
+        ball->GetMaterialSurfaceNSC()->SetFriction(0.5f);
+        ball->GetMaterialSurfaceNSC()->SetRollingFriction(0.02f);
+        ball->GetMaterialSurfaceNSC()->SetSpinningFriction(0.01f);
+        system.AddBody(ball);
+        bodies.push_back(ball);
+    }
+}
+
+// Final body positions obtained with the list-based contact container.
+static const double ref_pos[8][3] = {
+    {0, -0.5, 0},
+    {-0.00049741357393285062, 0.25000001914703329, -0.00023906079456977847},
+    {0.020368693364243403, 0.74999977581627386, -0.010069839774694085},
+    {0.039785468707049465, 1.2499996773623101, -0.020216302860453124},
+    {0.05975944234928688, 1.7499997221328474, -0.030239923521989183},
+    {-2.2678923436944824, 0.3000000029414705, 2.0000004659865254},
+    {-1.4001982992003226, 0.29999992886252991, 0.14663769258748749},
+    {-0.52823151116712341, 0.30000000942395422, -1.7056482552604908},
+};
+
+TEST(ChContactContainerNSC, reference) {
+    ChSystemNSC system;
+    system.SetMaxItersSolverSpeed(100);
+    std::vector<std::shared_ptr<ChBody>> bodies;
+    CreateScene(system, bodies);
+
+    for (int step = 0; step < 500; step++)
+        system.DoStepDynamics(2e-3);
+
+    ASSERT_GT(system.GetNcontacts(), 0);
+    for (size_t i = 0; i < bodies.size(); i++) {
+        const ChVector<>& pos = bodies[i]->GetPos();
+        EXPECT_NEAR(pos.x(), ref_pos[i][0], 1e-10) << "body " << i;
+        EXPECT_NEAR(pos.y(), ref_pos[i][1], 1e-10) << "body " << i;
+        EXPECT_NEAR(pos.z(), ref_pos[i][2], 1e-10) << "body " << i;
+    }
+}
+
+// Collect the reactions of all contacts, keyed by the second contactable.
+class ReactionCallback : public ChContactContainer::ReportContactCallback {
+  public:
+    virtual bool OnReportContact(const ChVector<>& pA,
+                                 const ChVector<>& pB,
+                                 const ChMatrix33<>& plane_coord,
+                                 const double& distance,
+                                 const double& eff_radius,
+                                 const ChVector<>& react_forces,
+                                 const ChVector<>& react_torques,
+                                 ChContactable* contactobjA,
+                                 ChContactable* contactobjB) override {
+        reactions[contactobjB] = react_forces;
+        return true;
+    }
+    std::map<ChContactable*, ChVector<>> reactions;
+};
+
+// Load contacts between the ground and the specified spheres, with contact points shifted by the given offset.
+static void LoadContacts(ChContactContainer& container,
+                         const std::vector<std::shared_ptr<ChBody>>& bodies,
+                         const std::vector<int>& balls,
+                         const ChVector<>& offset) {
+    container.BeginAddContact();
+    for (int i : balls) {
+        auto ball = bodies[i];
+        ChCollisionInfo cinfo;
+        cinfo.modelA = bodies[0]->GetCollisionModel().get();
+        cinfo.modelB = ball->GetCollisionModel().get();
+        cinfo.vN = ChVector<>(0, 1, 0);
+        cinfo.vpA = ChVector<>(ball->GetPos().x(), 0, ball->GetPos().z()) + offset;
+        cinfo.vpB = cinfo.vpA - cinfo.vN * 1e-3;
+        cinfo.distance = -1e-3;
+        container.AddContact(cinfo);
+    }
+    container.EndAddContact();
+}
+
+TEST(ChContactContainerNSC, warm_start) {
+    ChSystemNSC system;
+    system.SetSolverWarmStarting(true);
+    std::vector<std::shared_ptr<ChBody>> bodies;
+    CreateScene(system, bodies);
+    auto container = std::dynamic_pointer_cast<ChContactContainerNSC>(system.GetContactContainer());
+    container->SetContactCacheTolerance(0.01);
+
+    // Contacts of the first step, with distinct reactions
+    LoadContacts(*container, bodies, {5, 6}, VNULL);
+    ChVectorDynamic<> L(container->GetDOC_d());
+    for (int k = 0; k < L.GetRows(); k++)
+        L(k) = k + 1.0;
+    container->IntStateScatterReactions(0, L);
+    ReactionCallback first;
+    container->ReportAllContacts(&first);
+    ASSERT_EQ(first.reactions.size(), 2);
+
+    // Same contacts in reverse order, plus a new one: the reactions follow the contactable pairs
+    LoadContacts(*container, bodies, {7, 6, 5}, ChVector<>(0.001, 0, 0));
+    ReactionCallback second;
+    container->ReportAllContacts(&second);
+    ASSERT_EQ(second.reactions.size(), 3);
+    for (int i : {5, 6}) {
+        ChContactable* ball = bodies[i].get();
+        ASSERT_TRUE(second.reactions[ball].Equals(first.reactions[ball])) << "sphere " << i;
+    }
+    ASSERT_TRUE(second.reactions[bodies[7].get()].Equals(VNULL));
+
+    // Contact points moved beyond the tolerance: no warm start
+    LoadContacts(*container, bodies, {5, 6, 7}, ChVector<>(0.1, 0, 0));
+    ReactionCallback third;
+    container->ReportAllContacts(&third);
+    ASSERT_EQ(third.reactions.size(), 3);
+    for (auto& reaction : third.reactions)
+        ASSERT_TRUE(reaction.second.Equals(VNULL));
+}
@@ -0,0 +1,170 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+//
+// Unit test for the reuse of contact objects across steps in the NSC and SMC
+// contact containers. A sequence of contact sets of varying size (shrinking,
+// growing beyond the previous capacity, empty) is loaded in the container of a
+// system; after each load, the reported contacts and the contact forces must
+// match those of a newly created container loaded with the same contacts.
+//
+// =============================================================================
+
+#include <algorithm>
+#include <memory>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "chrono/physics/ChBodyEasy.h"
+#include "chrono/physics/ChContactContainerNSC.h"
+#include "chrono/physics/ChContactContainerSMC.h"
+#include "chrono/physics/ChSystemNSC.h"
+#include "chrono/physics/ChSystemSMC.h"
+
+using namespace chrono;
+using namespace chrono::collision;
+
+// Contact sets loaded at successive steps (indices of the spheres touching the ground).
+static const std::vector<std::vector<int>> contact_sets = {
+    {0, 1, 2}, {1, 3}, {0, 1, 2, 3, 4}, {}, {2, 4}, {4, 3, 2, 1, 0}};
+
+// Reported contact data.
+struct ContactRecord {
+    ChContactable* objB;
+    ChVector<> pA;
+    ChVector<> pB;
+    double distance;
+    bool operator<(const ContactRecord& other) const { return objB < other.objB; }
+};
+
+class RecordCallback : public ChContactContainer::ReportContactCallback {
+  public:
+    virtual bool OnReportContact(const ChVector<>& pA,
+                                 const ChVector<>& pB,
+                                 const ChMatrix33<>& plane_coord,
+                                 const double& distance,
+                                 const double& eff_radius,
+                                 const ChVector<>& react_forces,
+                                 const ChVector<>& react_torques,
+                                 ChContactable* contactobjA,
+                                 ChContactable* contactobjB) override {
+        records.push_back({contactobjB, pA, pB, distance});
+        return true;
+    }
+    std::vector<ContactRecord> records;
+};
+
+// Create a fixed ground and a row of spheres with different velocities.
+static void CreateBodies(ChSystem& system, std::vector<std::shared_ptr<ChBody>>& bodies) {
+    auto method = system.GetContactMethod();
+    auto ground = std::make_shared<ChBodyEasyBox>(10, 1, 10, 1000, true, true, method);
+    ground->SetBodyFixed(true);
+    system.AddBody(ground);
+    bodies.push_back(ground);
+
+    for (int i = 0; i < 5; i++) {
+        auto ball = std::make_shared<ChBodyEasySphere>(0.5, 1000, true, true, method);
+        ball->SetPos(ChVector<>(2.0 * i - 4, 0.99 - 0.002 * i, 0));
+        ball->SetPos_dt(ChVector<>(0.1 * i, -0.2 - 0.1 * i, 0));
+        system.AddBody(ball);
+        bodies.push_back(ball);
+    }
+}
+
+// Load the specified contact set in the given container.
+static void LoadContacts(ChContactContainer& container,
+                         const std::vector<std::shared_ptr<ChBody>>& bodies,
+                         const std::vector<int>& set,
+                         int step) {
+    container.BeginAddContact();
+    for (int i : set) {
+        auto ball = bodies[i + 1];
+        double depth = 1e-3 * (1 + i + step);
+        ChCollisionInfo cinfo;
+        cinfo.modelA = bodies[0]->GetCollisionModel().get();
+        cinfo.modelB = ball->GetCollisionModel().get();
+        cinfo.vN = ChVector<>(0, 1, 0);
+        cinfo.vpA = ChVector<>(ball->GetPos().x(), 0.5, 0);
+        cinfo.vpB = cinfo.vpA - cinfo.vN * depth;
+        cinfo.distance = -depth;
+        cinfo.eff_radius = 0.5;
+        container.AddContact(cinfo);
+    }
+    container.EndAddContact();
+}
+
+static std::vector<ContactRecord> Report(ChContactContainer& container) {
+    RecordCallback callback;
+    container.ReportAllContacts(&callback);
+    std::sort(callback.records.begin(), callback.records.end());
+    return callback.records;
+}
+
+static void CompareReports(const std::vector<ContactRecord>& reused, const std::vector<ContactRecord>& fresh) {
+    ASSERT_EQ(reused.size(), fresh.size());
+    for (size_t k = 0; k < reused.size(); k++) {
+        ASSERT_EQ(reused[k].objB, fresh[k].objB);
+        ASSERT_EQ(reused[k].distance, fresh[k].distance);
+        ASSERT_TRUE(reused[k].pA.Equals(fresh[k].pA));
+        ASSERT_TRUE(reused[k].pB.Equals(fresh[k].pB));
+    }
+}
+
+TEST(ChContactContainerNSC, pool_reuse) {
+    ChSystemNSC system;
+    std::vector<std::shared_ptr<ChBody>> bodies;
+    CreateBodies(system, bodies);
+    auto container = system.GetContactContainer();
+
+    for (int step = 0; step < (int)contact_sets.size(); step++) {
+        LoadContacts(*container, bodies, contact_sets[step], step);
+
+        ChContactContainerNSC fresh;
+        fresh.SetSystem(&system);
+        LoadContacts(fresh, bodies, contact_sets[step], step);
+
+        ASSERT_EQ(container->GetNcontacts(), (int)contact_sets[step].size());
+        ASSERT_EQ(container->GetNcontacts(), fresh.GetNcontacts());
+        CompareReports(Report(*container), Report(fresh));
+    }
+}
+
+TEST(ChContactContainerSMC, pool_reuse) {
+    ChSystemSMC system;
+    std::vector<std::shared_ptr<ChBody>> bodies;
+    CreateBodies(system, bodies);
+    auto container = system.GetContactContainer();
+
+    for (int step = 0; step < (int)contact_sets.size(); step++) {
+        LoadContacts(*container, bodies, contact_sets[step], step);
+        container->ComputeContactForces();
+
+        ChContactContainerSMC fresh;
+        fresh.SetSystem(&system);
+        LoadContacts(fresh, bodies, contact_sets[step], step);
+        fresh.ComputeContactForces();
+
+        ASSERT_EQ(container->GetNcontacts(), (int)contact_sets[step].size());
+        ASSERT_EQ(container->GetNcontacts(), fresh.GetNcontacts());
+        CompareReports(Report(*container), Report(fresh));
+
+        // Contact forces on all bodies (zero on the spheres not in contact)
+        for (int i = 1; i < (int)bodies.size(); i++) {
+            auto force = container->GetContactableForce(bodies[i].get());
+            auto fresh_force = fresh.GetContactableForce(bodies[i].get());
+            ASSERT_EQ(force, fresh_force);
+            bool in_contact = std::find(contact_sets[step].begin(), contact_sets[step].end(), i - 1) !=
+                              contact_sets[step].end();
+            ASSERT_EQ(force.Length2() > 0, in_contact);
+        }
+    }
+}
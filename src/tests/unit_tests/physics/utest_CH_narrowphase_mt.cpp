@@ -0,0 +1,89 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+//
+// Unit test for the multithreaded narrow phase of the Bullet collision system.
+// A pile of objects with different shapes (including compound ones) falls on a
+// fixed box; the contacts and the body positions must be identical to those
+// obtained with a single-threaded narrow phase.
+//
+// =============================================================================
+
+#include <memory>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "chrono/collision/ChCCollisionSystemBullet.h"
+#include "chrono/physics/ChBodyEasy.h"
+#include "chrono/physics/ChSystemNSC.h"
+
+using namespace chrono;
+using namespace chrono::collision;
+
+void CreatePile(ChSystemNSC& system, int nthreads) {
+    system.SetParallelThreadNumber(1);
+    std::static_pointer_cast<ChCollisionSystemBullet>(system.GetCollisionSystem())->SetNumThreads(nthreads);
+
+    auto ground = std::make_shared<ChBodyEasyBox>(4, 0.2, 4, 1000, true);
+    ground->SetBodyFixed(true);
+    system.AddBody(ground);
+
+    for (int i = 0; i < 150; i++) {
+        ChVector<> pos(-0.9 + 0.3 * (i % 7), 0.3 + 0.25 * (i / 49), -0.9 + 0.3 * ((i / 7) % 7));
+        std::shared_ptr<ChBody> body;
+        switch (i % 4) {
+            case 0:
+                body = std::make_shared<ChBodyEasySphere>(0.1, 1000, true);
+                break;
+            case 1:
+                body = std::make_shared<ChBodyEasyCylinder>(0.08, 0.15, 1000, true);
+                break;
+            case 2:
+                body = std::make_shared<ChBodyEasyBox>(0.15, 0.1, 0.12, 1000, true);
+                break;
+            case 3:
+                // Compound collision model
+                body = std::make_shared<ChBody>();
+                body->GetCollisionModel()->ClearModel();
+                body->GetCollisionModel()->AddBox(0.06, 0.04, 0.06);
+                body->GetCollisionModel()->AddSphere(0.05, ChVector<>(0, 0.06, 0));
+                body->GetCollisionModel()->BuildModel();
+                body->SetCollide(true);
+                break;
+        }
+        body->SetPos(pos);
+        body->SetRot(Q_from_AngAxis(0.1 * i, VECT_Y));
+        system.AddBody(body);
+    }
+}
+
+TEST(ChCollisionSystemBullet, narrowphase_mt) {
+    ChSystemNSC system1;
+    ChSystemNSC system4;
+    CreatePile(system1, 1);
+    CreatePile(system4, 4);
+
+    for (int step = 0; step < 200; step++) {
+        system1.DoStepDynamics(2e-3);
+        system4.DoStepDynamics(2e-3);
+        ASSERT_EQ(system1.GetNcontacts(), system4.GetNcontacts());
+    }
+    ASSERT_GT(system1.GetNcontacts(), 0);
+
+    auto& bodies1 = system1.Get_bodylist();
+    auto& bodies4 = system4.Get_bodylist();
+    for (size_t i = 0; i < bodies1.size(); i++) {
+        ASSERT_EQ(bodies1[i]->GetPos().x(), bodies4[i]->GetPos().x());
+        ASSERT_EQ(bodies1[i]->GetPos().y(), bodies4[i]->GetPos().y());
+        ASSERT_EQ(bodies1[i]->GetPos().z(), bodies4[i]->GetPos().z());
+    }
+}
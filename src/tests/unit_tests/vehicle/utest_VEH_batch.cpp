@@ -0,0 +1,128 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+//
+// Unit test for ChVehicleBatch. Each instance rolls a sphere, with its own
+// initial velocity, over a rigid terrain built from a mesh shared by all
+// instances. The instances are run by a batch of two threads; the final states
+// must be identical to those of the same simulations run one after the other.
+//
+// =============================================================================
+
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "chrono/physics/ChBodyEasy.h"
+#include "chrono/physics/ChSystemNSC.h"
+
+#include "chrono_vehicle/terrain/RigidTerrain.h"
+#include "chrono_vehicle/utils/ChVehicleBatch.h"
+
+using namespace chrono;
+using namespace chrono::vehicle;
+
+static const std::string mesh_file = "utest_VEH_batch_terrain.obj";
+
+// Write a wavy surface over [-5,5]x[-5,5], as a mesh of n x n quads.
+static void WriteWavyMesh(int n) {
+    std::ofstream obj(mesh_file);
+    for (int j = 0; j <= n; j++) {
+        for (int i = 0; i <= n; i++) {
+            double x = -5 + 10.0 * i / n;
+            double y = -5 + 10.0 * j / n;
+            obj << "v " << x << " " << y << " " << 0.2 * std::sin(x) * std::cos(0.7 * y) << "\n";
+        }
+    }
+    for (int j = 0; j < n; j++) {
+        for (int i = 0; i < n; i++) {
+            int v0 = j * (n + 1) + i + 1;
+            obj << "f " << v0 << " " << v0 + 1 << " " << v0 + n + 2 << "\n";
+            obj << "f " << v0 << " " << v0 + n + 2 << " " << v0 + n + 1 << "\n";
+        }
+    }
+}
+
+class RollingSphere : public ChVehicleBatch::Instance {
+  public:
+    RollingSphere(double speed) : m_speed(speed) {}
+
+    virtual void Initialize(ChVehicleBatch& batch) override {
+        m_system = std::make_shared<ChSystemNSC>();
+        m_system->Set_G_acc(ChVector<>(0, 0, -9.81));
+        m_system->SetParallelThreadNumber(1);
+
+        m_terrain = std::make_shared<RigidTerrain>(m_system.get());
+        auto patch = m_terrain->AddPatch(ChCoordsys<>(), batch.GetMesh(mesh_file), "wavy", 0, false);
+        patch->SetContactFrictionCoefficient(0.8f);
+        m_terrain->Initialize();
+
+        m_sphere = std::make_shared<ChBodyEasySphere>(0.3, 1000, true);
+        m_sphere->SetPos(ChVector<>(-3, 0.5, 0.6));
+        m_sphere->SetPos_dt(ChVector<>(m_speed, 0.2 * m_speed, 0));
+        m_system->AddBody(m_sphere);
+    }
+
+    virtual void Step(double time, double step) override {
+        m_terrain->Synchronize(time);
+        m_terrain->Advance(step);
+        m_system->DoStepDynamics(step);
+    }
+
+    const ChVector<>& GetPos() const { return m_sphere->GetPos(); }
+    const ChVector<>& GetVel() const { return m_sphere->GetPos_dt(); }
+
+  private:
+    double m_speed;
+    std::shared_ptr<ChSystemNSC> m_system;
+    std::shared_ptr<RigidTerrain> m_terrain;
+    std::shared_ptr<ChBody> m_sphere;
+};
+
+TEST(ChVehicleBatch, serial) {
+    WriteWavyMesh(20);
+
+    const int num_instances = 3;
+    const double end_time = 0.5;
+    const double step = 1e-3;
+
+    ChVehicleBatch batch(2);
+    for (int i = 0; i < num_instances; i++)
+        batch.AddInstance(std::make_shared<RollingSphere>(1.0 + i));
+    batch.Initialize();
+    batch.Run(end_time, step);
+    ASSERT_EQ(batch.GetNumThreads(), 2);
+    ASSERT_DOUBLE_EQ(batch.GetTime(), end_time);
+
+    // Same simulations, one after the other
+    ChVehicleBatch loader(1);
+    for (int i = 0; i < num_instances; i++) {
+        RollingSphere instance(1.0 + i);
+        instance.Initialize(loader);
+        double time = 0;
+        for (int is = 0; is < (int)std::round(end_time / step); is++) {
+            instance.Step(time, step);
+            time += step;
+        }
+
+        auto batch_instance = std::static_pointer_cast<RollingSphere>(batch.GetInstance(i));
+        ASSERT_TRUE(batch_instance->GetError().empty()) << batch_instance->GetError();
+        ASSERT_TRUE(batch_instance->GetPos() == instance.GetPos()) << "instance " << i;
+        ASSERT_TRUE(batch_instance->GetVel() == instance.GetVel()) << "instance " << i;
+    }
+
+    std::remove(mesh_file.c_str());
+}
@@ -0,0 +1,191 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+//
+// Unit test for the grid-indexed height, normal, and friction queries of
+// RigidTerrain. A terrain with overlapping box patches (one of them rotated)
+// and a wavy mesh patch is queried at a set of locations through the grid
+// index, with the single-point and the batched queries. The results must be
+// those obtained by intersecting a vertical line with every triangle of the
+// patch surfaces. They must also agree, up to the accuracy of the ray casts
+// (about 1e-2), with the queries used before RigidTerrain::Initialize, which
+// cast rays into every patch through the collision system.
+//
+// =============================================================================
+
+#include <cmath>
+#include <memory>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "chrono/geometry/ChTriangleMeshConnected.h"
+#include "chrono/physics/ChSystemNSC.h"
+
+#include "chrono_vehicle/terrain/RigidTerrain.h"
+
+using namespace chrono;
+using namespace chrono::vehicle;
+
+// Wavy surface over [-5,5]x[-5,5], as a mesh of n x n quads.
+static std::shared_ptr<geometry::ChTriangleMeshConnected> CreateWavyMesh(int n) {
+    auto trimesh = std::make_shared<geometry::ChTriangleMeshConnected>();
+    auto& vertices = trimesh->getCoordsVertices();
+    auto& faces = trimesh->getIndicesVertexes();
+    for (int j = 0; j <= n; j++) {
+        for (int i = 0; i <= n; i++) {
+            double x = -5 + 10.0 * i / n;
+            double y = -5 + 10.0 * j / n;
+            vertices.push_back(ChVector<>(x, y, 0.3 * std::sin(x) * std::cos(0.7 * y)));
+        }
+    }
+    for (int j = 0; j < n; j++) {
+        for (int i = 0; i < n; i++) {
+            int v0 = j * (n + 1) + i;
+            faces.push_back(ChVector<int>(v0, v0 + 1, v0 + n + 2));
+            faces.push_back(ChVector<int>(v0, v0 + n + 2, v0 + n + 1));
+        }
+    }
+    return trimesh;
+}
+
+// Triangle of the terrain surface, in absolute coordinates.
+struct Triangle {
+    ChVector<> v0, v1, v2;
+    float friction;
+};
+
+// Add the triangles of the top face of a box patch.
+static void AddBoxTop(const ChCoordsys<>& position, const ChVector<>& size, float friction, std::vector<Triangle>& tris) {
+    double hx = 0.5 * size.x();
+    double hy = 0.5 * size.y();
+    double hz = 0.5 * size.z();
+    ChVector<> p0 = position.TransformPointLocalToParent(ChVector<>(-hx, -hy, hz));
+    ChVector<> p1 = position.TransformPointLocalToParent(ChVector<>(hx, -hy, hz));
+    ChVector<> p2 = position.TransformPointLocalToParent(ChVector<>(hx, hy, hz));
+    ChVector<> p3 = position.TransformPointLocalToParent(ChVector<>(-hx, hy, hz));
+    tris.push_back({p0, p1, p2, friction});
+    tris.push_back({p0, p2, p3, friction});
+}
+
+// Add the triangles of a mesh patch.
+static void AddMesh(const ChCoordsys<>& position,
+                    const geometry::ChTriangleMeshConnected& trimesh,
+                    float friction,
+                    std::vector<Triangle>& tris) {
+    auto& vertices = trimesh.m_vertices;
+    for (const auto& face : trimesh.m_face_v_indices) {
+        tris.push_back({position.TransformPointLocalToParent(vertices[face.x()]),
+                        position.TransformPointLocalToParent(vertices[face.y()]),
+                        position.TransformPointLocalToParent(vertices[face.z()]), friction});
+    }
+}
+
+// Intersect the vertical line through (x,y) with all triangles and return the highest point.
+static void FindPoint(const std::vector<Triangle>& tris,
+                      double x,
+                      double y,
+                      double& height,
+                      ChVector<>& normal,
+                      float& friction) {
+    height = -1000;
+    normal = ChVector<>(0, 0, 1);
+    friction = 0.8f;
+    for (const auto& tri : tris) {
+        ChVector<> e1 = tri.v1 - tri.v0;
+        ChVector<> e2 = tri.v2 - tri.v0;
+        double det = e1.x() * e2.y() - e1.y() * e2.x();
+        double b1 = ((x - tri.v0.x()) * e2.y() - (y - tri.v0.y()) * e2.x()) / det;
+        double b2 = (e1.x() * (y - tri.v0.y()) - e1.y() * (x - tri.v0.x())) / det;
+        if (b1 < 0 || b2 < 0 || b1 + b2 > 1)
+            continue;
+        double z = tri.v0.z() + b1 * e1.z() + b2 * e2.z();
+        if (z > height) {
+            height = z;
+            normal = Vcross(e1, e2).GetNormalized();
+            if (normal.z() < 0)
+                normal = -normal;
+            friction = tri.friction;
+        }
+    }
+    if (height == -1000)
+        height = 0;
+}
+
+TEST(RigidTerrain, grid_index) {
+    ChSystemNSC system;
+    RigidTerrain terrain(&system);
+    std::vector<Triangle> tris;
+
+    ChCoordsys<> pos1(ChVector<>(-10, 0, -0.5), QUNIT);
+    ChVector<> size1(12, 12, 1);
+    auto patch1 = terrain.AddPatch(pos1, size1, false, 1, false);
+    patch1->SetContactFrictionCoefficient(0.9f);
+    AddBoxTop(pos1, size1, 0.9f, tris);
+
+    ChCoordsys<> pos2(ChVector<>(-12, 2, -0.3), Q_from_AngZ(0.4));
+    ChVector<> size2(4, 3, 1);
+    auto patch2 = terrain.AddPatch(pos2, size2, false, 1, false);
+    patch2->SetContactFrictionCoefficient(0.5f);
+    AddBoxTop(pos2, size2, 0.5f, tris);
+
+    ChCoordsys<> pos3(ChVector<>(2, 0, 0), QUNIT);
+    auto mesh3 = CreateWavyMesh(20);
+    auto patch3 = terrain.AddPatch(pos3, mesh3, "wavy", 0, false);
+    patch3->SetContactFrictionCoefficient(0.7f);
+    AddMesh(pos3, *mesh3, 0.7f, tris);
+
+    // Update the collision models for the ray casts
+    system.DoStepDynamics(1e-3);
+
+    // Query locations, at least 0.04 away from the patch boundaries, including some off the terrain
+    std::vector<ChVector<>> locations;
+    for (int j = 0; j < 17; j++)
+        for (int i = 0; i < 31; i++)
+            locations.push_back(ChVector<>(-17.5 + 0.83 * i + 0.011 * j, -6.35 + 0.79 * j + 0.007 * i, 0));
+
+    // Ray casts into every patch
+    size_t n = locations.size();
+    std::vector<double> ray_height(n);
+    std::vector<float> ray_friction(n);
+    for (size_t k = 0; k < n; k++) {
+        ray_height[k] = terrain.GetHeight(locations[k].x(), locations[k].y());
+        ray_friction[k] = terrain.GetCoefficientFriction(locations[k].x(), locations[k].y());
+    }
+
+    // Queries through the grid index
+    terrain.Initialize();
+
+    std::vector<double> heights(n);
+    std::vector<ChVector<>> normals(n);
+    std::vector<float> frictions(n);
+    terrain.GetProperties((int)n, locations.data(), heights.data(), normals.data(), frictions.data());
+
+    for (size_t k = 0; k < n; k++) {
+        double x = locations[k].x();
+        double y = locations[k].y();
+        double ref_height;
+        ChVector<> ref_normal;
+        float ref_friction;
+        FindPoint(tris, x, y, ref_height, ref_normal, ref_friction);
+
+        ASSERT_NEAR(terrain.GetHeight(x, y), ref_height, 1e-12) << "location " << x << " " << y;
+        ASSERT_TRUE(terrain.GetNormal(x, y).Equals(ref_normal, 1e-12)) << "location " << x << " " << y;
+        ASSERT_EQ(terrain.GetCoefficientFriction(x, y), ref_friction) << "location " << x << " " << y;
+
+        ASSERT_EQ(heights[k], terrain.GetHeight(x, y));
+        ASSERT_TRUE(normals[k].Equals(terrain.GetNormal(x, y)));
+        ASSERT_EQ(frictions[k], ref_friction);
+
+        ASSERT_NEAR(ray_height[k], ref_height, 2e-2) << "location " << x << " " << y;
+        ASSERT_EQ(ray_friction[k], ref_friction) << "location " << x << " " << y;
+    }
+}
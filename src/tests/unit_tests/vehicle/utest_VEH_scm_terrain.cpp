@@ -0,0 +1,259 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+//
+// Unit tests for the SCM deformable terrain.
+//
+// - grid_vs_mesh: a sphere sliding over the soil with bulldozing enabled is
+//   simulated on a flat terrain stored as a regular grid, and on the same
+//   terrain loaded from a Wavefront mesh (processed as a generic mesh). The
+//   soil deformation and the motion of the sphere must be identical.
+// - erosion_volume: a sphere is pressed into the soil with bulldozing enabled,
+//   with and without erosion of the bulldozed material. The erosion must change
+//   the shape of the soil but not its volume.
+// - sparse_storage: a sphere rolls over a flat terrain stored as a dense grid,
+//   and over the same terrain with sparse storage in small tiles, most of them
+//   compressed. The motion of the sphere must be the same, and the vertices of
+//   the visualization mesh of the sparse terrain (updated incrementally, then
+//   rebuilt after being hidden) must be those of the dense terrain.
+//
+// =============================================================================
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <map>
+#include <memory>
+#include <string>
+
+#include "gtest/gtest.h"
+
+#include "chrono/physics/ChBodyEasy.h"
+#include "chrono/physics/ChSystemNSC.h"
+
+#include "chrono_vehicle/terrain/SCMDeformableTerrain.h"
+
+using namespace chrono;
+using namespace chrono::vehicle;
+
+// Size and number of divisions of the flat terrain (the vertex coordinates are exact in single precision)
+static const double terrain_size = 2.0;
+static const int terrain_div = 32;
+
+// Write the flat terrain created by SCMDeformableTerrain::Initialize at height 0 to an .obj file, with the same
+// vertices and faces.
+static void WriteFlatMesh(const std::string& filename) {
+    std::ofstream obj(filename);
+    int nv = terrain_div + 1;
+    double d = terrain_size / terrain_div;
+    for (int iy = nv - 1; iy >= 0; --iy) {
+        for (int ix = 0; ix < nv; ++ix) {
+            obj << "v " << ix * d - 0.5 * terrain_size << " 0 " << 0.5 * terrain_size - iy * d << "\n";
+            obj << "vn 0 1 0\n";
+        }
+    }
+    // The soil mesh has one normal per vertex
+    for (int iy = nv - 2; iy >= 0; --iy) {
+        for (int ix = 0; ix < nv - 1; ++ix) {
+            int v0 = ix + nv * iy + 1;
+            obj << "f " << v0 << "//" << v0 << " " << v0 + nv + 1 << "//" << v0 + nv + 1 << " " << v0 + nv << "//"
+                << v0 + nv << "\n";
+            obj << "f " << v0 << "//" << v0 << " " << v0 + 1 << "//" << v0 + 1 << " " << v0 + nv + 1 << "//"
+                << v0 + nv + 1 << "\n";
+        }
+    }
+}
+
+static void SetSoilParameters(SCMDeformableTerrain& terrain) {
+    terrain.SetSoilParametersSCM(0.2e6, 0, 1.1, 0, 30, 0.01, 4e7, 3e4);
+    terrain.SetBulldozingFlow(true);
+    terrain.SetBulldozingParameters(55, 1, 5, 10);
+}
+
+TEST(SCMDeformableTerrain, grid_vs_mesh) {
+    std::string mesh_file = "utest_VEH_scm_flat.obj";
+    WriteFlatMesh(mesh_file);
+
+    ChSystemNSC system_grid;
+    ChSystemNSC system_mesh;
+    SCMDeformableTerrain terrain_grid(&system_grid);
+    SCMDeformableTerrain terrain_mesh(&system_mesh);
+    SetSoilParameters(terrain_grid);
+    SetSoilParameters(terrain_mesh);
+    terrain_grid.Initialize(0, terrain_size, terrain_size, terrain_div, terrain_div);
+    terrain_mesh.Initialize(mesh_file);
+    std::remove(mesh_file.c_str());
+
+    std::shared_ptr<ChBody> spheres[2];
+    ChSystemNSC* systems[2] = {&system_grid, &system_mesh};
+    for (int i = 0; i < 2; i++) {
+        spheres[i] = std::make_shared<ChBodyEasySphere>(0.15, 2000, true);
+        spheres[i]->SetPos(ChVector<>(-0.5, 0.15, 0.01));
+        spheres[i]->SetPos_dt(ChVector<>(1, 0, 0));
+        systems[i]->AddBody(spheres[i]);
+    }
+
+    for (int step = 0; step < 200; step++) {
+        system_grid.DoStepDynamics(1e-3);
+        system_mesh.DoStepDynamics(1e-3);
+    }
+
+    // The sphere must have sunk into the soil
+    ASSERT_LT(spheres[0]->GetPos().y(), 0.15 - 1e-3);
+
+    ASSERT_TRUE(spheres[0]->GetPos() == spheres[1]->GetPos());
+    ASSERT_TRUE(spheres[0]->GetRot() == spheres[1]->GetRot());
+
+    const auto& vertices_grid = terrain_grid.GetMesh()->GetMesh()->getCoordsVertices();
+    const auto& vertices_mesh = terrain_mesh.GetMesh()->GetMesh()->getCoordsVertices();
+    ASSERT_EQ(vertices_grid.size(), vertices_mesh.size());
+    double max_height = 0;
+    for (size_t i = 0; i < vertices_grid.size(); i++) {
+        ASSERT_TRUE(vertices_grid[i] == vertices_mesh[i]) << "vertex " << i;
+        max_height = std::max(max_height, vertices_grid[i].y());
+    }
+
+    // Soil must have been bulldozed to the sides of the rut
+    ASSERT_GT(max_height, 0);
+}
+
+TEST(SCMDeformableTerrain, erosion_volume) {
+    ChSystemNSC systems[2];
+    std::unique_ptr<SCMDeformableTerrain> terrains[2];
+    for (int i = 0; i < 2; i++) {
+        // Same soil, without and with erosion of the bulldozed material (the small erosion angle flattens the
+        // slightest bump)
+        terrains[i] = std::unique_ptr<SCMDeformableTerrain>(new SCMDeformableTerrain(&systems[i]));
+        terrains[i]->SetSoilParametersSCM(0.2e6, 0, 1.1, 0, 30, 0.01, 4e7, 3e4);
+        terrains[i]->SetBulldozingFlow(true);
+        terrains[i]->SetBulldozingParameters(0.1, 1, i == 0 ? 0 : 5, 10);
+        terrains[i]->Initialize(0, 6, 6, 48, 48);
+
+        // Sphere initially sunk in the soil, so that material is bulldozed in the first step. The sinkage is small
+        // enough for the material raised around the sphere to stay below its surface: it is all deposited on the
+        // soil, none is held as remainder.
+        auto sphere = std::make_shared<ChBodyEasySphere>(0.5, 2000, true);
+        sphere->SetPos(ChVector<>(0.03, 0.495, 0.02));
+        systems[i].AddBody(sphere);
+    }
+
+    // The soil is in the same state before the erosion of the first step: after that step, the volumes of the
+    // soil with and without erosion must be the same.
+    systems[0].DoStepDynamics(1e-3);
+    systems[1].DoStepDynamics(1e-3);
+
+    // All vertices have the same area: the soil volume is proportional to the sum of the vertex heights
+    const auto& vertices0 = terrains[0]->GetMesh()->GetMesh()->getCoordsVertices();
+    const auto& vertices1 = terrains[1]->GetMesh()->GetMesh()->getCoordsVertices();
+    double sum0 = 0;
+    double sum1 = 0;
+    double max_diff = 0;
+    double max_height = 0;
+    for (size_t i = 0; i < vertices0.size(); i++) {
+        sum0 += vertices0[i].y();
+        sum1 += vertices1[i].y();
+        max_diff = std::max(max_diff, std::abs(vertices1[i].y() - vertices0[i].y()));
+        max_height = std::max(max_height, vertices0[i].y());
+    }
+
+    // The erosion reshapes the bulldozed material and conserves its volume
+    ASSERT_GT(max_height, 0);
+    ASSERT_GT(max_diff, 0.1 * max_height);
+    ASSERT_NEAR(sum1, sum0, 1e-14 * vertices0.size());
+}
+
+// Check that all vertices of the sparse terrain mesh are vertices of the dense terrain mesh.
+static void CheckSparseMesh(const SCMDeformableTerrain& dense, const SCMDeformableTerrain& sparse, double d) {
+    std::map<std::pair<long, long>, double> heights;
+    for (const auto& v : dense.GetMesh()->GetMesh()->getCoordsVertices())
+        heights[std::make_pair(std::lround(v.x() / d), std::lround(v.y() / d))] = v.z();
+
+    const auto& vertices = sparse.GetMesh()->GetMesh()->getCoordsVertices();
+    ASSERT_GT(vertices.size(), 0);
+    for (const auto& v : vertices) {
+        auto h = heights.find(std::make_pair(std::lround(v.x() / d), std::lround(v.y() / d)));
+        ASSERT_TRUE(h != heights.end());
+        ASSERT_NEAR(v.z(), h->second, 1e-12);
+    }
+}
+
+TEST(SCMDeformableTerrain, sparse_storage) {
+    ChSystemNSC systems[2];
+    std::shared_ptr<ChBody> spheres[2];
+    std::unique_ptr<SCMDeformableTerrain> terrains[2];
+    for (int i = 0; i < 2; i++) {
+        systems[i].Set_G_acc(ChVector<>(0, 0, -9.81));
+
+        spheres[i] = std::make_shared<ChBodyEasySphere>(0.2, 500, true);
+        spheres[i]->SetPos(ChVector<>(-1.5, 0.1, 0.2));
+        spheres[i]->SetPos_dt(ChVector<>(4, 0, 0));
+        systems[i].AddBody(spheres[i]);
+
+        // Horizontal soil plane, with cells of 0.0625 x 0.0625
+        terrains[i] = std::unique_ptr<SCMDeformableTerrain>(new SCMDeformableTerrain(&systems[i]));
+        terrains[i]->SetPlane(ChCoordsys<>(VNULL, Q_from_AngX(CH_C_PI_2)));
+        terrains[i]->SetSoilParametersSCM(2e6, 0, 1.1, 0, 30, 0.01, 4e7, 3e4);
+        terrains[i]->EnableMovingPatch(spheres[i], VNULL, 0.6, 0.6);
+        if (i == 1) {
+            // Tiles of 0.5 x 0.5, at most 2 of them uncompressed
+            terrains[i]->EnableSparseStorage(8, 2);
+        }
+        terrains[i]->Initialize(0, 4, 4, 64, 64);
+    }
+
+    for (int step = 0; step < 600; step++) {
+        // Hide the sparse terrain mesh for a while: it must be rebuilt when shown again
+        if (step == 300)
+            terrains[1]->GetMesh()->SetVisible(false);
+        if (step == 400)
+            terrains[1]->GetMesh()->SetVisible(true);
+
+        systems[0].DoStepDynamics(1e-3);
+        systems[1].DoStepDynamics(1e-3);
+
+        if (step == 200 || step == 299 || step == 599)
+            CheckSparseMesh(*terrains[0], *terrains[1], 4.0 / 64);
+        if (step == 350)
+            ASSERT_EQ(terrains[1]->GetMesh()->GetMesh()->getCoordsVertices().size(), 0);
+    }
+
+    // The sphere must have sunk into the soil and crossed several tiles
+    ASSERT_LT(spheres[0]->GetPos().z(), 0.2 - 1e-3);
+    ASSERT_GT(spheres[0]->GetPos().x(), 0);
+
+    // The sparse grid vertices are computed from their indices, hence the roundoff differences
+    ASSERT_TRUE(spheres[0]->GetPos().Equals(spheres[1]->GetPos(), 1e-12));
+    ASSERT_TRUE(spheres[0]->GetRot().Equals(spheres[1]->GetRot(), 1e-12));
+
+    // At most 2 blocks of 9 x 9 vertices in the mesh
+    ASSERT_LE(terrains[1]->GetMesh()->GetMesh()->getCoordsVertices().size(), 2 * 81);
+}
+
+TEST(SCMDeformableTerrain, sparse_storage_restrictions) {
+    // Bulldozing and automatic refinement are not supported with sparse storage
+    for (int i = 0; i < 2; i++) {
+        ChSystemNSC system;
+        auto sphere = std::make_shared<ChBodyEasySphere>(0.2, 500, true);
+        sphere->SetPos(ChVector<>(0, 0, 0.2));
+        system.AddBody(sphere);
+
+        SCMDeformableTerrain terrain(&system);
+        terrain.SetPlane(ChCoordsys<>(VNULL, Q_from_AngX(CH_C_PI_2)));
+        terrain.EnableMovingPatch(sphere, VNULL, 0.6, 0.6);
+        terrain.EnableSparseStorage(8);
+        terrain.SetBulldozingFlow(i == 0);
+        terrain.SetAutomaticRefinement(i == 1);
+        terrain.Initialize(0, 4, 4, 64, 64);
+
+        ASSERT_THROW(system.DoStepDynamics(1e-3), ChException);
+    }
+}